@@ -38,12 +38,14 @@ extern "C" {
 #define PRINT_CSV_FORMAT      0
 /*---------- Print messages from BLE2 files at middleware level -----------*/
 #define BLUENRG2_DEBUG      0
-/*---------- Number of Bytes reserved for HCI Read Packet -----------*/
-#define HCI_READ_PACKET_SIZE      128
+/*---------- Number of Bytes reserved for HCI Read Packet (255: largest event, firmware update writes) -----------*/
+#define HCI_READ_PACKET_SIZE      255
 /*---------- Number of Bytes reserved for HCI Max Payload -----------*/
 #define HCI_MAX_PAYLOAD_SIZE      128
 /*---------- Number of incoming packets added to the list of packets to read -----------*/
 #define HCI_READ_PACKET_NUM_MAX      10
+/*---------- Number of incoming packets lent to the list of packets to read under sustained load -----------*/
+#define HCI_READ_PACKET_RESERVE      6
 /*---------- Scan Interval: time interval from when the Controller started its last scan until it begins the subsequent scan (for a number N, Time = N x 0.625 msec) -----------*/
 #define SCAN_P      16384
 /*---------- Scan Window: amount of time for the duration of the LE scan (for a number N, Time = N x 0.625 msec) -----------*/
@@ -0,0 +1,183 @@
+/**
+  **************************************************************************************************
+  * @file       : Bootloader.c
+  * @brief      : Bootloader of the firmware update. Installs an image verified by Ota_Update.c
+	*								and starts the application.
+  * @author			:
+  **************************************************************************************************
+  *
+  * Built as its own image for sectors 0-1 (0x08000000, 32KB) with startup_stm32f411xe.s and the
+  * CMSIS system_stm32f4xx.c (VECT_TAB_OFFSET 0). It runs on the reset clock (HSI, 16MHz) and uses
+  * the flash and CRC registers directly, no HAL.
+  *
+  * A header valid at OTA_HEADER_ADDR (see Ota_Image.h) is an update request. The staging area is
+  * checked again with the CRC unit, the application sectors are erased and the image copied, then
+  * checked. Only then the header magic is programmed to 0: a reset during the copy starts it
+  * again at the next boot.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include "stm32f4xx.h"
+#include "Ota_Image.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define BOOT_FLASH_KEY1									((uint32_t)0x45670123U)
+#define BOOT_FLASH_KEY2									((uint32_t)0xCDEF89ABU)
+#define BOOT_FLASH_ERRORS								(FLASH_SR_WRPERR | FLASH_SR_PGAERR | FLASH_SR_PGPERR | FLASH_SR_PGSERR)
+
+/* Copies tried before starting the old application anyway */
+#define BOOT_MAX_ATTEMPTS								3U
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static uint32_t Boot_CRC(uint32_t Address, uint32_t Size);
+static uint8_t Boot_Install(const Ota_Header_t *pHeader);
+static uint8_t Boot_Erase(uint32_t Sector);
+static uint8_t Boot_Program(uint32_t Address, uint32_t Word);
+static void Boot_Jump(void);
+
+
+int main(void)
+{
+	const Ota_Header_t *pHeader = (const Ota_Header_t *)OTA_HEADER_ADDR;
+	uint8_t Attempt;
+
+	RCC->AHB1ENR |= RCC_AHB1ENR_CRCEN;
+
+	if((pHeader->Magic == OTA_HEADER_MAGIC) && (pHeader->Check == OTA_HEADER_CHECK(pHeader)) &&
+		 (pHeader->Size != 0U) && (pHeader->Size <= OTA_MAX_IMAGE_SIZE) &&
+		 (Boot_CRC(OTA_STAGING_ADDR, pHeader->Size) == pHeader->Crc))
+	{
+		FLASH->KEYR = BOOT_FLASH_KEY1;
+		FLASH->KEYR = BOOT_FLASH_KEY2;
+
+		for(Attempt = 0; Attempt < BOOT_MAX_ATTEMPTS; Attempt++)
+		{
+			if(Boot_Install(pHeader))
+			{
+				/* Done: the request is cleared without an erase */
+				(void)Boot_Program(OTA_HEADER_ADDR, 0U);
+				break;
+			}
+		}
+
+		FLASH->CR |= FLASH_CR_LOCK;
+	}
+
+	RCC->AHB1ENR &= ~RCC_AHB1ENR_CRCEN;
+
+	Boot_Jump();
+
+	while(1);
+}
+
+/**
+  * @brief	CRC unit over Size bytes, the last word padded with 0xFF
+	*/
+static uint32_t Boot_CRC(uint32_t Address, uint32_t Size)
+{
+	const uint32_t *pWord = (const uint32_t *)Address;
+	uint32_t Words = (Size + 3U) / 4U;
+	uint32_t Last = 0xFFFFFFFFU;
+	uint32_t i;
+
+	CRC->CR = CRC_CR_RESET;
+	for(i = 0; i < (Size / 4U); i++)
+	{
+		CRC->DR = pWord[i];
+	}
+	if(Words != (Size / 4U))
+	{
+		/* Bytes past the image count as 0xFF */
+		Last &= pWord[i] | (0xFFFFFFFFU << (8U * (Size & 3U)));
+		CRC->DR = Last;
+	}
+
+	return CRC->DR;
+}
+
+/**
+  * @brief	Copy the staging area into the application sectors
+	* @retval	1 if the copy has the CRC of the header
+	*/
+static uint8_t Boot_Install(const Ota_Header_t *pHeader)
+{
+	const uint32_t *pSource = (const uint32_t *)OTA_STAGING_ADDR;
+	uint32_t Words = (pHeader->Size + 3U) / 4U;
+	uint32_t i;
+
+	for(i = 0; i < OTA_APP_SECTORS; i++)
+	{
+		if(!Boot_Erase(OTA_APP_FIRST_SECTOR + i))
+		{
+			return 0;
+		}
+	}
+
+	for(i = 0; i < Words; i++)
+	{
+		if(!Boot_Program(OTA_APP_ADDR + (4U * i), pSource[i]))
+		{
+			return 0;
+		}
+	}
+
+	return (Boot_CRC(OTA_APP_ADDR, pHeader->Size) == pHeader->Crc);
+}
+
+/**
+  * @brief	Erase a sector, 32-bit parallelism (2.7 - 3.6 V)
+	*/
+static uint8_t Boot_Erase(uint32_t Sector)
+{
+	while(FLASH->SR & FLASH_SR_BSY);
+	FLASH->SR = BOOT_FLASH_ERRORS | FLASH_SR_EOP;
+
+	FLASH->CR = FLASH_CR_PSIZE_1 | FLASH_CR_SER | (Sector << FLASH_CR_SNB_Pos);
+	FLASH->CR |= FLASH_CR_STRT;
+	while(FLASH->SR & FLASH_SR_BSY);
+	FLASH->CR = 0;
+
+	return ((FLASH->SR & BOOT_FLASH_ERRORS) == 0U);
+}
+
+/**
+  * @brief	Program one word
+	*/
+static uint8_t Boot_Program(uint32_t Address, uint32_t Word)
+{
+	while(FLASH->SR & FLASH_SR_BSY);
+	FLASH->SR = BOOT_FLASH_ERRORS | FLASH_SR_EOP;
+
+	FLASH->CR = FLASH_CR_PSIZE_1 | FLASH_CR_PG;
+	*(volatile uint32_t *)Address = Word;
+	__DSB();
+	while(FLASH->SR & FLASH_SR_BSY);
+	FLASH->CR = 0;
+
+	return ((FLASH->SR & BOOT_FLASH_ERRORS) == 0U);
+}
+
+/**
+  * @brief	Start the application, if there is one
+	*/
+static void Boot_Jump(void)
+{
+	uint32_t Stack = *(const uint32_t *)OTA_APP_ADDR;
+	uint32_t Reset_Handler = *(const uint32_t *)(OTA_APP_ADDR + 4U);
+
+	/* Erased flash or not a stack pointer in the 128KB of SRAM */
+	if((Stack <= SRAM1_BASE) || (Stack > (SRAM1_BASE + 0x20000U)))
+	{
+		return;
+	}
+
+	SCB->VTOR = OTA_APP_ADDR;
+	__set_MSP(Stack);
+	((void (*)(void))Reset_Handler)();
+}
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,141 @@
+/**
+  **************************************************************************************************
+  * @file           : Adv_Manager.h
+  * @brief          : Header for Adv_Manager.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __ADV_MANAGER_H
+#define __ADV_MANAGER_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/* Advertising payloads are limited to 31 bytes of AD structures */
+#define ADVMGR_MAX_DATA										31U
+
+/* Local name AD structure: AD type and name */
+#define ADVMGR_MAX_NAME										20U
+
+/**
+  * @brief Manufacturer specific data: company identifier (little endian) and payload, without the
+  *				 AD length and type bytes. Must fit next to the flags (3 bytes) and the local name.
+  */
+#define ADVMGR_MAX_MANUF_DATA							14U
+#define ADVMGR_MANUF_SLOTS								4U
+
+/* Phases of a schedule */
+#define ADVMGR_MAX_PHASES									4U
+
+/**
+  * @brief Default schedule, intervals in units of 0.625 ms. Fast right after start and disconnection
+  *				 so that the central reconnects quickly, then the configured intervals, then slow
+  *				 until a connection.
+  */
+#define ADVMGR_FAST_MS										30000U
+#define ADVMGR_FAST_INTERV_MIN						32U				/* 20 ms */
+#define ADVMGR_FAST_INTERV_MAX						48U				/* 30 ms */
+#define ADVMGR_NORMAL_MS									300000U
+#define ADVMGR_SLOW_INTERV_MIN						1636U			/* 1022.5 ms */
+#define ADVMGR_SLOW_INTERV_MAX						2056U			/* 1285 ms */
+
+/* Phase duration of a phase that lasts until advertising stops */
+#define ADVMGR_FOREVER										0U
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	ADVMGR_OK = 0x00,
+	ADVMGR_ERROR_PARAM,
+	ADVMGR_ERROR_ACI,
+
+} AdvMgr_Status_t;
+
+/**
+  * @brief One step of an advertising schedule
+  */
+typedef struct
+{
+	uint32_t Duration_ms;							/* ADVMGR_FOREVER for the last phase */
+	uint16_t Interval_Min;						/* Units of 0.625 ms */
+	uint16_t Interval_Max;
+
+} AdvMgr_Phase_t;
+
+/**
+  * @brief Position in a schedule. Pure state: AdvMgr_SchedUpdate() takes the time as a parameter
+  *				 and can be run against a virtual clock.
+  */
+typedef struct
+{
+	const AdvMgr_Phase_t *pPhases;
+	uint8_t Count;
+	uint8_t Phase;										/* Count once a schedule of finite phases ended */
+	uint32_t Phase_Start;							/* ms */
+
+} AdvMgr_Sched_t;
+
+typedef struct
+{
+	uint32_t Starts;									/* Advertising started by AdvMgr_Start() */
+	uint32_t Phase_Changes;						/* Restarts to apply the intervals of a new phase */
+	uint32_t Rotations;								/* Manufacturer data slot changes */
+	uint32_t Adv_Updates;							/* Advertising data sent to the controller */
+	uint32_t Adv_Skipped;							/* Advertising data already in the controller */
+	uint32_t Scan_Updates;						/* Scan response data sent to the controller */
+	uint32_t Scan_Skipped;
+	uint32_t Errors;
+
+} AdvMgr_Stats_t;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+/*** Schedule ***/
+void AdvMgr_SchedInit(AdvMgr_Sched_t *pSched, const AdvMgr_Phase_t *pPhases, uint8_t Count);
+void AdvMgr_SchedStart(AdvMgr_Sched_t *pSched, uint32_t Now);
+uint8_t AdvMgr_SchedUpdate(AdvMgr_Sched_t *pSched, uint32_t Now);
+const AdvMgr_Phase_t *AdvMgr_SchedPhase(const AdvMgr_Sched_t *pSched);
+uint32_t AdvMgr_SchedRemaining(const AdvMgr_Sched_t *pSched, uint32_t Now);
+
+/*** Advertising ***/
+void AdvMgr_Init(void);
+AdvMgr_Status_t AdvMgr_SetSchedule(const AdvMgr_Phase_t *pPhases, uint8_t Count);
+AdvMgr_Status_t AdvMgr_SetName(const uint8_t *pName, uint8_t Length);
+AdvMgr_Status_t AdvMgr_SetScanResponse(const uint8_t *pData, uint8_t Length);
+AdvMgr_Status_t AdvMgr_SetManufData(uint8_t Slot, const uint8_t *pData, uint8_t Length);
+void AdvMgr_SetRotation(uint32_t Period_ms);
+AdvMgr_Status_t AdvMgr_Start(void);
+AdvMgr_Status_t AdvMgr_Stop(void);
+void AdvMgr_Connected(void);
+void AdvMgr_Process(void);
+uint8_t AdvMgr_IsAdvertising(void);
+const AdvMgr_Phase_t *AdvMgr_GetPhase(void);
+
+const AdvMgr_Stats_t *AdvMgr_GetStats(void);
+void AdvMgr_ResetStats(void);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __ADV_MANAGER_H */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -85,6 +85,8 @@ void APP_UserEvtRx(void *pData);
 /*** User Application Related Routines/Functions ***/
 void BlueNRG_Loop(void);
 void TestUpdateCharacteristic(void);
+uint16_t BlueNRG_NotifySamples(const int16_t *pSamples, uint16_t Count, uint8_t Channels);
+uint8_t BlueNRG_NotifyRecord(const uint8_t *pRecord, uint16_t Length);
 
 
 
@@ -0,0 +1,134 @@
+/**
+  **************************************************************************************************
+  * @file           : Clock_Profile.h
+  * @brief          : Header for Clock_Profile.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __CLOCK_PROFILE_H
+#define __CLOCK_PROFILE_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/* Set to 0 to build only the profile table and ClockProfile_Compute(), without the switch (host tests) */
+#ifndef CLOCKPROFILE_SWITCH_ENABLE
+#define CLOCKPROFILE_SWITCH_ENABLE			1
+#endif
+
+/* STM32F411 limits with the regulator in scale 1 and VDD above 2.7 V */
+#define CLOCKPROFILE_SYSCLK_MAX					100000000U
+#define CLOCKPROFILE_PCLK1_MAX					50000000U
+#define CLOCKPROFILE_PCLK2_MAX					100000000U
+#define CLOCKPROFILE_VCO_IN_MIN					1000000U
+#define CLOCKPROFILE_VCO_IN_MAX					2000000U
+#define CLOCKPROFILE_VCO_OUT_MIN				100000000U
+#define CLOCKPROFILE_VCO_OUT_MAX				432000000U
+
+/* Highest USART1 baud rate error accepted for a profile, in tenths of percent */
+#define CLOCKPROFILE_UART_ERROR_MAX			20U
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	CLOCKPROFILE_OK = 0x00,
+	CLOCKPROFILE_ERROR_PARAM,
+	CLOCKPROFILE_ERROR_RANGE,
+	CLOCKPROFILE_ERROR_RCC,
+	CLOCKPROFILE_ERROR_BUS,
+
+} ClockProfile_Status_t;
+
+/**
+  * @brief Named clock profiles
+	*
+	* BURST_DSP runs the core at 100 MHz for bulk signal processing, BLE_STREAMING picks the SYSCLK
+	* for which SPI1 runs exactly at the BlueNRG-2 maximum and IDLE_LOW_POWER runs from the HSI at
+	* 4 MHz with the PLL stopped.
+	*
+	* main() starts in BLE_STREAMING. The peripheral then drops to IDLE_LOW_POWER while it is not
+	* connected and advertises with the slow intervals, or not at all, and goes back to
+	* BLE_STREAMING on connection (BLE_Process.c). BURST_DSP is left to the code running long DSP
+	* blocks, which switches back once done; nothing in this build does.
+	*/
+typedef enum
+{
+	CLOCK_PROFILE_BURST_DSP = 0x00,
+	CLOCK_PROFILE_BLE_STREAMING,
+	CLOCK_PROFILE_IDLE_LOW_POWER,
+	CLOCK_PROFILE_COUNT,
+
+} ClockProfile_Id_t;
+
+/**
+  * @brief Oscillator and bus settings of a profile. The PLL fields are ignored when SYSCLK is
+  *				 taken from the HSI.
+  */
+typedef struct
+{
+	const char *Name;
+	uint32_t SysClk_Source;						/* RCC_SYSCLKSOURCE_PLLCLK or RCC_SYSCLKSOURCE_HSI */
+	uint32_t PLLM;
+	uint32_t PLLN;
+	uint32_t PLLP;										/* RCC_PLLP_DIVx */
+	uint32_t PLLQ;
+	uint32_t AHB_Divider;							/* RCC_SYSCLK_DIVx */
+	uint32_t APB1_Divider;						/* RCC_HCLK_DIVx */
+	uint32_t APB2_Divider;						/* RCC_HCLK_DIVx */
+
+} ClockProfile_t;
+
+/**
+  * @brief Clocks and peripheral dividers derived from a profile
+  */
+typedef struct
+{
+	uint32_t SysClk;
+	uint32_t HClk;
+	uint32_t PClk1;
+	uint32_t PClk2;
+	uint32_t TimClk1;									/* TIM2-5 kernel clock */
+	uint32_t TIM2_Prescaler;					/* PSC giving TIM2 a 1 MHz count */
+	uint32_t Flash_Latency;						/* FLASH_LATENCY_x */
+	uint32_t SPI_Prescaler;						/* SPI_BAUDRATEPRESCALER_x for SPI1 */
+	uint32_t SPI_Baudrate;
+	uint32_t UART_BRR;								/* USART1 BRR, 16x oversampling */
+	uint32_t UART_Baudrate;
+
+} ClockProfile_Freq_t;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+ClockProfile_Status_t ClockProfile_Compute(const ClockProfile_t *pProfile, uint32_t UART_Baudrate, ClockProfile_Freq_t *pFreq);
+const ClockProfile_t *ClockProfile_GetProfile(ClockProfile_Id_t Id);
+#if CLOCKPROFILE_SWITCH_ENABLE
+ClockProfile_Status_t ClockProfile_Set(ClockProfile_Id_t Id);
+ClockProfile_Id_t ClockProfile_GetCurrent(void);
+const ClockProfile_Freq_t *ClockProfile_GetFreq(void);
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __CLOCK_PROFILE_H */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,79 @@
+/**
+  **************************************************************************************************
+  * @file           : Dsp_Endpoints.h
+  * @brief          : Header for Dsp_Endpoints.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __DSP_ENDPOINTS_H
+#define __DSP_ENDPOINTS_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "Dsp_Pipeline.h"
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+/**
+  * @brief Source fed by a circular DMA over two blocks of the first node
+  */
+typedef struct
+{
+	Pipe_t *pPipe;
+	uint8_t *pBuffer;													/* 2 * Pipe_BlockBytes(), target of the DMA */
+	volatile uint8_t Ready[2];								/* Half filled, set in the DMA interrupt */
+	volatile uint8_t Busy;										/* Half being pushed, 0xFF for none */
+	uint8_t Next;															/* Half to push next */
+	volatile uint32_t Overruns;								/* Halves written again before or while pushed */
+
+} Pipe_DmaSource_t;
+
+/**
+  * @brief Sink notifying the output of the last node with BlueNRG_NotifySamples()
+  */
+typedef struct
+{
+	int16_t *pSamples;												/* Out_Block samples: q15 conversion and samples not sent */
+	uint16_t Capacity;
+	uint8_t Channels;
+	uint8_t Is_Float;													/* Output of the last node in float32_t, else q15 */
+	uint16_t Pending;													/* Samples waiting for TX buffers */
+	uint16_t Offset;
+	uint32_t Dropped;													/* Samples of blocks arrived while some were pending */
+
+} Pipe_BleSink_t;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+/*** DMA source ***/
+void Pipe_DmaSource_Init(Pipe_DmaSource_t *pSource, Pipe_t *pPipe, uint8_t *pBuffer);
+void Pipe_DmaSource_HalfComplete(Pipe_DmaSource_t *pSource);
+void Pipe_DmaSource_Complete(Pipe_DmaSource_t *pSource);
+uint8_t Pipe_DmaSource_Process(Pipe_DmaSource_t *pSource);
+
+/*** BLE sink ***/
+void Pipe_BleSink_Init(Pipe_BleSink_t *pSink, int16_t *pSamples, uint16_t Capacity, uint8_t Channels, uint8_t Is_Float);
+void Pipe_BleSink(void *pContext, void *pData, uint16_t Samples);
+uint8_t Pipe_BleSink_Resume(Pipe_BleSink_t *pSink);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __DSP_ENDPOINTS_H */
+
+
+/******************************************* END OF FILE *******************************************/
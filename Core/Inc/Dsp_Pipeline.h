@@ -0,0 +1,168 @@
+/**
+  **************************************************************************************************
+  * @file           : Dsp_Pipeline.h
+  * @brief          : Header for Dsp_Pipeline.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __DSP_PIPELINE_H
+#define __DSP_PIPELINE_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "arm_math.h"
+
+#if defined(ARM_MATH_HOST_X86)
+#include <stdio.h>
+#endif
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+#define PIPE_MAX_NODES										8U
+
+/* Node flags */
+#define PIPE_FLAG_IN_PLACE								((uint8_t)0x01)		/* The output may overwrite the input */
+
+/* Alignment of the buffers in the arena */
+#define PIPE_ALIGN												8U
+
+/**
+  * @brief Node declarations, Block: samples consumed per call
+  */
+#define PIPE_NODE(Func, pContext, In_Block, Out_Block, In_Size, Out_Size, Flags)										\
+	{ (Func), (void *)(pContext), (In_Block), (Out_Block), (In_Size), (Out_Size), (Flags) }
+
+#define PIPE_NODE_Q15_TO_F32(Block)											\
+	PIPE_NODE(Pipe_Q15ToF32, NULL, (Block), (Block), 2U, 4U, 0U)
+#define PIPE_NODE_SCALE_F32(pScale, Block)							\
+	PIPE_NODE(Pipe_Scale_f32, (pScale), (Block), (Block), 4U, 4U, PIPE_FLAG_IN_PLACE)
+#define PIPE_NODE_BIQUAD_F32(pInstance, Block)					\
+	PIPE_NODE(Pipe_Biquad_f32, (pInstance), (Block), (Block), 4U, 4U, PIPE_FLAG_IN_PLACE)
+#define PIPE_NODE_FIR_F32(pInstance, Block)							\
+	PIPE_NODE(Pipe_Fir_f32, (pInstance), (Block), (Block), 4U, 4U, 0U)
+#define PIPE_NODE_DECIMATE_F32(pInstance, Block, M)			\
+	PIPE_NODE(Pipe_Decimate_f32, (pInstance), (Block), (Block) / (M), 4U, 4U, 0U)
+#define PIPE_NODE_INTERPOLATE_F32(pInstance, Block, L)	\
+	PIPE_NODE(Pipe_Interpolate_f32, (pInstance), (Block), (Block) * (L), 4U, 4U, 0U)
+#define PIPE_NODE_RFFT_F32(pInstance, N)								\
+	PIPE_NODE(Pipe_Rfft_f32, (pInstance), (N), (N), 4U, 4U, 0U)
+#define PIPE_NODE_POWER_F32(N)													\
+	PIPE_NODE(Pipe_Power_f32, NULL, (N), (N) / 2U, 4U, 4U, 0U)
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	PIPE_OK = 0x00,
+	PIPE_ERROR_PARAM,
+	PIPE_ERROR_RATE,														/* Block sizes of neighbours not multiples */
+	PIPE_ERROR_FORMAT,													/* Sample sizes of neighbours differ */
+	PIPE_ERROR_ARENA,														/* Arena too small, see Pipe_ArenaSize() */
+
+} Pipe_Status_t;
+
+/**
+  * @brief Stage: consumes Samples (In_Block) samples at pIn, produces Out_Block samples at pOut.
+  *				 pIn may be overwritten, pOut is pIn for an in-place run.
+  */
+typedef void (*Pipe_ProcessFunc_t)(void *pContext, void *pIn, void *pOut, uint16_t Samples);
+
+/**
+  * @brief Sink: Samples samples of the last node. The buffer is reused after the return, pData may
+  *				 be overwritten.
+  */
+typedef void (*Pipe_SinkFunc_t)(void *pContext, void *pData, uint16_t Samples);
+
+typedef struct
+{
+	Pipe_ProcessFunc_t pfProcess;
+	void *pContext;
+	uint16_t In_Block;												/* Samples consumed per call */
+	uint16_t Out_Block;												/* Samples produced per call */
+	uint8_t In_Size;													/* Bytes per sample */
+	uint8_t Out_Size;
+	uint8_t Flags;														/* PIPE_FLAG_x */
+
+} Pipe_Node_t;
+
+typedef struct
+{
+	uint32_t Blocks;													/* Source blocks pushed */
+	uint32_t Runs;														/* Stage calls */
+	uint32_t Sink_Blocks;
+	uint32_t Arena_Used;											/* Bytes of the planned buffers */
+	uint8_t Buffers;													/* Buffers shared by the node outputs */
+	uint8_t In_Place;													/* Nodes run in place */
+
+} Pipe_Stats_t;
+
+typedef struct
+{
+	const Pipe_Node_t *pNodes;
+	uint8_t Nodes;
+	Pipe_SinkFunc_t pfSink;
+	void *pSink_Context;
+	uint8_t *pOut[PIPE_MAX_NODES];						/* Output buffer of a node, NULL when run in place */
+	uint16_t Fill[PIPE_MAX_NODES];						/* Samples waiting in the output buffer */
+	Pipe_Stats_t Stats;
+
+} Pipe_t;
+
+#if defined(ARM_MATH_HOST_X86)
+typedef struct
+{
+	FILE *pFile;
+	uint8_t Size;															/* Bytes per sample */
+	uint32_t Samples;
+
+} Pipe_FileSink_t;
+#endif
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+/*** Pipeline ***/
+uint32_t Pipe_ArenaSize(const Pipe_Node_t *pNodes, uint8_t Nodes);
+Pipe_Status_t Pipe_Init(Pipe_t *pPipe, const Pipe_Node_t *pNodes, uint8_t Nodes,
+												Pipe_SinkFunc_t pfSink, void *pSink_Context, uint32_t *pArena, uint32_t Arena_Size);
+void Pipe_Push(Pipe_t *pPipe, void *pBlock);
+void Pipe_Reset(Pipe_t *pPipe);
+uint32_t Pipe_BlockBytes(const Pipe_t *pPipe);
+const Pipe_Stats_t *Pipe_GetStats(const Pipe_t *pPipe);
+
+/*** Stages ***/
+void Pipe_Q15ToF32(void *pContext, void *pIn, void *pOut, uint16_t Samples);
+void Pipe_Scale_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples);
+void Pipe_Biquad_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples);
+void Pipe_Fir_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples);
+void Pipe_Decimate_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples);
+void Pipe_Interpolate_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples);
+void Pipe_Rfft_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples);
+void Pipe_Power_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples);
+
+/*** Host files ***/
+#if defined(ARM_MATH_HOST_X86)
+uint32_t Pipe_RunFile(Pipe_t *pPipe, FILE *pFile, void *pBlock);
+void Pipe_FileSink(void *pContext, void *pData, uint16_t Samples);
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __DSP_PIPELINE_H */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,153 @@
+/**
+  **************************************************************************************************
+  * @file           : Event_Mask.h
+  * @brief          : Header for Event_Mask.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __EVENT_MASK_H
+#define __EVENT_MASK_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/**
+  * @brief Event identifiers: packet class and event code, as dispatched by APP_UserEvtRx() through
+  *				 the tables of bluenrg1_events.c
+  */
+#define EVTMASK_CLASS_HCI									0x00U			/* hci_events_table */
+#define EVTMASK_CLASS_LE									0x01U			/* hci_le_meta_events_table, subevent code */
+#define EVTMASK_CLASS_VENDOR							0x02U			/* hci_vendor_specific_events_table, ecode */
+
+#define EVTMASK_ID(Class, Code)						((uint32_t)(((uint32_t)(Class) << 16) | (uint16_t)(Code)))
+
+/*** HCI events ***/
+#define EVTMASK_DISCONNECTION_COMPLETE					EVTMASK_ID(EVTMASK_CLASS_HCI, 0x0005U)
+#define EVTMASK_ENCRYPTION_CHANGE								EVTMASK_ID(EVTMASK_CLASS_HCI, 0x0008U)
+#define EVTMASK_READ_REMOTE_VERSION_COMPLETE		EVTMASK_ID(EVTMASK_CLASS_HCI, 0x000CU)
+#define EVTMASK_HARDWARE_ERROR									EVTMASK_ID(EVTMASK_CLASS_HCI, 0x0010U)
+#define EVTMASK_NUMBER_OF_COMPLETED_PACKETS			EVTMASK_ID(EVTMASK_CLASS_HCI, 0x0013U)
+#define EVTMASK_DATA_BUFFER_OVERFLOW						EVTMASK_ID(EVTMASK_CLASS_HCI, 0x001AU)
+#define EVTMASK_ENCRYPTION_KEY_REFRESH_COMPLETE	EVTMASK_ID(EVTMASK_CLASS_HCI, 0x0030U)
+
+/*** LE meta events ***/
+#define EVTMASK_LE_CONNECTION_COMPLETE					EVTMASK_ID(EVTMASK_CLASS_LE, 0x0001U)
+#define EVTMASK_LE_ADVERTISING_REPORT						EVTMASK_ID(EVTMASK_CLASS_LE, 0x0002U)
+#define EVTMASK_LE_CONNECTION_UPDATE_COMPLETE		EVTMASK_ID(EVTMASK_CLASS_LE, 0x0003U)
+#define EVTMASK_LE_READ_REMOTE_FEATURES_COMPLETE	EVTMASK_ID(EVTMASK_CLASS_LE, 0x0004U)
+#define EVTMASK_LE_LONG_TERM_KEY_REQUEST				EVTMASK_ID(EVTMASK_CLASS_LE, 0x0005U)
+#define EVTMASK_LE_DATA_LENGTH_CHANGE						EVTMASK_ID(EVTMASK_CLASS_LE, 0x0007U)
+#define EVTMASK_LE_READ_LOCAL_P256_KEY_COMPLETE	EVTMASK_ID(EVTMASK_CLASS_LE, 0x0008U)
+#define EVTMASK_LE_GENERATE_DHKEY_COMPLETE			EVTMASK_ID(EVTMASK_CLASS_LE, 0x0009U)
+#define EVTMASK_LE_ENHANCED_CONNECTION_COMPLETE	EVTMASK_ID(EVTMASK_CLASS_LE, 0x000AU)
+#define EVTMASK_LE_DIRECT_ADVERTISING_REPORT		EVTMASK_ID(EVTMASK_CLASS_LE, 0x000BU)
+
+/*** Vendor events: BlueNRG and HAL ***/
+#define EVTMASK_BLUE_INITIALIZED								EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0001U)
+#define EVTMASK_BLUE_EVENTS_LOST								EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0002U)
+#define EVTMASK_BLUE_CRASH_INFO									EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0003U)
+#define EVTMASK_HAL_END_OF_RADIO_ACTIVITY				EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0004U)
+#define EVTMASK_HAL_SCAN_REQ_REPORT							EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0005U)
+#define EVTMASK_HAL_FW_ERROR										EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0006U)
+
+/*** Vendor events: GAP and L2CAP ***/
+#define EVTMASK_GAP_LIMITED_DISCOVERABLE				EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0400U)
+#define EVTMASK_GAP_PAIRING_COMPLETE						EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0401U)
+#define EVTMASK_GAP_PASS_KEY_REQ								EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0402U)
+#define EVTMASK_GAP_AUTHORIZATION_REQ						EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0403U)
+#define EVTMASK_GAP_SLAVE_SECURITY_INITIATED		EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0404U)
+#define EVTMASK_GAP_BOND_LOST										EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0405U)
+#define EVTMASK_GAP_PROC_COMPLETE								EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0407U)
+#define EVTMASK_GAP_ADDR_NOT_RESOLVED						EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0408U)
+#define EVTMASK_GAP_NUMERIC_COMPARISON_VALUE		EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0409U)
+#define EVTMASK_GAP_KEYPRESS_NOTIFICATION				EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x040AU)
+#define EVTMASK_L2CAP_CONNECTION_UPDATE_RESP		EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0800U)
+#define EVTMASK_L2CAP_PROC_TIMEOUT							EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0801U)
+#define EVTMASK_L2CAP_CONNECTION_UPDATE_REQ			EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0802U)
+#define EVTMASK_L2CAP_COMMAND_REJECT						EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x080AU)
+
+/*** Vendor events: GATT and ATT ***/
+#define EVTMASK_GATT_ATTRIBUTE_MODIFIED					EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C01U)
+#define EVTMASK_GATT_PROC_TIMEOUT								EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C02U)
+#define EVTMASK_ATT_EXCHANGE_MTU_RESP						EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C03U)
+#define EVTMASK_ATT_FIND_INFO_RESP							EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C04U)
+#define EVTMASK_ATT_FIND_BY_TYPE_VALUE_RESP			EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C05U)
+#define EVTMASK_ATT_READ_BY_TYPE_RESP						EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C06U)
+#define EVTMASK_ATT_READ_RESP										EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C07U)
+#define EVTMASK_ATT_READ_BLOB_RESP							EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C08U)
+#define EVTMASK_ATT_READ_MULTIPLE_RESP					EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C09U)
+#define EVTMASK_ATT_READ_BY_GROUP_TYPE_RESP			EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C0AU)
+#define EVTMASK_ATT_PREPARE_WRITE_RESP					EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C0CU)
+#define EVTMASK_ATT_EXEC_WRITE_RESP							EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C0DU)
+#define EVTMASK_GATT_INDICATION									EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C0EU)
+#define EVTMASK_GATT_NOTIFICATION								EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C0FU)
+#define EVTMASK_GATT_PROC_COMPLETE							EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C10U)
+#define EVTMASK_GATT_ERROR_RESP									EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C11U)
+#define EVTMASK_GATT_DISC_READ_CHAR_BY_UUID_RESP	EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C12U)
+#define EVTMASK_GATT_WRITE_PERMIT_REQ						EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C13U)
+#define EVTMASK_GATT_READ_PERMIT_REQ						EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C14U)
+#define EVTMASK_GATT_READ_MULTI_PERMIT_REQ			EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C15U)
+#define EVTMASK_GATT_TX_POOL_AVAILABLE					EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C16U)
+#define EVTMASK_GATT_SERVER_CONFIRMATION				EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C17U)
+#define EVTMASK_GATT_PREPARE_WRITE_PERMIT_REQ		EVTMASK_ID(EVTMASK_CLASS_VENDOR, 0x0C18U)
+
+/* Events known, one per entry of the dispatch tables */
+#define EVTMASK_EVENTS										60U
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	EVTMASK_OK = 0x00,
+	EVTMASK_ERROR_UNKNOWN,						/* Not an event of the dispatch tables */
+	EVTMASK_ERROR_ACI,
+
+} EvtMask_Status_t;
+
+/**
+  * @brief Masks of the five event mask commands, in the format they take
+  */
+typedef struct
+{
+	uint8_t HCI[8];										/* hci_set_event_mask */
+	uint8_t LE[8];										/* hci_le_set_event_mask */
+	uint16_t GAP;											/* aci_gap_set_event_mask, L2CAP events too */
+	uint32_t GATT;										/* aci_gatt_set_event_mask */
+	uint32_t HAL;											/* aci_hal_set_event_mask */
+
+} EvtMask_Masks_t;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+void EvtMask_Init(void);
+EvtMask_Status_t EvtMask_Register(uint32_t Event);
+EvtMask_Status_t EvtMask_RegisterList(const uint32_t *pEvents, uint8_t Count);
+uint8_t EvtMask_IsRegistered(uint32_t Event);
+void EvtMask_GetMasks(EvtMask_Masks_t *pMasks);
+EvtMask_Status_t EvtMask_Apply(void);
+uint8_t EvtMask_Check(uint32_t Event);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __EVENT_MASK_H */
+
+
+/******************************************* END OF FILE *******************************************/
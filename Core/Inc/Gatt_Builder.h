@@ -0,0 +1,109 @@
+/**
+  **************************************************************************************************
+  * @file           : Gatt_Builder.h
+  * @brief          : Header for Gatt_Builder.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __GATT_BUILDER_H
+#define __GATT_BUILDER_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/* Commands in flight at most, further bound by the credits of the controller. The responses
+	 wait in the HCI event queue (HCI_READ_PACKET_NUM_MAX packets) */
+#define GATTBUILD_WINDOW									4U
+
+/* Attributes added by one GattBuild_Run(): services, characteristics and user descriptions */
+#define GATTBUILD_MAX_ITEMS								96U
+
+/* Largest writable user description */
+#define GATTBUILD_NAME_MAX								32U
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	GATTBUILD_OK = 0x00,
+	GATTBUILD_ERROR_PARAM,
+	GATTBUILD_ERROR_ACI,												/* Rejected even with the actual handles */
+	GATTBUILD_ERROR_TIMEOUT,
+
+} GattBuild_Status_t;
+
+/**
+  * @brief Characteristic, 128-bit UUID. The controller adds the CCCD of a notify or indicate
+  *				 characteristic itself, the user description (pName) follows it.
+  */
+typedef struct
+{
+	const uint8_t *pUuid;
+	uint16_t Max_Length;
+	uint8_t Properties;												/* CHAR_PROP_x */
+	uint8_t Evt_Mask;													/* GATT_x_EVENTS */
+	uint8_t Is_Variable;											/* CHAR_VALUE_LEN_x */
+	const char *pName;												/* User description, NULL for none */
+	uint8_t Name_Access;											/* ATTR_ACCESS_READ_ONLY or ATTR_ACCESS_READ_WRITE */
+	uint16_t *pHandle;												/* Declaration handle, the value is at +1 */
+
+} GattBuild_Char_t;
+
+/**
+  * @brief Primary service, 128-bit UUID
+  */
+typedef struct
+{
+	const uint8_t *pUuid;
+	uint8_t Max_Records;											/* Reserved handles, 0: the records of pChars */
+	const GattBuild_Char_t *pChars;
+	uint8_t Chars;
+	uint16_t *pHandle;
+
+} GattBuild_Service_t;
+
+typedef struct
+{
+	uint32_t Commands;
+	uint32_t Predicted;												/* Handles returned as predicted */
+	uint32_t Mispredicted;
+	uint32_t Resent;													/* Commands sent again with the actual handles */
+	uint32_t Build_ms;
+
+} GattBuild_Stats_t;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+/*** Handle layout ***/
+uint8_t GattBuild_CharRecords(const GattBuild_Char_t *pChar);
+uint8_t GattBuild_ServiceRecords(const GattBuild_Service_t *pService);
+uint16_t GattBuild_PredictChar(const GattBuild_Service_t *pService, uint16_t Service_Handle, uint8_t Index);
+
+/*** Construction ***/
+GattBuild_Status_t GattBuild_Run(const GattBuild_Service_t *pServices, uint8_t Services);
+const GattBuild_Stats_t *GattBuild_GetStats(void);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __GATT_BUILDER_H */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,136 @@
+/**
+  **************************************************************************************************
+  * @file           : Gatt_Cache.h
+  * @brief          : Header for Gatt_Cache.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __GATT_CACHE_H
+#define __GATT_CACHE_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+#include "KV_Store.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/* Peers remembered, the least recently discovered one is replaced */
+#define GATTCACHE_PEERS										2U
+/* Key-value records per peer, the image is split over them */
+#define GATTCACHE_CHUNKS									6U
+#define GATTCACHE_IMAGE_SIZE							(GATTCACHE_CHUNKS * KVSTORE_MAX_VALUE_SIZE)
+
+/* How the cached database is validated on reconnect */
+#define GATTCACHE_HASH_NONE								((uint8_t)0x00)
+#define GATTCACHE_HASH_DATABASE						((uint8_t)0x01)		/* Database Hash characteristic (0x2B2A) */
+#define GATTCACHE_HASH_SERVICES						((uint8_t)0x02)		/* CRC-32 of the primary service list */
+
+#define GATTCACHE_VERSION									((uint8_t)0x01)
+
+/* Worst case of saving a full image (GATTCACHE_CHUNKS key-value writes) */
+#define GATTCACHE_SAVE_US									2000U
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	GATTCACHE_OK = 0x00,
+	GATTCACHE_ERROR_PARAM,
+	GATTCACHE_ERROR_NOT_READY,
+	GATTCACHE_ERROR_NOT_FOUND,
+
+} GattCache_Status_t;
+
+typedef enum
+{
+	GATTCACHE_STATE_IDLE = 0x00,
+	GATTCACHE_STATE_READ_HASH,				/* Reading the peer Database Hash */
+	GATTCACHE_STATE_DISC_SERVICES,
+	GATTCACHE_STATE_DISC_CHARS,
+	GATTCACHE_STATE_READY,
+	GATTCACHE_STATE_FAILED,
+
+} GattCache_State_t;
+
+/**
+  * @brief Start of a cache image. Records follow: a tag byte (GATTCACHE_REC_x, bit 7 set for a
+  *				 128-bit UUID), then for a service Start and End handles and the UUID, for a
+  *				 characteristic the declaration handle, properties, value handle and the UUID.
+  */
+typedef struct
+{
+	uint32_t Seq;											/* Save counter, orders the peers by age */
+	uint16_t Length;									/* Header and records, bytes */
+	uint16_t Round_Trips;							/* ATT round trips the discovery took */
+	uint8_t Version;
+	uint8_t Hash_Type;								/* GATTCACHE_HASH_x */
+	uint8_t Peer_Addr_Type;
+	uint8_t Services;									/* Service records, stored first */
+	uint8_t Peer_Addr[6];
+	uint16_t Services_Length;					/* Bytes of service records */
+	uint8_t Hash[16];
+
+} GattCache_Header_t;
+
+typedef struct
+{
+	GattCache_Header_t Header;
+	uint8_t Records[GATTCACHE_IMAGE_SIZE - sizeof(GattCache_Header_t)];
+
+} GattCache_Image_t;
+
+typedef struct
+{
+	uint32_t Connections;
+	uint32_t Hits;										/* Cache reused after validation */
+	uint32_t Misses;									/* Full discovery needed */
+	uint32_t Round_Trips;							/* ATT round trips spent */
+	uint32_t Round_Trips_Saved;				/* Discovery round trips avoided by hits */
+	uint32_t Saves;
+	uint32_t Overflows;								/* Databases too large for an image */
+	uint32_t Errors;
+
+} GattCache_Stats_t;
+
+/* Called once the handles of the peer are known */
+typedef void (*GattCache_ReadyFunc_t)(uint16_t Connection_Handle, uint8_t From_Cache);
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+void GattCache_Init(void);
+void GattCache_SetCallback(GattCache_ReadyFunc_t Ready);
+void GattCache_Connect(uint16_t Connection_Handle, uint8_t Peer_Addr_Type, const uint8_t Peer_Addr[6]);
+void GattCache_Disconnect(uint16_t Connection_Handle);
+void GattCache_Process(void);
+GattCache_State_t GattCache_GetState(void);
+
+GattCache_Status_t GattCache_FindService(uint8_t UUID_Type, const uint8_t *pUUID, uint16_t *pStart, uint16_t *pEnd);
+GattCache_Status_t GattCache_FindChar(uint16_t Start, uint16_t End, uint8_t UUID_Type, const uint8_t *pUUID,
+																			uint16_t *pValue_Handle, uint8_t *pProperties);
+GattCache_Status_t GattCache_Forget(uint8_t Peer_Addr_Type, const uint8_t Peer_Addr[6]);
+
+const GattCache_Stats_t *GattCache_GetStats(void);
+void GattCache_ResetStats(void);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __GATT_CACHE_H */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,80 @@
+/**
+  **************************************************************************************************
+  * @file           : Hci_Monitor.h
+  * @brief          : Header for Hci_Monitor.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __HCI_MONITOR_H
+#define __HCI_MONITOR_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+#include "hci_tl.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/* Bits of the aci_blue_events_lost_event bitmap the application recovers from */
+#define HCIMON_LOST_DISCONNECTION					((uint64_t)0x0000000000000001ULL)
+#define HCIMON_LOST_ATTRIBUTE_MODIFIED		((uint64_t)0x0000000000100000ULL)
+#define HCIMON_LOST_TX_POOL_AVAILABLE			((uint64_t)0x0000020000000000ULL)
+#define HCIMON_LOST_CONNECTION_COMPLETE		((uint64_t)0x0000100000000000ULL)
+#define HCIMON_LOST_CONN_UPDATE_COMPLETE	((uint64_t)0x0000400000000000ULL)
+
+/* Event classes of the bitmap */
+#define HCIMON_LOST_CLASSES								64U
+
+/* Load evaluation period, in ms */
+#define HCIMON_PERIOD_MS									1000U
+/* Periods without pressure before the reserve pool stops being lent */
+#define HCIMON_QUIET_PERIODS							10U
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+/**
+  * @brief Called from HciMon_Process() with the events lost since the previous call
+  */
+typedef void (*HciMon_RecoveryFunc_t)(uint64_t Lost_Events);
+
+typedef struct
+{
+	uint32_t Lost_Reports;						/* aci_blue_events_lost_event received */
+	uint64_t Lost_Mask;								/* Every class lost since the reset */
+	uint16_t Lost_Count[HCIMON_LOST_CLASSES];	/* Reports per class */
+	uint32_t Recoveries;							/* Recovery callbacks run */
+	uint32_t Reserve_Enables;					/* Times the reserve pool started being lent */
+	uint8_t Reserve_Active;
+
+} HciMon_Stats_t;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+void HciMon_Init(void);
+void HciMon_SetRecovery(HciMon_RecoveryFunc_t Recovery);
+void HciMon_Process(void);
+const HciMon_Stats_t *HciMon_GetStats(void);
+const tHciStats *HciMon_GetHciStats(void);
+void HciMon_ResetStats(void);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __HCI_MONITOR_H */
+
+
+/******************************************* END OF FILE *******************************************/
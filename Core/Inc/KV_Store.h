@@ -0,0 +1,115 @@
+/**
+  **************************************************************************************************
+  * @file           : KV_Store.h
+  * @brief          : Header for KV_Store.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __KV_STORE_H
+#define __KV_STORE_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/**
+  * @brief Flash area reserved for the key-value store
+	*
+	* Two 16KB sectors (2 and 3) of the STM32F411RE are used in turn: records are appended to the
+	* active sector and, once it is full, the live records are compacted into the other one. They
+	* sit between the bootloader and the application (see Ota_Image.h), a firmware update does not
+	* erase them.
+	*/
+#define KVSTORE_SECTOR_A_ID							FLASH_SECTOR_2
+#define KVSTORE_SECTOR_A_ADDR						((uint32_t)0x08008000)
+#define KVSTORE_SECTOR_B_ID							FLASH_SECTOR_3
+#define KVSTORE_SECTOR_B_ADDR						((uint32_t)0x0800C000)
+#define KVSTORE_SECTOR_SIZE							((uint32_t)0x4000)
+
+/* Keys are used directly as index in the RAM table, so they must be below KVSTORE_MAX_KEYS */
+#define KVSTORE_MAX_KEYS								32
+#define KVSTORE_MAX_VALUE_SIZE					64
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	KVSTORE_OK = 0x00,
+	KVSTORE_ERROR_NOT_FOUND,
+	KVSTORE_ERROR_PARAM,
+	KVSTORE_ERROR_CRC,
+	KVSTORE_ERROR_FULL,
+	KVSTORE_ERROR_FLASH,
+
+} KVStore_Status_t;
+
+/**
+  * @brief Keys of the records kept in the store
+  */
+typedef enum
+{
+	KVSTORE_KEY_DEVICE_IDENTITY = 0x01,			/* Device_Identity_t */
+	/* 0x02 and 0x03 held the last connection parameters and an application setting, nothing read
+	   them back. Not reused: a record left by an older firmware is never mistaken for a new key */
+	KVSTORE_KEY_FW_UPDATE = 0x04,						/* BlueNRG-2 update progress (Updater_Port.c) */
+	KVSTORE_KEY_GATT_CACHE = 0x10,					/* GATT client cache, GATTCACHE_PEERS x GATTCACHE_CHUNKS keys (Gatt_Cache.c) */
+
+} KVStore_Key_t;
+
+/**
+  * @brief Flash access routines used by the store. Sector is 0 or 1 and Offset is relative to
+  *				 the start of that sector. Replace with KVStore_RegisterIO() to run the store on another
+  *				 medium (e.g. a file-backed image when testing on the host).
+  */
+typedef struct
+{
+	int32_t (*Erase)(uint8_t Sector);
+	int32_t (*Program)(uint8_t Sector, uint32_t Offset, uint32_t Data);
+	int32_t (*Read)(uint8_t Sector, uint32_t Offset, void *pData, uint32_t Length);
+
+} KVStore_IO_t;
+
+/**
+  * @brief Persistent identity of the device: public address and the discovery time derived
+  *				 together with it on first boot
+  */
+typedef struct
+{
+	uint8_t BD_Addr[6];
+	uint16_t Discovery_Time;
+
+} Device_Identity_t;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+void KVStore_RegisterIO(const KVStore_IO_t *fops);
+KVStore_Status_t KVStore_Init(void);
+KVStore_Status_t KVStore_Read(uint16_t Key, void *pValue, uint16_t *pLength);
+KVStore_Status_t KVStore_Write(uint16_t Key, const void *pValue, uint16_t Length);
+KVStore_Status_t KVStore_Delete(uint16_t Key);
+KVStore_Status_t KVStore_Compact(void);
+uint32_t KVStore_CRC32(uint32_t Crc, const uint8_t *pData, uint32_t Length);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __KV_STORE_H */
+
+
+/******************************************* END OF FILE *******************************************/
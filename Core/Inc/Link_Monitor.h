@@ -0,0 +1,144 @@
+/**
+  **************************************************************************************************
+  * @file           : Link_Monitor.h
+  * @brief          : Header for Link_Monitor.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __LINK_MONITOR_H
+#define __LINK_MONITOR_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/* Links reported by aci_hal_get_link_status */
+#define LINKMON_MAX_LINKS									8U
+
+/* Sampling period of the connected links, in ms */
+#define LINKMON_PERIOD_MS									500U
+
+/* RSSI and loss smoothing: exponential averages with a weight of 1/2^shift per sample */
+#define LINKMON_RSSI_SHIFT								2U
+#define LINKMON_LOSS_SHIFT								2U
+
+/**
+  * @brief Control window on the RSSI estimated at the peer, in dBm. Below TARGET_LOW the power is
+  *				 raised at once, above TARGET_HIGH it is lowered after LINKMON_LOWER_HOLD samples, as long
+  *				 as the estimate stays above TARGET_HIGH once lowered. The gap is the hysteresis.
+  */
+#define LINKMON_TARGET_LOW_DBM						(-80)
+#define LINKMON_TARGET_HIGH_DBM						(-65)
+#define LINKMON_LOWER_HOLD								6U
+
+/* Loss ratio (per 256) above which the power is raised, and below which it may be lowered */
+#define LINKMON_LOSS_HIGH									13U				/* 5% */
+#define LINKMON_LOSS_LOW									3U				/* 1% */
+
+/* TX power assumed for the peer, the RSSI measured here tells the path loss from it */
+#define LINKMON_PEER_TX_DBM								0
+
+/* Level used when no link is connected: high power, PA level 4 (-2 dBm) */
+#define LINKMON_DEFAULT_LEVEL							5U
+
+/* RSSI value returned when it could not be measured */
+#define LINKMON_RSSI_UNAVAILABLE					((int8_t)127)
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	LINKMON_OK = 0x00,
+	LINKMON_ERROR_PARAM,
+	LINKMON_ERROR_NOT_FOUND,
+	LINKMON_ERROR_ACI,
+
+} LinkMon_Status_t;
+
+/**
+  * @brief One step of the TX power ladder
+  */
+typedef struct
+{
+	uint8_t En_High_Power;
+	uint8_t PA_Level;
+	int8_t Power_dBm;
+
+} LinkMon_Level_t;
+
+/**
+  * @brief Power controller of one link. Pure state: LinkMon_CtrlUpdate() does not touch the
+  *				 hardware and can be fed scripted RSSI traces.
+  */
+typedef struct
+{
+	int16_t RSSI_Q4;									/* Smoothed RSSI, dBm in Q4 */
+	uint16_t Loss_Q4;									/* Smoothed loss ratio, per 256 in Q4 */
+	uint8_t Level;										/* Wanted index in the power ladder */
+	uint8_t Hold;											/* Samples spent with room to lower the power */
+	uint8_t Started;
+
+} LinkMon_Ctrl_t;
+
+/**
+  * @brief Diagnostics of one link
+  */
+typedef struct
+{
+	uint16_t Connection_Handle;
+	uint8_t Link_Status;							/* As reported by aci_hal_get_link_status */
+	uint8_t Level;										/* Wanted index in the power ladder */
+	int8_t RSSI_Last;
+	int8_t RSSI_Avg;
+	int8_t RSSI_Min;
+	int8_t RSSI_Max;
+	int8_t Peer_RSSI;									/* Estimated RSSI at the peer with the applied power */
+	uint8_t Loss;											/* Smoothed loss ratio, per 256 */
+	uint16_t Raises;
+	uint16_t Lowers;
+	uint32_t Samples;
+	uint32_t Tx_Packets;
+	uint32_t Tx_Failed;
+
+} LinkMon_Stats_t;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+/*** Controller ***/
+void LinkMon_CtrlInit(LinkMon_Ctrl_t *pCtrl, uint8_t Level);
+uint8_t LinkMon_CtrlUpdate(LinkMon_Ctrl_t *pCtrl, int8_t RSSI, uint16_t Sent, uint16_t Failed);
+int8_t LinkMon_PeerRSSI(const LinkMon_Ctrl_t *pCtrl, uint8_t Level);
+const LinkMon_Level_t *LinkMon_GetLevel(uint8_t Level);
+uint8_t LinkMon_LevelCount(void);
+
+/*** Monitor ***/
+LinkMon_Status_t LinkMon_Init(void);
+void LinkMon_Process(void);
+void LinkMon_ReportTx(uint16_t Connection_Handle, uint16_t Sent, uint16_t Failed);
+LinkMon_Status_t LinkMon_GetStats(uint16_t Connection_Handle, LinkMon_Stats_t *pStats);
+uint8_t LinkMon_GetLinks(LinkMon_Stats_t *pStats, uint8_t Max);
+int8_t LinkMon_GetTxPower(void);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __LINK_MONITOR_H */
+
+
+/******************************************* END OF FILE *******************************************/
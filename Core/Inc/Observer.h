@@ -0,0 +1,163 @@
+/**
+  **************************************************************************************************
+  * @file           : Observer.h
+  * @brief          : Header for Observer.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __OBSERVER_H
+#define __OBSERVER_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/* Advertisers tracked at once: table slots (power of two) and the load they are limited to */
+#define OBSERVER_TABLE_BITS								8U
+#define OBSERVER_TABLE_SIZE								(1U << OBSERVER_TABLE_BITS)
+#define OBSERVER_MAX_DEVICES							((OBSERVER_TABLE_SIZE * 3U) / 4U)
+
+/* RSSI smoothing: exponential average with a weight of 1/2^OBSERVER_RSSI_SHIFT per report */
+#define OBSERVER_RSSI_SHIFT								3U
+
+/* Devices not heard for this long are dropped, in ms */
+#define OBSERVER_TIMEOUT_MS								30000U
+/* Table slots checked for expiry at each Observer_Process() call */
+#define OBSERVER_SWEEP_SLOTS							8U
+
+/* Callback flags */
+#define OBSERVER_FLAG_NEW									((uint8_t)0x01)		/* First report of the device */
+#define OBSERVER_FLAG_CHANGED							((uint8_t)0x02)		/* Advertising or scan response data changed */
+
+/* Advertising report event types */
+#define OBSERVER_EVENT_SCAN_RSP						((uint8_t)0x04)
+
+/* RSSI value reported when the controller could not measure it */
+#define OBSERVER_RSSI_UNAVAILABLE					((int8_t)127)
+
+/* Set to 1 to build Observer_Benchmark() */
+#ifndef OBSERVER_BENCHMARK
+#define OBSERVER_BENCHMARK								0
+#endif
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	OBSERVER_OK = 0x00,
+	OBSERVER_ERROR_PARAM,
+	OBSERVER_ERROR_ACI,
+
+} Observer_Status_t;
+
+/**
+  * @brief One advertising report, pointing into the HCI event buffer (valid during the callback only)
+  */
+typedef struct
+{
+	uint8_t Event_Type;								/* ADV_IND, ADV_DIRECT_IND, ADV_SCAN_IND, ADV_NONCONN_IND, SCAN_RSP */
+	uint8_t Address_Type;
+	const uint8_t *pAddress;					/* 6 bytes, little endian */
+	uint8_t Length_Data;
+	const uint8_t *pData;
+	int8_t RSSI;
+
+} Observer_Report_t;
+
+/**
+  * @brief Walks the reports of an LE Advertising Report event in place
+  */
+typedef struct
+{
+	const uint8_t *pPos;
+	const uint8_t *pEnd;
+	uint8_t Remaining;
+
+} Observer_Iter_t;
+
+/**
+  * @brief Aggregated state of one advertiser
+  */
+typedef struct
+{
+	uint8_t Address[6];
+	uint8_t Address_Type;
+	uint8_t Used;
+	uint8_t Event_Type;								/* Type of the last advertisement (not scan response) */
+	int8_t RSSI_Last;
+	int16_t RSSI_Q4;									/* Smoothed RSSI, dBm in Q4 */
+	uint32_t Adv_Hash;								/* Hash of the advertising data */
+	uint32_t Scan_Hash;								/* Hash of the scan response data */
+	uint32_t First_Seen;							/* ms */
+	uint32_t Last_Seen;								/* ms */
+	uint16_t Reports;
+	uint16_t Changes;
+
+} Observer_Device_t;
+
+typedef struct
+{
+	uint32_t Events;									/* LE Advertising Report events */
+	uint32_t Reports;
+	uint32_t New_Devices;
+	uint32_t Changes;									/* Reports whose data changed */
+	uint32_t Expired;
+	uint32_t Dropped_Full;						/* Reports of new devices with the table full */
+	uint32_t Malformed;								/* Events with inconsistent lengths */
+	uint16_t Devices;									/* Devices in the table */
+	uint16_t Max_Probe;								/* Longest probe sequence seen */
+
+} Observer_Stats_t;
+
+typedef void (*Observer_Callback_t)(const Observer_Device_t *pDevice, const Observer_Report_t *pReport, uint8_t Flags);
+typedef void (*Observer_ForEachFunc_t)(const Observer_Device_t *pDevice, void *pContext);
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+/*** Report parsing ***/
+uint8_t Observer_IterInit(Observer_Iter_t *pIter, const uint8_t *pEvent, uint16_t Length);
+uint8_t Observer_IterNext(Observer_Iter_t *pIter, Observer_Report_t *pReport);
+
+/*** Device table ***/
+void Observer_Init(void);
+void Observer_SetCallback(Observer_Callback_t Callback);
+void Observer_ProcessEvent(const uint8_t *pEvent, uint16_t Length, uint32_t Time);
+void Observer_Expire(uint32_t Time, uint16_t Slots);
+const Observer_Device_t *Observer_Find(const uint8_t Address[6], uint8_t Address_Type);
+void Observer_ForEach(Observer_ForEachFunc_t Func, void *pContext);
+const Observer_Stats_t *Observer_GetStats(void);
+void Observer_ResetStats(void);
+
+/*** Scanning ***/
+Observer_Status_t Observer_Start(uint16_t Scan_Interval, uint16_t Scan_Window);
+Observer_Status_t Observer_Stop(void);
+uint8_t Observer_HandleEvent(const uint8_t *pEvent, uint16_t Length);
+void Observer_Process(void);
+
+#if OBSERVER_BENCHMARK
+uint32_t Observer_Benchmark(uint16_t Devices, uint32_t Reports);
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __OBSERVER_H */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,85 @@
+/**
+  **************************************************************************************************
+  * @file           : Ota_Image.h
+  * @brief          : Flash layout of the firmware update, shared by the application and the
+	*									bootloader
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __OTA_IMAGE_H
+#define __OTA_IMAGE_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/**
+  * @brief Flash of the STM32F411RE (single bank, 512KB)
+	*
+	*		Sectors 0-1		0x08000000	 32KB		Bootloader
+	*		Sectors 2-3		0x08008000	 32KB		Key-value store (KV_Store.h)
+	*		Sectors 4-5		0x08010000	192KB		Application, IROM1 of the MDK-ARM project
+	*		Sectors 6-7		0x08040000	256KB		Staging area of the received image, header at its end
+	*
+	* The part has a single bank: the "bank swap" is a copy of the staging area into the application
+	* sectors, done by the bootloader at reset.
+	*/
+#define OTA_BOOT_ADDR										((uint32_t)0x08000000)
+#define OTA_APP_ADDR										((uint32_t)0x08010000)
+#define OTA_APP_SIZE										((uint32_t)0x00030000)
+#define OTA_APP_FIRST_SECTOR						4U
+#define OTA_APP_SECTORS									2U
+
+#define OTA_STAGING_ADDR								((uint32_t)0x08040000)
+#define OTA_STAGING_SIZE								((uint32_t)0x00040000)
+#define OTA_STAGING_FIRST_SECTOR				6U
+#define OTA_STAGING_SECTORS							2U
+
+/* Largest image, it has to fit in the application sectors */
+#define OTA_MAX_IMAGE_SIZE							OTA_APP_SIZE
+
+/* Header written at the end of the staging area once the image is verified */
+#define OTA_HEADER_ADDR									(OTA_STAGING_ADDR + OTA_STAGING_SIZE - sizeof(Ota_Header_t))
+#define OTA_HEADER_MAGIC								((uint32_t)0x3141544FU)		/* "OTA1" */
+
+/* Check word of a valid header */
+#define OTA_HEADER_CHECK(h)							((uint32_t)(~(h)->Magic ^ (h)->Size ^ (h)->Crc))
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+/**
+  * @brief Update request left to the bootloader. CRC: hardware CRC unit (CRC-32/MPEG-2) over the
+  *				 image read as little-endian words, the last one padded with 0xFF.
+  *				 The bootloader clears Magic (programs it to 0) once the image is installed.
+  */
+typedef struct
+{
+	uint32_t Magic;
+	uint32_t Size;										/* Bytes */
+	uint32_t Crc;
+	uint32_t Check;										/* OTA_HEADER_CHECK() */
+
+} Ota_Header_t;
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __OTA_IMAGE_H */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,140 @@
+/**
+  **************************************************************************************************
+  * @file           : Ota_Update.h
+  * @brief          : Header for Ota_Update.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __OTA_UPDATE_H
+#define __OTA_UPDATE_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+#include "Ota_Image.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/* Set to 0 to remove the update service from the GATT database of the peripheral (host tests) */
+#ifndef OTA_ENABLE
+#define OTA_ENABLE												1
+#endif
+
+/**
+  * @brief Data packet: sequence number (u16, little endian) and image bytes. The largest packet is
+  *				 bound by the HCI event carrying it (255 bytes, HCI_READ_PACKET_SIZE): the peer sends
+  *				 min(ATT_MTU - 3, OTA_MAX_PACKET) bytes.
+  */
+#define OTA_MAX_PACKET										242U
+#define OTA_MAX_DATA											(OTA_MAX_PACKET - 2U)
+
+/* Packets the peer may send past the last acknowledgement, acknowledged every half window */
+#define OTA_WINDOW												16U
+
+/* Received bytes not yet programmed, must hold at least two windows */
+#define OTA_RING_SIZE											8192U
+
+/* Bytes programmed per radio scheduler job, and the time it takes (16 us per word typical) */
+#define OTA_PROGRAM_CHUNK									256U
+#define OTA_PROGRAM_US										1200U
+
+/* Time given to the last notification before the reset that installs the image, in ms */
+#define OTA_RESET_DELAY_MS								500U
+
+/* Control characteristic: commands, first byte of the write */
+#define OTA_CMD_START											((uint8_t)0x01)		/* Image size (u32), CRC (u32) */
+#define OTA_CMD_ABORT											((uint8_t)0x02)
+#define OTA_CMD_APPLY											((uint8_t)0x03)		/* Install the verified image and reset */
+
+/* Control characteristic: notifications, event (u8), status (u8), offset (u32), sequence (u16) */
+#define OTA_EVT_ACK												((uint8_t)0x10)		/* Send from offset/sequence, one window */
+#define OTA_EVT_NACK											((uint8_t)0x11)		/* Packet lost: go back to offset/sequence */
+#define OTA_EVT_VERIFIED									((uint8_t)0x12)		/* Image received, status of the CRC check */
+#define OTA_EVT_APPLYING									((uint8_t)0x13)
+#define OTA_EVT_ERROR											((uint8_t)0x1F)
+#define OTA_NOTIFY_SIZE										8U
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	OTA_OK = 0x00,
+	OTA_ERROR_PARAM,
+	OTA_ERROR_SIZE,										/* Image larger than the application sectors */
+	OTA_ERROR_STATE,
+	OTA_ERROR_FLASH,
+	OTA_ERROR_CRC,
+	OTA_ERROR_IMAGE,									/* Not linked for OTA_APP_ADDR */
+	OTA_ERROR_ACI,
+
+} Ota_Status_t;
+
+typedef enum
+{
+	OTA_RX_OK = 0x00,
+	OTA_RX_DROPPED,										/* Out of order or no room, an acknowledgement tells where to resume */
+	OTA_RX_INVALID,										/* Malformed or beyond the image */
+
+} Ota_RxResult_t;
+
+/**
+  * @brief Reception of the image. Pure state: packets are fed with Ota_RxPacket(), the bytes to be
+  *				 programmed are taken with Ota_RxPending(), it can be run on the host.
+  */
+typedef struct
+{
+	uint32_t Image_Size;
+	uint32_t Received;								/* Bytes accepted, in order */
+	uint32_t Programmed;							/* Bytes written into the staging area */
+	uint32_t Acked;										/* Received at the last acknowledgement */
+	uint32_t Packets;
+	uint32_t Dropped;
+	uint32_t Nacks;
+	uint16_t Next_Seq;
+	uint8_t Since_Ack;								/* Packets accepted since the last acknowledgement */
+	uint8_t Nack_Pending;							/* A packet was lost, go back to Received */
+	uint8_t Nack_Sent;								/* Drop silently until the packet asked for arrives */
+	uint8_t Ring[OTA_RING_SIZE];
+
+} Ota_Rx_t;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+/*** Reception ***/
+void Ota_RxInit(Ota_Rx_t *pRx, uint32_t Image_Size);
+Ota_RxResult_t Ota_RxPacket(Ota_Rx_t *pRx, const uint8_t *pPacket, uint16_t Length);
+uint8_t Ota_RxAckDue(const Ota_Rx_t *pRx);
+void Ota_RxAcked(Ota_Rx_t *pRx);
+uint16_t Ota_RxPending(const Ota_Rx_t *pRx, const uint8_t **ppData);
+void Ota_RxProgrammed(Ota_Rx_t *pRx, uint16_t Length);
+
+/*** Service ***/
+#if OTA_ENABLE
+Ota_Status_t Ota_Init(void);
+uint8_t Ota_AttributeModified(uint16_t Connection_Handle, uint16_t Attr_Handle, uint16_t Length, const uint8_t *pData);
+void Ota_Disconnect(void);
+void Ota_Process(void);
+const Ota_Rx_t *Ota_GetRx(void);
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __OTA_UPDATE_H */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,78 @@
+/**
+  **************************************************************************************************
+  * @file           : Payload_Codec.h
+  * @brief          : Header for Payload_Codec.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __PAYLOAD_CODEC_H
+#define __PAYLOAD_CODEC_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/**
+  * @brief Frame header, first byte of every frame: codec in the high nibble, codec parameter in the
+  *				 low nibble (channels - 1 for CODEC_DELTA16, dictionary for CODEC_LZ)
+  */
+#define CODEC_RAW													((uint8_t)0x00)
+#define CODEC_DELTA16											((uint8_t)0x01)		/* Zig-zag varint deltas of int16 samples */
+#define CODEC_LZ													((uint8_t)0x02)		/* LZ77 over a static dictionary */
+
+#define CODEC_HEADER(Codec, Param)				((uint8_t)(((Codec) << 4) | ((Param) & 0x0FU)))
+#define CODEC_HEADER_CODEC(Header)				((uint8_t)((Header) >> 4))
+#define CODEC_HEADER_PARAM(Header)				((uint8_t)((Header) & 0x0FU))
+
+#define CODEC_MAX_CHANNELS								16U
+
+/* Dictionary built in, a decoder has to hold the same one */
+#define CODEC_DICT_ID											((uint8_t)0x01)
+
+/* Bytes of a record compressed at once */
+#define CODEC_MAX_INPUT										255U
+
+/* Matches tried per position, bounds the encoding time */
+#define CODEC_LZ_MAX_CHAIN								16U
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	CODEC_OK = 0x00,
+	CODEC_ERROR_PARAM,
+	CODEC_ERROR_FORMAT,								/* Malformed frame */
+	CODEC_ERROR_OVERFLOW,							/* Output buffer too small */
+
+} Codec_Status_t;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+uint16_t Codec_EncodeDelta16(const int16_t *pSamples, uint16_t Count, uint8_t Channels,
+														 uint8_t *pFrame, uint16_t Max, uint16_t *pConsumed);
+uint16_t Codec_EncodeLZ(const uint8_t *pData, uint16_t Length, uint8_t *pFrame, uint16_t Max);
+uint16_t Codec_EncodeRecord(const uint8_t *pData, uint16_t Length, uint8_t *pFrame, uint16_t Max);
+Codec_Status_t Codec_Decode(const uint8_t *pFrame, uint16_t Length, uint8_t *pOut, uint16_t Max, uint16_t *pDecoded);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __PAYLOAD_CODEC_H */
+
+
+/******************************************* END OF FILE *******************************************/
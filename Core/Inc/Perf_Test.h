@@ -0,0 +1,123 @@
+/**
+  **************************************************************************************************
+  * @file           : Perf_Test.h
+  * @brief          : Header for Perf_Test.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __PERF_TEST_H
+#define __PERF_TEST_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/* Set to 1 to add the test service to the GATT database of the peripheral */
+#ifndef PERFTEST_ENABLE
+#define PERFTEST_ENABLE										0
+#endif
+
+/* Data characteristic, sized for the default ATT MTU (23) */
+#define PERFTEST_MAX_PAYLOAD							20U
+#define PERFTEST_MIN_PAYLOAD							2U				/* Sequence number */
+
+/* Notifications queued at most per refill, bounds the time spent before a connection event */
+#define PERFTEST_MAX_BURST								16U
+
+/* Echo probes not reflected within this time are counted as lost, in ms */
+#define PERFTEST_ECHO_TIMEOUT_MS					2000U
+
+/* Round trip histogram: bin k counts RTTs up to PERFTEST_RTT_BIN0_US << k, the last bin the rest */
+#define PERFTEST_RTT_BINS									8U
+#define PERFTEST_RTT_BIN0_US							7500U
+
+/* Serialized results, see PerfTest_Serialize() */
+#define PERFTEST_RESULTS_SIZE							(1U + (5U * 4U) + 2U + (3U * 4U) + (2U * PERFTEST_RTT_BINS))
+
+/* Control characteristic commands, first byte of the write */
+#define PERFTEST_CMD_STOP									((uint8_t)0x00)
+#define PERFTEST_CMD_SOURCE								((uint8_t)0x01)		/* Payload length (u8), duration in s (u16, 0: until stopped) */
+#define PERFTEST_CMD_SINK									((uint8_t)0x02)
+#define PERFTEST_CMD_ECHO									((uint8_t)0x03)
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	PERFTEST_OK = 0x00,
+	PERFTEST_ERROR_PARAM,
+	PERFTEST_ERROR_ACI,
+
+} PerfTest_Status_t;
+
+typedef enum
+{
+	PERFTEST_MODE_IDLE = 0x00,
+	PERFTEST_MODE_SOURCE,							/* Sequence numbered notifications, as fast as the TX pool allows */
+	PERFTEST_MODE_SINK,								/* Counts written bytes and sequence gaps */
+	PERFTEST_MODE_ECHO,								/* Probes reflected by the peer, round trip times */
+
+} PerfTest_Mode_t;
+
+/**
+  * @brief Results of a run. Pure state: the PerfTest_Sink/Rtt functions take the data as parameters
+  *				 and can be fed on the host.
+  */
+typedef struct
+{
+	uint8_t Mode;
+	uint32_t Duration_ms;
+	uint32_t Bytes;
+	uint32_t Packets;
+	uint32_t Lost;										/* Sink: missing sequence numbers, echo: probes timed out */
+	uint32_t Bytes_Per_s;
+	uint16_t Next_Seq;								/* Sequence number expected or sent next */
+	uint32_t RTT_Min_us;
+	uint32_t RTT_Max_us;
+	uint32_t RTT_Sum_us;
+	uint16_t RTT_Hist[PERFTEST_RTT_BINS];
+
+} PerfTest_Results_t;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+/*** Accounting ***/
+void PerfTest_ResultsInit(PerfTest_Results_t *pResults, uint8_t Mode);
+void PerfTest_SinkUpdate(PerfTest_Results_t *pResults, const uint8_t *pData, uint16_t Length);
+void PerfTest_RttAdd(PerfTest_Results_t *pResults, uint32_t RTT_us);
+uint8_t PerfTest_RttBin(uint32_t RTT_us);
+void PerfTest_Finish(PerfTest_Results_t *pResults, uint32_t Duration_ms);
+uint16_t PerfTest_Serialize(const PerfTest_Results_t *pResults, uint8_t *pBuffer);
+
+/*** Service ***/
+#if PERFTEST_ENABLE
+PerfTest_Status_t PerfTest_Init(void);
+uint8_t PerfTest_AttributeModified(uint16_t Connection_Handle, uint16_t Attr_Handle, uint16_t Length, const uint8_t *pData);
+void PerfTest_Disconnect(void);
+void PerfTest_Process(void);
+const PerfTest_Results_t *PerfTest_GetResults(void);
+#endif
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __PERF_TEST_H */
+
+
+/******************************************* END OF FILE *******************************************/
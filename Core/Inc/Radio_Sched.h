@@ -0,0 +1,126 @@
+/**
+  **************************************************************************************************
+  * @file           : Radio_Sched.h
+  * @brief          : Header for Radio_Sched.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __RADIO_SCHED_H
+#define __RADIO_SCHED_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/**
+  * @brief Radio activities reported by aci_hal_end_of_radio_activity_event, bits of the mask passed
+  *				 to aci_hal_set_radio_activity_mask
+  */
+#define RADIO_ACTIVITY_MASK_IDLE					((uint16_t)0x0001)
+#define RADIO_ACTIVITY_MASK_ADVERTISING		((uint16_t)0x0002)
+#define RADIO_ACTIVITY_MASK_CONN_SLAVE		((uint16_t)0x0004)
+#define RADIO_ACTIVITY_MASK_SCANNING			((uint16_t)0x0008)
+#define RADIO_ACTIVITY_MASK_CONN_REQUEST	((uint16_t)0x0010)
+#define RADIO_ACTIVITY_MASK_CONN_MASTER		((uint16_t)0x0020)
+
+/* Jobs waiting for a gap in the radio activity */
+#define RADIOSCHED_MAX_JOBS								8U
+
+/* Time kept free before every radio activity, in us */
+#define RADIOSCHED_GUARD_US								500U
+/* Length assumed for the activity that just ended, including the event delivery, in us */
+#define RADIOSCHED_ACTIVITY_US						2500U
+/* How long before a connection event the notification buffers are refilled, in us */
+#define RADIOSCHED_REFILL_LEAD_US					1500U
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	RADIOSCHED_OK = 0x00,
+	RADIOSCHED_ERROR_PARAM,
+	RADIOSCHED_ERROR_FULL,
+	RADIOSCHED_ERROR_ACI,
+
+} RadioSched_Status_t;
+
+/**
+  * @brief Radio states as reported in Last_State/Next_State
+  */
+typedef enum
+{
+	RADIO_STATE_IDLE = 0x00,
+	RADIO_STATE_ADVERTISING,
+	RADIO_STATE_CONN_SLAVE,
+	RADIO_STATE_SCANNING,
+	RADIO_STATE_CONN_REQUEST,
+	RADIO_STATE_CONN_MASTER,
+	RADIO_STATE_TX_TEST,
+	RADIO_STATE_RX_TEST,
+
+} RadioSched_State_t;
+
+/**
+  * @brief What a refill managed to queue for the coming connection event
+  */
+typedef enum
+{
+	RADIOSCHED_REFILL_NONE = 0x00,		/* Nothing to send */
+	RADIOSCHED_REFILL_PARTIAL,				/* Some data, the TX buffers are not full */
+	RADIOSCHED_REFILL_FULL,						/* Stopped because the TX buffers are full */
+
+} RadioSched_Refill_t;
+
+typedef void (*RadioSched_Job_t)(void *pContext);
+typedef RadioSched_Refill_t (*RadioSched_RefillFunc_t)(void);
+typedef void (*RadioSched_ActivityFunc_t)(uint8_t Last_State, uint8_t Next_State, uint32_t Next_State_SysTime, uint32_t Time);
+
+typedef struct
+{
+	uint32_t Radio_Events;						/* End of radio activity events received */
+	uint32_t Conn_Events;							/* Connection events among them */
+	uint32_t Conn_Events_Full;				/* Connection events preceded by a refill that filled the buffers */
+	uint32_t Conn_Events_Partial;			/* ... by a refill that queued some data */
+	uint32_t Conn_Events_Empty;				/* ... with nothing queued */
+	uint32_t Refills_Late;						/* Refills done after the connection event already started */
+	uint32_t Jobs_Run;
+	uint32_t Jobs_Deferred;						/* Gaps a job did not fit in */
+	uint32_t Jobs_Overrun;						/* Jobs that ran into the next radio activity */
+
+} RadioSched_Stats_t;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+RadioSched_Status_t RadioSched_Init(uint16_t Activity_Mask);
+RadioSched_Status_t RadioSched_Submit(RadioSched_Job_t Job, void *pContext, uint32_t Duration_us);
+void RadioSched_SetRefill(RadioSched_RefillFunc_t Refill);
+void RadioSched_SetActivityHook(RadioSched_ActivityFunc_t Hook);
+void RadioSched_Process(void);
+uint32_t RadioSched_GetTime(void);
+uint32_t RadioSched_GetFreeTime(void);
+const RadioSched_Stats_t *RadioSched_GetStats(void);
+void RadioSched_ResetStats(void);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __RADIO_SCHED_H */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,107 @@
+/**
+  **************************************************************************************************
+  * @file           : Time_Sync.h
+  * @brief          : Header for Time_Sync.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __TIME_SYNC_H
+#define __TIME_SYNC_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/* Delay between a connection anchor and the processing of its end of radio activity event, in us.
+   It only shifts the estimated phase, calibrate it with a sniffer if absolute alignment matters */
+#define TIMESYNC_EVENT_LATENCY_US					1000U
+
+/* Phase errors are clipped to this value so a late event does not drag the estimate, in us */
+#define TIMESYNC_ERROR_CLIP_US						2000
+/* Phase and period loop gains, as right shifts of the phase error */
+#define TIMESYNC_PHASE_SHIFT							2U
+#define TIMESYNC_PERIOD_SHIFT							6U
+/* The estimate is locked after this many consecutive errors below TIMESYNC_LOCK_ERROR_US */
+#define TIMESYNC_LOCK_COUNT								8U
+#define TIMESYNC_LOCK_ERROR_US						250
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	TIMESYNC_OK = 0x00,
+	TIMESYNC_ERROR_PARAM,
+	TIMESYNC_ERROR_NOT_LOCKED,
+
+} TimeSync_Status_t;
+
+/**
+  * @brief Anchor phase estimate on the local TIM2 timebase. Pure state: the estimator functions
+  *				 do not touch the hardware and can be fed synthetic anchor sequences.
+  */
+typedef struct
+{
+	uint64_t Anchor_Q8;								/* Local time of the last anchor, us in Q8 */
+	uint32_t Period_Q8;								/* Anchor period in local us, Q8 */
+	uint32_t Nominal_Q8;							/* Period announced by the link, Q8 */
+	uint16_t Anchor_Count;						/* Anchors since the estimator started */
+	int32_t Last_Error;								/* Last phase error, us */
+	uint8_t Lock_Count;
+	uint8_t Started;
+
+} TimeSync_Estimator_t;
+
+/**
+  * @brief Anchor-relative timestamp carried with the samples
+  */
+typedef struct
+{
+	uint16_t Anchor_Count;						/* Anchor the sample is referred to */
+	int32_t Offset_us;								/* Sample time minus anchor time */
+
+} TimeSync_Stamp_t;
+
+/* Called once per anchor, Lead_us before it, to sample and queue the data it will carry */
+typedef void (*TimeSync_ProducerFunc_t)(uint16_t Anchor_Count);
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+/*** Estimator ***/
+void TimeSync_EstimatorInit(TimeSync_Estimator_t *pEst, uint32_t Period_us);
+void TimeSync_EstimatorUpdate(TimeSync_Estimator_t *pEst, uint32_t Time, uint32_t Anchors);
+uint8_t TimeSync_EstimatorLocked(const TimeSync_Estimator_t *pEst);
+uint32_t TimeSync_EstimatorNextAnchor(const TimeSync_Estimator_t *pEst, uint32_t Time, uint16_t *pAnchor_Count);
+void TimeSync_EstimatorStamp(const TimeSync_Estimator_t *pEst, uint32_t Time, TimeSync_Stamp_t *pStamp);
+
+/*** Service ***/
+void TimeSync_Init(void);
+void TimeSync_Start(uint16_t Conn_Interval);
+void TimeSync_Stop(void);
+void TimeSync_SetProducer(TimeSync_ProducerFunc_t Producer, uint32_t Lead_us);
+void TimeSync_Process(void);
+TimeSync_Status_t TimeSync_Stamp(uint32_t Time, TimeSync_Stamp_t *pStamp);
+const TimeSync_Estimator_t *TimeSync_GetEstimator(void);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __TIME_SYNC_H */
+
+
+/******************************************* END OF FILE *******************************************/
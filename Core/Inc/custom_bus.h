@@ -66,7 +66,7 @@
 #endif
 /* SPI1 Baud rate in bps  */
 #ifndef BUS_SPI1_BAUDRATE
-   #define BUS_SPI1_BAUDRATE   10000000U /* baud rate of SPIn = 10 Mbps*/
+   #define BUS_SPI1_BAUDRATE   8000000U /* baud rate of SPIn = 8 Mbps, BlueNRG-2 maximum */
 #endif
 
 /**
@@ -108,6 +108,8 @@ int32_t BSP_SPI1_DeInit(void);
 int32_t BSP_SPI1_Send(uint8_t *pData, uint16_t Length);
 int32_t BSP_SPI1_Recv(uint8_t *pData, uint16_t Length);
 int32_t BSP_SPI1_SendRecv(uint8_t *pTxData, uint8_t *pRxData, uint16_t Length);
+uint32_t BSP_SPI1_GetPrescaler(uint32_t clock_src_hz);
+int32_t BSP_SPI1_SetPrescaler(uint32_t prescaler);
 #if (USE_HAL_SPI_REGISTER_CALLBACKS == 1U)
 int32_t BSP_SPI1_RegisterDefaultMspCallbacks (void);
 int32_t BSP_SPI1_RegisterMspCallbacks (BSP_SPI_Cb_t *Callbacks);
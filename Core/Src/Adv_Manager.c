@@ -0,0 +1,575 @@
+/**
+  **************************************************************************************************
+  * @file       : Adv_Manager.c
+  * @brief      : Advertising manager. Runs the advertising intervals from a fast-then-slow schedule,
+	*								keeps the advertising and scan response payloads and only sends them to the
+	*								controller when their content changed, and rotates manufacturer data in place.
+  * @author			:
+  **************************************************************************************************
+  *
+  * A central reconnects within a few advertising intervals, so advertising is fast right after
+  * start and after a disconnection, and backs off once nobody connected for a while. The interval
+  * is a parameter of aci_gap_set_discoverable and cannot change while advertising: advertising is
+  * restarted at the phase changes only (twice with the default schedule).
+  *
+  * aci_gap_set_discoverable builds the flags and the local name, the manufacturer data is then
+  * added or replaced with aci_gap_update_adv_data without stopping advertising. The CRC-32 of the
+  * last payloads accepted by the controller is kept and identical payloads are not sent again.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Adv_Manager.h"
+#include "KV_Store.h"
+#include "bluenrg_conf.h"
+#include "bluenrg1_gap.h"
+#include "bluenrg1_gap_aci.h"
+#include "bluenrg1_hci_le.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define ADVMGR_AD_TYPE_MANUF_DATA				((uint8_t)0xFF)
+
+/* Flags AD structure added by aci_gap_set_discoverable */
+#define ADVMGR_FLAGS_SIZE								3U
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t Length;										/* Whole AD structure, 0 if the slot is empty */
+	uint8_t AD[ADVMGR_MAX_MANUF_DATA + 2U];
+
+} AdvMgr_Manuf_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static const AdvMgr_Phase_t Default_Phases[] =
+{
+	{ADVMGR_FAST_MS, ADVMGR_FAST_INTERV_MIN, ADVMGR_FAST_INTERV_MAX},
+	{ADVMGR_NORMAL_MS, ADV_INTERV_MIN, ADV_INTERV_MAX},
+	{ADVMGR_FOREVER, ADVMGR_SLOW_INTERV_MIN, ADVMGR_SLOW_INTERV_MAX},
+};
+
+static AdvMgr_Phase_t Phases[ADVMGR_MAX_PHASES];
+static AdvMgr_Sched_t Sched;
+
+static uint8_t Name[ADVMGR_MAX_NAME];
+static uint8_t Name_Length;
+
+static uint8_t Scan_Data[ADVMGR_MAX_DATA];
+static uint8_t Scan_Length;
+static uint8_t Scan_Sent;									/* Scan_Hash is in the controller */
+static uint32_t Scan_Hash;
+
+static AdvMgr_Manuf_t Manuf[ADVMGR_MANUF_SLOTS];
+static uint8_t Manuf_Slot;
+static uint32_t Rotation_Period;
+static uint32_t Last_Rotation;
+
+static uint8_t Adv_Sent;									/* Adv_Hash is in the controller */
+static uint8_t Adv_Dirty;									/* Manufacturer data to check against Adv_Hash */
+static uint32_t Adv_Hash;
+
+static uint8_t Advertising;
+static uint8_t Restart;										/* Advertising to be rebuilt */
+static AdvMgr_Stats_t Stats;
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static AdvMgr_Status_t AdvMgr_Discoverable(void);
+static void AdvMgr_SendAdvData(void);
+static void AdvMgr_SendScanResponse(void);
+static uint8_t AdvMgr_NextSlot(uint8_t Slot);
+
+
+/******************************************* Schedule ********************************************/
+
+/**
+  * @brief	Set the phases of a schedule
+	* @param	pSched: schedule
+	* @param	pPhases: phases, kept by reference
+	* @param	Count: number of phases
+	*/
+void AdvMgr_SchedInit(AdvMgr_Sched_t *pSched, const AdvMgr_Phase_t *pPhases, uint8_t Count)
+{
+	pSched->pPhases = pPhases;
+	pSched->Count = Count;
+	pSched->Phase = 0;
+	pSched->Phase_Start = 0;
+}
+
+/**
+  * @brief	Go back to the first phase
+	* @param	pSched: schedule
+	* @param	Now: time, ms
+	*/
+void AdvMgr_SchedStart(AdvMgr_Sched_t *pSched, uint32_t Now)
+{
+	pSched->Phase = 0;
+	pSched->Phase_Start = Now;
+}
+
+/**
+  * @brief	Move to the phase running at a given time
+	* @param	pSched: schedule
+	* @param	Now: time, ms. Must not go back.
+	* @retval	1 if the phase changed, 0 otherwise
+	* @note		Phases shorter than the time since the previous call are skipped. The end of a phase is
+	*					taken from the end of the previous one, the schedule does not drift with late calls.
+	*/
+uint8_t AdvMgr_SchedUpdate(AdvMgr_Sched_t *pSched, uint32_t Now)
+{
+	uint8_t Changed = 0;
+	uint32_t Duration;
+
+	while(pSched->Phase < pSched->Count)
+	{
+		Duration = pSched->pPhases[pSched->Phase].Duration_ms;
+		if((Duration == ADVMGR_FOREVER) || ((Now - pSched->Phase_Start) < Duration))
+		{
+			break;
+		}
+
+		pSched->Phase_Start += Duration;
+		pSched->Phase++;
+		Changed = 1;
+	}
+
+	return Changed;
+}
+
+/**
+  * @brief	Current phase
+	* @param	pSched: schedule
+	* @retval	NULL once the last phase of a schedule without ADVMGR_FOREVER phase ended
+	*/
+const AdvMgr_Phase_t *AdvMgr_SchedPhase(const AdvMgr_Sched_t *pSched)
+{
+	return (pSched->Phase < pSched->Count) ? &pSched->pPhases[pSched->Phase] : NULL;
+}
+
+/**
+  * @brief	Time left in the current phase
+	* @param	pSched: schedule
+	* @param	Now: time, ms
+	* @retval	ms, UINT32_MAX if the phase does not end
+	*/
+uint32_t AdvMgr_SchedRemaining(const AdvMgr_Sched_t *pSched, uint32_t Now)
+{
+	uint32_t Duration, Elapsed;
+
+	if(pSched->Phase >= pSched->Count)
+	{
+		return 0;
+	}
+
+	Duration = pSched->pPhases[pSched->Phase].Duration_ms;
+	if(Duration == ADVMGR_FOREVER)
+	{
+		return UINT32_MAX;
+	}
+
+	Elapsed = Now - pSched->Phase_Start;
+	return (Elapsed < Duration) ? (Duration - Elapsed) : 0U;
+}
+
+
+/****************************************** Advertising ******************************************/
+
+/**
+  * @brief	Forget the payloads and load the default schedule
+	* @note		To be called after hci_reset(), the controller holds no payload then
+	*/
+void AdvMgr_Init(void)
+{
+	memset(Manuf, 0, sizeof(Manuf));
+	memset(&Stats, 0, sizeof(Stats));
+	Name_Length = 0;
+	Scan_Length = 0;
+	Scan_Sent = 0;
+	Adv_Sent = 0;
+	Adv_Dirty = 0;
+	Manuf_Slot = 0;
+	Rotation_Period = 0;
+	Advertising = 0;
+	Restart = 0;
+
+	(void)AdvMgr_SetSchedule(Default_Phases, (uint8_t)(sizeof(Default_Phases) / sizeof(Default_Phases[0])));
+}
+
+/**
+  * @brief	Set the schedule used from the next AdvMgr_Start()
+	* @param	pPhases: phases, copied
+	* @param	Count: number of phases, up to ADVMGR_MAX_PHASES
+	*/
+AdvMgr_Status_t AdvMgr_SetSchedule(const AdvMgr_Phase_t *pPhases, uint8_t Count)
+{
+	if((pPhases == NULL) || (Count == 0U) || (Count > ADVMGR_MAX_PHASES))
+	{
+		return ADVMGR_ERROR_PARAM;
+	}
+
+	memcpy(Phases, pPhases, Count * sizeof(AdvMgr_Phase_t));
+	AdvMgr_SchedInit(&Sched, Phases, Count);
+
+	return ADVMGR_OK;
+}
+
+/**
+  * @brief	Set the local name advertised
+	* @param	pName: AD type (AD_TYPE_COMPLETE_LOCAL_NAME or AD_TYPE_SHORTENED_LOCAL_NAME) and name
+	* @param	Length: bytes, up to ADVMGR_MAX_NAME
+	* @note		Applied at the next AdvMgr_Start()
+	*/
+AdvMgr_Status_t AdvMgr_SetName(const uint8_t *pName, uint8_t Length)
+{
+	if((Length > ADVMGR_MAX_NAME) || ((Length != 0U) && (pName == NULL)))
+	{
+		return ADVMGR_ERROR_PARAM;
+	}
+
+	memcpy(Name, pName, Length);
+	Name_Length = Length;
+
+	return ADVMGR_OK;
+}
+
+/**
+  * @brief	Set the scan response data
+	* @param	pData: AD structures
+	* @param	Length: bytes, up to ADVMGR_MAX_DATA
+	* @retval	ADVMGR_ERROR_ACI if the controller refused it, it is sent again at AdvMgr_Start()
+	*/
+AdvMgr_Status_t AdvMgr_SetScanResponse(const uint8_t *pData, uint8_t Length)
+{
+	if((Length > ADVMGR_MAX_DATA) || ((Length != 0U) && (pData == NULL)))
+	{
+		return ADVMGR_ERROR_PARAM;
+	}
+
+	memcpy(Scan_Data, pData, Length);
+	Scan_Length = Length;
+	AdvMgr_SendScanResponse();
+
+	return Scan_Sent ? ADVMGR_OK : ADVMGR_ERROR_ACI;
+}
+
+/**
+  * @brief	Set the manufacturer specific data of a rotation slot
+	* @param	Slot: below ADVMGR_MANUF_SLOTS
+	* @param	pData: company identifier (little endian) and payload
+	* @param	Length: bytes, up to ADVMGR_MAX_MANUF_DATA and what the local name leaves. 0 empties the slot.
+	* @note		Sent at the next AdvMgr_Process() if the slot is the one advertised
+	*/
+AdvMgr_Status_t AdvMgr_SetManufData(uint8_t Slot, const uint8_t *pData, uint8_t Length)
+{
+	AdvMgr_Manuf_t *pManuf;
+
+	if((Slot >= ADVMGR_MANUF_SLOTS) || (Length > ADVMGR_MAX_MANUF_DATA) || ((Length != 0U) && (pData == NULL)) ||
+		 ((ADVMGR_FLAGS_SIZE + 1U + Name_Length + 2U + Length) > ADVMGR_MAX_DATA))
+	{
+		return ADVMGR_ERROR_PARAM;
+	}
+
+	pManuf = &Manuf[Slot];
+	if(Length == 0U)
+	{
+		pManuf->Length = 0;
+	}
+	else
+	{
+		pManuf->AD[0] = (uint8_t)(Length + 1U);
+		pManuf->AD[1] = ADVMGR_AD_TYPE_MANUF_DATA;
+		memcpy(&pManuf->AD[2], pData, Length);
+		pManuf->Length = (uint8_t)(Length + 2U);
+	}
+
+	if(Slot == Manuf_Slot)
+	{
+		Adv_Dirty = 1;
+	}
+
+	return ADVMGR_OK;
+}
+
+/**
+  * @brief	Rotate the advertised manufacturer data over the slots set
+	* @param	Period_ms: time each slot is advertised, 0 to stay on the current slot
+	*/
+void AdvMgr_SetRotation(uint32_t Period_ms)
+{
+	Rotation_Period = Period_ms;
+	Last_Rotation = HAL_GetTick();
+}
+
+/**
+  * @brief	Start advertising from the first phase of the schedule
+	* @note		Restarts advertising if it was running, e.g. to go back to fast advertising
+	*/
+AdvMgr_Status_t AdvMgr_Start(void)
+{
+	if(Advertising)
+	{
+		(void)aci_gap_set_non_discoverable();
+		Advertising = 0;
+	}
+	Restart = 0;
+
+	if(!Scan_Sent)
+	{
+		AdvMgr_SendScanResponse();
+	}
+
+	if(Manuf[Manuf_Slot].Length == 0U)
+	{
+		Manuf_Slot = AdvMgr_NextSlot(Manuf_Slot);
+	}
+	Last_Rotation = HAL_GetTick();
+
+	AdvMgr_SchedStart(&Sched, HAL_GetTick());
+	if(AdvMgr_Discoverable() != ADVMGR_OK)
+	{
+		return ADVMGR_ERROR_ACI;
+	}
+	Stats.Starts++;
+
+	/* Complete the advertising data right away */
+	AdvMgr_SendAdvData();
+
+	return ADVMGR_OK;
+}
+
+/**
+  * @brief	Stop advertising
+	*/
+AdvMgr_Status_t AdvMgr_Stop(void)
+{
+	Restart = 0;
+	if(!Advertising)
+	{
+		return ADVMGR_OK;
+	}
+	Advertising = 0;
+
+	return (aci_gap_set_non_discoverable() == BLE_STATUS_SUCCESS) ? ADVMGR_OK : ADVMGR_ERROR_ACI;
+}
+
+/**
+  * @brief	To be called on connection, the controller stopped advertising by itself
+	*/
+void AdvMgr_Connected(void)
+{
+	Advertising = 0;
+	Restart = 0;
+}
+
+/**
+  * @brief	Follow the schedule and rotate the manufacturer data
+	* @note		To be called from the main loop
+	*/
+void AdvMgr_Process(void)
+{
+	uint32_t Now;
+	uint8_t Slot;
+
+	if(!Advertising && !Restart)
+	{
+		return;
+	}
+	Now = HAL_GetTick();
+
+	if(AdvMgr_SchedUpdate(&Sched, Now))
+	{
+		if(AdvMgr_SchedPhase(&Sched) == NULL)
+		{
+			(void)AdvMgr_Stop();
+			return;
+		}
+
+		/* New intervals: advertising has to be set again */
+		Stats.Phase_Changes++;
+		Restart = 1;
+	}
+
+	if(Rotation_Period && ((Now - Last_Rotation) >= Rotation_Period))
+	{
+		Last_Rotation = Now;
+		Slot = AdvMgr_NextSlot(Manuf_Slot);
+		if(Slot != Manuf_Slot)
+		{
+			Manuf_Slot = Slot;
+			Adv_Dirty = 1;
+			Stats.Rotations++;
+		}
+	}
+
+	if(Restart)
+	{
+		if(Advertising)
+		{
+			(void)aci_gap_set_non_discoverable();
+			Advertising = 0;
+		}
+
+		/* Retried at the next call on failure */
+		if(AdvMgr_Discoverable() != ADVMGR_OK)
+		{
+			return;
+		}
+		Restart = 0;
+	}
+
+	AdvMgr_SendAdvData();
+}
+
+uint8_t AdvMgr_IsAdvertising(void)
+{
+	return Advertising;
+}
+
+/**
+  * @brief	Phase of the schedule being advertised
+	* @retval	Phase, NULL when advertising is stopped
+	*/
+const AdvMgr_Phase_t *AdvMgr_GetPhase(void)
+{
+	if(!Advertising && !Restart)
+	{
+		return NULL;
+	}
+
+	return AdvMgr_SchedPhase(&Sched);
+}
+
+const AdvMgr_Stats_t *AdvMgr_GetStats(void)
+{
+	return &Stats;
+}
+
+void AdvMgr_ResetStats(void)
+{
+	memset(&Stats, 0, sizeof(Stats));
+}
+
+
+/*************************************** Private functions ***************************************/
+
+/**
+  * @brief	Enter general discoverable mode with the intervals of the current phase
+	* @note		The controller advertising data then holds the flags and the local name only
+	*/
+static AdvMgr_Status_t AdvMgr_Discoverable(void)
+{
+	const AdvMgr_Phase_t *pPhase = AdvMgr_SchedPhase(&Sched);
+
+	if(pPhase == NULL)
+	{
+		return ADVMGR_ERROR_PARAM;
+	}
+
+	if(aci_gap_set_discoverable(ADV_IND, pPhase->Interval_Min, pPhase->Interval_Max, PUBLIC_ADDR,
+															NO_WHITE_LIST_USE, Name_Length, Name, 0, NULL, 0, 0) != BLE_STATUS_SUCCESS)
+	{
+		Stats.Errors++;
+		return ADVMGR_ERROR_ACI;
+	}
+
+	Advertising = 1;
+	Adv_Sent = 0;
+	Adv_Dirty = 1;
+
+	return ADVMGR_OK;
+}
+
+/**
+  * @brief	Send the manufacturer data of the current slot if the controller does not hold it already
+	*/
+static void AdvMgr_SendAdvData(void)
+{
+	const AdvMgr_Manuf_t *pManuf = &Manuf[Manuf_Slot];
+	uint32_t Hash;
+
+	if(!Adv_Dirty || !Advertising)
+	{
+		return;
+	}
+	Adv_Dirty = 0;
+
+	if(pManuf->Length == 0U)
+	{
+		/* aci_gap_update_adv_data cannot remove an AD structure, rebuild the advertising data */
+		if(Adv_Sent)
+		{
+			Restart = 1;
+		}
+		return;
+	}
+
+	Hash = KVStore_CRC32(0, pManuf->AD, pManuf->Length);
+	if(Adv_Sent && (Hash == Adv_Hash))
+	{
+		Stats.Adv_Skipped++;
+		return;
+	}
+
+	if(aci_gap_update_adv_data(pManuf->Length, (uint8_t *)pManuf->AD) != BLE_STATUS_SUCCESS)
+	{
+		/* Tried again at the next change */
+		Stats.Errors++;
+		return;
+	}
+
+	Adv_Hash = Hash;
+	Adv_Sent = 1;
+	Stats.Adv_Updates++;
+}
+
+/**
+  * @brief	Send the scan response data if the controller does not hold it already
+	*/
+static void AdvMgr_SendScanResponse(void)
+{
+	uint32_t Hash = KVStore_CRC32(0, Scan_Data, Scan_Length);
+
+	if(Scan_Sent && (Hash == Scan_Hash))
+	{
+		Stats.Scan_Skipped++;
+		return;
+	}
+
+	Scan_Sent = 0;
+	if(hci_le_set_scan_response_data(Scan_Length, Scan_Data) != BLE_STATUS_SUCCESS)
+	{
+		Stats.Errors++;
+		return;
+	}
+
+	Scan_Hash = Hash;
+	Scan_Sent = 1;
+	Stats.Scan_Updates++;
+}
+
+/**
+  * @brief	Next manufacturer data slot set after a slot
+	* @retval	Slot itself if no other slot is set
+	*/
+static uint8_t AdvMgr_NextSlot(uint8_t Slot)
+{
+	uint8_t i, Next;
+
+	for(i = 1; i <= ADVMGR_MANUF_SLOTS; i++)
+	{
+		Next = (uint8_t)((Slot + i) % ADVMGR_MANUF_SLOTS);
+		if(Manuf[Next].Length != 0U)
+		{
+			return Next;
+		}
+	}
+
+	return Slot;
+}
+
+
+/******************************************* END OF FILE *******************************************/
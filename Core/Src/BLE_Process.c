@@ -19,10 +19,25 @@
 #include "bluenrg1_gatt_aci.h"
 #include "bluenrg1_gap_aci.h"
 #include "bluenrg1_hci_le.h"
+#include "bluenrg1_events.h"
 
 
 /* Private includes ------------------------------------------------------------------------------*/
 #include "bluenrg_conf.h"				/* Contains configured Bluetooth Parameters in CubeMX */
+#include "KV_Store.h"						/* Persistent device identity */
+#include "Radio_Sched.h"					/* Jobs run between radio activities */
+#include "Time_Sync.h"						/* Connection anchor tracking for sample timestamps */
+#include "Observer.h"							/* Advertiser table of the central/gateway build */
+#include "Gatt_Cache.h"						/* Peer attribute handles kept across reconnects */
+#include "Link_Monitor.h"					/* RSSI sampling and TX power control */
+#include "Adv_Manager.h"					/* Advertising schedule and payloads */
+#include "Perf_Test.h"						/* Optional throughput and latency test service */
+#include "Payload_Codec.h"				/* Compression of the notified payloads */
+#include "Hci_Monitor.h"					/* HCI event queue load and lost events recovery */
+#include "Event_Mask.h"						/* Only the events handled cross the SPI bus */
+#include "Ota_Update.h"						/* Firmware update service */
+#include "Gatt_Builder.h"					/* GATT database built from service tables */
+#include "Clock_Profile.h"				/* Clocked down while only advertising */
 
 
 /* External variables ----------------------------------------------------------------------------*/
@@ -43,6 +58,7 @@ typedef struct
 
 
 /* Private define --------------------------------------------------------------------------------*/
+#define NOTIFY_FRAME_SIZE							20				/* Notification characteristic, fits the default ATT MTU */
 
 
 /* Private variables -----------------------------------------------------------------------------*/
@@ -52,10 +68,6 @@ static uint16_t hGAPService;
 static uint16_t hDevNameChar;
 static uint16_t hAppearanceChar;
 
-/* Variables that will hold service and characteristic UUIDs */
-Service_UUID_t suuid_object;
-Char_UUID_t char_obj_1, char_obj_2, char_obj_3, char_obj_4;
-	
 /* Handle to services and associated characteristics */
 static uint16_t hService;
 static uint16_t hClientIndicate;
@@ -63,15 +75,28 @@ static uint16_t hClientNotification;
 static uint16_t hClientREAD;
 static uint16_t hClientWRITE;
 
-/* Handle to associated characteristic descriptors */
-static uint16_t hFirstCharDesc;
-static uint16_t hSecondCharDesc;
-static uint16_t hThirdCharDesc;
-static uint16_t hFourthCharDesc;
-
 /* DISCOVERY/CONNECTIVITY DETAILS */
 static connectionStatus_t Conn_Details;
 
+/* ADVERTISING PAYLOADS */
+static const uint8_t local_name[] = {AD_TYPE_COMPLETE_LOCAL_NAME, 'E','y','e','w','e','a','r','B','L','E'};
+static const uint8_t uuidscanresponse[18] =
+			{0x11,0x06,0x5D,0xCE,0xE1,0x5A,0x50,0x51,0x1D,0xB1,0x63,0x4D,0xF9,0x03,0x8B,0x32,0x98,0xA8};
+
+/* EVENTS HANDLED IN THIS FILE */
+static const uint32_t Server_Events[] =
+{
+	EVTMASK_LE_CONNECTION_COMPLETE,
+	EVTMASK_LE_CONNECTION_UPDATE_COMPLETE,
+	EVTMASK_DISCONNECTION_COMPLETE,
+#if defined(DEVICE_TYPE_GAP_PERIPHERAL)
+	EVTMASK_GATT_ATTRIBUTE_MODIFIED,
+#elif defined(DEVICE_TYPE_GAP_CENTRAL)
+	EVTMASK_GATT_NOTIFICATION,
+	EVTMASK_LE_ADVERTISING_REPORT,		/* Passed to the observer */
+#endif
+};
+
 
 /* Private macro ---------------------------------------------------------------------------------*/
 
@@ -80,6 +105,10 @@ static connectionStatus_t Conn_Details;
 static void Setup_DeviceAddress(void);
 static void GAP_Peripheral_ConfigService(void);
 static void Server_ResetConnectionStatus(void);
+static void Server_RecoverLostEvents(uint64_t Lost_Events);
+#if defined(DEVICE_TYPE_GAP_PERIPHERAL)
+static void Server_SelectClockProfile(void);
+#endif
 
 
 /***************************** BLE Stack and Interface Initialization  **********************************/
@@ -99,9 +128,16 @@ void BlueNRG_Init(void)
 	hci_reset();
 	HAL_Delay(2000);
 	
-	/* Configure transmit power to high power at -2dBm */
-	ret = aci_hal_set_tx_power_level(1, 4);
-	if(ret != BLE_STATUS_SUCCESS)
+	/* The modules register the events they handle during their initialization */
+	EvtMask_Init();
+	(void)EvtMask_RegisterList(Server_Events, (uint8_t)(sizeof(Server_Events) / sizeof(Server_Events[0])));
+	
+	/* Watch the event queue and read the state again when the controller drops events */
+	HciMon_Init();
+	HciMon_SetRecovery(Server_RecoverLostEvents);
+	
+	/* Start at high power -2dBm, the link monitor adapts it once connected */
+	if(LinkMon_Init() != LINKMON_OK)
 	{
 		(void)strncpy(pText, "Error at Power Level Config\r\n", TEXTSIZE);
 		HAL_UART_Transmit(&huart1, (uint8_t*)pText, TEXTSIZE, UART_TIMEOUT);
@@ -140,6 +176,41 @@ void BlueNRG_Init(void)
 	/* Configure further the services and characteristics to be included in the GATT database */
 	GAP_Peripheral_ConfigService();
 	
+#if PERFTEST_ENABLE
+	/* Throughput and latency test service, after the application service */
+	if(PerfTest_Init() != PERFTEST_OK)
+	{
+		(void)strncpy(pText, "Error at Test Service\r\n", TEXTSIZE);
+		HAL_UART_Transmit(&huart1, (uint8_t*)pText, TEXTSIZE, UART_TIMEOUT);
+	}
+	
+#endif
+#if OTA_ENABLE
+	/* Firmware update service */
+	if(Ota_Init() != OTA_OK)
+	{
+		(void)strncpy(pText, "Error at Update Service\r\n", TEXTSIZE);
+		HAL_UART_Transmit(&huart1, (uint8_t*)pText, TEXTSIZE, UART_TIMEOUT);
+	}
+	
+#endif
+	/* Name that will be broadcasted to Central Devices scanning */
+	AdvMgr_Init();
+	(void)AdvMgr_SetName(local_name, sizeof(local_name));
+	
+	/* Configure scan response packet to be sent when GAP peripheral receives scan requests from GAP
+     central performing general discovery procedure (active scan).
+		 Scan Response Message must contain the following in this specific order:
+				Length = 0x11
+				Service UUID Type = 0x06 (128-bits Service UUID)
+				Service UUID = (UUID taken from above)
+	 */
+	if(AdvMgr_SetScanResponse(uuidscanresponse, sizeof(uuidscanresponse)) != ADVMGR_OK)
+	{
+		(void)strncpy(pText, "Error at Scan Response\r\n", TEXTSIZE);
+		HAL_UART_Transmit(&huart1, (uint8_t*)pText, TEXTSIZE, UART_TIMEOUT);
+	}
+	
 	Server_ResetConnectionStatus();
 	
 #elif defined(DEVICE_TYPE_GAP_CENTRAL)
@@ -151,8 +222,38 @@ void BlueNRG_Init(void)
    */	
 	aci_gap_init(GAP_CENTRAL_ROLE, GAP_PRIVACY_DISABLED, 0x08, &hGAPService, &hDevNameChar, &hAppearanceChar);
 	
+	/* Collect the advertisers around. The central does not advertise, skip that state of the FSM */
+	Observer_Init();
+	if(Observer_Start(SCAN_P, SCAN_L) != OBSERVER_OK)
+	{
+		(void)strncpy(pText, "Error at Observation Start\r\n", TEXTSIZE);
+		HAL_UART_Transmit(&huart1, (uint8_t*)pText, TEXTSIZE, UART_TIMEOUT);
+	}
+	Conn_Details.ConnectionStatus = STATE_AWAITING_CONNECTION;
+	
+	/* Reuse the databases of known peripherals instead of discovering them again */
+	GattCache_Init();
+	
 #endif
 
+	/* Report the end of advertising and connection events so that heavy jobs run between them */
+	if(RadioSched_Init(RADIO_ACTIVITY_MASK_ADVERTISING | RADIO_ACTIVITY_MASK_CONN_SLAVE |
+										 RADIO_ACTIVITY_MASK_CONN_MASTER) != RADIOSCHED_OK)
+	{
+		(void)strncpy(pText, "Error at Radio Activity Mask\r\n", TEXTSIZE);
+		HAL_UART_Transmit(&huart1, (uint8_t*)pText, TEXTSIZE, UART_TIMEOUT);
+	}
+	
+	/* Track the connection anchors from the same events */
+	TimeSync_Init();
+	
+	/* Disable the events nobody handles */
+	if(EvtMask_Apply() != EVTMASK_OK)
+	{
+		(void)strncpy(pText, "Error at Event Masks\r\n", TEXTSIZE);
+		HAL_UART_Transmit(&huart1, (uint8_t*)pText, TEXTSIZE, UART_TIMEOUT);
+	}
+
 }
 
 /**
@@ -160,31 +261,52 @@ void BlueNRG_Init(void)
   * @note		This MAC address will only be used to connect with other (Central devices). Central devices 
   *					will see this MAC address and use it to connect with this peripheral device. Peripheral will
   *					include the MAC address in the advertisement data.
+  *					The address is generated on first boot only and kept in the flash key-value store, so that
+  *					centrals recognize the device (and reuse their cached GATT handles) across resets.
   */
 static void Setup_DeviceAddress(void)
 {
 	tBleStatus ret;
+  Device_Identity_t identity;
+  uint16_t length = sizeof(identity);
   uint8_t bdaddr[] = {0x00, 0x00, 0x00, 0xE1, 0x80, 0x02};
   uint8_t random_number[8];
 
-  /* get a random number from BlueNRG */
-  ret = hci_le_rand(random_number);
-  if(ret != BLE_STATUS_SUCCESS)
+  if((KVStore_Read(KVSTORE_KEY_DEVICE_IDENTITY, &identity, &length) == KVSTORE_OK) &&
+     (length == sizeof(identity)))
   {
-    PRINT_DBG("hci_le_rand() call failed: 0x%02x\r\n", ret);
+    BLUENRG_memcpy(bdaddr, identity.BD_Addr, 6);
+    discovery_time = identity.Discovery_Time;
   }
-
-  discovery_time = 3000; /* at least 3 seconds */
-  /* setup discovery time with random number */
-  for (uint8_t i=0; i<8; i++)
+  else
   {
-    discovery_time += (2*random_number[i]);
-  }
+    /* get a random number from BlueNRG */
+    ret = hci_le_rand(random_number);
+    if(ret != BLE_STATUS_SUCCESS)
+    {
+      PRINT_DBG("hci_le_rand() call failed: 0x%02x\r\n", ret);
+    }
 
-  /* Setup last 3 bytes of public address with random number */
-  bdaddr[0] = (uint8_t) (random_number[0]);
-  bdaddr[1] = (uint8_t) (random_number[3]);
-  bdaddr[2] = (uint8_t) (random_number[6]);
+    discovery_time = 3000; /* at least 3 seconds */
+    /* setup discovery time with random number */
+    for (uint8_t i=0; i<8; i++)
+    {
+      discovery_time += (2*random_number[i]);
+    }
+
+    /* Setup last 3 bytes of public address with random number */
+    bdaddr[0] = (uint8_t) (random_number[0]);
+    bdaddr[1] = (uint8_t) (random_number[3]);
+    bdaddr[2] = (uint8_t) (random_number[6]);
+
+    /* Keep this identity for the next boots */
+    BLUENRG_memcpy(identity.BD_Addr, bdaddr, 6);
+    identity.Discovery_Time = discovery_time;
+    if(KVStore_Write(KVSTORE_KEY_DEVICE_IDENTITY, &identity, sizeof(identity)) != KVSTORE_OK)
+    {
+      PRINT_DBG("Saving device identity failed\r\n");
+    }
+  }
 
 	/* Configure public MAC address (bdaddr[3:5] is company specific, while bdaddr[0:2] is device specific) */
   ret = aci_hal_write_config_data(CONFIG_DATA_PUBADDR_OFFSET, CONFIG_DATA_PUBADDR_LEN, bdaddr);
@@ -211,32 +333,15 @@ static void Setup_DeviceAddress(void)
   */
 static void GAP_Peripheral_ConfigService(void)
 {
-	/* 128-bit UUID Declarations for 1 Service and the 4 Characteristics underneath that Service */
-		
 	/* Configure 128-bit Service UUID since Sciton does not have dedicated 16-bit Service
 	   UUID with Bluetooth SIG. Service UUID obtained through UUID generator.
 	   UUID (uuidgenerator.net): a898328b-03f9-4d63-b11d-51505ae1ce5d */
-	const uint8_t service_uuid[16] = 
+	static const uint8_t service_uuid[16] = 
 	{0x5D,0xCE,0xE1,0x5A,0x50,0x51,0x1D,0xB1,0x63,0x4D,0xF9,0x03,0x8B,0x32,0x98,0xA8};
-	const uint8_t char1_uuid[16] = 
-	{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x80,0xEA,0x25,0x9B};
-	const uint8_t char2_uuid[16] = 
-	{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x81,0xEA,0x25,0x9B};
-	const uint8_t char3_uuid[16] = 
-	{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x82,0xEA,0x25,0x9B};
-	const uint8_t char4_uuid[16] = 
-	{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x83,0xEA,0x25,0x9B};	
-	
-	BLUENRG_memcpy(&suuid_object.Service_UUID_128, service_uuid, 16);
-	
-	/* Add the Bluetooth Service based on the configuration above */
-	aci_gatt_add_service(UUID_TYPE_128, &suuid_object, PRIMARY_SERVICE, 20, &hService);
 	
-	/* Variables that will hold the four characteristics' 128-bit UUID number. 
-	   The first characteristic's UUID was generated with a UUID random number generator,
+	/* The first characteristic's UUID was generated with a UUID random number generator,
 	   and the subsequent characteristics' UUID were derived from that first char UUID. */
 	
-	
 	/**
 	  * @brief First Characteristic (...TBD...)
 		*
@@ -250,9 +355,9 @@ static void GAP_Peripheral_ConfigService(void)
 		* Fixed characteristic value length					: FIXED_LENGTH
 		*
 		* This characteristic will be used (...TBD...)
-		*/	
-	/* First characteristic's UUID */
-	BLUENRG_memcpy(&char_obj_1.Char_UUID_128, char1_uuid, 16);
+		*/
+	static const uint8_t char1_uuid[16] = 
+	{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x80,0xEA,0x25,0x9B};
 	
 	/**
 	  * @brief Second Characteristic (...TBD...)
@@ -267,9 +372,9 @@ static void GAP_Peripheral_ConfigService(void)
 		* Fixed characteristic value length					: FIXED_LENGTH
 		*
 		* This characteristic will be used (...TBD...)
-		*/	
-	/* Second characteristic's UUID */
-	BLUENRG_memcpy(&char_obj_2.Char_UUID_128, char2_uuid, 16);
+		*/
+	static const uint8_t char2_uuid[16] = 
+	{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x81,0xEA,0x25,0x9B};
 	
 	/**
 	  * @brief Third Characteristic (...TBD...)
@@ -284,9 +389,9 @@ static void GAP_Peripheral_ConfigService(void)
 		* Fixed characteristic value length					: FIXED_LENGTH
 		*
 		* This characteristic will be used (...TBD...)
-		*/	
-	/* Third characteristic's UUID */
-	BLUENRG_memcpy(&char_obj_3.Char_UUID_128, char3_uuid, 16);
+		*/
+	static const uint8_t char3_uuid[16] = 
+	{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x82,0xEA,0x25,0x9B};
 	
 	/**
 	  * @brief Fourth Characteristic (...TBD...)
@@ -301,60 +406,31 @@ static void GAP_Peripheral_ConfigService(void)
 		* Fixed characteristic value length					: FIXED_LENGTH
 		*
 		* This characteristic will be used (...TBD...)
-		*/	
-	/* Fourth characteristic's UUID */	
-	BLUENRG_memcpy(&char_obj_4.Char_UUID_128, char4_uuid, 16);
-	
-	/* Configure the four characteristic defined above for the GATT server (peripheral) */
-	aci_gatt_add_char(hService, UUID_TYPE_128, &char_obj_1, 20, CHAR_PROP_INDICATE, 
-											ATTR_PERMISSION_NONE, GATT_DONT_NOTIFY_EVENTS, 
-											0x07, CHAR_VALUE_LEN_CONSTANT, &hClientIndicate);
-	aci_gatt_add_char(hService, UUID_TYPE_128, &char_obj_2, 20, CHAR_PROP_NOTIFY, 
-											ATTR_PERMISSION_NONE, GATT_DONT_NOTIFY_EVENTS,
-											0x07, CHAR_VALUE_LEN_CONSTANT, &hClientNotification);
-	aci_gatt_add_char(hService, UUID_TYPE_128, &char_obj_3, 20, CHAR_PROP_READ, 
-											ATTR_PERMISSION_NONE, GATT_DONT_NOTIFY_EVENTS, 
-											0x07, CHAR_VALUE_LEN_CONSTANT, &hClientREAD);
-	aci_gatt_add_char(hService, UUID_TYPE_128, &char_obj_4, 20, CHAR_PROP_WRITE|CHAR_PROP_WRITE_WITHOUT_RESP, 
-											ATTR_PERMISSION_NONE, GATT_NOTIFY_ATTRIBUTE_WRITE,
-											0x07, CHAR_VALUE_LEN_CONSTANT, &hClientWRITE);
-	
-	/* CCCD value */
-	Char_Desc_Uuid_t DescriptorProperty;
-	DescriptorProperty.Char_UUID_16 = CHAR_USER_DESC_UUID;
-	
-	const char char1name[] = {'T','E','S','T','_','O','N','E'};
-	const char char2name[] = {'T','E','S','T','_','T','W','O'};
-	const char char3name[] = {'T','E','S','T','_','T','H','R','E','E'};
-	const char char4name[] = {'T','E','S','T','_','F','O','U','R'};
-	
-	/* Configure CCCD for the characteristics above (associated with characteristic UUIDs). The CCCD's
-     might only be necessary for indicate/notify related events, as the CCCD feature in the GATT server
-     allows client to configure server to automatically push new data to the client in the notify/indicate
-     characteristics.	*/
-
-	aci_gatt_add_char_desc(hService, hClientIndicate, UUID_TYPE_16, &DescriptorProperty,
-														128, 9, (uint8_t*)char1name, ATTR_PERMISSION_NONE, ATTR_ACCESS_READ_ONLY, 
-														GATT_DONT_NOTIFY_EVENTS, 7, CHAR_VALUE_LEN_CONSTANT, &hFirstCharDesc);
-	aci_gatt_add_char_desc(hService, hClientNotification, UUID_TYPE_16, &DescriptorProperty,
-														128, 9, (uint8_t*)char2name, ATTR_PERMISSION_NONE, ATTR_ACCESS_READ_ONLY, 
-														GATT_NOTIFY_ATTRIBUTE_WRITE, 7, CHAR_VALUE_LEN_CONSTANT, &hSecondCharDesc);
-	aci_gatt_add_char_desc(hService, hClientREAD, UUID_TYPE_16, &DescriptorProperty,
-														128, 11, (uint8_t*)char3name, ATTR_PERMISSION_NONE, ATTR_ACCESS_READ_ONLY, 
-														GATT_DONT_NOTIFY_EVENTS, 7, CHAR_VALUE_LEN_CONSTANT, &hThirdCharDesc);	
-	aci_gatt_add_char_desc(hService, hClientWRITE, UUID_TYPE_16, &DescriptorProperty,
-														128, 10, (uint8_t*)char4name, ATTR_PERMISSION_NONE, ATTR_ACCESS_READ_WRITE, 
-														GATT_DONT_NOTIFY_EVENTS, 7, CHAR_VALUE_LEN_CONSTANT, &hFourthCharDesc);		
-	
-	
-	/*
-	Char_Desc_Uuid_t DescriptorProperty;
-	DescriptorProperty.Char_UUID_16 = CHAR_CLIENT_CONFIG_DESC_UUID;
-	uint16_t char_desc_value = 0;
-	aci_gatt_add_char_desc(hService, hClientWRITE, UUID_TYPE_16, &DescriptorProperty, 128, 9,
-													(uint8_t*)&char_desc_value, ATTR_PERMISSION_NONE, ATTR_ACCESS_READ_WRITE,
-													GATT_NOTIFY_ATTRIBUTE_WRITE, 7, CHAR_VALUE_LEN_CONSTANT, &hFourthCharDesc);
-	*/
+		*/
+	static const uint8_t char4_uuid[16] = 
+	{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x83,0xEA,0x25,0x9B};
+	
+	/* The four characteristics, each followed by its user description. The controller adds the CCCD
+	   of the indicate and notify characteristics itself (declaration handle + 2) */
+	static const GattBuild_Char_t chars[4] =
+	{
+		{char1_uuid, 20, CHAR_PROP_INDICATE, GATT_DONT_NOTIFY_EVENTS, CHAR_VALUE_LEN_CONSTANT,
+			"TEST_ONE", ATTR_ACCESS_READ_ONLY, &hClientIndicate},
+		{char2_uuid, NOTIFY_FRAME_SIZE, CHAR_PROP_NOTIFY, GATT_DONT_NOTIFY_EVENTS, CHAR_VALUE_LEN_VARIABLE,
+			"TEST_TWO", ATTR_ACCESS_READ_ONLY, &hClientNotification},
+		{char3_uuid, 20, CHAR_PROP_READ, GATT_DONT_NOTIFY_EVENTS, CHAR_VALUE_LEN_CONSTANT,
+			"TEST_THREE", ATTR_ACCESS_READ_ONLY, &hClientREAD},
+		{char4_uuid, 20, CHAR_PROP_WRITE|CHAR_PROP_WRITE_WITHOUT_RESP, GATT_NOTIFY_ATTRIBUTE_WRITE, CHAR_VALUE_LEN_CONSTANT,
+			"TEST_FOUR", ATTR_ACCESS_READ_WRITE, &hClientWRITE},
+	};
+	static const GattBuild_Service_t service = {service_uuid, 20, chars, 4, &hService};
+	
+	/* Service, characteristics and descriptors sent back to back, see Gatt_Builder.c */
+	if(GattBuild_Run(&service, 1) != GATTBUILD_OK)
+	{
+		(void)strncpy(pText, "Error at GATT Service\r\n", TEXTSIZE);
+		HAL_UART_Transmit(&huart1, (uint8_t*)pText, TEXTSIZE, UART_TIMEOUT);
+	}
 }
 
 
@@ -380,59 +456,101 @@ static void Server_ResetConnectionStatus(void)
 	BLUENRG_memset(&Conn_Details.BLE_Client_Addr[0], 0, 6);
 }
 
+#if defined(DEVICE_TYPE_GAP_PERIPHERAL)
 /**
-  * @brief	Enables BLE Peripheral device to be discoverable by advertising (with certain parameters)
-  * @note		When BLE Peripheral adverises, it does so periodically at certain intervals. At these times
-  *					power consumption of device will be high. 
+  * @brief	Runs from the HSI at 4 MHz while not connected and advertising with the slow intervals
+  *					(or not at all), from the PLL otherwise
+  * @note		Called from the main loop: the connection complete event is handled at 4 MHz, the
+  *					switch back follows right after it.
   */
-void BlueNRG_MakeDeviceDiscoverable(void)
+static void Server_SelectClockProfile(void)
 {
-	uint8_t ret;
-	
-	/* Name that will be broadcasted to Central Devices scanning */
-	const char local_name[] = {AD_TYPE_COMPLETE_LOCAL_NAME, 'E','y','e','w','e','a','r','B','L','E'};
-	
-	/* Disable scan response: passive scan */
-	hci_le_set_scan_response_data(0, NULL);
-	
-	/* Put the GAP peripheral in general discoverable mode:
-			Advertising_Type: ADV_IND(undirected scannable and connectable);
-			Advertising_Interval_Min: 100;
-			Advertising_Interval_Max: 100;
-			Own_Address_Type: PUBLIC_ADDR (public address: 0x00);
-			Adv_Filter_Policy: NO_WHITE_LIST_USE (no whit list is used);
-			Local_Name_Lenght: 13
-			Local_Name: BlueNRG1Test;
-			Service_Uuid_Length: 0 (no service to be advertised); Service_Uuid_List: NULL;
-			Slave_Conn_Interval_Min: 0 (Slave connection internal minimum value);
-			Slave_Conn_Interval_Max: 0 (Slave connection internal maximum value).
-	*/	
+	const AdvMgr_Phase_t *pPhase = AdvMgr_GetPhase();
+	ClockProfile_Id_t Id = CLOCK_PROFILE_BLE_STREAMING;
 
-	/* Configure scan response packet to be sent when GAP peripheral receives scan requests from GAP
-     central performing general discovery procedure (active scan).
-		 Scan Response Message must contain the following in this specific order:
-				Length = 0x11
-				Service UUID Type = 0x06 (128-bits Service UUID)
-				Service UUID = (UUID taken from above)
-	 */
-	uint8_t uuidscanresponse[18] =
-				{0x11,0x06,0x5D,0xCE,0xE1,0x5A,0x50,0x51,0x1D,0xB1,0x63,0x4D,0xF9,0x03,0x8B,0x32,0x98,0xA8};
-	hci_le_set_scan_response_data(18, uuidscanresponse);
+	if((Conn_Details.ConnectionStatus != STATE_CONNECTED) &&
+		 ((pPhase == NULL) || (pPhase->Interval_Min >= ADVMGR_SLOW_INTERV_MIN)))
+	{
+		Id = CLOCK_PROFILE_IDLE_LOW_POWER;
+	}
+
+	/* A rejected profile keeps the current clocks */
+	if(Id != ClockProfile_GetCurrent())
+	{
+		(void)ClockProfile_Set(Id);
+	}
+}
+#endif
+
+/**
+  * @brief	Reads the state the lost events would have reported
+  * @note		Called from the main loop by the HCI monitor, after aci_blue_events_lost_event. Lost
+  *					writes are applied again from the values held by the GATT server: the last one wins.
+  */
+static void Server_RecoverLostEvents(uint64_t Lost_Events)
+{
+	uint8_t link_status[8];
+	uint16_t link_handle[8];
+	uint8_t value[20];
+	uint16_t length, value_length;
+	uint8_t i, connected = 0;
 	
-	/* Place Bluetooth Peripheral Device in Advertising State */
-	ret = aci_gap_set_discoverable(ADV_IND, ADV_INTERV_MIN, ADV_INTERV_MAX, PUBLIC_ADDR,
-																	NO_WHITE_LIST_USE, sizeof(local_name), (uint8_t*)local_name,
-																	0, NULL, 0, 0);
+	if(Lost_Events & (HCIMON_LOST_DISCONNECTION | HCIMON_LOST_CONNECTION_COMPLETE))
+	{
+		if(aci_hal_get_link_status(link_status, link_handle) == BLE_STATUS_SUCCESS)
+		{
+			for(i = 0; i < 8; i++)
+			{
+				/* 0x02: connected as slave, 0x05: connected as master */
+				if((link_status[i] == 0x02) || (link_status[i] == 0x05))
+				{
+					connected = 1;
+					break;
+				}
+			}
+			
+			if(!connected && (Conn_Details.ConnectionStatus == STATE_CONNECTED))
+			{
+				/* Disconnection lost: run it now, the FSM advertises again */
+				hci_disconnection_complete_event(BLE_STATUS_SUCCESS, Conn_Details.connectionhandle, 0x08);
+			}
+			else if(connected && (Conn_Details.ConnectionStatus != STATE_CONNECTED))
+			{
+				/* Connection lost: its parameters are unknown until the next update */
+				Conn_Details.connectionhandle = link_handle[i];
+				Conn_Details.ConnectionStatus = STATE_CONNECTED;
+				AdvMgr_Connected();
+			}
+		}
+	}
 	
-	if (ret != BLE_STATUS_SUCCESS)
+	if((Lost_Events & HCIMON_LOST_ATTRIBUTE_MODIFIED) && (Conn_Details.ConnectionStatus == STATE_CONNECTED))
+	{
+		if(aci_gatt_read_handle_value(hClientWRITE + 1, 0, sizeof(value), &length, &value_length, value) == BLE_STATUS_SUCCESS)
+		{
+			aci_gatt_attribute_modified_event(Conn_Details.connectionhandle, hClientWRITE + 1, 0, value_length, value);
+		}
+	}
+}
+
+/**
+  * @brief	Enables BLE Peripheral device to be discoverable by advertising (with certain parameters)
+  * @note		When BLE Peripheral adverises, it does so periodically at certain intervals. At these times
+  *					power consumption of device will be high. The advertising manager starts fast, for a quick
+  *					reconnection, then backs off (see Adv_Manager.h). The name and scan response are set in
+  *					BlueNRG_Init().
+  */
+void BlueNRG_MakeDeviceDiscoverable(void)
+{
+	/* Place Bluetooth Peripheral Device in Advertising State: ADV_IND (undirected scannable and
+	   connectable), public address, no white list */
+	if(AdvMgr_Start() != ADVMGR_OK)
 	{
 		(void)strncpy(pText, "Error at Discoverable Mode\r\n", TEXTSIZE);
 		HAL_UART_Transmit(&huart1, (uint8_t*)pText, TEXTSIZE, UART_TIMEOUT);
 		while(1);	
 	}
 	
-	// ret = hci_le_set_advertising_data();
-	
 	Conn_Details.ConnectionStatus = STATE_AWAITING_CONNECTION;
 }
 
@@ -457,6 +575,17 @@ void APP_UserEvtRx(void *pData)
     {
       evt_le_meta_event *evt = (void *)event_pckt->data;
 
+#if (BLE2_DEBUG == 1)
+      (void)EvtMask_Check(EVTMASK_ID(EVTMASK_CLASS_LE, evt->subevent));
+#endif
+
+      /* Advertising reports go to the observer straight from the event buffer */
+      if((evt->subevent == EVT_LE_ADVERTISING_REPORT) &&
+         Observer_HandleEvent(evt->data, (uint16_t)(event_pckt->plen - 1U)))
+      {
+        return;
+      }
+
       for (i = 0; i < (sizeof(hci_le_meta_events_table)/sizeof(hci_le_meta_events_table_type)); i++)
       {
         if (evt->subevent == hci_le_meta_events_table[i].evt_code)
@@ -469,6 +598,10 @@ void APP_UserEvtRx(void *pData)
     {
       evt_blue_aci *blue_evt = (void*)event_pckt->data;
 
+#if (BLE2_DEBUG == 1)
+      (void)EvtMask_Check(EVTMASK_ID(EVTMASK_CLASS_VENDOR, blue_evt->ecode));
+#endif
+
       for (i = 0; i < (sizeof(hci_vendor_specific_events_table)/sizeof(hci_vendor_specific_events_table_type)); i++)
       {
         if (blue_evt->ecode == hci_vendor_specific_events_table[i].evt_code)
@@ -479,6 +612,10 @@ void APP_UserEvtRx(void *pData)
     }
     else
     {
+#if (BLE2_DEBUG == 1)
+      (void)EvtMask_Check(EVTMASK_ID(EVTMASK_CLASS_HCI, event_pckt->evt));
+#endif
+
       for (i = 0; i < (sizeof(hci_events_table)/sizeof(hci_events_table_type)); i++)
       {
         if (event_pckt->evt == hci_events_table[i].evt_code)
@@ -523,8 +660,50 @@ void hci_le_connection_complete_event(uint8_t Status,
 	/* Update connection status to connected */
 	Conn_Details.ConnectionStatus = STATE_CONNECTED;
 	
+	/* The controller stopped advertising */
+	AdvMgr_Connected();
+	
+	/* Lock onto the anchors of the new connection */
+	TimeSync_Start(Conn_Interval);
+	
+#if defined(DEVICE_TYPE_GAP_CENTRAL)
+	/* Resolve the peer handles, from flash when its database did not change */
+	if(Role == 0x00)
+	{
+		GattCache_Connect(Connection_Handle, Peer_Address_Type, Peer_Address);
+	}
+#endif
+	
 } /* end hci_le_connection_complete_event() */
 
+/*******************************************************************************
+ * Function Name  : hci_le_connection_update_complete_event.
+ * Description    : This event indicates that the connection parameters were 
+ *									updated.
+ * Input          : See file bluenrg1_events.h
+ * Output         : See file bluenrg1_events.h
+ * Return         : See file bluenrg1_events.h
+ *******************************************************************************/
+void hci_le_connection_update_complete_event(uint8_t Status,
+                                             uint16_t Connection_Handle,
+                                             uint16_t Conn_Interval,
+                                             uint16_t Conn_Latency,
+                                             uint16_t Supervision_Timeout)
+{
+	if(Status != BLE_STATUS_SUCCESS)
+	{
+		return;
+	}
+	
+	Conn_Details.BLE_ConnInterval = Conn_Interval;
+	Conn_Details.BLE_ConnLatency = Conn_Latency;
+	Conn_Details.BLE_SupervisionTimeout = Supervision_Timeout;
+	
+	/* The anchors moved, estimate them again */
+	TimeSync_Start(Conn_Interval);
+	
+} /* end hci_le_connection_update_complete_event() */
+
 /*******************************************************************************
  * Function Name  : hci_disconnection_complete_event.
  * Description    : This event indicates the end of a disconnection procedure.
@@ -538,6 +717,14 @@ void hci_disconnection_complete_event(uint8_t Status,
 {
 	/* Resets all connectivity status details */
 	Server_ResetConnectionStatus();
+	TimeSync_Stop();
+	GattCache_Disconnect(Connection_Handle);
+#if PERFTEST_ENABLE
+	PerfTest_Disconnect();
+#endif
+#if OTA_ENABLE
+	Ota_Disconnect();
+#endif
 	
 } /* end hci_disconnection_complete_event() */
 
@@ -571,6 +758,20 @@ void aci_gatt_attribute_modified_event(uint16_t Connection_Handle,
                                        uint16_t Attr_Data_Length,
                                        uint8_t Attr_Data[])
 {
+#if PERFTEST_ENABLE
+	/* Writes to the test service */
+	if(PerfTest_AttributeModified(Connection_Handle, Attr_Handle, Attr_Data_Length, Attr_Data))
+	{
+		return;
+	}
+#endif
+#if OTA_ENABLE
+	/* Writes to the update service */
+	if(Ota_AttributeModified(Connection_Handle, Attr_Handle, Attr_Data_Length, Attr_Data))
+	{
+		return;
+	}
+#endif
 
 	/* Determine which characteristic was modified by Client (Indicate and Notify characteristics
 	   are modified by Client only if Client acknowledges these features on Server) */
@@ -629,6 +830,44 @@ void BlueNRG_Loop(void)
 {
 	hci_user_evt_proc();
 	
+	/* Recover from lost events and lend the reserve packets under load */
+	HciMon_Process();
+	
+	/* Refill notifications and run the jobs that fit before the next radio activity */
+	RadioSched_Process();
+	
+	/* Produce the samples of the next connection event right before its anchor */
+	TimeSync_Process();
+	
+	/* Sample the links and adjust the TX power */
+	LinkMon_Process();
+	
+	/* Advertising interval schedule and manufacturer data rotation */
+	AdvMgr_Process();
+	
+#if defined(DEVICE_TYPE_GAP_PERIPHERAL)
+	/* Clock down while only advertising slowly */
+	Server_SelectClockProfile();
+	
+#endif
+#if PERFTEST_ENABLE
+	/* Test run timeouts and echo probes */
+	PerfTest_Process();
+	
+#endif
+#if OTA_ENABLE
+	/* Firmware update: erase, acknowledgements, verification */
+	Ota_Process();
+	
+#endif
+#if defined(DEVICE_TYPE_GAP_CENTRAL)
+	/* Forget the advertisers gone silent */
+	Observer_Process();
+	
+	/* Next step of the peer database discovery */
+	GattCache_Process();
+	
+#endif
 	/* FSM to handle device connectivity */
 	switch(Conn_Details.ConnectionStatus)
 	{
@@ -678,5 +917,50 @@ void TestUpdateCharacteristic(void)
 	counter++;
 }
 
-/******************************************* END OF FILE *******************************************/
+/**
+  * @brief 	Notify sensor samples, compressed with CODEC_DELTA16 into as few frames as possible
+	* @param	pSamples: samples, interleaved by channel
+	* @param	Count: samples, a multiple of Channels
+	* @param	Channels: 1 to CODEC_MAX_CHANNELS
+	* @retval	Samples sent. Less than Count when the TX buffers are full, the rest is to be sent again
+	*					after aci_gatt_tx_pool_available_event or at the next connection event.
+  */
+uint16_t BlueNRG_NotifySamples(const int16_t *pSamples, uint16_t Count, uint8_t Channels)
+{
+	uint8_t frame[NOTIFY_FRAME_SIZE];
+	uint16_t sent = 0, consumed, length;
+	
+	while(sent < Count)
+	{
+		length = Codec_EncodeDelta16(&pSamples[sent], Count - sent, Channels, frame, NOTIFY_FRAME_SIZE, &consumed);
+		if((length == 0) || (aci_gatt_update_char_value(hService, hClientNotification, 0, length, frame) != BLE_STATUS_SUCCESS))
+		{
+			break;
+		}
+		sent += consumed;
+	}
+	
+	return sent;
+}
+
+/**
+  * @brief 	Notify a text or structured record in one frame, compressed when it helps
+	* @param	pRecord: record
+	* @param	Length: bytes
+	* @retval	1 if sent, 0 if it does not fit a frame once compressed or the TX buffers are full
+  */
+uint8_t BlueNRG_NotifyRecord(const uint8_t *pRecord, uint16_t Length)
+{
+	uint8_t frame[NOTIFY_FRAME_SIZE];
+	uint16_t length;
+	
+	length = Codec_EncodeRecord(pRecord, Length, frame, NOTIFY_FRAME_SIZE);
+	if(length == 0)
+	{
+		return 0;
+	}
+	
+	return (aci_gatt_update_char_value(hService, hClientNotification, 0, length, frame) == BLE_STATUS_SUCCESS) ? 1 : 0;
+}
 
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,341 @@
+/**
+  **************************************************************************************************
+  * @file       : Clock_Profile.c
+  * @brief      : Runtime clock profiles. Switches SYSCLK and the bus prescalers between named
+	*								profiles and retimes everything that depends on them: SysTick (HAL_GetTick),
+	*								the TIM2 microsecond timebase, the SPI1 link to the BlueNRG-2 and the USART1
+	*								console.
+  * @author			:
+  **************************************************************************************************
+  *
+  * A switch goes through the HSI so the PLL can be reprogrammed, then selects the new source and
+  * dividers with the flash latency of the target HCLK. HAL_RCC_ClockConfig() updates
+  * SystemCoreClock and reprograms SysTick, so HAL_GetTick() keeps counting milliseconds.
+  *
+  * ClockProfile_Compute() derives every clock and divider of a profile without touching the
+  * hardware; ClockProfile_Set() refuses any profile it reports as out of range.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include "Clock_Profile.h"
+#include "custom_bus.h"
+#include "hci_tl_interface.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define CLOCKPROFILE_UART_TIMEOUT				10U
+
+
+/* External variables ----------------------------------------------------------------------------*/
+#if CLOCKPROFILE_SWITCH_ENABLE
+extern UART_HandleTypeDef huart1;
+extern TIM_HandleTypeDef htim2;
+#endif
+extern const uint8_t AHBPrescTable[16];
+extern const uint8_t APBPrescTable[8];
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static const ClockProfile_t Profiles[CLOCK_PROFILE_COUNT] =
+{
+	/* 100 MHz = HSI / 16 * 200 / 2, SPI1 = 100 MHz / 16 */
+	{ "BURST_DSP", RCC_SYSCLKSOURCE_PLLCLK, 16, 200, RCC_PLLP_DIV2, 4,
+		RCC_SYSCLK_DIV1, RCC_HCLK_DIV2, RCC_HCLK_DIV1 },
+
+	/* 64 MHz = HSI / 16 * 256 / 4, SPI1 = 64 MHz / 8 */
+	{ "BLE_STREAMING", RCC_SYSCLKSOURCE_PLLCLK, 16, 256, RCC_PLLP_DIV4, 6,
+		RCC_SYSCLK_DIV1, RCC_HCLK_DIV2, RCC_HCLK_DIV1 },
+
+	/* 4 MHz = HSI / 4 with the PLL stopped, SPI1 = 4 MHz / 2 */
+	{ "IDLE_LOW_POWER", RCC_SYSCLKSOURCE_HSI, 16, 200, RCC_PLLP_DIV2, 4,
+		RCC_SYSCLK_DIV4, RCC_HCLK_DIV1, RCC_HCLK_DIV1 },
+};
+
+#if CLOCKPROFILE_SWITCH_ENABLE
+/* Set to a valid profile by the first successful ClockProfile_Set() */
+static ClockProfile_Id_t CurrentProfile = CLOCK_PROFILE_COUNT;
+static ClockProfile_Freq_t CurrentFreq;
+#endif
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static uint32_t ClockProfile_FlashLatency(uint32_t HClk);
+
+
+/**
+  * @brief	Get the settings of a profile
+	* @param	Id: profile
+	* @retval	Profile, NULL if Id is not valid
+	*/
+const ClockProfile_t *ClockProfile_GetProfile(ClockProfile_Id_t Id)
+{
+	if(Id >= CLOCK_PROFILE_COUNT)
+	{
+		return NULL;
+	}
+
+	return &Profiles[Id];
+}
+
+/**
+  * @brief	Derive the clocks, flash latency and SPI1/USART1 dividers of a profile. Only reads
+	*					the profile, so it can be used to check a table before applying it.
+	* @param	pProfile: profile to evaluate
+	* @param	UART_Baudrate: baud rate USART1 must keep
+	* @param	pFreq: filled with the result
+	* @retval	CLOCKPROFILE_ERROR_RANGE if a clock is outside the device limits, if SPI1 cannot be
+	*					brought under BUS_SPI1_BAUDRATE, if TIM2 cannot count microseconds or if the baud
+	*					rate error is too large
+	*/
+ClockProfile_Status_t ClockProfile_Compute(const ClockProfile_t *pProfile, uint32_t UART_Baudrate, ClockProfile_Freq_t *pFreq)
+{
+	uint32_t VCO_In, VCO_Out, Error;
+
+	if((pProfile == NULL) || (pFreq == NULL) || (UART_Baudrate == 0U))
+	{
+		return CLOCKPROFILE_ERROR_PARAM;
+	}
+
+	if(pProfile->SysClk_Source == RCC_SYSCLKSOURCE_PLLCLK)
+	{
+		if((pProfile->PLLM < 2U) || (pProfile->PLLM > 63U) || (pProfile->PLLN < 50U) || (pProfile->PLLN > 432U) ||
+			 (pProfile->PLLQ < 2U) || (pProfile->PLLQ > 15U))
+		{
+			return CLOCKPROFILE_ERROR_RANGE;
+		}
+
+		VCO_In = HSI_VALUE / pProfile->PLLM;
+		VCO_Out = VCO_In * pProfile->PLLN;
+		if((VCO_In < CLOCKPROFILE_VCO_IN_MIN) || (VCO_In > CLOCKPROFILE_VCO_IN_MAX) ||
+			 (VCO_Out < CLOCKPROFILE_VCO_OUT_MIN) || (VCO_Out > CLOCKPROFILE_VCO_OUT_MAX))
+		{
+			return CLOCKPROFILE_ERROR_RANGE;
+		}
+
+		pFreq->SysClk = VCO_Out / pProfile->PLLP;
+	}
+	else if(pProfile->SysClk_Source == RCC_SYSCLKSOURCE_HSI)
+	{
+		pFreq->SysClk = HSI_VALUE;
+	}
+	else
+	{
+		return CLOCKPROFILE_ERROR_PARAM;
+	}
+
+	pFreq->HClk = pFreq->SysClk >> AHBPrescTable[(pProfile->AHB_Divider & RCC_CFGR_HPRE) >> RCC_CFGR_HPRE_Pos];
+	pFreq->PClk1 = pFreq->HClk >> APBPrescTable[(pProfile->APB1_Divider & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos];
+	pFreq->PClk2 = pFreq->HClk >> APBPrescTable[(pProfile->APB2_Divider & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos];
+
+	if((pFreq->SysClk > CLOCKPROFILE_SYSCLK_MAX) || (pFreq->PClk1 > CLOCKPROFILE_PCLK1_MAX) ||
+		 (pFreq->PClk2 > CLOCKPROFILE_PCLK2_MAX))
+	{
+		return CLOCKPROFILE_ERROR_RANGE;
+	}
+
+	/* Timers on APB1 run at twice PCLK1 as soon as APB1 is divided */
+	pFreq->TimClk1 = (pProfile->APB1_Divider == RCC_HCLK_DIV1) ? pFreq->PClk1 : (2U * pFreq->PClk1);
+	if((pFreq->TimClk1 % 1000000U) != 0U)
+	{
+		return CLOCKPROFILE_ERROR_RANGE;
+	}
+	pFreq->TIM2_Prescaler = (pFreq->TimClk1 / 1000000U) - 1U;
+	pFreq->Flash_Latency = ClockProfile_FlashLatency(pFreq->HClk);
+
+	/* SPI1 and USART1 both sit on APB2 */
+	pFreq->SPI_Prescaler = BSP_SPI1_GetPrescaler(pFreq->PClk2);
+	pFreq->SPI_Baudrate = pFreq->PClk2 >> (((pFreq->SPI_Prescaler & SPI_CR1_BR) >> SPI_CR1_BR_Pos) + 1U);
+	if(pFreq->SPI_Baudrate > BUS_SPI1_BAUDRATE)
+	{
+		return CLOCKPROFILE_ERROR_RANGE;
+	}
+
+	/* With 16x oversampling the baud rate is PCLK2 / BRR; the mantissa must be at least 1 */
+	pFreq->UART_BRR = UART_BRR_SAMPLING16(pFreq->PClk2, UART_Baudrate);
+	if(pFreq->UART_BRR < 16U)
+	{
+		return CLOCKPROFILE_ERROR_RANGE;
+	}
+	pFreq->UART_Baudrate = (pFreq->PClk2 + (pFreq->UART_BRR / 2U)) / pFreq->UART_BRR;
+
+	Error = (pFreq->UART_Baudrate > UART_Baudrate) ? (pFreq->UART_Baudrate - UART_Baudrate) : (UART_Baudrate - pFreq->UART_Baudrate);
+	if(((uint64_t)Error * 1000U) > ((uint64_t)UART_Baudrate * CLOCKPROFILE_UART_ERROR_MAX))
+	{
+		return CLOCKPROFILE_ERROR_RANGE;
+	}
+
+	return CLOCKPROFILE_OK;
+}
+
+#if CLOCKPROFILE_SWITCH_ENABLE
+/**
+  * @brief	Switch to a clock profile and retime SysTick, TIM2, SPI1 and USART1
+	* @note		Must not be called from interrupt context. The BlueNRG-2 IRQ is held off during the
+	*					switch, an event raised meanwhile is serviced right after.
+	* @param	Id: profile to apply
+	* @retval	Status, the previous clocks are kept when the profile is rejected
+	*/
+ClockProfile_Status_t ClockProfile_Set(ClockProfile_Id_t Id)
+{
+	RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+	RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+	ClockProfile_Freq_t Freq;
+	const ClockProfile_t *pProfile;
+	ClockProfile_Status_t ret;
+	uint32_t IrqEnabled;
+	uint32_t tickstart;
+
+	pProfile = ClockProfile_GetProfile(Id);
+	ret = ClockProfile_Compute(pProfile, huart1.Init.BaudRate, &Freq);
+	if(ret != CLOCKPROFILE_OK)
+	{
+		return ret;
+	}
+
+	IrqEnabled = NVIC_GetEnableIRQ(HCI_TL_SPI_EXTI_IRQn);
+	HAL_NVIC_DisableIRQ(HCI_TL_SPI_EXTI_IRQn);
+
+	/* Let the last character leave with the old divider */
+	if(huart1.gState != HAL_UART_STATE_RESET)
+	{
+		tickstart = HAL_GetTick();
+		while((__HAL_UART_GET_FLAG(&huart1, UART_FLAG_TC) == RESET) && ((HAL_GetTick() - tickstart) < CLOCKPROFILE_UART_TIMEOUT))
+		{
+		}
+	}
+
+	/* Run from the HSI while the PLL is reprogrammed. The current latency is kept, it is always
+	   enough for 16 MHz */
+	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
+															|RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
+	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
+	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+	if(HAL_RCC_ClockConfig(&RCC_ClkInitStruct, __HAL_FLASH_GET_LATENCY()) != HAL_OK)
+	{
+		ret = CLOCKPROFILE_ERROR_RCC;
+	}
+
+	if(ret == CLOCKPROFILE_OK)
+	{
+		RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+		if(pProfile->SysClk_Source == RCC_SYSCLKSOURCE_PLLCLK)
+		{
+			RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+			RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+			RCC_OscInitStruct.PLL.PLLM = pProfile->PLLM;
+			RCC_OscInitStruct.PLL.PLLN = pProfile->PLLN;
+			RCC_OscInitStruct.PLL.PLLP = pProfile->PLLP;
+			RCC_OscInitStruct.PLL.PLLQ = pProfile->PLLQ;
+		}
+		else
+		{
+			RCC_OscInitStruct.PLL.PLLState = RCC_PLL_OFF;
+		}
+
+		if(HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+		{
+			ret = CLOCKPROFILE_ERROR_RCC;
+		}
+	}
+
+	if(ret == CLOCKPROFILE_OK)
+	{
+		/* Also reprograms SysTick from the new HCLK */
+		RCC_ClkInitStruct.SYSCLKSource = pProfile->SysClk_Source;
+		RCC_ClkInitStruct.AHBCLKDivider = pProfile->AHB_Divider;
+		RCC_ClkInitStruct.APB1CLKDivider = pProfile->APB1_Divider;
+		RCC_ClkInitStruct.APB2CLKDivider = pProfile->APB2_Divider;
+		if(HAL_RCC_ClockConfig(&RCC_ClkInitStruct, Freq.Flash_Latency) != HAL_OK)
+		{
+			ret = CLOCKPROFILE_ERROR_RCC;
+		}
+	}
+
+	if(ret == CLOCKPROFILE_OK)
+	{
+		CurrentProfile = Id;
+		CurrentFreq = Freq;
+
+		if(BSP_SPI1_SetPrescaler(Freq.SPI_Prescaler) != BSP_ERROR_NONE)
+		{
+			ret = CLOCKPROFILE_ERROR_BUS;
+		}
+
+		/* The update event that loads the new prescaler also clears the counter, restore it */
+		if(htim2.State != HAL_TIM_STATE_RESET)
+		{
+			uint32_t Count = htim2.Instance->CNT;
+			htim2.Init.Prescaler = Freq.TIM2_Prescaler;
+			htim2.Instance->PSC = Freq.TIM2_Prescaler;
+			htim2.Instance->EGR = TIM_EGR_UG;
+			htim2.Instance->CNT = Count;
+		}
+
+		if(huart1.gState != HAL_UART_STATE_RESET)
+		{
+			__HAL_UART_DISABLE(&huart1);
+			huart1.Instance->BRR = Freq.UART_BRR;
+			__HAL_UART_ENABLE(&huart1);
+		}
+	}
+
+	if(IrqEnabled)
+	{
+		HAL_NVIC_EnableIRQ(HCI_TL_SPI_EXTI_IRQn);
+	}
+
+	return ret;
+}
+
+/**
+  * @brief	Get the profile in use
+	* @retval	Profile, CLOCK_PROFILE_COUNT until the first switch
+	*/
+ClockProfile_Id_t ClockProfile_GetCurrent(void)
+{
+	return CurrentProfile;
+}
+
+/**
+  * @brief	Get the clocks of the profile in use
+	* @retval	Clocks, NULL until the first switch
+	*/
+const ClockProfile_Freq_t *ClockProfile_GetFreq(void)
+{
+	if(CurrentProfile == CLOCK_PROFILE_COUNT)
+	{
+		return NULL;
+	}
+
+	return &CurrentFreq;
+}
+#endif /* CLOCKPROFILE_SWITCH_ENABLE */
+
+/**
+  * @brief	Flash wait states for a given HCLK (VDD 2.7 V - 3.6 V)
+	* @param	HClk: AHB clock in Hz
+	* @retval	FLASH_LATENCY_x
+	*/
+static uint32_t ClockProfile_FlashLatency(uint32_t HClk)
+{
+	if(HClk <= 30000000U)
+	{
+		return FLASH_LATENCY_0;
+	}
+	else if(HClk <= 64000000U)
+	{
+		return FLASH_LATENCY_1;
+	}
+	else if(HClk <= 90000000U)
+	{
+		return FLASH_LATENCY_2;
+	}
+
+	return FLASH_LATENCY_3;
+}
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,177 @@
+/**
+  **************************************************************************************************
+  * @file       : Dsp_Endpoints.c
+  * @brief      : Source and sink of Dsp_Pipeline.c on the target: blocks filled by a circular DMA,
+	*								results notified over BLE.
+  * @author			:
+  **************************************************************************************************
+  *
+  * DMA source: the peripheral (ADC, SPI or I2S of a sensor) runs a circular DMA over a buffer of two
+  * blocks. Its half and full transfer callbacks call Pipe_DmaSource_HalfComplete() and
+  * Pipe_DmaSource_Complete(), the main loop calls Pipe_DmaSource_Process(), which pushes the
+  * filled half to the chain where it lies while the DMA fills the other one. A half the DMA
+  * comes back to before it was pushed, or while it is pushed, is counted as an overrun: the
+  * chain takes longer than a block period.
+  *
+  * BLE sink: the output block is converted to q15 when needed and notified with
+  * BlueNRG_NotifySamples(). Samples the TX buffers can not take are kept and sent by
+  * Pipe_BleSink_Resume() from the main loop; blocks arriving meanwhile are dropped, not queued.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Dsp_Endpoints.h"
+#include "BLE_Process.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define PIPE_DMA_NONE											((uint8_t)0xFF)
+
+
+/****************************************** DMA source *******************************************/
+
+/**
+  * @brief	Bind a source to a chain, the DMA is started afterwards by the application
+	* @param	pSource: source
+	* @param	pPipe: chain, initialized
+	* @param	pBuffer: 2 * Pipe_BlockBytes() bytes, the circular DMA buffer
+	*/
+void Pipe_DmaSource_Init(Pipe_DmaSource_t *pSource, Pipe_t *pPipe, uint8_t *pBuffer)
+{
+	pSource->pPipe = pPipe;
+	pSource->pBuffer = pBuffer;
+	pSource->Ready[0] = 0;
+	pSource->Ready[1] = 0;
+	pSource->Busy = PIPE_DMA_NONE;
+	pSource->Next = 0;
+	pSource->Overruns = 0;
+}
+
+/**
+  * @brief	First half filled, from the DMA half transfer callback. The DMA now writes the second one.
+	*/
+void Pipe_DmaSource_HalfComplete(Pipe_DmaSource_t *pSource)
+{
+	if(pSource->Ready[1] || (pSource->Busy == 1U))
+	{
+		pSource->Overruns++;
+	}
+	pSource->Ready[0] = 1;
+}
+
+/**
+  * @brief	Second half filled, from the DMA transfer complete callback. The DMA now writes the first one.
+	*/
+void Pipe_DmaSource_Complete(Pipe_DmaSource_t *pSource)
+{
+	if(pSource->Ready[0] || (pSource->Busy == 0U))
+	{
+		pSource->Overruns++;
+	}
+	pSource->Ready[1] = 1;
+}
+
+/**
+  * @brief	Push the filled halves to the chain, in order, from the main loop
+	* @retval	Blocks pushed
+	*/
+uint8_t Pipe_DmaSource_Process(Pipe_DmaSource_t *pSource)
+{
+	uint32_t Bytes = Pipe_BlockBytes(pSource->pPipe);
+	uint8_t Half, Blocks = 0;
+
+	while(pSource->Ready[pSource->Next])
+	{
+		Half = pSource->Next;
+		pSource->Busy = Half;
+		pSource->Ready[Half] = 0;
+
+		Pipe_Push(pSource->pPipe, &pSource->pBuffer[Half * Bytes]);
+
+		pSource->Busy = PIPE_DMA_NONE;
+		pSource->Next = Half ^ 1U;
+		Blocks++;
+	}
+
+	return Blocks;
+}
+
+
+/******************************************* BLE sink ********************************************/
+
+/**
+  * @brief	Initialize a sink
+	* @param	pSink: sink, context of Pipe_BleSink()
+	* @param	pSamples: Out_Block samples of the last node
+	* @param	Capacity: samples of pSamples
+	* @param	Channels: interleaved in the output, see BlueNRG_NotifySamples()
+	* @param	Is_Float: 1 if the last node outputs float32_t, in [-1, 1) (a scale node ahead may
+	*					bring it there), 0 for q15
+	*/
+void Pipe_BleSink_Init(Pipe_BleSink_t *pSink, int16_t *pSamples, uint16_t Capacity, uint8_t Channels, uint8_t Is_Float)
+{
+	pSink->pSamples = pSamples;
+	pSink->Capacity = Capacity;
+	pSink->Channels = Channels;
+	pSink->Is_Float = Is_Float;
+	pSink->Pending = 0;
+	pSink->Offset = 0;
+	pSink->Dropped = 0;
+}
+
+/**
+  * @brief	Sink of the chain, pContext: Pipe_BleSink_t
+	*/
+void Pipe_BleSink(void *pContext, void *pData, uint16_t Samples)
+{
+	Pipe_BleSink_t *pSink = (Pipe_BleSink_t *)pContext;
+	int16_t *pBlock = (int16_t *)pData;
+	uint16_t sent;
+
+	if(!Pipe_BleSink_Resume(pSink) || (Samples > pSink->Capacity))
+	{
+		pSink->Dropped += Samples;
+		return;
+	}
+
+	if(pSink->Is_Float)
+	{
+		arm_float_to_q15((float32_t *)pData, pSink->pSamples, Samples);
+		pBlock = pSink->pSamples;
+	}
+
+	sent = BlueNRG_NotifySamples(pBlock, Samples, pSink->Channels);
+	if(sent < Samples)
+	{
+		/* The chain reuses its buffer, the rest is kept here */
+		pSink->Pending = Samples - sent;
+		if(pBlock != pSink->pSamples)
+		{
+			memcpy(pSink->pSamples, &pBlock[sent], (uint32_t)pSink->Pending * sizeof(int16_t));
+			sent = 0;
+		}
+		pSink->Offset = sent;
+	}
+}
+
+/**
+  * @brief	Send the samples left by the sink, from the main loop or when TX buffers are freed
+	* @retval	1 if nothing is pending any more
+	*/
+uint8_t Pipe_BleSink_Resume(Pipe_BleSink_t *pSink)
+{
+	uint16_t sent;
+
+	if(pSink->Pending != 0U)
+	{
+		sent = BlueNRG_NotifySamples(&pSink->pSamples[pSink->Offset], pSink->Pending, pSink->Channels);
+		pSink->Offset += sent;
+		pSink->Pending -= sent;
+	}
+
+	return (pSink->Pending == 0U);
+}
+
+
+/******************************************* END OF FILE *******************************************/
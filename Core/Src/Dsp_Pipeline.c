@@ -0,0 +1,472 @@
+/**
+  **************************************************************************************************
+  * @file       : Dsp_Pipeline.c
+  * @brief      : Streaming chains of CMSIS-DSP stages. Buffers are planned once at init so that
+	*								stages run in place or ping-pong between shared buffers, without copies.
+  * @author			:
+  **************************************************************************************************
+  *
+  * A chain is a table of nodes, each with the samples it consumes and produces per call: rate
+  * changes (decimators, interpolators, FFT frames) are neighbours whose block sizes are
+  * multiples of each other. A source pushes blocks of the first node, the output of the last
+  * node goes to the sink. After a node runs:
+  *  - its output is accumulated until the next node has a whole block (e.g. 4 decimated blocks
+  *    of 64 samples for an FFT of 256), the upstream nodes run again in the meantime;
+  *  - or the next node runs on every slice of it (e.g. 4 blocks of 64 out of an interpolator).
+  *
+  * The output of each node lives from the call of its producer to the last call of its consumer,
+  * extended to the earlier nodes when it accumulates and to the later ones when it is sliced.
+  * Outputs that never live at the same time share a buffer, so that a plain chain ping-pongs
+  * between two buffers, and nodes with PIPE_FLAG_IN_PLACE keep writing in their input. The
+  * first node reads the pushed block itself: a DMA buffer half is processed where it lies.
+  *
+  *   static arm_biquad_casd_df1_inst_f32 Hp;
+  *   static arm_fir_decimate_instance_f32 Dec;
+  *   static arm_rfft_fast_instance_f32 Fft;
+  *   static const Pipe_Node_t Chain[] =
+  *   {
+  *     PIPE_NODE_Q15_TO_F32(64), PIPE_NODE_BIQUAD_F32(&Hp, 64),
+  *     PIPE_NODE_DECIMATE_F32(&Dec, 64, 4), PIPE_NODE_RFFT_F32(&Fft, 256), PIPE_NODE_POWER_F32(256)
+  *   };
+  *
+  * takes two buffers of 256 floats (2KB): the first holds the converted block, filtered in place,
+  * then the FFT output; the second the decimated blocks until 256 are there, then the power
+  * spectrum, once the FFT has read them.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Dsp_Pipeline.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define PIPE_NO_BUFFER										((uint8_t)0xFF)
+
+
+/* Private macro ---------------------------------------------------------------------------------*/
+#define PIPE_ROUND_UP(n)									(((n) + (PIPE_ALIGN - 1U)) & ~(PIPE_ALIGN - 1U))
+
+
+/* Private types ---------------------------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t Buffer[PIPE_MAX_NODES];						/* Buffer of a node output, PIPE_NO_BUFFER when in place */
+	uint32_t Offset[PIPE_MAX_NODES];					/* Of each buffer in the arena */
+	uint8_t Buffers;
+	uint8_t In_Place;
+	uint32_t Size;
+
+} Pipe_Plan_t;
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static Pipe_Status_t Pipe_Plan(const Pipe_Node_t *pNodes, uint8_t Nodes, Pipe_Plan_t *pPlan);
+static uint8_t Pipe_IsInPlace(const Pipe_Node_t *pNodes, uint8_t Nodes, uint8_t Index);
+static void Pipe_Run(Pipe_t *pPipe, uint8_t Index, uint8_t *pIn);
+
+
+/******************************************* Pipeline ********************************************/
+
+/**
+  * @brief	Bytes of arena a chain needs
+	* @param	pNodes: nodes, in order
+	* @param	Nodes: 1 to PIPE_MAX_NODES
+	* @retval	Bytes, 0 if the chain is not valid
+	*/
+uint32_t Pipe_ArenaSize(const Pipe_Node_t *pNodes, uint8_t Nodes)
+{
+	Pipe_Plan_t plan;
+
+	if(Pipe_Plan(pNodes, Nodes, &plan) != PIPE_OK)
+	{
+		return 0;
+	}
+
+	return plan.Size;
+}
+
+/**
+  * @brief	Check a chain and plan its buffers in the arena
+	* @param	pPipe: pipeline
+	* @param	pNodes: nodes, in order. The table and the instances it points to must stay valid.
+	* @param	Nodes: 1 to PIPE_MAX_NODES
+	* @param	pfSink: called with each output block of the last node
+	* @param	pSink_Context: passed to the sink
+	* @param	pArena: buffers of the chain, PIPE_ALIGN aligned
+	* @param	Arena_Size: bytes, at least Pipe_ArenaSize()
+	* @retval	Status, Arena_Used of the statistics holds the size needed on PIPE_ERROR_ARENA
+	*/
+Pipe_Status_t Pipe_Init(Pipe_t *pPipe, const Pipe_Node_t *pNodes, uint8_t Nodes,
+												Pipe_SinkFunc_t pfSink, void *pSink_Context, uint32_t *pArena, uint32_t Arena_Size)
+{
+	Pipe_Plan_t plan;
+	Pipe_Status_t status;
+	uint8_t i;
+
+	if((pPipe == NULL) || (pfSink == NULL))
+	{
+		return PIPE_ERROR_PARAM;
+	}
+
+	memset(pPipe, 0, sizeof(Pipe_t));
+
+	status = Pipe_Plan(pNodes, Nodes, &plan);
+	if(status != PIPE_OK)
+	{
+		return status;
+	}
+
+	pPipe->Stats.Arena_Used = plan.Size;
+	if((plan.Size > Arena_Size) || ((plan.Size != 0U) && (pArena == NULL)))
+	{
+		return PIPE_ERROR_ARENA;
+	}
+
+	pPipe->pNodes = pNodes;
+	pPipe->Nodes = Nodes;
+	pPipe->pfSink = pfSink;
+	pPipe->pSink_Context = pSink_Context;
+	pPipe->Stats.Buffers = plan.Buffers;
+	pPipe->Stats.In_Place = plan.In_Place;
+
+	for(i = 0; i < Nodes; i++)
+	{
+		pPipe->pOut[i] = (plan.Buffer[i] == PIPE_NO_BUFFER) ? NULL : ((uint8_t *)pArena + plan.Offset[plan.Buffer[i]]);
+	}
+
+	return PIPE_OK;
+}
+
+/**
+  * @brief	Run the chain on a block of the source, down to the sink as far as whole blocks allow
+	* @param	pPipe: pipeline
+	* @param	pBlock: In_Block samples of the first node, overwritten when it runs in place. Not
+	*					needed any more on return.
+	*/
+void Pipe_Push(Pipe_t *pPipe, void *pBlock)
+{
+	pPipe->Stats.Blocks++;
+	Pipe_Run(pPipe, 0, (uint8_t *)pBlock);
+}
+
+/**
+  * @brief	Drop the samples waiting for a whole block, e.g. after a gap in the source
+	*/
+void Pipe_Reset(Pipe_t *pPipe)
+{
+	memset(pPipe->Fill, 0, sizeof(pPipe->Fill));
+}
+
+/**
+  * @brief	Bytes of a block pushed to the chain
+	*/
+uint32_t Pipe_BlockBytes(const Pipe_t *pPipe)
+{
+	return (uint32_t)pPipe->pNodes[0].In_Block * pPipe->pNodes[0].In_Size;
+}
+
+const Pipe_Stats_t *Pipe_GetStats(const Pipe_t *pPipe)
+{
+	return &pPipe->Stats;
+}
+
+/**
+  * @brief	Run a node on a block, then its consumers on every whole block of its output
+	* @note		Recursion depth: the number of nodes
+	*/
+static void Pipe_Run(Pipe_t *pPipe, uint8_t Index, uint8_t *pIn)
+{
+	const Pipe_Node_t *pNode = &pPipe->pNodes[Index];
+	const Pipe_Node_t *pNext;
+	uint8_t *pOut;
+	uint16_t Available, Offset;
+
+	pOut = (pPipe->pOut[Index] == NULL) ? pIn : (pPipe->pOut[Index] + ((uint32_t)pPipe->Fill[Index] * pNode->Out_Size));
+	pNode->pfProcess(pNode->pContext, pIn, pOut, pNode->In_Block);
+	pPipe->Stats.Runs++;
+
+	if((Index + 1U) == pPipe->Nodes)
+	{
+		pPipe->Stats.Sink_Blocks++;
+		pPipe->pfSink(pPipe->pSink_Context, pOut, pNode->Out_Block);
+		return;
+	}
+
+	pNext = &pPipe->pNodes[Index + 1U];
+	if(pPipe->pOut[Index] != NULL)
+	{
+		pPipe->Fill[Index] += pNode->Out_Block;
+		if(pPipe->Fill[Index] < pNext->In_Block)
+		{
+			return;
+		}
+		pOut = pPipe->pOut[Index];
+		Available = pPipe->Fill[Index];
+	}
+	else
+	{
+		Available = pNode->Out_Block;
+	}
+
+	for(Offset = 0; Offset < Available; Offset += pNext->In_Block)
+	{
+		Pipe_Run(pPipe, Index + 1U, pOut + ((uint32_t)Offset * pNode->Out_Size));
+	}
+	pPipe->Fill[Index] = 0;
+}
+
+/**
+  * @brief	In place when flagged, with an output the size of the input, not accumulated
+	*/
+static uint8_t Pipe_IsInPlace(const Pipe_Node_t *pNodes, uint8_t Nodes, uint8_t Index)
+{
+	const Pipe_Node_t *pNode = &pNodes[Index];
+
+	if(((pNode->Flags & PIPE_FLAG_IN_PLACE) == 0U) ||
+		 (((uint32_t)pNode->In_Block * pNode->In_Size) != ((uint32_t)pNode->Out_Block * pNode->Out_Size)))
+	{
+		return 0;
+	}
+
+	return (((Index + 1U) == Nodes) || (pNodes[Index + 1U].In_Block <= pNode->Out_Block));
+}
+
+/**
+  * @brief	Give each node output a buffer, shared with the outputs it never lives together with
+	*/
+static Pipe_Status_t Pipe_Plan(const Pipe_Node_t *pNodes, uint8_t Nodes, Pipe_Plan_t *pPlan)
+{
+	uint8_t First[PIPE_MAX_NODES], Last[PIPE_MAX_NODES];			/* Nodes the content of an output lives over */
+	uint8_t Owner[PIPE_MAX_NODES];														/* Output holding the data of an in-place one */
+	uint32_t Bytes[PIPE_MAX_NODES];
+	uint32_t Size[PIPE_MAX_NODES];
+	uint8_t i, j, b;
+	uint16_t In, Out;
+
+	if((pNodes == NULL) || (Nodes == 0U) || (Nodes > PIPE_MAX_NODES))
+	{
+		return PIPE_ERROR_PARAM;
+	}
+
+	memset(pPlan, 0, sizeof(Pipe_Plan_t));
+
+	for(i = 0; i < Nodes; i++)
+	{
+		if((pNodes[i].pfProcess == NULL) || (pNodes[i].In_Block == 0U) || (pNodes[i].Out_Block == 0U) ||
+			 (pNodes[i].In_Size == 0U) || (pNodes[i].Out_Size == 0U))
+		{
+			return PIPE_ERROR_PARAM;
+		}
+
+		Out = pNodes[i].Out_Block;
+		if((i + 1U) == Nodes)
+		{
+			First[i] = i;
+			Last[i] = i;
+			Bytes[i] = (uint32_t)Out * pNodes[i].Out_Size;
+			continue;
+		}
+
+		In = pNodes[i + 1U].In_Block;
+		if(pNodes[i + 1U].In_Size != pNodes[i].Out_Size)
+		{
+			return PIPE_ERROR_FORMAT;
+		}
+		if(((In > Out) ? (In % Out) : (Out % In)) != 0U)
+		{
+			return PIPE_ERROR_RATE;
+		}
+
+		/* Accumulated: written again by every upstream node. Sliced: read until the downstream ones are done */
+		First[i] = (In > Out) ? 0U : i;
+		Last[i] = (Out > In) ? (Nodes - 1U) : (i + 1U);
+		Bytes[i] = (uint32_t)((In > Out) ? In : Out) * pNodes[i].Out_Size;
+	}
+
+	/* In place: the data stays in the output of the previous node, or in the pushed block */
+	for(i = 0; i < Nodes; i++)
+	{
+		Owner[i] = i;
+		if(!Pipe_IsInPlace(pNodes, Nodes, i))
+		{
+			continue;
+		}
+
+		pPlan->In_Place++;
+		Owner[i] = PIPE_NO_BUFFER;
+		if((i != 0U) && (Owner[i - 1U] != PIPE_NO_BUFFER))
+		{
+			Owner[i] = Owner[i - 1U];
+			Last[Owner[i]] = (Last[i] > Last[Owner[i]]) ? Last[i] : Last[Owner[i]];
+		}
+	}
+
+	/* First buffer free over the whole life of the output */
+	for(i = 0; i < Nodes; i++)
+	{
+		pPlan->Buffer[i] = PIPE_NO_BUFFER;
+		if(Owner[i] != i)
+		{
+			continue;
+		}
+
+		for(b = 0; b < pPlan->Buffers; b++)
+		{
+			for(j = 0; j < i; j++)
+			{
+				if((Owner[j] == j) && (pPlan->Buffer[j] == b) && (First[j] <= Last[i]) && (First[i] <= Last[j]))
+				{
+					break;
+				}
+			}
+			if(j == i)
+			{
+				break;
+			}
+		}
+
+		if(b == pPlan->Buffers)
+		{
+			Size[b] = 0;
+			pPlan->Buffers++;
+		}
+		pPlan->Buffer[i] = b;
+		Size[b] = (Bytes[i] > Size[b]) ? Bytes[i] : Size[b];
+	}
+
+	/* In-place nodes write where their input is */
+	for(i = 0; i < Nodes; i++)
+	{
+		if(Owner[i] != i)
+		{
+			pPlan->Buffer[i] = PIPE_NO_BUFFER;
+		}
+	}
+
+	for(b = 0; b < pPlan->Buffers; b++)
+	{
+		pPlan->Offset[b] = pPlan->Size;
+		pPlan->Size += PIPE_ROUND_UP(Size[b]);
+	}
+
+	return PIPE_OK;
+}
+
+
+/******************************************** Stages *********************************************/
+
+/**
+  * @brief	q15 samples to float, pContext not used
+	*/
+void Pipe_Q15ToF32(void *pContext, void *pIn, void *pOut, uint16_t Samples)
+{
+	(void)pContext;
+	arm_q15_to_float((q15_t *)pIn, (float32_t *)pOut, Samples);
+}
+
+/**
+  * @brief	Gain, pContext: float32_t factor
+	*/
+void Pipe_Scale_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples)
+{
+	arm_scale_f32((float32_t *)pIn, *(const float32_t *)pContext, (float32_t *)pOut, Samples);
+}
+
+/**
+  * @brief	Biquad cascade, pContext: arm_biquad_casd_df1_inst_f32
+	*/
+void Pipe_Biquad_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples)
+{
+	arm_biquad_cascade_df1_f32((const arm_biquad_casd_df1_inst_f32 *)pContext, (float32_t *)pIn, (float32_t *)pOut, Samples);
+}
+
+/**
+  * @brief	FIR filter, pContext: arm_fir_instance_f32 of a Samples block
+	*/
+void Pipe_Fir_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples)
+{
+	arm_fir_f32((const arm_fir_instance_f32 *)pContext, (float32_t *)pIn, (float32_t *)pOut, Samples);
+}
+
+/**
+  * @brief	FIR decimator, pContext: arm_fir_decimate_instance_f32 of a Samples block
+	*/
+void Pipe_Decimate_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples)
+{
+	arm_fir_decimate_f32((const arm_fir_decimate_instance_f32 *)pContext, (float32_t *)pIn, (float32_t *)pOut, Samples);
+}
+
+/**
+  * @brief	FIR interpolator, pContext: arm_fir_interpolate_instance_f32 of a Samples block
+	*/
+void Pipe_Interpolate_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples)
+{
+	arm_fir_interpolate_f32((const arm_fir_interpolate_instance_f32 *)pContext, (float32_t *)pIn, (float32_t *)pOut, Samples);
+}
+
+/**
+  * @brief	Real FFT of Samples points, pContext: arm_rfft_fast_instance_f32. The input is used
+	*					as work area, the output is packed: DC, Nyquist, then bins 1 to N/2 - 1.
+	*/
+void Pipe_Rfft_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples)
+{
+	(void)Samples;
+	arm_rfft_fast_f32((arm_rfft_fast_instance_f32 *)pContext, (float32_t *)pIn, (float32_t *)pOut, 0);
+}
+
+/**
+  * @brief	Power spectrum of a packed real FFT of Samples points: bins 0 to N/2 - 1, pContext
+	*					not used
+	*/
+void Pipe_Power_f32(void *pContext, void *pIn, void *pOut, uint16_t Samples)
+{
+	float32_t *pBins = (float32_t *)pIn;
+	float32_t *pPower = (float32_t *)pOut;
+	float32_t dc = pBins[0];
+
+	(void)pContext;
+	/* Bin k is read before the output of bin k is written */
+	arm_cmplx_mag_squared_f32(&pBins[2], &pPower[1], (Samples / 2U) - 1U);
+	pPower[0] = dc * dc;
+}
+
+
+/****************************************** Host files *******************************************/
+#if defined(ARM_MATH_HOST_X86)
+
+/**
+  * @brief	Push the blocks of a file of raw samples, as the DMA would
+	* @param	pPipe: pipeline
+	* @param	pFile: samples of the first node, native byte order
+	* @param	pBlock: Pipe_BlockBytes() bytes
+	* @retval	Blocks pushed, a partial block at the end is left out
+	*/
+uint32_t Pipe_RunFile(Pipe_t *pPipe, FILE *pFile, void *pBlock)
+{
+	uint32_t Bytes = Pipe_BlockBytes(pPipe);
+	uint32_t Blocks = 0;
+
+	while(fread(pBlock, 1, Bytes, pFile) == Bytes)
+	{
+		Pipe_Push(pPipe, pBlock);
+		Blocks++;
+	}
+
+	return Blocks;
+}
+
+/**
+  * @brief	Sink writing raw samples to a file, pContext: Pipe_FileSink_t
+	*/
+void Pipe_FileSink(void *pContext, void *pData, uint16_t Samples)
+{
+	Pipe_FileSink_t *pSink = (Pipe_FileSink_t *)pContext;
+
+	pSink->Samples += (uint32_t)fwrite(pData, pSink->Size, Samples, pSink->pFile);
+}
+
+#endif /* ARM_MATH_HOST_X86 */
+
+
+/******************************************* END OF FILE *******************************************/
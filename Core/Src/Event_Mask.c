@@ -0,0 +1,320 @@
+/**
+  **************************************************************************************************
+  * @file       : Event_Mask.c
+  * @brief      : Event masks derived from the handlers of the application. Modules register the
+	*								events they handle, the five event masks of the BlueNRG-2 are computed from
+	*								them and programmed once at boot.
+  * @author			:
+  **************************************************************************************************
+  *
+  * bluenrg1_events_cb.c gives every event a weak, empty callback, and the controller sends every
+  * event class unless told otherwise. An event nobody handles still raises the IRQ, is read over
+  * SPI, takes a packet of the HCI pool and is dispatched to an empty function.
+  *
+  * The table below maps each event of the dispatch tables to the mask and the bit that enables it.
+  * A mask only gets the bits of registered events, the LE meta event bit of the HCI mask is set as
+  * soon as one LE event is registered. Events without a bit (command completes, BlueNRG events,
+  * permit requests, ...) cannot be disabled and are always sent.
+  *
+  * With BLE2_DEBUG set, APP_UserEvtRx() checks the events received against the registrations and
+  * the first one of each kind without a handler is printed.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Event_Mask.h"
+#include "bluenrg_conf.h"
+#include "bluenrg1_hci_le.h"
+#include "bluenrg1_gap_aci.h"
+#include "bluenrg1_gatt_aci.h"
+#include "bluenrg1_hal_aci.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* Mask enabling an event */
+#define EVTMASK_REG_NONE								0x00U			/* Always sent */
+#define EVTMASK_REG_HCI									0x01U
+#define EVTMASK_REG_LE									0x02U
+#define EVTMASK_REG_GAP									0x03U
+#define EVTMASK_REG_GATT								0x04U
+#define EVTMASK_REG_HAL									0x05U
+
+/* LE Meta-Event bit of the HCI mask */
+#define EVTMASK_HCI_LE_META_BIT					61U
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t Event;
+	uint8_t Register;
+	uint8_t Bit;
+
+} EvtMask_Entry_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static const EvtMask_Entry_t Events[EVTMASK_EVENTS] =
+{
+	{EVTMASK_DISCONNECTION_COMPLETE,						EVTMASK_REG_HCI,	4U},
+	{EVTMASK_ENCRYPTION_CHANGE,									EVTMASK_REG_HCI,	7U},
+	{EVTMASK_READ_REMOTE_VERSION_COMPLETE,			EVTMASK_REG_HCI,	11U},
+	{EVTMASK_HARDWARE_ERROR,										EVTMASK_REG_HCI,	15U},
+	{EVTMASK_NUMBER_OF_COMPLETED_PACKETS,				EVTMASK_REG_NONE,	0U},
+	{EVTMASK_DATA_BUFFER_OVERFLOW,							EVTMASK_REG_HCI,	25U},
+	{EVTMASK_ENCRYPTION_KEY_REFRESH_COMPLETE,		EVTMASK_REG_HCI,	47U},
+
+	{EVTMASK_LE_CONNECTION_COMPLETE,						EVTMASK_REG_LE,		0U},
+	{EVTMASK_LE_ADVERTISING_REPORT,							EVTMASK_REG_LE,		1U},
+	{EVTMASK_LE_CONNECTION_UPDATE_COMPLETE,			EVTMASK_REG_LE,		2U},
+	{EVTMASK_LE_READ_REMOTE_FEATURES_COMPLETE,	EVTMASK_REG_LE,		3U},
+	{EVTMASK_LE_LONG_TERM_KEY_REQUEST,					EVTMASK_REG_LE,		4U},
+	{EVTMASK_LE_DATA_LENGTH_CHANGE,							EVTMASK_REG_LE,		6U},
+	{EVTMASK_LE_READ_LOCAL_P256_KEY_COMPLETE,		EVTMASK_REG_LE,		7U},
+	{EVTMASK_LE_GENERATE_DHKEY_COMPLETE,				EVTMASK_REG_LE,		8U},
+	{EVTMASK_LE_ENHANCED_CONNECTION_COMPLETE,		EVTMASK_REG_LE,		9U},
+	{EVTMASK_LE_DIRECT_ADVERTISING_REPORT,			EVTMASK_REG_LE,		10U},
+
+	{EVTMASK_BLUE_INITIALIZED,									EVTMASK_REG_NONE,	0U},
+	{EVTMASK_BLUE_EVENTS_LOST,									EVTMASK_REG_NONE,	0U},
+	{EVTMASK_BLUE_CRASH_INFO,										EVTMASK_REG_NONE,	0U},
+	{EVTMASK_HAL_END_OF_RADIO_ACTIVITY,					EVTMASK_REG_NONE,	0U},		/* aci_hal_set_radio_activity_mask */
+	{EVTMASK_HAL_SCAN_REQ_REPORT,								EVTMASK_REG_HAL,	0U},
+	{EVTMASK_HAL_FW_ERROR,											EVTMASK_REG_NONE,	0U},
+
+	{EVTMASK_GAP_LIMITED_DISCOVERABLE,					EVTMASK_REG_GAP,	0U},
+	{EVTMASK_GAP_PAIRING_COMPLETE,							EVTMASK_REG_GAP,	1U},
+	{EVTMASK_GAP_PASS_KEY_REQ,									EVTMASK_REG_GAP,	2U},
+	{EVTMASK_GAP_AUTHORIZATION_REQ,							EVTMASK_REG_GAP,	3U},
+	{EVTMASK_GAP_SLAVE_SECURITY_INITIATED,			EVTMASK_REG_GAP,	4U},
+	{EVTMASK_GAP_BOND_LOST,											EVTMASK_REG_GAP,	5U},
+	{EVTMASK_GAP_PROC_COMPLETE,									EVTMASK_REG_GAP,	7U},
+	{EVTMASK_GAP_ADDR_NOT_RESOLVED,							EVTMASK_REG_GAP,	11U},
+	{EVTMASK_GAP_NUMERIC_COMPARISON_VALUE,			EVTMASK_REG_NONE,	0U},
+	{EVTMASK_GAP_KEYPRESS_NOTIFICATION,					EVTMASK_REG_NONE,	0U},
+	{EVTMASK_L2CAP_CONNECTION_UPDATE_RESP,			EVTMASK_REG_GAP,	9U},
+	{EVTMASK_L2CAP_PROC_TIMEOUT,								EVTMASK_REG_GAP,	10U},
+	{EVTMASK_L2CAP_CONNECTION_UPDATE_REQ,				EVTMASK_REG_GAP,	8U},
+	{EVTMASK_L2CAP_COMMAND_REJECT,							EVTMASK_REG_NONE,	0U},
+
+	{EVTMASK_GATT_ATTRIBUTE_MODIFIED,						EVTMASK_REG_GATT,	0U},
+	{EVTMASK_GATT_PROC_TIMEOUT,									EVTMASK_REG_GATT,	1U},
+	{EVTMASK_ATT_EXCHANGE_MTU_RESP,							EVTMASK_REG_GATT,	2U},
+	{EVTMASK_ATT_FIND_INFO_RESP,								EVTMASK_REG_GATT,	3U},
+	{EVTMASK_ATT_FIND_BY_TYPE_VALUE_RESP,				EVTMASK_REG_GATT,	4U},
+	{EVTMASK_ATT_READ_BY_TYPE_RESP,							EVTMASK_REG_GATT,	5U},
+	{EVTMASK_ATT_READ_RESP,											EVTMASK_REG_GATT,	6U},
+	{EVTMASK_ATT_READ_BLOB_RESP,								EVTMASK_REG_GATT,	7U},
+	{EVTMASK_ATT_READ_MULTIPLE_RESP,						EVTMASK_REG_GATT,	8U},
+	{EVTMASK_ATT_READ_BY_GROUP_TYPE_RESP,				EVTMASK_REG_GATT,	9U},
+	{EVTMASK_ATT_PREPARE_WRITE_RESP,						EVTMASK_REG_GATT,	11U},
+	{EVTMASK_ATT_EXEC_WRITE_RESP,								EVTMASK_REG_GATT,	12U},
+	{EVTMASK_GATT_INDICATION,										EVTMASK_REG_GATT,	13U},
+	{EVTMASK_GATT_NOTIFICATION,									EVTMASK_REG_GATT,	14U},
+	{EVTMASK_GATT_PROC_COMPLETE,								EVTMASK_REG_GATT,	16U},
+	{EVTMASK_GATT_ERROR_RESP,										EVTMASK_REG_GATT,	15U},
+	{EVTMASK_GATT_DISC_READ_CHAR_BY_UUID_RESP,	EVTMASK_REG_GATT,	17U},
+	{EVTMASK_GATT_WRITE_PERMIT_REQ,							EVTMASK_REG_NONE,	0U},		/* Asked for by the attribute flags */
+	{EVTMASK_GATT_READ_PERMIT_REQ,							EVTMASK_REG_NONE,	0U},
+	{EVTMASK_GATT_READ_MULTI_PERMIT_REQ,				EVTMASK_REG_NONE,	0U},
+	{EVTMASK_GATT_TX_POOL_AVAILABLE,						EVTMASK_REG_GATT,	18U},
+	{EVTMASK_GATT_SERVER_CONFIRMATION,					EVTMASK_REG_NONE,	0U},
+	{EVTMASK_GATT_PREPARE_WRITE_PERMIT_REQ,			EVTMASK_REG_NONE,	0U},
+};
+
+/* Bit i set when Events[i] has a handler */
+static uint64_t Registered;
+#if (BLE2_DEBUG == 1)
+static uint64_t Reported;
+#endif
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static int8_t EvtMask_Find(uint32_t Event);
+
+
+/**
+  * @brief	Forget the registrations, every maskable event is disabled by EvtMask_Apply()
+	* @note		To be called before the modules register their handlers
+	*/
+void EvtMask_Init(void)
+{
+	Registered = 0;
+#if (BLE2_DEBUG == 1)
+	Reported = 0;
+#endif
+}
+
+/**
+  * @brief	Tell that the application defines the callback of an event
+	* @param	Event: EVTMASK_x identifier
+	* @retval	Status
+	*/
+EvtMask_Status_t EvtMask_Register(uint32_t Event)
+{
+	int8_t Index = EvtMask_Find(Event);
+
+	if(Index < 0)
+	{
+		return EVTMASK_ERROR_UNKNOWN;
+	}
+
+	Registered |= (uint64_t)1U << Index;
+
+	return EVTMASK_OK;
+}
+
+/**
+  * @brief	Register the callbacks of a module at once
+	* @param	pEvents: EVTMASK_x identifiers
+	* @param	Count: number of identifiers
+	* @retval	Status, the known events are registered anyway
+	*/
+EvtMask_Status_t EvtMask_RegisterList(const uint32_t *pEvents, uint8_t Count)
+{
+	EvtMask_Status_t Status = EVTMASK_OK;
+	uint8_t i;
+
+	for(i = 0; i < Count; i++)
+	{
+		if(EvtMask_Register(pEvents[i]) != EVTMASK_OK)
+		{
+			Status = EVTMASK_ERROR_UNKNOWN;
+		}
+	}
+
+	return Status;
+}
+
+/**
+  * @brief	Whether the callback of an event is registered
+	*/
+uint8_t EvtMask_IsRegistered(uint32_t Event)
+{
+	int8_t Index = EvtMask_Find(Event);
+
+	return (uint8_t)((Index >= 0) && (Registered & ((uint64_t)1U << Index)));
+}
+
+/**
+  * @brief	Compute the masks enabling the registered events only
+	* @param	pMasks: the five masks
+	*/
+void EvtMask_GetMasks(EvtMask_Masks_t *pMasks)
+{
+	uint8_t i;
+	uint8_t Bit;
+
+	memset(pMasks, 0, sizeof(*pMasks));
+
+	for(i = 0; i < EVTMASK_EVENTS; i++)
+	{
+		if(!(Registered & ((uint64_t)1U << i)))
+		{
+			continue;
+		}
+
+		Bit = Events[i].Bit;
+		switch(Events[i].Register)
+		{
+			case EVTMASK_REG_HCI:
+				pMasks->HCI[Bit >> 3] |= (uint8_t)(1U << (Bit & 7U));
+				break;
+
+			case EVTMASK_REG_LE:
+				pMasks->LE[Bit >> 3] |= (uint8_t)(1U << (Bit & 7U));
+				pMasks->HCI[EVTMASK_HCI_LE_META_BIT >> 3] |= (uint8_t)(1U << (EVTMASK_HCI_LE_META_BIT & 7U));
+				break;
+
+			case EVTMASK_REG_GAP:
+				pMasks->GAP |= (uint16_t)(1U << Bit);
+				break;
+
+			case EVTMASK_REG_GATT:
+				pMasks->GATT |= (uint32_t)1U << Bit;
+				break;
+
+			case EVTMASK_REG_HAL:
+				pMasks->HAL |= (uint32_t)1U << Bit;
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+/**
+  * @brief	Program the event masks of the controller
+	* @note		To be called once every module has registered, after aci_gatt_init() and aci_gap_init()
+	* @retval	Status
+	*/
+EvtMask_Status_t EvtMask_Apply(void)
+{
+	EvtMask_Masks_t Masks;
+
+	EvtMask_GetMasks(&Masks);
+
+	if((hci_set_event_mask(Masks.HCI) != BLE_STATUS_SUCCESS) ||
+		 (hci_le_set_event_mask(Masks.LE) != BLE_STATUS_SUCCESS) ||
+		 (aci_gap_set_event_mask(Masks.GAP) != BLE_STATUS_SUCCESS) ||
+		 (aci_gatt_set_event_mask(Masks.GATT) != BLE_STATUS_SUCCESS) ||
+		 (aci_hal_set_event_mask(Masks.HAL) != BLE_STATUS_SUCCESS))
+	{
+		return EVTMASK_ERROR_ACI;
+	}
+
+	return EVTMASK_OK;
+}
+
+/**
+  * @brief	Check a received event against the registrations
+	* @param	Event: EVTMASK_x identifier of the event received
+	* @retval	1 if the event has a handler
+	* @note		With BLE2_DEBUG set the first event of each kind without a handler is printed
+	*/
+uint8_t EvtMask_Check(uint32_t Event)
+{
+	int8_t Index = EvtMask_Find(Event);
+
+	if((Index >= 0) && (Registered & ((uint64_t)1U << Index)))
+	{
+		return 1;
+	}
+
+#if (BLE2_DEBUG == 1)
+	if(Index < 0)
+	{
+		PRINT_DBG("Unknown event %u:0x%04X\r\n", (unsigned int)(Event >> 16), (unsigned int)(Event & 0xFFFFU));
+	}
+	else if(!(Reported & ((uint64_t)1U << Index)))
+	{
+		Reported |= (uint64_t)1U << Index;
+		PRINT_DBG("Event %u:0x%04X has no handler\r\n", (unsigned int)(Event >> 16), (unsigned int)(Event & 0xFFFFU));
+	}
+#endif
+
+	return 0;
+}
+
+/**
+  * @brief	Index of an event in the table, -1 if unknown
+	*/
+static int8_t EvtMask_Find(uint32_t Event)
+{
+	uint8_t i;
+
+	for(i = 0; i < EVTMASK_EVENTS; i++)
+	{
+		if(Events[i].Event == Event)
+		{
+			return (int8_t)i;
+		}
+	}
+
+	return -1;
+}
+
+
+/******************************************* END OF FILE *******************************************/
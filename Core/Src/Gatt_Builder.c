@@ -0,0 +1,538 @@
+/**
+  **************************************************************************************************
+  * @file       : Gatt_Builder.c
+  * @brief      : Construction of the GATT database from service tables. The add commands are sent
+	*								back to back, their handle parameters predicted from the layout of the tables.
+  * @author			:
+  **************************************************************************************************
+  *
+  * Every aci_gatt_add_x() call sends a command and waits for its response before returning, and
+  * the next command needs the handle of that response: one round trip per service, per
+  * characteristic and per descriptor.
+  *
+  * The controller allocates handles in order within the range a service reserves:
+  *  - the service takes the handle after the range of the previous service, and reserves
+  *    Max_Attribute_Records handles, its own declaration included;
+  *  - a characteristic takes its declaration and value handles, then its CCCD (notify or
+  *    indicate), SCCD (broadcast) and extended properties descriptor (CHAR_PROP_EXT);
+  *  - a descriptor takes the next handle.
+  * The handles carried by the commands are thus predicted from the tables, and up to
+  * GATTBUILD_WINDOW commands are in flight (as many as the controller grants through its command
+  * credits, see hci_send_cmd_queued()). Every response is checked against the prediction.
+  *
+  * Only the first service of the database is waited for: its handle depends on the services the
+  * GAP and GATT layers added. The handle after the last service is kept for the next run.
+  *
+  * The controller handles the commands in order, so a command carrying a mispredicted service
+  * handle is rejected (no service is declared there yet) and nothing is added at a wrong place.
+  * From the first mispredicted or rejected response on, no new command is sent: one following
+  * with the actual handles would be added before the rejected ones. The commands in flight are
+  * collected, then the rejected ones are sent again, one at a time, with the actual handles.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Gatt_Builder.h"
+#include "hci.h"
+#include "hci_tl.h"
+#include "bluenrg1_gatt_aci.h"
+#include "bluenrg1_gatt_server.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define GATTBUILD_OGF									((uint16_t)0x3F)
+#define GATTBUILD_OCF_ADD_SERVICE			((uint16_t)0x0102)
+#define GATTBUILD_OCF_ADD_CHAR				((uint16_t)0x0104)
+#define GATTBUILD_OCF_ADD_CHAR_DESC		((uint16_t)0x0105)
+
+#define GATTBUILD_ITEM_SERVICE				((uint8_t)0x00)
+#define GATTBUILD_ITEM_CHAR						((uint8_t)0x01)
+#define GATTBUILD_ITEM_NAME						((uint8_t)0x02)
+
+/* Minimum encryption key size, as the services added with the ACI functions */
+#define GATTBUILD_ENC_KEY_SIZE				((uint8_t)0x07)
+
+/* Descriptors the controller adds with a characteristic */
+#define GATTBUILD_CCCD_PROPS					(CHAR_PROP_NOTIFY | CHAR_PROP_INDICATE)
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t Kind;
+	uint8_t Service;
+	uint8_t Char;
+	uint8_t Done;
+
+} GattBuild_Item_t;
+
+typedef struct
+{
+	uint8_t Item;
+	uint16_t Handle;												/* Predicted, 0 when unknown */
+
+} GattBuild_Pending_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static GattBuild_Item_t Items[GATTBUILD_MAX_ITEMS];
+static uint8_t Item_Count;
+
+static GattBuild_Pending_t Pending[GATTBUILD_WINDOW];
+static uint8_t Pending_Head;
+static uint8_t Pending_Count;
+
+/* Commands are serialized here, hci_send_cmd_queued() copies them */
+static uint8_t Command[HCI_MAX_PAYLOAD_SIZE];
+
+/* Handle after the last service added, 0 until a first run */
+static uint16_t Next_Handle;
+
+/* A response differed from the prediction, the commands left wait for the actual handles */
+static uint8_t Resync;
+
+static GattBuild_Stats_t Stats;
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static uint16_t GattBuild_Base(const GattBuild_Service_t *pServices, uint8_t Service);
+static uint16_t GattBuild_Predict(const GattBuild_Service_t *pServices, const GattBuild_Item_t *pItem);
+static uint8_t GattBuild_Serialize(const GattBuild_Service_t *pServices, const GattBuild_Item_t *pItem, uint16_t *pOcf);
+static void GattBuild_Request(struct hci_request *pRequest, uint16_t Ocf, uint8_t Length, uint8_t *pResponse);
+static GattBuild_Status_t GattBuild_Pass(const GattBuild_Service_t *pServices, uint8_t Window);
+static GattBuild_Status_t GattBuild_Collect(const GattBuild_Service_t *pServices);
+static uint8_t *GattBuild_PutU16(uint8_t *p, uint16_t Value);
+
+
+/***************************************** Handle layout *****************************************/
+
+/**
+  * @brief	Handles a characteristic takes, its user description included
+	*/
+uint8_t GattBuild_CharRecords(const GattBuild_Char_t *pChar)
+{
+	uint8_t Records = 2;
+
+	if(pChar->Properties & GATTBUILD_CCCD_PROPS)
+	{
+		Records++;
+	}
+	if(pChar->Properties & CHAR_PROP_BROADCAST)
+	{
+		Records++;
+	}
+	if(pChar->Properties & CHAR_PROP_EXT)
+	{
+		Records++;
+	}
+	if(pChar->pName != NULL)
+	{
+		Records++;
+	}
+
+	return Records;
+}
+
+/**
+  * @brief	Handles a service reserves, its declaration included
+	*/
+uint8_t GattBuild_ServiceRecords(const GattBuild_Service_t *pService)
+{
+	uint8_t Records = 1;
+	uint8_t i;
+
+	if(pService->Max_Records != 0U)
+	{
+		return pService->Max_Records;
+	}
+
+	for(i = 0; i < pService->Chars; i++)
+	{
+		Records += GattBuild_CharRecords(&pService->pChars[i]);
+	}
+
+	return Records;
+}
+
+/**
+  * @brief	Declaration handle of a characteristic
+	* @param	pService: service
+	* @param	Service_Handle: handle of the service declaration
+	* @param	Index: characteristic, in the order of pService->pChars
+	*/
+uint16_t GattBuild_PredictChar(const GattBuild_Service_t *pService, uint16_t Service_Handle, uint8_t Index)
+{
+	uint16_t Handle = Service_Handle + 1U;
+	uint8_t i;
+
+	for(i = 0; i < Index; i++)
+	{
+		Handle += GattBuild_CharRecords(&pService->pChars[i]);
+	}
+
+	return Handle;
+}
+
+
+/****************************************** Construction *****************************************/
+
+/**
+  * @brief	Add services to the GATT database
+	* @param	pServices: services, added in this order
+	* @param	Services: number of services
+	* @retval	GATTBUILD_OK once every attribute is added, the handles are written through the pHandle
+	*					pointers of the tables
+	* @note		To be called after aci_gatt_init() and aci_gap_init()
+	*/
+GattBuild_Status_t GattBuild_Run(const GattBuild_Service_t *pServices, uint8_t Services)
+{
+	GattBuild_Status_t Status;
+	uint32_t Start = HAL_GetTick();
+	uint8_t s, c;
+
+	Item_Count = 0;
+	for(s = 0; s < Services; s++)
+	{
+		if((pServices[s].pHandle == NULL) || (Item_Count >= GATTBUILD_MAX_ITEMS))
+		{
+			return GATTBUILD_ERROR_PARAM;
+		}
+		*pServices[s].pHandle = 0;
+		Items[Item_Count].Kind = GATTBUILD_ITEM_SERVICE;
+		Items[Item_Count].Service = s;
+		Items[Item_Count].Char = 0;
+		Items[Item_Count].Done = 0;
+		Item_Count++;
+
+		for(c = 0; c < pServices[s].Chars; c++)
+		{
+			const GattBuild_Char_t *pChar = &pServices[s].pChars[c];
+
+			if((pChar->pHandle == NULL) || ((Item_Count + 2U) > GATTBUILD_MAX_ITEMS) ||
+				 ((pChar->pName != NULL) && (strlen(pChar->pName) > GATTBUILD_NAME_MAX)))
+			{
+				return GATTBUILD_ERROR_PARAM;
+			}
+			*pChar->pHandle = 0;
+			Items[Item_Count].Kind = GATTBUILD_ITEM_CHAR;
+			Items[Item_Count].Service = s;
+			Items[Item_Count].Char = c;
+			Items[Item_Count].Done = 0;
+			Item_Count++;
+
+			/* The user description right after the characteristic, before the next declaration */
+			if(pChar->pName != NULL)
+			{
+				Items[Item_Count] = Items[Item_Count - 1U];
+				Items[Item_Count].Kind = GATTBUILD_ITEM_NAME;
+				Item_Count++;
+			}
+		}
+	}
+	Pending_Head = 0;
+	Pending_Count = 0;
+	Resync = 0;
+
+	/* Back to back with the predicted handles, then the rejected commands with the actual ones */
+	Status = GattBuild_Pass(pServices, GATTBUILD_WINDOW);
+	if(Status == GATTBUILD_OK)
+	{
+		Status = GattBuild_Pass(pServices, 1);
+	}
+
+	if(Status == GATTBUILD_OK)
+	{
+		for(s = 0; s < Item_Count; s++)
+		{
+			if(!Items[s].Done)
+			{
+				Status = GATTBUILD_ERROR_ACI;
+			}
+		}
+	}
+
+	if((Status == GATTBUILD_OK) && (Services != 0U))
+	{
+		Next_Handle = *pServices[Services - 1U].pHandle + GattBuild_ServiceRecords(&pServices[Services - 1U]);
+	}
+
+	Stats.Build_ms += HAL_GetTick() - Start;
+
+	return Status;
+}
+
+/**
+  * @brief	Counters of the runs since reset
+	*/
+const GattBuild_Stats_t *GattBuild_GetStats(void)
+{
+	return &Stats;
+}
+
+/**
+  * @brief	Handle of a service: the actual one once added, predicted otherwise
+	* @retval	0 when it cannot be predicted yet
+	*/
+static uint16_t GattBuild_Base(const GattBuild_Service_t *pServices, uint8_t Service)
+{
+	uint16_t Handle = Next_Handle;
+	uint8_t s;
+
+	for(s = 0; s <= Service; s++)
+	{
+		if(*pServices[s].pHandle != 0U)
+		{
+			Handle = *pServices[s].pHandle;
+		}
+		else if(Handle == 0U)
+		{
+			return 0;
+		}
+
+		if(s < Service)
+		{
+			Handle += GattBuild_ServiceRecords(&pServices[s]);
+		}
+	}
+
+	return Handle;
+}
+
+/**
+  * @brief	Handle the controller should return for an item
+	*/
+static uint16_t GattBuild_Predict(const GattBuild_Service_t *pServices, const GattBuild_Item_t *pItem)
+{
+	const GattBuild_Service_t *pService = &pServices[pItem->Service];
+	uint16_t Base = GattBuild_Base(pServices, pItem->Service);
+	uint16_t Handle;
+
+	if((pItem->Kind == GATTBUILD_ITEM_SERVICE) || (Base == 0U))
+	{
+		return Base;
+	}
+
+	Handle = *pService->pChars[pItem->Char].pHandle;
+	if(Handle == 0U)
+	{
+		Handle = GattBuild_PredictChar(pService, Base, pItem->Char);
+	}
+
+	if(pItem->Kind == GATTBUILD_ITEM_NAME)
+	{
+		/* Last record of the characteristic */
+		Handle += GattBuild_CharRecords(&pService->pChars[pItem->Char]) - 1U;
+	}
+
+	return Handle;
+}
+
+/**
+  * @brief	Parameters of the add command of an item
+	* @retval	Length of the parameters, 0 if the handles it needs are not known yet
+	*/
+static uint8_t GattBuild_Serialize(const GattBuild_Service_t *pServices, const GattBuild_Item_t *pItem, uint16_t *pOcf)
+{
+	const GattBuild_Service_t *pService = &pServices[pItem->Service];
+	const GattBuild_Char_t *pChar = &pService->pChars[pItem->Char];
+	uint16_t Base = GattBuild_Base(pServices, pItem->Service);
+	uint8_t *p = Command;
+	uint8_t Length;
+
+	if(pItem->Kind == GATTBUILD_ITEM_SERVICE)
+	{
+		*pOcf = GATTBUILD_OCF_ADD_SERVICE;
+		*p++ = UUID_TYPE_128;
+		memcpy(p, pService->pUuid, 16);
+		p += 16;
+		*p++ = PRIMARY_SERVICE;
+		*p++ = GattBuild_ServiceRecords(pService);
+	}
+	else if(Base == 0U)
+	{
+		/* Waits for the handle of the first service */
+		return 0;
+	}
+	else if(pItem->Kind == GATTBUILD_ITEM_CHAR)
+	{
+		*pOcf = GATTBUILD_OCF_ADD_CHAR;
+		p = GattBuild_PutU16(p, Base);
+		*p++ = UUID_TYPE_128;
+		memcpy(p, pChar->pUuid, 16);
+		p += 16;
+		p = GattBuild_PutU16(p, pChar->Max_Length);
+		*p++ = pChar->Properties;
+		*p++ = ATTR_PERMISSION_NONE;
+		*p++ = pChar->Evt_Mask;
+		*p++ = GATTBUILD_ENC_KEY_SIZE;
+		*p++ = pChar->Is_Variable;
+	}
+	else
+	{
+		*pOcf = GATTBUILD_OCF_ADD_CHAR_DESC;
+		Length = (uint8_t)strlen(pChar->pName);
+		p = GattBuild_PutU16(p, Base);
+		p = GattBuild_PutU16(p, (*pChar->pHandle != 0U) ? *pChar->pHandle : GattBuild_PredictChar(pService, Base, pItem->Char));
+		*p++ = UUID_TYPE_16;
+		p = GattBuild_PutU16(p, CHAR_USER_DESC_UUID);
+		*p++ = (pChar->Name_Access == ATTR_ACCESS_READ_ONLY) ? Length : GATTBUILD_NAME_MAX;
+		*p++ = Length;
+		memcpy(p, pChar->pName, Length);
+		p += Length;
+		*p++ = ATTR_PERMISSION_NONE;
+		*p++ = pChar->Name_Access;
+		*p++ = GATT_DONT_NOTIFY_EVENTS;
+		*p++ = GATTBUILD_ENC_KEY_SIZE;
+		*p++ = (pChar->Name_Access == ATTR_ACCESS_READ_ONLY) ? CHAR_VALUE_LEN_CONSTANT : CHAR_VALUE_LEN_VARIABLE;
+	}
+
+	return (uint8_t)(p - Command);
+}
+
+/**
+  * @brief	Request of an add command, the response is the status and a handle
+	*/
+static void GattBuild_Request(struct hci_request *pRequest, uint16_t Ocf, uint8_t Length, uint8_t *pResponse)
+{
+	memset(pRequest, 0, sizeof(struct hci_request));
+	pRequest->ogf = GATTBUILD_OGF;
+	pRequest->ocf = Ocf;
+	pRequest->cparam = Command;
+	pRequest->clen = Length;
+	pRequest->rparam = pResponse;
+	pRequest->rlen = 3;
+}
+
+/**
+  * @brief	Send the items not added yet, Window commands in flight at most
+	*/
+static GattBuild_Status_t GattBuild_Pass(const GattBuild_Service_t *pServices, uint8_t Window)
+{
+	struct hci_request Request;
+	GattBuild_Pending_t *pPending;
+	GattBuild_Status_t Status;
+	uint16_t Ocf = 0;
+	uint8_t Length;
+	uint8_t Next = 0;
+
+	while(1)
+	{
+		while((Next < Item_Count) && Items[Next].Done)
+		{
+			Next++;
+		}
+
+		Length = 0;
+		if((Next < Item_Count) && (Pending_Count < Window) && ((Window == 1U) || !Resync) && (hci_cmd_credits() != 0U))
+		{
+			Length = GattBuild_Serialize(pServices, &Items[Next], &Ocf);
+		}
+
+		if(Length != 0U)
+		{
+			GattBuild_Request(&Request, Ocf, Length, NULL);
+			if(hci_send_cmd_queued(&Request) == 0)
+			{
+				pPending = &Pending[(Pending_Head + Pending_Count) % GATTBUILD_WINDOW];
+				pPending->Item = Next;
+				pPending->Handle = GattBuild_Predict(pServices, &Items[Next]);
+				Pending_Count++;
+				Stats.Commands++;
+				if(Window == 1U)
+				{
+					Stats.Resent++;
+				}
+				Next++;
+				continue;
+			}
+		}
+
+		if(Pending_Count == 0U)
+		{
+			/* Everything sent and answered, or waiting for nothing */
+			return GATTBUILD_OK;
+		}
+
+		Status = GattBuild_Collect(pServices);
+		if(Status != GATTBUILD_OK)
+		{
+			return Status;
+		}
+	}
+}
+
+/**
+  * @brief	Take the response of the oldest command in flight
+	*/
+static GattBuild_Status_t GattBuild_Collect(const GattBuild_Service_t *pServices)
+{
+	struct hci_request Request;
+	GattBuild_Pending_t *pPending = &Pending[Pending_Head];
+	GattBuild_Item_t *pItem = &Items[pPending->Item];
+	uint8_t Response[3] = {0};
+	uint16_t Ocf;
+	uint16_t Handle;
+
+	Ocf = (pItem->Kind == GATTBUILD_ITEM_SERVICE) ? GATTBUILD_OCF_ADD_SERVICE :
+				((pItem->Kind == GATTBUILD_ITEM_CHAR) ? GATTBUILD_OCF_ADD_CHAR : GATTBUILD_OCF_ADD_CHAR_DESC);
+	GattBuild_Request(&Request, Ocf, 0, Response);
+
+	Pending_Head = (Pending_Head + 1U) % GATTBUILD_WINDOW;
+	Pending_Count--;
+
+	if(hci_wait_cmd_response(&Request) < 0)
+	{
+		/* The responses still in flight are lost as well */
+		Pending_Count = 0;
+		return GATTBUILD_ERROR_TIMEOUT;
+	}
+
+	if(Response[0] != BLE_STATUS_SUCCESS)
+	{
+		/* Left for the next pass */
+		Resync = 1;
+		return GATTBUILD_OK;
+	}
+
+	Handle = (uint16_t)(Response[1] | ((uint16_t)Response[2] << 8));
+	pItem->Done = 1;
+
+	if(pPending->Handle != 0U)
+	{
+		if(Handle == pPending->Handle)
+		{
+			Stats.Predicted++;
+		}
+		else
+		{
+			Stats.Mispredicted++;
+			Resync = 1;
+		}
+	}
+
+	if(pItem->Kind == GATTBUILD_ITEM_SERVICE)
+	{
+		*pServices[pItem->Service].pHandle = Handle;
+	}
+	else if(pItem->Kind == GATTBUILD_ITEM_CHAR)
+	{
+		*pServices[pItem->Service].pChars[pItem->Char].pHandle = Handle;
+	}
+
+	return GATTBUILD_OK;
+}
+
+/**
+  * @brief	Write a little endian u16
+	*/
+static uint8_t *GattBuild_PutU16(uint8_t *p, uint16_t Value)
+{
+	p[0] = (uint8_t)Value;
+	p[1] = (uint8_t)(Value >> 8);
+
+	return p + 2;
+}
+
+
+/******************************************* END OF FILE *******************************************/
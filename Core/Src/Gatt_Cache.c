@@ -0,0 +1,781 @@
+/**
+  **************************************************************************************************
+  * @file       : Gatt_Cache.c
+  * @brief      : GATT client attribute cache of the central role. Services and characteristics
+	*								discovered on a peer are kept in flash, keyed by its address, and reused on
+	*								reconnect once a single read confirmed the peer database did not change.
+  * @author			:
+  **************************************************************************************************
+  *
+  * A full discovery costs one ATT round trip per response of the primary service discovery and
+  * of the characteristic discovery of every service, plus a closing request for each procedure.
+  * The results are packed as they stream in from aci_att_read_by_group_type_resp_event and
+  * aci_att_read_by_type_resp_event into an image of at most GATTCACHE_IMAGE_SIZE bytes, saved
+  * over GATTCACHE_CHUNKS key-value records.
+  *
+  * On reconnect the Database Hash characteristic of the peer is read (one round trip). When it
+  * matches the stored hash the image is used as is. Peers without a Database Hash are validated
+  * against a CRC-32 of their primary service list instead, which costs the service discovery but
+  * still skips the characteristic discovery of every service.
+  *
+  * ACI procedures are started from GattCache_Process(), in the main loop, never from the event
+  * callbacks.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Gatt_Cache.h"
+#include "Radio_Sched.h"
+#include "Event_Mask.h"
+#include "bluenrg1_gatt_aci.h"
+#include "bluenrg1_gatt_server.h"
+#include "bluenrg1_events.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define GATTCACHE_REC_SERVICE						((uint8_t)0x01)
+#define GATTCACHE_REC_CHAR							((uint8_t)0x02)
+#define GATTCACHE_REC_TYPE_MASK					((uint8_t)0x03)
+#define GATTCACHE_REC_UUID_128					((uint8_t)0x80)
+
+#define GATTCACHE_SERVICE_SIZE(u)				(5U + (u))			/* Tag, start, end, UUID */
+#define GATTCACHE_CHAR_SIZE(u)					(6U + (u))			/* Tag, declaration, properties, value, UUID */
+
+#define GATTCACHE_DATABASE_HASH_UUID		((uint16_t)0x2B2A)
+#define GATTCACHE_NO_SLOT								((uint8_t)0xFF)
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Callbacks defined below */
+static const uint32_t Handled_Events[] =
+{
+	EVTMASK_GATT_DISC_READ_CHAR_BY_UUID_RESP,
+	EVTMASK_ATT_READ_BY_GROUP_TYPE_RESP,
+	EVTMASK_ATT_READ_BY_TYPE_RESP,
+	EVTMASK_GATT_PROC_COMPLETE,
+};
+
+static GattCache_Image_t Image;
+static GattCache_State_t State;
+static GattCache_ReadyFunc_t ReadyFunc;
+static GattCache_Stats_t Stats;
+
+static uint16_t Conn_Handle;
+static uint8_t Slot;
+static uint32_t Next_Seq;
+static uint8_t Loaded;								/* Image holds the stored database of the peer */
+static uint8_t Pending;								/* Next procedure to be started by GattCache_Process() */
+static uint8_t Verify;								/* Service discovery only checks the stored CRC */
+static uint8_t Overflow;
+static uint8_t Hash_Valid;
+static uint8_t Hash[16];
+static uint32_t Service_Crc;
+static uint16_t Cursor;								/* Service record whose characteristics are discovered */
+static uint16_t Session_Round_Trips;
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static uint8_t GattCache_ReadHeader(uint8_t Peer, GattCache_Header_t *pHeader);
+static void GattCache_Load(uint8_t Peer_Addr_Type, const uint8_t Peer_Addr[6]);
+static void GattCache_Save(void *pContext);
+static void GattCache_StartDiscovery(void);
+static void GattCache_Finish(uint8_t From_Cache);
+static uint8_t GattCache_Append(uint8_t Tag, const uint8_t *pData, uint8_t Length);
+static uint8_t GattCache_RecordSize(const uint8_t *pRecord);
+static uint8_t GattCache_UUIDMatch(const uint8_t *pRecord, uint8_t Offset, uint8_t UUID_Type, const uint8_t *pUUID);
+
+
+/**
+  * @brief	Reset the cache state, to be called once the KV store is up
+	*/
+void GattCache_Init(void)
+{
+	State = GATTCACHE_STATE_IDLE;
+	ReadyFunc = NULL;
+	Pending = 0;
+	Loaded = 0;
+	GattCache_ResetStats();
+	(void)EvtMask_RegisterList(Handled_Events, (uint8_t)(sizeof(Handled_Events) / sizeof(Handled_Events[0])));
+}
+
+/**
+  * @brief	Register the function told when the peer handles are known
+	* @param	Ready: function to call, NULL to remove
+	*/
+void GattCache_SetCallback(GattCache_ReadyFunc_t Ready)
+{
+	ReadyFunc = Ready;
+}
+
+/**
+  * @brief	Start resolving the database of a newly connected peer
+	* @param	Connection_Handle: connection to the peer
+	* @param	Peer_Addr_Type: address type from the connection complete event
+	* @param	Peer_Addr: peer address
+	*/
+void GattCache_Connect(uint16_t Connection_Handle, uint8_t Peer_Addr_Type, const uint8_t Peer_Addr[6])
+{
+	Stats.Connections++;
+	Conn_Handle = Connection_Handle;
+	Session_Round_Trips = 0;
+	Hash_Valid = 0;
+	Overflow = 0;
+
+	GattCache_Load(Peer_Addr_Type, Peer_Addr);
+
+	State = GATTCACHE_STATE_READ_HASH;
+	Pending = 1;
+}
+
+/**
+  * @brief	Stop any procedure running on a connection
+	*/
+void GattCache_Disconnect(uint16_t Connection_Handle)
+{
+	if(Connection_Handle == Conn_Handle)
+	{
+		State = GATTCACHE_STATE_IDLE;
+		Pending = 0;
+	}
+}
+
+/**
+  * @brief	Start the next GATT procedure
+	* @note		To be called from the main loop
+	*/
+void GattCache_Process(void)
+{
+	UUID_t uuid;
+	tBleStatus ret = BLE_STATUS_SUCCESS;
+	const uint8_t *pService;
+
+	if(!Pending)
+	{
+		return;
+	}
+	Pending = 0;
+
+	switch(State)
+	{
+		case GATTCACHE_STATE_READ_HASH:
+		{
+			uuid.UUID_16 = GATTCACHE_DATABASE_HASH_UUID;
+			ret = aci_gatt_read_using_char_uuid(Conn_Handle, 0x0001, 0xFFFF, UUID_TYPE_16, &uuid);
+			break;
+		}
+
+		case GATTCACHE_STATE_DISC_SERVICES:
+		{
+			Service_Crc = 0;
+			ret = aci_gatt_disc_all_primary_services(Conn_Handle);
+			break;
+		}
+
+		case GATTCACHE_STATE_DISC_CHARS:
+		{
+			pService = &Image.Records[Cursor];
+			ret = aci_gatt_disc_all_char_of_service(Conn_Handle, (uint16_t)(pService[1] | (pService[2] << 8)),
+																							(uint16_t)(pService[3] | (pService[4] << 8)));
+			break;
+		}
+
+		default:
+		{
+			break;
+		}
+	}
+
+	if(ret != BLE_STATUS_SUCCESS)
+	{
+		/* Busy (e.g. another procedure running), retry on the next pass */
+		if(ret == BLE_STATUS_NOT_ALLOWED)
+		{
+			Pending = 1;
+		}
+		else
+		{
+			Stats.Errors++;
+			State = GATTCACHE_STATE_FAILED;
+		}
+	}
+}
+
+GattCache_State_t GattCache_GetState(void)
+{
+	return State;
+}
+
+/**
+  * @brief	Look up a primary service of the connected peer
+	* @param	UUID_Type: UUID_TYPE_16 or UUID_TYPE_128
+	* @param	pUUID: UUID, little endian
+	* @param	pStart, pEnd: receive the handle range of the service
+	* @retval	GATTCACHE_ERROR_NOT_READY until the database is resolved
+	*/
+GattCache_Status_t GattCache_FindService(uint8_t UUID_Type, const uint8_t *pUUID, uint16_t *pStart, uint16_t *pEnd)
+{
+	uint16_t Offset = 0;
+	const uint8_t *pRecord;
+
+	if((pUUID == NULL) || (pStart == NULL) || (pEnd == NULL))
+	{
+		return GATTCACHE_ERROR_PARAM;
+	}
+
+	if(State != GATTCACHE_STATE_READY)
+	{
+		return GATTCACHE_ERROR_NOT_READY;
+	}
+
+	while(Offset < Image.Header.Services_Length)
+	{
+		pRecord = &Image.Records[Offset];
+		if(GattCache_UUIDMatch(pRecord, 5, UUID_Type, pUUID))
+		{
+			*pStart = (uint16_t)(pRecord[1] | (pRecord[2] << 8));
+			*pEnd = (uint16_t)(pRecord[3] | (pRecord[4] << 8));
+			return GATTCACHE_OK;
+		}
+		Offset += GattCache_RecordSize(pRecord);
+	}
+
+	return GATTCACHE_ERROR_NOT_FOUND;
+}
+
+/**
+  * @brief	Look up a characteristic of the connected peer
+	* @param	Start, End: handle range to search, e.g. from GattCache_FindService()
+	* @param	UUID_Type: UUID_TYPE_16 or UUID_TYPE_128
+	* @param	pUUID: UUID, little endian
+	* @param	pValue_Handle: receives the handle of the characteristic value
+	* @param	pProperties: receives the characteristic properties, may be NULL
+	* @retval	GATTCACHE_ERROR_NOT_READY until the database is resolved
+	*/
+GattCache_Status_t GattCache_FindChar(uint16_t Start, uint16_t End, uint8_t UUID_Type, const uint8_t *pUUID,
+																			uint16_t *pValue_Handle, uint8_t *pProperties)
+{
+	uint16_t Offset, Decl_Handle;
+	const uint8_t *pRecord;
+
+	if((pUUID == NULL) || (pValue_Handle == NULL))
+	{
+		return GATTCACHE_ERROR_PARAM;
+	}
+
+	if(State != GATTCACHE_STATE_READY)
+	{
+		return GATTCACHE_ERROR_NOT_READY;
+	}
+
+	Offset = Image.Header.Services_Length;
+	while(Offset < (Image.Header.Length - sizeof(GattCache_Header_t)))
+	{
+		pRecord = &Image.Records[Offset];
+		Decl_Handle = (uint16_t)(pRecord[1] | (pRecord[2] << 8));
+		if((Decl_Handle >= Start) && (Decl_Handle <= End) && GattCache_UUIDMatch(pRecord, 6, UUID_Type, pUUID))
+		{
+			*pValue_Handle = (uint16_t)(pRecord[4] | (pRecord[5] << 8));
+			if(pProperties != NULL)
+			{
+				*pProperties = pRecord[3];
+			}
+			return GATTCACHE_OK;
+		}
+		Offset += GattCache_RecordSize(pRecord);
+	}
+
+	return GATTCACHE_ERROR_NOT_FOUND;
+}
+
+/**
+  * @brief	Drop the stored database of a peer (e.g. after a Service Changed indication)
+	*/
+GattCache_Status_t GattCache_Forget(uint8_t Peer_Addr_Type, const uint8_t Peer_Addr[6])
+{
+	GattCache_Header_t Header;
+	uint8_t i, j;
+
+	for(i = 0; i < GATTCACHE_PEERS; i++)
+	{
+		if(GattCache_ReadHeader(i, &Header) &&
+			 (Header.Peer_Addr_Type == Peer_Addr_Type) && (memcmp(Header.Peer_Addr, Peer_Addr, 6) == 0))
+		{
+			for(j = 0; j < GATTCACHE_CHUNKS; j++)
+			{
+				(void)KVStore_Delete(KVSTORE_KEY_GATT_CACHE + (i * GATTCACHE_CHUNKS) + j);
+			}
+			return GATTCACHE_OK;
+		}
+	}
+
+	return GATTCACHE_ERROR_NOT_FOUND;
+}
+
+/**
+  * @brief	Cache statistics
+	*/
+const GattCache_Stats_t *GattCache_GetStats(void)
+{
+	return &Stats;
+}
+
+void GattCache_ResetStats(void)
+{
+	memset(&Stats, 0, sizeof(Stats));
+}
+
+/**
+  * @brief	Read the header of a stored image
+	* @param	Peer: slot, below GATTCACHE_PEERS
+	* @param	pHeader: receives the header
+	* @retval	1 if the slot holds an image of this version
+	*/
+static uint8_t GattCache_ReadHeader(uint8_t Peer, GattCache_Header_t *pHeader)
+{
+	uint8_t Chunk[KVSTORE_MAX_VALUE_SIZE];
+	uint16_t Length = sizeof(Chunk);
+
+	if((KVStore_Read(KVSTORE_KEY_GATT_CACHE + (Peer * GATTCACHE_CHUNKS), Chunk, &Length) != KVSTORE_OK) ||
+		 (Length < sizeof(GattCache_Header_t)))
+	{
+		return 0;
+	}
+
+	memcpy(pHeader, Chunk, sizeof(GattCache_Header_t));
+
+	return (pHeader->Version == GATTCACHE_VERSION) ? 1U : 0U;
+}
+
+/**
+  * @brief	Pick the slot of a peer and load its image
+	* @note		A peer seen for the first time takes a free slot, or the least recently saved one
+	*/
+static void GattCache_Load(uint8_t Peer_Addr_Type, const uint8_t Peer_Addr[6])
+{
+	GattCache_Header_t Header;
+	uint32_t Oldest = UINT32_MAX;
+	uint16_t Length, Offset;
+	uint8_t i, Free = GATTCACHE_NO_SLOT, Old = 0;
+
+	Slot = GATTCACHE_NO_SLOT;
+	Loaded = 0;
+	Next_Seq = 0;
+
+	for(i = 0; i < GATTCACHE_PEERS; i++)
+	{
+		if(!GattCache_ReadHeader(i, &Header))
+		{
+			if(Free == GATTCACHE_NO_SLOT)
+			{
+				Free = i;
+			}
+			continue;
+		}
+
+		if(Header.Seq >= Next_Seq)
+		{
+			Next_Seq = Header.Seq + 1U;
+		}
+		if(Header.Seq < Oldest)
+		{
+			Oldest = Header.Seq;
+			Old = i;
+		}
+		if((Header.Peer_Addr_Type == Peer_Addr_Type) && (memcmp(Header.Peer_Addr, Peer_Addr, 6) == 0))
+		{
+			Slot = i;
+		}
+	}
+
+	if(Slot != GATTCACHE_NO_SLOT)
+	{
+		/* Read the chunks back into the image */
+		Loaded = 1;
+		for(i = 0, Offset = 0; (i < GATTCACHE_CHUNKS) && Loaded; i++)
+		{
+			Length = KVSTORE_MAX_VALUE_SIZE;
+			if(KVStore_Read(KVSTORE_KEY_GATT_CACHE + (Slot * GATTCACHE_CHUNKS) + i, (uint8_t *)&Image + Offset, &Length) != KVSTORE_OK)
+			{
+				Loaded = 0;
+				break;
+			}
+			Offset += Length;
+			if(Offset >= Image.Header.Length)
+			{
+				break;
+			}
+		}
+		Loaded = Loaded && (Offset == Image.Header.Length);
+	}
+	else
+	{
+		Slot = (Free != GATTCACHE_NO_SLOT) ? Free : Old;
+	}
+
+	if(!Loaded)
+	{
+		memset(&Image.Header, 0, sizeof(GattCache_Header_t));
+		Image.Header.Version = GATTCACHE_VERSION;
+		Image.Header.Peer_Addr_Type = Peer_Addr_Type;
+		memcpy(Image.Header.Peer_Addr, Peer_Addr, 6);
+	}
+}
+
+/**
+  * @brief	Write the image of the current peer, split over its key-value records
+	* @note		Run by the radio scheduler in a gap between connection events
+	*/
+static void GattCache_Save(void *pContext)
+{
+	uint16_t Offset, Length;
+	uint8_t i;
+
+	(void)pContext;
+
+	for(i = 0, Offset = 0; i < GATTCACHE_CHUNKS; i++)
+	{
+		if(Offset < Image.Header.Length)
+		{
+			Length = Image.Header.Length - Offset;
+			if(Length > KVSTORE_MAX_VALUE_SIZE)
+			{
+				Length = KVSTORE_MAX_VALUE_SIZE;
+			}
+			if(KVStore_Write(KVSTORE_KEY_GATT_CACHE + (Slot * GATTCACHE_CHUNKS) + i, (uint8_t *)&Image + Offset, Length) != KVSTORE_OK)
+			{
+				Stats.Errors++;
+				return;
+			}
+			Offset += Length;
+		}
+		else
+		{
+			(void)KVStore_Delete(KVSTORE_KEY_GATT_CACHE + (Slot * GATTCACHE_CHUNKS) + i);
+		}
+	}
+
+	Stats.Saves++;
+}
+
+/**
+  * @brief	Throw the records away and discover the whole database
+	*/
+static void GattCache_StartDiscovery(void)
+{
+	Loaded = 0;
+	Verify = 0;
+	Overflow = 0;
+	Image.Header.Length = sizeof(GattCache_Header_t);
+	Image.Header.Services = 0;
+	Image.Header.Services_Length = 0;
+	State = GATTCACHE_STATE_DISC_SERVICES;
+	Pending = 1;
+}
+
+/**
+  * @brief	Database resolved: account, save a new discovery and tell the application
+	*/
+static void GattCache_Finish(uint8_t From_Cache)
+{
+	Stats.Round_Trips += Session_Round_Trips;
+
+	if(From_Cache)
+	{
+		Stats.Hits++;
+		if(Image.Header.Round_Trips > Session_Round_Trips)
+		{
+			Stats.Round_Trips_Saved += Image.Header.Round_Trips - Session_Round_Trips;
+		}
+	}
+	else
+	{
+		Stats.Misses++;
+		if(Overflow)
+		{
+			Stats.Overflows++;
+		}
+		else
+		{
+			Image.Header.Round_Trips = Session_Round_Trips;
+			Image.Header.Seq = Next_Seq++;
+			if(RadioSched_Submit(GattCache_Save, NULL, GATTCACHE_SAVE_US) != RADIOSCHED_OK)
+			{
+				GattCache_Save(NULL);
+			}
+		}
+	}
+
+	State = GATTCACHE_STATE_READY;
+
+	if(ReadyFunc != NULL)
+	{
+		ReadyFunc(Conn_Handle, From_Cache);
+	}
+}
+
+/**
+  * @brief	Add a record at the end of the image
+	* @param	Tag: GATTCACHE_REC_x, with GATTCACHE_REC_UUID_128 for 128-bit UUIDs
+	* @param	pData: record fields as received (little endian handles, then the UUID)
+	* @param	Length: length of the fields
+	* @retval	0 if the image is full
+	*/
+static uint8_t GattCache_Append(uint8_t Tag, const uint8_t *pData, uint8_t Length)
+{
+	uint8_t *pRecord;
+
+	if((Image.Header.Length + 1U + Length) > GATTCACHE_IMAGE_SIZE)
+	{
+		Overflow = 1;
+		return 0;
+	}
+
+	pRecord = (uint8_t *)&Image + Image.Header.Length;
+	pRecord[0] = Tag;
+	memcpy(&pRecord[1], pData, Length);
+	Image.Header.Length += 1U + Length;
+
+	return 1;
+}
+
+static uint8_t GattCache_RecordSize(const uint8_t *pRecord)
+{
+	uint8_t UUID_Size = (pRecord[0] & GATTCACHE_REC_UUID_128) ? 16U : 2U;
+
+	return ((pRecord[0] & GATTCACHE_REC_TYPE_MASK) == GATTCACHE_REC_SERVICE) ? GATTCACHE_SERVICE_SIZE(UUID_Size)
+																																					 : GATTCACHE_CHAR_SIZE(UUID_Size);
+}
+
+static uint8_t GattCache_UUIDMatch(const uint8_t *pRecord, uint8_t Offset, uint8_t UUID_Type, const uint8_t *pUUID)
+{
+	uint8_t Is_128 = (pRecord[0] & GATTCACHE_REC_UUID_128) ? 1U : 0U;
+
+	if(Is_128 != (UUID_Type == UUID_TYPE_128))
+	{
+		return 0;
+	}
+
+	return (memcmp(&pRecord[Offset], pUUID, Is_128 ? 16U : 2U) == 0) ? 1U : 0U;
+}
+
+
+/********************** BLE HCI related events and event callbacks in Stack *****************************/
+
+/*******************************************************************************
+ * Function Name  : aci_gatt_disc_read_char_by_uuid_resp_event.
+ * Description    : Value read by aci_gatt_read_using_char_uuid (Database Hash).
+ * Input          : See file bluenrg1_events.h
+ * Output         : See file bluenrg1_events.h
+ * Return         : See file bluenrg1_events.h
+ *******************************************************************************/
+void aci_gatt_disc_read_char_by_uuid_resp_event(uint16_t Connection_Handle,
+                                                uint16_t Attribute_Handle,
+                                                uint8_t Attribute_Value_Length,
+                                                uint8_t Attribute_Value[])
+{
+	(void)Attribute_Handle;
+
+	if((State == GATTCACHE_STATE_READ_HASH) && (Connection_Handle == Conn_Handle) && (Attribute_Value_Length == 16U))
+	{
+		memcpy(Hash, Attribute_Value, 16);
+		Hash_Valid = 1;
+	}
+
+} /* end aci_gatt_disc_read_char_by_uuid_resp_event() */
+
+/*******************************************************************************
+ * Function Name  : aci_att_read_by_group_type_resp_event.
+ * Description    : Primary services found by aci_gatt_disc_all_primary_services.
+ * Input          : See file bluenrg1_events.h
+ * Output         : See file bluenrg1_events.h
+ * Return         : See file bluenrg1_events.h
+ *******************************************************************************/
+void aci_att_read_by_group_type_resp_event(uint16_t Connection_Handle,
+                                           uint8_t Attribute_Data_Length,
+                                           uint8_t Data_Length,
+                                           uint8_t Attribute_Data_List[])
+{
+	uint8_t i, Tag;
+
+	if((State != GATTCACHE_STATE_DISC_SERVICES) || (Connection_Handle != Conn_Handle))
+	{
+		return;
+	}
+
+	Session_Round_Trips++;
+	Service_Crc = KVStore_CRC32(Service_Crc, Attribute_Data_List, Data_Length);
+
+	if(Verify || ((Attribute_Data_Length != 6U) && (Attribute_Data_Length != 20U)))
+	{
+		return;
+	}
+
+	/* Start handle, end handle, UUID */
+	Tag = GATTCACHE_REC_SERVICE | ((Attribute_Data_Length == 20U) ? GATTCACHE_REC_UUID_128 : 0U);
+	for(i = 0; (i + Attribute_Data_Length) <= Data_Length; i += Attribute_Data_Length)
+	{
+		if(GattCache_Append(Tag, &Attribute_Data_List[i], Attribute_Data_Length))
+		{
+			Image.Header.Services++;
+			Image.Header.Services_Length += 1U + Attribute_Data_Length;
+		}
+	}
+
+} /* end aci_att_read_by_group_type_resp_event() */
+
+/*******************************************************************************
+ * Function Name  : aci_att_read_by_type_resp_event.
+ * Description    : Characteristics found by aci_gatt_disc_all_char_of_service.
+ * Input          : See file bluenrg1_events.h
+ * Output         : See file bluenrg1_events.h
+ * Return         : See file bluenrg1_events.h
+ *******************************************************************************/
+void aci_att_read_by_type_resp_event(uint16_t Connection_Handle,
+                                     uint8_t Handle_Value_Pair_Length,
+                                     uint8_t Data_Length,
+                                     uint8_t Handle_Value_Pair_Data[])
+{
+	uint8_t i, Tag;
+
+	if((State != GATTCACHE_STATE_DISC_CHARS) || (Connection_Handle != Conn_Handle))
+	{
+		return;
+	}
+
+	Session_Round_Trips++;
+
+	if((Handle_Value_Pair_Length != 7U) && (Handle_Value_Pair_Length != 21U))
+	{
+		return;
+	}
+
+	/* Declaration handle, properties, value handle, UUID */
+	Tag = GATTCACHE_REC_CHAR | ((Handle_Value_Pair_Length == 21U) ? GATTCACHE_REC_UUID_128 : 0U);
+	for(i = 0; (i + Handle_Value_Pair_Length) <= Data_Length; i += Handle_Value_Pair_Length)
+	{
+		(void)GattCache_Append(Tag, &Handle_Value_Pair_Data[i], Handle_Value_Pair_Length);
+	}
+
+} /* end aci_att_read_by_type_resp_event() */
+
+/*******************************************************************************
+ * Function Name  : aci_gatt_proc_complete_event.
+ * Description    : End of a GATT procedure, moves the cache to its next step.
+ * Input          : See file bluenrg1_events.h
+ * Output         : See file bluenrg1_events.h
+ * Return         : See file bluenrg1_events.h
+ *******************************************************************************/
+void aci_gatt_proc_complete_event(uint16_t Connection_Handle,
+                                  uint8_t Error_Code)
+{
+	if(Connection_Handle != Conn_Handle)
+	{
+		return;
+	}
+
+	switch(State)
+	{
+		case GATTCACHE_STATE_READ_HASH:
+		{
+			Session_Round_Trips++;
+
+			if(Hash_Valid)
+			{
+				if(Loaded && (Image.Header.Hash_Type == GATTCACHE_HASH_DATABASE) && (memcmp(Image.Header.Hash, Hash, 16) == 0))
+				{
+					GattCache_Finish(1);
+					break;
+				}
+				GattCache_StartDiscovery();
+				Image.Header.Hash_Type = GATTCACHE_HASH_DATABASE;
+				memcpy(Image.Header.Hash, Hash, 16);
+			}
+			else if(Loaded && (Image.Header.Hash_Type == GATTCACHE_HASH_SERVICES))
+			{
+				/* No Database Hash: compare the service list with the stored one */
+				State = GATTCACHE_STATE_DISC_SERVICES;
+				Verify = 1;
+				Pending = 1;
+			}
+			else
+			{
+				GattCache_StartDiscovery();
+				Image.Header.Hash_Type = GATTCACHE_HASH_SERVICES;
+			}
+			break;
+		}
+
+		case GATTCACHE_STATE_DISC_SERVICES:
+		{
+			/* Closing request answered with Attribute Not Found */
+			Session_Round_Trips++;
+
+			if(Error_Code != BLE_STATUS_SUCCESS)
+			{
+				Stats.Errors++;
+				State = GATTCACHE_STATE_FAILED;
+				break;
+			}
+
+			if(Verify)
+			{
+				if(memcmp(Image.Header.Hash, &Service_Crc, sizeof(Service_Crc)) == 0)
+				{
+					GattCache_Finish(1);
+				}
+				else
+				{
+					GattCache_StartDiscovery();
+					Image.Header.Hash_Type = GATTCACHE_HASH_SERVICES;
+				}
+				break;
+			}
+
+			if(Image.Header.Hash_Type == GATTCACHE_HASH_SERVICES)
+			{
+				memcpy(Image.Header.Hash, &Service_Crc, sizeof(Service_Crc));
+			}
+
+			Cursor = 0;
+			if(Image.Header.Services_Length == 0U)
+			{
+				GattCache_Finish(0);
+				break;
+			}
+			State = GATTCACHE_STATE_DISC_CHARS;
+			Pending = 1;
+			break;
+		}
+
+		case GATTCACHE_STATE_DISC_CHARS:
+		{
+			Session_Round_Trips++;
+
+			if(Error_Code != BLE_STATUS_SUCCESS)
+			{
+				Stats.Errors++;
+				State = GATTCACHE_STATE_FAILED;
+				break;
+			}
+
+			Cursor += GattCache_RecordSize(&Image.Records[Cursor]);
+			if(Cursor >= Image.Header.Services_Length)
+			{
+				GattCache_Finish(0);
+				break;
+			}
+			Pending = 1;
+			break;
+		}
+
+		default:
+		{
+			break;
+		}
+	}
+
+} /* end aci_gatt_proc_complete_event() */
+
+
+/******************************************* END OF FILE *******************************************/
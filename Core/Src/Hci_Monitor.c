@@ -0,0 +1,176 @@
+/**
+  **************************************************************************************************
+  * @file       : Hci_Monitor.c
+  * @brief      : HCI backpressure monitor. Collects the event queue counters and the events the
+	*								BlueNRG-2 reports as lost, runs the recovery of the application and lends the
+	*								reserve packet pool to the event queue under sustained load.
+  * @author			:
+  **************************************************************************************************
+  *
+  * When the packet pool of hci_tl.c is empty, the interrupt stops reading and the controller keeps
+  * the events. Once its own queue overflows it drops them and reports the classes dropped with
+  * aci_blue_events_lost_event, e.g. the attribute writes of a phone sending a burst. The lost
+  * classes are accumulated here and handed to the recovery callback from the main loop, where
+  * ACI commands can be issued to read the state again.
+  *
+  * The reserve pool makes the event queue longer. It is only lent while the pool runs empty or
+  * events are lost, a long queue otherwise only makes hci_user_evt_proc() bursts longer and
+  * delays the notification refills of the radio scheduler.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Hci_Monitor.h"
+#include "Event_Mask.h"
+#include "bluenrg1_events.h"
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static HciMon_Stats_t Stats;
+static HciMon_RecoveryFunc_t RecoveryFunc;
+static uint64_t Lost_Pending;
+
+static uint32_t Last_Period;
+static uint32_t Last_Pool_Empty;
+static uint32_t Last_Lost_Reports;
+static uint8_t Quiet_Periods;
+
+
+/**
+  * @brief	Start monitoring, the reserve pool is not lent
+	* @note		To be called after hci_init()
+	*/
+void HciMon_Init(void)
+{
+	memset(&Stats, 0, sizeof(Stats));
+	Lost_Pending = 0;
+	Last_Period = HAL_GetTick();
+	Last_Pool_Empty = hci_get_stats()->pool_empty;
+	Last_Lost_Reports = 0;
+	Quiet_Periods = 0;
+	hci_reserve_enable(FALSE);
+	(void)EvtMask_Register(EVTMASK_BLUE_EVENTS_LOST);
+}
+
+/**
+  * @brief	Set the function that reads the state again after events were lost
+	* @param	Recovery: recovery function, NULL for none
+	*/
+void HciMon_SetRecovery(HciMon_RecoveryFunc_t Recovery)
+{
+	RecoveryFunc = Recovery;
+}
+
+/**
+  * @brief	Run the recovery and adapt the event queue to the load
+	* @note		To be called from the main loop
+	*/
+void HciMon_Process(void)
+{
+	const tHciStats *pHci;
+	uint64_t Lost;
+	uint8_t Pressure;
+
+	if(Lost_Pending != 0U)
+	{
+		Lost = Lost_Pending;
+		Lost_Pending = 0;
+
+		if(RecoveryFunc != NULL)
+		{
+			RecoveryFunc(Lost);
+			Stats.Recoveries++;
+		}
+	}
+
+	if((HAL_GetTick() - Last_Period) < HCIMON_PERIOD_MS)
+	{
+		return;
+	}
+	Last_Period = HAL_GetTick();
+
+	/* Under pressure when the pool ran empty, events were lost or the reserve is still in use */
+	pHci = hci_get_stats();
+	Pressure = (pHci->pool_empty != Last_Pool_Empty) || (Stats.Lost_Reports != Last_Lost_Reports) ||
+						 (Stats.Reserve_Active && (hci_reserve_free() < HCI_READ_PACKET_RESERVE));
+	Last_Pool_Empty = pHci->pool_empty;
+	Last_Lost_Reports = Stats.Lost_Reports;
+
+	if(Pressure)
+	{
+		Quiet_Periods = 0;
+		if(!Stats.Reserve_Active)
+		{
+			hci_reserve_enable(TRUE);
+			Stats.Reserve_Active = 1;
+			Stats.Reserve_Enables++;
+		}
+	}
+	else if(Stats.Reserve_Active && (++Quiet_Periods >= HCIMON_QUIET_PERIODS))
+	{
+		hci_reserve_enable(FALSE);
+		Stats.Reserve_Active = 0;
+		Quiet_Periods = 0;
+	}
+}
+
+const HciMon_Stats_t *HciMon_GetStats(void)
+{
+	return &Stats;
+}
+
+const tHciStats *HciMon_GetHciStats(void)
+{
+	return hci_get_stats();
+}
+
+/**
+  * @brief	Clear the counters, of the event queue too
+	*/
+void HciMon_ResetStats(void)
+{
+	uint8_t Active = Stats.Reserve_Active;
+
+	memset(&Stats, 0, sizeof(Stats));
+	Stats.Reserve_Active = Active;
+	hci_reset_stats();
+	Last_Pool_Empty = 0;
+	Last_Lost_Reports = 0;
+}
+
+
+/*******************************************************************************
+ * Function Name  : aci_blue_events_lost_event.
+ * Description    : The controller event queue overflowed, events of the classes
+ *									set in the bitmap were dropped.
+ * Input          : See file bluenrg1_events.h
+ * Output         : See file bluenrg1_events.h
+ * Return         : See file bluenrg1_events.h
+ *******************************************************************************/
+void aci_blue_events_lost_event(uint8_t Lost_Events[8])
+{
+	uint64_t Mask = 0;
+	uint8_t i;
+
+	for(i = 0; i < 8U; i++)
+	{
+		Mask |= (uint64_t)Lost_Events[i] << (8U * i);
+	}
+
+	for(i = 0; i < HCIMON_LOST_CLASSES; i++)
+	{
+		if((Mask & ((uint64_t)1U << i)) && (Stats.Lost_Count[i] < UINT16_MAX))
+		{
+			Stats.Lost_Count[i]++;
+		}
+	}
+
+	Stats.Lost_Reports++;
+	Stats.Lost_Mask |= Mask;
+	Lost_Pending |= Mask;
+
+} /* end aci_blue_events_lost_event() */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,522 @@
+/**
+  **************************************************************************************************
+  * @file       : KV_Store.c
+  * @brief      : Log-structured key-value store kept in two reserved flash sectors. Used to keep
+	*								the device identity, the BlueNRG-2 update progress and the GATT client cache
+	*								across resets.
+  * @author			:
+  **************************************************************************************************
+  *
+  * Sector layout:
+  *		+ word 0 : KVSTORE_MAGIC, programmed last when a sector is formatted or compacted into
+  *		+ word 1 : sequence number, the valid sector with the highest sequence is the active one
+  *		+ records, appended one after the other up to the first erased word
+  *
+  * Record layout (word aligned):
+  *		+ word 0 : key (bits 0-15) and value length in bytes (bits 16-31)
+  *		+ value, padded with 0xFF up to the next word
+  *		+ CRC32 of word 0 and the value, programmed last so an interrupted write is detected
+  *
+  * A record of length 0 deletes the key. Only the latest record of each key is live; its offset
+  * is kept in a RAM table indexed by key, so lookups never scan the flash.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "KV_Store.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define KVSTORE_MAGIC										((uint32_t)0x3153564B)		/* "KVS1" */
+#define KVSTORE_ERASED_WORD							((uint32_t)0xFFFFFFFF)
+#define KVSTORE_SECTOR_HDR_SIZE					8U
+#define KVSTORE_RECORD_OVERHEAD					8U
+#define KVSTORE_NO_RECORD								((uint16_t)0x0000)
+
+
+/* Private macro ---------------------------------------------------------------------------------*/
+#define KVSTORE_ALIGN4(len)							(((uint32_t)(len) + 3U) & ~3U)
+#define KVSTORE_RECORD_SIZE(len)				(KVSTORE_RECORD_OVERHEAD + KVSTORE_ALIGN4(len))
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static KVStore_IO_t KVStore_IO;
+
+static uint8_t ActiveSector;
+static uint32_t ActiveSequence;
+static uint32_t WriteOffset;
+
+/* Set when the area after the last record is not blank (interrupted write), the next write will
+   then compact first so it never programs over partially written words */
+static uint8_t TailDirty;
+
+/* Offset of the live record of each key in the active sector, KVSTORE_NO_RECORD if none */
+static uint16_t KVIndex[KVSTORE_MAX_KEYS];
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static int32_t KVStore_HAL_Erase(uint8_t Sector);
+static int32_t KVStore_HAL_Program(uint8_t Sector, uint32_t Offset, uint32_t Data);
+static int32_t KVStore_HAL_Read(uint8_t Sector, uint32_t Offset, void *pData, uint32_t Length);
+static KVStore_Status_t KVStore_Format(uint8_t Sector, uint32_t Sequence);
+static KVStore_Status_t KVStore_ReadRecord(uint8_t Sector, uint32_t Offset, uint16_t *pKey,
+																						uint8_t *pValue, uint16_t *pLength);
+static KVStore_Status_t KVStore_AppendRecord(uint8_t Sector, uint32_t Offset, uint16_t Key,
+																							const uint8_t *pValue, uint16_t Length);
+static void KVStore_ScanSector(uint8_t Sector);
+
+
+/************************************ Flash Access Routines ********************************************/
+
+/**
+  * @brief	Erases one of the two sectors reserved for the store
+  */
+static int32_t KVStore_HAL_Erase(uint8_t Sector)
+{
+	FLASH_EraseInitTypeDef EraseInit;
+	uint32_t SectorError = 0;
+	HAL_StatusTypeDef status;
+
+	EraseInit.TypeErase = FLASH_TYPEERASE_SECTORS;
+	EraseInit.Banks = FLASH_BANK_1;
+	EraseInit.Sector = (Sector == 0) ? KVSTORE_SECTOR_A_ID : KVSTORE_SECTOR_B_ID;
+	EraseInit.NbSectors = 1;
+	EraseInit.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+	HAL_FLASH_Unlock();
+	__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+													FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+	status = HAL_FLASHEx_Erase(&EraseInit, &SectorError);
+	HAL_FLASH_Lock();
+
+	return (status == HAL_OK) ? 0 : -1;
+}
+
+/**
+  * @brief	Programs one 32-bit word in one of the two sectors reserved for the store
+  */
+static int32_t KVStore_HAL_Program(uint8_t Sector, uint32_t Offset, uint32_t Data)
+{
+	uint32_t address = ((Sector == 0) ? KVSTORE_SECTOR_A_ADDR : KVSTORE_SECTOR_B_ADDR) + Offset;
+	HAL_StatusTypeDef status;
+
+	HAL_FLASH_Unlock();
+	status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, Data);
+	HAL_FLASH_Lock();
+
+	return (status == HAL_OK) ? 0 : -1;
+}
+
+/**
+  * @brief	Reads from one of the two sectors reserved for the store (memory mapped)
+  */
+static int32_t KVStore_HAL_Read(uint8_t Sector, uint32_t Offset, void *pData, uint32_t Length)
+{
+	uint32_t address = ((Sector == 0) ? KVSTORE_SECTOR_A_ADDR : KVSTORE_SECTOR_B_ADDR) + Offset;
+
+	memcpy(pData, (const void *)(uintptr_t)address, Length);
+
+	return 0;
+}
+
+/**
+  * @brief	Registers the flash access routines. Must be called before KVStore_Init() if the
+  *					internal flash should not be used.
+  */
+void KVStore_RegisterIO(const KVStore_IO_t *fops)
+{
+	KVStore_IO.Erase = fops->Erase;
+	KVStore_IO.Program = fops->Program;
+	KVStore_IO.Read = fops->Read;
+}
+
+
+/************************************ Store Initialization *********************************************/
+
+/**
+  * @brief	Mounts the store: selects the active sector and rebuilds the RAM index from its records
+  * @note		Formats the first sector if neither of them holds a valid store (first boot).
+  */
+KVStore_Status_t KVStore_Init(void)
+{
+	uint32_t header[2][2];
+	uint8_t valid[2];
+	uint32_t word;
+	uint32_t offset;
+	uint8_t i;
+
+	if((KVStore_IO.Erase == NULL) || (KVStore_IO.Program == NULL) || (KVStore_IO.Read == NULL))
+	{
+		KVStore_IO.Erase = KVStore_HAL_Erase;
+		KVStore_IO.Program = KVStore_HAL_Program;
+		KVStore_IO.Read = KVStore_HAL_Read;
+	}
+
+	for(i = 0; i < 2; i++)
+	{
+		KVStore_IO.Read(i, 0, &header[i][0], KVSTORE_SECTOR_HDR_SIZE);
+		valid[i] = (header[i][0] == KVSTORE_MAGIC);
+	}
+
+	if(valid[0] && valid[1])
+	{
+		/* Interrupted or completed compaction: the newest copy wins */
+		ActiveSector = ((int32_t)(header[1][1] - header[0][1]) > 0) ? 1 : 0;
+	}
+	else if(valid[0] || valid[1])
+	{
+		ActiveSector = valid[1] ? 1 : 0;
+	}
+	else
+	{
+		/* Blank or corrupted area, start a new store */
+		if(KVStore_Format(0, 1) != KVSTORE_OK)
+		{
+			return KVSTORE_ERROR_FLASH;
+		}
+		header[0][1] = 1;
+		ActiveSector = 0;
+	}
+	ActiveSequence = header[ActiveSector][1];
+
+	KVStore_ScanSector(ActiveSector);
+
+	/* Anything already programmed after the last record comes from an interrupted write */
+	TailDirty = 0;
+	for(offset = WriteOffset; offset < KVSTORE_SECTOR_SIZE; offset += 4U)
+	{
+		KVStore_IO.Read(ActiveSector, offset, &word, 4);
+		if(word != KVSTORE_ERASED_WORD)
+		{
+			TailDirty = 1;
+			break;
+		}
+	}
+
+	return KVSTORE_OK;
+}
+
+/**
+  * @brief	Erases a sector and marks it as a valid, empty store with the given sequence number
+  */
+static KVStore_Status_t KVStore_Format(uint8_t Sector, uint32_t Sequence)
+{
+	if(KVStore_IO.Erase(Sector) != 0)
+	{
+		return KVSTORE_ERROR_FLASH;
+	}
+
+	/* Magic goes last: a sector is only valid once its header is complete */
+	if((KVStore_IO.Program(Sector, 4, Sequence) != 0) ||
+		 (KVStore_IO.Program(Sector, 0, KVSTORE_MAGIC) != 0))
+	{
+		return KVSTORE_ERROR_FLASH;
+	}
+
+	return KVSTORE_OK;
+}
+
+/**
+  * @brief	Walks the records of a sector, filling the RAM index and setting the append offset
+  */
+static void KVStore_ScanSector(uint8_t Sector)
+{
+	uint8_t value[KVSTORE_MAX_VALUE_SIZE];
+	uint32_t offset = KVSTORE_SECTOR_HDR_SIZE;
+	uint32_t word;
+	uint16_t key;
+	uint16_t length;
+
+	memset(KVIndex, 0, sizeof(KVIndex));
+
+	while((offset + KVSTORE_RECORD_OVERHEAD) <= KVSTORE_SECTOR_SIZE)
+	{
+		KVStore_IO.Read(Sector, offset, &word, 4);
+		if(word == KVSTORE_ERASED_WORD)
+		{
+			break;
+		}
+
+		length = (uint16_t)(word >> 16);
+		if((length > KVSTORE_MAX_VALUE_SIZE) || ((offset + KVSTORE_RECORD_SIZE(length)) > KVSTORE_SECTOR_SIZE))
+		{
+			/* Torn record header, nothing after it can be trusted */
+			break;
+		}
+
+		/* Records whose CRC fails were interrupted while written and are skipped */
+		if(KVStore_ReadRecord(Sector, offset, &key, value, &length) == KVSTORE_OK)
+		{
+			if(key < KVSTORE_MAX_KEYS)
+			{
+				KVIndex[key] = (length != 0) ? (uint16_t)offset : KVSTORE_NO_RECORD;
+			}
+		}
+
+		offset += KVSTORE_RECORD_SIZE(length);
+	}
+
+	WriteOffset = offset;
+}
+
+
+/************************************** Record Handling ************************************************/
+
+/**
+  * @brief	Reads a record and checks its CRC. pValue must hold KVSTORE_MAX_VALUE_SIZE bytes.
+  */
+static KVStore_Status_t KVStore_ReadRecord(uint8_t Sector, uint32_t Offset, uint16_t *pKey,
+																						uint8_t *pValue, uint16_t *pLength)
+{
+	uint32_t word;
+	uint32_t crc_stored;
+	uint32_t crc;
+	uint16_t length;
+
+	KVStore_IO.Read(Sector, Offset, &word, 4);
+	length = (uint16_t)(word >> 16);
+	if(length > KVSTORE_MAX_VALUE_SIZE)
+	{
+		return KVSTORE_ERROR_CRC;
+	}
+
+	KVStore_IO.Read(Sector, Offset + 4U, pValue, length);
+	KVStore_IO.Read(Sector, Offset + 4U + KVSTORE_ALIGN4(length), &crc_stored, 4);
+
+	crc = KVStore_CRC32(0, (const uint8_t *)&word, 4);
+	crc = KVStore_CRC32(crc, pValue, length);
+
+	*pKey = (uint16_t)(word & 0xFFFF);
+	*pLength = length;
+
+	return (crc == crc_stored) ? KVSTORE_OK : KVSTORE_ERROR_CRC;
+}
+
+/**
+  * @brief	Programs a record at the given offset: header, value and finally its CRC
+  */
+static KVStore_Status_t KVStore_AppendRecord(uint8_t Sector, uint32_t Offset, uint16_t Key,
+																							const uint8_t *pValue, uint16_t Length)
+{
+	uint32_t header = ((uint32_t)Length << 16) | Key;
+	uint32_t crc;
+	uint32_t word;
+	uint32_t i;
+
+	crc = KVStore_CRC32(0, (const uint8_t *)&header, 4);
+	crc = KVStore_CRC32(crc, pValue, Length);
+
+	if(KVStore_IO.Program(Sector, Offset, header) != 0)
+	{
+		return KVSTORE_ERROR_FLASH;
+	}
+	Offset += 4U;
+
+	for(i = 0; i < Length; i += 4U)
+	{
+		word = KVSTORE_ERASED_WORD;
+		memcpy(&word, &pValue[i], ((Length - i) < 4U) ? (Length - i) : 4U);
+		if(KVStore_IO.Program(Sector, Offset, word) != 0)
+		{
+			return KVSTORE_ERROR_FLASH;
+		}
+		Offset += 4U;
+	}
+
+	if(KVStore_IO.Program(Sector, Offset, crc) != 0)
+	{
+		return KVSTORE_ERROR_FLASH;
+	}
+
+	return KVSTORE_OK;
+}
+
+
+/************************************** Public Interface ***********************************************/
+
+/**
+  * @brief	Reads the current value of a key
+  * @param	pLength: in, size of the pValue buffer; out, length of the stored value
+  */
+KVStore_Status_t KVStore_Read(uint16_t Key, void *pValue, uint16_t *pLength)
+{
+	uint8_t value[KVSTORE_MAX_VALUE_SIZE];
+	uint16_t key;
+	uint16_t length;
+	KVStore_Status_t ret;
+
+	if((Key >= KVSTORE_MAX_KEYS) || (pValue == NULL) || (pLength == NULL))
+	{
+		return KVSTORE_ERROR_PARAM;
+	}
+
+	if(KVIndex[Key] == KVSTORE_NO_RECORD)
+	{
+		return KVSTORE_ERROR_NOT_FOUND;
+	}
+
+	ret = KVStore_ReadRecord(ActiveSector, KVIndex[Key], &key, value, &length);
+	if(ret != KVSTORE_OK)
+	{
+		return ret;
+	}
+
+	if(length > *pLength)
+	{
+		return KVSTORE_ERROR_PARAM;
+	}
+
+	memcpy(pValue, value, length);
+	*pLength = length;
+
+	return KVSTORE_OK;
+}
+
+/**
+  * @brief	Stores a new value for a key
+  * @note		Nothing is programmed when the stored value is already identical, so callers can
+  *					write unconditionally without wearing the flash.
+  */
+KVStore_Status_t KVStore_Write(uint16_t Key, const void *pValue, uint16_t Length)
+{
+	uint8_t current[KVSTORE_MAX_VALUE_SIZE];
+	uint16_t current_length = KVSTORE_MAX_VALUE_SIZE;
+	KVStore_Status_t ret;
+
+	if((Key >= KVSTORE_MAX_KEYS) || (Length > KVSTORE_MAX_VALUE_SIZE) || ((pValue == NULL) && (Length != 0)))
+	{
+		return KVSTORE_ERROR_PARAM;
+	}
+
+	ret = KVStore_Read(Key, current, &current_length);
+	if(ret == KVSTORE_OK)
+	{
+		if((current_length == Length) && (memcmp(current, pValue, Length) == 0))
+		{
+			return KVSTORE_OK;
+		}
+	}
+	else if((ret == KVSTORE_ERROR_NOT_FOUND) && (Length == 0))
+	{
+		return KVSTORE_OK;
+	}
+
+	if((TailDirty != 0) || ((WriteOffset + KVSTORE_RECORD_SIZE(Length)) > KVSTORE_SECTOR_SIZE))
+	{
+		ret = KVStore_Compact();
+		if(ret != KVSTORE_OK)
+		{
+			return ret;
+		}
+
+		if((WriteOffset + KVSTORE_RECORD_SIZE(Length)) > KVSTORE_SECTOR_SIZE)
+		{
+			return KVSTORE_ERROR_FULL;
+		}
+	}
+
+	ret = KVStore_AppendRecord(ActiveSector, WriteOffset, Key, (const uint8_t *)pValue, Length);
+	if(ret != KVSTORE_OK)
+	{
+		/* Partially programmed words may be left behind, compact before the next append */
+		TailDirty = 1;
+		return ret;
+	}
+
+	KVIndex[Key] = (Length != 0) ? (uint16_t)WriteOffset : KVSTORE_NO_RECORD;
+	WriteOffset += KVSTORE_RECORD_SIZE(Length);
+
+	return KVSTORE_OK;
+}
+
+/**
+  * @brief	Deletes a key (appends an empty record for it)
+  */
+KVStore_Status_t KVStore_Delete(uint16_t Key)
+{
+	return KVStore_Write(Key, NULL, 0);
+}
+
+/**
+  * @brief	Copies the live records into the other sector and makes it the active one
+  * @note		Power loss at any point leaves either the old sector or the complete new one valid,
+  *					since the new sector header is programmed only after all records are copied.
+  */
+KVStore_Status_t KVStore_Compact(void)
+{
+	uint8_t value[KVSTORE_MAX_VALUE_SIZE];
+	uint16_t new_index[KVSTORE_MAX_KEYS];
+	uint8_t target = ActiveSector ^ 1U;
+	uint32_t offset = KVSTORE_SECTOR_HDR_SIZE;
+	uint16_t key;
+	uint16_t length;
+	uint16_t i;
+
+	if(KVStore_IO.Erase(target) != 0)
+	{
+		return KVSTORE_ERROR_FLASH;
+	}
+
+	memset(new_index, 0, sizeof(new_index));
+
+	for(i = 0; i < KVSTORE_MAX_KEYS; i++)
+	{
+		if(KVIndex[i] == KVSTORE_NO_RECORD)
+		{
+			continue;
+		}
+
+		/* A record that went bad in the old sector is dropped rather than copied */
+		if(KVStore_ReadRecord(ActiveSector, KVIndex[i], &key, value, &length) != KVSTORE_OK)
+		{
+			continue;
+		}
+
+		if(KVStore_AppendRecord(target, offset, key, value, length) != KVSTORE_OK)
+		{
+			return KVSTORE_ERROR_FLASH;
+		}
+
+		new_index[i] = (uint16_t)offset;
+		offset += KVSTORE_RECORD_SIZE(length);
+	}
+
+	if((KVStore_IO.Program(target, 4, ActiveSequence + 1U) != 0) ||
+		 (KVStore_IO.Program(target, 0, KVSTORE_MAGIC) != 0))
+	{
+		return KVSTORE_ERROR_FLASH;
+	}
+
+	ActiveSector = target;
+	ActiveSequence++;
+	WriteOffset = offset;
+	TailDirty = 0;
+	memcpy(KVIndex, new_index, sizeof(KVIndex));
+
+	return KVSTORE_OK;
+}
+
+/**
+  * @brief	CRC-32 (IEEE 802.3, reflected) used to protect the records
+  * @param	Crc: 0 to start, or the result of the previous call to continue over several buffers
+  */
+uint32_t KVStore_CRC32(uint32_t Crc, const uint8_t *pData, uint32_t Length)
+{
+	uint32_t i;
+	uint8_t bit;
+
+	Crc = ~Crc;
+	for(i = 0; i < Length; i++)
+	{
+		Crc ^= pData[i];
+		for(bit = 0; bit < 8; bit++)
+		{
+			Crc = (Crc >> 1) ^ (0xEDB88320U & (0U - (Crc & 1U)));
+		}
+	}
+
+	return ~Crc;
+}
+
+/******************************************* END OF FILE *******************************************/
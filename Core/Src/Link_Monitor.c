@@ -0,0 +1,395 @@
+/**
+  **************************************************************************************************
+  * @file       : Link_Monitor.c
+  * @brief      : Link quality monitor and closed loop TX power control. Samples the RSSI of every
+	*								connected link, smooths it together with the loss reported by the application
+	*								and sets the lowest TX power that keeps each link inside its margin.
+  * @author			:
+  **************************************************************************************************
+  *
+  * hci_read_rssi measures the packets of the peer, so it tells the path loss rather than how well
+  * the peer receives this device. Assuming the peer transmits at LINKMON_PEER_TX_DBM, the RSSI at
+  * the peer is estimated as RSSI + own power - LINKMON_PEER_TX_DBM and kept between
+  * LINKMON_TARGET_LOW_DBM and LINKMON_TARGET_HIGH_DBM. The BlueNRG-2 has a single TX power for
+  * all links: the highest level wanted by a link is applied.
+  *
+  * The controller does not see retransmissions. The application reports them through
+  * LinkMon_ReportTx(), e.g. notifications refused with BLE_STATUS_INSUFFICIENT_RESOURCES because
+  * the TX buffers still hold unacknowledged packets.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Link_Monitor.h"
+#include "bluenrg1_hal_aci.h"
+#include "bluenrg1_hci_le.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* Link status values of aci_hal_get_link_status */
+#define LINKMON_STATUS_CONN_SLAVE				((uint8_t)0x02)
+#define LINKMON_STATUS_CONN_MASTER			((uint8_t)0x05)
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t Used;
+	LinkMon_Ctrl_t Ctrl;
+	LinkMon_Stats_t Stats;
+	uint16_t Sent;										/* Reported since the last sample */
+	uint16_t Failed;
+
+} LinkMon_Link_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+/**
+  * @brief TX power ladder of the BlueNRG-2, from the PA level tables of the programming manual,
+  *				 in steps of about 3 dB
+  */
+static const LinkMon_Level_t Levels[] =
+{
+	{0, 0, -18},
+	{0, 1, -15},
+	{0, 2, -12},
+	{0, 3, -9},
+	{0, 4, -6},
+	{1, 4, -2},
+	{0, 6, 0},
+	{1, 5, 2},
+	{1, 6, 4},
+	{1, 7, 8},
+};
+
+#define LINKMON_LEVELS									((uint8_t)(sizeof(Levels) / sizeof(Levels[0])))
+
+static LinkMon_Link_t Links[LINKMON_MAX_LINKS];
+static uint8_t Applied_Level;
+static uint32_t Last_Sample;
+
+
+/*************************************** Power controller ****************************************/
+
+/**
+  * @brief	Reset a link controller
+	* @param	pCtrl: controller
+	* @param	Level: power ladder index the link starts at
+	*/
+void LinkMon_CtrlInit(LinkMon_Ctrl_t *pCtrl, uint8_t Level)
+{
+	memset(pCtrl, 0, sizeof(LinkMon_Ctrl_t));
+	pCtrl->Level = (Level < LINKMON_LEVELS) ? Level : (LINKMON_LEVELS - 1U);
+}
+
+/**
+  * @brief	Feed one sample of a link and get the power it needs
+	* @param	pCtrl: controller
+	* @param	RSSI: RSSI of the link, LINKMON_RSSI_UNAVAILABLE if not measured
+	* @param	Sent: packets sent since the previous sample
+	* @param	Failed: packets among them that had to be retried or were refused
+	* @retval	Power ladder index wanted by the link
+	*/
+uint8_t LinkMon_CtrlUpdate(LinkMon_Ctrl_t *pCtrl, int8_t RSSI, uint16_t Sent, uint16_t Failed)
+{
+	uint32_t Ratio;
+	uint16_t Loss;
+
+	if(RSSI != LINKMON_RSSI_UNAVAILABLE)
+	{
+		if(!pCtrl->Started)
+		{
+			pCtrl->RSSI_Q4 = (int16_t)(RSSI * 16);
+			pCtrl->Started = 1;
+		}
+		else
+		{
+			pCtrl->RSSI_Q4 += (int16_t)(((RSSI * 16) - pCtrl->RSSI_Q4) >> LINKMON_RSSI_SHIFT);
+		}
+	}
+
+	if(Sent != 0U)
+	{
+		Ratio = ((uint32_t)((Failed < Sent) ? Failed : Sent) << 12) / Sent;
+		pCtrl->Loss_Q4 = (uint16_t)((int32_t)pCtrl->Loss_Q4 + (((int32_t)Ratio - (int32_t)pCtrl->Loss_Q4) >> LINKMON_LOSS_SHIFT));
+	}
+
+	if(!pCtrl->Started)
+	{
+		return pCtrl->Level;
+	}
+
+	Loss = pCtrl->Loss_Q4 >> 4;
+
+	if((LinkMon_PeerRSSI(pCtrl, pCtrl->Level) < LINKMON_TARGET_LOW_DBM) || (Loss > LINKMON_LOSS_HIGH))
+	{
+		/* Raise at once: one step for losses, up to the window for a weak signal */
+		if(pCtrl->Level < (LINKMON_LEVELS - 1U))
+		{
+			pCtrl->Level++;
+		}
+		while((pCtrl->Level < (LINKMON_LEVELS - 1U)) && (LinkMon_PeerRSSI(pCtrl, pCtrl->Level) < LINKMON_TARGET_LOW_DBM))
+		{
+			pCtrl->Level++;
+		}
+		pCtrl->Hold = 0;
+	}
+	else if((pCtrl->Level > 0U) && (Loss <= LINKMON_LOSS_LOW) &&
+					(LinkMon_PeerRSSI(pCtrl, pCtrl->Level - 1U) >= LINKMON_TARGET_HIGH_DBM))
+	{
+		/* Lower one step once the margin held for a while */
+		if(++pCtrl->Hold >= LINKMON_LOWER_HOLD)
+		{
+			pCtrl->Level--;
+			pCtrl->Hold = 0;
+		}
+	}
+	else
+	{
+		pCtrl->Hold = 0;
+	}
+
+	return pCtrl->Level;
+}
+
+/**
+  * @brief	RSSI estimated at the peer
+	* @param	pCtrl: controller
+	* @param	Level: power ladder index this device transmits at
+	* @retval	dBm
+	*/
+int8_t LinkMon_PeerRSSI(const LinkMon_Ctrl_t *pCtrl, uint8_t Level)
+{
+	int32_t RSSI = (pCtrl->RSSI_Q4 + 8) >> 4;
+
+	RSSI += Levels[(Level < LINKMON_LEVELS) ? Level : (LINKMON_LEVELS - 1U)].Power_dBm - LINKMON_PEER_TX_DBM;
+
+	return (int8_t)((RSSI < -127) ? -127 : ((RSSI > 126) ? 126 : RSSI));
+}
+
+/**
+  * @brief	Power ladder step
+	* @param	Level: index, below LinkMon_LevelCount()
+	*/
+const LinkMon_Level_t *LinkMon_GetLevel(uint8_t Level)
+{
+	return (Level < LINKMON_LEVELS) ? &Levels[Level] : NULL;
+}
+
+uint8_t LinkMon_LevelCount(void)
+{
+	return LINKMON_LEVELS;
+}
+
+
+/***************************************** Link monitor ******************************************/
+
+/**
+  * @brief	Apply the default TX power and forget all links
+	* @retval	LINKMON_ERROR_ACI if the power could not be set
+	*/
+LinkMon_Status_t LinkMon_Init(void)
+{
+	memset(Links, 0, sizeof(Links));
+	Applied_Level = LINKMON_DEFAULT_LEVEL;
+	Last_Sample = HAL_GetTick();
+
+	if(aci_hal_set_tx_power_level(Levels[Applied_Level].En_High_Power, Levels[Applied_Level].PA_Level) != BLE_STATUS_SUCCESS)
+	{
+		return LINKMON_ERROR_ACI;
+	}
+
+	return LINKMON_OK;
+}
+
+/**
+  * @brief	Sample the connected links and adjust the TX power
+	* @note		To be called from the main loop, runs every LINKMON_PERIOD_MS
+	*/
+void LinkMon_Process(void)
+{
+	uint8_t Link_Status[LINKMON_MAX_LINKS];
+	uint16_t Link_Handle[LINKMON_MAX_LINKS];
+	LinkMon_Link_t *pLink;
+	uint8_t i, Level, Wanted = 0, Connected = 0;
+	int8_t RSSI;
+
+	if((HAL_GetTick() - Last_Sample) < LINKMON_PERIOD_MS)
+	{
+		return;
+	}
+	Last_Sample = HAL_GetTick();
+
+	if(aci_hal_get_link_status(Link_Status, Link_Handle) != BLE_STATUS_SUCCESS)
+	{
+		return;
+	}
+
+	for(i = 0; i < LINKMON_MAX_LINKS; i++)
+	{
+		pLink = &Links[i];
+
+		if((Link_Status[i] != LINKMON_STATUS_CONN_SLAVE) && (Link_Status[i] != LINKMON_STATUS_CONN_MASTER))
+		{
+			pLink->Used = 0;
+			continue;
+		}
+
+		/* New connection on this link */
+		if(!pLink->Used || (pLink->Stats.Connection_Handle != Link_Handle[i]))
+		{
+			memset(pLink, 0, sizeof(LinkMon_Link_t));
+			pLink->Used = 1;
+			pLink->Stats.Connection_Handle = Link_Handle[i];
+			pLink->Stats.RSSI_Min = INT8_MAX;
+			pLink->Stats.RSSI_Max = INT8_MIN;
+			pLink->Stats.Level = Applied_Level;
+			LinkMon_CtrlInit(&pLink->Ctrl, Applied_Level);
+		}
+		pLink->Stats.Link_Status = Link_Status[i];
+
+		if(hci_read_rssi(Link_Handle[i], &RSSI) != BLE_STATUS_SUCCESS)
+		{
+			RSSI = LINKMON_RSSI_UNAVAILABLE;
+		}
+
+		Level = LinkMon_CtrlUpdate(&pLink->Ctrl, RSSI, pLink->Sent, pLink->Failed);
+		pLink->Sent = 0;
+		pLink->Failed = 0;
+
+		if(Level > pLink->Stats.Level)
+		{
+			pLink->Stats.Raises++;
+		}
+		else if(Level < pLink->Stats.Level)
+		{
+			pLink->Stats.Lowers++;
+		}
+		pLink->Stats.Level = Level;
+
+		if(RSSI != LINKMON_RSSI_UNAVAILABLE)
+		{
+			pLink->Stats.Samples++;
+			pLink->Stats.RSSI_Last = RSSI;
+			pLink->Stats.RSSI_Avg = (int8_t)((pLink->Ctrl.RSSI_Q4 + 8) >> 4);
+			if(RSSI < pLink->Stats.RSSI_Min)
+			{
+				pLink->Stats.RSSI_Min = RSSI;
+			}
+			if(RSSI > pLink->Stats.RSSI_Max)
+			{
+				pLink->Stats.RSSI_Max = RSSI;
+			}
+		}
+		pLink->Stats.Loss = (uint8_t)((pLink->Ctrl.Loss_Q4 >> 4) > 255U ? 255U : (pLink->Ctrl.Loss_Q4 >> 4));
+
+		if(Level > Wanted)
+		{
+			Wanted = Level;
+		}
+		Connected = 1;
+	}
+
+	if(!Connected)
+	{
+		Wanted = LINKMON_DEFAULT_LEVEL;
+	}
+
+	if((Wanted != Applied_Level) &&
+		 (aci_hal_set_tx_power_level(Levels[Wanted].En_High_Power, Levels[Wanted].PA_Level) == BLE_STATUS_SUCCESS))
+	{
+		Applied_Level = Wanted;
+	}
+
+	for(i = 0; i < LINKMON_MAX_LINKS; i++)
+	{
+		if(Links[i].Used)
+		{
+			Links[i].Stats.Peer_RSSI = LinkMon_PeerRSSI(&Links[i].Ctrl, Applied_Level);
+		}
+	}
+}
+
+/**
+  * @brief	Report the packets sent on a link and how many of them failed
+	* @param	Connection_Handle: link
+	* @param	Sent: packets handed to the stack
+	* @param	Failed: packets refused or retried
+	*/
+void LinkMon_ReportTx(uint16_t Connection_Handle, uint16_t Sent, uint16_t Failed)
+{
+	uint8_t i;
+
+	for(i = 0; i < LINKMON_MAX_LINKS; i++)
+	{
+		if(Links[i].Used && (Links[i].Stats.Connection_Handle == Connection_Handle))
+		{
+			Links[i].Sent = ((uint32_t)Links[i].Sent + Sent > UINT16_MAX) ? UINT16_MAX : (uint16_t)(Links[i].Sent + Sent);
+			Links[i].Failed = ((uint32_t)Links[i].Failed + Failed > UINT16_MAX) ? UINT16_MAX : (uint16_t)(Links[i].Failed + Failed);
+			Links[i].Stats.Tx_Packets += Sent;
+			Links[i].Stats.Tx_Failed += Failed;
+			return;
+		}
+	}
+}
+
+/**
+  * @brief	Diagnostics of one link
+	* @param	Connection_Handle: link
+	* @param	pStats: receives a copy of the statistics
+	* @retval	LINKMON_ERROR_NOT_FOUND if the link is not connected
+	*/
+LinkMon_Status_t LinkMon_GetStats(uint16_t Connection_Handle, LinkMon_Stats_t *pStats)
+{
+	uint8_t i;
+
+	if(pStats == NULL)
+	{
+		return LINKMON_ERROR_PARAM;
+	}
+
+	for(i = 0; i < LINKMON_MAX_LINKS; i++)
+	{
+		if(Links[i].Used && (Links[i].Stats.Connection_Handle == Connection_Handle))
+		{
+			*pStats = Links[i].Stats;
+			return LINKMON_OK;
+		}
+	}
+
+	return LINKMON_ERROR_NOT_FOUND;
+}
+
+/**
+  * @brief	Diagnostics of all connected links
+	* @param	pStats: receives up to Max entries
+	* @param	Max: size of pStats
+	* @retval	Number of entries written
+	*/
+uint8_t LinkMon_GetLinks(LinkMon_Stats_t *pStats, uint8_t Max)
+{
+	uint8_t i, Count = 0;
+
+	for(i = 0; (i < LINKMON_MAX_LINKS) && (Count < Max); i++)
+	{
+		if(Links[i].Used)
+		{
+			pStats[Count++] = Links[i].Stats;
+		}
+	}
+
+	return Count;
+}
+
+/**
+  * @brief	TX power currently applied
+	* @retval	dBm
+	*/
+int8_t LinkMon_GetTxPower(void)
+{
+	return Levels[Applied_Level].Power_dBm;
+}
+
+
+/******************************************* END OF FILE *******************************************/
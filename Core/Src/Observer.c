@@ -0,0 +1,533 @@
+/**
+  **************************************************************************************************
+  * @file       : Observer.c
+  * @brief      : High rate observer for the central/gateway build. Collects advertising reports
+	*								straight from the HCI event buffer into a table of advertisers with smoothed
+	*								RSSI, last-seen times and payload change detection.
+  * @author			:
+  **************************************************************************************************
+  *
+  * Reports are walked in place in the LE Advertising Report event, without the copy made by
+  * hci_le_advertising_report_event_process(). Advertisers are kept in an open addressing table
+  * (linear probing, keyed by address and address type) so a report costs one hash, a short probe
+  * and a hash of its payload. The application callback only runs for new devices and changed
+  * payloads, which turns a flood of repeated beacons into a few events.
+  *
+  * Expired devices are removed with backward shift deletion, a few slots per Observer_Process()
+  * call, so the table needs no tombstones and probes stay short.
+  *
+  * Observer_IterInit() to Observer_ResetStats() do not touch the hardware and take the time as a
+  * parameter, so they can be fed synthetic advertising floods on the host.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Observer.h"
+#include "bluenrg1_gap_aci.h"
+#include "bluenrg1_gap.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define OBSERVER_TABLE_MASK							(OBSERVER_TABLE_SIZE - 1U)
+
+/* Fixed part of a report: event type, address type, address, data length and RSSI */
+#define OBSERVER_REPORT_HEADER					9U
+#define OBSERVER_REPORT_OVERHEAD				10U
+
+#define OBSERVER_FNV_OFFSET							2166136261U
+#define OBSERVER_FNV_PRIME							16777619U
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static Observer_Device_t Table[OBSERVER_TABLE_SIZE];
+static Observer_Callback_t CallbackFunc;
+static Observer_Stats_t Stats;
+static uint16_t Sweep_Pos;
+static uint8_t Active;
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static uint32_t Observer_Slot(const uint8_t *pAddress, uint8_t Address_Type);
+static uint32_t Observer_PayloadHash(const uint8_t *pData, uint8_t Length);
+static void Observer_Remove(uint32_t Slot);
+static void Observer_Update(const Observer_Report_t *pReport, uint32_t Time);
+
+
+/***************************************** Report parsing ****************************************/
+
+/**
+  * @brief	Start walking an LE Advertising Report event
+	* @param	pIter: iterator
+	* @param	pEvent: event parameters following the subevent code (Num_Reports first)
+	* @param	Length: length of the parameters
+	* @retval	Number of reports announced, 0 if none
+	*/
+uint8_t Observer_IterInit(Observer_Iter_t *pIter, const uint8_t *pEvent, uint16_t Length)
+{
+	if((pEvent == NULL) || (Length < 1U))
+	{
+		pIter->Remaining = 0;
+		return 0;
+	}
+
+	pIter->Remaining = pEvent[0];
+	pIter->pPos = &pEvent[1];
+	pIter->pEnd = &pEvent[Length];
+
+	return pIter->Remaining;
+}
+
+/**
+  * @brief	Get the next report of the event
+	* @param	pIter: iterator
+	* @param	pReport: receives pointers into the event buffer
+	* @retval	1 if a report was returned, 0 at the end. Remaining stays non zero when the event
+	*					ended before the announced number of reports.
+	*/
+uint8_t Observer_IterNext(Observer_Iter_t *pIter, Observer_Report_t *pReport)
+{
+	const uint8_t *pPos = pIter->pPos;
+	uint8_t Length_Data;
+
+	if(pIter->Remaining == 0U)
+	{
+		return 0;
+	}
+
+	if((pIter->pEnd - pPos) < (int32_t)OBSERVER_REPORT_HEADER)
+	{
+		return 0;
+	}
+
+	Length_Data = pPos[8];
+	if((pIter->pEnd - pPos) < (int32_t)(OBSERVER_REPORT_OVERHEAD + Length_Data))
+	{
+		return 0;
+	}
+
+	pReport->Event_Type = pPos[0];
+	pReport->Address_Type = pPos[1];
+	pReport->pAddress = &pPos[2];
+	pReport->Length_Data = Length_Data;
+	pReport->pData = &pPos[OBSERVER_REPORT_HEADER];
+	pReport->RSSI = (int8_t)pPos[OBSERVER_REPORT_HEADER + Length_Data];
+
+	pIter->pPos = &pPos[OBSERVER_REPORT_OVERHEAD + Length_Data];
+	pIter->Remaining--;
+
+	return 1;
+}
+
+
+/****************************************** Device table *****************************************/
+
+/**
+  * @brief	Clear the device table and the statistics
+	*/
+void Observer_Init(void)
+{
+	memset(Table, 0, sizeof(Table));
+	memset(&Stats, 0, sizeof(Stats));
+	Sweep_Pos = 0;
+}
+
+/**
+  * @brief	Register the function told about new devices and payload changes
+	* @param	Callback: function to call, NULL to remove
+	*/
+void Observer_SetCallback(Observer_Callback_t Callback)
+{
+	CallbackFunc = Callback;
+}
+
+/**
+  * @brief	Aggregate the reports of an LE Advertising Report event
+	* @param	pEvent: event parameters following the subevent code
+	* @param	Length: length of the parameters
+	* @param	Time: current time in ms
+	*/
+void Observer_ProcessEvent(const uint8_t *pEvent, uint16_t Length, uint32_t Time)
+{
+	Observer_Iter_t Iter;
+	Observer_Report_t Report;
+
+	Stats.Events++;
+	(void)Observer_IterInit(&Iter, pEvent, Length);
+
+	while(Observer_IterNext(&Iter, &Report))
+	{
+		Observer_Update(&Report, Time);
+	}
+
+	if(Iter.Remaining != 0U)
+	{
+		Stats.Malformed++;
+	}
+}
+
+/**
+  * @brief	Drop the devices not heard for OBSERVER_TIMEOUT_MS
+	* @param	Time: current time in ms
+	* @param	Slots: table slots to check, the sweep resumes where it stopped
+	*/
+void Observer_Expire(uint32_t Time, uint16_t Slots)
+{
+	while(Slots-- > 0U)
+	{
+		/* A removal pulls the next entry of the cluster into this slot, check it again */
+		while(Table[Sweep_Pos].Used && ((Time - Table[Sweep_Pos].Last_Seen) > OBSERVER_TIMEOUT_MS))
+		{
+			Observer_Remove(Sweep_Pos);
+			Stats.Expired++;
+		}
+
+		Sweep_Pos = (Sweep_Pos + 1U) & OBSERVER_TABLE_MASK;
+	}
+}
+
+/**
+  * @brief	Look up a device
+	* @param	Address: device address, little endian
+	* @param	Address_Type: address type as reported
+	* @retval	Device entry, NULL if not in the table
+	*/
+const Observer_Device_t *Observer_Find(const uint8_t Address[6], uint8_t Address_Type)
+{
+	uint32_t Slot = Observer_Slot(Address, Address_Type);
+
+	while(Table[Slot].Used)
+	{
+		if((Table[Slot].Address_Type == Address_Type) && (memcmp(Table[Slot].Address, Address, 6) == 0))
+		{
+			return &Table[Slot];
+		}
+		Slot = (Slot + 1U) & OBSERVER_TABLE_MASK;
+	}
+
+	return NULL;
+}
+
+/**
+  * @brief	Call a function for every device in the table
+	* @param	Func: called with each device, must not start or stop the observer
+	* @param	pContext: passed to Func
+	*/
+void Observer_ForEach(Observer_ForEachFunc_t Func, void *pContext)
+{
+	uint32_t i;
+
+	for(i = 0; i < OBSERVER_TABLE_SIZE; i++)
+	{
+		if(Table[i].Used)
+		{
+			Func(&Table[i], pContext);
+		}
+	}
+}
+
+/**
+  * @brief	Observer statistics
+	*/
+const Observer_Stats_t *Observer_GetStats(void)
+{
+	return &Stats;
+}
+
+void Observer_ResetStats(void)
+{
+	uint16_t Devices = Stats.Devices;
+
+	memset(&Stats, 0, sizeof(Stats));
+	Stats.Devices = Devices;
+}
+
+/**
+  * @brief	Home slot of an address
+	*/
+static uint32_t Observer_Slot(const uint8_t *pAddress, uint8_t Address_Type)
+{
+	uint32_t Low, High;
+
+	Low = (uint32_t)pAddress[0] | ((uint32_t)pAddress[1] << 8) | ((uint32_t)pAddress[2] << 16) | ((uint32_t)pAddress[3] << 24);
+	High = (uint32_t)pAddress[4] | ((uint32_t)pAddress[5] << 8) | ((uint32_t)Address_Type << 16);
+
+	/* Multiplicative hashing, the top bits are the best mixed */
+	return ((Low ^ (High * 0x85EBCA6BU)) * 0x9E3779B1U) >> (32U - OBSERVER_TABLE_BITS);
+}
+
+/**
+  * @brief	FNV-1a hash of the advertising data
+	*/
+static uint32_t Observer_PayloadHash(const uint8_t *pData, uint8_t Length)
+{
+	uint32_t Hash = OBSERVER_FNV_OFFSET;
+
+	while(Length-- > 0U)
+	{
+		Hash = (Hash ^ *pData++) * OBSERVER_FNV_PRIME;
+	}
+
+	return Hash;
+}
+
+/**
+  * @brief	Remove an entry and close the hole (backward shift deletion)
+	* @param	Slot: slot of the entry
+	*/
+static void Observer_Remove(uint32_t Slot)
+{
+	uint32_t Hole = Slot, Next = Slot, Home;
+
+	for(;;)
+	{
+		Next = (Next + 1U) & OBSERVER_TABLE_MASK;
+		if(!Table[Next].Used)
+		{
+			break;
+		}
+
+		/* The entry can fill the hole unless its home slot lies cyclically in (Hole, Next] */
+		Home = Observer_Slot(Table[Next].Address, Table[Next].Address_Type);
+		if(((Next - Home) & OBSERVER_TABLE_MASK) >= ((Next - Hole) & OBSERVER_TABLE_MASK))
+		{
+			Table[Hole] = Table[Next];
+			Hole = Next;
+		}
+	}
+
+	Table[Hole].Used = 0;
+	Stats.Devices--;
+}
+
+/**
+  * @brief	Fold one report into the table
+	* @param	pReport: report
+	* @param	Time: current time in ms
+	*/
+static void Observer_Update(const Observer_Report_t *pReport, uint32_t Time)
+{
+	Observer_Device_t *pDevice;
+	uint32_t Slot, Hash;
+	uint16_t Probe = 0;
+	uint8_t Flags = 0;
+
+	Stats.Reports++;
+
+	Slot = Observer_Slot(pReport->pAddress, pReport->Address_Type);
+	while(Table[Slot].Used)
+	{
+		if((Table[Slot].Address_Type == pReport->Address_Type) && (memcmp(Table[Slot].Address, pReport->pAddress, 6) == 0))
+		{
+			break;
+		}
+		Slot = (Slot + 1U) & OBSERVER_TABLE_MASK;
+		Probe++;
+	}
+
+	if(Probe > Stats.Max_Probe)
+	{
+		Stats.Max_Probe = Probe;
+	}
+
+	pDevice = &Table[Slot];
+	Hash = Observer_PayloadHash(pReport->pData, pReport->Length_Data);
+
+	if(!pDevice->Used)
+	{
+		if(Stats.Devices >= OBSERVER_MAX_DEVICES)
+		{
+			Stats.Dropped_Full++;
+			return;
+		}
+
+		memset(pDevice, 0, sizeof(Observer_Device_t));
+		memcpy(pDevice->Address, pReport->pAddress, 6);
+		pDevice->Address_Type = pReport->Address_Type;
+		pDevice->Used = 1;
+		pDevice->RSSI_Last = OBSERVER_RSSI_UNAVAILABLE;
+		pDevice->First_Seen = Time;
+		Stats.Devices++;
+		Stats.New_Devices++;
+		Flags = OBSERVER_FLAG_NEW;
+	}
+
+	/* Scan responses carry other data than the advertisements, track them apart */
+	if(pReport->Event_Type == OBSERVER_EVENT_SCAN_RSP)
+	{
+		if(!(Flags & OBSERVER_FLAG_NEW) && (pDevice->Scan_Hash != Hash))
+		{
+			Flags |= OBSERVER_FLAG_CHANGED;
+		}
+		pDevice->Scan_Hash = Hash;
+	}
+	else
+	{
+		if(!(Flags & OBSERVER_FLAG_NEW) && (pDevice->Adv_Hash != Hash))
+		{
+			Flags |= OBSERVER_FLAG_CHANGED;
+		}
+		pDevice->Adv_Hash = Hash;
+		pDevice->Event_Type = pReport->Event_Type;
+	}
+
+	if(pReport->RSSI != OBSERVER_RSSI_UNAVAILABLE)
+	{
+		if(pDevice->RSSI_Last == OBSERVER_RSSI_UNAVAILABLE)
+		{
+			pDevice->RSSI_Q4 = (int16_t)(pReport->RSSI * 16);
+		}
+		else
+		{
+			pDevice->RSSI_Q4 += (int16_t)(((pReport->RSSI * 16) - pDevice->RSSI_Q4) >> OBSERVER_RSSI_SHIFT);
+		}
+		pDevice->RSSI_Last = pReport->RSSI;
+	}
+
+	pDevice->Last_Seen = Time;
+	if(pDevice->Reports < UINT16_MAX)
+	{
+		pDevice->Reports++;
+	}
+
+	if(Flags & OBSERVER_FLAG_CHANGED)
+	{
+		Stats.Changes++;
+		if(pDevice->Changes < UINT16_MAX)
+		{
+			pDevice->Changes++;
+		}
+	}
+
+	if((Flags != 0U) && (CallbackFunc != NULL))
+	{
+		CallbackFunc(pDevice, pReport, Flags);
+	}
+}
+
+
+/******************************************** Scanning *******************************************/
+
+/**
+  * @brief	Start passive scanning. Duplicate filtering is left to the device table so that RSSI
+	*					and payload updates keep coming.
+	* @param	Scan_Interval: N * 0.625 ms
+	* @param	Scan_Window: N * 0.625 ms, up to Scan_Interval
+	* @retval	Status
+	*/
+Observer_Status_t Observer_Start(uint16_t Scan_Interval, uint16_t Scan_Window)
+{
+	if(Scan_Window > Scan_Interval)
+	{
+		return OBSERVER_ERROR_PARAM;
+	}
+
+	if(aci_gap_start_observation_proc(Scan_Interval, Scan_Window, 0x00, PUBLIC_ADDR, 0x00, 0x00) != BLE_STATUS_SUCCESS)
+	{
+		return OBSERVER_ERROR_ACI;
+	}
+
+	Active = 1;
+
+	return OBSERVER_OK;
+}
+
+/**
+  * @brief	Stop scanning. The device table is kept.
+	* @retval	Status
+	*/
+Observer_Status_t Observer_Stop(void)
+{
+	Active = 0;
+
+	if(aci_gap_terminate_gap_proc(GAP_OBSERVATION_PROC) != BLE_STATUS_SUCCESS)
+	{
+		return OBSERVER_ERROR_ACI;
+	}
+
+	return OBSERVER_OK;
+}
+
+/**
+  * @brief	Take an LE Advertising Report event from the HCI event dispatcher
+	* @param	pEvent: event parameters following the subevent code
+	* @param	Length: length of the parameters
+	* @retval	1 if the event was consumed, 0 if it should go to the stack callbacks
+	*/
+uint8_t Observer_HandleEvent(const uint8_t *pEvent, uint16_t Length)
+{
+	if(!Active)
+	{
+		return 0;
+	}
+
+	Observer_ProcessEvent(pEvent, Length, HAL_GetTick());
+
+	return 1;
+}
+
+/**
+  * @brief	Expire silent devices, a few slots at a time
+	* @note		To be called from the main loop
+	*/
+void Observer_Process(void)
+{
+	Observer_Expire(HAL_GetTick(), OBSERVER_SWEEP_SLOTS);
+}
+
+
+#if OBSERVER_BENCHMARK
+/**
+  * @brief	Feed a synthetic advertising flood through the observer and time it
+	* @param	Devices: advertisers in the flood, each changes its payload every 16th report
+	* @param	Reports: reports to process, three 31 byte reports per event
+	* @retval	Reports per second
+	* @note		Clears the device table, run it with the observation stopped
+	*/
+uint32_t Observer_Benchmark(uint16_t Devices, uint32_t Reports)
+{
+	static uint8_t Event[1U + 3U * (OBSERVER_REPORT_OVERHEAD + 31U)];
+	uint32_t n, Start, Elapsed, Device;
+	uint8_t *pReport;
+	uint8_t i;
+
+	if(Devices == 0U)
+	{
+		return 0;
+	}
+
+	Observer_Init();
+	Start = HAL_GetTick();
+
+	for(n = 0; n < Reports; n += 3U)
+	{
+		Event[0] = 3;
+		pReport = &Event[1];
+		for(i = 0; i < 3U; i++)
+		{
+			Device = (n + i) % Devices;
+			pReport[0] = 0x03;
+			pReport[1] = 0x01;
+			pReport[2] = (uint8_t)Device;
+			pReport[3] = (uint8_t)(Device >> 8);
+			pReport[4] = 0x5A;
+			pReport[5] = 0xA5;
+			pReport[6] = 0x00;
+			pReport[7] = 0xC0;
+			pReport[8] = 31;
+			memset(&pReport[OBSERVER_REPORT_HEADER], (int)Device, 31);
+			pReport[OBSERVER_REPORT_HEADER + 30U] = (uint8_t)(((n + i) / Devices) >> 4);
+			pReport[OBSERVER_REPORT_HEADER + 31U] = (uint8_t)(-40 - (int32_t)((n + i) & 0x1FU));
+			pReport += OBSERVER_REPORT_OVERHEAD + 31U;
+		}
+		Observer_ProcessEvent(Event, sizeof(Event), HAL_GetTick());
+	}
+
+	Elapsed = HAL_GetTick() - Start;
+
+	return (Elapsed == 0U) ? UINT32_MAX : (uint32_t)(((uint64_t)Reports * 1000U) / Elapsed);
+}
+#endif
+
+
+/******************************************* END OF FILE *******************************************/
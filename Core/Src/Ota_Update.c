@@ -0,0 +1,619 @@
+/**
+  **************************************************************************************************
+  * @file       : Ota_Update.c
+  * @brief      : Firmware update over the air. Receives an image into the staging flash area,
+	*								verifies it with the hardware CRC unit and leaves it to the bootloader.
+  * @author			:
+  **************************************************************************************************
+  *
+  * The peer (the updater) writes OTA_CMD_START with the size and the CRC of the image, waits for
+  * the first OTA_EVT_ACK (the staging sectors are erased meanwhile), then streams the image with
+  * writes without response to the data characteristic. An acknowledgement carries the offset and
+  * the sequence number the window starts at: the peer may send OTA_WINDOW packets from there. They
+  * are acknowledged every half window, as long as the ring buffer has room for a whole window, so
+  * the peer never waits for a round trip while the flash keeps up. A lost packet is answered with
+  * OTA_EVT_NACK and the peer goes back to the offset it gives (go-back-N).
+  *
+  * Received bytes are programmed from the ring, by word, in OTA_PROGRAM_CHUNK jobs run by the radio
+  * scheduler between the connection events: programming overlaps the reception. Once the image is
+  * complete its CRC is checked on the staging area, then OTA_CMD_APPLY writes the header of
+  * Ota_Image.h and resets: the bootloader copies the image into the application sectors.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Ota_Update.h"
+#include "BLE_Process.h"
+#include "Radio_Sched.h"
+#include "Gatt_Builder.h"
+#include "bluenrg1_gatt_aci.h"
+#include "bluenrg1_hci_le.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* Acknowledgement after this many packets, leaves half a window in flight */
+#define OTA_ACK_EVERY									(OTA_WINDOW / 2U)
+
+/* Link layer payload and time asked for during the transfer (data length extension) */
+#define OTA_DLE_OCTETS								251U
+#define OTA_DLE_TIME_US								2120U
+
+
+/* Private macro ---------------------------------------------------------------------------------*/
+#define OTA_GET_U16(p)								((uint16_t)((p)[0] | ((uint16_t)(p)[1] << 8)))
+#define OTA_GET_U32(p)								((uint32_t)((p)[0] | ((uint32_t)(p)[1] << 8) | ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24)))
+
+
+/******************************************* Reception *******************************************/
+
+/**
+  * @brief	Start receiving an image
+	* @param	pRx: reception state
+	* @param	Image_Size: bytes announced by the peer
+	*/
+void Ota_RxInit(Ota_Rx_t *pRx, uint32_t Image_Size)
+{
+	memset(pRx, 0, sizeof(Ota_Rx_t) - OTA_RING_SIZE);
+	pRx->Image_Size = Image_Size;
+}
+
+/**
+  * @brief	Take a data packet
+	* @param	pRx: reception state
+	* @param	pPacket: sequence number (u16) and image bytes
+	* @param	Length: bytes of the packet
+	* @retval	OTA_RX_OK if the bytes were stored
+	*/
+Ota_RxResult_t Ota_RxPacket(Ota_Rx_t *pRx, const uint8_t *pPacket, uint16_t Length)
+{
+	uint16_t Data_Length, Head, First;
+
+	if((Length <= 2U) || (Length > OTA_MAX_PACKET))
+	{
+		return OTA_RX_INVALID;
+	}
+	Data_Length = (uint16_t)(Length - 2U);
+
+	if(OTA_GET_U16(pPacket) != pRx->Next_Seq)
+	{
+		/* Behind: still in flight from before the last NACK, ahead: one was lost */
+		if(((int16_t)(OTA_GET_U16(pPacket) - pRx->Next_Seq) > 0) && !pRx->Nack_Sent)
+		{
+			pRx->Nack_Pending = 1;
+		}
+		pRx->Dropped++;
+		return OTA_RX_DROPPED;
+	}
+
+	if((pRx->Received + Data_Length) > pRx->Image_Size)
+	{
+		return OTA_RX_INVALID;
+	}
+
+	if(((pRx->Received - pRx->Programmed) + Data_Length) > OTA_RING_SIZE)
+	{
+		/* The peer went past its window */
+		if(!pRx->Nack_Sent)
+		{
+			pRx->Nack_Pending = 1;
+		}
+		pRx->Dropped++;
+		return OTA_RX_DROPPED;
+	}
+
+	Head = (uint16_t)(pRx->Received % OTA_RING_SIZE);
+	First = (uint16_t)(OTA_RING_SIZE - Head);
+	if(First > Data_Length)
+	{
+		First = Data_Length;
+	}
+	memcpy(&pRx->Ring[Head], &pPacket[2], First);
+	memcpy(&pRx->Ring[0], &pPacket[2 + First], (uint16_t)(Data_Length - First));
+
+	pRx->Received += Data_Length;
+	pRx->Next_Seq++;
+	pRx->Packets++;
+	pRx->Since_Ack++;
+	pRx->Nack_Sent = 0;
+
+	return OTA_RX_OK;
+}
+
+/**
+  * @brief	Whether an acknowledgement has to be sent now
+	* @retval	0, OTA_EVT_ACK or OTA_EVT_NACK
+	* @note		Held back while the ring has no room for a whole window: the peer then waits for the
+	*					flash to catch up.
+	*/
+uint8_t Ota_RxAckDue(const Ota_Rx_t *pRx)
+{
+	if(pRx->Received == pRx->Image_Size)
+	{
+		/* Last one, tells the peer everything arrived */
+		return (pRx->Acked != pRx->Received) ? OTA_EVT_ACK : 0U;
+	}
+
+	if(!pRx->Nack_Pending && (pRx->Since_Ack < OTA_ACK_EVERY))
+	{
+		return 0;
+	}
+
+	if((OTA_RING_SIZE - (pRx->Received - pRx->Programmed)) < (OTA_WINDOW * OTA_MAX_DATA))
+	{
+		return 0;
+	}
+
+	return pRx->Nack_Pending ? OTA_EVT_NACK : OTA_EVT_ACK;
+}
+
+/**
+  * @brief	The acknowledgement returned by Ota_RxAckDue() was sent
+	*/
+void Ota_RxAcked(Ota_Rx_t *pRx)
+{
+	if(pRx->Nack_Pending)
+	{
+		pRx->Nack_Pending = 0;
+		pRx->Nack_Sent = 1;
+		pRx->Nacks++;
+	}
+	pRx->Acked = pRx->Received;
+	pRx->Since_Ack = 0;
+}
+
+/**
+  * @brief	Next bytes to be programmed, at offset pRx->Programmed of the image
+	* @param	pRx: reception state
+	* @param	ppData: set to the bytes in the ring
+	* @retval	Bytes, whole words except at the end of the image. 0 if nothing is pending.
+	*/
+uint16_t Ota_RxPending(const Ota_Rx_t *pRx, const uint8_t **ppData)
+{
+	uint32_t Tail = pRx->Programmed % OTA_RING_SIZE;
+	uint32_t Length = pRx->Received - pRx->Programmed;
+
+	if(pRx->Received != pRx->Image_Size)
+	{
+		Length &= ~3U;
+	}
+	if(Length > OTA_PROGRAM_CHUNK)
+	{
+		Length = OTA_PROGRAM_CHUNK;
+	}
+	if(Length > (OTA_RING_SIZE - Tail))
+	{
+		Length = OTA_RING_SIZE - Tail;
+	}
+
+	*ppData = &pRx->Ring[Tail];
+
+	return (uint16_t)Length;
+}
+
+/**
+  * @brief	Bytes returned by Ota_RxPending() were programmed
+	*/
+void Ota_RxProgrammed(Ota_Rx_t *pRx, uint16_t Length)
+{
+	pRx->Programmed += Length;
+}
+
+
+#if OTA_ENABLE
+/******************************************** Service ********************************************/
+
+/* Private typedef -------------------------------------------------------------------------------*/
+typedef enum
+{
+	OTA_STATE_IDLE = 0x00,
+	OTA_STATE_ERASING,
+	OTA_STATE_RECEIVING,
+	OTA_STATE_VERIFIED,
+	OTA_STATE_APPLYING,
+
+} Ota_State_t;
+
+
+/* External variables ----------------------------------------------------------------------------*/
+extern CRC_HandleTypeDef hcrc;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* UUIDs derived from the application characteristics (...0x8x, 0xEB...) */
+static const uint8_t Service_UUID[16] =
+{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x90,0xEB,0x25,0x9B};
+static const uint8_t Control_UUID[16] =
+{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x91,0xEB,0x25,0x9B};
+static const uint8_t Data_UUID[16] =
+{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x92,0xEB,0x25,0x9B};
+
+static uint16_t hOtaService;
+static uint16_t hControl;
+static uint16_t hData;
+
+static Ota_Rx_t Rx;
+static Ota_State_t State;
+static uint16_t Connection;
+static uint32_t Image_CRC;
+static uint8_t Erase_Sector;						/* Next staging sector to erase */
+static uint8_t Job_Queued;
+static uint8_t Result_Event;						/* Notification to send again, 0 for none */
+static uint8_t Result_Status;
+static uint32_t Apply_Time;							/* ms */
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static void Ota_Start(const uint8_t *pData, uint16_t Length);
+static void Ota_Fail(Ota_Status_t Status);
+static uint8_t Ota_Notify(uint8_t Event, uint8_t Status);
+static void Ota_ProgramJob(void *pContext);
+static Ota_Status_t Ota_Verify(void);
+static Ota_Status_t Ota_WriteHeader(void);
+
+
+/**
+  * @brief	Add the update service to the GATT database
+	* @note		To be called after aci_gatt_init() and aci_gap_init()
+	*/
+Ota_Status_t Ota_Init(void)
+{
+	State = OTA_STATE_IDLE;
+	Job_Queued = 0;
+	Result_Event = 0;
+
+	/* Service, control (3 records with the CCCD), data (2 records) */
+	static const GattBuild_Char_t Chars[2] =
+	{
+		{Control_UUID, 9, CHAR_PROP_WRITE|CHAR_PROP_NOTIFY, GATT_NOTIFY_ATTRIBUTE_WRITE, CHAR_VALUE_LEN_VARIABLE, NULL, 0, &hControl},
+		{Data_UUID, OTA_MAX_PACKET, CHAR_PROP_WRITE_WITHOUT_RESP, GATT_NOTIFY_ATTRIBUTE_WRITE, CHAR_VALUE_LEN_VARIABLE, NULL, 0, &hData},
+	};
+	static const GattBuild_Service_t Service = {Service_UUID, 6, Chars, 2, &hOtaService};
+
+	if(GattBuild_Run(&Service, 1) != GATTBUILD_OK)
+	{
+		return OTA_ERROR_ACI;
+	}
+
+	return OTA_OK;
+}
+
+/**
+  * @brief	Handle a write of the peer
+	* @param	Connection_Handle: link written on
+	* @param	Attr_Handle: attribute written
+	* @param	Length: bytes
+	* @param	pData: value written
+	* @retval	1 if the attribute belongs to the update service, 0 otherwise
+	*/
+uint8_t Ota_AttributeModified(uint16_t Connection_Handle, uint16_t Attr_Handle, uint16_t Length, const uint8_t *pData)
+{
+	if(hOtaService == 0U)
+	{
+		/* Not in the database (central) */
+		return 0;
+	}
+
+	if(Attr_Handle == (hData + 1U))
+	{
+		if(State == OTA_STATE_RECEIVING)
+		{
+			if(Ota_RxPacket(&Rx, pData, Length) == OTA_RX_INVALID)
+			{
+				Ota_Fail(OTA_ERROR_PARAM);
+			}
+		}
+		return 1;
+	}
+	else if(Attr_Handle == (hControl + 1U))
+	{
+		if(Length == 0U)
+		{
+			return 1;
+		}
+		Connection = Connection_Handle;
+
+		switch(pData[0])
+		{
+			case OTA_CMD_START:
+			{
+				Ota_Start(pData, Length);
+				break;
+			}
+
+			case OTA_CMD_APPLY:
+			{
+				if(State != OTA_STATE_VERIFIED)
+				{
+					Ota_Fail(OTA_ERROR_STATE);
+				}
+				else if(Ota_WriteHeader() != OTA_OK)
+				{
+					Ota_Fail(OTA_ERROR_FLASH);
+				}
+				else
+				{
+					State = OTA_STATE_APPLYING;
+					Apply_Time = HAL_GetTick();
+					Result_Event = OTA_EVT_APPLYING;
+					Result_Status = OTA_OK;
+				}
+				break;
+			}
+
+			default:
+			{
+				State = OTA_STATE_IDLE;
+				break;
+			}
+		}
+		return 1;
+	}
+	else if(Attr_Handle == (hControl + 2U))
+	{
+		/* CCCD of the control characteristic */
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+  * @brief	Drop the transfer on disconnection, an image being installed is installed anyway
+	*/
+void Ota_Disconnect(void)
+{
+	if(State == OTA_STATE_APPLYING)
+	{
+		NVIC_SystemReset();
+	}
+	State = OTA_STATE_IDLE;
+	Result_Event = 0;
+}
+
+/**
+  * @brief	Erase, acknowledge, program and verify
+	* @note		To be called from the main loop
+	*/
+void Ota_Process(void)
+{
+	FLASH_EraseInitTypeDef EraseInit;
+	uint32_t SectorError = 0;
+	const uint8_t *pData;
+	uint8_t Event;
+	Ota_Status_t Status;
+
+	if((Result_Event != 0U) && Ota_Notify(Result_Event, Result_Status))
+	{
+		Result_Event = 0;
+	}
+
+	switch(State)
+	{
+		case OTA_STATE_ERASING:
+		{
+			/* One sector per call, up to 2 s each: the controller keeps the link meanwhile */
+			EraseInit.TypeErase = FLASH_TYPEERASE_SECTORS;
+			EraseInit.Banks = FLASH_BANK_1;
+			EraseInit.Sector = Erase_Sector;
+			EraseInit.NbSectors = 1;
+			EraseInit.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+			HAL_FLASH_Unlock();
+			__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+															FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+			Status = (HAL_FLASHEx_Erase(&EraseInit, &SectorError) == HAL_OK) ? OTA_OK : OTA_ERROR_FLASH;
+			HAL_FLASH_Lock();
+
+			if(Status != OTA_OK)
+			{
+				Ota_Fail(Status);
+			}
+			else if(++Erase_Sector >= (OTA_STAGING_FIRST_SECTOR + OTA_STAGING_SECTORS))
+			{
+				/* Ready: the first acknowledgement opens the window */
+				State = OTA_STATE_RECEIVING;
+				Rx.Since_Ack = OTA_ACK_EVERY;
+			}
+			break;
+		}
+
+		case OTA_STATE_RECEIVING:
+		{
+			Event = Ota_RxAckDue(&Rx);
+			if((Event != 0U) && Ota_Notify(Event, OTA_OK))
+			{
+				Ota_RxAcked(&Rx);
+			}
+
+			if(!Job_Queued && (Ota_RxPending(&Rx, &pData) != 0U))
+			{
+				Job_Queued = (RadioSched_Submit(Ota_ProgramJob, NULL, OTA_PROGRAM_US) == RADIOSCHED_OK);
+			}
+
+			if(Rx.Programmed == Rx.Image_Size)
+			{
+				Status = Ota_Verify();
+				if(Status != OTA_OK)
+				{
+					Ota_Fail(Status);
+				}
+				else
+				{
+					State = OTA_STATE_VERIFIED;
+					Result_Event = OTA_EVT_VERIFIED;
+					Result_Status = OTA_OK;
+				}
+			}
+			break;
+		}
+
+		case OTA_STATE_APPLYING:
+		{
+			if((HAL_GetTick() - Apply_Time) >= OTA_RESET_DELAY_MS)
+			{
+				NVIC_SystemReset();
+			}
+			break;
+		}
+
+		default:
+			break;
+	}
+}
+
+const Ota_Rx_t *Ota_GetRx(void)
+{
+	return &Rx;
+}
+
+
+/**
+  * @brief	Check the start command and erase the staging area
+	*/
+static void Ota_Start(const uint8_t *pData, uint16_t Length)
+{
+	uint32_t Size;
+
+	if(Length < 9U)
+	{
+		Ota_Fail(OTA_ERROR_PARAM);
+		return;
+	}
+
+	Size = OTA_GET_U32(&pData[1]);
+	if((Size == 0U) || (Size > OTA_MAX_IMAGE_SIZE))
+	{
+		Ota_Fail(OTA_ERROR_SIZE);
+		return;
+	}
+
+	Image_CRC = OTA_GET_U32(&pData[5]);
+	Ota_RxInit(&Rx, Size);
+	Erase_Sector = OTA_STAGING_FIRST_SECTOR;
+	Result_Event = 0;
+	State = OTA_STATE_ERASING;
+
+	/* Longest link layer packets, for writes of up to OTA_MAX_PACKET bytes in one PDU */
+	(void)hci_le_set_data_length(Connection, OTA_DLE_OCTETS, OTA_DLE_TIME_US);
+}
+
+/**
+  * @brief	End the transfer and tell the peer why
+	*/
+static void Ota_Fail(Ota_Status_t Status)
+{
+	State = OTA_STATE_IDLE;
+	Result_Event = OTA_EVT_ERROR;
+	Result_Status = (uint8_t)Status;
+}
+
+/**
+  * @brief	Notify the control characteristic
+	* @retval	1 if queued, 0 if the TX pool is full
+	*/
+static uint8_t Ota_Notify(uint8_t Event, uint8_t Status)
+{
+	uint8_t Value[OTA_NOTIFY_SIZE];
+
+	Value[0] = Event;
+	Value[1] = Status;
+	Value[2] = (uint8_t)Rx.Received;
+	Value[3] = (uint8_t)(Rx.Received >> 8);
+	Value[4] = (uint8_t)(Rx.Received >> 16);
+	Value[5] = (uint8_t)(Rx.Received >> 24);
+	Value[6] = (uint8_t)Rx.Next_Seq;
+	Value[7] = (uint8_t)(Rx.Next_Seq >> 8);
+
+	return (aci_gatt_update_char_value(hOtaService, hControl, 0, OTA_NOTIFY_SIZE, Value) == BLE_STATUS_SUCCESS);
+}
+
+/**
+  * @brief	Program the next chunk of the ring, run between radio activities
+	*/
+static void Ota_ProgramJob(void *pContext)
+{
+	const uint8_t *pData;
+	uint32_t Address, Word;
+	uint16_t Length, i;
+	HAL_StatusTypeDef status = HAL_OK;
+
+	(void)pContext;
+	Job_Queued = 0;
+
+	if(State != OTA_STATE_RECEIVING)
+	{
+		return;
+	}
+
+	Length = Ota_RxPending(&Rx, &pData);
+	Address = OTA_STAGING_ADDR + Rx.Programmed;
+
+	/* Word programming: double words need the external VPP supply */
+	HAL_FLASH_Unlock();
+	for(i = 0; (i < Length) && (status == HAL_OK); i += 4U)
+	{
+		Word = 0xFFFFFFFFU;
+		memcpy(&Word, &pData[i], ((uint16_t)(Length - i) < 4U) ? (uint32_t)(Length - i) : 4U);
+		status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, Address + i, Word);
+	}
+	HAL_FLASH_Lock();
+
+	if(status != HAL_OK)
+	{
+		Ota_Fail(OTA_ERROR_FLASH);
+		return;
+	}
+
+	Ota_RxProgrammed(&Rx, Length);
+}
+
+/**
+  * @brief	Check the CRC of the staging area and that the image is linked for the application sectors
+	*/
+static Ota_Status_t Ota_Verify(void)
+{
+	uint32_t Reset_Handler = *(const uint32_t *)(OTA_STAGING_ADDR + 4U);
+
+	if(HAL_CRC_Calculate(&hcrc, (uint32_t *)OTA_STAGING_ADDR, (Rx.Image_Size + 3U) / 4U) != Image_CRC)
+	{
+		return OTA_ERROR_CRC;
+	}
+
+	if((Reset_Handler < OTA_APP_ADDR) || (Reset_Handler >= (OTA_APP_ADDR + OTA_APP_SIZE)))
+	{
+		return OTA_ERROR_IMAGE;
+	}
+
+	return OTA_OK;
+}
+
+/**
+  * @brief	Leave the update request to the bootloader
+	*/
+static Ota_Status_t Ota_WriteHeader(void)
+{
+	Ota_Header_t Header;
+	const uint32_t *pWords = (const uint32_t *)&Header;
+	HAL_StatusTypeDef status = HAL_OK;
+	uint8_t i;
+
+	Header.Magic = OTA_HEADER_MAGIC;
+	Header.Size = Rx.Image_Size;
+	Header.Crc = Image_CRC;
+	Header.Check = OTA_HEADER_CHECK(&Header);
+
+	HAL_FLASH_Unlock();
+	for(i = 0; (i < (sizeof(Header) / 4U)) && (status == HAL_OK); i++)
+	{
+		status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, OTA_HEADER_ADDR + (4U * i), pWords[i]);
+	}
+	HAL_FLASH_Lock();
+
+	return (status == HAL_OK) ? OTA_OK : OTA_ERROR_FLASH;
+}
+
+#endif /* OTA_ENABLE */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,462 @@
+/**
+  **************************************************************************************************
+  * @file       : Payload_Codec.c
+  * @brief      : Compression of outgoing notification payloads. Every frame starts with a header
+	*								byte naming its codec, so that frames are decoded on their own and a client can
+	*								mix them with uncompressed ones.
+  * @author			:
+  **************************************************************************************************
+  *
+  * CODEC_DELTA16: sensor samples, interleaved over 1 to 16 channels. Each sample is stored as the
+  * zig-zag varint of its difference with the previous sample of its channel (0 before the first
+  * one of the frame): slowly changing signals take 1 byte per sample instead of 2. The encoder
+  * fills the frame with whole sample sets and tells how many samples it took.
+  *
+  * CODEC_LZ: text and structured records. LZ77 over the record, preceded by a static dictionary
+  * of the usual field names, so that short records compress too. Tokens:
+  *  - 0x00..0x7F: literal run of (token + 1) bytes that follow;
+  *  - 0x80..0xFF: match of ((token >> 3) & 0x0F) + 3 bytes, at a distance of
+  *    (((token & 0x07) << 8) | next byte) + 1 back in the dictionary followed by the output.
+  * Matches are looked up through hash chains limited to CODEC_LZ_MAX_CHAIN candidates, records
+  * to CODEC_MAX_INPUT bytes: the encoding time is bounded. Tables are static, no heap is used.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Payload_Codec.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define CODEC_LZ_MIN_MATCH							3U
+#define CODEC_LZ_MAX_MATCH							(CODEC_LZ_MIN_MATCH + 15U)
+#define CODEC_LZ_MAX_DISTANCE						2048U
+#define CODEC_LZ_MAX_LITERALS						128U
+#define CODEC_LZ_HASH_SIZE							256U
+#define CODEC_LZ_NONE										((uint16_t)0xFFFF)
+
+/* Dictionary and record, the dictionary must not exceed 256 bytes */
+#define CODEC_LZ_WINDOW									(256U + CODEC_MAX_INPUT)
+
+/* Bytes of the varint of a zig-zag int16 difference */
+#define CODEC_VARINT_MAX								3U
+
+
+/* Private macro ---------------------------------------------------------------------------------*/
+#define CODEC_LZ_HASH(a, b)							((uint8_t)(((a) * 33U) ^ (b)))
+#define CODEC_ZIGZAG(v)									((uint32_t)(((uint32_t)(v) << 1) ^ (uint32_t)((v) >> 31)))
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+/**
+  * @brief Static dictionary (CODEC_DICT_ID), the most frequent strings last so that they are the
+  *				 closest to the record
+  */
+static const uint8_t Dictionary[] =
+	"OFFACKERR0000000000,null,false,true}]}\r\n"
+	"{\"id\":\"state\":\"step\":\"temp\":\"bat\":\"spo2\":\"hr\":"
+	"\"gyr\":[\"mag\":[\"acc\":[{\"t\":";
+
+#define CODEC_DICT_SIZE									((uint16_t)(sizeof(Dictionary) - 1U))
+
+/* Hash chains of the encoder: first position of a hash, previous position of the same hash */
+static uint16_t Head[CODEC_LZ_HASH_SIZE];
+static uint16_t Prev[CODEC_LZ_WINDOW];
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static uint8_t Codec_Byte(const uint8_t *pData, uint16_t Position);
+static void Codec_Insert(const uint8_t *pData, uint16_t End, uint16_t Position);
+static uint16_t Codec_Literals(const uint8_t *pLiterals, uint16_t Count, uint8_t *pFrame, uint16_t Pos, uint16_t Max);
+static Codec_Status_t Codec_DecodeDelta16(const uint8_t *pFrame, uint16_t Length, uint8_t Channels,
+																					uint8_t *pOut, uint16_t Max, uint16_t *pDecoded);
+static Codec_Status_t Codec_DecodeLZ(const uint8_t *pFrame, uint16_t Length, uint8_t *pOut, uint16_t Max, uint16_t *pDecoded);
+
+
+/******************************************* Encoders ********************************************/
+
+/**
+  * @brief	Encode int16 samples as a CODEC_DELTA16 frame
+	* @param	pSamples: samples, interleaved by channel
+	* @param	Count: samples, whole sets of Channels samples are encoded
+	* @param	Channels: 1 to CODEC_MAX_CHANNELS
+	* @param	pFrame: frame
+	* @param	Max: frame size, e.g. the characteristic length
+	* @param	pConsumed: samples encoded
+	* @retval	Frame length, 0 if not even one sample set fits
+	*/
+uint16_t Codec_EncodeDelta16(const int16_t *pSamples, uint16_t Count, uint8_t Channels,
+														 uint8_t *pFrame, uint16_t Max, uint16_t *pConsumed)
+{
+	uint8_t Set[CODEC_MAX_CHANNELS * CODEC_VARINT_MAX];
+	int32_t Last[CODEC_MAX_CHANNELS];
+	uint16_t Pos = 1, Used = 0, Size;
+	uint32_t Zigzag;
+	uint8_t c;
+
+	*pConsumed = 0;
+	if((Channels == 0U) || (Channels > CODEC_MAX_CHANNELS) || (Max < 2U))
+	{
+		return 0;
+	}
+
+	memset(Last, 0, sizeof(Last));
+	pFrame[0] = CODEC_HEADER(CODEC_DELTA16, Channels - 1U);
+
+	while((Used + Channels) <= Count)
+	{
+		/* A set is only kept if it fits as a whole */
+		Size = 0;
+		for(c = 0; c < Channels; c++)
+		{
+			Zigzag = CODEC_ZIGZAG((int32_t)pSamples[Used + c] - Last[c]);
+			while(Zigzag >= 0x80U)
+			{
+				Set[Size++] = (uint8_t)(Zigzag | 0x80U);
+				Zigzag >>= 7;
+			}
+			Set[Size++] = (uint8_t)Zigzag;
+		}
+
+		if((Pos + Size) > Max)
+		{
+			break;
+		}
+
+		memcpy(&pFrame[Pos], Set, Size);
+		Pos += Size;
+		for(c = 0; c < Channels; c++)
+		{
+			Last[c] = pSamples[Used + c];
+		}
+		Used += Channels;
+	}
+
+	*pConsumed = Used;
+	return (Used != 0U) ? Pos : 0U;
+}
+
+/**
+  * @brief	Encode a record as a CODEC_LZ frame
+	* @param	pData: record
+	* @param	Length: bytes, up to CODEC_MAX_INPUT
+	* @param	pFrame: frame
+	* @param	Max: frame size
+	* @retval	Frame length, 0 if it does not fit
+	*/
+uint16_t Codec_EncodeLZ(const uint8_t *pData, uint16_t Length, uint8_t *pFrame, uint16_t Max)
+{
+	uint16_t End = CODEC_DICT_SIZE + Length;
+	uint16_t Pos = 1, Literal_Start = 0, i = 0, k;
+	uint16_t Position, Candidate, Distance, Len, Best_Len, Best_Distance, Limit;
+	uint8_t Chain;
+
+	if((Length > CODEC_MAX_INPUT) || (Max < 1U))
+	{
+		return 0;
+	}
+
+	pFrame[0] = CODEC_HEADER(CODEC_LZ, CODEC_DICT_ID);
+	memset(Head, 0xFF, sizeof(Head));
+	for(Position = 0; Position < CODEC_DICT_SIZE; Position++)
+	{
+		Codec_Insert(pData, End, Position);
+	}
+
+	while(i < Length)
+	{
+		Position = CODEC_DICT_SIZE + i;
+		Limit = ((uint16_t)(Length - i) < CODEC_LZ_MAX_MATCH) ? (uint16_t)(Length - i) : (uint16_t)CODEC_LZ_MAX_MATCH;
+		Best_Len = 0;
+		Best_Distance = 0;
+
+		if(Limit >= CODEC_LZ_MIN_MATCH)
+		{
+			Candidate = Head[CODEC_LZ_HASH(Codec_Byte(pData, Position), Codec_Byte(pData, Position + 1U))];
+			for(Chain = 0; (Candidate != CODEC_LZ_NONE) && (Chain < CODEC_LZ_MAX_CHAIN); Chain++)
+			{
+				Distance = Position - Candidate;
+				if(Distance > CODEC_LZ_MAX_DISTANCE)
+				{
+					break;
+				}
+
+				for(Len = 0; (Len < Limit) && (Codec_Byte(pData, Candidate + Len) == Codec_Byte(pData, Position + Len)); Len++)
+				{
+				}
+
+				if(Len > Best_Len)
+				{
+					Best_Len = Len;
+					Best_Distance = Distance;
+					if(Len == Limit)
+					{
+						break;
+					}
+				}
+				Candidate = Prev[Candidate];
+			}
+		}
+
+		if(Best_Len < CODEC_LZ_MIN_MATCH)
+		{
+			Codec_Insert(pData, End, Position);
+			i++;
+			continue;
+		}
+
+		Pos = Codec_Literals(&pData[Literal_Start], i - Literal_Start, pFrame, Pos, Max);
+		if((Pos == 0U) || ((Pos + 2U) > Max))
+		{
+			return 0;
+		}
+		pFrame[Pos++] = (uint8_t)(0x80U | ((Best_Len - CODEC_LZ_MIN_MATCH) << 3) | ((Best_Distance - 1U) >> 8));
+		pFrame[Pos++] = (uint8_t)(Best_Distance - 1U);
+
+		for(k = 0; k < Best_Len; k++)
+		{
+			Codec_Insert(pData, End, Position + k);
+		}
+		i += Best_Len;
+		Literal_Start = i;
+	}
+
+	return Codec_Literals(&pData[Literal_Start], Length - Literal_Start, pFrame, Pos, Max);
+}
+
+/**
+  * @brief	Encode a record with CODEC_LZ, or CODEC_RAW when it does not compress
+	* @param	pData: record
+	* @param	Length: bytes, up to CODEC_MAX_INPUT
+	* @param	pFrame: frame
+	* @param	Max: frame size
+	* @retval	Frame length, 0 if it does not fit
+	*/
+uint16_t Codec_EncodeRecord(const uint8_t *pData, uint16_t Length, uint8_t *pFrame, uint16_t Max)
+{
+	uint16_t Size = Codec_EncodeLZ(pData, Length, pFrame, Max);
+
+	if((Size != 0U) && (Size < (Length + 1U)))
+	{
+		return Size;
+	}
+
+	if((Length + 1U) > Max)
+	{
+		return 0;
+	}
+
+	pFrame[0] = CODEC_HEADER(CODEC_RAW, 0);
+	memcpy(&pFrame[1], pData, Length);
+
+	return (uint16_t)(Length + 1U);
+}
+
+
+/******************************************* Decoder *********************************************/
+
+/**
+  * @brief	Decode a frame of any codec
+	* @param	pFrame: frame, header included
+	* @param	Length: frame length
+	* @param	pOut: decoded bytes, int16 samples in little endian for CODEC_DELTA16
+	* @param	Max: size of pOut
+	* @param	pDecoded: bytes decoded
+	*/
+Codec_Status_t Codec_Decode(const uint8_t *pFrame, uint16_t Length, uint8_t *pOut, uint16_t Max, uint16_t *pDecoded)
+{
+	*pDecoded = 0;
+	if(Length == 0U)
+	{
+		return CODEC_ERROR_FORMAT;
+	}
+
+	switch(CODEC_HEADER_CODEC(pFrame[0]))
+	{
+		case CODEC_RAW:
+		{
+			if((Length - 1U) > Max)
+			{
+				return CODEC_ERROR_OVERFLOW;
+			}
+			memcpy(pOut, &pFrame[1], Length - 1U);
+			*pDecoded = Length - 1U;
+			return CODEC_OK;
+		}
+
+		case CODEC_DELTA16:
+		{
+			return Codec_DecodeDelta16(pFrame, Length, CODEC_HEADER_PARAM(pFrame[0]) + 1U, pOut, Max, pDecoded);
+		}
+
+		case CODEC_LZ:
+		{
+			if(CODEC_HEADER_PARAM(pFrame[0]) != CODEC_DICT_ID)
+			{
+				return CODEC_ERROR_PARAM;
+			}
+			return Codec_DecodeLZ(pFrame, Length, pOut, Max, pDecoded);
+		}
+
+		default:
+		{
+			return CODEC_ERROR_FORMAT;
+		}
+	}
+}
+
+
+/*************************************** Private functions ***************************************/
+
+/**
+  * @brief	Byte of the dictionary followed by the record
+	*/
+static uint8_t Codec_Byte(const uint8_t *pData, uint16_t Position)
+{
+	return (Position < CODEC_DICT_SIZE) ? Dictionary[Position] : pData[Position - CODEC_DICT_SIZE];
+}
+
+/**
+  * @brief	Add a position to the hash chains
+	* @param	End: end of the dictionary and record
+	*/
+static void Codec_Insert(const uint8_t *pData, uint16_t End, uint16_t Position)
+{
+	uint8_t Hash;
+
+	if((Position + 1U) >= End)
+	{
+		return;
+	}
+
+	Hash = CODEC_LZ_HASH(Codec_Byte(pData, Position), Codec_Byte(pData, Position + 1U));
+	Prev[Position] = Head[Hash];
+	Head[Hash] = Position;
+}
+
+/**
+  * @brief	Write literal runs
+	* @retval	Frame position after them, 0 if they do not fit
+	*/
+static uint16_t Codec_Literals(const uint8_t *pLiterals, uint16_t Count, uint8_t *pFrame, uint16_t Pos, uint16_t Max)
+{
+	uint16_t Run;
+
+	while(Count != 0U)
+	{
+		Run = (Count < CODEC_LZ_MAX_LITERALS) ? Count : CODEC_LZ_MAX_LITERALS;
+		if((Pos + 1U + Run) > Max)
+		{
+			return 0;
+		}
+
+		pFrame[Pos++] = (uint8_t)(Run - 1U);
+		memcpy(&pFrame[Pos], pLiterals, Run);
+		Pos += Run;
+		pLiterals += Run;
+		Count -= Run;
+	}
+
+	return Pos;
+}
+
+static Codec_Status_t Codec_DecodeDelta16(const uint8_t *pFrame, uint16_t Length, uint8_t Channels,
+																					uint8_t *pOut, uint16_t Max, uint16_t *pDecoded)
+{
+	int16_t Last[CODEC_MAX_CHANNELS];
+	uint16_t Pos = 1, Out = 0;
+	uint32_t Zigzag;
+	uint8_t Shift, c = 0;
+
+	memset(Last, 0, sizeof(Last));
+
+	while(Pos < Length)
+	{
+		Zigzag = 0;
+		Shift = 0;
+		do
+		{
+			if((Pos >= Length) || (Shift > (7U * (CODEC_VARINT_MAX - 1U))))
+			{
+				return CODEC_ERROR_FORMAT;
+			}
+			Zigzag |= (uint32_t)(pFrame[Pos] & 0x7FU) << Shift;
+			Shift += 7U;
+		} while(pFrame[Pos++] & 0x80U);
+
+		if((Out + 2U) > Max)
+		{
+			return CODEC_ERROR_OVERFLOW;
+		}
+
+		Last[c] = (int16_t)(Last[c] + (int32_t)((Zigzag >> 1) ^ (0U - (Zigzag & 1U))));
+		pOut[Out++] = (uint8_t)Last[c];
+		pOut[Out++] = (uint8_t)((uint16_t)Last[c] >> 8);
+		c = (uint8_t)((c + 1U) % Channels);
+	}
+
+	if(c != 0U)
+	{
+		return CODEC_ERROR_FORMAT;
+	}
+
+	*pDecoded = Out;
+	return CODEC_OK;
+}
+
+static Codec_Status_t Codec_DecodeLZ(const uint8_t *pFrame, uint16_t Length, uint8_t *pOut, uint16_t Max, uint16_t *pDecoded)
+{
+	uint16_t Pos = 1, Out = 0, Run, Distance, Source;
+	uint8_t Token;
+
+	while(Pos < Length)
+	{
+		Token = pFrame[Pos++];
+		if(Token < 0x80U)
+		{
+			Run = Token + 1U;
+			if((Pos + Run) > Length)
+			{
+				return CODEC_ERROR_FORMAT;
+			}
+			if((Out + Run) > Max)
+			{
+				return CODEC_ERROR_OVERFLOW;
+			}
+			memcpy(&pOut[Out], &pFrame[Pos], Run);
+			Pos += Run;
+			Out += Run;
+			continue;
+		}
+
+		if(Pos >= Length)
+		{
+			return CODEC_ERROR_FORMAT;
+		}
+		Run = ((Token >> 3) & 0x0FU) + CODEC_LZ_MIN_MATCH;
+		Distance = (uint16_t)((((uint16_t)Token & 0x07U) << 8) | pFrame[Pos++]) + 1U;
+		if(Distance > (CODEC_DICT_SIZE + Out))
+		{
+			return CODEC_ERROR_FORMAT;
+		}
+		if((Out + Run) > Max)
+		{
+			return CODEC_ERROR_OVERFLOW;
+		}
+
+		/* Byte by byte, the match may overlap the bytes it produces */
+		Source = CODEC_DICT_SIZE + Out - Distance;
+		while(Run--)
+		{
+			pOut[Out] = (Source < CODEC_DICT_SIZE) ? Dictionary[Source] : pOut[Source - CODEC_DICT_SIZE];
+			Source++;
+			Out++;
+		}
+	}
+
+	*pDecoded = Out;
+	return CODEC_OK;
+}
+
+
+/******************************************* END OF FILE *******************************************/
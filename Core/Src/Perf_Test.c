@@ -0,0 +1,568 @@
+/**
+  **************************************************************************************************
+  * @file       : Perf_Test.c
+  * @brief      : Throughput and latency test service. Streams, counts or reflects packets on a data
+	*								characteristic and reports the results on a read characteristic and over UART.
+  * @author			:
+  **************************************************************************************************
+  *
+  * The peer selects the mode by writing the control characteristic, then:
+  *  - source: notifications of the data characteristic carry a sequence number (u16, little endian)
+  *    and are queued before every connection event until the TX pool is full (RadioSched refill);
+  *  - sink: writes without response to the data characteristic are counted, gaps in their sequence
+  *    numbers are counted as lost;
+  *  - echo: a probe (PERFTEST_PKT_PROBE, sequence number, TIM2 time in us) is notified and the
+  *    peer writes it back unchanged, the round trip is measured here. Probes of the peer
+  *    (PERFTEST_PKT_PEER) are notified back unchanged for it to measure the round trip itself.
+  * Writing PERFTEST_CMD_STOP, a new mode or disconnecting ends the run and publishes the results.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include <stdio.h>
+#include "Perf_Test.h"
+#include "BLE_Process.h"
+#include "Radio_Sched.h"
+#include "Link_Monitor.h"
+#include "Gatt_Builder.h"
+#include "bluenrg1_gatt_aci.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* Echo packet types, first byte of the packet */
+#define PERFTEST_PKT_PROBE						((uint8_t)0xE0)		/* Sent here, reflected by the peer */
+#define PERFTEST_PKT_PEER							((uint8_t)0xE1)		/* Sent by the peer, reflected here */
+#define PERFTEST_PROBE_SIZE						7U
+
+/* Client Characteristic Configuration: notifications enabled */
+#define PERFTEST_CCCD_NOTIFY					((uint8_t)0x01)
+
+
+/* Private macro ---------------------------------------------------------------------------------*/
+#define PERFTEST_GET_U16(p)						((uint16_t)((p)[0] | ((uint16_t)(p)[1] << 8)))
+#define PERFTEST_GET_U32(p)						((uint32_t)((p)[0] | ((uint32_t)(p)[1] << 8) | ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24)))
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static uint8_t *PerfTest_PutU16(uint8_t *p, uint16_t Value);
+static uint8_t *PerfTest_PutU32(uint8_t *p, uint32_t Value);
+
+
+/****************************************** Accounting *******************************************/
+
+/**
+  * @brief	Clear the results for a new run
+	* @param	pResults: results
+	* @param	Mode: PERFTEST_MODE_x
+	*/
+void PerfTest_ResultsInit(PerfTest_Results_t *pResults, uint8_t Mode)
+{
+	memset(pResults, 0, sizeof(PerfTest_Results_t));
+	pResults->Mode = Mode;
+	pResults->RTT_Min_us = UINT32_MAX;
+}
+
+/**
+  * @brief	Count a packet received in sink mode
+	* @param	pResults: results
+	* @param	pData: packet, starting with its sequence number
+	* @param	Length: bytes
+	* @note		Sequence numbers behind the expected one (repeated packets) are counted but do not
+	*					move the expected number back
+	*/
+void PerfTest_SinkUpdate(PerfTest_Results_t *pResults, const uint8_t *pData, uint16_t Length)
+{
+	uint16_t Seq, Gap;
+
+	pResults->Bytes += Length;
+	if(Length < PERFTEST_MIN_PAYLOAD)
+	{
+		pResults->Packets++;
+		return;
+	}
+
+	Seq = PERFTEST_GET_U16(pData);
+	if(pResults->Packets == 0U)
+	{
+		pResults->Next_Seq = Seq;
+	}
+	pResults->Packets++;
+
+	Gap = (uint16_t)(Seq - pResults->Next_Seq);
+	if(Gap < 0x8000U)
+	{
+		pResults->Lost += Gap;
+		pResults->Next_Seq = (uint16_t)(Seq + 1U);
+	}
+}
+
+/**
+  * @brief	Histogram bin of a round trip time
+	* @param	RTT_us: round trip, us
+	* @retval	Bin, below PERFTEST_RTT_BINS
+	*/
+uint8_t PerfTest_RttBin(uint32_t RTT_us)
+{
+	uint8_t Bin = 0;
+	uint32_t Edge = PERFTEST_RTT_BIN0_US;
+
+	while((Bin < (PERFTEST_RTT_BINS - 1U)) && (RTT_us > Edge))
+	{
+		Edge <<= 1;
+		Bin++;
+	}
+
+	return Bin;
+}
+
+/**
+  * @brief	Count a round trip measured in echo mode
+	* @param	pResults: results
+	* @param	RTT_us: round trip, us
+	*/
+void PerfTest_RttAdd(PerfTest_Results_t *pResults, uint32_t RTT_us)
+{
+	uint8_t Bin = PerfTest_RttBin(RTT_us);
+
+	if(RTT_us < pResults->RTT_Min_us)
+	{
+		pResults->RTT_Min_us = RTT_us;
+	}
+	if(RTT_us > pResults->RTT_Max_us)
+	{
+		pResults->RTT_Max_us = RTT_us;
+	}
+	pResults->RTT_Sum_us += RTT_us;
+
+	if(pResults->RTT_Hist[Bin] < UINT16_MAX)
+	{
+		pResults->RTT_Hist[Bin]++;
+	}
+}
+
+/**
+  * @brief	Close a run and compute the rate
+	* @param	pResults: results
+	* @param	Duration_ms: length of the run
+	*/
+void PerfTest_Finish(PerfTest_Results_t *pResults, uint32_t Duration_ms)
+{
+	pResults->Duration_ms = Duration_ms;
+	pResults->Bytes_Per_s = (Duration_ms != 0U) ? (uint32_t)(((uint64_t)pResults->Bytes * 1000U) / Duration_ms) : 0U;
+}
+
+/**
+  * @brief	Results as published on the results characteristic, little endian: mode (u8), duration
+	*					in ms, bytes, packets, lost, bytes/s (u32), round trips (u16), RTT min, max and average
+	*					in us (u32), then the histogram (PERFTEST_RTT_BINS x u16)
+	* @param	pResults: results
+	* @param	pBuffer: PERFTEST_RESULTS_SIZE bytes
+	* @retval	Bytes written
+	*/
+uint16_t PerfTest_Serialize(const PerfTest_Results_t *pResults, uint8_t *pBuffer)
+{
+	uint8_t *p = pBuffer;
+	uint32_t Count = 0;
+	uint8_t i;
+
+	for(i = 0; i < PERFTEST_RTT_BINS; i++)
+	{
+		Count += pResults->RTT_Hist[i];
+	}
+
+	*p++ = pResults->Mode;
+	p = PerfTest_PutU32(p, pResults->Duration_ms);
+	p = PerfTest_PutU32(p, pResults->Bytes);
+	p = PerfTest_PutU32(p, pResults->Packets);
+	p = PerfTest_PutU32(p, pResults->Lost);
+	p = PerfTest_PutU32(p, pResults->Bytes_Per_s);
+	p = PerfTest_PutU16(p, (Count > UINT16_MAX) ? UINT16_MAX : (uint16_t)Count);
+	p = PerfTest_PutU32(p, (Count != 0U) ? pResults->RTT_Min_us : 0U);
+	p = PerfTest_PutU32(p, pResults->RTT_Max_us);
+	p = PerfTest_PutU32(p, (Count != 0U) ? (pResults->RTT_Sum_us / Count) : 0U);
+	for(i = 0; i < PERFTEST_RTT_BINS; i++)
+	{
+		p = PerfTest_PutU16(p, pResults->RTT_Hist[i]);
+	}
+
+	return (uint16_t)(p - pBuffer);
+}
+
+
+#if PERFTEST_ENABLE
+/******************************************** Service ********************************************/
+
+/* External variables ----------------------------------------------------------------------------*/
+extern UART_HandleTypeDef huart1;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* UUIDs derived from the application characteristics (...0x8x, 0xEA...) */
+static const uint8_t Service_UUID[16] =
+{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x90,0xEA,0x25,0x9B};
+static const uint8_t Control_UUID[16] =
+{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x91,0xEA,0x25,0x9B};
+static const uint8_t Data_UUID[16] =
+{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x92,0xEA,0x25,0x9B};
+static const uint8_t Results_UUID[16] =
+{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x93,0xEA,0x25,0x9B};
+
+static uint16_t hPerfService;
+static uint16_t hControl;
+static uint16_t hData;
+static uint16_t hResults;
+
+static PerfTest_Results_t Results;
+static uint16_t Connection;
+static uint8_t Notify_Enabled;
+static uint8_t Payload_Length;
+static uint32_t Run_Start;								/* ms */
+static uint32_t Run_Duration;							/* ms, 0 until stopped */
+
+static uint8_t Probe_Pending;
+static uint32_t Probe_Sent;								/* ms */
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static void PerfTest_Start(uint8_t Mode);
+static void PerfTest_Stop(void);
+static RadioSched_Refill_t PerfTest_Refill(void);
+static void PerfTest_SendProbe(void);
+static void PerfTest_Report(void);
+
+
+/**
+  * @brief	Add the test service to the GATT database
+	* @note		To be called after aci_gatt_init() and aci_gap_init()
+	*/
+PerfTest_Status_t PerfTest_Init(void)
+{
+	uint8_t Value[PERFTEST_RESULTS_SIZE];
+
+	PerfTest_ResultsInit(&Results, PERFTEST_MODE_IDLE);
+	Notify_Enabled = 0;
+	Probe_Pending = 0;
+
+	/* Service, control (2 records), data (3 records with the CCCD), results (2 records) */
+	static const GattBuild_Char_t Chars[3] =
+	{
+		{Control_UUID, 4, CHAR_PROP_WRITE, GATT_NOTIFY_ATTRIBUTE_WRITE, CHAR_VALUE_LEN_VARIABLE, NULL, 0, &hControl},
+		{Data_UUID, PERFTEST_MAX_PAYLOAD, CHAR_PROP_NOTIFY|CHAR_PROP_WRITE_WITHOUT_RESP, GATT_NOTIFY_ATTRIBUTE_WRITE,
+			CHAR_VALUE_LEN_VARIABLE, NULL, 0, &hData},
+		{Results_UUID, PERFTEST_RESULTS_SIZE, CHAR_PROP_READ, GATT_DONT_NOTIFY_EVENTS, CHAR_VALUE_LEN_CONSTANT, NULL, 0, &hResults},
+	};
+	static const GattBuild_Service_t Service = {Service_UUID, 8, Chars, 3, &hPerfService};
+
+	if(GattBuild_Run(&Service, 1) != GATTBUILD_OK)
+	{
+		return PERFTEST_ERROR_ACI;
+	}
+
+	(void)PerfTest_Serialize(&Results, Value);
+	(void)aci_gatt_update_char_value(hPerfService, hResults, 0, PERFTEST_RESULTS_SIZE, Value);
+
+	return PERFTEST_OK;
+}
+
+/**
+  * @brief	Handle a write of the peer
+	* @param	Connection_Handle: link written on
+	* @param	Attr_Handle: attribute written
+	* @param	Length: bytes
+	* @param	pData: value written
+	* @retval	1 if the attribute belongs to the test service, 0 otherwise
+	*/
+uint8_t PerfTest_AttributeModified(uint16_t Connection_Handle, uint16_t Attr_Handle, uint16_t Length, const uint8_t *pData)
+{
+	uint16_t Duration;
+
+	if(Attr_Handle == (hControl + 1U))
+	{
+		if(Length == 0U)
+		{
+			return 1;
+		}
+		Connection = Connection_Handle;
+
+		switch(pData[0])
+		{
+			case PERFTEST_CMD_SOURCE:
+			{
+				Payload_Length = (Length > 1U) ? pData[1] : PERFTEST_MAX_PAYLOAD;
+				if(Payload_Length < PERFTEST_MIN_PAYLOAD)
+				{
+					Payload_Length = PERFTEST_MIN_PAYLOAD;
+				}
+				else if(Payload_Length > PERFTEST_MAX_PAYLOAD)
+				{
+					Payload_Length = PERFTEST_MAX_PAYLOAD;
+				}
+				Duration = (Length > 3U) ? PERFTEST_GET_U16(&pData[2]) : 0U;
+				PerfTest_Start(PERFTEST_MODE_SOURCE);
+				Run_Duration = (uint32_t)Duration * 1000U;
+				break;
+			}
+
+			case PERFTEST_CMD_SINK:
+			{
+				PerfTest_Start(PERFTEST_MODE_SINK);
+				break;
+			}
+
+			case PERFTEST_CMD_ECHO:
+			{
+				PerfTest_Start(PERFTEST_MODE_ECHO);
+				break;
+			}
+
+			default:
+			{
+				PerfTest_Stop();
+				break;
+			}
+		}
+		return 1;
+	}
+	else if(Attr_Handle == (hData + 1U))
+	{
+		if(Results.Mode == PERFTEST_MODE_SINK)
+		{
+			PerfTest_SinkUpdate(&Results, pData, Length);
+		}
+		else if((Results.Mode == PERFTEST_MODE_ECHO) && (Length >= PERFTEST_PROBE_SIZE))
+		{
+			if((pData[0] == PERFTEST_PKT_PROBE) && Probe_Pending && (PERFTEST_GET_U16(&pData[1]) == (uint16_t)(Results.Next_Seq - 1U)))
+			{
+				PerfTest_RttAdd(&Results, RadioSched_GetTime() - PERFTEST_GET_U32(&pData[3]));
+				Results.Packets++;
+				Results.Bytes += Length;
+				Probe_Pending = 0;
+			}
+			else if(pData[0] == PERFTEST_PKT_PEER)
+			{
+				(void)aci_gatt_update_char_value(hPerfService, hData, 0, (uint8_t)((Length > PERFTEST_MAX_PAYLOAD) ? PERFTEST_MAX_PAYLOAD : Length), (uint8_t *)pData);
+			}
+		}
+		return 1;
+	}
+	else if(Attr_Handle == (hData + 2U))
+	{
+		Notify_Enabled = (Length != 0U) && (pData[0] & PERFTEST_CCCD_NOTIFY);
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+  * @brief	End the run on disconnection
+	*/
+void PerfTest_Disconnect(void)
+{
+	Notify_Enabled = 0;
+	PerfTest_Stop();
+}
+
+/**
+  * @brief	Run timeouts and echo probes
+	* @note		To be called from the main loop
+	*/
+void PerfTest_Process(void)
+{
+	if(Results.Mode == PERFTEST_MODE_IDLE)
+	{
+		return;
+	}
+
+	if(Run_Duration && ((HAL_GetTick() - Run_Start) >= Run_Duration))
+	{
+		PerfTest_Stop();
+		return;
+	}
+
+	if(Results.Mode == PERFTEST_MODE_ECHO)
+	{
+		if(Probe_Pending && ((HAL_GetTick() - Probe_Sent) >= PERFTEST_ECHO_TIMEOUT_MS))
+		{
+			Results.Lost++;
+			Probe_Pending = 0;
+		}
+		if(!Probe_Pending)
+		{
+			PerfTest_SendProbe();
+		}
+	}
+}
+
+const PerfTest_Results_t *PerfTest_GetResults(void)
+{
+	return &Results;
+}
+
+
+/**
+  * @brief	Start a run, ending the current one
+	* @param	Mode: PERFTEST_MODE_x
+	*/
+static void PerfTest_Start(uint8_t Mode)
+{
+	if(Results.Mode != PERFTEST_MODE_IDLE)
+	{
+		PerfTest_Stop();
+	}
+
+	PerfTest_ResultsInit(&Results, Mode);
+	Run_Start = HAL_GetTick();
+	Run_Duration = 0;
+	Probe_Pending = 0;
+
+	if(Mode == PERFTEST_MODE_SOURCE)
+	{
+		/* Fill the TX pool now, then before every connection event */
+		RadioSched_SetRefill(PerfTest_Refill);
+		(void)PerfTest_Refill();
+	}
+}
+
+/**
+  * @brief	End the run and publish its results
+	*/
+static void PerfTest_Stop(void)
+{
+	uint8_t Value[PERFTEST_RESULTS_SIZE];
+
+	if(Results.Mode == PERFTEST_MODE_IDLE)
+	{
+		return;
+	}
+
+	if(Results.Mode == PERFTEST_MODE_SOURCE)
+	{
+		RadioSched_SetRefill(NULL);
+	}
+
+	PerfTest_Finish(&Results, HAL_GetTick() - Run_Start);
+	(void)PerfTest_Serialize(&Results, Value);
+	(void)aci_gatt_update_char_value(hPerfService, hResults, 0, PERFTEST_RESULTS_SIZE, Value);
+	PerfTest_Report();
+
+	Results.Mode = PERFTEST_MODE_IDLE;
+}
+
+/**
+  * @brief	Queue source notifications until the TX pool is full
+	*/
+static RadioSched_Refill_t PerfTest_Refill(void)
+{
+	uint8_t Packet[PERFTEST_MAX_PAYLOAD];
+	uint8_t i, Sent = 0;
+	tBleStatus ret;
+
+	if((Results.Mode != PERFTEST_MODE_SOURCE) || !Notify_Enabled)
+	{
+		return RADIOSCHED_REFILL_NONE;
+	}
+
+	memset(Packet, 0, sizeof(Packet));
+	for(i = 0; i < PERFTEST_MAX_BURST; i++)
+	{
+		(void)PerfTest_PutU16(Packet, Results.Next_Seq);
+		ret = aci_gatt_update_char_value(hPerfService, hData, 0, Payload_Length, Packet);
+		if(ret != BLE_STATUS_SUCCESS)
+		{
+			/* Refused packets tell the link monitor the peer does not keep up */
+			LinkMon_ReportTx(Connection, Sent + 1U, 1);
+			return (ret == BLE_STATUS_INSUFFICIENT_RESOURCES) ? RADIOSCHED_REFILL_FULL : RADIOSCHED_REFILL_PARTIAL;
+		}
+
+		Results.Next_Seq++;
+		Results.Packets++;
+		Results.Bytes += Payload_Length;
+		Sent++;
+	}
+
+	LinkMon_ReportTx(Connection, Sent, 0);
+	return RADIOSCHED_REFILL_PARTIAL;
+}
+
+/**
+  * @brief	Notify the next echo probe
+	*/
+static void PerfTest_SendProbe(void)
+{
+	uint8_t Probe[PERFTEST_PROBE_SIZE];
+
+	if(!Notify_Enabled)
+	{
+		return;
+	}
+
+	Probe[0] = PERFTEST_PKT_PROBE;
+	(void)PerfTest_PutU16(&Probe[1], Results.Next_Seq);
+	(void)PerfTest_PutU32(&Probe[3], RadioSched_GetTime());
+
+	/* Retried at the next call when the TX pool is full */
+	if(aci_gatt_update_char_value(hPerfService, hData, 0, PERFTEST_PROBE_SIZE, Probe) == BLE_STATUS_SUCCESS)
+	{
+		Results.Next_Seq++;
+		Probe_Pending = 1;
+		Probe_Sent = HAL_GetTick();
+	}
+}
+
+/**
+  * @brief	Print the results of the run over UART
+	*/
+static void PerfTest_Report(void)
+{
+	char Text[128];
+	uint32_t i, Count = 0;
+	int Length;
+
+	for(i = 0; i < PERFTEST_RTT_BINS; i++)
+	{
+		Count += Results.RTT_Hist[i];
+	}
+
+	Length = snprintf(Text, sizeof(Text), "Perf mode %u: %lu B in %lu ms, %lu B/s, %lu pkts, %lu lost\r\n",
+										Results.Mode, (unsigned long)Results.Bytes, (unsigned long)Results.Duration_ms,
+										(unsigned long)Results.Bytes_Per_s, (unsigned long)Results.Packets, (unsigned long)Results.Lost);
+	HAL_UART_Transmit(&huart1, (uint8_t*)Text, (uint16_t)Length, UART_TIMEOUT);
+
+	if(Count != 0U)
+	{
+		Length = snprintf(Text, sizeof(Text), "RTT us: min %lu avg %lu max %lu, hist",
+											(unsigned long)Results.RTT_Min_us, (unsigned long)(Results.RTT_Sum_us / Count),
+											(unsigned long)Results.RTT_Max_us);
+		for(i = 0; i < PERFTEST_RTT_BINS; i++)
+		{
+			Length += snprintf(&Text[Length], sizeof(Text) - (uint32_t)Length, " %u", Results.RTT_Hist[i]);
+		}
+		Length += snprintf(&Text[Length], sizeof(Text) - (uint32_t)Length, "\r\n");
+		HAL_UART_Transmit(&huart1, (uint8_t*)Text, (uint16_t)Length, UART_TIMEOUT);
+	}
+}
+#endif /* PERFTEST_ENABLE */
+
+
+/*************************************** Private functions ***************************************/
+
+static uint8_t *PerfTest_PutU16(uint8_t *p, uint16_t Value)
+{
+	p[0] = (uint8_t)Value;
+	p[1] = (uint8_t)(Value >> 8);
+	return p + 2;
+}
+
+static uint8_t *PerfTest_PutU32(uint8_t *p, uint32_t Value)
+{
+	p[0] = (uint8_t)Value;
+	p[1] = (uint8_t)(Value >> 8);
+	p[2] = (uint8_t)(Value >> 16);
+	p[3] = (uint8_t)(Value >> 24);
+	return p + 4;
+}
+
+
+/******************************************* END OF FILE *******************************************/
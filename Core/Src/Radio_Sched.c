@@ -0,0 +1,383 @@
+/**
+  **************************************************************************************************
+  * @file       : Radio_Sched.c
+  * @brief      : Radio activity aware scheduling. Tracks the upcoming BlueNRG-2 radio activities
+	*								and runs CPU or SPI heavy jobs (DSP blocks, flash writes, ...) in the gaps between
+	*								them. Notification buffers are refilled right before each connection event.
+  * @author			:
+  **************************************************************************************************
+  *
+  * aci_hal_end_of_radio_activity_event gives, at the end of each radio activity enabled in the
+  * mask, the type and the controller time (2.4414 us ticks) of the next one. The difference with
+  * the time announced by the previous event is the period between the activity that just ended
+  * and the next one. Removing the assumed length of the finished activity, a guard time and the
+  * HSI tolerance gives the end of the free gap on the local TIM2 microsecond timebase.
+  *
+  * Jobs are queued with their worst-case duration and run first-fit, in submission order, while
+  * they fit in what is left of the gap. Everything runs from BlueNRG_Loop(), never from an ISR.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Radio_Sched.h"
+#include "Event_Mask.h"
+#include "bluenrg1_hal_aci.h"
+#include "bluenrg1_events.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* With no radio event for this long past the next activity announced (or past the last event when
+   none is known), the radio is considered idle */
+#define RADIOSCHED_SILENCE_US						100000U
+/* Period assumed for a next activity announced by the first event, before the controller time of
+   a second one gives it: the longest advertising interval */
+#define RADIOSCHED_MAX_PERIOD_US				10240000U
+
+
+/* Private macro ---------------------------------------------------------------------------------*/
+/* One controller tick is 625/256 us */
+#define RADIOSCHED_SYSTIME_TO_US(t)			((uint32_t)(((uint64_t)(t) * 625U) >> 8))
+#define RADIOSCHED_IS_CONN_EVENT(s)			(((s) == RADIO_STATE_CONN_SLAVE) || ((s) == RADIO_STATE_CONN_MASTER))
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+typedef struct
+{
+	RadioSched_Job_t Job;
+	void *pContext;
+	uint32_t Duration_us;
+	uint32_t Deferred_Gap;						/* Last gap counted in Jobs_Deferred */
+
+} RadioSched_Entry_t;
+
+
+/* External variables ----------------------------------------------------------------------------*/
+extern TIM_HandleTypeDef htim2;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static RadioSched_Entry_t Jobs[RADIOSCHED_MAX_JOBS];
+static uint8_t JobCount;
+
+static RadioSched_RefillFunc_t RefillFunc;
+static RadioSched_ActivityFunc_t ActivityHook;
+static uint8_t Refill_Pending;
+static RadioSched_Refill_t Refill_Result;
+
+static uint8_t Gap_Open;
+static uint8_t Gap_Unbounded;				/* Nothing scheduled on the radio */
+static uint32_t Gap_End;						/* Local time the gap closes at */
+static uint32_t Gap_Seq;
+
+static uint8_t Last_Valid;
+static uint32_t Last_SysTime;				/* Controller time of the activity that just ended */
+static uint32_t Last_EventTime;			/* Local time of the last radio event */
+static uint32_t Last_Period;				/* us from the last event to the next activity, 0 if none announced */
+
+static RadioSched_Stats_t Stats;
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static int32_t RadioSched_Remaining(uint32_t Now);
+
+
+/**
+  * @brief	Enable the radio activity events and reset the scheduler
+	* @param	Activity_Mask: RADIO_ACTIVITY_MASK_x of the activities to track
+	* @retval	Status
+	*/
+RadioSched_Status_t RadioSched_Init(uint16_t Activity_Mask)
+{
+	JobCount = 0;
+	RefillFunc = NULL;
+	ActivityHook = NULL;
+	Refill_Pending = 0;
+	Refill_Result = RADIOSCHED_REFILL_NONE;
+	Gap_Open = 0;
+	Gap_Unbounded = 0;
+	Gap_Seq = 0;
+	Last_Valid = 0;
+	Last_Period = 0;
+	Last_EventTime = RadioSched_GetTime();
+	RadioSched_ResetStats();
+	(void)EvtMask_Register(EVTMASK_HAL_END_OF_RADIO_ACTIVITY);
+
+	if(aci_hal_set_radio_activity_mask(Activity_Mask) != BLE_STATUS_SUCCESS)
+	{
+		return RADIOSCHED_ERROR_ACI;
+	}
+
+	return RADIOSCHED_OK;
+}
+
+/**
+  * @brief	Queue a job for the next gap long enough to hold it
+	* @param	Job: function to run
+	* @param	pContext: passed to the job
+	* @param	Duration_us: worst-case run time of the job
+	* @retval	RADIOSCHED_ERROR_FULL if RADIOSCHED_MAX_JOBS jobs are already waiting
+	*/
+RadioSched_Status_t RadioSched_Submit(RadioSched_Job_t Job, void *pContext, uint32_t Duration_us)
+{
+	if(Job == NULL)
+	{
+		return RADIOSCHED_ERROR_PARAM;
+	}
+
+	if(JobCount >= RADIOSCHED_MAX_JOBS)
+	{
+		return RADIOSCHED_ERROR_FULL;
+	}
+
+	Jobs[JobCount].Job = Job;
+	Jobs[JobCount].pContext = pContext;
+	Jobs[JobCount].Duration_us = Duration_us;
+	Jobs[JobCount].Deferred_Gap = Gap_Seq - 1U;
+	JobCount++;
+
+	return RADIOSCHED_OK;
+}
+
+/**
+  * @brief	Register the function queuing notifications before each connection event
+	* @param	Refill: queues data until nothing is left or the TX buffers are full, NULL to remove
+	*/
+void RadioSched_SetRefill(RadioSched_RefillFunc_t Refill)
+{
+	RefillFunc = Refill;
+}
+
+/**
+  * @brief	Register a function called with every radio activity event and its local arrival time
+	* @param	Hook: function to call, NULL to remove
+	*/
+void RadioSched_SetActivityHook(RadioSched_ActivityFunc_t Hook)
+{
+	ActivityHook = Hook;
+}
+
+/**
+  * @brief	Run the refill and the queued jobs that fit in the current gap
+	* @note		To be called from the main loop, right after hci_user_evt_proc()
+	*/
+void RadioSched_Process(void)
+{
+	RadioSched_Entry_t Entry;
+	int32_t Remaining, Budget;
+	uint32_t Now;
+	uint8_t i;
+
+	Now = RadioSched_GetTime();
+
+	/* Events stopped (e.g. advertising disabled): nothing is scheduled on the radio. A gap closed
+	   before a known activity stays closed until that activity is well overdue, whatever the
+	   advertising or connection interval */
+	if(!Gap_Open && ((Now - Last_EventTime) > (Last_Period + RADIOSCHED_SILENCE_US)))
+	{
+		Gap_Open = 1;
+		Gap_Unbounded = 1;
+	}
+
+	Remaining = RadioSched_Remaining(Now);
+
+	/* Refill the notification buffers just before the connection event */
+	if(Refill_Pending && (!Gap_Open || (Remaining <= (int32_t)RADIOSCHED_REFILL_LEAD_US)))
+	{
+		Refill_Pending = 0;
+		if(!Gap_Open || (Remaining < -(int32_t)RADIOSCHED_GUARD_US))
+		{
+			Stats.Refills_Late++;
+		}
+		Refill_Result = RefillFunc();
+	}
+
+	if(!Gap_Open)
+	{
+		return;
+	}
+
+	i = 0;
+	while(i < JobCount)
+	{
+		Remaining = RadioSched_Remaining(RadioSched_GetTime());
+		Budget = Remaining - (Refill_Pending ? (int32_t)RADIOSCHED_REFILL_LEAD_US : 0);
+		if(Budget <= 0)
+		{
+			break;
+		}
+
+		if(Jobs[i].Duration_us <= (uint32_t)Budget)
+		{
+			/* Dequeue first, the job may submit new ones */
+			Entry = Jobs[i];
+			JobCount--;
+			memmove(&Jobs[i], &Jobs[i + 1U], (JobCount - i) * sizeof(RadioSched_Entry_t));
+
+			Entry.Job(Entry.pContext);
+			Stats.Jobs_Run++;
+
+			if(RadioSched_Remaining(RadioSched_GetTime()) < -(int32_t)RADIOSCHED_GUARD_US)
+			{
+				Stats.Jobs_Overrun++;
+			}
+		}
+		else
+		{
+			if(Jobs[i].Deferred_Gap != Gap_Seq)
+			{
+				Jobs[i].Deferred_Gap = Gap_Seq;
+				Stats.Jobs_Deferred++;
+			}
+			i++;
+		}
+	}
+
+	if(RadioSched_Remaining(RadioSched_GetTime()) <= 0)
+	{
+		Gap_Open = 0;
+	}
+}
+
+/**
+  * @brief	Local microsecond timebase (TIM2, retimed by ClockProfile_Set())
+	* @retval	Time in us, wraps around every 71 minutes
+	*/
+uint32_t RadioSched_GetTime(void)
+{
+	return htim2.Instance->CNT;
+}
+
+/**
+  * @brief	Time left before the next radio activity, minus the refill lead time
+	* @retval	Free time in us, 0 when unknown or already over, UINT32_MAX if the radio is idle
+	*/
+uint32_t RadioSched_GetFreeTime(void)
+{
+	int32_t Remaining;
+
+	if(!Gap_Open)
+	{
+		return 0;
+	}
+
+	if(Gap_Unbounded)
+	{
+		return UINT32_MAX;
+	}
+
+	Remaining = RadioSched_Remaining(RadioSched_GetTime()) - (Refill_Pending ? (int32_t)RADIOSCHED_REFILL_LEAD_US : 0);
+
+	return (Remaining > 0) ? (uint32_t)Remaining : 0U;
+}
+
+/**
+  * @brief	Scheduler statistics
+	*/
+const RadioSched_Stats_t *RadioSched_GetStats(void)
+{
+	return &Stats;
+}
+
+void RadioSched_ResetStats(void)
+{
+	memset(&Stats, 0, sizeof(Stats));
+}
+
+/**
+  * @brief	Time left in the current gap
+	* @param	Now: local time
+	* @retval	us before the gap closes, negative once it is over
+	*/
+static int32_t RadioSched_Remaining(uint32_t Now)
+{
+	if(Gap_Unbounded)
+	{
+		return INT32_MAX;
+	}
+
+	return (int32_t)(Gap_End - Now);
+}
+
+
+/********************** BLE HCI related events and event callbacks in Stack *****************************/
+
+/*******************************************************************************
+ * Function Name  : aci_hal_end_of_radio_activity_event.
+ * Description    : Reported at the end of each radio activity enabled in the
+ *									mask, with the type and time of the next one.
+ * Input          : See file bluenrg1_events.h
+ * Output         : See file bluenrg1_events.h
+ * Return         : See file bluenrg1_events.h
+ *******************************************************************************/
+void aci_hal_end_of_radio_activity_event(uint8_t Last_State,
+                                         uint8_t Next_State,
+                                         uint32_t Next_State_SysTime)
+{
+	uint32_t Now = RadioSched_GetTime();
+	uint32_t Period_us, Margin_us;
+
+	Stats.Radio_Events++;
+	Last_EventTime = Now;
+
+	if(ActivityHook != NULL)
+	{
+		ActivityHook(Last_State, Next_State, Next_State_SysTime, Now);
+	}
+
+	/* Account the connection event that just took place */
+	if(RADIOSCHED_IS_CONN_EVENT(Last_State))
+	{
+		Stats.Conn_Events++;
+		if(Refill_Result == RADIOSCHED_REFILL_FULL)
+		{
+			Stats.Conn_Events_Full++;
+		}
+		else if(Refill_Result == RADIOSCHED_REFILL_PARTIAL)
+		{
+			Stats.Conn_Events_Partial++;
+		}
+		else
+		{
+			Stats.Conn_Events_Empty++;
+		}
+	}
+	Refill_Result = RADIOSCHED_REFILL_NONE;
+	Refill_Pending = (RefillFunc != NULL) && RADIOSCHED_IS_CONN_EVENT(Next_State);
+
+	Gap_Seq++;
+
+	if(Next_State == RADIO_STATE_IDLE)
+	{
+		Gap_Open = 1;
+		Gap_Unbounded = 1;
+		Last_Valid = 0;
+		Last_Period = 0;
+		return;
+	}
+
+	Gap_Open = 0;
+	Gap_Unbounded = 0;
+	Last_Period = RADIOSCHED_MAX_PERIOD_US;
+
+	if(Last_Valid)
+	{
+		Period_us = RADIOSCHED_SYSTIME_TO_US(Next_State_SysTime - Last_SysTime);
+		Last_Period = Period_us;
+
+		/* HSI tolerance is 1%, take 1/64 of the period off */
+		Margin_us = RADIOSCHED_ACTIVITY_US + RADIOSCHED_GUARD_US + (Period_us >> 6);
+		if(Period_us > Margin_us)
+		{
+			Gap_End = Now + Period_us - Margin_us;
+			Gap_Open = 1;
+		}
+	}
+
+	Last_SysTime = Next_State_SysTime;
+	Last_Valid = 1;
+
+} /* end aci_hal_end_of_radio_activity_event() */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,370 @@
+/**
+  **************************************************************************************************
+  * @file       : Time_Sync.c
+  * @brief      : Connection anchor time synchronization. Estimates the phase and period of the
+	*								connection anchors on the local TIM2 timebase, runs the sample producer right
+	*								before each anchor and stamps samples relative to the anchors.
+  * @author			:
+  **************************************************************************************************
+  *
+  * The end of radio activity event of each connection event is taken as an observation of its
+  * anchor, delayed by a roughly constant TIMESYNC_EVENT_LATENCY_US. The controller times announced
+  * by the events give the number of connection intervals between two observations, so skipped
+  * events (slave latency) do not break the estimate. A first order loop corrects the phase and a
+  * slower one the period, which absorbs the drift between the HSI/HSE and the BlueNRG-2 clock.
+  *
+  * The estimator functions are pure: they do not touch the hardware and can be fed synthetic
+  * anchor sequences on the host. The service part wires them to Radio_Sched.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Time_Sync.h"
+#include "Radio_Sched.h"
+#include "bluenrg1_hal_aci.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* Largest drift corrected on the period, as a right shift of the nominal period (about 3%) */
+#define TIMESYNC_PERIOD_RANGE_SHIFT			5U
+
+
+/* Private macro ---------------------------------------------------------------------------------*/
+/* One controller tick is 625/256 us */
+#define TIMESYNC_SYSTIME_TO_US(t)				((uint32_t)(((uint64_t)(t) * 625U) >> 8))
+#define TIMESYNC_IS_CONN_EVENT(s)				(((s) == RADIO_STATE_CONN_SLAVE) || ((s) == RADIO_STATE_CONN_MASTER))
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static TimeSync_Estimator_t Estimator;
+static uint8_t Active;
+
+static uint8_t Next_Valid;							/* Next_SysTime announces a connection event */
+static uint32_t Next_SysTime;
+static uint8_t Anchor_Valid;
+static uint32_t Anchor_SysTime;					/* Controller time of the last observed anchor */
+
+static TimeSync_ProducerFunc_t ProducerFunc;
+static uint32_t Producer_Lead_us;
+static uint8_t Produced_Valid;
+static uint16_t Produced_Count;					/* Last anchor the producer ran for */
+
+
+/* Private function prototypes -------------------------------------------------------------------*/
+static void TimeSync_ActivityHook(uint8_t Last_State, uint8_t Next_State, uint32_t Next_State_SysTime, uint32_t Time);
+
+
+/*************************************** Anchor estimator ****************************************/
+
+/**
+  * @brief	Reset an estimator
+	* @param	pEst: estimator
+	* @param	Period_us: nominal anchor period
+	*/
+void TimeSync_EstimatorInit(TimeSync_Estimator_t *pEst, uint32_t Period_us)
+{
+	memset(pEst, 0, sizeof(TimeSync_Estimator_t));
+	pEst->Nominal_Q8 = Period_us << 8;
+	pEst->Period_Q8 = pEst->Nominal_Q8;
+}
+
+/**
+  * @brief	Feed an anchor observation
+	* @param	pEst: estimator
+	* @param	Time: local time the connection event was reported at
+	* @param	Anchors: connection intervals since the previous observation (ignored for the first one)
+	*/
+void TimeSync_EstimatorUpdate(TimeSync_Estimator_t *pEst, uint32_t Time, uint32_t Anchors)
+{
+	uint32_t Observed = Time - TIMESYNC_EVENT_LATENCY_US;
+	uint32_t Range;
+	int32_t Error, Step;
+
+	if(!pEst->Started)
+	{
+		pEst->Anchor_Q8 = (uint64_t)Observed << 8;
+		pEst->Started = 1;
+		return;
+	}
+
+	if(Anchors == 0U)
+	{
+		return;
+	}
+
+	/* Predict, then compare with the observation (modulo 2^32 like TIM2) */
+	pEst->Anchor_Q8 += (uint64_t)pEst->Period_Q8 * Anchors;
+	pEst->Anchor_Count += (uint16_t)Anchors;
+	Error = (int32_t)(Observed - (uint32_t)(pEst->Anchor_Q8 >> 8));
+	pEst->Last_Error = Error;
+
+	/* Far off (missed count, retimed clock): restart from the observation */
+	if((Error > (int32_t)(pEst->Period_Q8 >> 10)) || (Error < -(int32_t)(pEst->Period_Q8 >> 10)))
+	{
+		pEst->Anchor_Q8 = (uint64_t)Observed << 8;
+		pEst->Lock_Count = 0;
+		return;
+	}
+
+	if(Error > TIMESYNC_ERROR_CLIP_US)
+	{
+		Error = TIMESYNC_ERROR_CLIP_US;
+	}
+	else if(Error < -TIMESYNC_ERROR_CLIP_US)
+	{
+		Error = -TIMESYNC_ERROR_CLIP_US;
+	}
+
+	/* Phase correction */
+	pEst->Anchor_Q8 += (uint64_t)(int64_t)((Error * 256) >> TIMESYNC_PHASE_SHIFT);
+
+	/* Period correction, spread over the intervals the error built up in */
+	Step = ((Error * 256) >> TIMESYNC_PERIOD_SHIFT) / (int32_t)Anchors;
+	pEst->Period_Q8 = (uint32_t)((int32_t)pEst->Period_Q8 + Step);
+	Range = pEst->Nominal_Q8 >> TIMESYNC_PERIOD_RANGE_SHIFT;
+	if(pEst->Period_Q8 > (pEst->Nominal_Q8 + Range))
+	{
+		pEst->Period_Q8 = pEst->Nominal_Q8 + Range;
+	}
+	else if(pEst->Period_Q8 < (pEst->Nominal_Q8 - Range))
+	{
+		pEst->Period_Q8 = pEst->Nominal_Q8 - Range;
+	}
+
+	if((Error < TIMESYNC_LOCK_ERROR_US) && (Error > -TIMESYNC_LOCK_ERROR_US))
+	{
+		if(pEst->Lock_Count < TIMESYNC_LOCK_COUNT)
+		{
+			pEst->Lock_Count++;
+		}
+	}
+	else
+	{
+		pEst->Lock_Count = 0;
+	}
+}
+
+/**
+  * @brief	Check whether the estimate can be relied on
+	* @retval	1 after TIMESYNC_LOCK_COUNT consecutive small errors
+	*/
+uint8_t TimeSync_EstimatorLocked(const TimeSync_Estimator_t *pEst)
+{
+	return (pEst->Started && (pEst->Lock_Count >= TIMESYNC_LOCK_COUNT)) ? 1U : 0U;
+}
+
+/**
+  * @brief	First anchor after a given time
+	* @param	pEst: estimator
+	* @param	Time: local time
+	* @param	pAnchor_Count: receives the count of that anchor, may be NULL
+	* @retval	Local time of the anchor
+	*/
+uint32_t TimeSync_EstimatorNextAnchor(const TimeSync_Estimator_t *pEst, uint32_t Time, uint16_t *pAnchor_Count)
+{
+	int32_t Elapsed = (int32_t)(Time - (uint32_t)(pEst->Anchor_Q8 >> 8));
+	uint32_t k = 0;
+
+	if(Elapsed >= 0)
+	{
+		k = (uint32_t)(((uint64_t)Elapsed << 8) / pEst->Period_Q8) + 1U;
+	}
+
+	if(pAnchor_Count != NULL)
+	{
+		*pAnchor_Count = (uint16_t)(pEst->Anchor_Count + k);
+	}
+
+	return (uint32_t)((pEst->Anchor_Q8 + (uint64_t)pEst->Period_Q8 * k) >> 8);
+}
+
+/**
+  * @brief	Express a local time relative to the anchor at or before it
+	* @param	pEst: estimator
+	* @param	Time: local time of the sample
+	* @param	pStamp: receives the anchor count and the offset from it, in [0, period)
+	*/
+void TimeSync_EstimatorStamp(const TimeSync_Estimator_t *pEst, uint32_t Time, TimeSync_Stamp_t *pStamp)
+{
+	int32_t Elapsed = (int32_t)(Time - (uint32_t)(pEst->Anchor_Q8 >> 8));
+	uint64_t Elapsed_Q8;
+	uint32_t k;
+
+	if(Elapsed >= 0)
+	{
+		k = (uint32_t)(((uint64_t)Elapsed << 8) / pEst->Period_Q8);
+		pStamp->Anchor_Count = (uint16_t)(pEst->Anchor_Count + k);
+		Elapsed_Q8 = ((uint64_t)Elapsed << 8) - (uint64_t)pEst->Period_Q8 * k;
+	}
+	else
+	{
+		/* Sample taken before the last observed anchor */
+		k = (uint32_t)((((uint64_t)(-(int64_t)Elapsed) << 8) + pEst->Period_Q8 - 1U) / pEst->Period_Q8);
+		pStamp->Anchor_Count = (uint16_t)(pEst->Anchor_Count - k);
+		Elapsed_Q8 = (uint64_t)pEst->Period_Q8 * k - ((uint64_t)(-(int64_t)Elapsed) << 8);
+	}
+
+	pStamp->Offset_us = (int32_t)(Elapsed_Q8 >> 8);
+}
+
+
+/*************************************** Time sync service ***************************************/
+
+/**
+  * @brief	Attach to the radio activity events
+	* @note		To be called after RadioSched_Init(), which removes the hook
+	*/
+void TimeSync_Init(void)
+{
+	Active = 0;
+	ProducerFunc = NULL;
+	Producer_Lead_us = 0;
+	RadioSched_SetActivityHook(TimeSync_ActivityHook);
+}
+
+/**
+  * @brief	Start tracking the anchors of a new connection
+	* @param	Conn_Interval: connection interval, N * 1.25 ms
+	* @note		The anchor period reported by the controller is preferred when available
+	*/
+void TimeSync_Start(uint16_t Conn_Interval)
+{
+	uint32_t Anchor_Period = 0, Max_Free_Slot;
+	uint32_t Period_us = (uint32_t)Conn_Interval * 1250U;
+
+	if((aci_hal_get_anchor_period(&Anchor_Period, &Max_Free_Slot) == BLE_STATUS_SUCCESS) && (Anchor_Period != 0U))
+	{
+		Period_us = Anchor_Period * 625U;
+	}
+
+	TimeSync_EstimatorInit(&Estimator, Period_us);
+	Next_Valid = 0;
+	Anchor_Valid = 0;
+	Produced_Valid = 0;
+	Active = (Period_us != 0U) ? 1U : 0U;
+}
+
+/**
+  * @brief	Stop tracking, e.g. on disconnection
+	*/
+void TimeSync_Stop(void)
+{
+	Active = 0;
+}
+
+/**
+  * @brief	Register the function sampling and queuing the data of each connection event
+	* @param	Producer: called once per anchor, NULL to remove
+	* @param	Lead_us: how long before the anchor it is called. Must cover the producer run time
+	*					plus RADIOSCHED_REFILL_LEAD_US so the data is queued by the refill of that event.
+	*/
+void TimeSync_SetProducer(TimeSync_ProducerFunc_t Producer, uint32_t Lead_us)
+{
+	ProducerFunc = Producer;
+	Producer_Lead_us = Lead_us;
+	Produced_Valid = 0;
+}
+
+/**
+  * @brief	Call the producer when the next anchor is within its lead time
+	* @note		To be called from the main loop. Nothing is produced until the estimate is locked.
+	*/
+void TimeSync_Process(void)
+{
+	uint32_t Now, Next;
+	uint16_t Count;
+
+	if(!Active || (ProducerFunc == NULL) || !TimeSync_EstimatorLocked(&Estimator))
+	{
+		return;
+	}
+
+	Now = RadioSched_GetTime();
+	Next = TimeSync_EstimatorNextAnchor(&Estimator, Now, &Count);
+
+	if(Produced_Valid && (Count == Produced_Count))
+	{
+		return;
+	}
+
+	if((int32_t)(Next - Now) <= (int32_t)Producer_Lead_us)
+	{
+		Produced_Valid = 1;
+		Produced_Count = Count;
+		ProducerFunc(Count);
+	}
+}
+
+/**
+  * @brief	Stamp a sample relative to the connection anchors
+	* @param	Time: local time the sample was taken at (RadioSched_GetTime())
+	* @param	pStamp: receives the anchor count and the offset from it
+	* @retval	TIMESYNC_ERROR_NOT_LOCKED while the estimate cannot be relied on
+	*/
+TimeSync_Status_t TimeSync_Stamp(uint32_t Time, TimeSync_Stamp_t *pStamp)
+{
+	if(pStamp == NULL)
+	{
+		return TIMESYNC_ERROR_PARAM;
+	}
+
+	if(!Active || !TimeSync_EstimatorLocked(&Estimator))
+	{
+		return TIMESYNC_ERROR_NOT_LOCKED;
+	}
+
+	TimeSync_EstimatorStamp(&Estimator, Time, pStamp);
+
+	return TIMESYNC_OK;
+}
+
+/**
+  * @brief	Current anchor estimate
+	*/
+const TimeSync_Estimator_t *TimeSync_GetEstimator(void)
+{
+	return &Estimator;
+}
+
+/**
+  * @brief	Radio activity hook, feeds the end of each connection event to the estimator
+	* @param	Last_State: activity that just ended
+	* @param	Next_State: next activity
+	* @param	Next_State_SysTime: controller time of the next activity
+	* @param	Time: local time the event was received at
+	*/
+static void TimeSync_ActivityHook(uint8_t Last_State, uint8_t Next_State, uint32_t Next_State_SysTime, uint32_t Time)
+{
+	uint32_t Delta_us, Period_us, Anchors;
+
+	if(!Active)
+	{
+		return;
+	}
+
+	/* The connection event that ended is the one announced by the previous event */
+	if(TIMESYNC_IS_CONN_EVENT(Last_State) && Next_Valid)
+	{
+		Anchors = 0;
+		if(Anchor_Valid)
+		{
+			Delta_us = TIMESYNC_SYSTIME_TO_US(Next_SysTime - Anchor_SysTime);
+			Period_us = Estimator.Nominal_Q8 >> 8;
+			Anchors = (Delta_us + (Period_us >> 1)) / Period_us;
+		}
+
+		if(!Anchor_Valid || (Anchors != 0U))
+		{
+			TimeSync_EstimatorUpdate(&Estimator, Time, Anchors);
+			Anchor_SysTime = Next_SysTime;
+			Anchor_Valid = 1;
+		}
+	}
+
+	Next_Valid = TIMESYNC_IS_CONN_EVENT(Next_State) ? 1U : 0U;
+	Next_SysTime = Next_State_SysTime;
+}
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,63 @@
+/**
+  **************************************************************************************************
+  * @file       : Updater_Port.c
+  * @brief      : Hooks of the BlueNRG-2 updater (bluenrg_utils.c) for this board. The progress of an
+	*								update is kept in the key-value store and the CRCs are computed by the CRC unit.
+  * @author			:
+  **************************************************************************************************
+  *
+  * program_device() saves the size of the image and the sectors verified so far after each
+  * sector. After a reset, a new call with the same image reads them back from
+  * KVSTORE_KEY_FW_UPDATE and resumes once the updater confirmed the CRC of those sectors.
+  *
+  * The CRC unit is configured by MX_CRC_Init() with its reset values, which is the CRC-32 the
+  * updater expects apart from the initial value; bluenrg_utils.c makes up for that one.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include "main.h"
+#include "KV_Store.h"
+#include "bluenrg_utils.h"
+
+
+/* External variables ----------------------------------------------------------------------------*/
+extern CRC_HandleTypeDef hcrc;
+
+
+/* Functions -------------------------------------------------------------------------------------*/
+int updater_progress_load(updater_progress_t *progress)
+{
+	uint16_t Length = sizeof(*progress);
+
+	if((KVStore_Read(KVSTORE_KEY_FW_UPDATE, progress, &Length) != KVSTORE_OK) || (Length != sizeof(*progress)))
+	{
+		return -1;
+	}
+	return 0;
+}
+
+/**
+  * @note		A failed write only costs the sectors programmed since the last one saved
+  */
+void updater_progress_save(const updater_progress_t *progress)
+{
+	(void)KVStore_Write(KVSTORE_KEY_FW_UPDATE, progress, sizeof(*progress));
+}
+
+void updater_progress_clear(void)
+{
+	(void)KVStore_Delete(KVSTORE_KEY_FW_UPDATE);
+}
+
+uint32_t updater_crc_calc(const uint32_t *words, uint32_t count, uint8_t restart)
+{
+	if(restart)
+	{
+		return HAL_CRC_Calculate(&hcrc, (uint32_t *)words, count);
+	}
+	return HAL_CRC_Accumulate(&hcrc, (uint32_t *)words, count);
+}
+
+
+/******************************************* END OF FILE *******************************************/
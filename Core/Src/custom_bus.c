@@ -61,9 +61,7 @@ static uint32_t SPI1InitCounter = 0;
 
 static void SPI1_MspInit(SPI_HandleTypeDef* hSPI);
 static void SPI1_MspDeInit(SPI_HandleTypeDef* hSPI);
-#if (USE_CUBEMX_BSP_V2 == 1)
 static uint32_t SPI_GetPrescaler( uint32_t clk_src_hz, uint32_t baudrate_mbps );
-#endif
 
 /**
   * @}
@@ -251,6 +249,50 @@ int32_t BSP_SPI1_RegisterMspCallbacks (BSP_SPI_Cb_t *Callbacks)
 }
 #endif /* USE_HAL_SPI_REGISTER_CALLBACKS */
 
+/**
+  * @brief  Compute the SPI1 prescaler giving the highest baud rate not above
+  *         BUS_SPI1_BAUDRATE.
+  * @param  clock_src_hz : SPI1 source clock (PCLK2) in Hz.
+  * @retval SPI_BAUDRATEPRESCALER_x value
+  */
+uint32_t BSP_SPI1_GetPrescaler(uint32_t clock_src_hz)
+{
+  return SPI_GetPrescaler(clock_src_hz, BUS_SPI1_BAUDRATE);
+}
+
+/**
+  * @brief  Apply a new SPI1 prescaler, e.g. after the system clock changed.
+  *         The current transfer, if any, is allowed to complete first.
+  * @param  prescaler : SPI_BAUDRATEPRESCALER_x value
+  * @retval BSP status
+  */
+int32_t BSP_SPI1_SetPrescaler(uint32_t prescaler)
+{
+  uint32_t tickstart = HAL_GetTick();
+
+  hspi1.Init.BaudRatePrescaler = prescaler;
+
+  /* Not initialized yet: MX_SPI1_Init() will use the new value */
+  if (HAL_SPI_GetState(&hspi1) == HAL_SPI_STATE_RESET)
+  {
+    return BSP_ERROR_NONE;
+  }
+
+  while (__HAL_SPI_GET_FLAG(&hspi1, SPI_FLAG_BSY) != RESET)
+  {
+    if ((HAL_GetTick() - tickstart) > BUS_SPI1_POLL_TIMEOUT)
+    {
+      return BSP_ERROR_BUSY;
+    }
+  }
+
+  /* BR can only be changed while the SPI is disabled, the HAL enables it again on the next transfer */
+  __HAL_SPI_DISABLE(&hspi1);
+  MODIFY_REG(hspi1.Instance->CR1, SPI_CR1_BR, prescaler);
+
+  return BSP_ERROR_NONE;
+}
+
 /**
   * @brief  Return system tick in ms
   * @retval Current HAL time base time stamp
@@ -271,7 +313,7 @@ __weak HAL_StatusTypeDef MX_SPI1_Init(SPI_HandleTypeDef* hspi)
   hspi->Init.CLKPolarity = SPI_POLARITY_LOW;
   hspi->Init.CLKPhase = SPI_PHASE_2EDGE;
   hspi->Init.NSS = SPI_NSS_SOFT;
-  hspi->Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_128;
+  hspi->Init.BaudRatePrescaler = SPI_GetPrescaler(HAL_RCC_GetPCLK2Freq(), BUS_SPI1_BAUDRATE);
   hspi->Init.FirstBit = SPI_FIRSTBIT_MSB;
   hspi->Init.TIMode = SPI_TIMODE_DISABLE;
   hspi->Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
@@ -350,7 +392,6 @@ static void SPI1_MspDeInit(SPI_HandleTypeDef* spiHandle)
   /* USER CODE END SPI1_MspDeInit 1 */
 }
 
-#if (USE_CUBEMX_BSP_V2 == 1)
 /**
   * @brief  Convert the SPI baudrate into prescaler.
   * @param  clock_src_hz : SPI source clock in HZ.
@@ -386,7 +427,6 @@ static uint32_t SPI_GetPrescaler( uint32_t clock_src_hz, uint32_t baudrate_mbps
 
   return presc;
 }
-#endif
 /**
   * @}
   */
@@ -20,6 +20,8 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "BLE_Process.h"
+#include "KV_Store.h"
+#include "Clock_Profile.h"
 
 
 /* Private includes ----------------------------------------------------------*/
@@ -35,6 +37,8 @@
 
 
 /* Private variables ---------------------------------------------------------*/
+CRC_HandleTypeDef hcrc;
+
 TIM_HandleTypeDef htim2;
 TIM_HandleTypeDef htim4;
 
@@ -46,6 +50,7 @@ char pText[TEXTSIZE] = "STM32F411RE Nucleo Board and BlueNRG-2\r\n";
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
+static void MX_CRC_Init(void);
 static void MX_TIM2_Init(void);
 static void MX_TIM4_Init(void);
 static void MX_USART1_UART_Init(void);
@@ -77,15 +82,31 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_CRC_Init();
   MX_TIM2_Init();
   MX_TIM4_Init();
   MX_USART1_UART_Init();
 	
+  /* Leave the reset configuration for the profile giving the fastest valid SPI link */
+	if(ClockProfile_Set(CLOCK_PROFILE_BLE_STREAMING) != CLOCKPROFILE_OK)
+	{
+		Error_Handler();
+	}
+	
+  /* TIM2 free-runs as the microsecond timebase of the radio scheduler */
+	HAL_TIM_Base_Start(&htim2);
+	
 	HAL_UART_Transmit(&huart1, (uint8_t*)pText, TEXTSIZE, UART_TIMEOUT);
 	(void)strncpy(pText, "Intro to Bluetooth Low Energy\r\n", TEXTSIZE);
 	HAL_UART_Transmit(&huart1, (uint8_t*)pText, TEXTSIZE, UART_TIMEOUT);
 	printf("Keil Terminal Printout test\n");
 	
+  /* Mount the flash key-value store holding the device identity and settings */
+	if(KVStore_Init() != KVSTORE_OK)
+	{
+		Error_Handler();
+	}
+	
   /* Bluetooth Module Initialization. Place in advertising mode at startup
      to allow establishing connections with central device	*/
 	BlueNRG_Init();
@@ -146,6 +167,32 @@ void SystemClock_Config(void)
   }
 }
 
+/**
+  * @brief CRC Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_CRC_Init(void)
+{
+
+  /* USER CODE BEGIN CRC_Init 0 */
+
+  /* USER CODE END CRC_Init 0 */
+
+  /* USER CODE BEGIN CRC_Init 1 */
+
+  /* USER CODE END CRC_Init 1 */
+  hcrc.Instance = CRC;
+  if (HAL_CRC_Init(&hcrc) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* USER CODE BEGIN CRC_Init 2 */
+
+  /* USER CODE END CRC_Init 2 */
+
+}
+
 /**
   * @brief TIM2 Initialization Function
   * @param None
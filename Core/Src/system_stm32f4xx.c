@@ -90,8 +90,13 @@
 /*!< Uncomment the following line if you need to relocate your vector Table in
      Internal SRAM. */
 /* #define VECT_TAB_SRAM */
-#define VECT_TAB_OFFSET  0x00 /*!< Vector Table base offset field. 
-                                   This value must be a multiple of 0x200. */
+#if !defined(VECT_TAB_OFFSET)
+#define VECT_TAB_OFFSET  0x10000 /*!< Vector Table base offset field. 
+                                   This value must be a multiple of 0x200.
+                                   The application starts after the bootloader
+                                   and the key-value store (see Ota_Image.h).
+                                   The F411RE_Bootloader target defines it to 0. */
+#endif /* VECT_TAB_OFFSET */
 /******************************************************************************/
 
 /**
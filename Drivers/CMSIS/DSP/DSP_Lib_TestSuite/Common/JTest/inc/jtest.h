@@ -13,5 +13,6 @@
 #include "jtest_group_define.h"
 #include "jtest_group_call.h"
 #include "jtest_cycle.h"
+#include "jtest_bench.h"
 
 #endif /* _JTEST_H_ */
@@ -0,0 +1,96 @@
+#ifndef _JTEST_BENCH_H_
+#define _JTEST_BENCH_H_
+
+/*--------------------------------------------------------------------------------*/
+/* Includes */
+/*--------------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "jtest_fw.h"           /* JTEST_DUMP_DATAF() */
+
+/*--------------------------------------------------------------------------------*/
+/* Declare Module Variables */
+/*--------------------------------------------------------------------------------*/
+extern const char * JTEST_BENCH_CSV_HEADER;
+extern const char * JTEST_BENCH_CSV_STRF;
+extern const char * JTEST_BENCH_UNIT;
+
+/*--------------------------------------------------------------------------------*/
+/* Macros and Defines */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  Runs of each measurement, the fastest one is reported. The first run also
+ *  warms the caches and the branch predictors of the host.
+ */
+#ifndef JTEST_BENCH_REPEAT
+#define JTEST_BENCH_REPEAT 8
+#endif
+
+/**
+ *  Time fn_call and dump one CSV row to the data channel: the fastest of
+ *  #JTEST_BENCH_REPEAT runs, in cycles (DWT, or SysTick on cores without it)
+ *  or in ns on a host, per call and per sample.
+ *
+ *  setup runs before each call and is not timed, e.g. to restore the input of
+ *  an in-place transform.
+ *
+ *  @param kernel  Name of the kernel, a string.
+ *  @param size    Block size, transform length or matrix dimension.
+ *  @param param   Second swept value (taps, stages...), 0 if none.
+ *  @param samples Samples produced by one call.
+ */
+#define JTEST_BENCH_SETUP(kernel, size, param, samples, setup, fn_call) \
+    do                                                                  \
+    {                                                                   \
+        uint32_t __jtest_bench_run;                                     \
+        uint32_t __jtest_bench_start;                                   \
+        uint32_t __jtest_bench_time;                                    \
+        uint32_t __jtest_bench_best = UINT32_MAX;                       \
+                                                                        \
+        for (__jtest_bench_run = 0;                                     \
+             __jtest_bench_run < JTEST_BENCH_REPEAT;                    \
+             ++__jtest_bench_run)                                       \
+        {                                                               \
+            setup;                                                      \
+                                                                        \
+            __jtest_bench_start = jtest_bench_now();                    \
+            fn_call;                                                    \
+            __jtest_bench_time =                                        \
+                jtest_bench_elapsed(__jtest_bench_start);               \
+                                                                        \
+            if (__jtest_bench_time < __jtest_bench_best)                \
+            {                                                           \
+                __jtest_bench_best = __jtest_bench_time;                \
+            }                                                           \
+        }                                                               \
+                                                                        \
+        jtest_bench_report((kernel), (size), (param), (samples),        \
+                           __jtest_bench_best);                         \
+    } while (0)
+
+/**
+ *  #JTEST_BENCH_SETUP() without setup.
+ */
+#define JTEST_BENCH(kernel, size, param, samples, fn_call)              \
+    JTEST_BENCH_SETUP(kernel, size, param, samples, (void)0, fn_call)
+
+/**
+ *  Dump the CSV header to the data channel.
+ */
+#define JTEST_BENCH_DUMP_HEADER()                                       \
+    JTEST_DUMP_DATAF("%s", JTEST_BENCH_CSV_HEADER)
+
+/*--------------------------------------------------------------------------------*/
+/* Function Prototypes */
+/*--------------------------------------------------------------------------------*/
+void jtest_bench_init(void);
+uint32_t jtest_bench_now(void);
+uint32_t jtest_bench_elapsed(uint32_t start);
+void jtest_bench_report(const char * kernel,
+                        uint32_t size,
+                        uint32_t param,
+                        uint32_t samples,
+                        uint32_t time);
+
+#endif /* _JTEST_BENCH_H_ */
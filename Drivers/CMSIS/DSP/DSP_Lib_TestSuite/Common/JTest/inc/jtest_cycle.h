@@ -7,6 +7,7 @@
 
 #include "jtest_fw.h"           /* JTEST_DUMP_STRF() */
 #include "jtest_systick.h"
+#include "jtest_bench.h"        /* jtest_bench_now() */
 #include "jtest_util.h"         /* STR() */
 
 /*--------------------------------------------------------------------------------*/
@@ -43,6 +44,20 @@ extern const char * JTEST_CYCLE_STRF;
                          __jtest_cycle_end_count));     \
     } while (0)
 */
+#if defined(ARM_MATH_HOST_X86)
+#define JTEST_COUNT_CYCLES(fn_call)                     \
+    do                                                  \
+    {                                                   \
+        uint32_t __jtest_cycle_start_count =            \
+            jtest_bench_now();                          \
+                                                        \
+        fn_call;                                        \
+                                                        \
+        JTEST_DUMP_STRF(JTEST_CYCLE_STRF,               \
+                        jtest_bench_elapsed(            \
+                            __jtest_cycle_start_count)); \
+    } while (0)
+#else
 #define JTEST_COUNT_CYCLES(fn_call)                     \
     do                                                  \
     {                                                   \
@@ -61,5 +76,6 @@ extern const char * JTEST_CYCLE_STRF;
                         (JTEST_SYSTICK_INITIAL_VALUE -  \
                          __jtest_cycle_end_count));     \
     } while (0)
+#endif
 
 #endif /* _JTEST_CYCLE_H_ */
@@ -68,6 +68,16 @@ typedef struct JTEST_FW_struct
 #define JTEST_FW_STR_BUFFER JTEST_FW_STR_BUFFER
 #endif
 
+/**
+ *  Default name for the JTEST_FW_DATA_BUFFER.
+ *
+ *  Define your own if you want the variable containing the char buffer to have
+ *  a different name.
+ */
+#ifndef JTEST_FW_DATA_BUFFER
+#define JTEST_FW_DATA_BUFFER JTEST_FW_DATA_BUFFER
+#endif
+
 /**
  *  Size of the #JTEST_FW_t, output string-buffer.
  *
@@ -97,6 +107,7 @@ typedef struct JTEST_FW_struct
     do                                                                  \
     {                                                                   \
         JTEST_FW.str_buffer = JTEST_FW_STR_BUFFER;                      \
+        JTEST_FW.data_buffer = JTEST_FW_DATA_BUFFER;                    \
     } while (0)
 
 /* Debugger Action-triggering Macros */
@@ -200,6 +211,22 @@ typedef struct JTEST_FW_struct
         jtest_dump_str_segments();                                      \
     } while (0)
 
+/**
+ *  Dump a formatted line of data to the Keil Debugger.
+ *
+ *  Kept apart from the strings, so that results like the benchmark tables can
+ *  be collected without the test log. The line must fit in
+ *  #JTEST_STR_MAX_OUTPUT_SIZE characters.
+ */
+#define JTEST_DUMP_DATAF(format_str, ... )                              \
+    do                                                                  \
+    {                                                                   \
+        JTEST_CLEAR_DATA_BUFFER();                                      \
+        snprintf(JTEST_FW.data_buffer, JTEST_STR_MAX_OUTPUT_SIZE,       \
+                 format_str, __VA_ARGS__);                              \
+        JTEST_TRIGGER_ACTION(dump_data);                                \
+    } while (0)
+
 /* Pass/Fail Macros */
 /*--------------------------------------------------------------------------------*/
 
@@ -234,6 +261,7 @@ typedef struct JTEST_FW_struct
 /* Declare Global Variables */
 /*--------------------------------------------------------------------------------*/
 extern char JTEST_FW_STR_BUFFER[JTEST_BUF_SIZE];
+extern char JTEST_FW_DATA_BUFFER[JTEST_BUF_SIZE];
 extern volatile JTEST_FW_t JTEST_FW;
 
 /*--------------------------------------------------------------------------------*/
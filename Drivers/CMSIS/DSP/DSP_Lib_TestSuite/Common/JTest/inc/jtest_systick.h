@@ -40,6 +40,8 @@
   #include "ARMv8MML_DP.h"
 #elif defined ARMv8MML_DSP_DP
   #include "ARMv8MML_DSP_DP.h"
+#elif defined ARM_MATH_HOST_X86
+  /* No SysTick, cycles are counted as ns (jtest_bench.h) */
 
 #else
   #warning "no appropriate header file found!"
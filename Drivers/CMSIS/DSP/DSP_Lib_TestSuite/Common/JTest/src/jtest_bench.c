@@ -0,0 +1,151 @@
+#if defined(ARM_MATH_HOST_X86)
+#define _POSIX_C_SOURCE 199309L /* clock_gettime() */
+#include <time.h>
+#endif
+
+#include "arm_math.h"           /* Core and vector extension in use */
+#include "../inc/jtest_bench.h"
+#include <inttypes.h>
+
+#if !defined(ARM_MATH_HOST_X86)
+#include "../inc/jtest_systick.h"
+#endif
+
+/*--------------------------------------------------------------------------------*/
+/* Define Module Variables */
+/*--------------------------------------------------------------------------------*/
+
+const char * JTEST_BENCH_CSV_HEADER =
+    "core,kernel,size,param,samples,unit,per_call,per_sample\n";
+
+const char * JTEST_BENCH_CSV_STRF =
+    "%s,%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%s,%" PRIu32 ",%" PRIu32 ".%02" PRIu32 "\n";
+
+#if defined(ARM_MATH_HOST_X86)
+const char * JTEST_BENCH_UNIT = "ns";
+#else
+const char * JTEST_BENCH_UNIT = "cycles";
+#endif
+
+/* Name of the core in the rows, set by jtest_bench_init() */
+static char jtest_bench_core[16] = "unknown";
+
+/* Time of an empty measurement, taken off every result */
+static uint32_t jtest_bench_overhead = 0;
+
+/*--------------------------------------------------------------------------------*/
+/* Timer */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  Start the time base and measure its overhead.
+ *
+ *  On Cortex-M3/M4/M7/M33 the DWT cycle counter is used. Cortex-M0/M0+/M23
+ *  have none and use the SysTick, results are then limited to 2^24 cycles.
+ */
+void jtest_bench_init(void)
+{
+    uint32_t run;
+    uint32_t start;
+    uint32_t time;
+
+#if defined(ARM_MATH_HOST_X86)
+#if defined(ARM_MATH_AVX2)
+    strcpy(jtest_bench_core, "x86-avx2");
+#elif defined(ARM_MATH_SSE4)
+    strcpy(jtest_bench_core, "x86-sse4");
+#else
+    strcpy(jtest_bench_core, "x86");
+#endif
+#else
+    sprintf(jtest_bench_core, "cortex-m%u", (unsigned int) __CORTEX_M);
+
+#if defined(DWT)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#else
+    JTEST_SYSTICK_RESET(SysTick);
+    JTEST_SYSTICK_START(SysTick);
+#endif
+#endif
+
+    jtest_bench_overhead = UINT32_MAX;
+    for (run = 0; run < JTEST_BENCH_REPEAT; ++run)
+    {
+        start = jtest_bench_now();
+        time = jtest_bench_elapsed(start);
+
+        if (time < jtest_bench_overhead)
+        {
+            jtest_bench_overhead = time;
+        }
+    }
+}
+
+/**
+ *  Current value of the time base, cycles or ns.
+ */
+uint32_t jtest_bench_now(void)
+{
+#if defined(ARM_MATH_HOST_X86)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t) (((uint64_t) ts.tv_sec * 1000000000U) + (uint64_t) ts.tv_nsec);
+#elif defined(DWT)
+    return DWT->CYCCNT;
+#else
+    /* The SysTick counts down */
+    return JTEST_SYSTICK_INITIAL_VALUE - JTEST_SYSTICK_VALUE(SysTick);
+#endif
+}
+
+/**
+ *  Time since start, without the overhead of the measurement.
+ */
+uint32_t jtest_bench_elapsed(uint32_t start)
+{
+    uint32_t time = jtest_bench_now() - start;
+
+#if !defined(ARM_MATH_HOST_X86) && !defined(DWT)
+    time &= JTEST_SYSTICK_INITIAL_VALUE;
+#endif
+
+    return (time > jtest_bench_overhead) ? (time - jtest_bench_overhead) : 0;
+}
+
+/*--------------------------------------------------------------------------------*/
+/* Report */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  Dump a CSV row, the time per sample with two decimals, without a
+ *  floating-point printf.
+ */
+void jtest_bench_report(const char * kernel,
+                        uint32_t size,
+                        uint32_t param,
+                        uint32_t samples,
+                        uint32_t time)
+{
+    uint64_t per_sample;
+
+    if (samples == 0)
+    {
+        samples = 1;
+    }
+
+    per_sample = (((uint64_t) time * 100U) + (samples / 2U)) / samples;
+
+    JTEST_DUMP_DATAF(JTEST_BENCH_CSV_STRF,
+                     jtest_bench_core,
+                     kernel,
+                     size,
+                     param,
+                     samples,
+                     JTEST_BENCH_UNIT,
+                     time,
+                     (uint32_t) (per_sample / 100U),
+                     (uint32_t) (per_sample % 100U));
+}
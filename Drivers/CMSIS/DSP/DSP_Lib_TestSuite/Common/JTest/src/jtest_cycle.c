@@ -6,4 +6,8 @@
 /*--------------------------------------------------------------------------------*/
 
 /* const char * JTEST_CYCLE_STRF = "Running: %s\nCycles: %" PRIu32 "\n"; */
+#if defined(ARM_MATH_HOST_X86)
+const char * JTEST_CYCLE_STRF = "Time: %" PRIu32 " ns\n";
+#else
 const char * JTEST_CYCLE_STRF = "Cycles: %" PRIu32 "\n"; /* function name + parameter string skipped */
+#endif
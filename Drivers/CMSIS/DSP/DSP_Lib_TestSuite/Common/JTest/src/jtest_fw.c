@@ -5,5 +5,6 @@
 /*--------------------------------------------------------------------------------*/
 
 char JTEST_FW_STR_BUFFER[JTEST_BUF_SIZE] = {0};
+char JTEST_FW_DATA_BUFFER[JTEST_BUF_SIZE] = {0};
 
 volatile JTEST_FW_t JTEST_FW = {0};
@@ -1,6 +1,10 @@
 
 #include "jtest_fw.h"
 
+#if defined(ARM_MATH_HOST_X86)
+#include <stdlib.h>             /* exit() */
+#endif
+
 void test_start    (void) {
 //  ;
   JTEST_FW.test_start++;
@@ -24,14 +28,25 @@ void group_end     (void) {
 void dump_str      (void) {
 //  ;
   JTEST_FW.dump_str++;
+#if defined(ARM_MATH_HOST_X86)
+  /* No debugger on a host, the log goes to stderr */
+  fprintf(stderr, "%.*s", JTEST_STR_MAX_OUTPUT_SIZE, JTEST_FW.str_buffer);
+#endif
 }
 
 void dump_data     (void) {
 //  ;
   JTEST_FW.dump_data++;
+#if defined(ARM_MATH_HOST_X86)
+  /* and the data to stdout */
+  fputs(JTEST_FW.data_buffer, stdout);
+#endif
 }
 
 void exit_fw       (void) {
 //  ;
   JTEST_FW.exit_fw++;
+#if defined(ARM_MATH_HOST_X86)
+  exit((JTEST_FW.failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+#endif
 }
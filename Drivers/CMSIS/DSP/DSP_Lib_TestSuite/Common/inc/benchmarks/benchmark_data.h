@@ -0,0 +1,112 @@
+#ifndef _BENCHMARK_DATA_H_
+#define _BENCHMARK_DATA_H_
+
+/*--------------------------------------------------------------------------------*/
+/* Includes */
+/*--------------------------------------------------------------------------------*/
+
+#include "arr_desc.h"
+#include "arm_math.h"
+
+/*--------------------------------------------------------------------------------*/
+/* Macros and Defines */
+/*--------------------------------------------------------------------------------*/
+
+#define BENCHMARK_MAX_BLOCKSIZE  1024
+#define BENCHMARK_MAX_NUMTAPS    128
+#define BENCHMARK_MAX_NUMSTAGES  8
+#define BENCHMARK_MAX_FFT_LEN    4096
+#define BENCHMARK_MAX_MR_FFT_LEN 960
+#define BENCHMARK_MAX_MAT_DIM    32
+
+/* Long filters, FFT-based FIR against the direct form */
+#define BENCHMARK_MAX_LONG_NUMTAPS 1024
+#define BENCHMARK_LONG_BLOCKSIZE   256
+
+/* Interleaved channels of the multi-channel filters, an IMU frame */
+#define BENCHMARK_MC_NUMCHANNELS   6
+
+/* Window of the median filters, spike rejection */
+#define BENCHMARK_MEDIAN_WINDOW    9
+
+/* Every buffer holds at least a complex FFT, or two blocks, or a matrix */
+#define BENCHMARK_BUF_LEN        (BENCHMARK_MAX_FFT_LEN * 2)
+
+/* FIR states are the largest ones */
+#define BENCHMARK_STATE_LEN                                     \
+    (BENCHMARK_MAX_BLOCKSIZE + BENCHMARK_MAX_NUMTAPS)
+
+/* The buffers of each type share one union, see benchmark_buf_t */
+#define benchmark_input_q31   (benchmark_input_fixed.q31)
+#define benchmark_input_q15   (benchmark_input_fixed.q15)
+#define benchmark_input_q7    (benchmark_input_fixed.q7)
+#define benchmark_input2_q31  (benchmark_input2_fixed.q31)
+#define benchmark_input2_q15  (benchmark_input2_fixed.q15)
+#define benchmark_input2_q7   (benchmark_input2_fixed.q7)
+#define benchmark_output_f32  (benchmark_output.f32)
+#define benchmark_output_q63  (benchmark_output.q63)
+#define benchmark_output_q31  (benchmark_output.q31)
+#define benchmark_output_q15  (benchmark_output.q15)
+#define benchmark_output_q7   (benchmark_output.q7)
+#define benchmark_output2_f32 (benchmark_output2.f32)
+#define benchmark_output2_q31 (benchmark_output2.q31)
+#define benchmark_output2_q15 (benchmark_output2.q15)
+
+/* Names used by the conversions, arm_float_to_x() */
+#define benchmark_input_float  benchmark_input_f32
+#define benchmark_output_float benchmark_output_f32
+
+/*--------------------------------------------------------------------------------*/
+/* Types */
+/*--------------------------------------------------------------------------------*/
+
+/* One buffer seen as every data type, without casts between pointer types */
+typedef union
+{
+    float32_t f32[BENCHMARK_BUF_LEN];
+    q63_t     q63[BENCHMARK_BUF_LEN / 2];
+    q31_t     q31[BENCHMARK_BUF_LEN];
+    q15_t     q15[BENCHMARK_BUF_LEN * 2];
+    q7_t      q7[BENCHMARK_BUF_LEN * 4];
+} benchmark_buf_t;
+
+/*--------------------------------------------------------------------------------*/
+/* Declare Variables */
+/*--------------------------------------------------------------------------------*/
+
+/* Input/Output Buffers, filled by benchmark_fill_inputs() */
+extern float32_t benchmark_input_f32[BENCHMARK_BUF_LEN];
+extern float32_t benchmark_input2_f32[BENCHMARK_BUF_LEN];
+extern benchmark_buf_t benchmark_input_fixed;
+extern benchmark_buf_t benchmark_input2_fixed;
+extern benchmark_buf_t benchmark_output;
+extern benchmark_buf_t benchmark_output2;
+extern float32_t benchmark_state[BENCHMARK_STATE_LEN];
+
+/* FIR coefficients, low-pass */
+extern float32_t benchmark_coeffs_f32[BENCHMARK_MAX_NUMTAPS];
+extern q31_t benchmark_coeffs_q31[BENCHMARK_MAX_NUMTAPS];
+extern q15_t benchmark_coeffs_q15[BENCHMARK_MAX_NUMTAPS];
+extern q7_t benchmark_coeffs_q7[BENCHMARK_MAX_NUMTAPS];
+
+/* Biquad coefficients, stable sections. df1 q15 takes 6 per stage */
+extern float32_t benchmark_biquad_f32[BENCHMARK_MAX_NUMSTAGES * 5];
+extern q31_t benchmark_biquad_q31[BENCHMARK_MAX_NUMSTAGES * 5];
+extern q15_t benchmark_biquad_q15[BENCHMARK_MAX_NUMSTAGES * 6];
+
+/* Swept values */
+ARR_DESC_DECLARE(benchmark_blocksizes);
+ARR_DESC_DECLARE(benchmark_numtaps);
+ARR_DESC_DECLARE(benchmark_long_numtaps);
+ARR_DESC_DECLARE(benchmark_numstages);
+ARR_DESC_DECLARE(benchmark_fftlens);
+ARR_DESC_DECLARE(benchmark_rfftlens);
+ARR_DESC_DECLARE(benchmark_mr_fftlens);
+ARR_DESC_DECLARE(benchmark_matdims);
+
+/*--------------------------------------------------------------------------------*/
+/* Function Prototypes */
+/*--------------------------------------------------------------------------------*/
+void benchmark_fill_inputs(void);
+
+#endif /* _BENCHMARK_DATA_H_ */
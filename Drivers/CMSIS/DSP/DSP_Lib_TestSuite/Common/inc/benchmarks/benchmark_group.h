@@ -0,0 +1,9 @@
+#ifndef _BENCHMARK_GROUP_H_
+#define _BENCHMARK_GROUP_H_
+
+/*--------------------------------------------------------------------------------*/
+/* Declare Test Groups */
+/*--------------------------------------------------------------------------------*/
+JTEST_DECLARE_GROUP(all_benchmarks);
+
+#endif /* _BENCHMARK_GROUP_H_ */
@@ -0,0 +1,108 @@
+#ifndef _BENCHMARK_TEMPLATES_H_
+#define _BENCHMARK_TEMPLATES_H_
+
+/*--------------------------------------------------------------------------------*/
+/* Includes */
+/*--------------------------------------------------------------------------------*/
+
+#include "jtest.h"
+#include "arr_desc.h"
+#include "template.h"
+#include "benchmark_data.h"
+
+/*--------------------------------------------------------------------------------*/
+/* Sweeps */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  Run body for every block size of benchmark_blocksizes, as blockSize.
+ */
+#define BENCHMARK_DO_BLOCKSIZES(body)                                   \
+    TEMPLATE_DO_ARR_DESC(                                               \
+        blocksize_idx, uint32_t, blockSize, benchmark_blocksizes,       \
+        body)
+
+/**
+ *  Run body for every tap count of benchmark_numtaps, as numTaps.
+ */
+#define BENCHMARK_DO_NUMTAPS(body)                                      \
+    TEMPLATE_DO_ARR_DESC(                                               \
+        numtaps_idx, uint16_t, numTaps, benchmark_numtaps,              \
+        body)
+
+/**
+ *  Run body for every tap count of benchmark_long_numtaps, as numTaps.
+ */
+#define BENCHMARK_DO_LONG_NUMTAPS(body)                                 \
+    TEMPLATE_DO_ARR_DESC(                                               \
+        numtaps_idx, uint16_t, numTaps, benchmark_long_numtaps,         \
+        body)
+
+/**
+ *  Run body for every stage count of benchmark_numstages, as numStages.
+ */
+#define BENCHMARK_DO_NUMSTAGES(body)                                    \
+    TEMPLATE_DO_ARR_DESC(                                               \
+        numstages_idx, uint8_t, numStages, benchmark_numstages,         \
+        body)
+
+/**
+ *  Run body for every length of the arr_desc, as fftLen.
+ */
+#define BENCHMARK_DO_FFTLENS(arr_desc, body)                            \
+    TEMPLATE_DO_ARR_DESC(                                               \
+        fftlen_idx, uint16_t, fftLen, arr_desc,                         \
+        body)
+
+/**
+ *  Run body for every dimension of benchmark_matdims, as matDim.
+ */
+#define BENCHMARK_DO_MATDIMS(body)                                      \
+    TEMPLATE_DO_ARR_DESC(                                               \
+        matdim_idx, uint16_t, matDim, benchmark_matdims,                \
+        body)
+
+/*--------------------------------------------------------------------------------*/
+/* Benchmark Definitions */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  Name of the benchmark of a function.
+ */
+#define BENCHMARK_NAME(fn_name)                 \
+    fn_name##_benchmark
+
+/**
+ *  Benchmark of fn_name over the block sizes, arguments in the order of
+ *  the call. blockSize samples are produced.
+ */
+#define BENCHMARK_DEFINE_BLOCK(fn_name, ...)                            \
+    JTEST_DEFINE_TEST(BENCHMARK_NAME(fn_name), fn_name)                 \
+    {                                                                   \
+        BENCHMARK_DO_BLOCKSIZES(                                        \
+            JTEST_BENCH(STR(fn_name), blockSize, 0, blockSize,          \
+                        fn_name(__VA_ARGS__)));                         \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+/**
+ *  Benchmark of a function of two inputs, fn(pSrcA, pSrcB, pDst, blockSize).
+ */
+#define BENCHMARK_DEFINE_BINARY(fn_name, suffix)                        \
+    BENCHMARK_DEFINE_BLOCK(fn_name##_##suffix,                          \
+                           benchmark_input_##suffix,                    \
+                           benchmark_input2_##suffix,                   \
+                           benchmark_output_##suffix,                   \
+                           blockSize)
+
+/**
+ *  Benchmark of a function of one input, fn(pSrc, pDst, blockSize).
+ */
+#define BENCHMARK_DEFINE_UNARY(fn_name, suffix)                         \
+    BENCHMARK_DEFINE_BLOCK(fn_name##_##suffix,                          \
+                           benchmark_input_##suffix,                    \
+                           benchmark_output_##suffix,                   \
+                           blockSize)
+
+#endif /* _BENCHMARK_TEMPLATES_H_ */
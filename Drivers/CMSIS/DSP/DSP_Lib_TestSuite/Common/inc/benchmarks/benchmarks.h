@@ -0,0 +1,17 @@
+#ifndef _BENCHMARKS_H_
+#define _BENCHMARKS_H_
+
+/*--------------------------------------------------------------------------------*/
+/* Test/Group Declarations */
+/*--------------------------------------------------------------------------------*/
+JTEST_DECLARE_GROUP(basic_math_benchmarks);
+JTEST_DECLARE_GROUP(complex_math_benchmarks);
+JTEST_DECLARE_GROUP(controller_benchmarks);
+JTEST_DECLARE_GROUP(fast_math_benchmarks);
+JTEST_DECLARE_GROUP(filtering_benchmarks);
+JTEST_DECLARE_GROUP(matrix_benchmarks);
+JTEST_DECLARE_GROUP(statistics_benchmarks);
+JTEST_DECLARE_GROUP(support_benchmarks);
+JTEST_DECLARE_GROUP(transform_benchmarks);
+
+#endif /* _BENCHMARKS_H_ */
@@ -39,6 +39,60 @@
     } while (0)
 
 
+/**
+ *  Assert that every output of the function under test is within abs_tol +
+ *  rel_tol * |ref| of the reference output, and display the largest absolute
+ *  and relative errors. Equal infinities match, and so do two NaNs.
+ */
+#define FAST_MATH_ASSERT_CLOSE(ref_ptr, fut_ptr, block_size,            \
+                               abs_tol, rel_tol)                        \
+    do                                                                  \
+    {                                                                   \
+        uint32_t close_idx;                                             \
+        double close_ref, close_fut, close_err;                         \
+        double close_max_abs = 0.0;                                     \
+        double close_max_rel = 0.0;                                     \
+                                                                        \
+        for (close_idx = 0; close_idx < (block_size); close_idx++)      \
+        {                                                               \
+            close_ref = (double) (ref_ptr)[close_idx];                  \
+            close_fut = (double) (fut_ptr)[close_idx];                  \
+                                                                        \
+            if ((close_ref == close_fut) ||                             \
+                ((close_ref != close_ref) && (close_fut != close_fut))) \
+            {                                                           \
+                continue;                                               \
+            }                                                           \
+                                                                        \
+            close_err = fabs(close_fut - close_ref);                    \
+            if (!(close_err <=                                          \
+                  (abs_tol) + (rel_tol) * fabs(close_ref)))             \
+            {                                                           \
+                JTEST_DUMP_STRF("Index: %d\n"                           \
+                                "Reference: %.9g\n"                     \
+                                "Result: %.9g\n",                       \
+                                (int)close_idx,                         \
+                                close_ref,                              \
+                                close_fut);                             \
+                return JTEST_TEST_FAILED;                               \
+            }                                                           \
+                                                                        \
+            close_max_abs = (close_err > close_max_abs) ?               \
+                close_err : close_max_abs;                              \
+            if (close_ref != 0.0)                                       \
+            {                                                           \
+                close_err /= fabs(close_ref);                           \
+                close_max_rel = (close_err > close_max_rel) ?           \
+                    close_err : close_max_rel;                          \
+            }                                                           \
+        }                                                               \
+                                                                        \
+        JTEST_DUMP_STRF("Largest absolute error: %g\n"                  \
+                        "Largest relative error: %g\n",                 \
+                        close_max_abs,                                  \
+                        close_max_rel);                                 \
+    } while (0)
+
 /*--------------------------------------------------------------------------------*/
 /* TEST Templates */
 /*--------------------------------------------------------------------------------*/
@@ -99,4 +153,74 @@
             return JTEST_TEST_PASSED;                                   \
         }
 
+/**
+ *  Test template for the block functions of one input vector. The inputs are
+ *  generated by fill_fn, and an odd block size runs the loop tails.
+ */
+#define FAST_MATH_BLOCK_TEST_TEMPLATE_BUF1(suffix, func, fill_fn,       \
+                                           abs_tol, rel_tol)            \
+                                                                        \
+    JTEST_DEFINE_TEST(arm_##func##_##suffix##_test,                     \
+                      arm_##func##_##suffix)                            \
+    {                                                                   \
+        uint32_t blockSize = FAST_MATH_MAX_LEN - 1;                     \
+                                                                        \
+        fill_fn((TYPE_FROM_ABBREV(suffix) *) fast_math_block_a,         \
+                blockSize);                                             \
+                                                                        \
+        JTEST_COUNT_CYCLES(                                             \
+            arm_##func##_##suffix(                                      \
+                (TYPE_FROM_ABBREV(suffix) *) fast_math_block_a,         \
+                (TYPE_FROM_ABBREV(suffix) *) fast_math_output_fut,      \
+                blockSize));                                            \
+                                                                        \
+        ref_##func##_##suffix(                                          \
+            (TYPE_FROM_ABBREV(suffix) *) fast_math_block_a,             \
+            (TYPE_FROM_ABBREV(suffix) *) fast_math_output_ref,          \
+            blockSize);                                                 \
+                                                                        \
+        FAST_MATH_ASSERT_CLOSE(                                         \
+            (TYPE_FROM_ABBREV(suffix) *) fast_math_output_ref,          \
+            (TYPE_FROM_ABBREV(suffix) *) fast_math_output_fut,          \
+            blockSize, abs_tol, rel_tol);                               \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+/**
+ *  Test template for the block functions of two input vectors.
+ */
+#define FAST_MATH_BLOCK_TEST_TEMPLATE_BUF2(suffix, func, fill_fn,       \
+                                           abs_tol, rel_tol)            \
+                                                                        \
+    JTEST_DEFINE_TEST(arm_##func##_##suffix##_test,                     \
+                      arm_##func##_##suffix)                            \
+    {                                                                   \
+        uint32_t blockSize = FAST_MATH_MAX_LEN - 1;                     \
+                                                                        \
+        fill_fn((TYPE_FROM_ABBREV(suffix) *) fast_math_block_a,         \
+                (TYPE_FROM_ABBREV(suffix) *) fast_math_block_b,         \
+                blockSize);                                             \
+                                                                        \
+        JTEST_COUNT_CYCLES(                                             \
+            arm_##func##_##suffix(                                      \
+                (TYPE_FROM_ABBREV(suffix) *) fast_math_block_a,         \
+                (TYPE_FROM_ABBREV(suffix) *) fast_math_block_b,         \
+                (TYPE_FROM_ABBREV(suffix) *) fast_math_output_fut,      \
+                blockSize));                                            \
+                                                                        \
+        ref_##func##_##suffix(                                          \
+            (TYPE_FROM_ABBREV(suffix) *) fast_math_block_a,             \
+            (TYPE_FROM_ABBREV(suffix) *) fast_math_block_b,             \
+            (TYPE_FROM_ABBREV(suffix) *) fast_math_output_ref,          \
+            blockSize);                                                 \
+                                                                        \
+        FAST_MATH_ASSERT_CLOSE(                                         \
+            (TYPE_FROM_ABBREV(suffix) *) fast_math_output_ref,          \
+            (TYPE_FROM_ABBREV(suffix) *) fast_math_output_fut,          \
+            blockSize, abs_tol, rel_tol);                               \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
 #endif /* _FAST_MATH_TEMPLATES_H_ */
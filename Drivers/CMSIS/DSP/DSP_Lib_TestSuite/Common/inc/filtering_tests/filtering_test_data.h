@@ -20,6 +20,9 @@
 #define FILTERING_MAX_TAP_DELAY	0xFF
 #define FILTERING_MAX_L				3
 #define FILTERING_MAX_M				33
+#define FIR_FFT_MAX_NUMTAPS      600
+#define FILTERING_MAX_NUMCHANNELS 9
+#define FILTERING_MAX_MEDIAN_WINDOW 31
 
 /*--------------------------------------------------------------------------------*/
 /* Declare Variables */
@@ -47,8 +50,11 @@ ARR_DESC_DECLARE(filtering_blocksizes);
 ARR_DESC_DECLARE(lms_blocksizes);
 ARR_DESC_DECLARE(filtering_numtaps);
 ARR_DESC_DECLARE(filtering_numtaps2);
+ARR_DESC_DECLARE(fir_fft_numtaps);
 ARR_DESC_DECLARE(filtering_postshifts);
 ARR_DESC_DECLARE(filtering_numstages);
+ARR_DESC_DECLARE(filtering_numchannels);
+ARR_DESC_DECLARE(filtering_median_windows);
 ARR_DESC_DECLARE(filtering_Ls);
 ARR_DESC_DECLARE(filtering_Ms);
 
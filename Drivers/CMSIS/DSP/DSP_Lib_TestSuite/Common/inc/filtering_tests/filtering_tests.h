@@ -9,7 +9,9 @@ JTEST_DECLARE_GROUP(biquad_tests);
 JTEST_DECLARE_GROUP(conv_tests);
 JTEST_DECLARE_GROUP(correlate_tests);
 JTEST_DECLARE_GROUP(fir_tests);
+JTEST_DECLARE_GROUP(fir_fft_tests);
 JTEST_DECLARE_GROUP(iir_tests);
 JTEST_DECLARE_GROUP(lms_tests);
+JTEST_DECLARE_GROUP(median_filter_tests);
 
 #endif /* _FILTERING_TESTS_H_ */
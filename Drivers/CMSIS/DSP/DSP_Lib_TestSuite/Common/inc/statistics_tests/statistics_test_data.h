@@ -13,6 +13,7 @@
 /*--------------------------------------------------------------------------------*/
 #define STATISTICS_MAX_INPUT_ELEMENTS 32
 #define STATISTICS_BIGGEST_INPUT_TYPE float32_t
+#define STATISTICS_ORDER_MAX_BLOCKSIZE 257
 
 /*--------------------------------------------------------------------------------*/
 /* Declare Variables */
@@ -33,6 +34,10 @@ statistics_output_f32_fut[STATISTICS_MAX_INPUT_ELEMENTS];
 
 /* Block Sizes */
 ARR_DESC_DECLARE(statistics_block_sizes);
+ARR_DESC_DECLARE(statistics_order_block_sizes);
+
+/* Percentiles */
+ARR_DESC_DECLARE(statistics_percentiles);
 
 /* Float Inputs */
 ARR_DESC_DECLARE(statistics_zeros);
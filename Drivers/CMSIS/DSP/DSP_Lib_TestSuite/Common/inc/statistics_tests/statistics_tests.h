@@ -6,9 +6,11 @@
 /*--------------------------------------------------------------------------------*/
 JTEST_DECLARE_GROUP(max_tests);
 JTEST_DECLARE_GROUP(mean_tests);
+JTEST_DECLARE_GROUP(percentile_tests);
 JTEST_DECLARE_GROUP(min_tests);
 JTEST_DECLARE_GROUP(power_tests);
 JTEST_DECLARE_GROUP(rms_tests);
+JTEST_DECLARE_GROUP(running_stats_tests);
 JTEST_DECLARE_GROUP(std_tests);
 JTEST_DECLARE_GROUP(var_tests);
 
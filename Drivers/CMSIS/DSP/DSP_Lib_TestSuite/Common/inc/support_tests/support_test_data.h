@@ -7,6 +7,12 @@
 
 #include "arr_desc.h"
 
+/*--------------------------------------------------------------------------------*/
+/* Macros and Defines */
+/*--------------------------------------------------------------------------------*/
+
+#define SUPPORT_SORT_MAX_BLOCKSIZE 1000
+
 /*--------------------------------------------------------------------------------*/
 /* Declare Variables */
 /*--------------------------------------------------------------------------------*/
@@ -17,6 +23,8 @@ ARR_DESC_DECLARE(support_output_ref);
 
 /* Block Sizes*/
 ARR_DESC_DECLARE(support_block_sizes);
+ARR_DESC_DECLARE(support_sort_block_sizes);
+ARR_DESC_DECLARE(support_sort_patterns);
 
 /* Numbers */
 ARR_DESC_DECLARE(support_elts);
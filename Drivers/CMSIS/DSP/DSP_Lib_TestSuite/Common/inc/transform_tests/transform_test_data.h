@@ -39,10 +39,13 @@ ARR_DESC_DECLARE(transform_radix4_fftlens);
 ARR_DESC_DECLARE(transform_rfft_fftlens);
 ARR_DESC_DECLARE(transform_rfft_fast_fftlens);
 ARR_DESC_DECLARE(transform_dct_fftlens);
+ARR_DESC_DECLARE(transform_cfft_mr_fftlens);
+ARR_DESC_DECLARE(transform_rfft_mr_fftlens);
 
 /* CFFT Structs */
 ARR_DESC_DECLARE(transform_cfft_f32_structs);
 ARR_DESC_DECLARE(transform_cfft_q31_structs);
 ARR_DESC_DECLARE(transform_cfft_q15_structs);
+ARR_DESC_DECLARE(transform_cfft_bfp_q15_structs);
 
 #endif /* _TRANSFORM_TEST_DATA_H_ */
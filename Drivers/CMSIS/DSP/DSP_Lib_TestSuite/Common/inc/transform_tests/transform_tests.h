@@ -9,5 +9,7 @@ JTEST_DECLARE_GROUP(cfft_family_tests);
 JTEST_DECLARE_GROUP(dct4_tests);
 JTEST_DECLARE_GROUP(rfft_tests);
 JTEST_DECLARE_GROUP(rfft_fast_tests);
+JTEST_DECLARE_GROUP(cfft_mr_tests);
+JTEST_DECLARE_GROUP(cfft_bfp_tests);
 
 #endif /* _TRANSFORM_TESTS_H_ */
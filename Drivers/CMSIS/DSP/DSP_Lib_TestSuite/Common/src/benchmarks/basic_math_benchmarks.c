@@ -0,0 +1,126 @@
+#include "jtest.h"
+#include "arm_math.h"           /* FUTs */
+#include "benchmark_templates.h"
+#include "benchmark_data.h"
+#include "benchmarks.h"
+
+/*--------------------------------------------------------------------------------*/
+/* Benchmark Definitions */
+/*--------------------------------------------------------------------------------*/
+
+BENCHMARK_DEFINE_BINARY(arm_add, f32);
+BENCHMARK_DEFINE_BINARY(arm_add, q31);
+BENCHMARK_DEFINE_BINARY(arm_add, q15);
+BENCHMARK_DEFINE_BINARY(arm_add, q7);
+
+BENCHMARK_DEFINE_BINARY(arm_sub, f32);
+BENCHMARK_DEFINE_BINARY(arm_sub, q31);
+BENCHMARK_DEFINE_BINARY(arm_sub, q15);
+BENCHMARK_DEFINE_BINARY(arm_sub, q7);
+
+BENCHMARK_DEFINE_BINARY(arm_mult, f32);
+BENCHMARK_DEFINE_BINARY(arm_mult, q31);
+BENCHMARK_DEFINE_BINARY(arm_mult, q15);
+BENCHMARK_DEFINE_BINARY(arm_mult, q7);
+
+BENCHMARK_DEFINE_UNARY(arm_abs, f32);
+BENCHMARK_DEFINE_UNARY(arm_abs, q31);
+BENCHMARK_DEFINE_UNARY(arm_abs, q15);
+BENCHMARK_DEFINE_UNARY(arm_abs, q7);
+
+BENCHMARK_DEFINE_UNARY(arm_negate, f32);
+BENCHMARK_DEFINE_UNARY(arm_negate, q31);
+BENCHMARK_DEFINE_UNARY(arm_negate, q15);
+BENCHMARK_DEFINE_UNARY(arm_negate, q7);
+
+BENCHMARK_DEFINE_BLOCK(arm_scale_f32,
+                       benchmark_input_f32, 0.5f, benchmark_output_f32, blockSize);
+BENCHMARK_DEFINE_BLOCK(arm_scale_q31,
+                       benchmark_input_q31, 0x40000000, 1, benchmark_output_q31, blockSize);
+BENCHMARK_DEFINE_BLOCK(arm_scale_q15,
+                       benchmark_input_q15, 0x4000, 1, benchmark_output_q15, blockSize);
+BENCHMARK_DEFINE_BLOCK(arm_scale_q7,
+                       benchmark_input_q7, 0x40, 1, benchmark_output_q7, blockSize);
+
+BENCHMARK_DEFINE_BLOCK(arm_offset_f32,
+                       benchmark_input_f32, 0.25f, benchmark_output_f32, blockSize);
+BENCHMARK_DEFINE_BLOCK(arm_offset_q31,
+                       benchmark_input_q31, 0x20000000, benchmark_output_q31, blockSize);
+BENCHMARK_DEFINE_BLOCK(arm_offset_q15,
+                       benchmark_input_q15, 0x2000, benchmark_output_q15, blockSize);
+BENCHMARK_DEFINE_BLOCK(arm_offset_q7,
+                       benchmark_input_q7, 0x20, benchmark_output_q7, blockSize);
+
+BENCHMARK_DEFINE_BLOCK(arm_shift_q31,
+                       benchmark_input_q31, 2, benchmark_output_q31, blockSize);
+BENCHMARK_DEFINE_BLOCK(arm_shift_q15,
+                       benchmark_input_q15, 2, benchmark_output_q15, blockSize);
+BENCHMARK_DEFINE_BLOCK(arm_shift_q7,
+                       benchmark_input_q7, 2, benchmark_output_q7, blockSize);
+
+BENCHMARK_DEFINE_BLOCK(arm_dot_prod_f32,
+                       benchmark_input_f32, benchmark_input2_f32, blockSize,
+                       benchmark_output_f32);
+BENCHMARK_DEFINE_BLOCK(arm_dot_prod_q31,
+                       benchmark_input_q31, benchmark_input2_q31, blockSize,
+                       benchmark_output_q63);
+BENCHMARK_DEFINE_BLOCK(arm_dot_prod_q15,
+                       benchmark_input_q15, benchmark_input2_q15, blockSize,
+                       benchmark_output_q63);
+BENCHMARK_DEFINE_BLOCK(arm_dot_prod_q7,
+                       benchmark_input_q7, benchmark_input2_q7, blockSize,
+                       benchmark_output_q31);
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all benchmarks in a group. */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(basic_math_benchmarks)
+{
+    /*
+      To skip a benchmark, comment it out.
+    */
+    JTEST_TEST_CALL(arm_add_f32_benchmark);
+    JTEST_TEST_CALL(arm_add_q31_benchmark);
+    JTEST_TEST_CALL(arm_add_q15_benchmark);
+    JTEST_TEST_CALL(arm_add_q7_benchmark);
+
+    JTEST_TEST_CALL(arm_sub_f32_benchmark);
+    JTEST_TEST_CALL(arm_sub_q31_benchmark);
+    JTEST_TEST_CALL(arm_sub_q15_benchmark);
+    JTEST_TEST_CALL(arm_sub_q7_benchmark);
+
+    JTEST_TEST_CALL(arm_mult_f32_benchmark);
+    JTEST_TEST_CALL(arm_mult_q31_benchmark);
+    JTEST_TEST_CALL(arm_mult_q15_benchmark);
+    JTEST_TEST_CALL(arm_mult_q7_benchmark);
+
+    JTEST_TEST_CALL(arm_abs_f32_benchmark);
+    JTEST_TEST_CALL(arm_abs_q31_benchmark);
+    JTEST_TEST_CALL(arm_abs_q15_benchmark);
+    JTEST_TEST_CALL(arm_abs_q7_benchmark);
+
+    JTEST_TEST_CALL(arm_negate_f32_benchmark);
+    JTEST_TEST_CALL(arm_negate_q31_benchmark);
+    JTEST_TEST_CALL(arm_negate_q15_benchmark);
+    JTEST_TEST_CALL(arm_negate_q7_benchmark);
+
+    JTEST_TEST_CALL(arm_scale_f32_benchmark);
+    JTEST_TEST_CALL(arm_scale_q31_benchmark);
+    JTEST_TEST_CALL(arm_scale_q15_benchmark);
+    JTEST_TEST_CALL(arm_scale_q7_benchmark);
+
+    JTEST_TEST_CALL(arm_offset_f32_benchmark);
+    JTEST_TEST_CALL(arm_offset_q31_benchmark);
+    JTEST_TEST_CALL(arm_offset_q15_benchmark);
+    JTEST_TEST_CALL(arm_offset_q7_benchmark);
+
+    JTEST_TEST_CALL(arm_shift_q31_benchmark);
+    JTEST_TEST_CALL(arm_shift_q15_benchmark);
+    JTEST_TEST_CALL(arm_shift_q7_benchmark);
+
+    JTEST_TEST_CALL(arm_dot_prod_f32_benchmark);
+    JTEST_TEST_CALL(arm_dot_prod_q31_benchmark);
+    JTEST_TEST_CALL(arm_dot_prod_q15_benchmark);
+    JTEST_TEST_CALL(arm_dot_prod_q7_benchmark);
+}
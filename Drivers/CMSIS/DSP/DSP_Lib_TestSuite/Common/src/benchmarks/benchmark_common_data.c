@@ -0,0 +1,131 @@
+#include "benchmark_data.h"
+
+/*--------------------------------------------------------------------------------*/
+/* Input/Output Buffers */
+/*--------------------------------------------------------------------------------*/
+
+float32_t benchmark_input_f32[BENCHMARK_BUF_LEN] = {0};
+float32_t benchmark_input2_f32[BENCHMARK_BUF_LEN] = {0};
+benchmark_buf_t benchmark_input_fixed = {{0}};
+benchmark_buf_t benchmark_input2_fixed = {{0}};
+benchmark_buf_t benchmark_output = {{0}};
+benchmark_buf_t benchmark_output2 = {{0}};
+float32_t benchmark_state[BENCHMARK_STATE_LEN] = {0};
+
+/*--------------------------------------------------------------------------------*/
+/* Coefficient Lists */
+/*--------------------------------------------------------------------------------*/
+
+float32_t benchmark_coeffs_f32[BENCHMARK_MAX_NUMTAPS] = {0};
+q31_t benchmark_coeffs_q31[BENCHMARK_MAX_NUMTAPS] = {0};
+q15_t benchmark_coeffs_q15[BENCHMARK_MAX_NUMTAPS] = {0};
+q7_t benchmark_coeffs_q7[BENCHMARK_MAX_NUMTAPS] = {0};
+
+float32_t benchmark_biquad_f32[BENCHMARK_MAX_NUMSTAGES * 5] = {0};
+q31_t benchmark_biquad_q31[BENCHMARK_MAX_NUMSTAGES * 5] = {0};
+q15_t benchmark_biquad_q15[BENCHMARK_MAX_NUMSTAGES * 6] = {0};
+
+/*--------------------------------------------------------------------------------*/
+/* Swept Values */
+/*--------------------------------------------------------------------------------*/
+ARR_DESC_DEFINE(uint32_t,
+                benchmark_blocksizes,
+                4,
+                CURLY(
+                      16, 64, 256, BENCHMARK_MAX_BLOCKSIZE));
+
+ARR_DESC_DEFINE(uint16_t,
+                benchmark_numtaps,
+                3,
+                CURLY(
+                      8, 32, BENCHMARK_MAX_NUMTAPS));
+
+ARR_DESC_DEFINE(uint16_t,
+                benchmark_long_numtaps,
+                6,
+                CURLY(
+                      32, 64, 128, 256, 512, BENCHMARK_MAX_LONG_NUMTAPS));
+
+ARR_DESC_DEFINE(uint8_t,
+                benchmark_numstages,
+                3,
+                CURLY(
+                      1, 4, BENCHMARK_MAX_NUMSTAGES));
+
+ARR_DESC_DEFINE(uint16_t,
+                benchmark_fftlens,
+                9,
+                CURLY(
+                      16, 32, 64, 128, 256, 512, 1024, 2048, BENCHMARK_MAX_FFT_LEN));
+
+ARR_DESC_DEFINE(uint16_t,
+                benchmark_rfftlens,
+                8,
+                CURLY(
+                      32, 64, 128, 256, 512, 1024, 2048, BENCHMARK_MAX_FFT_LEN));
+
+/* Frame lengths of 2/3/5 factors, for the mixed-radix FFTs */
+ARR_DESC_DEFINE(uint16_t,
+                benchmark_mr_fftlens,
+                4,
+                CURLY(
+                      100, 240, 480, 960));
+
+ARR_DESC_DEFINE(uint16_t,
+                benchmark_matdims,
+                4,
+                CURLY(
+                      4, 8, 16, BENCHMARK_MAX_MAT_DIM));
+
+/*--------------------------------------------------------------------------------*/
+/* Initialization */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  Fill the inputs with noise and the coefficients with stable filters. The
+ *  values only need to keep the kernels away from overflows and denormals,
+ *  timings do not depend on them.
+ */
+void benchmark_fill_inputs(void)
+{
+    /* Biquad section b0, b1, b2, a1, a2: poles at radius 0.5 */
+    static const float32_t biquad[5] = { 0.2f, 0.4f, 0.2f, 0.5f, -0.25f };
+    uint32_t seed = 0x12345678U;
+    uint32_t i;
+
+    for (i = 0; i < BENCHMARK_BUF_LEN; ++i)
+    {
+        seed = (seed * 1664525U) + 1013904223U;
+        benchmark_input_f32[i] = ((float32_t) (seed >> 8) / 16777216.0f) - 0.5f;
+        /* Two q15 values below 0.125 */
+        benchmark_input_q31[i] = (q31_t) ((seed & 0x1FFF1FFFU) - 0x10001000U);
+
+        seed = (seed * 1664525U) + 1013904223U;
+        benchmark_input2_f32[i] = ((float32_t) (seed >> 8) / 16777216.0f) - 0.5f;
+        benchmark_input2_q31[i] = (q31_t) ((seed & 0x1FFF1FFFU) - 0x10001000U);
+    }
+
+    for (i = 0; i < BENCHMARK_MAX_NUMTAPS; ++i)
+    {
+        benchmark_coeffs_f32[i] = 1.0f / BENCHMARK_MAX_NUMTAPS;
+    }
+    arm_float_to_q31(benchmark_coeffs_f32, benchmark_coeffs_q31, BENCHMARK_MAX_NUMTAPS);
+    arm_float_to_q15(benchmark_coeffs_f32, benchmark_coeffs_q15, BENCHMARK_MAX_NUMTAPS);
+    arm_float_to_q7(benchmark_coeffs_f32, benchmark_coeffs_q7, BENCHMARK_MAX_NUMTAPS);
+
+    /* The fixed-point sections are halved, postShift 1 */
+    for (i = 0; i < BENCHMARK_MAX_NUMSTAGES; ++i)
+    {
+        memcpy(&benchmark_biquad_f32[5 * i], biquad, sizeof(biquad));
+        arm_float_to_q31((float32_t *) biquad, &benchmark_biquad_q31[5 * i], 5);
+        arm_shift_q31(&benchmark_biquad_q31[5 * i], -1, &benchmark_biquad_q31[5 * i], 5);
+
+        /* b0, 0, b1, b2, a1, a2 */
+        benchmark_biquad_q15[(6 * i) + 0] = (q15_t) (benchmark_biquad_q31[(5 * i) + 0] >> 16);
+        benchmark_biquad_q15[(6 * i) + 1] = 0;
+        benchmark_biquad_q15[(6 * i) + 2] = (q15_t) (benchmark_biquad_q31[(5 * i) + 1] >> 16);
+        benchmark_biquad_q15[(6 * i) + 3] = (q15_t) (benchmark_biquad_q31[(5 * i) + 2] >> 16);
+        benchmark_biquad_q15[(6 * i) + 4] = (q15_t) (benchmark_biquad_q31[(5 * i) + 3] >> 16);
+        benchmark_biquad_q15[(6 * i) + 5] = (q15_t) (benchmark_biquad_q31[(5 * i) + 4] >> 16);
+    }
+}
@@ -0,0 +1,21 @@
+#include "jtest.h"
+#include "benchmark_group.h"
+#include "benchmarks.h"
+
+JTEST_DEFINE_GROUP(all_benchmarks)
+{
+    /*
+      To skip a family, comment it out.
+    */
+    JTEST_BENCH_DUMP_HEADER();
+
+    JTEST_GROUP_CALL(basic_math_benchmarks);
+    JTEST_GROUP_CALL(complex_math_benchmarks);
+    JTEST_GROUP_CALL(controller_benchmarks);
+    JTEST_GROUP_CALL(fast_math_benchmarks);
+    JTEST_GROUP_CALL(filtering_benchmarks);
+    JTEST_GROUP_CALL(matrix_benchmarks);
+    JTEST_GROUP_CALL(statistics_benchmarks);
+    JTEST_GROUP_CALL(support_benchmarks);
+    JTEST_GROUP_CALL(transform_benchmarks);
+}
@@ -0,0 +1,75 @@
+#include "jtest.h"
+#include "arm_math.h"           /* FUTs */
+#include "benchmark_templates.h"
+#include "benchmark_data.h"
+#include "benchmarks.h"
+
+/*--------------------------------------------------------------------------------*/
+/* Benchmark Definitions */
+/*--------------------------------------------------------------------------------*/
+
+/* Block sizes count complex samples */
+
+BENCHMARK_DEFINE_UNARY(arm_cmplx_conj, f32);
+BENCHMARK_DEFINE_UNARY(arm_cmplx_conj, q31);
+BENCHMARK_DEFINE_UNARY(arm_cmplx_conj, q15);
+
+BENCHMARK_DEFINE_UNARY(arm_cmplx_mag, f32);
+BENCHMARK_DEFINE_UNARY(arm_cmplx_mag, q31);
+BENCHMARK_DEFINE_UNARY(arm_cmplx_mag, q15);
+
+BENCHMARK_DEFINE_UNARY(arm_cmplx_mag_squared, f32);
+BENCHMARK_DEFINE_UNARY(arm_cmplx_mag_squared, q31);
+BENCHMARK_DEFINE_UNARY(arm_cmplx_mag_squared, q15);
+
+BENCHMARK_DEFINE_BINARY(arm_cmplx_mult_cmplx, f32);
+BENCHMARK_DEFINE_BINARY(arm_cmplx_mult_cmplx, q31);
+BENCHMARK_DEFINE_BINARY(arm_cmplx_mult_cmplx, q15);
+
+BENCHMARK_DEFINE_BINARY(arm_cmplx_mult_real, f32);
+BENCHMARK_DEFINE_BINARY(arm_cmplx_mult_real, q31);
+BENCHMARK_DEFINE_BINARY(arm_cmplx_mult_real, q15);
+
+BENCHMARK_DEFINE_BLOCK(arm_cmplx_dot_prod_f32,
+                       benchmark_input_f32, benchmark_input2_f32, blockSize,
+                       &benchmark_output_f32[0], &benchmark_output_f32[1]);
+BENCHMARK_DEFINE_BLOCK(arm_cmplx_dot_prod_q31,
+                       benchmark_input_q31, benchmark_input2_q31, blockSize,
+                       &benchmark_output_q63[0], &benchmark_output_q63[1]);
+BENCHMARK_DEFINE_BLOCK(arm_cmplx_dot_prod_q15,
+                       benchmark_input_q15, benchmark_input2_q15, blockSize,
+                       &benchmark_output_q31[0], &benchmark_output_q31[1]);
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all benchmarks in a group. */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(complex_math_benchmarks)
+{
+    /*
+      To skip a benchmark, comment it out.
+    */
+    JTEST_TEST_CALL(arm_cmplx_conj_f32_benchmark);
+    JTEST_TEST_CALL(arm_cmplx_conj_q31_benchmark);
+    JTEST_TEST_CALL(arm_cmplx_conj_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_cmplx_mag_f32_benchmark);
+    JTEST_TEST_CALL(arm_cmplx_mag_q31_benchmark);
+    JTEST_TEST_CALL(arm_cmplx_mag_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_cmplx_mag_squared_f32_benchmark);
+    JTEST_TEST_CALL(arm_cmplx_mag_squared_q31_benchmark);
+    JTEST_TEST_CALL(arm_cmplx_mag_squared_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_cmplx_mult_cmplx_f32_benchmark);
+    JTEST_TEST_CALL(arm_cmplx_mult_cmplx_q31_benchmark);
+    JTEST_TEST_CALL(arm_cmplx_mult_cmplx_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_cmplx_mult_real_f32_benchmark);
+    JTEST_TEST_CALL(arm_cmplx_mult_real_q31_benchmark);
+    JTEST_TEST_CALL(arm_cmplx_mult_real_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_cmplx_dot_prod_f32_benchmark);
+    JTEST_TEST_CALL(arm_cmplx_dot_prod_q31_benchmark);
+    JTEST_TEST_CALL(arm_cmplx_dot_prod_q15_benchmark);
+}
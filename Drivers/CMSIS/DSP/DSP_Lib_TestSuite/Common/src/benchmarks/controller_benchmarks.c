@@ -0,0 +1,90 @@
+#include "jtest.h"
+#include "arm_math.h"           /* FUTs */
+#include "benchmark_templates.h"
+#include "benchmark_data.h"
+#include "benchmarks.h"
+
+/*--------------------------------------------------------------------------------*/
+/* Benchmark Definitions */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  The PID controllers take one sample per call, a block of calls is timed.
+ */
+#define PID_DEFINE_BENCHMARK(suffix)                                    \
+    JTEST_DEFINE_TEST(arm_pid_##suffix##_benchmark,                     \
+                      arm_pid_##suffix)                                 \
+    {                                                                   \
+        arm_pid_instance_##suffix pid_inst = { 0 };                     \
+        uint32_t i;                                                     \
+                                                                        \
+        pid_inst.Kp = benchmark_coeffs_##suffix[0];                     \
+        pid_inst.Ki = benchmark_coeffs_##suffix[1];                     \
+        pid_inst.Kd = benchmark_coeffs_##suffix[2];                     \
+        arm_pid_init_##suffix(&pid_inst, 1);                            \
+                                                                        \
+        BENCHMARK_DO_BLOCKSIZES(                                        \
+            JTEST_BENCH(STR(arm_pid_##suffix), blockSize, 0, blockSize, \
+                        for (i = 0; i < blockSize; ++i)                 \
+                        {                                               \
+                            benchmark_output_##suffix[i] =              \
+                                arm_pid_##suffix(                       \
+                                    &pid_inst,                          \
+                                    benchmark_input_##suffix[i]);       \
+                        }));                                            \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+PID_DEFINE_BENCHMARK(f32);
+PID_DEFINE_BENCHMARK(q31);
+PID_DEFINE_BENCHMARK(q15);
+
+JTEST_DEFINE_TEST(arm_sin_cos_f32_benchmark, arm_sin_cos_f32)
+{
+    uint32_t i;
+
+    BENCHMARK_DO_BLOCKSIZES(
+        JTEST_BENCH("arm_sin_cos_f32", blockSize, 0, blockSize,
+                    for (i = 0; i < blockSize; ++i)
+                    {
+                        arm_sin_cos_f32(benchmark_input_f32[i] * 360.0f,
+                                        &benchmark_output_f32[i],
+                                        &benchmark_output2_f32[i]);
+                    }));
+
+    return JTEST_TEST_PASSED;
+}
+
+JTEST_DEFINE_TEST(arm_sin_cos_q31_benchmark, arm_sin_cos_q31)
+{
+    uint32_t i;
+
+    BENCHMARK_DO_BLOCKSIZES(
+        JTEST_BENCH("arm_sin_cos_q31", blockSize, 0, blockSize,
+                    for (i = 0; i < blockSize; ++i)
+                    {
+                        arm_sin_cos_q31(benchmark_input_q31[i],
+                                        &benchmark_output_q31[i],
+                                        &benchmark_output2_q31[i]);
+                    }));
+
+    return JTEST_TEST_PASSED;
+}
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all benchmarks in a group. */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(controller_benchmarks)
+{
+    /*
+      To skip a benchmark, comment it out.
+    */
+    JTEST_TEST_CALL(arm_pid_f32_benchmark);
+    JTEST_TEST_CALL(arm_pid_q31_benchmark);
+    JTEST_TEST_CALL(arm_pid_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_sin_cos_f32_benchmark);
+    JTEST_TEST_CALL(arm_sin_cos_q31_benchmark);
+}
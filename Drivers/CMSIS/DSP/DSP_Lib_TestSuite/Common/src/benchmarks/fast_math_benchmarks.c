@@ -0,0 +1,155 @@
+#include "jtest.h"
+#include "arm_math.h"           /* FUTs */
+#include "benchmark_templates.h"
+#include "benchmark_data.h"
+#include "benchmarks.h"
+
+/*--------------------------------------------------------------------------------*/
+/* Benchmark Definitions */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  Functions of one sample, fn(x). The fixed-point ones take inputs in
+ *  [0, 1), the inputs are made positive in output2 first and a block of calls
+ *  is timed.
+ */
+#define FAST_MATH_DEFINE_BENCHMARK(fn_name, suffix, fn_call)            \
+    JTEST_DEFINE_TEST(arm_##fn_name##_##suffix##_benchmark,             \
+                      arm_##fn_name##_##suffix)                         \
+    {                                                                   \
+        uint32_t i;                                                     \
+                                                                        \
+        arm_abs_##suffix(benchmark_input_##suffix,                      \
+                         benchmark_output2_##suffix,                    \
+                         BENCHMARK_MAX_BLOCKSIZE);                      \
+                                                                        \
+        BENCHMARK_DO_BLOCKSIZES(                                        \
+            JTEST_BENCH(STR(arm_##fn_name##_##suffix),                  \
+                        blockSize, 0, blockSize,                        \
+                        for (i = 0; i < blockSize; ++i)                 \
+                        {                                               \
+                            fn_call;                                    \
+                        }));                                            \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+/* y = fn(x) */
+#define FAST_MATH_DEFINE_TRIG_BENCHMARK(fn_name, suffix)                \
+    FAST_MATH_DEFINE_BENCHMARK(fn_name, suffix,                         \
+                               benchmark_output_##suffix[i] =           \
+                               arm_##fn_name##_##suffix(                \
+                                   benchmark_output2_##suffix[i]))
+
+/* arm_sqrt_x(x, &y) */
+#define SQRT_DEFINE_BENCHMARK(suffix)                                   \
+    FAST_MATH_DEFINE_BENCHMARK(sqrt, suffix,                            \
+                               arm_sqrt_##suffix(                       \
+                                   benchmark_output2_##suffix[i],       \
+                                   &benchmark_output_##suffix[i]))
+
+/**
+ *  Block functions, fn(..., blockSize). The absolute values of the inputs are
+ *  in output2, for the functions of positive inputs.
+ */
+#define FAST_MATH_DEFINE_BLOCK_BENCHMARK(fn_name, suffix, ...)          \
+    JTEST_DEFINE_TEST(arm_##fn_name##_##suffix##_benchmark,             \
+                      arm_##fn_name##_##suffix)                         \
+    {                                                                   \
+        arm_abs_##suffix(benchmark_input_##suffix,                      \
+                         benchmark_output2_##suffix,                    \
+                         BENCHMARK_MAX_BLOCKSIZE);                      \
+                                                                        \
+        BENCHMARK_DO_BLOCKSIZES(                                        \
+            JTEST_BENCH(STR(arm_##fn_name##_##suffix),                  \
+                        blockSize, 0, blockSize,                        \
+                        arm_##fn_name##_##suffix(__VA_ARGS__)));        \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+/* fn(pSrc, pDst, blockSize) */
+#define FAST_MATH_DEFINE_UNARY_BENCHMARK(fn_name, suffix)               \
+    FAST_MATH_DEFINE_BLOCK_BENCHMARK(fn_name, suffix,                   \
+                                     benchmark_input_##suffix,          \
+                                     benchmark_output_##suffix,         \
+                                     blockSize)
+
+/* fn(|pSrc|, pDst, blockSize) */
+#define FAST_MATH_DEFINE_POSITIVE_BENCHMARK(fn_name, suffix)            \
+    FAST_MATH_DEFINE_BLOCK_BENCHMARK(fn_name, suffix,                   \
+                                     benchmark_output2_##suffix,        \
+                                     benchmark_output_##suffix,         \
+                                     blockSize)
+
+FAST_MATH_DEFINE_TRIG_BENCHMARK(sin, f32);
+FAST_MATH_DEFINE_TRIG_BENCHMARK(sin, q31);
+FAST_MATH_DEFINE_TRIG_BENCHMARK(sin, q15);
+
+FAST_MATH_DEFINE_TRIG_BENCHMARK(cos, f32);
+FAST_MATH_DEFINE_TRIG_BENCHMARK(cos, q31);
+FAST_MATH_DEFINE_TRIG_BENCHMARK(cos, q15);
+
+SQRT_DEFINE_BENCHMARK(f32);
+SQRT_DEFINE_BENCHMARK(q31);
+SQRT_DEFINE_BENCHMARK(q15);
+
+FAST_MATH_DEFINE_UNARY_BENCHMARK(vsin, f32);
+FAST_MATH_DEFINE_UNARY_BENCHMARK(vsin, q31);
+FAST_MATH_DEFINE_UNARY_BENCHMARK(vcos, f32);
+FAST_MATH_DEFINE_UNARY_BENCHMARK(vcos, q31);
+
+FAST_MATH_DEFINE_BLOCK_BENCHMARK(vatan2, f32, benchmark_input_f32,
+                                 benchmark_input2_f32, benchmark_output_f32,
+                                 blockSize);
+FAST_MATH_DEFINE_BLOCK_BENCHMARK(vatan2, q31, benchmark_input_q31,
+                                 benchmark_input2_q31, benchmark_output_q31,
+                                 blockSize);
+
+FAST_MATH_DEFINE_UNARY_BENCHMARK(vexp, f32);
+
+FAST_MATH_DEFINE_POSITIVE_BENCHMARK(vlog, f32);
+FAST_MATH_DEFINE_POSITIVE_BENCHMARK(vlog10, f32);
+FAST_MATH_DEFINE_POSITIVE_BENCHMARK(vlog, q31);
+
+FAST_MATH_DEFINE_BLOCK_BENCHMARK(vpow, f32, benchmark_output2_f32,
+                                 benchmark_input2_f32, benchmark_output_f32,
+                                 blockSize);
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all benchmarks in a group. */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(fast_math_benchmarks)
+{
+    /*
+      To skip a benchmark, comment it out.
+    */
+    JTEST_TEST_CALL(arm_sin_f32_benchmark);
+    JTEST_TEST_CALL(arm_sin_q31_benchmark);
+    JTEST_TEST_CALL(arm_sin_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_cos_f32_benchmark);
+    JTEST_TEST_CALL(arm_cos_q31_benchmark);
+    JTEST_TEST_CALL(arm_cos_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_sqrt_f32_benchmark);
+    JTEST_TEST_CALL(arm_sqrt_q31_benchmark);
+    JTEST_TEST_CALL(arm_sqrt_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_vsin_f32_benchmark);
+    JTEST_TEST_CALL(arm_vsin_q31_benchmark);
+    JTEST_TEST_CALL(arm_vcos_f32_benchmark);
+    JTEST_TEST_CALL(arm_vcos_q31_benchmark);
+
+    JTEST_TEST_CALL(arm_vatan2_f32_benchmark);
+    JTEST_TEST_CALL(arm_vatan2_q31_benchmark);
+
+    JTEST_TEST_CALL(arm_vexp_f32_benchmark);
+
+    JTEST_TEST_CALL(arm_vlog_f32_benchmark);
+    JTEST_TEST_CALL(arm_vlog10_f32_benchmark);
+    JTEST_TEST_CALL(arm_vlog_q31_benchmark);
+
+    JTEST_TEST_CALL(arm_vpow_f32_benchmark);
+}
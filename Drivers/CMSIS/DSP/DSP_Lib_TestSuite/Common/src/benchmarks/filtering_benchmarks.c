@@ -0,0 +1,537 @@
+#include "jtest.h"
+#include "arm_math.h"           /* FUTs */
+#include "benchmark_templates.h"
+#include "benchmark_data.h"
+#include "benchmarks.h"
+
+/*--------------------------------------------------------------------------------*/
+/* Variables */
+/*--------------------------------------------------------------------------------*/
+
+/* The LMS filters update their coefficients, they get a copy */
+static float32_t lms_coeffs_f32[BENCHMARK_MAX_NUMTAPS];
+static q31_t lms_coeffs_q31[BENCHMARK_MAX_NUMTAPS];
+static q15_t lms_coeffs_q15[BENCHMARK_MAX_NUMTAPS];
+
+/* Spectra and delay line of the FFT-based FIR, state of the direct form */
+static float32_t fir_fft_buffer[ARM_FIR_FFT_BUFFER_SIZE(BENCHMARK_MAX_LONG_NUMTAPS,
+                                                        BENCHMARK_LONG_BLOCKSIZE)];
+
+/* Delay line of the multi-channel FIRs, numTaps - 1 frames and a block */
+static float32_t fir_mc_state[(BENCHMARK_MAX_NUMTAPS + BENCHMARK_MAX_BLOCKSIZE)
+                              * BENCHMARK_MC_NUMCHANNELS];
+
+/* Heap of the median filters */
+static int16_t median_filter_index[BENCHMARK_MEDIAN_WINDOW * 2];
+
+/*--------------------------------------------------------------------------------*/
+/* FIR */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  FIR filters over the tap counts and block sizes. config_suffix selects the
+ *  fast variants, e.g. _fast.
+ */
+#define FIR_DEFINE_BENCHMARK(suffix, config_suffix)                     \
+    JTEST_DEFINE_TEST(arm_fir##config_suffix##_##suffix##_benchmark,    \
+                      arm_fir##config_suffix##_##suffix)                \
+    {                                                                   \
+        arm_fir_instance_##suffix fir_inst = { 0 };                     \
+                                                                        \
+        BENCHMARK_DO_NUMTAPS(                                           \
+            BENCHMARK_DO_BLOCKSIZES(                                    \
+                arm_fir_init_##suffix(&fir_inst, numTaps,               \
+                                      benchmark_coeffs_##suffix,        \
+                                      (void *) benchmark_state,         \
+                                      blockSize);                       \
+                                                                        \
+                JTEST_BENCH(STR(arm_fir##config_suffix##_##suffix),     \
+                            blockSize, numTaps, blockSize,              \
+                            arm_fir##config_suffix##_##suffix(          \
+                                &fir_inst,                              \
+                                benchmark_input_##suffix,               \
+                                benchmark_output_##suffix,              \
+                                blockSize))));                          \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+FIR_DEFINE_BENCHMARK(f32, );
+FIR_DEFINE_BENCHMARK(q31, );
+FIR_DEFINE_BENCHMARK(q31, _fast);
+FIR_DEFINE_BENCHMARK(q15, );
+FIR_DEFINE_BENCHMARK(q15, _fast);
+FIR_DEFINE_BENCHMARK(q7, );
+
+/**
+ *  Multi-channel FIR filters on frames of BENCHMARK_MC_NUMCHANNELS samples,
+ *  the samples of all channels are counted.
+ */
+#define FIR_MC_DEFINE_BENCHMARK(suffix)                                 \
+    JTEST_DEFINE_TEST(arm_fir_mc_##suffix##_benchmark,                  \
+                      arm_fir_mc_##suffix)                              \
+    {                                                                   \
+        arm_fir_mc_instance_##suffix fir_inst = { 0 };                  \
+                                                                        \
+        BENCHMARK_DO_NUMTAPS(                                           \
+            BENCHMARK_DO_BLOCKSIZES(                                    \
+                arm_fir_mc_init_##suffix(&fir_inst,                     \
+                                         BENCHMARK_MC_NUMCHANNELS,      \
+                                         numTaps,                       \
+                                         benchmark_coeffs_##suffix,     \
+                                         (void *) fir_mc_state,         \
+                                         blockSize);                    \
+                                                                        \
+                JTEST_BENCH(STR(arm_fir_mc_##suffix),                   \
+                            blockSize, numTaps,                         \
+                            blockSize * BENCHMARK_MC_NUMCHANNELS,       \
+                            arm_fir_mc_##suffix(                        \
+                                &fir_inst,                              \
+                                benchmark_input_##suffix,               \
+                                benchmark_output_##suffix,              \
+                                blockSize))));                          \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+FIR_MC_DEFINE_BENCHMARK(f32);
+FIR_MC_DEFINE_BENCHMARK(q31);
+FIR_MC_DEFINE_BENCHMARK(q15);
+
+/**
+ *  Long filters, the second input as coefficients, against the FFT-based
+ *  FIR. The latter runs the direct form below its break-even, so the two rows
+ *  meet there.
+ */
+JTEST_DEFINE_TEST(arm_fir_long_f32_benchmark,
+                  arm_fir_f32)
+{
+    arm_fir_instance_f32 fir_inst = { 0 };
+
+    BENCHMARK_DO_LONG_NUMTAPS(
+        arm_fir_init_f32(&fir_inst, numTaps, benchmark_input2_f32,
+                         fir_fft_buffer, BENCHMARK_LONG_BLOCKSIZE);
+
+        JTEST_BENCH("arm_fir_f32",
+                    BENCHMARK_LONG_BLOCKSIZE, numTaps, BENCHMARK_LONG_BLOCKSIZE,
+                    arm_fir_f32(&fir_inst,
+                                benchmark_input_f32,
+                                benchmark_output_f32,
+                                BENCHMARK_LONG_BLOCKSIZE)));
+
+    return JTEST_TEST_PASSED;
+}
+
+JTEST_DEFINE_TEST(arm_fir_fft_f32_benchmark,
+                  arm_fir_fft_f32)
+{
+    arm_fir_fft_instance_f32 fir_inst;
+
+    BENCHMARK_DO_LONG_NUMTAPS(
+        arm_fir_fft_init_f32(&fir_inst, numTaps, benchmark_input2_f32,
+                             fir_fft_buffer, BENCHMARK_LONG_BLOCKSIZE);
+
+        JTEST_BENCH("arm_fir_fft_f32",
+                    BENCHMARK_LONG_BLOCKSIZE, numTaps, BENCHMARK_LONG_BLOCKSIZE,
+                    arm_fir_fft_f32(&fir_inst,
+                                    benchmark_input_f32,
+                                    benchmark_output_f32,
+                                    BENCHMARK_LONG_BLOCKSIZE)));
+
+    return JTEST_TEST_PASSED;
+}
+
+/**
+ *  Decimation by 4 and interpolation by 4, samples produced per call.
+ */
+#define FIR_DECIMATE_DEFINE_BENCHMARK(suffix, config_suffix)            \
+    JTEST_DEFINE_TEST(arm_fir_decimate##config_suffix##_##suffix##_benchmark, \
+                      arm_fir_decimate##config_suffix##_##suffix)       \
+    {                                                                   \
+        arm_fir_decimate_instance_##suffix fir_inst = { 0 };            \
+                                                                        \
+        BENCHMARK_DO_NUMTAPS(                                           \
+            BENCHMARK_DO_BLOCKSIZES(                                    \
+                arm_fir_decimate_init_##suffix(&fir_inst, numTaps, 4,   \
+                                               benchmark_coeffs_##suffix, \
+                                               (void *) benchmark_state, \
+                                               blockSize);              \
+                                                                        \
+                JTEST_BENCH(STR(arm_fir_decimate##config_suffix##_##suffix), \
+                            blockSize, numTaps, blockSize / 4,          \
+                            arm_fir_decimate##config_suffix##_##suffix( \
+                                &fir_inst,                              \
+                                benchmark_input_##suffix,               \
+                                benchmark_output_##suffix,              \
+                                blockSize))));                          \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+#define FIR_INTERPOLATE_DEFINE_BENCHMARK(suffix)                        \
+    JTEST_DEFINE_TEST(arm_fir_interpolate_##suffix##_benchmark,         \
+                      arm_fir_interpolate_##suffix)                     \
+    {                                                                   \
+        arm_fir_interpolate_instance_##suffix fir_inst = { 0 };         \
+                                                                        \
+        BENCHMARK_DO_NUMTAPS(                                           \
+            BENCHMARK_DO_BLOCKSIZES(                                    \
+                arm_fir_interpolate_init_##suffix(&fir_inst, 4, numTaps, \
+                                                  benchmark_coeffs_##suffix, \
+                                                  (void *) benchmark_state, \
+                                                  blockSize);           \
+                                                                        \
+                JTEST_BENCH(STR(arm_fir_interpolate_##suffix),          \
+                            blockSize, numTaps, blockSize * 4,          \
+                            arm_fir_interpolate_##suffix(               \
+                                &fir_inst,                              \
+                                benchmark_input_##suffix,               \
+                                benchmark_output_##suffix,              \
+                                blockSize))));                          \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+FIR_DECIMATE_DEFINE_BENCHMARK(f32, );
+FIR_DECIMATE_DEFINE_BENCHMARK(q31, );
+FIR_DECIMATE_DEFINE_BENCHMARK(q31, _fast);
+FIR_DECIMATE_DEFINE_BENCHMARK(q15, );
+FIR_DECIMATE_DEFINE_BENCHMARK(q15, _fast);
+
+FIR_INTERPOLATE_DEFINE_BENCHMARK(f32);
+FIR_INTERPOLATE_DEFINE_BENCHMARK(q31);
+FIR_INTERPOLATE_DEFINE_BENCHMARK(q15);
+
+/*--------------------------------------------------------------------------------*/
+/* Biquad */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  Biquad cascades over the stage counts and block sizes. init_call
+ *  initializes biquad_inst for numStages.
+ */
+#define BIQUAD_DEFINE_BENCHMARK(fn_name, inst_type, suffix, init_call)  \
+    JTEST_DEFINE_TEST(fn_name##_benchmark, fn_name)                     \
+    {                                                                   \
+        inst_type biquad_inst = { 0 };                                  \
+                                                                        \
+        BENCHMARK_DO_NUMSTAGES(                                         \
+            BENCHMARK_DO_BLOCKSIZES(                                    \
+                memset(benchmark_state, 0, sizeof(benchmark_state));    \
+                init_call;                                              \
+                                                                        \
+                JTEST_BENCH(STR(fn_name),                               \
+                            blockSize, numStages, blockSize,            \
+                            fn_name(&biquad_inst,                       \
+                                    benchmark_input_##suffix,           \
+                                    benchmark_output_##suffix,          \
+                                    blockSize))));                      \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+BIQUAD_DEFINE_BENCHMARK(arm_biquad_cascade_df1_f32,
+                        arm_biquad_casd_df1_inst_f32, f32,
+                        arm_biquad_cascade_df1_init_f32(
+                            &biquad_inst, numStages,
+                            benchmark_biquad_f32, benchmark_state));
+
+BIQUAD_DEFINE_BENCHMARK(arm_biquad_cascade_df2T_f32,
+                        arm_biquad_cascade_df2T_instance_f32, f32,
+                        arm_biquad_cascade_df2T_init_f32(
+                            &biquad_inst, numStages,
+                            benchmark_biquad_f32, benchmark_state));
+
+BIQUAD_DEFINE_BENCHMARK(arm_biquad_cascade_df1_q31,
+                        arm_biquad_casd_df1_inst_q31, q31,
+                        arm_biquad_cascade_df1_init_q31(
+                            &biquad_inst, numStages,
+                            benchmark_biquad_q31, (q31_t *) benchmark_state, 1));
+
+BIQUAD_DEFINE_BENCHMARK(arm_biquad_cascade_df1_fast_q31,
+                        arm_biquad_casd_df1_inst_q31, q31,
+                        arm_biquad_cascade_df1_init_q31(
+                            &biquad_inst, numStages,
+                            benchmark_biquad_q31, (q31_t *) benchmark_state, 1));
+
+BIQUAD_DEFINE_BENCHMARK(arm_biquad_cas_df1_32x64_q31,
+                        arm_biquad_cas_df1_32x64_ins_q31, q31,
+                        arm_biquad_cas_df1_32x64_init_q31(
+                            &biquad_inst, numStages,
+                            benchmark_biquad_q31, (q63_t *) benchmark_state, 1));
+
+BIQUAD_DEFINE_BENCHMARK(arm_biquad_cascade_df1_q15,
+                        arm_biquad_casd_df1_inst_q15, q15,
+                        arm_biquad_cascade_df1_init_q15(
+                            &biquad_inst, numStages,
+                            benchmark_biquad_q15, (q15_t *) benchmark_state, 1));
+
+BIQUAD_DEFINE_BENCHMARK(arm_biquad_cascade_df1_fast_q15,
+                        arm_biquad_casd_df1_inst_q15, q15,
+                        arm_biquad_cascade_df1_init_q15(
+                            &biquad_inst, numStages,
+                            benchmark_biquad_q15, (q15_t *) benchmark_state, 1));
+
+/* Two interleaved channels, samples of both are counted */
+JTEST_DEFINE_TEST(arm_biquad_cascade_stereo_df2T_f32_benchmark,
+                  arm_biquad_cascade_stereo_df2T_f32)
+{
+    arm_biquad_cascade_stereo_df2T_instance_f32 biquad_inst = { 0 };
+
+    BENCHMARK_DO_NUMSTAGES(
+        BENCHMARK_DO_BLOCKSIZES(
+            memset(benchmark_state, 0, sizeof(benchmark_state));
+            arm_biquad_cascade_stereo_df2T_init_f32(
+                &biquad_inst, numStages,
+                benchmark_biquad_f32, benchmark_state);
+
+            JTEST_BENCH("arm_biquad_cascade_stereo_df2T_f32",
+                        blockSize, numStages, blockSize * 2,
+                        arm_biquad_cascade_stereo_df2T_f32(
+                            &biquad_inst,
+                            benchmark_input_f32,
+                            benchmark_output_f32,
+                            blockSize))));
+
+    return JTEST_TEST_PASSED;
+}
+
+/**
+ *  Multi-channel biquad cascades on frames of BENCHMARK_MC_NUMCHANNELS
+ *  samples, the samples of all channels are counted.
+ */
+#define BIQUAD_MC_DEFINE_BENCHMARK(fn_name, inst_type, suffix, init_call) \
+    JTEST_DEFINE_TEST(fn_name##_benchmark, fn_name)                     \
+    {                                                                   \
+        inst_type biquad_inst = { 0 };                                  \
+                                                                        \
+        BENCHMARK_DO_NUMSTAGES(                                         \
+            BENCHMARK_DO_BLOCKSIZES(                                    \
+                memset(benchmark_state, 0, sizeof(benchmark_state));    \
+                init_call;                                              \
+                                                                        \
+                JTEST_BENCH(STR(fn_name),                               \
+                            blockSize, numStages,                       \
+                            blockSize * BENCHMARK_MC_NUMCHANNELS,       \
+                            fn_name(&biquad_inst,                       \
+                                    benchmark_input_##suffix,           \
+                                    benchmark_output_##suffix,          \
+                                    blockSize))));                      \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+BIQUAD_MC_DEFINE_BENCHMARK(arm_biquad_cascade_mc_df2T_f32,
+                           arm_biquad_cascade_mc_df2T_instance_f32, f32,
+                           arm_biquad_cascade_mc_df2T_init_f32(
+                               &biquad_inst, BENCHMARK_MC_NUMCHANNELS,
+                               numStages, benchmark_biquad_f32,
+                               benchmark_state));
+
+BIQUAD_MC_DEFINE_BENCHMARK(arm_biquad_cascade_mc_df1_q31,
+                           arm_biquad_casd_mc_df1_inst_q31, q31,
+                           arm_biquad_cascade_mc_df1_init_q31(
+                               &biquad_inst, BENCHMARK_MC_NUMCHANNELS,
+                               numStages, benchmark_biquad_q31,
+                               (q31_t *) benchmark_state, 1));
+
+BIQUAD_MC_DEFINE_BENCHMARK(arm_biquad_cascade_mc_df1_q15,
+                           arm_biquad_casd_mc_df1_inst_q15, q15,
+                           arm_biquad_cascade_mc_df1_init_q15(
+                               &biquad_inst, BENCHMARK_MC_NUMCHANNELS,
+                               numStages, benchmark_biquad_q15,
+                               (q15_t *) benchmark_state, 1));
+
+/*--------------------------------------------------------------------------------*/
+/* Convolution and Correlation */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  A block of blockSize samples with a sequence of numTaps samples. The extra
+ *  arguments, like the scratch buffers, follow the output.
+ */
+#define CONV_DEFINE_BENCHMARK(fn_name, suffix, out_len, ...)             \
+    JTEST_DEFINE_TEST(fn_name##_benchmark, fn_name)                     \
+    {                                                                   \
+        BENCHMARK_DO_NUMTAPS(                                           \
+            BENCHMARK_DO_BLOCKSIZES(                                    \
+                JTEST_BENCH(STR(fn_name),                               \
+                            blockSize, numTaps, (out_len),              \
+                            fn_name(benchmark_input_##suffix,           \
+                                    blockSize,                          \
+                                    benchmark_input2_##suffix,          \
+                                    numTaps,                            \
+                                    benchmark_output_##suffix           \
+                                    __VA_ARGS__))));                    \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+#define CONV_LEN  (blockSize + numTaps - 1)
+#define CORR_LEN  ((2 * MAX(blockSize, numTaps)) - 1)
+
+CONV_DEFINE_BENCHMARK(arm_conv_f32, f32, CONV_LEN, );
+CONV_DEFINE_BENCHMARK(arm_conv_q31, q31, CONV_LEN, );
+CONV_DEFINE_BENCHMARK(arm_conv_fast_q31, q31, CONV_LEN, );
+CONV_DEFINE_BENCHMARK(arm_conv_q15, q15, CONV_LEN, );
+CONV_DEFINE_BENCHMARK(arm_conv_fast_q15, q15, CONV_LEN, );
+CONV_DEFINE_BENCHMARK(arm_conv_fast_opt_q15, q15, CONV_LEN,
+                      , benchmark_output2_q15, (q15_t *) benchmark_state);
+CONV_DEFINE_BENCHMARK(arm_conv_q7, q7, CONV_LEN, );
+
+CONV_DEFINE_BENCHMARK(arm_correlate_f32, f32, CORR_LEN, );
+CONV_DEFINE_BENCHMARK(arm_correlate_q31, q31, CORR_LEN, );
+CONV_DEFINE_BENCHMARK(arm_correlate_fast_q31, q31, CORR_LEN, );
+CONV_DEFINE_BENCHMARK(arm_correlate_q15, q15, CORR_LEN, );
+CONV_DEFINE_BENCHMARK(arm_correlate_fast_q15, q15, CORR_LEN, );
+CONV_DEFINE_BENCHMARK(arm_correlate_fast_opt_q15, q15, CORR_LEN,
+                      , benchmark_output2_q15);
+CONV_DEFINE_BENCHMARK(arm_correlate_q7, q7, CORR_LEN, );
+
+/*--------------------------------------------------------------------------------*/
+/* LMS */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  Adaptive filters against the second input as reference. The extra
+ *  arguments follow the block size in the init call, e.g. the postShift.
+ */
+#define LMS_DEFINE_BENCHMARK(fn_name, inst_type, suffix, mu, ...)       \
+    JTEST_DEFINE_TEST(arm_##fn_name##_##suffix##_benchmark,             \
+                      arm_##fn_name##_##suffix)                         \
+    {                                                                   \
+        inst_type lms_inst = { 0 };                                     \
+                                                                        \
+        BENCHMARK_DO_NUMTAPS(                                           \
+            BENCHMARK_DO_BLOCKSIZES(                                    \
+                memcpy(lms_coeffs_##suffix, benchmark_coeffs_##suffix,  \
+                       sizeof(lms_coeffs_##suffix));                    \
+                memset(benchmark_state, 0, sizeof(benchmark_state));    \
+                arm_##fn_name##_init_##suffix(&lms_inst, numTaps,       \
+                                              lms_coeffs_##suffix,      \
+                                              (void *) benchmark_state, \
+                                              (mu), blockSize           \
+                                              __VA_ARGS__);             \
+                                                                        \
+                JTEST_BENCH(STR(arm_##fn_name##_##suffix),              \
+                            blockSize, numTaps, blockSize,              \
+                            arm_##fn_name##_##suffix(                   \
+                                &lms_inst,                              \
+                                benchmark_input_##suffix,               \
+                                benchmark_input2_##suffix,              \
+                                benchmark_output_##suffix,              \
+                                benchmark_output2_##suffix,             \
+                                blockSize))));                          \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+LMS_DEFINE_BENCHMARK(lms, arm_lms_instance_f32, f32, 0.01f, );
+LMS_DEFINE_BENCHMARK(lms, arm_lms_instance_q31, q31, 0x01000000, , 0);
+LMS_DEFINE_BENCHMARK(lms, arm_lms_instance_q15, q15, 0x0100, , 0);
+LMS_DEFINE_BENCHMARK(lms_norm, arm_lms_norm_instance_f32, f32, 0.01f, );
+LMS_DEFINE_BENCHMARK(lms_norm, arm_lms_norm_instance_q31, q31, 0x01000000, , 0);
+LMS_DEFINE_BENCHMARK(lms_norm, arm_lms_norm_instance_q15, q15, 0x0100, , 0);
+
+/*--------------------------------------------------------------------------------*/
+/* Median Filter */
+/*--------------------------------------------------------------------------------*/
+
+/* Sliding median over the block sizes, the window is the param */
+#define MEDIAN_FILTER_DEFINE_BENCHMARK(suffix)                          \
+    JTEST_DEFINE_TEST(arm_median_filter_##suffix##_benchmark,           \
+                      arm_median_filter_##suffix)                       \
+    {                                                                   \
+        arm_median_filter_instance_##suffix median_inst;                \
+                                                                        \
+        arm_median_filter_init_##suffix(&median_inst,                   \
+                                        BENCHMARK_MEDIAN_WINDOW,        \
+                                        (void *) benchmark_state,       \
+                                        median_filter_index);           \
+                                                                        \
+        BENCHMARK_DO_BLOCKSIZES(                                        \
+            JTEST_BENCH(STR(arm_median_filter_##suffix),                \
+                        blockSize, BENCHMARK_MEDIAN_WINDOW, blockSize,  \
+                        arm_median_filter_##suffix(                     \
+                            &median_inst,                               \
+                            benchmark_input_##suffix,                   \
+                            benchmark_output_##suffix,                  \
+                            blockSize)));                               \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+MEDIAN_FILTER_DEFINE_BENCHMARK(f32);
+MEDIAN_FILTER_DEFINE_BENCHMARK(q31);
+MEDIAN_FILTER_DEFINE_BENCHMARK(q15);
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all benchmarks in a group. */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(filtering_benchmarks)
+{
+    /*
+      To skip a benchmark, comment it out.
+    */
+    JTEST_TEST_CALL(arm_fir_f32_benchmark);
+    JTEST_TEST_CALL(arm_fir_q31_benchmark);
+    JTEST_TEST_CALL(arm_fir_fast_q31_benchmark);
+    JTEST_TEST_CALL(arm_fir_q15_benchmark);
+    JTEST_TEST_CALL(arm_fir_fast_q15_benchmark);
+    JTEST_TEST_CALL(arm_fir_q7_benchmark);
+    JTEST_TEST_CALL(arm_fir_mc_f32_benchmark);
+    JTEST_TEST_CALL(arm_fir_mc_q31_benchmark);
+    JTEST_TEST_CALL(arm_fir_mc_q15_benchmark);
+    JTEST_TEST_CALL(arm_fir_long_f32_benchmark);
+    JTEST_TEST_CALL(arm_fir_fft_f32_benchmark);
+
+    JTEST_TEST_CALL(arm_fir_decimate_f32_benchmark);
+    JTEST_TEST_CALL(arm_fir_decimate_q31_benchmark);
+    JTEST_TEST_CALL(arm_fir_decimate_fast_q31_benchmark);
+    JTEST_TEST_CALL(arm_fir_decimate_q15_benchmark);
+    JTEST_TEST_CALL(arm_fir_decimate_fast_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_fir_interpolate_f32_benchmark);
+    JTEST_TEST_CALL(arm_fir_interpolate_q31_benchmark);
+    JTEST_TEST_CALL(arm_fir_interpolate_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_biquad_cascade_df1_f32_benchmark);
+    JTEST_TEST_CALL(arm_biquad_cascade_df2T_f32_benchmark);
+    JTEST_TEST_CALL(arm_biquad_cascade_stereo_df2T_f32_benchmark);
+    JTEST_TEST_CALL(arm_biquad_cascade_df1_q31_benchmark);
+    JTEST_TEST_CALL(arm_biquad_cascade_df1_fast_q31_benchmark);
+    JTEST_TEST_CALL(arm_biquad_cas_df1_32x64_q31_benchmark);
+    JTEST_TEST_CALL(arm_biquad_cascade_df1_q15_benchmark);
+    JTEST_TEST_CALL(arm_biquad_cascade_df1_fast_q15_benchmark);
+    JTEST_TEST_CALL(arm_biquad_cascade_mc_df2T_f32_benchmark);
+    JTEST_TEST_CALL(arm_biquad_cascade_mc_df1_q31_benchmark);
+    JTEST_TEST_CALL(arm_biquad_cascade_mc_df1_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_conv_f32_benchmark);
+    JTEST_TEST_CALL(arm_conv_q31_benchmark);
+    JTEST_TEST_CALL(arm_conv_fast_q31_benchmark);
+    JTEST_TEST_CALL(arm_conv_q15_benchmark);
+    JTEST_TEST_CALL(arm_conv_fast_q15_benchmark);
+    JTEST_TEST_CALL(arm_conv_fast_opt_q15_benchmark);
+    JTEST_TEST_CALL(arm_conv_q7_benchmark);
+
+    JTEST_TEST_CALL(arm_correlate_f32_benchmark);
+    JTEST_TEST_CALL(arm_correlate_q31_benchmark);
+    JTEST_TEST_CALL(arm_correlate_fast_q31_benchmark);
+    JTEST_TEST_CALL(arm_correlate_q15_benchmark);
+    JTEST_TEST_CALL(arm_correlate_fast_q15_benchmark);
+    JTEST_TEST_CALL(arm_correlate_fast_opt_q15_benchmark);
+    JTEST_TEST_CALL(arm_correlate_q7_benchmark);
+
+    JTEST_TEST_CALL(arm_lms_f32_benchmark);
+    JTEST_TEST_CALL(arm_lms_q31_benchmark);
+    JTEST_TEST_CALL(arm_lms_q15_benchmark);
+    JTEST_TEST_CALL(arm_lms_norm_f32_benchmark);
+    JTEST_TEST_CALL(arm_lms_norm_q31_benchmark);
+    JTEST_TEST_CALL(arm_lms_norm_q15_benchmark);
+
+    JTEST_TEST_CALL(arm_median_filter_f32_benchmark);
+    JTEST_TEST_CALL(arm_median_filter_q31_benchmark);
+    JTEST_TEST_CALL(arm_median_filter_q15_benchmark);
+}
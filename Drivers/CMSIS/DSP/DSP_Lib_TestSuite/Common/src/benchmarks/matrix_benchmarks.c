@@ -0,0 +1,122 @@
+#include "jtest.h"
+#include "arm_math.h"           /* FUTs */
+#include "benchmark_templates.h"
+#include "benchmark_data.h"
+#include "benchmarks.h"
+
+/*--------------------------------------------------------------------------------*/
+/* Benchmark Definitions */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  Square matrices over the dimensions, matDim * matDim samples are
+ *  produced. The matrix instances mat_a, mat_b and mat_dst are set up before
+ *  fn_call.
+ */
+#define MATRIX_DEFINE_BENCHMARK(fn_name, suffix, fn_call)               \
+    JTEST_DEFINE_TEST(fn_name##_benchmark, fn_name)                     \
+    {                                                                   \
+        arm_matrix_instance_##suffix mat_a;                             \
+        arm_matrix_instance_##suffix mat_b;                             \
+        arm_matrix_instance_##suffix mat_dst;                           \
+                                                                        \
+        BENCHMARK_DO_MATDIMS(                                           \
+            arm_mat_init_##suffix(&mat_a, matDim, matDim,               \
+                                  benchmark_input_##suffix);            \
+            arm_mat_init_##suffix(&mat_b, matDim, matDim,               \
+                                  benchmark_input2_##suffix);           \
+            arm_mat_init_##suffix(&mat_dst, matDim, matDim,             \
+                                  benchmark_output_##suffix);           \
+                                                                        \
+            JTEST_BENCH(STR(fn_name), matDim, 0, matDim * matDim,       \
+                        fn_call));                                      \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+#define MATRIX_DEFINE_BINARY_BENCHMARK(fn_name, suffix)                 \
+    MATRIX_DEFINE_BENCHMARK(fn_name##_##suffix, suffix,                 \
+                            fn_name##_##suffix(&mat_a, &mat_b, &mat_dst))
+
+#define MATRIX_DEFINE_UNARY_BENCHMARK(fn_name, suffix)                  \
+    MATRIX_DEFINE_BENCHMARK(fn_name##_##suffix, suffix,                 \
+                            fn_name##_##suffix(&mat_a, &mat_dst))
+
+MATRIX_DEFINE_BINARY_BENCHMARK(arm_mat_add, f32);
+MATRIX_DEFINE_BINARY_BENCHMARK(arm_mat_add, q31);
+MATRIX_DEFINE_BINARY_BENCHMARK(arm_mat_add, q15);
+
+MATRIX_DEFINE_BINARY_BENCHMARK(arm_mat_sub, f32);
+MATRIX_DEFINE_BINARY_BENCHMARK(arm_mat_sub, q31);
+MATRIX_DEFINE_BINARY_BENCHMARK(arm_mat_sub, q15);
+
+MATRIX_DEFINE_BINARY_BENCHMARK(arm_mat_mult, f32);
+MATRIX_DEFINE_BINARY_BENCHMARK(arm_mat_mult, q31);
+MATRIX_DEFINE_BINARY_BENCHMARK(arm_mat_mult_fast, q31);
+
+/* The q15 multiplications transpose B into the state */
+MATRIX_DEFINE_BENCHMARK(arm_mat_mult_q15, q15,
+                        arm_mat_mult_q15(&mat_a, &mat_b, &mat_dst,
+                                         (q15_t *) benchmark_state));
+MATRIX_DEFINE_BENCHMARK(arm_mat_mult_fast_q15, q15,
+                        arm_mat_mult_fast_q15(&mat_a, &mat_b, &mat_dst,
+                                              (q15_t *) benchmark_state));
+
+MATRIX_DEFINE_UNARY_BENCHMARK(arm_mat_trans, f32);
+MATRIX_DEFINE_UNARY_BENCHMARK(arm_mat_trans, q31);
+MATRIX_DEFINE_UNARY_BENCHMARK(arm_mat_trans, q15);
+
+MATRIX_DEFINE_BENCHMARK(arm_mat_scale_f32, f32,
+                        arm_mat_scale_f32(&mat_a, 0.5f, &mat_dst));
+MATRIX_DEFINE_BENCHMARK(arm_mat_scale_q31, q31,
+                        arm_mat_scale_q31(&mat_a, 0x40000000, 0, &mat_dst));
+MATRIX_DEFINE_BENCHMARK(arm_mat_scale_q15, q15,
+                        arm_mat_scale_q15(&mat_a, 0x4000, 0, &mat_dst));
+
+/* The inverse works in place on A, a copy of the input is taken each run */
+JTEST_DEFINE_TEST(arm_mat_inverse_f32_benchmark,
+                  arm_mat_inverse_f32)
+{
+    arm_matrix_instance_f32 mat_a;
+    arm_matrix_instance_f32 mat_dst;
+
+    BENCHMARK_DO_MATDIMS(
+        arm_mat_init_f32(&mat_a, matDim, matDim, benchmark_output2_f32);
+        arm_mat_init_f32(&mat_dst, matDim, matDim, benchmark_output_f32);
+
+        JTEST_BENCH_SETUP("arm_mat_inverse_f32", matDim, 0, matDim * matDim,
+                          memcpy(benchmark_output2_f32, benchmark_input_f32,
+                                 matDim * matDim * sizeof(float32_t)),
+                          arm_mat_inverse_f32(&mat_a, &mat_dst)));
+
+    return JTEST_TEST_PASSED;
+}
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all benchmarks in a group. */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(matrix_benchmarks)
+{
+    /*
+      To skip a benchmark, comment it out.
+    */
+    JTEST_TEST_CALL(arm_mat_add_f32_benchmark);
+    JTEST_TEST_CALL(arm_mat_add_q31_benchmark);
+    JTEST_TEST_CALL(arm_mat_add_q15_benchmark);
+    JTEST_TEST_CALL(arm_mat_sub_f32_benchmark);
+    JTEST_TEST_CALL(arm_mat_sub_q31_benchmark);
+    JTEST_TEST_CALL(arm_mat_sub_q15_benchmark);
+    JTEST_TEST_CALL(arm_mat_mult_f32_benchmark);
+    JTEST_TEST_CALL(arm_mat_mult_q31_benchmark);
+    JTEST_TEST_CALL(arm_mat_mult_fast_q31_benchmark);
+    JTEST_TEST_CALL(arm_mat_mult_q15_benchmark);
+    JTEST_TEST_CALL(arm_mat_mult_fast_q15_benchmark);
+    JTEST_TEST_CALL(arm_mat_trans_f32_benchmark);
+    JTEST_TEST_CALL(arm_mat_trans_q31_benchmark);
+    JTEST_TEST_CALL(arm_mat_trans_q15_benchmark);
+    JTEST_TEST_CALL(arm_mat_scale_f32_benchmark);
+    JTEST_TEST_CALL(arm_mat_scale_q31_benchmark);
+    JTEST_TEST_CALL(arm_mat_scale_q15_benchmark);
+    JTEST_TEST_CALL(arm_mat_inverse_f32_benchmark);
+}
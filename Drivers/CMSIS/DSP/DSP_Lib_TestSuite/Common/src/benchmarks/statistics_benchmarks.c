@@ -0,0 +1,176 @@
+#include "jtest.h"
+#include "arm_math.h"           /* FUTs */
+#include "benchmark_templates.h"
+#include "benchmark_data.h"
+#include "benchmarks.h"
+#include "type_abbrev.h"
+
+/*--------------------------------------------------------------------------------*/
+/* Benchmark Definitions */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  Statistics of a block, fn(pSrc, blockSize, &result).
+ */
+#define STATS_DEFINE_BENCHMARK(fn_name, suffix, result_type)            \
+    JTEST_DEFINE_TEST(arm_##fn_name##_##suffix##_benchmark,             \
+                      arm_##fn_name##_##suffix)                         \
+    {                                                                   \
+        result_type result;                                             \
+                                                                        \
+        BENCHMARK_DO_BLOCKSIZES(                                        \
+            JTEST_BENCH(STR(arm_##fn_name##_##suffix),                  \
+                        blockSize, 0, blockSize,                        \
+                        arm_##fn_name##_##suffix(                       \
+                            benchmark_input_##suffix,                   \
+                            blockSize,                                  \
+                            &result)));                                 \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+/**
+ *  Extremes of a block, fn(pSrc, blockSize, &result, &index).
+ */
+#define STATS_DEFINE_INDEX_BENCHMARK(fn_name, suffix)                   \
+    JTEST_DEFINE_TEST(arm_##fn_name##_##suffix##_benchmark,             \
+                      arm_##fn_name##_##suffix)                         \
+    {                                                                   \
+        TYPE_FROM_ABBREV(suffix) result;                                \
+        uint32_t index;                                                 \
+                                                                        \
+        BENCHMARK_DO_BLOCKSIZES(                                        \
+            JTEST_BENCH(STR(arm_##fn_name##_##suffix),                  \
+                        blockSize, 0, blockSize,                        \
+                        arm_##fn_name##_##suffix(                       \
+                            benchmark_input_##suffix,                   \
+                            blockSize,                                  \
+                            &result,                                    \
+                            &index)));                                  \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+/**
+ *  Median of a block, selected in place. The input is copied into the output
+ *  buffer before each run, the copy is not timed.
+ */
+#define STATS_DEFINE_MEDIAN_BENCHMARK(suffix, half)                     \
+    JTEST_DEFINE_TEST(arm_percentile_##suffix##_benchmark,              \
+                      arm_percentile_##suffix)                          \
+    {                                                                   \
+        TYPE_FROM_ABBREV(suffix) result;                                \
+                                                                        \
+        BENCHMARK_DO_BLOCKSIZES(                                        \
+            JTEST_BENCH_SETUP(STR(arm_percentile_##suffix),             \
+                              blockSize, 0, blockSize,                  \
+                              memcpy(benchmark_output_##suffix,         \
+                                     benchmark_input_##suffix,          \
+                                     blockSize *                        \
+                                     sizeof(benchmark_input_##suffix[0])), \
+                              arm_percentile_##suffix(                  \
+                                  benchmark_output_##suffix,            \
+                                  blockSize,                            \
+                                  (half),                               \
+                                  &result)));                           \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+/*
+  The running statistics keep adding to the same instance, as on a stream: a
+  call costs one pass over the block and the merge into the running state.
+*/
+JTEST_DEFINE_TEST(arm_running_stats_f32_benchmark,
+                  arm_running_stats_f32)
+{
+    arm_running_stats_instance_f32 stats;
+
+    arm_running_stats_init_f32(&stats);
+
+    BENCHMARK_DO_BLOCKSIZES(
+        JTEST_BENCH("arm_running_stats_f32",
+                    blockSize, 0, blockSize,
+                    arm_running_stats_f32(
+                        &stats,
+                        benchmark_input_f32,
+                        blockSize)));
+
+    return JTEST_TEST_PASSED;
+}
+
+STATS_DEFINE_INDEX_BENCHMARK(max, f32);
+STATS_DEFINE_INDEX_BENCHMARK(max, q31);
+STATS_DEFINE_INDEX_BENCHMARK(max, q15);
+STATS_DEFINE_INDEX_BENCHMARK(max, q7);
+
+STATS_DEFINE_INDEX_BENCHMARK(min, f32);
+STATS_DEFINE_INDEX_BENCHMARK(min, q31);
+STATS_DEFINE_INDEX_BENCHMARK(min, q15);
+STATS_DEFINE_INDEX_BENCHMARK(min, q7);
+
+STATS_DEFINE_BENCHMARK(mean, f32, float32_t);
+STATS_DEFINE_BENCHMARK(mean, q31, q31_t);
+STATS_DEFINE_BENCHMARK(mean, q15, q15_t);
+STATS_DEFINE_BENCHMARK(mean, q7, q7_t);
+
+STATS_DEFINE_BENCHMARK(power, f32, float32_t);
+STATS_DEFINE_BENCHMARK(power, q31, q63_t);
+STATS_DEFINE_BENCHMARK(power, q15, q63_t);
+STATS_DEFINE_BENCHMARK(power, q7, q31_t);
+
+STATS_DEFINE_BENCHMARK(rms, f32, float32_t);
+STATS_DEFINE_BENCHMARK(rms, q31, q31_t);
+STATS_DEFINE_BENCHMARK(rms, q15, q15_t);
+
+STATS_DEFINE_BENCHMARK(std, f32, float32_t);
+STATS_DEFINE_BENCHMARK(std, q31, q31_t);
+STATS_DEFINE_BENCHMARK(std, q15, q15_t);
+
+STATS_DEFINE_BENCHMARK(var, f32, float32_t);
+STATS_DEFINE_BENCHMARK(var, q31, q31_t);
+STATS_DEFINE_BENCHMARK(var, q15, q15_t);
+
+STATS_DEFINE_MEDIAN_BENCHMARK(f32, 0.5f);
+STATS_DEFINE_MEDIAN_BENCHMARK(q31, 0x40000000);
+STATS_DEFINE_MEDIAN_BENCHMARK(q15, 0x4000);
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all benchmarks in a group. */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(statistics_benchmarks)
+{
+    /*
+      To skip a benchmark, comment it out.
+    */
+    JTEST_TEST_CALL(arm_max_f32_benchmark);
+    JTEST_TEST_CALL(arm_max_q31_benchmark);
+    JTEST_TEST_CALL(arm_max_q15_benchmark);
+    JTEST_TEST_CALL(arm_max_q7_benchmark);
+    JTEST_TEST_CALL(arm_min_f32_benchmark);
+    JTEST_TEST_CALL(arm_min_q31_benchmark);
+    JTEST_TEST_CALL(arm_min_q15_benchmark);
+    JTEST_TEST_CALL(arm_min_q7_benchmark);
+    JTEST_TEST_CALL(arm_mean_f32_benchmark);
+    JTEST_TEST_CALL(arm_mean_q31_benchmark);
+    JTEST_TEST_CALL(arm_mean_q15_benchmark);
+    JTEST_TEST_CALL(arm_mean_q7_benchmark);
+    JTEST_TEST_CALL(arm_power_f32_benchmark);
+    JTEST_TEST_CALL(arm_power_q31_benchmark);
+    JTEST_TEST_CALL(arm_power_q15_benchmark);
+    JTEST_TEST_CALL(arm_power_q7_benchmark);
+    JTEST_TEST_CALL(arm_rms_f32_benchmark);
+    JTEST_TEST_CALL(arm_rms_q31_benchmark);
+    JTEST_TEST_CALL(arm_rms_q15_benchmark);
+    JTEST_TEST_CALL(arm_std_f32_benchmark);
+    JTEST_TEST_CALL(arm_std_q31_benchmark);
+    JTEST_TEST_CALL(arm_std_q15_benchmark);
+    JTEST_TEST_CALL(arm_var_f32_benchmark);
+    JTEST_TEST_CALL(arm_var_q31_benchmark);
+    JTEST_TEST_CALL(arm_var_q15_benchmark);
+    JTEST_TEST_CALL(arm_running_stats_f32_benchmark);
+    JTEST_TEST_CALL(arm_percentile_f32_benchmark);
+    JTEST_TEST_CALL(arm_percentile_q31_benchmark);
+    JTEST_TEST_CALL(arm_percentile_q15_benchmark);
+}
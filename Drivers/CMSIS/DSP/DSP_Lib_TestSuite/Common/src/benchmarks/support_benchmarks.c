@@ -0,0 +1,105 @@
+#include "jtest.h"
+#include "arm_math.h"           /* FUTs */
+#include "benchmark_templates.h"
+#include "benchmark_data.h"
+#include "benchmarks.h"
+
+/*--------------------------------------------------------------------------------*/
+/* Benchmark Definitions */
+/*--------------------------------------------------------------------------------*/
+
+/* Copies and conversions, fn(pSrc, pDst, blockSize) */
+#define SUPPORT_DEFINE_CONVERT_BENCHMARK(from, to)                      \
+    BENCHMARK_DEFINE_BLOCK(arm_##from##_to_##to,                        \
+                           benchmark_input_##from,                      \
+                           benchmark_output_##to,                       \
+                           blockSize)
+
+#define SUPPORT_DEFINE_FILL_BENCHMARK(suffix, value)                    \
+    BENCHMARK_DEFINE_BLOCK(arm_fill_##suffix,                           \
+                           (value),                                     \
+                           benchmark_output_##suffix,                   \
+                           blockSize)
+
+/**
+ *  Sort in place. The input is copied into the output buffer before each run,
+ *  the copy is not timed.
+ */
+#define SUPPORT_DEFINE_SORT_BENCHMARK(suffix)                           \
+    JTEST_DEFINE_TEST(arm_sort_##suffix##_benchmark,                    \
+                      arm_sort_##suffix)                                \
+    {                                                                   \
+        BENCHMARK_DO_BLOCKSIZES(                                        \
+            JTEST_BENCH_SETUP(STR(arm_sort_##suffix),                   \
+                              blockSize, 0, blockSize,                  \
+                              memcpy(benchmark_output_##suffix,         \
+                                     benchmark_input_##suffix,          \
+                                     blockSize *                        \
+                                     sizeof(benchmark_input_##suffix[0])), \
+                              arm_sort_##suffix(                        \
+                                  benchmark_output_##suffix,            \
+                                  blockSize)));                         \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+BENCHMARK_DEFINE_UNARY(arm_copy, f32);
+BENCHMARK_DEFINE_UNARY(arm_copy, q31);
+BENCHMARK_DEFINE_UNARY(arm_copy, q15);
+BENCHMARK_DEFINE_UNARY(arm_copy, q7);
+
+SUPPORT_DEFINE_FILL_BENCHMARK(f32, 0.5f);
+SUPPORT_DEFINE_FILL_BENCHMARK(q31, 0x40000000);
+SUPPORT_DEFINE_FILL_BENCHMARK(q15, 0x4000);
+SUPPORT_DEFINE_FILL_BENCHMARK(q7, 0x40);
+
+SUPPORT_DEFINE_CONVERT_BENCHMARK(float, q31);
+SUPPORT_DEFINE_CONVERT_BENCHMARK(float, q15);
+SUPPORT_DEFINE_CONVERT_BENCHMARK(float, q7);
+SUPPORT_DEFINE_CONVERT_BENCHMARK(q31, float);
+SUPPORT_DEFINE_CONVERT_BENCHMARK(q31, q15);
+SUPPORT_DEFINE_CONVERT_BENCHMARK(q31, q7);
+SUPPORT_DEFINE_CONVERT_BENCHMARK(q15, float);
+SUPPORT_DEFINE_CONVERT_BENCHMARK(q15, q31);
+SUPPORT_DEFINE_CONVERT_BENCHMARK(q15, q7);
+SUPPORT_DEFINE_CONVERT_BENCHMARK(q7, float);
+SUPPORT_DEFINE_CONVERT_BENCHMARK(q7, q31);
+SUPPORT_DEFINE_CONVERT_BENCHMARK(q7, q15);
+
+SUPPORT_DEFINE_SORT_BENCHMARK(f32);
+SUPPORT_DEFINE_SORT_BENCHMARK(q31);
+SUPPORT_DEFINE_SORT_BENCHMARK(q15);
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all benchmarks in a group. */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(support_benchmarks)
+{
+    /*
+      To skip a benchmark, comment it out.
+    */
+    JTEST_TEST_CALL(arm_copy_f32_benchmark);
+    JTEST_TEST_CALL(arm_copy_q31_benchmark);
+    JTEST_TEST_CALL(arm_copy_q15_benchmark);
+    JTEST_TEST_CALL(arm_copy_q7_benchmark);
+    JTEST_TEST_CALL(arm_fill_f32_benchmark);
+    JTEST_TEST_CALL(arm_fill_q31_benchmark);
+    JTEST_TEST_CALL(arm_fill_q15_benchmark);
+    JTEST_TEST_CALL(arm_fill_q7_benchmark);
+    JTEST_TEST_CALL(arm_float_to_q31_benchmark);
+    JTEST_TEST_CALL(arm_float_to_q15_benchmark);
+    JTEST_TEST_CALL(arm_float_to_q7_benchmark);
+    JTEST_TEST_CALL(arm_q31_to_float_benchmark);
+    JTEST_TEST_CALL(arm_q31_to_q15_benchmark);
+    JTEST_TEST_CALL(arm_q31_to_q7_benchmark);
+    JTEST_TEST_CALL(arm_q15_to_float_benchmark);
+    JTEST_TEST_CALL(arm_q15_to_q31_benchmark);
+    JTEST_TEST_CALL(arm_q15_to_q7_benchmark);
+    JTEST_TEST_CALL(arm_q7_to_float_benchmark);
+    JTEST_TEST_CALL(arm_q7_to_q31_benchmark);
+    JTEST_TEST_CALL(arm_q7_to_q15_benchmark);
+    JTEST_TEST_CALL(arm_sort_f32_benchmark);
+    JTEST_TEST_CALL(arm_sort_q31_benchmark);
+    JTEST_TEST_CALL(arm_sort_q15_benchmark);
+}
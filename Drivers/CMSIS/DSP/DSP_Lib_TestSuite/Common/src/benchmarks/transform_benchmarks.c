@@ -0,0 +1,247 @@
+#include "jtest.h"
+#include "arm_math.h"           /* FUTs */
+#include "arm_const_structs.h"
+#include "benchmark_templates.h"
+#include "benchmark_data.h"
+#include "benchmarks.h"
+
+/*--------------------------------------------------------------------------------*/
+/* CFFT Structs */
+/*--------------------------------------------------------------------------------*/
+
+/* Same lengths as benchmark_fftlens */
+ARR_DESC_DEFINE(const arm_cfft_instance_f32 *,
+                benchmark_cfft_f32_structs,
+                9,
+                CURLY(
+                    &arm_cfft_sR_f32_len16,
+                    &arm_cfft_sR_f32_len32,
+                    &arm_cfft_sR_f32_len64,
+                    &arm_cfft_sR_f32_len128,
+                    &arm_cfft_sR_f32_len256,
+                    &arm_cfft_sR_f32_len512,
+                    &arm_cfft_sR_f32_len1024,
+                    &arm_cfft_sR_f32_len2048,
+                    &arm_cfft_sR_f32_len4096
+                    ));
+
+ARR_DESC_DEFINE(const arm_cfft_instance_q31 *,
+                benchmark_cfft_q31_structs,
+                9,
+                CURLY(
+                    &arm_cfft_sR_q31_len16,
+                    &arm_cfft_sR_q31_len32,
+                    &arm_cfft_sR_q31_len64,
+                    &arm_cfft_sR_q31_len128,
+                    &arm_cfft_sR_q31_len256,
+                    &arm_cfft_sR_q31_len512,
+                    &arm_cfft_sR_q31_len1024,
+                    &arm_cfft_sR_q31_len2048,
+                    &arm_cfft_sR_q31_len4096
+                    ));
+
+ARR_DESC_DEFINE(const arm_cfft_instance_q15 *,
+                benchmark_cfft_q15_structs,
+                9,
+                CURLY(
+                    &arm_cfft_sR_q15_len16,
+                    &arm_cfft_sR_q15_len32,
+                    &arm_cfft_sR_q15_len64,
+                    &arm_cfft_sR_q15_len128,
+                    &arm_cfft_sR_q15_len256,
+                    &arm_cfft_sR_q15_len512,
+                    &arm_cfft_sR_q15_len1024,
+                    &arm_cfft_sR_q15_len2048,
+                    &arm_cfft_sR_q15_len4096
+                    ));
+
+/*--------------------------------------------------------------------------------*/
+/* Benchmark Definitions */
+/*--------------------------------------------------------------------------------*/
+
+/**
+ *  Complex FFT in place, with bit reversal. The input is copied into the
+ *  output buffer before each run, the copy is not timed.
+ */
+#define CFFT_DEFINE_BENCHMARK(suffix, ifft_flag, name_suffix)           \
+    JTEST_DEFINE_TEST(arm_cfft##name_suffix##_##suffix##_benchmark,     \
+                      arm_cfft_##suffix)                                \
+    {                                                                   \
+        TEMPLATE_DO_ARR_DESC(                                           \
+            cfft_idx, const arm_cfft_instance_##suffix *, cfft_inst,    \
+            benchmark_cfft_##suffix##_structs,                          \
+            JTEST_BENCH_SETUP(STR(arm_cfft##name_suffix##_##suffix),    \
+                              cfft_inst->fftLen, 0, cfft_inst->fftLen,  \
+                              memcpy(benchmark_output_##suffix,         \
+                                     benchmark_input_##suffix,          \
+                                     2 * cfft_inst->fftLen *            \
+                                     sizeof(benchmark_input_##suffix[0])), \
+                              arm_cfft_##suffix(cfft_inst,              \
+                                                benchmark_output_##suffix, \
+                                                (ifft_flag), 1)));      \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+CFFT_DEFINE_BENCHMARK(f32, 0, );
+CFFT_DEFINE_BENCHMARK(f32, 1, _ifft);
+CFFT_DEFINE_BENCHMARK(q31, 0, );
+CFFT_DEFINE_BENCHMARK(q15, 0, );
+
+/**
+ *  Block floating-point Q15 FFT, run as CFFT_DEFINE_BENCHMARK(q15) for the
+ *  comparison.
+ */
+#define CFFT_BFP_DEFINE_BENCHMARK(ifft_flag, name_suffix)               \
+    JTEST_DEFINE_TEST(arm_cfft_bfp##name_suffix##_q15_benchmark,        \
+                      arm_cfft_bfp_q15)                                 \
+    {                                                                   \
+        int32_t block_exp;                                              \
+                                                                        \
+        TEMPLATE_DO_ARR_DESC(                                           \
+            cfft_idx, const arm_cfft_instance_q15 *, cfft_inst,         \
+            benchmark_cfft_q15_structs,                                 \
+            JTEST_BENCH_SETUP(STR(arm_cfft_bfp##name_suffix##_q15),     \
+                              cfft_inst->fftLen, 0, cfft_inst->fftLen,  \
+                              memcpy(benchmark_output_q15,              \
+                                     benchmark_input_q15,               \
+                                     2 * cfft_inst->fftLen *            \
+                                     sizeof(q15_t)),                    \
+                              arm_cfft_bfp_q15(cfft_inst,               \
+                                               benchmark_output_q15,    \
+                                               (ifft_flag), 1,          \
+                                               &block_exp)));           \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+CFFT_BFP_DEFINE_BENCHMARK(0, );
+CFFT_BFP_DEFINE_BENCHMARK(1, _ifft);
+
+/* Real FFT of fftLen samples, the input is overwritten */
+JTEST_DEFINE_TEST(arm_rfft_fast_f32_benchmark,
+                  arm_rfft_fast_f32)
+{
+    arm_rfft_fast_instance_f32 rfft_inst;
+
+    BENCHMARK_DO_FFTLENS(
+        benchmark_rfftlens,
+        arm_rfft_fast_init_f32(&rfft_inst, fftLen);
+
+        JTEST_BENCH_SETUP("arm_rfft_fast_f32", fftLen, 0, fftLen,
+                          memcpy(benchmark_output2_f32, benchmark_input_f32,
+                                 fftLen * sizeof(float32_t)),
+                          arm_rfft_fast_f32(&rfft_inst,
+                                            benchmark_output2_f32,
+                                            benchmark_output_f32,
+                                            0)));
+
+    return JTEST_TEST_PASSED;
+}
+
+/**
+ *  Fixed-point real FFTs of fftLen samples.
+ */
+#define RFFT_DEFINE_BENCHMARK(suffix)                                   \
+    JTEST_DEFINE_TEST(arm_rfft_##suffix##_benchmark,                    \
+                      arm_rfft_##suffix)                                \
+    {                                                                   \
+        arm_rfft_instance_##suffix rfft_inst;                           \
+                                                                        \
+        BENCHMARK_DO_FFTLENS(                                           \
+            benchmark_rfftlens,                                         \
+            arm_rfft_init_##suffix(&rfft_inst, fftLen, 0, 1);           \
+                                                                        \
+            JTEST_BENCH_SETUP(STR(arm_rfft_##suffix), fftLen, 0, fftLen, \
+                              memcpy(benchmark_output2_##suffix,        \
+                                     benchmark_input_##suffix,          \
+                                     fftLen *                           \
+                                     sizeof(benchmark_input_##suffix[0])), \
+                              arm_rfft_##suffix(&rfft_inst,             \
+                                                benchmark_output2_##suffix, \
+                                                benchmark_output_##suffix))); \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+RFFT_DEFINE_BENCHMARK(q31);
+RFFT_DEFINE_BENCHMARK(q15);
+
+/* Twiddles and work buffer of the mixed-radix FFTs */
+static float32_t benchmark_mr_twiddle[ARM_CFFT_MR_TWIDDLE_SIZE(BENCHMARK_MAX_MR_FFT_LEN)];
+static float32_t benchmark_mr_buffer[ARM_CFFT_MR_BUFFER_SIZE(BENCHMARK_MAX_MR_FFT_LEN)];
+
+/**
+ *  Mixed-radix complex FFT in place, the input copied as for arm_cfft.
+ */
+#define CFFT_MR_DEFINE_BENCHMARK(ifft_flag, name_suffix)                \
+    JTEST_DEFINE_TEST(arm_cfft_mr##name_suffix##_f32_benchmark,         \
+                      arm_cfft_mr_f32)                                  \
+    {                                                                   \
+        arm_cfft_mr_instance_f32 cfft_inst;                             \
+                                                                        \
+        BENCHMARK_DO_FFTLENS(                                           \
+            benchmark_mr_fftlens,                                       \
+            arm_cfft_mr_init_f32(&cfft_inst, fftLen,                    \
+                                 benchmark_mr_twiddle,                  \
+                                 benchmark_mr_buffer);                  \
+                                                                        \
+            JTEST_BENCH_SETUP(STR(arm_cfft_mr##name_suffix##_f32),      \
+                              fftLen, 0, fftLen,                        \
+                              memcpy(benchmark_output_f32,              \
+                                     benchmark_input_f32,               \
+                                     2 * fftLen * sizeof(float32_t)),   \
+                              arm_cfft_mr_f32(&cfft_inst,               \
+                                              benchmark_output_f32,     \
+                                              (ifft_flag))));           \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+CFFT_MR_DEFINE_BENCHMARK(0, );
+CFFT_MR_DEFINE_BENCHMARK(1, _ifft);
+
+/* Mixed-radix real FFT of fftLen samples, the input is overwritten */
+JTEST_DEFINE_TEST(arm_rfft_mr_f32_benchmark,
+                  arm_rfft_mr_f32)
+{
+    arm_rfft_mr_instance_f32 rfft_inst;
+
+    BENCHMARK_DO_FFTLENS(
+        benchmark_mr_fftlens,
+        arm_rfft_mr_init_f32(&rfft_inst, fftLen,
+                             benchmark_mr_twiddle, benchmark_mr_buffer);
+
+        JTEST_BENCH_SETUP("arm_rfft_mr_f32", fftLen, 0, fftLen,
+                          memcpy(benchmark_output2_f32, benchmark_input_f32,
+                                 fftLen * sizeof(float32_t)),
+                          arm_rfft_mr_f32(&rfft_inst,
+                                          benchmark_output2_f32,
+                                          benchmark_output_f32,
+                                          0)));
+
+    return JTEST_TEST_PASSED;
+}
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all benchmarks in a group. */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(transform_benchmarks)
+{
+    /*
+      To skip a benchmark, comment it out.
+    */
+    JTEST_TEST_CALL(arm_cfft_f32_benchmark);
+    JTEST_TEST_CALL(arm_cfft_ifft_f32_benchmark);
+    JTEST_TEST_CALL(arm_cfft_q31_benchmark);
+    JTEST_TEST_CALL(arm_cfft_q15_benchmark);
+    JTEST_TEST_CALL(arm_cfft_bfp_q15_benchmark);
+    JTEST_TEST_CALL(arm_cfft_bfp_ifft_q15_benchmark);
+    JTEST_TEST_CALL(arm_rfft_fast_f32_benchmark);
+    JTEST_TEST_CALL(arm_cfft_mr_f32_benchmark);
+    JTEST_TEST_CALL(arm_cfft_mr_ifft_f32_benchmark);
+    JTEST_TEST_CALL(arm_rfft_mr_f32_benchmark);
+    JTEST_TEST_CALL(arm_rfft_q31_benchmark);
+    JTEST_TEST_CALL(arm_rfft_q15_benchmark);
+}
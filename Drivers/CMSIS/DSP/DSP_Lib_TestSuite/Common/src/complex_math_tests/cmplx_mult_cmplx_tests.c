@@ -7,17 +7,17 @@
 #include "complex_math_templates.h"
 #include "type_abbrev.h"
 
-#define JTEST_ARM_CMPLX_MULT_CMPLX_TEST(suffix) \
-    COMPLEX_MATH_DEFINE_TEST_TEMPLATE_BUF2_BLK( \
-        cmplx_mult_cmplx,                       \
-        suffix,                                 \
-        TYPE_FROM_ABBREV(suffix),               \
-        TYPE_FROM_ABBREV(suffix),               \
-        COMPLEX_MATH_COMPARE_CMPLX_INTERFACE)
+#define JTEST_ARM_CMPLX_MULT_CMPLX_TEST(suffix, comparison_interface)  \
+    COMPLEX_MATH_DEFINE_TEST_TEMPLATE_BUF2_BLK(                         \
+        cmplx_mult_cmplx,                                               \
+        suffix,                                                         \
+        TYPE_FROM_ABBREV(suffix),                                       \
+        TYPE_FROM_ABBREV(suffix),                                       \
+        comparison_interface)
 
-JTEST_ARM_CMPLX_MULT_CMPLX_TEST(f32);
-JTEST_ARM_CMPLX_MULT_CMPLX_TEST(q31);
-JTEST_ARM_CMPLX_MULT_CMPLX_TEST(q15);
+JTEST_ARM_CMPLX_MULT_CMPLX_TEST(f32, COMPLEX_MATH_SNR_COMPARE_CMPLX_INTERFACE);
+JTEST_ARM_CMPLX_MULT_CMPLX_TEST(q31, COMPLEX_MATH_COMPARE_CMPLX_INTERFACE);
+JTEST_ARM_CMPLX_MULT_CMPLX_TEST(q15, COMPLEX_MATH_COMPARE_CMPLX_INTERFACE);
 
 /*--------------------------------------------------------------------------------*/
 /* Collect all tests in a group. */
@@ -5,6 +5,222 @@
 #include "fast_math_test_data.h"
 #include "type_abbrev.h"
 
+/* Inputs of the block functions */
+static float32_t fast_math_block_a[FAST_MATH_MAX_LEN];
+static float32_t fast_math_block_b[FAST_MATH_MAX_LEN];
+
+static uint32_t fast_math_seed;
+
+/**
+ *  Pseudo-random 32-bit value.
+ */
+static uint32_t fast_math_rand(void)
+{
+    fast_math_seed = fast_math_seed * 1664525 + 1013904223;
+    return fast_math_seed;
+}
+
+/**
+ *  Pseudo-random float32_t value in [lo, hi).
+ */
+static float32_t fast_math_uniform(float32_t lo, float32_t hi)
+{
+    return lo + (hi - lo) * (float32_t)(fast_math_rand() >> 8) / 16777216.0f;
+}
+
+/**
+ *  Angles in radians: half of them within 2 turns, the others up to 8192.
+ */
+static void fast_math_fill_angle_f32(float32_t * pDst, uint32_t blockSize)
+{
+    uint32_t i;
+
+    fast_math_seed = 12345;
+    for (i = 0; i < blockSize; i++)
+    {
+        pDst[i] = (i < blockSize / 2) ? fast_math_uniform(-12.6f, 12.6f) :
+                                        fast_math_uniform(-8192.0f, 8192.0f);
+    }
+}
+
+/**
+ *  Q31 angles over the whole range, 1.0 is 2*pi.
+ */
+static void fast_math_fill_angle_q31(q31_t * pDst, uint32_t blockSize)
+{
+    uint32_t i;
+
+    fast_math_seed = 23456;
+    for (i = 0; i < blockSize; i++)
+    {
+        pDst[i] = (q31_t)fast_math_rand();
+    }
+}
+
+/**
+ *  Points in the four quadrants, with magnitudes from 2^-20 to 2^20, and
+ *  points on the axes and at the origin.
+ */
+static void fast_math_fill_point_f32(float32_t * pY, float32_t * pX, uint32_t blockSize)
+{
+    uint32_t i;
+
+    fast_math_seed = 34567;
+    for (i = 0; i < blockSize; i++)
+    {
+        pY[i] = ldexpf(fast_math_uniform(-1.0f, 1.0f), (int)(fast_math_rand() % 41) - 20);
+        pX[i] = ldexpf(fast_math_uniform(-1.0f, 1.0f), (int)(fast_math_rand() % 41) - 20);
+        pY[i] = ((i % 16) == 1) ? 0.0f : pY[i];
+        pX[i] = ((i % 16) == 2) ? -0.0f : pX[i];
+        pY[i] = ((i % 64) == 3) ? -0.0f : pY[i];
+        pX[i] = ((i % 64) == 3) ? 0.0f : pX[i];
+        pX[i] = ((i % 16) == 4) ? pY[i] : pX[i];
+    }
+}
+
+/**
+ *  Q31 points with magnitudes from 2^-24 to 1, on the axes and at the origin.
+ */
+static void fast_math_fill_point_q31(q31_t * pY, q31_t * pX, uint32_t blockSize)
+{
+    uint32_t i;
+
+    fast_math_seed = 45678;
+    for (i = 0; i < blockSize; i++)
+    {
+        pY[i] = (q31_t)fast_math_rand() >> (fast_math_rand() % 24);
+        pX[i] = (q31_t)fast_math_rand() >> (fast_math_rand() % 24);
+        pY[i] = ((i % 16) == 1) ? 0 : pY[i];
+        pX[i] = ((i % 16) == 2) ? 0 : pX[i];
+        pY[i] = ((i % 64) == 3) ? 0 : pY[i];
+        pX[i] = ((i % 64) == 3) ? 0 : pX[i];
+        pX[i] = ((i % 16) == 4) ? -pY[i] : pX[i];
+        pY[i] = ((i % 64) == 5) ? (q31_t)0x80000000 : pY[i];
+    }
+}
+
+/**
+ *  Exponents from the smallest subnormal result to the largest finite one.
+ */
+static void fast_math_fill_exp_f32(float32_t * pDst, uint32_t blockSize)
+{
+    uint32_t i;
+
+    fast_math_seed = 56789;
+    for (i = 0; i < blockSize; i++)
+    {
+        pDst[i] = (i < blockSize / 2) ? fast_math_uniform(-2.0f, 2.0f) :
+                                        fast_math_uniform(-103.0f, 88.7f);
+    }
+}
+
+/**
+ *  Positive values: half of them in [0.5, 2], the others over all the finite
+ *  numbers, subnormals included.
+ */
+static void fast_math_fill_log_f32(float32_t * pDst, uint32_t blockSize)
+{
+    union
+    {
+        float32_t f;
+        uint32_t u;
+    } t;
+    uint32_t i;
+
+    fast_math_seed = 67890;
+    for (i = 0; i < blockSize; i++)
+    {
+        t.u = ((i % 16) == 1) ? (fast_math_rand() & 0x007FFFFF) :
+                                (fast_math_rand() % 0x7F800000);
+        pDst[i] = (i < blockSize / 2) ? fast_math_uniform(0.5f, 2.0f) : t.f;
+    }
+}
+
+/**
+ *  Q31 values down to 2^-31, and some zero and negative ones.
+ */
+static void fast_math_fill_log_q31(q31_t * pDst, uint32_t blockSize)
+{
+    uint32_t i;
+
+    fast_math_seed = 78901;
+    for (i = 0; i < blockSize; i++)
+    {
+        pDst[i] = (q31_t)(fast_math_rand() >> 1) >> (fast_math_rand() % 31);
+        pDst[i] = ((i % 64) == 1) ? 0 : pDst[i];
+        pDst[i] = ((i % 64) == 2) ? -pDst[i] : pDst[i];
+        pDst[i] = ((i % 64) == 3) ? 1 : pDst[i];
+    }
+}
+
+/**
+ *  Bases in [0.01, 100] and exponents in [-3, 3], with some zero exponents.
+ */
+static void fast_math_fill_pow_f32(float32_t * pA, float32_t * pB, uint32_t blockSize)
+{
+    uint32_t i;
+
+    fast_math_seed = 89012;
+    for (i = 0; i < blockSize; i++)
+    {
+        pA[i] = expf(fast_math_uniform(-4.6f, 4.6f));
+        pB[i] = ((i % 16) == 1) ? 0.0f : fast_math_uniform(-3.0f, 3.0f);
+    }
+}
+
+FAST_MATH_BLOCK_TEST_TEMPLATE_BUF1(f32, vsin, fast_math_fill_angle_f32, 1.2e-7, 0);
+FAST_MATH_BLOCK_TEST_TEMPLATE_BUF1(q31, vsin, fast_math_fill_angle_q31, 4, 0);
+FAST_MATH_BLOCK_TEST_TEMPLATE_BUF1(f32, vcos, fast_math_fill_angle_f32, 1.2e-7, 0);
+FAST_MATH_BLOCK_TEST_TEMPLATE_BUF1(q31, vcos, fast_math_fill_angle_q31, 4, 0);
+
+FAST_MATH_BLOCK_TEST_TEMPLATE_BUF2(f32, vatan2, fast_math_fill_point_f32, 0, 2.4e-7);
+FAST_MATH_BLOCK_TEST_TEMPLATE_BUF2(q31, vatan2, fast_math_fill_point_q31, 4, 0);
+
+FAST_MATH_BLOCK_TEST_TEMPLATE_BUF1(f32, vexp, fast_math_fill_exp_f32, 3e-45, 2.4e-7);
+
+FAST_MATH_BLOCK_TEST_TEMPLATE_BUF1(f32, vlog, fast_math_fill_log_f32, 1.2e-7, 2.4e-7);
+FAST_MATH_BLOCK_TEST_TEMPLATE_BUF1(f32, vlog10, fast_math_fill_log_f32, 1.2e-7, 2.4e-7);
+FAST_MATH_BLOCK_TEST_TEMPLATE_BUF1(q31, vlog, fast_math_fill_log_q31, 1, 0);
+
+FAST_MATH_BLOCK_TEST_TEMPLATE_BUF2(f32, vpow, fast_math_fill_pow_f32, 0, 2e-6);
+
+/**
+ *  Infinite, NaN and zero inputs, and the limits of the ranges: the results
+ *  must match the C library.
+ */
+JTEST_DEFINE_TEST(arm_vmath_special_f32_test, arm_vexp_f32)
+{
+    float32_t exp_in[] = { 0.0f, -0.0f, INFINITY, -INFINITY, NAN, 88.7f, 89.0f, -103.2f, -104.0f };
+    float32_t log_in[] = { 1.0f, 0.0f, -0.0f, -1.0f, INFINITY, -INFINITY, NAN, 1.4e-45f, 3.4e38f };
+    float32_t atan2_y[] = { 0.0f, -0.0f, 0.0f, -0.0f, 1.0f, -1.0f, 0.0f, 1.0f, 1.0f, INFINITY };
+    float32_t atan2_x[] = { 0.0f, 0.0f, -0.0f, -0.0f, 0.0f, 0.0f, -1.0f, INFINITY, -INFINITY, 1.0f };
+    float32_t pow_a[] = { 0.0f, 0.0f, 0.0f, 5.0f, INFINITY, NAN, 2.0f, 1.0f };
+    float32_t pow_b[] = { 2.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.5f, 3.0f };
+    uint32_t n;
+
+    n = sizeof(exp_in) / sizeof(float32_t);
+    arm_vexp_f32(exp_in, fast_math_output_fut, n);
+    ref_vexp_f32(exp_in, fast_math_output_ref, n);
+    FAST_MATH_ASSERT_CLOSE(fast_math_output_ref, fast_math_output_fut, n, 3e-45, 2.4e-7);
+
+    n = sizeof(log_in) / sizeof(float32_t);
+    arm_vlog_f32(log_in, fast_math_output_fut, n);
+    ref_vlog_f32(log_in, fast_math_output_ref, n);
+    FAST_MATH_ASSERT_CLOSE(fast_math_output_ref, fast_math_output_fut, n, 0, 2.4e-7);
+
+    n = sizeof(atan2_y) / sizeof(float32_t);
+    arm_vatan2_f32(atan2_y, atan2_x, fast_math_output_fut, n);
+    ref_vatan2_f32(atan2_y, atan2_x, fast_math_output_ref, n);
+    FAST_MATH_ASSERT_CLOSE(fast_math_output_ref, fast_math_output_fut, n, 0, 2.4e-7);
+
+    n = sizeof(pow_a) / sizeof(float32_t);
+    arm_vpow_f32(pow_a, pow_b, fast_math_output_fut, n);
+    ref_vpow_f32(pow_a, pow_b, fast_math_output_ref, n);
+    FAST_MATH_ASSERT_CLOSE(fast_math_output_ref, fast_math_output_fut, n, 0, 2.4e-7);
+
+    return JTEST_TEST_PASSED;
+}
+
 SQRT_TEST_TEMPLATE_ELT1(q31);
 SQRT_TEST_TEMPLATE_ELT1(q15);
 
@@ -35,4 +251,22 @@ JTEST_DEFINE_GROUP(fast_math_tests)
     JTEST_TEST_CALL(arm_cos_f32_test);
     JTEST_TEST_CALL(arm_cos_q31_test);
     JTEST_TEST_CALL(arm_cos_q15_test);
+
+    JTEST_TEST_CALL(arm_vsin_f32_test);
+    JTEST_TEST_CALL(arm_vsin_q31_test);
+    JTEST_TEST_CALL(arm_vcos_f32_test);
+    JTEST_TEST_CALL(arm_vcos_q31_test);
+
+    JTEST_TEST_CALL(arm_vatan2_f32_test);
+    JTEST_TEST_CALL(arm_vatan2_q31_test);
+
+    JTEST_TEST_CALL(arm_vexp_f32_test);
+
+    JTEST_TEST_CALL(arm_vlog_f32_test);
+    JTEST_TEST_CALL(arm_vlog10_f32_test);
+    JTEST_TEST_CALL(arm_vlog_q31_test);
+
+    JTEST_TEST_CALL(arm_vpow_f32_test);
+
+    JTEST_TEST_CALL(arm_vmath_special_f32_test);
 }
@@ -113,6 +113,134 @@
    }
 
 
+/*
+  The lanes of the multi-channel kernel round every product, where the compiler
+  may fuse the scalar reference into multiply-adds (-mfma). Over a cascade of
+  stages the two roundings drift apart by a few dB, so the floating-point
+  multi-channel outputs are compared with a lower SNR threshold.
+*/
+#define BIQUAD_MC_SNR_THRESHOLD_float32_t 90
+
+#define BIQUAD_MC_DEFINE_TEST(suffix, instance_name, config_suffix, output_type)    \
+   JTEST_DEFINE_TEST(arm_biquad_cascade_mc_##config_suffix##_##suffix##_test,       \
+         arm_biquad_cascade_mc_##config_suffix##_##suffix)                          \
+   {                                                                                \
+      instance_name biquad_inst_fut = { 0 };                                        \
+      instance_name biquad_inst_ref = { 0 };                                        \
+                                                                                    \
+      TEMPLATE_DO_ARR_DESC(                                                         \
+            blocksize_idx, uint32_t, blockSize, filtering_blocksizes                \
+            ,                                                                       \
+         TEMPLATE_DO_ARR_DESC(                                                      \
+               numstages_idx, uint16_t, numStages, filtering_numstages              \
+               ,                                                                    \
+            TEMPLATE_DO_ARR_DESC(                                                   \
+                  numchannels_idx, uint16_t, numChannels, filtering_numchannels     \
+                  ,                                                                 \
+                  /* Display test parameter values */                               \
+                  JTEST_DUMP_STRF("Block Size: %d\n"                                \
+                                  "Number of Stages: %d\n"                          \
+                                  "Number of Channels: %d\n",                       \
+                                  (int)blockSize,                                   \
+                                  (int)numStages,                                   \
+                                  (int)numChannels);                                \
+                                                                                    \
+                  /* Initialize the BIQUAD Instances */                             \
+                  arm_biquad_cascade_mc_##config_suffix##_init_##suffix(            \
+                        &biquad_inst_fut, numChannels, numStages,                   \
+                        (output_type*)filtering_coeffs_b_##suffix,                  \
+                        (void *) filtering_pState);                                 \
+                                                                                    \
+                  JTEST_COUNT_CYCLES(                                               \
+                        arm_biquad_cascade_mc_##config_suffix##_##suffix(           \
+                              &biquad_inst_fut,                                     \
+                              (void *) filtering_##suffix##_inputs,                 \
+                              (void *) filtering_output_fut,                        \
+                              blockSize));                                          \
+                                                                                    \
+                  arm_biquad_cascade_mc_##config_suffix##_init_##suffix(            \
+                        &biquad_inst_ref, numChannels, numStages,                   \
+                        (output_type*)filtering_coeffs_b_##suffix,                  \
+                        (void *) filtering_pState);                                 \
+                                                                                    \
+                  ref_biquad_cascade_mc_##config_suffix##_##suffix(                 \
+                        &biquad_inst_ref,                                           \
+                        (void *) filtering_##suffix##_inputs,                       \
+                        (void *) filtering_output_ref,                              \
+                        blockSize);                                                 \
+                                                                                    \
+                  TEST_CONVERT_AND_ASSERT_SNR(                                      \
+                        filtering_output_f32_ref,                                   \
+                        (output_type *) filtering_output_ref,                       \
+                        filtering_output_f32_fut,                                   \
+                        (output_type *) filtering_output_fut,                       \
+                        blockSize * numChannels,                                    \
+                        output_type,                                                \
+                        BIQUAD_MC_SNR_THRESHOLD_##output_type))));                  \
+                                                                                    \
+            return JTEST_TEST_PASSED;                                               \
+   }
+
+#define BIQUAD_MC_WITH_POSTSHIFT_DEFINE_TEST(suffix, config_suffix, output_type)       \
+   JTEST_DEFINE_TEST(arm_biquad_cascade_mc_##config_suffix##_##suffix##_test,          \
+         arm_biquad_cascade_mc_##config_suffix##_##suffix)                             \
+   {                                                                                   \
+      arm_biquad_casd_mc_##config_suffix##_inst_##suffix biquad_inst_fut = { 0 };      \
+      arm_biquad_casd_mc_##config_suffix##_inst_##suffix biquad_inst_ref = { 0 };      \
+                                                                                       \
+      TEMPLATE_DO_ARR_DESC(                                                            \
+            blocksize_idx, uint32_t, blockSize, filtering_blocksizes                   \
+            ,                                                                          \
+         TEMPLATE_DO_ARR_DESC(                                                         \
+               numstages_idx, uint16_t, numStages, filtering_numstages                 \
+               ,                                                                       \
+            TEMPLATE_DO_ARR_DESC(                                                      \
+                  postshifts_idx, uint8_t, postShift, filtering_postshifts             \
+                  ,                                                                    \
+               TEMPLATE_DO_ARR_DESC(                                                   \
+                     numchannels_idx, uint16_t, numChannels, filtering_numchannels     \
+                     ,                                                                 \
+                     /* Display test parameter values */                               \
+                     JTEST_DUMP_STRF("Block Size: %d\n"                                \
+                                     "Number of Stages: %d\n"                          \
+                                     "Post Shift: %d\n"                                \
+                                     "Number of Channels: %d\n",                       \
+                                     (int)blockSize,                                   \
+                                     (int)numStages,                                   \
+                                     (int)postShift,                                   \
+                                     (int)numChannels);                                \
+                                                                                       \
+                     /* Initialize the BIQUAD Instances */                             \
+                     arm_biquad_cascade_mc_##config_suffix##_init_##suffix(            \
+                           &biquad_inst_fut, numChannels, numStages,                   \
+                           (output_type*)filtering_coeffs_b_##suffix,                  \
+                           (void *) filtering_pState, postShift);                      \
+                                                                                       \
+                     JTEST_COUNT_CYCLES(                                               \
+                           arm_biquad_cascade_mc_##config_suffix##_##suffix(           \
+                                 &biquad_inst_fut,                                     \
+                                 (void *) filtering_##suffix##_inputs,                 \
+                                 (void *) filtering_output_fut,                        \
+                                 blockSize));                                          \
+                                                                                       \
+                     arm_biquad_cascade_mc_##config_suffix##_init_##suffix(            \
+                           &biquad_inst_ref, numChannels, numStages,                   \
+                           (output_type*)filtering_coeffs_b_##suffix,                  \
+                           (void *) filtering_pState, postShift);                      \
+                                                                                       \
+                     ref_biquad_cascade_mc_##config_suffix##_##suffix(                 \
+                           &biquad_inst_ref,                                           \
+                           (void *) filtering_##suffix##_inputs,                       \
+                           (void *) filtering_output_ref,                              \
+                           blockSize);                                                 \
+                                                                                       \
+                     FILTERING_SNR_COMPARE_INTERFACE(                                  \
+                           blockSize * numChannels,                                    \
+                           output_type)))));                                           \
+                                                                                       \
+            return JTEST_TEST_PASSED;                                                  \
+   }
+
 JTEST_DEFINE_TEST(arm_biquad_cas_df1_32x64_q31_test,
       arm_biquad_cas_df1_32x64_q31)
 {
@@ -222,6 +350,9 @@ BIQUAD_WITH_POSTSHIFT_DEFINE_TEST(q31,df1,,q31_t);
 BIQUAD_WITH_POSTSHIFT_DEFINE_TEST(q15,df1,,q15_t);
 BIQUAD_WITH_POSTSHIFT_DEFINE_TEST(q31,df1,_fast,q31_t);
 BIQUAD_WITH_POSTSHIFT_DEFINE_TEST(q15,df1,_fast,q15_t);
+BIQUAD_MC_DEFINE_TEST(f32,arm_biquad_cascade_mc_df2T_instance_f32,df2T,float32_t);
+BIQUAD_MC_WITH_POSTSHIFT_DEFINE_TEST(q31,df1,q31_t);
+BIQUAD_MC_WITH_POSTSHIFT_DEFINE_TEST(q15,df1,q15_t);
 
 /*--------------------------------------------------------------------------------*/
 /* Collect all tests in a group. */
@@ -241,4 +372,7 @@ JTEST_DEFINE_GROUP(biquad_tests)
    JTEST_TEST_CALL(arm_biquad_cascade_df1_fast_q31_test);
    JTEST_TEST_CALL(arm_biquad_cascade_df1_fast_q15_test);
    JTEST_TEST_CALL(arm_biquad_cas_df1_32x64_q31_test);
+   JTEST_TEST_CALL(arm_biquad_cascade_mc_df2T_f32_test);
+   JTEST_TEST_CALL(arm_biquad_cascade_mc_df1_q31_test);
+   JTEST_TEST_CALL(arm_biquad_cascade_mc_df1_q15_test);
 }
@@ -560,6 +560,12 @@ ARR_DESC_DEFINE(uint16_t,
                 CURLY(
                       4, 6, 14, 32, FILTERING_MAX_NUMTAPS));
 
+ARR_DESC_DEFINE(uint16_t,
+                fir_fft_numtaps,
+                5,
+                CURLY(
+                      5, 33, 100, 300, FIR_FFT_MAX_NUMTAPS));
+
 ARR_DESC_DEFINE(uint16_t,
                 filtering_numtaps2,
                 5,
@@ -572,6 +578,18 @@ ARR_DESC_DEFINE(uint16_t,
                 CURLY(
                       1, 7, FILTERING_MAX_NUMSTAGES));
 
+ARR_DESC_DEFINE(uint16_t,
+                filtering_numchannels,
+                4,
+                CURLY(
+                      1, 3, 6, FILTERING_MAX_NUMCHANNELS));
+
+ARR_DESC_DEFINE(uint16_t,
+                filtering_median_windows,
+                6,
+                CURLY(
+                      1, 2, 3, 5, 8, FILTERING_MAX_MEDIAN_WINDOW));
+
 ARR_DESC_DEFINE(uint8_t,
                 filtering_postshifts,
                 3,
@@ -0,0 +1,124 @@
+#include "jtest.h"
+#include "filtering_test_data.h"
+#include "arr_desc.h"
+#include "arm_math.h"           /* FUTs */
+#include "ref.h"                /* Reference Functions */
+#include "test_templates.h"
+#include "filtering_templates.h"
+#include "type_abbrev.h"
+
+/* Partition spectra and delay line of the FUT, state of the reference */
+static float32_t fir_fft_buffer[ARM_FIR_FFT_BUFFER_SIZE(FIR_FFT_MAX_NUMTAPS,
+                                                        LMS_MAX_BLOCKSIZE)];
+static float32_t fir_fft_ref_state[FIR_FFT_MAX_NUMTAPS + LMS_MAX_BLOCKSIZE * 2];
+
+/* Coefficients long enough for every number of taps, offset from the inputs */
+#define FIR_FFT_COEFFS_F32 (filtering_f32_inputs + LMS_MAX_BLOCKSIZE * 2 - FIR_FFT_MAX_NUMTAPS)
+
+/*
+  FFT-based FIR function test. Two blocks are filtered, so that the second one
+  depends on the state left by the first, and compared with a single block of
+  the reference.
+*/
+JTEST_DEFINE_TEST(arm_fir_fft_f32_test,
+                  arm_fir_fft_f32)
+{
+    arm_fir_fft_instance_f32 fir_inst_fut;
+    arm_fir_instance_f32 fir_inst_ref = { 0 };
+
+    TEMPLATE_DO_ARR_DESC(
+        blocksize_idx, uint32_t, blockSize, lms_blocksizes
+        ,
+        TEMPLATE_DO_ARR_DESC(
+            numtaps_idx, uint16_t, numTaps, fir_fft_numtaps
+            ,
+            /* Initialize the FIR Instances */
+            TEST_ASSERT_EQUAL(
+                arm_fir_fft_init_f32(
+                    &fir_inst_fut, numTaps,
+                    (float32_t *) FIR_FFT_COEFFS_F32,
+                    fir_fft_buffer, blockSize), ARM_MATH_SUCCESS);
+
+            /* Display test parameter values */
+            JTEST_DUMP_STRF("Block Size: %d\n"
+                            "Number of Taps: %d\n"
+                            "Partition Length: %d\n",
+                            (int)blockSize,
+                            (int)numTaps,
+                            (int)fir_inst_fut.partLen);
+
+            JTEST_COUNT_CYCLES(
+                arm_fir_fft_f32(
+                    &fir_inst_fut,
+                    (void *) filtering_f32_inputs,
+                    (void *) filtering_output_fut,
+                    blockSize));
+
+            arm_fir_fft_f32(
+                &fir_inst_fut,
+                (void *) (filtering_f32_inputs + blockSize),
+                (void *) (filtering_output_fut + blockSize),
+                blockSize);
+
+            arm_fir_init_f32(
+                &fir_inst_ref, numTaps,
+                (float32_t *) FIR_FFT_COEFFS_F32,
+                fir_fft_ref_state, blockSize * 2);
+
+            ref_fir_f32(
+                &fir_inst_ref,
+                (void *) filtering_f32_inputs,
+                (void *) filtering_output_ref,
+                blockSize * 2);
+
+            FILTERING_SNR_COMPARE_INTERFACE(
+                blockSize * 2,
+                float32_t)));
+
+    return JTEST_TEST_PASSED;
+}
+
+/* Short filters stay in direct form, long ones are partitioned */
+JTEST_DEFINE_TEST(arm_fir_fft_init_f32_test,
+                  arm_fir_fft_init_f32)
+{
+    arm_fir_fft_instance_f32 fir_inst;
+
+    TEST_ASSERT_EQUAL(arm_fir_fft_init_f32(&fir_inst, 0, (float32_t *) FIR_FFT_COEFFS_F32,
+                                           fir_fft_buffer, 256),
+                      ARM_MATH_ARGUMENT_ERROR);
+
+    TEST_ASSERT_EQUAL(arm_fir_fft_init_f32(&fir_inst, 5, (float32_t *) FIR_FFT_COEFFS_F32,
+                                           fir_fft_buffer, 256),
+                      ARM_MATH_SUCCESS);
+    TEST_ASSERT_EQUAL(fir_inst.partLen, 0);
+
+    /* No power-of-two divisor of 16 or more */
+    TEST_ASSERT_EQUAL(arm_fir_fft_init_f32(&fir_inst, FIR_FFT_MAX_NUMTAPS,
+                                           (float32_t *) FIR_FFT_COEFFS_F32,
+                                           fir_fft_buffer, 120),
+                      ARM_MATH_SUCCESS);
+    TEST_ASSERT_EQUAL(fir_inst.partLen, 0);
+
+    TEST_ASSERT_EQUAL(arm_fir_fft_init_f32(&fir_inst, FIR_FFT_MAX_NUMTAPS,
+                                           (float32_t *) FIR_FFT_COEFFS_F32,
+                                           fir_fft_buffer, LMS_MAX_BLOCKSIZE),
+                      ARM_MATH_SUCCESS);
+    TEST_ASSERT_EQUAL((fir_inst.partLen != 0), 1);
+    TEST_ASSERT_EQUAL((LMS_MAX_BLOCKSIZE % fir_inst.partLen), 0);
+
+    return JTEST_TEST_PASSED;
+}
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all tests in a group */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(fir_fft_tests)
+{
+    /*
+      To skip a test, comment it out.
+    */
+    JTEST_TEST_CALL(arm_fir_fft_init_f32_test);
+    JTEST_TEST_CALL(arm_fir_fft_f32_test);
+}
@@ -339,6 +339,66 @@
             return JTEST_TEST_PASSED;                                   \
    }
 
+/* State of the multi-channel filters, larger than filtering_pState */
+static float32_t fir_mc_state[(FILTERING_MAX_NUMTAPS + FILTERING_MAX_BLOCKSIZE)
+                              * FILTERING_MAX_NUMCHANNELS];
+
+#define FIR_MC_DEFINE_TEST(suffix, output_type)                              \
+   JTEST_DEFINE_TEST(arm_fir_mc_##suffix##_test,                             \
+         arm_fir_mc_##suffix)                                                \
+   {                                                                         \
+      arm_fir_mc_instance_##suffix fir_inst_fut = { 0 };                     \
+      arm_fir_mc_instance_##suffix fir_inst_ref = { 0 };                     \
+                                                                             \
+      TEMPLATE_DO_ARR_DESC(                                                  \
+            blocksize_idx, uint32_t, blockSize, filtering_blocksizes         \
+            ,                                                                \
+         TEMPLATE_DO_ARR_DESC(                                               \
+               numtaps_idx, uint16_t, numTaps, filtering_numtaps             \
+               ,                                                             \
+            TEMPLATE_DO_ARR_DESC(                                            \
+                  numchannels_idx, uint16_t, numChannels,                    \
+                  filtering_numchannels                                      \
+                  ,                                                          \
+                  /* Display test parameter values */                        \
+                  JTEST_DUMP_STRF("Block Size: %d\n"                         \
+                                  "Number of Taps: %d\n"                     \
+                                  "Number of Channels: %d\n",                \
+                                  (int)blockSize,                            \
+                                  (int)numTaps,                              \
+                                  (int)numChannels);                         \
+                                                                             \
+                  /* Initialize the FIR Instances */                         \
+                  arm_fir_mc_init_##suffix(                                  \
+                        &fir_inst_fut, numChannels, numTaps,                 \
+                        (output_type*)filtering_coeffs_##suffix,             \
+                        (void *) fir_mc_state, blockSize);                   \
+                                                                             \
+                  JTEST_COUNT_CYCLES(                                        \
+                        arm_fir_mc_##suffix(                                 \
+                              &fir_inst_fut,                                 \
+                              (void *) filtering_##suffix##_inputs,          \
+                              (void *) filtering_output_fut,                 \
+                              blockSize));                                   \
+                                                                             \
+                  arm_fir_mc_init_##suffix(                                  \
+                        &fir_inst_ref, numChannels, numTaps,                 \
+                        (output_type*)filtering_coeffs_##suffix,             \
+                        (void *) fir_mc_state, blockSize);                   \
+                                                                             \
+                  ref_fir_mc_##suffix(                                       \
+                        &fir_inst_ref,                                       \
+                        (void *) filtering_##suffix##_inputs,                \
+                        (void *) filtering_output_ref,                       \
+                        blockSize);                                          \
+                                                                             \
+                  FILTERING_SNR_COMPARE_INTERFACE(                           \
+                        blockSize * numChannels,                             \
+                        output_type))));                                     \
+                                                                             \
+            return JTEST_TEST_PASSED;                                        \
+   }
+
 FIR_DEFINE_TEST(f32,,float32_t);
 FIR_DEFINE_TEST(q31,,q31_t);
 FIR_DEFINE_TEST(q15,,q15_t);
@@ -346,6 +406,10 @@ FIR_DEFINE_TEST(q31,_fast,q31_t);
 FIR_DEFINE_TEST(q15,_fast,q15_t);
 FIR_DEFINE_TEST(q7,,q7_t);
 
+FIR_MC_DEFINE_TEST(f32,float32_t);
+FIR_MC_DEFINE_TEST(q31,q31_t);
+FIR_MC_DEFINE_TEST(q15,q15_t);
+
 FIR_LATTICE_DEFINE_TEST(f32,float32_t);
 FIR_LATTICE_DEFINE_TEST(q31,q31_t);
 FIR_LATTICE_DEFINE_TEST(q15,q15_t);
@@ -381,6 +445,10 @@ JTEST_DEFINE_GROUP(fir_tests)
    JTEST_TEST_CALL(arm_fir_fast_q31_test);
    JTEST_TEST_CALL(arm_fir_fast_q15_test);
 
+   JTEST_TEST_CALL(arm_fir_mc_f32_test);
+   JTEST_TEST_CALL(arm_fir_mc_q31_test);
+   JTEST_TEST_CALL(arm_fir_mc_q15_test);
+
    JTEST_TEST_CALL(arm_fir_lattice_f32_test);
    JTEST_TEST_CALL(arm_fir_lattice_q31_test);
    JTEST_TEST_CALL(arm_fir_lattice_q15_test);
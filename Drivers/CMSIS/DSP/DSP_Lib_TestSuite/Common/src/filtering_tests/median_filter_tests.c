@@ -0,0 +1,89 @@
+#include "jtest.h"
+#include "filtering_test_data.h"
+#include "arr_desc.h"
+#include "arm_math.h"           /* FUTs */
+#include "ref.h"                /* Reference Functions */
+#include "test_templates.h"
+#include "filtering_templates.h"
+#include "type_abbrev.h"
+
+/* Window and heap of the FUT */
+static float32_t median_filter_state[FILTERING_MAX_MEDIAN_WINDOW];
+static int16_t median_filter_index[FILTERING_MAX_MEDIAN_WINDOW * 2];
+
+/*
+  Median filter function test. Two blocks are filtered, so that the second one
+  depends on the window left by the first, and compared with a single block of
+  the reference. The medians are samples of the input, or averages of two of
+  them, and must match exactly.
+*/
+#define MEDIAN_FILTER_DEFINE_TEST(suffix)                               \
+    JTEST_DEFINE_TEST(arm_median_filter_##suffix##_test,                \
+                      arm_median_filter_##suffix)                       \
+    {                                                                   \
+        arm_median_filter_instance_##suffix median_inst_fut;            \
+                                                                        \
+        TEMPLATE_DO_ARR_DESC(                                           \
+            blocksize_idx, uint32_t, blockSize, filtering_blocksizes    \
+            ,                                                           \
+            TEMPLATE_DO_ARR_DESC(                                       \
+                window_idx, uint16_t, windowSize,                       \
+                filtering_median_windows                                \
+                ,                                                       \
+                /* Initialize the median filter instance */             \
+                arm_median_filter_init_##suffix(                        \
+                    &median_inst_fut, windowSize,                       \
+                    (TYPE_FROM_ABBREV(suffix) *) median_filter_state,   \
+                    median_filter_index);                               \
+                                                                        \
+                /* Display test parameter values */                     \
+                JTEST_DUMP_STRF("Block Size: %d\n"                      \
+                                "Window Size: %d\n",                    \
+                                (int)blockSize,                         \
+                                (int)windowSize);                       \
+                                                                        \
+                JTEST_COUNT_CYCLES(                                     \
+                    arm_median_filter_##suffix(                         \
+                        &median_inst_fut,                               \
+                        (void *) filtering_##suffix##_inputs,           \
+                        (void *) filtering_output_fut,                  \
+                        blockSize));                                    \
+                                                                        \
+                arm_median_filter_##suffix(                             \
+                    &median_inst_fut,                                   \
+                    (void *) (filtering_##suffix##_inputs + blockSize), \
+                    (void *) ((TYPE_FROM_ABBREV(suffix) *)              \
+                              filtering_output_fut + blockSize),        \
+                    blockSize);                                         \
+                                                                        \
+                ref_median_filter_##suffix(                             \
+                    (void *) filtering_##suffix##_inputs,               \
+                    (void *) filtering_output_ref,                      \
+                    blockSize * 2,                                      \
+                    windowSize);                                        \
+                                                                        \
+                TEST_ASSERT_BUFFERS_EQUAL(                              \
+                    filtering_output_ref,                               \
+                    filtering_output_fut,                               \
+                    blockSize * 2 * sizeof(TYPE_FROM_ABBREV(suffix))))); \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+MEDIAN_FILTER_DEFINE_TEST(f32);
+MEDIAN_FILTER_DEFINE_TEST(q31);
+MEDIAN_FILTER_DEFINE_TEST(q15);
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all tests in a group */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(median_filter_tests)
+{
+    /*
+      To skip a test, comment it out.
+    */
+    JTEST_TEST_CALL(arm_median_filter_f32_test);
+    JTEST_TEST_CALL(arm_median_filter_q31_test);
+    JTEST_TEST_CALL(arm_median_filter_q15_test);
+}
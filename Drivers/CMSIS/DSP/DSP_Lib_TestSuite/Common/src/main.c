@@ -2,6 +2,11 @@
 #include "all_tests.h"
 #include "arm_math.h"
 
+#if defined(JTEST_BENCHMARK)
+#include "benchmark_group.h"
+#include "benchmark_data.h"
+#endif
+
 
 #if defined(__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050)
 asm(" .global __ARM_use_no_argv\n");
@@ -10,8 +15,10 @@ asm(" .global __ARM_use_no_argv\n");
 
 void debug_init(void)
 {
+#if !defined(ARM_MATH_HOST_X86)
     uint32_t * SHCSR_ptr = (uint32_t *) 0xE000ED24; /* System Handler Control and State Register */
     *SHCSR_ptr |= 0x70000;             /* Enable  UsageFault, BusFault, and MemManage fault*/
+#endif
 }
 
 int main(void)
@@ -20,7 +27,14 @@ int main(void)
 
     JTEST_INIT();               /* Initialize test framework. */
 
+#if defined(JTEST_BENCHMARK)
+    benchmark_fill_inputs();
+    jtest_bench_init();
+
+    JTEST_GROUP_CALL(all_benchmarks); /* Run all benchmarks, CSV on the data channel. */
+#else
     JTEST_GROUP_CALL(all_tests); /* Run all tests. */
+#endif
 
     JTEST_ACT_EXIT_FW();        /* Exit test framework.  */
     while (1);                   /* Never return. */
@@ -0,0 +1,203 @@
+#include "jtest.h"
+#include "statistics_test_data.h"
+#include "arr_desc.h"
+#include "arm_math.h"           /* FUTs */
+#include "ref.h"                /* Reference Functions */
+#include "test_templates.h"
+#include "statistics_templates.h"
+#include "type_abbrev.h"
+
+static float32_t percentile_input[STATISTICS_ORDER_MAX_BLOCKSIZE];
+static float32_t percentile_fut[STATISTICS_ORDER_MAX_BLOCKSIZE];
+static float32_t percentile_ref[STATISTICS_ORDER_MAX_BLOCKSIZE];
+
+/**
+ *  Fill percentile_input with blockSize Q31 inputs: random ones, with a tie
+ *  every 4 samples.
+ */
+static void percentile_fill_q31(
+    uint32_t blockSize)
+{
+    q31_t * pDst = (q31_t *) percentile_input;
+    uint32_t seed = 54321;
+    uint32_t i;
+
+    for (i = 0; i < blockSize; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        pDst[i] = ((i & 3) == 3) ? pDst[i - 1] : (q31_t) seed;
+    }
+}
+
+/**
+ *  Convert the Q31 inputs to the type of suffix, in place.
+ */
+#define PERCENTILE_CONVERT_f32(blockSize)                               \
+    do                                                                  \
+    {                                                                   \
+        memcpy(percentile_ref, percentile_input,                        \
+               blockSize * sizeof(q31_t));                              \
+        arm_q31_to_float((q31_t *) percentile_ref, percentile_input,    \
+                         blockSize);                                    \
+    } while (0)
+
+#define PERCENTILE_CONVERT_q31(blockSize)
+
+#define PERCENTILE_CONVERT_q15(blockSize)                               \
+    do                                                                  \
+    {                                                                   \
+        memcpy(percentile_ref, percentile_input,                        \
+               blockSize * sizeof(q31_t));                              \
+        arm_q31_to_q15((q31_t *) percentile_ref,                        \
+                       (q15_t *) percentile_input, blockSize);          \
+    } while (0)
+
+/**
+ *  Convert the float32_t fraction to the type of suffix.
+ */
+#define PERCENTILE_FRACTION_f32(fraction, pDst)                         \
+    (*(pDst) = (fraction))
+
+#define PERCENTILE_FRACTION_q31(fraction, pDst)                         \
+    arm_float_to_q31(&(fraction), (pDst), 1)
+
+#define PERCENTILE_FRACTION_q15(fraction, pDst)                         \
+    arm_float_to_q15(&(fraction), (pDst), 1)
+
+/**
+ *  Selects the smallest, the first quartile, the median and the largest
+ *  inputs and compares with the sorted inputs.
+ */
+#define QUICKSELECT_DEFINE_TEST(suffix)                                 \
+    JTEST_DEFINE_TEST(arm_quickselect_##suffix##_test,                  \
+                      arm_quickselect_##suffix)                         \
+    {                                                                   \
+        uint32_t rank[4];                                               \
+        uint32_t rank_idx;                                              \
+        TYPE_FROM_ABBREV(suffix) result;                                \
+                                                                        \
+        TEMPLATE_DO_ARR_DESC(                                           \
+            blocksize_idx, uint32_t, blockSize,                         \
+            statistics_order_block_sizes                                \
+            ,                                                           \
+            percentile_fill_q31(blockSize);                             \
+            PERCENTILE_CONVERT_##suffix(blockSize);                     \
+            memcpy(percentile_ref, percentile_input,                    \
+                   blockSize * sizeof(TYPE_FROM_ABBREV(suffix)));       \
+            ref_sort_##suffix(                                          \
+                (TYPE_FROM_ABBREV(suffix) *) percentile_ref,            \
+                blockSize);                                             \
+                                                                        \
+            rank[0] = 0;                                                \
+            rank[1] = blockSize / 4;                                    \
+            rank[2] = blockSize / 2;                                    \
+            rank[3] = blockSize - 1;                                    \
+                                                                        \
+            for (rank_idx = 0; rank_idx < 4; rank_idx++)                \
+            {                                                           \
+                /* Display test parameter values */                     \
+                JTEST_DUMP_STRF("Block Size: %d\n"                      \
+                                "Rank: %d\n",                           \
+                                (int)blockSize,                         \
+                                (int)rank[rank_idx]);                   \
+                                                                        \
+                memcpy(percentile_fut, percentile_input,                \
+                       blockSize * sizeof(TYPE_FROM_ABBREV(suffix)));   \
+                                                                        \
+                JTEST_COUNT_CYCLES(                                     \
+                    arm_quickselect_##suffix(                           \
+                        (TYPE_FROM_ABBREV(suffix) *) percentile_fut,    \
+                        blockSize,                                      \
+                        rank[rank_idx],                                 \
+                        &result));                                      \
+                                                                        \
+                TEST_ASSERT_EQUAL(                                      \
+                    ((TYPE_FROM_ABBREV(suffix) *) percentile_ref)       \
+                    [rank[rank_idx]],                                   \
+                    result);                                            \
+            });                                                         \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+/**
+ *  Compares every percentile with the one interpolated by the reference from
+ *  the sorted inputs.
+ */
+#define PERCENTILE_DEFINE_TEST(suffix)                                  \
+    JTEST_DEFINE_TEST(arm_percentile_##suffix##_test,                   \
+                      arm_percentile_##suffix)                          \
+    {                                                                   \
+        TYPE_FROM_ABBREV(suffix) frac;                                  \
+        TYPE_FROM_ABBREV(suffix) result_fut;                            \
+        TYPE_FROM_ABBREV(suffix) result_ref;                            \
+                                                                        \
+        TEMPLATE_DO_ARR_DESC(                                           \
+            blocksize_idx, uint32_t, blockSize,                         \
+            statistics_order_block_sizes                                \
+            ,                                                           \
+            percentile_fill_q31(blockSize);                             \
+            PERCENTILE_CONVERT_##suffix(blockSize);                     \
+                                                                        \
+            TEMPLATE_DO_ARR_DESC(                                       \
+                fraction_idx, float32_t, fraction,                      \
+                statistics_percentiles                                  \
+                ,                                                       \
+                /* Display test parameter values */                     \
+                JTEST_DUMP_STRF("Block Size: %d\n"                      \
+                                "Fraction: %f\n",                       \
+                                (int)blockSize,                         \
+                                (double)fraction);                      \
+                                                                        \
+                PERCENTILE_FRACTION_##suffix(fraction, &frac);          \
+                memcpy(percentile_fut, percentile_input,                \
+                       blockSize * sizeof(TYPE_FROM_ABBREV(suffix)));   \
+                memcpy(percentile_ref, percentile_input,                \
+                       blockSize * sizeof(TYPE_FROM_ABBREV(suffix)));   \
+                                                                        \
+                JTEST_COUNT_CYCLES(                                     \
+                    arm_percentile_##suffix(                            \
+                        (TYPE_FROM_ABBREV(suffix) *) percentile_fut,    \
+                        blockSize,                                      \
+                        frac,                                           \
+                        &result_fut));                                  \
+                                                                        \
+                ref_percentile_##suffix(                                \
+                    (TYPE_FROM_ABBREV(suffix) *) percentile_ref,        \
+                    blockSize,                                          \
+                    frac,                                               \
+                    &result_ref);                                       \
+                                                                        \
+                TEST_ASSERT_BUFFERS_EQUAL(                              \
+                    &result_ref,                                        \
+                    &result_fut,                                        \
+                    sizeof(TYPE_FROM_ABBREV(suffix)))));                \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+QUICKSELECT_DEFINE_TEST(f32);
+QUICKSELECT_DEFINE_TEST(q31);
+QUICKSELECT_DEFINE_TEST(q15);
+
+PERCENTILE_DEFINE_TEST(f32);
+PERCENTILE_DEFINE_TEST(q31);
+PERCENTILE_DEFINE_TEST(q15);
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all tests in a group. */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(percentile_tests)
+{
+    /*
+      To skip a test, comment it out.
+    */
+    JTEST_TEST_CALL(arm_quickselect_f32_test);
+    JTEST_TEST_CALL(arm_quickselect_q31_test);
+    JTEST_TEST_CALL(arm_quickselect_q15_test);
+
+    JTEST_TEST_CALL(arm_percentile_f32_test);
+    JTEST_TEST_CALL(arm_percentile_q31_test);
+    JTEST_TEST_CALL(arm_percentile_q15_test);
+}
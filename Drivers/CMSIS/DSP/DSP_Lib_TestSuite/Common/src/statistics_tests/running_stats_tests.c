@@ -0,0 +1,250 @@
+#include "jtest.h"
+#include "statistics_test_data.h"
+#include "arr_desc.h"
+#include "arm_math.h"           /* FUTs */
+#include "ref.h"                /* Reference Functions */
+#include "test_templates.h"
+#include "statistics_templates.h"
+#include "type_abbrev.h"
+
+/* Blocks of uneven size, as they come from a stream */
+#define RUNNING_STATS_CHUNK 7
+
+/* Offset of the long stream, far larger than the spread of the samples */
+#define RUNNING_STATS_OFFSET 1000.0f
+#define RUNNING_STATS_REPEAT 256
+
+/* SNR thresholds of the results read from the moments */
+#define RUNNING_STATS_SNR_THRESHOLD 100
+#define RUNNING_STATS_SHAPE_SNR_THRESHOLD 80
+
+static float32_t running_stats_buf[STATISTICS_MAX_INPUT_ELEMENTS];
+
+/**
+ *  Add blockSize samples of pSrc to S, RUNNING_STATS_CHUNK samples at a time.
+ */
+static void running_stats_add_chunks(
+    arm_running_stats_instance_f32 * S,
+    float32_t * pSrc,
+    uint32_t blockSize)
+{
+    uint32_t chunk;
+
+    while (blockSize > 0)
+    {
+        chunk = (blockSize > RUNNING_STATS_CHUNK) ? RUNNING_STATS_CHUNK : blockSize;
+        arm_running_stats_f32(S, pSrc, chunk);
+        pSrc += chunk;
+        blockSize -= chunk;
+    }
+}
+
+/**
+ *  Read the statistics of S into statistics_output_f32_fut and compute the
+ *  reference ones of the same samples into statistics_output_f32_ref:
+ *  mean, variance, standard deviation, RMS, min, max, skewness, kurtosis.
+ */
+static void running_stats_results(
+    const arm_running_stats_instance_f32 * S,
+    float32_t * pSrc,
+    uint32_t blockSize)
+{
+    uint32_t index;
+
+    statistics_output_f32_fut[0] = S->mean;
+    arm_running_stats_var_f32(S, &statistics_output_f32_fut[1]);
+    arm_running_stats_std_f32(S, &statistics_output_f32_fut[2]);
+    arm_running_stats_rms_f32(S, &statistics_output_f32_fut[3]);
+    statistics_output_f32_fut[4] = S->min;
+    statistics_output_f32_fut[5] = S->max;
+    arm_running_stats_skewness_f32(S, &statistics_output_f32_fut[6]);
+    arm_running_stats_kurtosis_f32(S, &statistics_output_f32_fut[7]);
+
+    ref_mean_f32(pSrc, blockSize, &statistics_output_f32_ref[0]);
+    ref_var_f32(pSrc, blockSize, &statistics_output_f32_ref[1]);
+    ref_std_f32(pSrc, blockSize, &statistics_output_f32_ref[2]);
+    ref_rms_f32(pSrc, blockSize, &statistics_output_f32_ref[3]);
+    ref_min_f32(pSrc, blockSize, &statistics_output_f32_ref[4], &index);
+    ref_max_f32(pSrc, blockSize, &statistics_output_f32_ref[5], &index);
+    ref_skewness_f32(pSrc, blockSize, &statistics_output_f32_ref[6]);
+    ref_kurtosis_f32(pSrc, blockSize, &statistics_output_f32_ref[7]);
+}
+
+/**
+ *  Compare the results of running_stats_results(), one by one.
+ *
+ *  @note Below 3 samples the skewness, and below 4 the kurtosis, is fixed by
+ *  the count alone and says nothing of the samples. The skewness is then 0,
+ *  so the SNR would only measure rounding noise: neither is compared.
+ */
+#define RUNNING_STATS_COMPARE_INTERFACE(block_size)                     \
+    do                                                                  \
+    {                                                                   \
+        uint32_t result_idx;                                            \
+                                                                        \
+        for (result_idx = 0; result_idx < 6; result_idx++)              \
+        {                                                               \
+            TEST_ASSERT_SNR(&statistics_output_f32_ref[result_idx],     \
+                            &statistics_output_f32_fut[result_idx],     \
+                            1, RUNNING_STATS_SNR_THRESHOLD);            \
+        }                                                               \
+                                                                        \
+        if ((block_size) >= 3)                                          \
+        {                                                               \
+            TEST_ASSERT_SNR(&statistics_output_f32_ref[6],              \
+                            &statistics_output_f32_fut[6],              \
+                            1, RUNNING_STATS_SHAPE_SNR_THRESHOLD);      \
+        }                                                               \
+                                                                        \
+        if ((block_size) >= 4)                                          \
+        {                                                               \
+            TEST_ASSERT_SNR(&statistics_output_f32_ref[7],              \
+                            &statistics_output_f32_fut[7],              \
+                            1, RUNNING_STATS_SHAPE_SNR_THRESHOLD);      \
+        }                                                               \
+    } while (0)
+
+/*
+  The samples are added in chunks, and the statistics compared with the ones of
+  the whole block.
+*/
+JTEST_DEFINE_TEST(arm_running_stats_f32_test,
+                  arm_running_stats_f32)
+{
+    arm_running_stats_instance_f32 stats;
+
+    TEMPLATE_DO_ARR_DESC(
+        blocksize_idx, uint32_t, blockSize, statistics_block_sizes
+        ,
+        /* Display test parameter values */
+        JTEST_DUMP_STRF("Block Size: %d\n", (int)blockSize);
+
+        arm_running_stats_init_f32(&stats);
+
+        JTEST_COUNT_CYCLES(
+            running_stats_add_chunks(
+                &stats,
+                (float32_t *) statistics_f_32.data_ptr,
+                blockSize));
+
+        TEST_ASSERT_EQUAL(stats.count, blockSize);
+
+        running_stats_results(
+            &stats,
+            (float32_t *) statistics_f_32.data_ptr,
+            blockSize);
+
+        RUNNING_STATS_COMPARE_INTERFACE(blockSize));
+
+    return JTEST_TEST_PASSED;
+}
+
+/*
+  The two parts of a block are added to separate instances, then merged.
+*/
+JTEST_DEFINE_TEST(arm_running_stats_merge_f32_test,
+                  arm_running_stats_merge_f32)
+{
+    arm_running_stats_instance_f32 stats;
+    arm_running_stats_instance_f32 stats_other;
+    float32_t * pSrc = (float32_t *) statistics_f_32.data_ptr;
+
+    TEMPLATE_DO_ARR_DESC(
+        blocksize_idx, uint32_t, blockSize, statistics_block_sizes
+        ,
+        /* Display test parameter values */
+        JTEST_DUMP_STRF("Block Size: %d\n"
+                        "Split: %d\n",
+                        (int)blockSize,
+                        (int)(blockSize / 3));
+
+        arm_running_stats_init_f32(&stats);
+        arm_running_stats_init_f32(&stats_other);
+
+        running_stats_add_chunks(&stats, pSrc, blockSize / 3);
+        running_stats_add_chunks(&stats_other,
+                                 pSrc + blockSize / 3,
+                                 blockSize - blockSize / 3);
+
+        JTEST_COUNT_CYCLES(
+            arm_running_stats_merge_f32(&stats, &stats_other));
+
+        TEST_ASSERT_EQUAL(stats.count, blockSize);
+
+        running_stats_results(&stats, pSrc, blockSize);
+
+        RUNNING_STATS_COMPARE_INTERFACE(blockSize));
+
+    return JTEST_TEST_PASSED;
+}
+
+/*
+  A long stream, offset far from zero, where a sum of squares would lose the
+  variance. The samples repeat, so the statistics of the stream follow from the
+  ones of the repeated block, taken without the offset.
+*/
+JTEST_DEFINE_TEST(arm_running_stats_long_f32_test,
+                  arm_running_stats_f32)
+{
+    arm_running_stats_instance_f32 stats;
+    float32_t * pSrc = (float32_t *) statistics_f_32.data_ptr;
+    uint32_t blockSize = STATISTICS_MAX_INPUT_ELEMENTS;
+    uint32_t count = blockSize * RUNNING_STATS_REPEAT;
+    float32_t m2;
+    uint32_t i;
+
+    /* The offset samples, and the same samples less the offset, exactly */
+    for (i = 0; i < blockSize; i++)
+    {
+        running_stats_buf[i] = pSrc[i] + RUNNING_STATS_OFFSET;
+    }
+
+    arm_running_stats_init_f32(&stats);
+
+    for (i = 0; i < RUNNING_STATS_REPEAT; i++)
+    {
+        arm_running_stats_f32(&stats, running_stats_buf, blockSize);
+    }
+
+    TEST_ASSERT_EQUAL(stats.count, count);
+
+    for (i = 0; i < blockSize; i++)
+    {
+        running_stats_buf[i] = running_stats_buf[i] - RUNNING_STATS_OFFSET;
+    }
+
+    /* Mean, with the offset: the float32 mean cannot hold more */
+    statistics_output_f32_fut[0] = stats.mean;
+    ref_mean_f32(running_stats_buf, blockSize, &statistics_output_f32_ref[0]);
+    statistics_output_f32_ref[0] += RUNNING_STATS_OFFSET;
+
+    /* Variance: RUNNING_STATS_REPEAT times the squared deviations of a block */
+    arm_running_stats_var_f32(&stats, &statistics_output_f32_fut[1]);
+    ref_var_f32(running_stats_buf, blockSize, &m2);
+    m2 *= (float32_t) (blockSize - 1);
+    statistics_output_f32_ref[1] =
+        m2 * (float32_t) RUNNING_STATS_REPEAT / (float32_t) (count - 1);
+
+    TEST_ASSERT_SNR(&statistics_output_f32_ref[0],
+                    &statistics_output_f32_fut[0],
+                    1, RUNNING_STATS_SNR_THRESHOLD);
+    TEST_ASSERT_SNR(&statistics_output_f32_ref[1],
+                    &statistics_output_f32_fut[1],
+                    1, RUNNING_STATS_SNR_THRESHOLD);
+
+    return JTEST_TEST_PASSED;
+}
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all tests in a group. */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(running_stats_tests)
+{
+    /*
+      To skip a test, comment it out.
+    */
+    JTEST_TEST_CALL(arm_running_stats_f32_test);
+    JTEST_TEST_CALL(arm_running_stats_merge_f32_test);
+    JTEST_TEST_CALL(arm_running_stats_long_f32_test);
+}
@@ -38,6 +38,21 @@ ARR_DESC_DEFINE(uint32_t,
                 4,
                 CURLY(1, 2, 15, 32));
 
+/* Below, at and above the sorting network of the order statistics */
+ARR_DESC_DEFINE(uint32_t,
+                statistics_order_block_sizes,
+                9,
+                CURLY(1, 2, 3, 15, 16, 17, 32, 100, STATISTICS_ORDER_MAX_BLOCKSIZE));
+
+/*--------------------------------------------------------------------------------*/
+/* Percentiles */
+/*--------------------------------------------------------------------------------*/
+
+ARR_DESC_DEFINE(float32_t,
+                statistics_percentiles,
+                6,
+                CURLY(0.0f, 0.1f, 0.25f, 0.5f, 0.9f, 1.0f));
+
 /*--------------------------------------------------------------------------------*/
 /* Test Data */
 /*--------------------------------------------------------------------------------*/
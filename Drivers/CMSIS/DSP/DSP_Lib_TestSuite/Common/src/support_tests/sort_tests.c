@@ -0,0 +1,138 @@
+#include "jtest.h"
+#include "support_test_data.h"
+#include "arr_desc.h"
+#include "arm_math.h"           /* FUTs */
+#include "ref.h"                /* Reference Functions */
+#include "test_templates.h"
+#include "support_templates.h"
+#include "type_abbrev.h"
+
+/* Orders of the inputs */
+#define SORT_PATTERN_RANDOM     0   /* full scale */
+#define SORT_PATTERN_TIES       1   /* 16 distinct values */
+#define SORT_PATTERN_ASCENDING  2
+#define SORT_PATTERN_DESCENDING 3
+#define SORT_PATTERN_CONSTANT   4
+#define SORT_PATTERN_ORGAN_PIPE 5   /* ascending then descending */
+
+static float32_t sort_fut[SUPPORT_SORT_MAX_BLOCKSIZE];
+static float32_t sort_ref[SUPPORT_SORT_MAX_BLOCKSIZE];
+
+/**
+ *  Fill pDst with blockSize Q31 inputs of the given pattern.
+ */
+static void sort_fill_q31(
+    q31_t * pDst,
+    uint32_t blockSize,
+    uint32_t pattern)
+{
+    uint32_t seed = 12345;
+    uint32_t i;
+
+    for (i = 0; i < blockSize; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+
+        switch (pattern)
+        {
+        case SORT_PATTERN_RANDOM:
+            pDst[i] = (q31_t) seed;
+            break;
+        case SORT_PATTERN_TIES:
+            pDst[i] = (q31_t) (seed & 0xF0000000);
+            break;
+        case SORT_PATTERN_ASCENDING:
+            pDst[i] = (q31_t) (i << 16) - 0x40000000;
+            break;
+        case SORT_PATTERN_DESCENDING:
+            pDst[i] = 0x40000000 - (q31_t) (i << 16);
+            break;
+        case SORT_PATTERN_CONSTANT:
+            pDst[i] = 0x12340000;
+            break;
+        default:
+            pDst[i] = (q31_t) (((i < blockSize / 2) ? i : blockSize - i) << 16);
+            break;
+        }
+    }
+}
+
+/**
+ *  Fill the FUT and reference buffers with the same inputs of type suffix.
+ */
+#define SORT_FILL_f32(blockSize, pattern)                               \
+    do                                                                  \
+    {                                                                   \
+        sort_fill_q31((q31_t *) sort_ref, blockSize, pattern);          \
+        arm_q31_to_float((q31_t *) sort_ref, sort_fut, blockSize);      \
+    } while (0)
+
+#define SORT_FILL_q31(blockSize, pattern)                               \
+    sort_fill_q31((q31_t *) sort_fut, blockSize, pattern)
+
+#define SORT_FILL_q15(blockSize, pattern)                               \
+    do                                                                  \
+    {                                                                   \
+        sort_fill_q31((q31_t *) sort_ref, blockSize, pattern);          \
+        arm_q31_to_q15((q31_t *) sort_ref, (q15_t *) sort_fut,          \
+                       blockSize);                                      \
+    } while (0)
+
+/**
+ *  Sorts every pattern in place and compares with the reference insertion sort.
+ */
+#define SORT_DEFINE_TEST(suffix)                                        \
+    JTEST_DEFINE_TEST(arm_sort_##suffix##_test,                         \
+                      arm_sort_##suffix)                                \
+    {                                                                   \
+        TEMPLATE_DO_ARR_DESC(                                           \
+            blocksize_idx, uint32_t, blockSize,                         \
+            support_sort_block_sizes                                    \
+            ,                                                           \
+            TEMPLATE_DO_ARR_DESC(                                       \
+                pattern_idx, uint32_t, pattern, support_sort_patterns   \
+                ,                                                       \
+                /* Display test parameter values */                     \
+                JTEST_DUMP_STRF("Block Size: %d\n"                      \
+                                "Pattern: %d\n",                        \
+                                (int)blockSize,                         \
+                                (int)pattern);                          \
+                                                                        \
+                SORT_FILL_##suffix(blockSize, pattern);                 \
+                memcpy(sort_ref, sort_fut,                              \
+                       blockSize * sizeof(TYPE_FROM_ABBREV(suffix)));   \
+                                                                        \
+                JTEST_COUNT_CYCLES(                                     \
+                    arm_sort_##suffix(                                  \
+                        (TYPE_FROM_ABBREV(suffix) *) sort_fut,          \
+                        blockSize));                                    \
+                                                                        \
+                ref_sort_##suffix(                                      \
+                    (TYPE_FROM_ABBREV(suffix) *) sort_ref,              \
+                    blockSize);                                         \
+                                                                        \
+                TEST_ASSERT_BUFFERS_EQUAL(                              \
+                    sort_ref,                                           \
+                    sort_fut,                                           \
+                    blockSize * sizeof(TYPE_FROM_ABBREV(suffix)))));    \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+SORT_DEFINE_TEST(f32);
+SORT_DEFINE_TEST(q31);
+SORT_DEFINE_TEST(q15);
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all tests in a group. */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(sort_tests)
+{
+    /*
+      To skip a test, comment it out.
+    */
+    JTEST_TEST_CALL(arm_sort_f32_test);
+    JTEST_TEST_CALL(arm_sort_q31_test);
+    JTEST_TEST_CALL(arm_sort_q15_test);
+}
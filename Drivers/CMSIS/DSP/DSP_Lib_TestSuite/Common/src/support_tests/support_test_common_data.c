@@ -32,6 +32,18 @@ ARR_DESC_DEFINE(uint32_t,
                 4,
                 CURLY( 2, 7, 15, 32));
 
+/* Below, at and above the sorting network, up to many partitioning levels */
+ARR_DESC_DEFINE(uint32_t,
+                support_sort_block_sizes,
+                11,
+                CURLY( 1, 2, 3, 5, 8, 15, 16, 17, 31, 100, SUPPORT_SORT_MAX_BLOCKSIZE));
+
+/* Orders of the inputs, see sort_tests.c */
+ARR_DESC_DEFINE(uint32_t,
+                support_sort_patterns,
+                6,
+                CURLY( 0, 1, 2, 3, 4, 5));
+
 /*--------------------------------------------------------------------------------*/
 /* Numbers */
 /*--------------------------------------------------------------------------------*/
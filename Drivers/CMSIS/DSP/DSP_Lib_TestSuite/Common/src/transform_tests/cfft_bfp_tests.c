@@ -0,0 +1,177 @@
+#include "jtest.h"
+#include "ref.h"
+#include "arr_desc.h"
+#include "transform_templates.h"
+#include "transform_test_data.h"
+#include "type_abbrev.h"
+
+/* Against the unscaled transform of the same Q15 input */
+#define CFFT_BFP_SNR_THRESHOLD 60
+
+/* Margin of the block floating-point FFT over arm_cfft_q15 at low amplitude */
+#define CFFT_BFP_SNR_GAIN 20
+
+/**
+ *  Copy the Q15 inputs, scaled down by input_shift, to the in-place buffer of
+ *  the FUT and to the input buffer of the reference.
+ */
+#define CFFT_BFP_PREPARE_INPUTS(fftLen, input_shift)                    \
+    do                                                                  \
+    {                                                                   \
+        uint32_t i;                                                     \
+        for (i = 0; i < 2 * (fftLen); i++)                              \
+        {                                                               \
+            ((q15_t *) transform_fft_inplace_input_fut)[i] =            \
+                transform_fft_q15_inputs[i] >> (input_shift);           \
+        }                                                               \
+        memcpy(transform_fft_input_ref,                                 \
+               transform_fft_inplace_input_fut,                         \
+               2 * (fftLen) * sizeof(q15_t));                           \
+    } while (0)
+
+/**
+ *  Convert the Q15 output of the FUT to floating point, scaled by
+ *  2^block_exp, for the comparison with ref_cfft_bfp_q15().
+ */
+#define CFFT_BFP_CONVERT_OUTPUT(fftLen, block_exp)                      \
+    do                                                                  \
+    {                                                                   \
+        arm_q15_to_float((q15_t *) transform_fft_inplace_input_fut,     \
+                         transform_fft_output_f32_fut,                  \
+                         2 * (fftLen));                                 \
+        arm_scale_f32(transform_fft_output_f32_fut,                     \
+                      ldexpf(1.0f, (block_exp)),                        \
+                      transform_fft_output_f32_fut,                     \
+                      2 * (fftLen));                                    \
+    } while (0)
+
+/*
+  Block floating-point CFFT function test template. Arguments are: function
+  configuration suffix, inverse-transform flag and right shift of the inputs.
+*/
+#define CFFT_BFP_DEFINE_TEST(config_suffix, ifft_flag, input_shift)     \
+    JTEST_DEFINE_TEST(arm_cfft_bfp_q15_##config_suffix##_test,          \
+                      arm_cfft_bfp_q15)                                 \
+    {                                                                   \
+        int32_t block_exp;                                              \
+                                                                        \
+        /* Go through all arm_cfft_instances */                         \
+        TEMPLATE_DO_ARR_DESC(                                           \
+            cfft_inst_idx, const arm_cfft_instance_q15 *, cfft_inst,    \
+            transform_cfft_bfp_q15_structs                              \
+            ,                                                           \
+            CFFT_BFP_PREPARE_INPUTS(cfft_inst->fftLen, input_shift);    \
+                                                                        \
+            /* Display parameter values */                              \
+            JTEST_DUMP_STRF("Block Size: %d\n"                          \
+                            "Inverse-transform flag: %d\n"              \
+                            "Input shift: %d\n",                        \
+                            (int)cfft_inst->fftLen,                     \
+                            (int)ifft_flag,                             \
+                            (int)input_shift);                          \
+                                                                        \
+            /* Display cycle count and run test */                      \
+            JTEST_COUNT_CYCLES(                                         \
+                arm_cfft_bfp_q15(                                       \
+                    cfft_inst,                                          \
+                    (void *) transform_fft_inplace_input_fut,           \
+                    ifft_flag,                                          \
+                    1,                                                  \
+                    &block_exp));                                       \
+                                                                        \
+            ref_cfft_bfp_q15(cfft_inst,                                 \
+                             (void *) transform_fft_input_ref,          \
+                             transform_fft_output_f32_ref,              \
+                             ifft_flag);                                \
+                                                                        \
+            /* Test correctness */                                      \
+            CFFT_BFP_CONVERT_OUTPUT(cfft_inst->fftLen, block_exp);      \
+            TEST_ASSERT_SNR(transform_fft_output_f32_ref,               \
+                            transform_fft_output_f32_fut,               \
+                            2 * cfft_inst->fftLen,                      \
+                            CFFT_BFP_SNR_THRESHOLD));                   \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+CFFT_BFP_DEFINE_TEST(forward, 0U, 0);
+CFFT_BFP_DEFINE_TEST(inverse, 1U, 0);
+CFFT_BFP_DEFINE_TEST(forward_low, 0U, 10);
+CFFT_BFP_DEFINE_TEST(inverse_low, 1U, 10);
+
+/*
+  A 10-bit input runs through arm_cfft_q15 and arm_cfft_bfp_q15. The first one
+  loses 2 bits per radix-4 stage, the second one only what the data grows.
+*/
+JTEST_DEFINE_TEST(arm_cfft_bfp_q15_gain_test,
+                  arm_cfft_bfp_q15)
+{
+    int32_t block_exp;
+    float32_t snr_bfp;
+    float32_t snr_q15;
+
+    TEMPLATE_DO_ARR_DESC(
+        cfft_inst_idx, const arm_cfft_instance_q15 *, cfft_inst_ptr,
+        transform_cfft_bfp_q15_structs
+        ,
+        CFFT_BFP_PREPARE_INPUTS(cfft_inst_ptr->fftLen, 6);
+
+        ref_cfft_bfp_q15(cfft_inst_ptr,
+                         (void *) transform_fft_input_ref,
+                         transform_fft_output_f32_ref,
+                         0);
+
+        /* arm_cfft_q15 divides by fftLen */
+        arm_cfft_q15(cfft_inst_ptr,
+                     (void *) transform_fft_input_ref,
+                     0, 1);
+        arm_q15_to_float((q15_t *) transform_fft_input_ref,
+                         transform_fft_output_f32_fut,
+                         2 * cfft_inst_ptr->fftLen);
+        arm_scale_f32(transform_fft_output_f32_fut,
+                      (float32_t) cfft_inst_ptr->fftLen,
+                      transform_fft_output_f32_fut,
+                      2 * cfft_inst_ptr->fftLen);
+        snr_q15 = arm_snr_f32(transform_fft_output_f32_ref,
+                              transform_fft_output_f32_fut,
+                              2 * cfft_inst_ptr->fftLen);
+
+        arm_cfft_bfp_q15(cfft_inst_ptr,
+                         (void *) transform_fft_inplace_input_fut,
+                         0, 1, &block_exp);
+        CFFT_BFP_CONVERT_OUTPUT(cfft_inst_ptr->fftLen, block_exp);
+        snr_bfp = arm_snr_f32(transform_fft_output_f32_ref,
+                              transform_fft_output_f32_fut,
+                              2 * cfft_inst_ptr->fftLen);
+
+        /* Display parameter values */
+        JTEST_DUMP_STRF("Block Size: %d\n"
+                        "SNR arm_cfft_q15: %f\n"
+                        "SNR arm_cfft_bfp_q15: %f\n",
+                        (int)cfft_inst_ptr->fftLen,
+                        (double)snr_q15,
+                        (double)snr_bfp);
+
+        if (snr_bfp <= snr_q15 + CFFT_BFP_SNR_GAIN)
+        {
+            return JTEST_TEST_FAILED;
+        });
+
+    return JTEST_TEST_PASSED;
+}
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all tests in a group */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(cfft_bfp_tests)
+{
+    /*
+      To skip a test, comment it out.
+    */
+    JTEST_TEST_CALL(arm_cfft_bfp_q15_forward_test);
+    JTEST_TEST_CALL(arm_cfft_bfp_q15_inverse_test);
+    JTEST_TEST_CALL(arm_cfft_bfp_q15_forward_low_test);
+    JTEST_TEST_CALL(arm_cfft_bfp_q15_inverse_low_test);
+    JTEST_TEST_CALL(arm_cfft_bfp_q15_gain_test);
+}
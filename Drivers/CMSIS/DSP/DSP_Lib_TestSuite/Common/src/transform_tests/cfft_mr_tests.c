@@ -0,0 +1,170 @@
+#include "jtest.h"
+#include "ref.h"
+#include "arr_desc.h"
+#include "transform_templates.h"
+#include "transform_test_data.h"
+#include "type_abbrev.h"
+
+/* Twiddles and work buffer, large enough for the real FFT as well */
+static float32_t transform_mr_twiddle[ARM_CFFT_MR_TWIDDLE_SIZE(TRANSFORM_MAX_FFT_LEN)];
+static float32_t transform_mr_buffer[ARM_CFFT_MR_BUFFER_SIZE(TRANSFORM_MAX_FFT_LEN)];
+
+/*
+  Mixed-radix CFFT function test template. Arguments are: function configuration
+  suffix and inverse-transform flag
+*/
+#define CFFT_MR_DEFINE_TEST(config_suffix, ifft_flag)                   \
+    JTEST_DEFINE_TEST(arm_cfft_mr_f32_##config_suffix##_test,           \
+                      arm_cfft_mr_f32)                                  \
+    {                                                                   \
+        arm_cfft_mr_instance_f32 cfft_inst_fut;                         \
+                                                                        \
+        /* Go through all FFT lengths */                                \
+        TEMPLATE_DO_ARR_DESC(                                           \
+            fftlen_idx, uint16_t, fftlen, transform_cfft_mr_fftlens     \
+            ,                                                           \
+                                                                        \
+            /* Initialize the CFFT Instance */                          \
+            TEST_ASSERT_EQUAL(                                          \
+                arm_cfft_mr_init_f32(                                   \
+                    &cfft_inst_fut, fftlen,                             \
+                    transform_mr_twiddle,                               \
+                    transform_mr_buffer), ARM_MATH_SUCCESS);            \
+                                                                        \
+            TRANSFORM_PREPARE_INPLACE_INPUTS(                           \
+                transform_fft_f32_inputs,                               \
+                fftlen *                                                \
+                sizeof(float32_t) *                                     \
+                2 /*complex_inputs*/);                                  \
+                                                                        \
+            /* Display parameter values */                              \
+            JTEST_DUMP_STRF("Block Size: %d\n"                          \
+                            "Inverse-transform flag: %d\n",             \
+                            (int)fftlen,                                \
+                            (int)ifft_flag);                            \
+                                                                        \
+            /* Display cycle count and run test */                      \
+            JTEST_COUNT_CYCLES(                                         \
+                arm_cfft_mr_f32(                                        \
+                    &cfft_inst_fut,                                     \
+                    (void *) transform_fft_inplace_input_fut,           \
+                    ifft_flag));                                        \
+                                                                        \
+            ref_cfft_mr_f32(                                            \
+                &cfft_inst_fut,                                         \
+                (void *) transform_fft_inplace_input_ref,               \
+                ifft_flag);                                             \
+                                                                        \
+            /* Test correctness */                                      \
+            TRANSFORM_SNR_COMPARE_CMPLX_INTERFACE(                      \
+                fftlen,                                                 \
+                float32_t));                                            \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+CFFT_MR_DEFINE_TEST(forward, 0U);
+CFFT_MR_DEFINE_TEST(inverse, 1U);
+
+/*
+  Mixed-radix RFFT function test template. Arguments are: function configuration
+  suffix and inverse-transform flag
+*/
+#define RFFT_MR_DEFINE_TEST(config_suffix, ifft_flag)                   \
+    JTEST_DEFINE_TEST(arm_rfft_mr_f32_##config_suffix##_test,           \
+                      arm_rfft_mr_f32)                                  \
+    {                                                                   \
+        arm_rfft_mr_instance_f32 rfft_inst_fut;                         \
+                                                                        \
+        /* Go through all FFT lengths */                                \
+        TEMPLATE_DO_ARR_DESC(                                           \
+            fftlen_idx, uint16_t, fftlen, transform_rfft_mr_fftlens     \
+            ,                                                           \
+                                                                        \
+            /* Initialize the RFFT Instance */                          \
+            TEST_ASSERT_EQUAL(                                          \
+                arm_rfft_mr_init_f32(                                   \
+                    &rfft_inst_fut, fftlen,                             \
+                    transform_mr_twiddle,                               \
+                    transform_mr_buffer), ARM_MATH_SUCCESS);            \
+                                                                        \
+            TRANSFORM_COPY_INPUTS(                                      \
+                transform_fft_f32_inputs,                               \
+                fftlen *                                                \
+                sizeof(float32_t));                                     \
+                                                                        \
+            /* Display parameter values */                              \
+            JTEST_DUMP_STRF("Block Size: %d\n"                          \
+                            "Inverse-transform flag: %d\n",             \
+                         (int)fftlen,                                   \
+                         (int)ifft_flag);                               \
+                                                                        \
+            /* Display cycle count and run test */                      \
+            JTEST_COUNT_CYCLES(                                         \
+                arm_rfft_mr_f32(                                        \
+                    &rfft_inst_fut,                                     \
+                    (void *) transform_fft_input_fut,                   \
+                    (void *) transform_fft_output_fut,                  \
+                    ifft_flag));                                        \
+                                                                        \
+            ref_rfft_mr_f32(                                            \
+                &rfft_inst_fut,                                         \
+                (void *) transform_fft_input_ref,                       \
+                (void *) transform_fft_output_ref,                      \
+                ifft_flag);                                             \
+                                                                        \
+            /* Test correctness */                                      \
+            TRANSFORM_SNR_COMPARE_INTERFACE(                            \
+                fftlen,                                                 \
+                float32_t));                                            \
+                                                                        \
+        return JTEST_TEST_PASSED;                                       \
+    }
+
+RFFT_MR_DEFINE_TEST(forward, 0U);
+RFFT_MR_DEFINE_TEST(inverse, 1U);
+
+/* Lengths with a prime factor above 5 are refused */
+JTEST_DEFINE_TEST(arm_cfft_mr_init_f32_test,
+                  arm_cfft_mr_init_f32)
+{
+    arm_cfft_mr_instance_f32 cfft_inst;
+    arm_rfft_mr_instance_f32 rfft_inst;
+
+    TEST_ASSERT_EQUAL(arm_cfft_mr_init_f32(&cfft_inst, 1, transform_mr_twiddle,
+                                           transform_mr_buffer),
+                      ARM_MATH_ARGUMENT_ERROR);
+    TEST_ASSERT_EQUAL(arm_cfft_mr_init_f32(&cfft_inst, 7 * 64, transform_mr_twiddle,
+                                           transform_mr_buffer),
+                      ARM_MATH_ARGUMENT_ERROR);
+    TEST_ASSERT_EQUAL(arm_rfft_mr_init_f32(&rfft_inst, 241, transform_mr_twiddle,
+                                           transform_mr_buffer),
+                      ARM_MATH_ARGUMENT_ERROR);
+    TEST_ASSERT_EQUAL(arm_rfft_mr_init_f32(&rfft_inst, 2 * 11, transform_mr_twiddle,
+                                           transform_mr_buffer),
+                      ARM_MATH_ARGUMENT_ERROR);
+
+    /* 960 = 4 * 4 * 4 * 3 * 5 */
+    TEST_ASSERT_EQUAL(arm_cfft_mr_init_f32(&cfft_inst, 960, transform_mr_twiddle,
+                                           transform_mr_buffer),
+                      ARM_MATH_SUCCESS);
+    TEST_ASSERT_EQUAL(cfft_inst.numStages, 5);
+
+    return JTEST_TEST_PASSED;
+}
+
+/*--------------------------------------------------------------------------------*/
+/* Collect all tests in a group */
+/*--------------------------------------------------------------------------------*/
+
+JTEST_DEFINE_GROUP(cfft_mr_tests)
+{
+    /*
+      To skip a test, comment it out.
+    */
+    JTEST_TEST_CALL(arm_cfft_mr_init_f32_test);
+    JTEST_TEST_CALL(arm_cfft_mr_f32_forward_test);
+    JTEST_TEST_CALL(arm_cfft_mr_f32_inverse_test);
+    JTEST_TEST_CALL(arm_rfft_mr_f32_forward_test);
+    JTEST_TEST_CALL(arm_rfft_mr_f32_inverse_test);
+}
@@ -7,5 +7,7 @@ JTEST_DEFINE_GROUP(transform_tests)
     JTEST_GROUP_CALL(cfft_family_tests);
     JTEST_GROUP_CALL(rfft_tests);
     JTEST_GROUP_CALL(rfft_fast_tests);
+    JTEST_GROUP_CALL(cfft_mr_tests);
+    JTEST_GROUP_CALL(cfft_bfp_tests);
     JTEST_GROUP_CALL(dct4_tests);
 }
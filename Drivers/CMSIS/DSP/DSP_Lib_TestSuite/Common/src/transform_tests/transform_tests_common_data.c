@@ -3250,6 +3250,22 @@ ARR_DESC_DEFINE(uint16_t,
                       32, 64, 128, 256,
                       512, 1024, 2048));
 
+/* Products of 2, 3 and 5, the powers of two checked against ref_cfft_f32 */
+ARR_DESC_DEFINE(uint16_t,
+                transform_cfft_mr_fftlens,
+                14,
+                CURLY(
+                      2, 3, 5, 12, 15, 60, 64,
+                      100, 240, 256, 480, 960, 1000, 1024));
+
+/* Even lengths, half of them a product of 2, 3 and 5 */
+ARR_DESC_DEFINE(uint16_t,
+                transform_rfft_mr_fftlens,
+                9,
+                CURLY(
+                      6, 30, 100, 120, 128,
+                      240, 480, 960, 1920));
+
 /*--------------------------------------------------------------------------------*/
 /* CFFT_F32 Structs */
 /*--------------------------------------------------------------------------------*/
@@ -3309,3 +3325,19 @@ ARR_DESC_DEFINE(const arm_cfft_instance_q15 *,
                     /* &arm_cfft_sR_q15_len2048, */
                     /* &arm_cfft_sR_q15_len4096 */
                     ));
+
+/* All lengths, for the block floating-point FFT */
+ARR_DESC_DEFINE(const arm_cfft_instance_q15 *,
+                transform_cfft_bfp_q15_structs,
+                9,
+                CURLY(
+                    &arm_cfft_sR_q15_len16,
+                    &arm_cfft_sR_q15_len32,
+                    &arm_cfft_sR_q15_len64,
+                    &arm_cfft_sR_q15_len128,
+                    &arm_cfft_sR_q15_len256,
+                    &arm_cfft_sR_q15_len512,
+                    &arm_cfft_sR_q15_len1024,
+                    &arm_cfft_sR_q15_len2048,
+                    &arm_cfft_sR_q15_len4096
+                    ));
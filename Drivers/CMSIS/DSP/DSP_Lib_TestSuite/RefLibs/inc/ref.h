@@ -480,6 +480,28 @@ arm_status ref_sqrt_q31(q31_t in, q31_t * pOut);
 
 arm_status ref_sqrt_q15(q15_t in, q15_t * pOut);
 
+void ref_vsin_f32(float32_t * pSrc, float32_t * pDst, uint32_t blockSize);
+
+void ref_vsin_q31(q31_t * pSrc, q31_t * pDst, uint32_t blockSize);
+
+void ref_vcos_f32(float32_t * pSrc, float32_t * pDst, uint32_t blockSize);
+
+void ref_vcos_q31(q31_t * pSrc, q31_t * pDst, uint32_t blockSize);
+
+void ref_vatan2_f32(float32_t * pSrcY, float32_t * pSrcX, float32_t * pDst, uint32_t blockSize);
+
+void ref_vatan2_q31(q31_t * pSrcY, q31_t * pSrcX, q31_t * pDst, uint32_t blockSize);
+
+void ref_vexp_f32(float32_t * pSrc, float32_t * pDst, uint32_t blockSize);
+
+void ref_vlog_f32(float32_t * pSrc, float32_t * pDst, uint32_t blockSize);
+
+void ref_vlog10_f32(float32_t * pSrc, float32_t * pDst, uint32_t blockSize);
+
+void ref_vlog_q31(q31_t * pSrc, q31_t * pDst, uint32_t blockSize);
+
+void ref_vpow_f32(float32_t * pSrcA, float32_t * pSrcB, float32_t * pDst, uint32_t blockSize);
+
 	/*
 	 * Filtering Functions
 	 */
@@ -537,6 +559,24 @@ void ref_biquad_cascade_df1_q15(
   q15_t * pDst,
   uint32_t blockSize);
 
+void ref_biquad_cascade_mc_df2T_f32(
+	const arm_biquad_cascade_mc_df2T_instance_f32 * S,
+	float32_t * pSrc,
+	float32_t * pDst,
+	uint32_t blockSize);
+
+void ref_biquad_cascade_mc_df1_q31(
+  const arm_biquad_casd_mc_df1_inst_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize);
+
+void ref_biquad_cascade_mc_df1_q15(
+  const arm_biquad_casd_mc_df1_inst_q15 * S,
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize);
+
 void ref_conv_f32(
   float32_t * pSrcA,
   uint32_t 		srcALen,
@@ -761,6 +801,42 @@ void ref_fir_fast_q15(
   q15_t * pDst,
   uint32_t blockSize);
 
+void ref_fir_mc_f32(
+  const arm_fir_mc_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+void ref_fir_mc_q31(
+  const arm_fir_mc_instance_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize);
+
+void ref_fir_mc_q15(
+  const arm_fir_mc_instance_q15 * S,
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize);
+
+void ref_median_filter_f32(
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize,
+  uint16_t windowSize);
+
+void ref_median_filter_q31(
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize,
+  uint16_t windowSize);
+
+void ref_median_filter_q15(
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize,
+  uint16_t windowSize);
+
 void ref_fir_q7(
   const arm_fir_instance_q7 * S,
   q7_t * pSrc,
@@ -1173,6 +1249,34 @@ void ref_var_q31(
 void ref_var_q15(
   q15_t * pSrc,
   uint32_t blockSize,
+  q15_t * pResult);
+
+void ref_skewness_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t * pResult);
+
+void ref_kurtosis_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t * pResult);
+
+void ref_percentile_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t fraction,
+  float32_t * pResult);
+
+void ref_percentile_q31(
+  q31_t * pSrc,
+  uint32_t blockSize,
+  q31_t fraction,
+  q31_t * pResult);
+
+void ref_percentile_q15(
+  q15_t * pSrc,
+  uint32_t blockSize,
+  q15_t fraction,
   q15_t * pResult);
 
 	/*
@@ -1218,6 +1322,18 @@ void ref_fill_q7(
   q7_t * pDst,
   uint32_t blockSize);
 
+void ref_sort_f32(
+  float32_t * pSrc,
+  uint32_t blockSize);
+
+void ref_sort_q31(
+  q31_t * pSrc,
+  uint32_t blockSize);
+
+void ref_sort_q15(
+  q15_t * pSrc,
+  uint32_t blockSize);
+
 void ref_q31_to_q15(
   q31_t * pSrc,
   q15_t * pDst,
@@ -1292,6 +1408,11 @@ void ref_cfft_f32(
    uint8_t ifftFlag,
    uint8_t bitReverseFlag);
 	 
+void ref_cfft_mr_f32(
+	const arm_cfft_mr_instance_f32 * S,
+	float32_t * p1,
+	uint8_t ifftFlag);
+
 void ref_cfft_q31(
 	const arm_cfft_instance_q31 * S,
     q31_t * p1,
@@ -1304,6 +1425,12 @@ void ref_cfft_q15(
     uint8_t ifftFlag,
     uint8_t bitReverseFlag);
 
+void ref_cfft_bfp_q15(
+	const arm_cfft_instance_q15 * S,
+	q15_t * pSrc,
+	float32_t * pDst,
+	uint8_t ifftFlag);
+
 void ref_cfft_radix2_f32(
 	const arm_cfft_radix2_instance_f32 * S,
 	float32_t * pSrc);
@@ -1338,6 +1465,11 @@ void ref_rfft_fast_f32(
 	float32_t * p, float32_t * pOut,
 	uint8_t ifftFlag);
 
+void ref_rfft_mr_f32(
+	arm_rfft_mr_instance_f32 * S,
+	float32_t * p, float32_t * pOut,
+	uint8_t ifftFlag);
+
 void ref_rfft_q31(
   const arm_rfft_instance_q31 * S,
   q31_t * pSrc,
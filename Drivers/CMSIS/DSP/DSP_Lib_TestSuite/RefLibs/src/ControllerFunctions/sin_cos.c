@@ -16,6 +16,7 @@ void ref_sin_cos_q31(
   q31_t * pCosVal)
 {
 	//theta is given in the range [-1,1) to represent [-pi,pi)
-	*pSinVal = (q31_t)(sinf((float32_t)theta * 3.14159265358979f / 2147483648.0f) * 2147483648.0f);
-	*pCosVal = (q31_t)(cosf((float32_t)theta * 3.14159265358979f / 2147483648.0f) * 2147483648.0f);
+	//the q63_t conversion saturates 1.0 to 0x7FFFFFFF on every host, as the ARM cores do
+	*pSinVal = ref_sat_q31((q63_t)(sinf((float32_t)theta * 3.14159265358979f / 2147483648.0f) * 2147483648.0f));
+	*pCosVal = ref_sat_q31((q63_t)(cosf((float32_t)theta * 3.14159265358979f / 2147483648.0f) * 2147483648.0f));
 }
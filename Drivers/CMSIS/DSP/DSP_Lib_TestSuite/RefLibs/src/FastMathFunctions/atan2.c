@@ -0,0 +1,24 @@
+#include "ref.h"
+
+void ref_vatan2_f32(float32_t * pSrcY, float32_t * pSrcX, float32_t * pDst, uint32_t blockSize)
+{
+	uint32_t i;
+
+	for (i = 0; i < blockSize; i++)
+	{
+		pDst[i] = (float32_t)atan2((double)pSrcY[i], (double)pSrcX[i]);
+	}
+}
+
+void ref_vatan2_q31(q31_t * pSrcY, q31_t * pSrcX, q31_t * pDst, uint32_t blockSize)
+{
+	uint32_t i;
+	double angle;
+
+	for (i = 0; i < blockSize; i++)
+	{
+		/* 1.0 is 2*pi, atan2(0, 0) is 0 */
+		angle = atan2((double)pSrcY[i], (double)pSrcX[i]) / 6.283185307179586;
+		pDst[i] = ref_sat_q31((q63_t)floor(angle * 2147483648.0 + 0.5));
+	}
+}
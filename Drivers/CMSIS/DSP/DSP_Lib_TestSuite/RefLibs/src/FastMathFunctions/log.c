@@ -0,0 +1,39 @@
+#include "ref.h"
+
+void ref_vlog_f32(float32_t * pSrc, float32_t * pDst, uint32_t blockSize)
+{
+	uint32_t i;
+
+	for (i = 0; i < blockSize; i++)
+	{
+		pDst[i] = (float32_t)log((double)pSrc[i]);
+	}
+}
+
+void ref_vlog10_f32(float32_t * pSrc, float32_t * pDst, uint32_t blockSize)
+{
+	uint32_t i;
+
+	for (i = 0; i < blockSize; i++)
+	{
+		pDst[i] = (float32_t)log10((double)pSrc[i]);
+	}
+}
+
+void ref_vlog_q31(q31_t * pSrc, q31_t * pDst, uint32_t blockSize)
+{
+	uint32_t i;
+
+	for (i = 0; i < blockSize; i++)
+	{
+		/* 5.26 output, 0x80000000 for the inputs without a logarithm */
+		if (pSrc[i] <= 0)
+		{
+			pDst[i] = (q31_t)0x80000000;
+		}
+		else
+		{
+			pDst[i] = (q31_t)floor(log((double)pSrc[i] / 2147483648.0) * 67108864.0 + 0.5);
+		}
+	}
+}
@@ -0,0 +1,11 @@
+#include "ref.h"
+
+void ref_vpow_f32(float32_t * pSrcA, float32_t * pSrcB, float32_t * pDst, uint32_t blockSize)
+{
+	uint32_t i;
+
+	for (i = 0; i < blockSize; i++)
+	{
+		pDst[i] = (float32_t)pow((double)pSrcA[i], (double)pSrcB[i]);
+	}
+}
@@ -9,3 +9,26 @@ q15_t ref_sin_q15(q15_t x)
 {
 	return (q15_t)(sinf((float32_t)x * 6.28318530717959f / 32768.0f) * 32768.0f);
 }
+
+void ref_vsin_f32(float32_t * pSrc, float32_t * pDst, uint32_t blockSize)
+{
+	uint32_t i;
+
+	for (i = 0; i < blockSize; i++)
+	{
+		pDst[i] = (float32_t)sin((double)pSrc[i]);
+	}
+}
+
+void ref_vsin_q31(q31_t * pSrc, q31_t * pDst, uint32_t blockSize)
+{
+	uint32_t i;
+	double phase;
+
+	for (i = 0; i < blockSize; i++)
+	{
+		/* The input wraps around, 1.0 is 2*pi */
+		phase = (double)((uint32_t)pSrc[i] << 1) * 6.283185307179586 / 4294967296.0;
+		pDst[i] = ref_sat_q31((q63_t)floor(sin(phase) * 2147483648.0 + 0.5));
+	}
+}
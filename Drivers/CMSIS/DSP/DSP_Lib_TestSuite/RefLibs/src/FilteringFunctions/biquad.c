@@ -711,3 +711,175 @@ void ref_biquad_cascade_df1_q15(
 
   } while (--stage);
 }
+
+void ref_biquad_cascade_mc_df2T_f32(
+	const arm_biquad_cascade_mc_df2T_instance_f32 * S,
+	float32_t * pSrc,
+	float32_t * pDst,
+	uint32_t blockSize)
+{
+    float32_t *pIn = pSrc;                         /*  source pointer            */
+    float32_t *pState = S->pState;                 /*  State pointer             */
+    float32_t *pCoeffs = S->pCoeffs;               /*  coefficient pointer       */
+    float32_t acc, Xn, d1, d2;                     /*  one channel               */
+    float32_t b0, b1, b2, a1, a2;                  /*  Filter coefficients       */
+    uint32_t numChannels = S->numChannels;         /*  number of channels        */
+    uint32_t n, ch, stage = S->numStages;          /*  loop counters             */
+
+    do
+    {
+        /* Reading the coefficients */
+        b0 = *pCoeffs++;
+        b1 = *pCoeffs++;
+        b2 = *pCoeffs++;
+        a1 = *pCoeffs++;
+        a2 = *pCoeffs++;
+
+        for (ch = 0; ch < numChannels; ch++)
+        {
+            d1 = pState[0];
+            d2 = pState[1];
+
+            for (n = 0; n < blockSize; n++)
+            {
+                Xn = pIn[n * numChannels + ch];
+
+                acc = (b0 * Xn) + d1;
+                pDst[n * numChannels + ch] = acc;
+
+                d1 = ((b1 * Xn) + (a1 * acc)) + d2;
+                d2 = (b2 * Xn) + (a2 * acc);
+            }
+
+            *pState++ = d1;
+            *pState++ = d2;
+        }
+
+        /* The current stage output is the input to the next stage */
+        pIn = pDst;
+
+        stage--;
+
+    } while (stage > 0U);
+}
+
+void ref_biquad_cascade_mc_df1_q31(
+  const arm_biquad_casd_mc_df1_inst_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize)
+{
+  q63_t acc;                                     /*  accumulator                   */
+  uint32_t lShift = 31U - (uint32_t) S->postShift; /*  Shift to be applied to the output */
+  q31_t *pIn = pSrc;                             /*  input pointer initialization  */
+  q31_t *pState = S->pState;                     /*  pState pointer initialization */
+  q31_t *pCoeffs = S->pCoeffs;                   /*  coeff pointer initialization  */
+  q31_t Xn, Xn1, Xn2, Yn1, Yn2;                  /*  Filter state variables        */
+  q31_t b0, b1, b2, a1, a2;                      /*  Filter coefficients           */
+  uint32_t numChannels = S->numChannels;         /*  number of channels            */
+  uint32_t n, ch, stage = S->numStages;          /*  loop counters                 */
+
+  do
+  {
+    b0 = *pCoeffs++;
+    b1 = *pCoeffs++;
+    b2 = *pCoeffs++;
+    a1 = *pCoeffs++;
+    a2 = *pCoeffs++;
+
+    for (ch = 0; ch < numChannels; ch++)
+    {
+      Xn1 = pState[0];
+      Xn2 = pState[1];
+      Yn1 = pState[2];
+      Yn2 = pState[3];
+
+      for (n = 0; n < blockSize; n++)
+      {
+        Xn = pIn[n * numChannels + ch];
+
+        acc = (q63_t)b0*Xn + (q63_t)b1*Xn1 + (q63_t)b2*Xn2 + (q63_t)a1*Yn1 + (q63_t)a2*Yn2;
+
+        /* The result is converted to 1.31  */
+        acc = acc >> lShift;
+
+        Xn2 = Xn1;
+        Xn1 = Xn;
+        Yn2 = Yn1;
+        Yn1 = (q31_t) acc;
+
+        pDst[n * numChannels + ch] = (q31_t) acc;
+      }
+
+      *pState++ = Xn1;
+      *pState++ = Xn2;
+      *pState++ = Yn1;
+      *pState++ = Yn2;
+    }
+
+    /*  Subsequent stages occur in-place in the output buffer */
+    pIn = pDst;
+
+  } while (--stage);
+}
+
+void ref_biquad_cascade_mc_df1_q15(
+  const arm_biquad_casd_mc_df1_inst_q15 * S,
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize)
+{
+  q63_t acc;                                     /*  Accumulator                   */
+  int32_t shift = (15 - (int32_t) S->postShift); /*  Post shift                    */
+  q15_t *pIn = pSrc;                             /*  Source pointer                */
+  q15_t *pState = S->pState;                     /*  State pointer                 */
+  q15_t *pCoeffs = S->pCoeffs;                   /*  Coefficient pointer           */
+  q15_t Xn, Xn1, Xn2, Yn1, Yn2;                  /*  Filter state variables        */
+  q15_t b0, b1, b2, a1, a2;                      /*  Filter coefficients           */
+  uint32_t numChannels = S->numChannels;         /*  number of channels            */
+  uint32_t n, ch, stage = (uint32_t) S->numStages; /*  loop counters               */
+
+  do
+  {
+    b0 = *pCoeffs++;
+    pCoeffs++;  // skip the 0 coefficient
+    b1 = *pCoeffs++;
+    b2 = *pCoeffs++;
+    a1 = *pCoeffs++;
+    a2 = *pCoeffs++;
+
+    for (ch = 0; ch < numChannels; ch++)
+    {
+      Xn1 = pState[0];
+      Xn2 = pState[1];
+      Yn1 = pState[2];
+      Yn2 = pState[3];
+
+      for (n = 0; n < blockSize; n++)
+      {
+        Xn = pIn[n * numChannels + ch];
+
+        acc = (q31_t)b0*Xn + (q31_t)b1*Xn1 + (q31_t)b2*Xn2 + (q31_t)a1*Yn1 + (q31_t)a2*Yn2;
+
+        /* The result is converted to 1.15  */
+        acc = ref_sat_q15(acc >> shift);
+
+        Xn2 = Xn1;
+        Xn1 = Xn;
+        Yn2 = Yn1;
+        Yn1 = (q15_t) acc;
+
+        pDst[n * numChannels + ch] = (q15_t) acc;
+      }
+
+      *pState++ = Xn1;
+      *pState++ = Xn2;
+      *pState++ = Yn1;
+      *pState++ = Yn2;
+    }
+
+    /*  Subsequent stages occur in-place in the output buffer */
+    pIn = pDst;
+
+  } while (--stage);
+}
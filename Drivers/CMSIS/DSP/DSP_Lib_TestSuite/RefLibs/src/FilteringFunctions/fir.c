@@ -323,3 +323,165 @@ void ref_fir_q7(
       pStateCurnt[i] = pState[i];
 	 }
 }
+
+void ref_fir_mc_f32(
+  const arm_fir_mc_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+   float32_t *pState = S->pState;                 /* State pointer */
+   float32_t *pCoeffs = S->pCoeffs;               /* Coefficient pointer */
+   float32_t *pStateCurnt;                        /* Points to the current frame of the state */
+   uint32_t numTaps = S->numTaps;             /* Number of filter coefficients in the filter */
+   uint32_t numChannels = S->numChannels;     /* Number of interleaved channels */
+   uint32_t i, ch;                            /* Loop counters */
+   float32_t acc;
+
+   /* pStateCurnt points to the location where the new input frame should be written */
+   pStateCurnt = &(S->pState[(numTaps - 1U) * numChannels]);
+
+   while (blockSize > 0U)
+   {
+      /* Copy one frame at a time into state buffer */
+      for(ch=0;ch<numChannels;ch++)
+      {
+         *pStateCurnt++ = *pSrc++;
+      }
+
+      for(ch=0;ch<numChannels;ch++)
+      {
+         acc = 0;
+
+         for(i=0;i<numTaps;i++)
+         {
+            /* Perform the multiply-accumulates */
+            acc += pState[i * numChannels + ch] * pCoeffs[i];
+         }
+
+         /* The result is store in the destination buffer. */
+         *pDst++ = acc;
+      }
+
+      /* Advance state pointer by 1 frame for the next frame */
+      pState += numChannels;
+
+      blockSize--;
+   }
+
+   /* Now copy the last numTaps - 1 frames to the starting of the state buffer. */
+   pStateCurnt = S->pState;
+
+   for(i=0;i<(numTaps-1)*numChannels;i++)
+   {
+      pStateCurnt[i] = pState[i];
+   }
+}
+
+void ref_fir_mc_q31(
+  const arm_fir_mc_instance_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize)
+{
+   q31_t *pState = S->pState;                 /* State pointer */
+   q31_t *pCoeffs = S->pCoeffs;               /* Coefficient pointer */
+   q31_t *pStateCurnt;                        /* Points to the current frame of the state */
+   uint32_t numTaps = S->numTaps;             /* Number of filter coefficients in the filter */
+   uint32_t numChannels = S->numChannels;     /* Number of interleaved channels */
+   uint32_t i, ch;                            /* Loop counters */
+   q63_t acc;
+
+   /* pStateCurnt points to the location where the new input frame should be written */
+   pStateCurnt = &(S->pState[(numTaps - 1U) * numChannels]);
+
+   while (blockSize > 0U)
+   {
+      /* Copy one frame at a time into state buffer */
+      for(ch=0;ch<numChannels;ch++)
+      {
+         *pStateCurnt++ = *pSrc++;
+      }
+
+      for(ch=0;ch<numChannels;ch++)
+      {
+         acc = 0;
+
+         for(i=0;i<numTaps;i++)
+         {
+            /* Perform the multiply-accumulates */
+            acc += (q63_t)pState[i * numChannels + ch] * pCoeffs[i];
+         }
+
+         /* The result is store in the destination buffer. */
+         *pDst++ = (q31_t)(acc >> 31);
+      }
+
+      /* Advance state pointer by 1 frame for the next frame */
+      pState += numChannels;
+
+      blockSize--;
+   }
+
+   /* Now copy the last numTaps - 1 frames to the starting of the state buffer. */
+   pStateCurnt = S->pState;
+
+   for(i=0;i<(numTaps-1)*numChannels;i++)
+   {
+      pStateCurnt[i] = pState[i];
+   }
+}
+
+void ref_fir_mc_q15(
+  const arm_fir_mc_instance_q15 * S,
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize)
+{
+   q15_t *pState = S->pState;                 /* State pointer */
+   q15_t *pCoeffs = S->pCoeffs;               /* Coefficient pointer */
+   q15_t *pStateCurnt;                        /* Points to the current frame of the state */
+   uint32_t numTaps = S->numTaps;             /* Number of filter coefficients in the filter */
+   uint32_t numChannels = S->numChannels;     /* Number of interleaved channels */
+   uint32_t i, ch;                            /* Loop counters */
+   q63_t acc;
+
+   /* pStateCurnt points to the location where the new input frame should be written */
+   pStateCurnt = &(S->pState[(numTaps - 1U) * numChannels]);
+
+   while (blockSize > 0U)
+   {
+      /* Copy one frame at a time into state buffer */
+      for(ch=0;ch<numChannels;ch++)
+      {
+         *pStateCurnt++ = *pSrc++;
+      }
+
+      for(ch=0;ch<numChannels;ch++)
+      {
+         acc = 0;
+
+         for(i=0;i<numTaps;i++)
+         {
+            /* Perform the multiply-accumulates */
+            acc += (q31_t)pState[i * numChannels + ch] * pCoeffs[i];
+         }
+
+         /* The result is store in the destination buffer. */
+         *pDst++ = ref_sat_q15(acc >> 15);
+      }
+
+      /* Advance state pointer by 1 frame for the next frame */
+      pState += numChannels;
+
+      blockSize--;
+   }
+
+   /* Now copy the last numTaps - 1 frames to the starting of the state buffer. */
+   pStateCurnt = S->pState;
+
+   for(i=0;i<(numTaps-1)*numChannels;i++)
+   {
+      pStateCurnt[i] = pState[i];
+   }
+}
@@ -0,0 +1,172 @@
+#include "ref.h"
+
+/*
+ * The k-th smallest sample of the window ending at pSrc[n], zeros before pSrc[0]:
+ * the one with at most k samples less than it and more than k samples less or equal.
+ */
+static float32_t ref_median_rank_f32(
+  float32_t * pSrc,
+  uint32_t n,
+  uint16_t windowSize,
+  uint32_t k)
+{
+	uint32_t i, j, less, lessEq;
+	uint32_t last = windowSize - 1U;
+	float32_t xi, xj;
+	
+	for(i=0;i<windowSize;i++)
+	{
+		xi = (n + i >= last) ? pSrc[n + i - last] : 0;
+		less = 0;
+		lessEq = 0;
+		for(j=0;j<windowSize;j++)
+		{
+			xj = (n + j >= last) ? pSrc[n + j - last] : 0;
+			if (xj < xi) less++;
+			if (xj <= xi) lessEq++;
+		}
+		if ((less <= k) && (k < lessEq))
+		{
+			return xi;
+		}
+	}
+	return 0;
+}
+
+void ref_median_filter_f32(
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize,
+  uint16_t windowSize)
+{
+	uint32_t n;
+	float32_t lower, upper;
+	
+	for(n=0;n<blockSize;n++)
+	{
+		upper = ref_median_rank_f32(pSrc, n, windowSize, windowSize / 2);
+		if (windowSize & 1)
+		{
+			pDst[n] = upper;
+		}
+		else
+		{
+			lower = ref_median_rank_f32(pSrc, n, windowSize, windowSize / 2 - 1);
+			pDst[n] = 0.5f * (lower + upper);
+		}
+	}
+}
+
+/*
+ * The k-th smallest sample of the window ending at pSrc[n], zeros before pSrc[0]:
+ * the one with at most k samples less than it and more than k samples less or equal.
+ */
+static q31_t ref_median_rank_q31(
+  q31_t * pSrc,
+  uint32_t n,
+  uint16_t windowSize,
+  uint32_t k)
+{
+	uint32_t i, j, less, lessEq;
+	uint32_t last = windowSize - 1U;
+	q31_t xi, xj;
+	
+	for(i=0;i<windowSize;i++)
+	{
+		xi = (n + i >= last) ? pSrc[n + i - last] : 0;
+		less = 0;
+		lessEq = 0;
+		for(j=0;j<windowSize;j++)
+		{
+			xj = (n + j >= last) ? pSrc[n + j - last] : 0;
+			if (xj < xi) less++;
+			if (xj <= xi) lessEq++;
+		}
+		if ((less <= k) && (k < lessEq))
+		{
+			return xi;
+		}
+	}
+	return 0;
+}
+
+void ref_median_filter_q31(
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize,
+  uint16_t windowSize)
+{
+	uint32_t n;
+	q31_t lower, upper;
+	
+	for(n=0;n<blockSize;n++)
+	{
+		upper = ref_median_rank_q31(pSrc, n, windowSize, windowSize / 2);
+		if (windowSize & 1)
+		{
+			pDst[n] = upper;
+		}
+		else
+		{
+			lower = ref_median_rank_q31(pSrc, n, windowSize, windowSize / 2 - 1);
+			pDst[n] = (q31_t)(((q63_t)lower + upper) >> 1);
+		}
+	}
+}
+
+/*
+ * The k-th smallest sample of the window ending at pSrc[n], zeros before pSrc[0]:
+ * the one with at most k samples less than it and more than k samples less or equal.
+ */
+static q15_t ref_median_rank_q15(
+  q15_t * pSrc,
+  uint32_t n,
+  uint16_t windowSize,
+  uint32_t k)
+{
+	uint32_t i, j, less, lessEq;
+	uint32_t last = windowSize - 1U;
+	q15_t xi, xj;
+	
+	for(i=0;i<windowSize;i++)
+	{
+		xi = (n + i >= last) ? pSrc[n + i - last] : 0;
+		less = 0;
+		lessEq = 0;
+		for(j=0;j<windowSize;j++)
+		{
+			xj = (n + j >= last) ? pSrc[n + j - last] : 0;
+			if (xj < xi) less++;
+			if (xj <= xi) lessEq++;
+		}
+		if ((less <= k) && (k < lessEq))
+		{
+			return xi;
+		}
+	}
+	return 0;
+}
+
+void ref_median_filter_q15(
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize,
+  uint16_t windowSize)
+{
+	uint32_t n;
+	q15_t lower, upper;
+	
+	for(n=0;n<blockSize;n++)
+	{
+		upper = ref_median_rank_q15(pSrc, n, windowSize, windowSize / 2);
+		if (windowSize & 1)
+		{
+			pDst[n] = upper;
+		}
+		else
+		{
+			lower = ref_median_rank_q15(pSrc, n, windowSize, windowSize / 2 - 1);
+			pDst[n] = (q15_t)(((q31_t)lower + upper) >> 1);
+		}
+	}
+}
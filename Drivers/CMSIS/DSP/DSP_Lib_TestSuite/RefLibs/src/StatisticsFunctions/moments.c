@@ -0,0 +1,59 @@
+#include "ref.h"
+
+void ref_skewness_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t * pResult)
+{
+	uint32_t i;
+	float64_t mean=0, d, m2=0, m3=0;
+	
+	for(i=0;i<blockSize;i++)
+	{
+			mean += pSrc[i];
+	}
+	mean /= blockSize;
+	
+	for(i=0;i<blockSize;i++)
+	{
+			d = pSrc[i] - mean;
+			m2 += d * d;
+			m3 += d * d * d;
+	}
+	
+	if (m2 == 0)
+	{
+		*pResult = 0;
+		return;
+	}
+	*pResult = (float32_t)(sqrt((float64_t)blockSize) * m3 / (m2 * sqrt(m2)));
+}
+
+void ref_kurtosis_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t * pResult)
+{
+	uint32_t i;
+	float64_t mean=0, d, m2=0, m4=0;
+	
+	for(i=0;i<blockSize;i++)
+	{
+			mean += pSrc[i];
+	}
+	mean /= blockSize;
+	
+	for(i=0;i<blockSize;i++)
+	{
+			d = pSrc[i] - mean;
+			m2 += d * d;
+			m4 += d * d * d * d;
+	}
+	
+	if (m2 == 0)
+	{
+		*pResult = 0;
+		return;
+	}
+	*pResult = (float32_t)(blockSize * m4 / (m2 * m2) - 3);
+}
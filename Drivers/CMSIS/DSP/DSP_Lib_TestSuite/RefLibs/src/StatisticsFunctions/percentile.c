@@ -0,0 +1,85 @@
+#include "ref.h"
+
+void ref_percentile_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t fraction,
+  float32_t * pResult)
+{
+	float32_t rank;
+	uint32_t index;
+	
+	ref_sort_f32(pSrc, blockSize);
+	
+	rank = fraction * (float32_t)(blockSize - 1);
+	if (rank < 0.0f) rank = 0.0f;
+	if (rank > (float32_t)(blockSize - 1)) rank = (float32_t)(blockSize - 1);
+	
+	index = (uint32_t)rank;
+	rank = rank - (float32_t)index;
+	
+	if (rank > 0.0f)
+	{
+		*pResult = pSrc[index] + rank * (pSrc[index+1] - pSrc[index]);
+	}
+	else
+	{
+		*pResult = pSrc[index];
+	}
+}
+
+void ref_percentile_q31(
+  q31_t * pSrc,
+  uint32_t blockSize,
+  q31_t fraction,
+  q31_t * pResult)
+{
+	q63_t rank;
+	uint32_t index;
+	q31_t frac;
+	
+	ref_sort_q31(pSrc, blockSize);
+	
+	if (fraction < 0) fraction = 0;
+	
+	rank = (q63_t)fraction * (blockSize - 1);
+	index = (uint32_t)(rank >> 31);
+	frac = (q31_t)(rank & 0x7FFFFFFF);
+	
+	if (frac > 0)
+	{
+		*pResult = (q31_t)(pSrc[index] + ((((q63_t)pSrc[index+1] - pSrc[index]) * frac) >> 31));
+	}
+	else
+	{
+		*pResult = pSrc[index];
+	}
+}
+
+void ref_percentile_q15(
+  q15_t * pSrc,
+  uint32_t blockSize,
+  q15_t fraction,
+  q15_t * pResult)
+{
+	q63_t rank;
+	uint32_t index;
+	q31_t frac;
+	
+	ref_sort_q15(pSrc, blockSize);
+	
+	if (fraction < 0) fraction = 0;
+	
+	rank = (q63_t)fraction * (blockSize - 1);
+	index = (uint32_t)(rank >> 15);
+	frac = (q31_t)(rank & 0x7FFF);
+	
+	if (frac > 0)
+	{
+		*pResult = (q15_t)(pSrc[index] + ((((q31_t)pSrc[index+1] - pSrc[index]) * frac) >> 15));
+	}
+	else
+	{
+		*pResult = pSrc[index];
+	}
+}
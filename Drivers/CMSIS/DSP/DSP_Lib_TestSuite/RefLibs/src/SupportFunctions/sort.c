@@ -0,0 +1,58 @@
+#include "ref.h"
+
+void ref_sort_f32(
+  float32_t * pSrc,
+  uint32_t blockSize)
+{
+	uint32_t i, j;
+	float32_t in;
+	
+	/* Insertion sort */
+	for(i=1;i<blockSize;i++)
+	{
+		in = pSrc[i];
+		for(j=i;(j>0) && (in < pSrc[j-1]);j--)
+		{
+			pSrc[j] = pSrc[j-1];
+		}
+		pSrc[j] = in;
+	}
+}
+
+void ref_sort_q31(
+  q31_t * pSrc,
+  uint32_t blockSize)
+{
+	uint32_t i, j;
+	q31_t in;
+	
+	/* Insertion sort */
+	for(i=1;i<blockSize;i++)
+	{
+		in = pSrc[i];
+		for(j=i;(j>0) && (in < pSrc[j-1]);j--)
+		{
+			pSrc[j] = pSrc[j-1];
+		}
+		pSrc[j] = in;
+	}
+}
+
+void ref_sort_q15(
+  q15_t * pSrc,
+  uint32_t blockSize)
+{
+	uint32_t i, j;
+	q15_t in;
+	
+	/* Insertion sort */
+	for(i=1;i<blockSize;i++)
+	{
+		in = pSrc[i];
+		for(j=i;(j>0) && (in < pSrc[j-1]);j--)
+		{
+			pSrc[j] = pSrc[j-1];
+		}
+		pSrc[j] = in;
+	}
+}
@@ -1,5 +1,6 @@
 #include "ref.h"
 #include "arm_const_structs.h"
+#include <string.h>
 	 
 void ref_cfft_f32(
    const arm_cfft_instance_f32 * S, 
@@ -67,6 +68,61 @@ void ref_cfft_f32(
 	}
 }
 
+/*
+ * Any length: the power-of-two ones go through ref_cfft_f32, which only reads
+ * S->fftLen, the others through a direct DFT accumulated in double, up to
+ * 4096 points.
+ */
+static float32_t ref_cfft_mr_out[2 * 4096];
+
+void ref_cfft_mr_f32(
+	const arm_cfft_mr_instance_f32 * S,
+	float32_t * p1,
+	uint8_t ifftFlag)
+{
+	arm_cfft_instance_f32 pow2;
+	uint32_t N = S->fftLen;
+	uint32_t k, n;
+	float64_t sumr, sumi, phase, stepr, stepi, wr, wi, wtemp;
+	int32_t dir = (ifftFlag) ? -1 : 1;
+
+	if ((N & (N - 1)) == 0)
+	{
+		pow2.fftLen = N;
+		ref_cfft_f32(&pow2, p1, ifftFlag, 1);
+		return;
+	}
+
+	for (k = 0; k < N; k++)
+	{
+		// W^(k*n) by a rotating phasor, the drift over N steps stays far
+		// below float32_t precision
+		phase = -6.283185307179586 * dir * (float64_t) k / N;
+		stepr = cos(phase);
+		stepi = sin(phase);
+		wr = 1.0;
+		wi = 0.0;
+		sumr = 0.0;
+		sumi = 0.0;
+		for (n = 0; n < N; n++)
+		{
+			sumr += p1[2*n] * wr - p1[2*n+1] * wi;
+			sumi += p1[2*n] * wi + p1[2*n+1] * wr;
+			wtemp = wr;
+			wr = wr * stepr - wi * stepi;
+			wi = wtemp * stepi + wi * stepr;
+		}
+		if (ifftFlag)
+		{
+			sumr /= N;
+			sumi /= N;
+		}
+		ref_cfft_mr_out[2*k]   = (float32_t) sumr;
+		ref_cfft_mr_out[2*k+1] = (float32_t) sumi;
+	}
+	memcpy(p1, ref_cfft_mr_out, 2 * N * sizeof(float32_t));
+}
+
 void ref_cfft_q31(
 	const arm_cfft_instance_q31 * S,
     q31_t * p1,
@@ -217,6 +273,38 @@ void ref_cfft_q15(
 	}
 }
 
+/*
+ * Unscaled transform of Q15 data in both directions, in floating point with
+ * 1.0 for 32768, as the output of arm_cfft_bfp_q15 times 2^blockExp.
+ */
+void ref_cfft_bfp_q15(
+	const arm_cfft_instance_q15 * S,
+	q15_t * pSrc,
+	float32_t * pDst,
+	uint8_t ifftFlag)
+{
+	arm_cfft_instance_f32 pow2;
+	uint32_t i;
+
+	for(i=0;i<S->fftLen*2;i++)
+	{
+		pDst[i] = (float32_t)pSrc[i] / 32768.0f;
+	}
+
+	// ref_cfft_f32 only reads S->fftLen
+	pow2.fftLen = S->fftLen;
+	ref_cfft_f32(&pow2, pDst, ifftFlag, 1);
+
+	// Undo the 1/N of the inverse transform
+	if (ifftFlag)
+	{
+		for(i=0;i<S->fftLen*2;i++)
+		{
+			pDst[i] *= (float32_t)S->fftLen;
+		}
+	}
+}
+
 void ref_cfft_radix2_f32(
 	const arm_cfft_radix2_instance_f32 * S,
 	float32_t * pSrc)
@@ -300,3 +300,57 @@ void ref_rfft_q15(
 		}
 	}
 }
+
+void ref_rfft_mr_f32(
+	arm_rfft_mr_instance_f32 * S,
+	float32_t * p, float32_t * pOut,
+	uint8_t ifftFlag)
+{
+	arm_cfft_mr_instance_f32 cfft;
+	uint32_t i,j;
+	
+	cfft.fftLen = S->fftLenRFFT;
+	
+	//same packing as ref_rfft_fast_f32, through a complex FFT of fftLenRFFT points
+	if (ifftFlag)
+	{
+		for(i=0;i<S->fftLenRFFT;i++)
+		{
+			pOut[i] = p[i];
+		}
+		pOut[S->fftLenRFFT] = pOut[1];
+		pOut[S->fftLenRFFT+1] = 0;
+		pOut[1] = 0;
+		j=4;
+		for(i = S->fftLenRFFT / 2 + 1;i < S->fftLenRFFT;i++)
+		{
+			pOut[2*i+0] = p[2*i+0 - j];
+			pOut[2*i+1] = -p[2*i+1 - j];
+			j+=4;
+		}
+	}
+	else
+	{
+		for(i=0;i<S->fftLenRFFT;i++)
+		{
+			pOut[2*i+0] = p[i];
+			pOut[2*i+1] = 0.0f;
+		}
+	}
+	
+	ref_cfft_mr_f32(&cfft, pOut, ifftFlag);
+	
+	if (ifftFlag)
+	{
+		//throw away the imaginary part which should be all zeros
+		for(i=0;i<S->fftLenRFFT;i++)
+		{
+			pOut[i] = pOut[2*i];
+		}
+	}
+	else
+	{
+		//pack last sample's real part into first sample's complex part
+		pOut[1] = pOut[S->fftLenRFFT];
+	}
+}
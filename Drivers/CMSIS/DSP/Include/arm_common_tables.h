@@ -118,4 +118,10 @@ extern const float32_t sinTable_f32[FAST_MATH_TABLE_SIZE + 1];
 extern const q31_t sinTable_q31[FAST_MATH_TABLE_SIZE + 1];
 extern const q15_t sinTable_q15[FAST_MATH_TABLE_SIZE + 1];
 
+/* Sorting network of the sort and order-statistic functions */
+#define ARM_SORT_NETWORK_SIZE ((uint32_t)16)
+#define ARMSORTNETWORK16_TABLE_LENGTH ((uint16_t)63)
+
+extern const uint8_t armSortNetwork16[ARMSORTNETWORK16_TABLE_LENGTH];
+
 #endif /*  ARM_COMMON_TABLES_H */
@@ -131,6 +131,13 @@
    * Define macro ARM_MATH_ARMV8MBL for building the library on Armv8-M Baseline target, ARM_MATH_ARMV8MML for building library
    * on Armv8-M Mainline target.
    *
+   * - ARM_MATH_HOST_X86:
+   *
+   * Define macro ARM_MATH_HOST_X86 for building the library on an x86 host with GCC or Clang, for offline tools and tests.
+   * The core intrinsics are provided in portable C and the scalar (non-DSP) code paths are used. When the compiler targets
+   * SSE4.1 (-msse4.1) or AVX2 and FMA (-mavx2 -mfma), vectorized versions of arm_fir_f32, arm_dot_prod_f32,
+   * arm_biquad_cascade_df2T_f32, arm_cmplx_mag_f32, arm_mat_mult_f32 and of the radix-8 butterflies of arm_cfft_f32 are used.
+   *
    * - __FPU_PRESENT:
    *
    * Initialize macro __FPU_PRESENT = 1 when building on FPU supported Targets. Enable this macro for floating point libraries.
@@ -337,8 +344,17 @@
   #if (defined (__DSP_PRESENT) && (__DSP_PRESENT == 1))
     #define ARM_MATH_DSP
   #endif
+#elif defined (ARM_MATH_HOST_X86)
+  #include <stdint.h>
+  #if defined (__AVX2__) && defined (__FMA__)
+    #define ARM_MATH_AVX2
+  #endif
+  #if defined (__SSE4_1__) || defined (ARM_MATH_AVX2)
+    #define ARM_MATH_SSE4
+    #include <immintrin.h>
+  #endif
 #else
-  #error "Define according the used Cortex core ARM_MATH_CM7, ARM_MATH_CM4, ARM_MATH_CM3, ARM_MATH_CM0PLUS, ARM_MATH_CM0, ARM_MATH_ARMV8MBL, ARM_MATH_ARMV8MML"
+  #error "Define according the used Cortex core ARM_MATH_CM7, ARM_MATH_CM4, ARM_MATH_CM3, ARM_MATH_CM0PLUS, ARM_MATH_CM0, ARM_MATH_ARMV8MBL, ARM_MATH_ARMV8MML, ARM_MATH_HOST_X86"
 #endif
 
 #undef  __CMSIS_GENERIC         /* enable NVIC and Systick functions */
@@ -479,6 +495,73 @@ extern "C"
   #error Unknown compiler
 #endif
 
+#if defined (ARM_MATH_HOST_X86)
+  /**
+   * @brief Core intrinsics of the Cortex-M headers, in portable C for the host
+   */
+#ifndef   __STATIC_INLINE
+  #define __STATIC_INLINE  static inline
+#endif
+#ifndef   __FPU_USED
+  #define __FPU_USED       1U
+#endif
+
+  CMSIS_INLINE __STATIC_INLINE int32_t __SSAT(
+  int32_t val,
+  uint32_t sat)
+  {
+    if ((sat >= 1U) && (sat <= 32U))
+    {
+      const int32_t max = (int32_t)((1U << (sat - 1U)) - 1U);
+      const int32_t min = -1 - max;
+
+      if (val > max)
+      {
+        return max;
+      }
+      else if (val < min)
+      {
+        return min;
+      }
+    }
+    return val;
+  }
+
+  CMSIS_INLINE __STATIC_INLINE uint32_t __USAT(
+  int32_t val,
+  uint32_t sat)
+  {
+    if (sat <= 31U)
+    {
+      const uint32_t max = ((1U << sat) - 1U);
+
+      if (val > (int32_t)max)
+      {
+        return max;
+      }
+      else if (val < 0)
+      {
+        return 0U;
+      }
+    }
+    return (uint32_t)val;
+  }
+
+  CMSIS_INLINE __STATIC_INLINE uint8_t __CLZ(
+  uint32_t data)
+  {
+    return (data == 0U) ? 32U : (uint8_t)__builtin_clz(data);
+  }
+
+  CMSIS_INLINE __STATIC_INLINE uint32_t __ROR(
+  uint32_t op1,
+  uint32_t op2)
+  {
+    op2 %= 32U;
+    return (op2 == 0U) ? op1 : ((op1 >> op2) | (op1 << (32U - op2)));
+  }
+#endif /* defined (ARM_MATH_HOST_X86) */
+
 #define __SIMD32(addr)        (*(__SIMD32_TYPE **) & (addr))
 #define __SIMD32_CONST(addr)  ((__SIMD32_TYPE *)(addr))
 #define _SIMD32_OFFSET(addr)  (*(__SIMD32_TYPE *)  (addr))
@@ -1011,7 +1094,7 @@ extern "C"
   {
     uint16_t numTaps;        /**< number of filter coefficients in the filter. */
     q7_t *pState;            /**< points to the state variable array. The array is of length numTaps+blockSize-1. */
-    q7_t *pCoeffs;           /**< points to the coefficient array. The array is of length numTaps.*/
+    q7_t *pCoeffs;           /**< points to the coefficient array. The array is of length numTaps. */
   } arm_fir_instance_q7;
 
   /**
@@ -1021,7 +1104,7 @@ extern "C"
   {
     uint16_t numTaps;         /**< number of filter coefficients in the filter. */
     q15_t *pState;            /**< points to the state variable array. The array is of length numTaps+blockSize-1. */
-    q15_t *pCoeffs;           /**< points to the coefficient array. The array is of length numTaps.*/
+    q15_t *pCoeffs;           /**< points to the coefficient array. The array is of length numTaps. */
   } arm_fir_instance_q15;
 
   /**
@@ -1195,6 +1278,136 @@ extern "C"
   uint32_t blockSize);
 
 
+  /**
+   * @brief Instance structure for the Q15 multi-channel FIR filter.
+   */
+  typedef struct
+  {
+    uint16_t numChannels;   /**< number of interleaved channels. */
+    uint16_t numTaps;       /**< number of filter coefficients in the filter. */
+    q15_t *pState;          /**< points to the state variable array. The array is of length (numTaps+blockSize-1)*numChannels. */
+    q15_t *pCoeffs;         /**< points to the coefficient array. The array is of length numTaps. */
+  } arm_fir_mc_instance_q15;
+
+  /**
+   * @brief Instance structure for the Q31 multi-channel FIR filter.
+   */
+  typedef struct
+  {
+    uint16_t numChannels;   /**< number of interleaved channels. */
+    uint16_t numTaps;       /**< number of filter coefficients in the filter. */
+    q31_t *pState;          /**< points to the state variable array. The array is of length (numTaps+blockSize-1)*numChannels. */
+    q31_t *pCoeffs;         /**< points to the coefficient array. The array is of length numTaps. */
+  } arm_fir_mc_instance_q31;
+
+  /**
+   * @brief Instance structure for the floating-point multi-channel FIR filter.
+   */
+  typedef struct
+  {
+    uint16_t numChannels;   /**< number of interleaved channels. */
+    uint16_t numTaps;       /**< number of filter coefficients in the filter. */
+    float32_t *pState;      /**< points to the state variable array. The array is of length (numTaps+blockSize-1)*numChannels. */
+    float32_t *pCoeffs;     /**< points to the coefficient array. The array is of length numTaps. */
+  } arm_fir_mc_instance_f32;
+
+
+  /**
+   * @brief Processing function for the Q15 multi-channel FIR filter.
+   * @param[in]  S          points to an instance of the Q15 multi-channel FIR structure.
+   * @param[in]  pSrc       points to the block of input frames, numChannels interleaved samples each.
+   * @param[out] pDst       points to the block of output frames.
+   * @param[in]  blockSize  number of frames to process.
+   */
+  void arm_fir_mc_q15(
+  const arm_fir_mc_instance_q15 * S,
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Initialization function for the Q15 multi-channel FIR filter.
+   * @param[in,out] S            points to an instance of the Q15 multi-channel FIR structure.
+   * @param[in]     numChannels  number of interleaved channels.
+   * @param[in]     numTaps      Number of filter coefficients in the filter.
+   * @param[in]     pCoeffs      points to the filter coefficients, shared by the channels.
+   * @param[in]     pState       points to the state buffer.
+   * @param[in]     blockSize    number of frames that are processed at a time.
+   */
+  void arm_fir_mc_init_q15(
+  arm_fir_mc_instance_q15 * S,
+  uint16_t numChannels,
+  uint16_t numTaps,
+  q15_t * pCoeffs,
+  q15_t * pState,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief Processing function for the Q31 multi-channel FIR filter.
+   * @param[in]  S          points to an instance of the Q31 multi-channel FIR structure.
+   * @param[in]  pSrc       points to the block of input frames, numChannels interleaved samples each.
+   * @param[out] pDst       points to the block of output frames.
+   * @param[in]  blockSize  number of frames to process.
+   */
+  void arm_fir_mc_q31(
+  const arm_fir_mc_instance_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Initialization function for the Q31 multi-channel FIR filter.
+   * @param[in,out] S            points to an instance of the Q31 multi-channel FIR structure.
+   * @param[in]     numChannels  number of interleaved channels.
+   * @param[in]     numTaps      Number of filter coefficients in the filter.
+   * @param[in]     pCoeffs      points to the filter coefficients, shared by the channels.
+   * @param[in]     pState       points to the state buffer.
+   * @param[in]     blockSize    number of frames that are processed at a time.
+   */
+  void arm_fir_mc_init_q31(
+  arm_fir_mc_instance_q31 * S,
+  uint16_t numChannels,
+  uint16_t numTaps,
+  q31_t * pCoeffs,
+  q31_t * pState,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief Processing function for the floating-point multi-channel FIR filter.
+   * @param[in]  S          points to an instance of the floating-point multi-channel FIR structure.
+   * @param[in]  pSrc       points to the block of input frames, numChannels interleaved samples each.
+   * @param[out] pDst       points to the block of output frames.
+   * @param[in]  blockSize  number of frames to process.
+   */
+  void arm_fir_mc_f32(
+  const arm_fir_mc_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Initialization function for the floating-point multi-channel FIR filter.
+   * @param[in,out] S            points to an instance of the floating-point multi-channel FIR structure.
+   * @param[in]     numChannels  number of interleaved channels.
+   * @param[in]     numTaps      Number of filter coefficients in the filter.
+   * @param[in]     pCoeffs      points to the filter coefficients, shared by the channels.
+   * @param[in]     pState       points to the state buffer.
+   * @param[in]     blockSize    number of frames that are processed at a time.
+   */
+  void arm_fir_mc_init_f32(
+  arm_fir_mc_instance_f32 * S,
+  uint16_t numChannels,
+  uint16_t numTaps,
+  float32_t * pCoeffs,
+  float32_t * pState,
+  uint32_t blockSize);
+
+
   /**
    * @brief Instance structure for the Q15 Biquad cascade filter.
    */
@@ -2099,6 +2312,21 @@ void arm_cfft_q15(
     uint8_t ifftFlag,
     uint8_t bitReverseFlag);
 
+  /**
+   * @brief Block floating-point Q15 complex FFT.
+   * @param[in]      *S              points to an instance of the Q15 CFFT structure.
+   * @param[in, out] *p1             points to the complex data buffer of size <code>2*fftLen</code>.
+   * @param[in]      ifftFlag        flag that selects forward (ifftFlag=0) or inverse (ifftFlag=1) transform.
+   * @param[in]      bitReverseFlag  flag that enables (bitReverseFlag=1) or disables (bitReverseFlag=0) bit reversal of output.
+   * @param[out]     *pBlockExp      points to the block exponent: the unscaled transform is the output times <code>2^(*pBlockExp)</code>.
+   */
+void arm_cfft_bfp_q15(
+    const arm_cfft_instance_q15 * S,
+    q15_t * p1,
+    uint8_t ifftFlag,
+    uint8_t bitReverseFlag,
+    int32_t * pBlockExp);
+
   /**
    * @brief Instance structure for the fixed-point CFFT/CIFFT function.
    */
@@ -2229,6 +2457,114 @@ void arm_rfft_fast_f32(
   float32_t * p, float32_t * pOut,
   uint8_t ifftFlag);
 
+  /**
+   * @brief Maximum number of radix stages of a mixed-radix FFT plan.
+   */
+#define ARM_CFFT_MR_MAX_STAGES 16U
+
+  /**
+   * @brief Sizes, in float32_t, of the twiddle and work buffers given to the mixed-radix FFT init functions.
+   */
+#define ARM_CFFT_MR_TWIDDLE_SIZE(fftLen) (2U * (fftLen))
+#define ARM_CFFT_MR_BUFFER_SIZE(fftLen)  (2U * (fftLen))
+#define ARM_RFFT_MR_TWIDDLE_SIZE(fftLen) ((fftLen) + 2U * ((fftLen) / 4U + 1U))
+#define ARM_RFFT_MR_BUFFER_SIZE(fftLen)  (fftLen)
+
+  /**
+   * @brief Instance structure for the floating-point mixed-radix CFFT/CIFFT function.
+   */
+  typedef struct
+  {
+    uint16_t fftLen;                               /**< length of the FFT, a product of 2, 3, 4 and 5. */
+    uint8_t numStages;                             /**< number of radix stages. */
+    uint8_t radix[ARM_CFFT_MR_MAX_STAGES];         /**< radix of each stage, in execution order. */
+    const float32_t *pTwiddle;                     /**< points to the fftLen complex twiddle factors. */
+    float32_t *pBuffer;                            /**< points to the work buffer of 2*fftLen values. */
+  } arm_cfft_mr_instance_f32;
+
+  arm_status arm_cfft_mr_init_f32(
+  arm_cfft_mr_instance_f32 * S,
+  uint16_t fftLen,
+  float32_t * pTwiddle,
+  float32_t * pBuffer);
+
+  void arm_cfft_mr_f32(
+  const arm_cfft_mr_instance_f32 * S,
+  float32_t * p1,
+  uint8_t ifftFlag);
+
+  /**
+   * @brief Instance structure for the floating-point mixed-radix RFFT/RIFFT function.
+   */
+  typedef struct
+  {
+    arm_cfft_mr_instance_f32 Sint;                 /**< Internal CFFT structure, of fftLenRFFT/2 points. */
+    uint16_t fftLenRFFT;                           /**< length of the real sequence */
+    const float32_t *pTwiddleRFFT;                 /**< Twiddle factors real stage  */
+  } arm_rfft_mr_instance_f32;
+
+  arm_status arm_rfft_mr_init_f32(
+  arm_rfft_mr_instance_f32 * S,
+  uint16_t fftLen,
+  float32_t * pTwiddle,
+  float32_t * pBuffer);
+
+  void arm_rfft_mr_f32(
+  const arm_rfft_mr_instance_f32 * S,
+  float32_t * p, float32_t * pOut,
+  uint8_t ifftFlag);
+
+  /**
+   * @brief Size, in float32_t, of the buffer given to arm_fir_fft_init_f32().
+   */
+#define ARM_FIR_FFT_BUFFER_SIZE(numTaps, blockSize) (4U * (numTaps) + 9U * (blockSize))
+
+  /**
+   * @brief Instance structure for the floating-point FFT-based FIR filter.
+   */
+  typedef struct
+  {
+    uint16_t numTaps;                    /**< number of filter coefficients in the filter. */
+    uint16_t partLen;                    /**< taps per partition and samples per FFT block, 0 for the direct form. */
+    uint16_t numParts;                   /**< number of partitions of the filter. */
+    uint16_t fdlIndex;                   /**< slot of the newest input spectrum in the delay line. */
+    float32_t *pState;                   /**< points to the previous input block, partLen values. */
+    float32_t *pCoeffsFreq;              /**< points to the partition spectra, numParts*2*partLen values. */
+    float32_t *pFdl;                     /**< points to the frequency-domain delay line, numParts*2*partLen values. */
+    float32_t *pScratch;                 /**< points to the work buffer, 4*partLen values. */
+    arm_rfft_fast_instance_f32 rfft;     /**< real FFT of 2*partLen points. */
+    arm_fir_instance_f32 fir;            /**< direct form, used when partLen is 0. */
+  } arm_fir_fft_instance_f32;
+
+  /**
+   * @brief  Initialization function for the floating-point FFT-based FIR filter.
+   * @param[in,out] S          points to an instance of the FFT-based FIR filter structure.
+   * @param[in]     numTaps    Number of filter coefficients in the filter.
+   * @param[in]     pCoeffs    points to the filter coefficients, in the order of arm_fir_init_f32().
+   * @param[in]     pBuffer    points to ARM_FIR_FFT_BUFFER_SIZE(numTaps, blockSize) values.
+   * @param[in]     blockSize  number of samples that are processed at a time.
+   * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if numTaps or blockSize is 0.
+   */
+  arm_status arm_fir_fft_init_f32(
+  arm_fir_fft_instance_f32 * S,
+  uint16_t numTaps,
+  float32_t * pCoeffs,
+  float32_t * pBuffer,
+  uint32_t blockSize);
+
+  /**
+   * @brief Processing function for the floating-point FFT-based FIR filter.
+   * @param[in,out] S          points to an instance of the FFT-based FIR filter structure.
+   * @param[in]     pSrc       points to the block of input data.
+   * @param[out]    pDst       points to the block of output data.
+   * @param[in]     blockSize  number of samples to process, the one given at init or a multiple of partLen.
+   */
+  void arm_fir_fft_f32(
+  arm_fir_fft_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
   /**
    * @brief Instance structure for the floating-point DCT4/IDCT4 function.
    */
@@ -2887,6 +3223,36 @@ void arm_rfft_fast_f32(
   uint32_t blockSize);
 
 
+  /**
+   * @brief  Sorts the elements of a floating-point vector in ascending order, in place.
+   * @param[in,out] pSrc       points to the vector
+   * @param[in]     blockSize  number of elements in the vector
+   */
+  void arm_sort_f32(
+  float32_t * pSrc,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Sorts the elements of a Q31 vector in ascending order, in place.
+   * @param[in,out] pSrc       points to the vector
+   * @param[in]     blockSize  number of elements in the vector
+   */
+  void arm_sort_q31(
+  q31_t * pSrc,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Sorts the elements of a Q15 vector in ascending order, in place.
+   * @param[in,out] pSrc       points to the vector
+   * @param[in]     blockSize  number of elements in the vector
+   */
+  void arm_sort_q15(
+  q15_t * pSrc,
+  uint32_t blockSize);
+
+
 /**
  * @brief Convolution of floating-point sequences.
  * @param[in]  pSrcA    points to the first input sequence.
@@ -3251,7 +3617,7 @@ void arm_rfft_fast_f32(
   {
     uint8_t M;                  /**< decimation factor. */
     uint16_t numTaps;           /**< number of coefficients in the filter. */
-    q15_t *pCoeffs;             /**< points to the coefficient array. The array is of length numTaps.*/
+    q15_t *pCoeffs;             /**< points to the coefficient array. The array is of length numTaps. */
     q15_t *pState;              /**< points to the state variable array. The array is of length numTaps+blockSize-1. */
   } arm_fir_decimate_instance_q15;
 
@@ -3262,7 +3628,7 @@ void arm_rfft_fast_f32(
   {
     uint8_t M;                  /**< decimation factor. */
     uint16_t numTaps;           /**< number of coefficients in the filter. */
-    q31_t *pCoeffs;             /**< points to the coefficient array. The array is of length numTaps.*/
+    q31_t *pCoeffs;             /**< points to the coefficient array. The array is of length numTaps. */
     q31_t *pState;              /**< points to the state variable array. The array is of length numTaps+blockSize-1. */
   } arm_fir_decimate_instance_q31;
 
@@ -3273,7 +3639,7 @@ void arm_rfft_fast_f32(
   {
     uint8_t M;                  /**< decimation factor. */
     uint16_t numTaps;           /**< number of coefficients in the filter. */
-    float32_t *pCoeffs;         /**< points to the coefficient array. The array is of length numTaps.*/
+    float32_t *pCoeffs;         /**< points to the coefficient array. The array is of length numTaps. */
     float32_t *pState;          /**< points to the state variable array. The array is of length numTaps+blockSize-1. */
   } arm_fir_decimate_instance_f32;
 
@@ -3684,6 +4050,256 @@ void arm_rfft_fast_f32(
   float32_t * pState);
 
 
+  /**
+   * @brief Instance structure for the floating-point multi-channel transposed direct form II Biquad cascade filter.
+   */
+  typedef struct
+  {
+    uint16_t numChannels;      /**< number of interleaved channels. */
+    uint8_t numStages;         /**< number of 2nd order stages in the filter.  Overall order is 2*numStages. */
+    float32_t *pState;         /**< points to the array of state coefficients.  The array is of length 2*numStages*numChannels. */
+    float32_t *pCoeffs;        /**< points to the array of coefficients.  The array is of length 5*numStages. */
+  } arm_biquad_cascade_mc_df2T_instance_f32;
+
+  /**
+   * @brief Instance structure for the Q15 multi-channel Biquad cascade filter.
+   */
+  typedef struct
+  {
+    uint16_t numChannels;    /**< number of interleaved channels. */
+    int8_t numStages;        /**< number of 2nd order stages in the filter.  Overall order is 2*numStages. */
+    q15_t *pState;           /**< Points to the array of state coefficients.  The array is of length 4*numStages*numChannels. */
+    q15_t *pCoeffs;          /**< Points to the array of coefficients.  The array is of length 6*numStages. */
+    int8_t postShift;        /**< Additional shift, in bits, applied to each output sample. */
+  } arm_biquad_casd_mc_df1_inst_q15;
+
+  /**
+   * @brief Instance structure for the Q31 multi-channel Biquad cascade filter.
+   */
+  typedef struct
+  {
+    uint16_t numChannels;    /**< number of interleaved channels. */
+    uint32_t numStages;      /**< number of 2nd order stages in the filter.  Overall order is 2*numStages. */
+    q31_t *pState;           /**< Points to the array of state coefficients.  The array is of length 4*numStages*numChannels. */
+    q31_t *pCoeffs;          /**< Points to the array of coefficients.  The array is of length 5*numStages. */
+    uint8_t postShift;       /**< Additional shift, in bits, applied to each output sample. */
+  } arm_biquad_casd_mc_df1_inst_q31;
+
+
+  /**
+   * @brief Processing function for the floating-point multi-channel transposed direct form II Biquad cascade filter.
+   * @param[in]  S          points to an instance of the filter data structure.
+   * @param[in]  pSrc       points to the block of input frames, numChannels interleaved samples each.
+   * @param[out] pDst       points to the block of output frames.
+   * @param[in]  blockSize  number of frames to process.
+   */
+  void arm_biquad_cascade_mc_df2T_f32(
+  const arm_biquad_cascade_mc_df2T_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Initialization function for the floating-point multi-channel transposed direct form II Biquad cascade filter.
+   * @param[in,out] S            points to an instance of the filter data structure.
+   * @param[in]     numChannels  number of interleaved channels.
+   * @param[in]     numStages    number of 2nd order stages in the filter.
+   * @param[in]     pCoeffs      points to the filter coefficients, shared by the channels.
+   * @param[in]     pState       points to the state buffer.
+   */
+  void arm_biquad_cascade_mc_df2T_init_f32(
+  arm_biquad_cascade_mc_df2T_instance_f32 * S,
+  uint16_t numChannels,
+  uint8_t numStages,
+  float32_t * pCoeffs,
+  float32_t * pState);
+
+
+  /**
+   * @brief Processing function for the Q15 multi-channel Biquad cascade filter.
+   * @param[in]  S          points to an instance of the Q15 multi-channel Biquad cascade structure.
+   * @param[in]  pSrc       points to the block of input frames, numChannels interleaved samples each.
+   * @param[out] pDst       points to the block of output frames.
+   * @param[in]  blockSize  number of frames to process.
+   */
+  void arm_biquad_cascade_mc_df1_q15(
+  const arm_biquad_casd_mc_df1_inst_q15 * S,
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Initialization function for the Q15 multi-channel Biquad cascade filter.
+   * @param[in,out] S            points to an instance of the Q15 multi-channel Biquad cascade structure.
+   * @param[in]     numChannels  number of interleaved channels.
+   * @param[in]     numStages    number of 2nd order stages in the filter.
+   * @param[in]     pCoeffs      points to the filter coefficients, shared by the channels.
+   * @param[in]     pState       points to the state buffer.
+   * @param[in]     postShift    Shift to be applied to the output. Varies according to the coefficients format
+   */
+  void arm_biquad_cascade_mc_df1_init_q15(
+  arm_biquad_casd_mc_df1_inst_q15 * S,
+  uint16_t numChannels,
+  uint8_t numStages,
+  q15_t * pCoeffs,
+  q15_t * pState,
+  int8_t postShift);
+
+
+  /**
+   * @brief Processing function for the Q31 multi-channel Biquad cascade filter.
+   * @param[in]  S          points to an instance of the Q31 multi-channel Biquad cascade structure.
+   * @param[in]  pSrc       points to the block of input frames, numChannels interleaved samples each.
+   * @param[out] pDst       points to the block of output frames.
+   * @param[in]  blockSize  number of frames to process.
+   */
+  void arm_biquad_cascade_mc_df1_q31(
+  const arm_biquad_casd_mc_df1_inst_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Initialization function for the Q31 multi-channel Biquad cascade filter.
+   * @param[in,out] S            points to an instance of the Q31 multi-channel Biquad cascade structure.
+   * @param[in]     numChannels  number of interleaved channels.
+   * @param[in]     numStages    number of 2nd order stages in the filter.
+   * @param[in]     pCoeffs      points to the filter coefficients, shared by the channels.
+   * @param[in]     pState       points to the state buffer.
+   * @param[in]     postShift    Shift to be applied to the output. Varies according to the coefficients format
+   */
+  void arm_biquad_cascade_mc_df1_init_q31(
+  arm_biquad_casd_mc_df1_inst_q31 * S,
+  uint16_t numChannels,
+  uint8_t numStages,
+  q31_t * pCoeffs,
+  q31_t * pState,
+  int8_t postShift);
+
+
+  /**
+   * @brief Instance structure for the floating-point median filter.
+   */
+  typedef struct
+  {
+    uint16_t windowSize;    /**< number of samples in the window. */
+    uint16_t stateIndex;    /**< index of the oldest sample in the window. */
+    float32_t *pState;      /**< points to the window samples. The array is of length windowSize. */
+    int16_t *pIndex;        /**< points to the heap, then the heap node of every sample. The array is of length 2*windowSize. */
+  } arm_median_filter_instance_f32;
+
+
+  /**
+   * @brief Processing function for the floating-point sliding window median filter.
+   * @param[in]  S          points to an instance of the floating-point median filter structure.
+   * @param[in]  pSrc       points to the block of input data.
+   * @param[out] pDst       points to the block of output data.
+   * @param[in]  blockSize  number of samples to process.
+   */
+  void arm_median_filter_f32(
+  arm_median_filter_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Initialization function for the floating-point median filter.
+   * @param[in,out] S           points to an instance of the floating-point median filter structure.
+   * @param[in]     windowSize  number of samples in the window, from 1 to 32767.
+   * @param[in]     pState      points to the window samples, of length windowSize.
+   * @param[in]     pIndex      points to the heap and positions, of length 2*windowSize.
+   */
+  void arm_median_filter_init_f32(
+  arm_median_filter_instance_f32 * S,
+  uint16_t windowSize,
+  float32_t * pState,
+  int16_t * pIndex);
+
+
+  /**
+   * @brief Instance structure for the Q31 median filter.
+   */
+  typedef struct
+  {
+    uint16_t windowSize;    /**< number of samples in the window. */
+    uint16_t stateIndex;    /**< index of the oldest sample in the window. */
+    q31_t *pState;          /**< points to the window samples. The array is of length windowSize. */
+    int16_t *pIndex;        /**< points to the heap, then the heap node of every sample. The array is of length 2*windowSize. */
+  } arm_median_filter_instance_q31;
+
+
+  /**
+   * @brief Processing function for the Q31 sliding window median filter.
+   * @param[in]  S          points to an instance of the Q31 median filter structure.
+   * @param[in]  pSrc       points to the block of input data.
+   * @param[out] pDst       points to the block of output data.
+   * @param[in]  blockSize  number of samples to process.
+   */
+  void arm_median_filter_q31(
+  arm_median_filter_instance_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Initialization function for the Q31 median filter.
+   * @param[in,out] S           points to an instance of the Q31 median filter structure.
+   * @param[in]     windowSize  number of samples in the window, from 1 to 32767.
+   * @param[in]     pState      points to the window samples, of length windowSize.
+   * @param[in]     pIndex      points to the heap and positions, of length 2*windowSize.
+   */
+  void arm_median_filter_init_q31(
+  arm_median_filter_instance_q31 * S,
+  uint16_t windowSize,
+  q31_t * pState,
+  int16_t * pIndex);
+
+
+  /**
+   * @brief Instance structure for the Q15 median filter.
+   */
+  typedef struct
+  {
+    uint16_t windowSize;    /**< number of samples in the window. */
+    uint16_t stateIndex;    /**< index of the oldest sample in the window. */
+    q15_t *pState;          /**< points to the window samples. The array is of length windowSize. */
+    int16_t *pIndex;        /**< points to the heap, then the heap node of every sample. The array is of length 2*windowSize. */
+  } arm_median_filter_instance_q15;
+
+
+  /**
+   * @brief Processing function for the Q15 sliding window median filter.
+   * @param[in]  S          points to an instance of the Q15 median filter structure.
+   * @param[in]  pSrc       points to the block of input data.
+   * @param[out] pDst       points to the block of output data.
+   * @param[in]  blockSize  number of samples to process.
+   */
+  void arm_median_filter_q15(
+  arm_median_filter_instance_q15 * S,
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Initialization function for the Q15 median filter.
+   * @param[in,out] S           points to an instance of the Q15 median filter structure.
+   * @param[in]     windowSize  number of samples in the window, from 1 to 32767.
+   * @param[in]     pState      points to the window samples, of length windowSize.
+   * @param[in]     pIndex      points to the heap and positions, of length 2*windowSize.
+   */
+  void arm_median_filter_init_q15(
+  arm_median_filter_instance_q15 * S,
+  uint16_t windowSize,
+  q15_t * pState,
+  int16_t * pIndex);
+
+
   /**
    * @brief  Initialization function for the floating-point transposed direct form II Biquad cascade filter.
    * @param[in,out] S          points to an instance of the filter data structure.
@@ -4413,7 +5029,7 @@ void arm_rfft_fast_f32(
     uint16_t numTaps;             /**< number of coefficients in the filter. */
     uint16_t stateIndex;          /**< state buffer index.  Points to the oldest sample in the state buffer. */
     float32_t *pState;            /**< points to the state buffer array. The array is of length maxDelay+blockSize-1. */
-    float32_t *pCoeffs;           /**< points to the coefficient array. The array is of length numTaps.*/
+    float32_t *pCoeffs;           /**< points to the coefficient array. The array is of length numTaps. */
     uint16_t maxDelay;            /**< maximum offset specified by the pTapDelay array. */
     int32_t *pTapDelay;           /**< points to the array of delay values.  The array is of length numTaps. */
   } arm_fir_sparse_instance_f32;
@@ -4426,7 +5042,7 @@ void arm_rfft_fast_f32(
     uint16_t numTaps;             /**< number of coefficients in the filter. */
     uint16_t stateIndex;          /**< state buffer index.  Points to the oldest sample in the state buffer. */
     q31_t *pState;                /**< points to the state buffer array. The array is of length maxDelay+blockSize-1. */
-    q31_t *pCoeffs;               /**< points to the coefficient array. The array is of length numTaps.*/
+    q31_t *pCoeffs;               /**< points to the coefficient array. The array is of length numTaps. */
     uint16_t maxDelay;            /**< maximum offset specified by the pTapDelay array. */
     int32_t *pTapDelay;           /**< points to the array of delay values.  The array is of length numTaps. */
   } arm_fir_sparse_instance_q31;
@@ -4439,7 +5055,7 @@ void arm_rfft_fast_f32(
     uint16_t numTaps;             /**< number of coefficients in the filter. */
     uint16_t stateIndex;          /**< state buffer index.  Points to the oldest sample in the state buffer. */
     q15_t *pState;                /**< points to the state buffer array. The array is of length maxDelay+blockSize-1. */
-    q15_t *pCoeffs;               /**< points to the coefficient array. The array is of length numTaps.*/
+    q15_t *pCoeffs;               /**< points to the coefficient array. The array is of length numTaps. */
     uint16_t maxDelay;            /**< maximum offset specified by the pTapDelay array. */
     int32_t *pTapDelay;           /**< points to the array of delay values.  The array is of length numTaps. */
   } arm_fir_sparse_instance_q15;
@@ -4452,7 +5068,7 @@ void arm_rfft_fast_f32(
     uint16_t numTaps;             /**< number of coefficients in the filter. */
     uint16_t stateIndex;          /**< state buffer index.  Points to the oldest sample in the state buffer. */
     q7_t *pState;                 /**< points to the state buffer array. The array is of length maxDelay+blockSize-1. */
-    q7_t *pCoeffs;                /**< points to the coefficient array. The array is of length numTaps.*/
+    q7_t *pCoeffs;                /**< points to the coefficient array. The array is of length numTaps. */
     uint16_t maxDelay;            /**< maximum offset specified by the pTapDelay array. */
     int32_t *pTapDelay;           /**< points to the array of delay values.  The array is of length numTaps. */
   } arm_fir_sparse_instance_q7;
@@ -5780,6 +6396,144 @@ void arm_rfft_fast_f32(
    */
 
 
+  /**
+   * @brief  Block sine for floating-point data.
+   * @param[in]  pSrc       points to the input vector, in radians.
+   * @param[out] pDst       points to the output vector.
+   * @param[in]  blockSize  number of samples in the vector.
+   */
+  void arm_vsin_f32(
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Block sine for Q31 data.
+   * @param[in]  pSrc       points to the input vector, [0 +0.9999] maps to [0 2*pi).
+   * @param[out] pDst       points to the output vector.
+   * @param[in]  blockSize  number of samples in the vector.
+   */
+  void arm_vsin_q31(
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Block cosine for floating-point data.
+   * @param[in]  pSrc       points to the input vector, in radians.
+   * @param[out] pDst       points to the output vector.
+   * @param[in]  blockSize  number of samples in the vector.
+   */
+  void arm_vcos_f32(
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Block cosine for Q31 data.
+   * @param[in]  pSrc       points to the input vector, [0 +0.9999] maps to [0 2*pi).
+   * @param[out] pDst       points to the output vector.
+   * @param[in]  blockSize  number of samples in the vector.
+   */
+  void arm_vcos_q31(
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Block four-quadrant arctangent for floating-point data.
+   * @param[in]  pSrcY      points to the vector of ordinates.
+   * @param[in]  pSrcX      points to the vector of abscissas.
+   * @param[out] pDst       points to the output vector, in radians.
+   * @param[in]  blockSize  number of samples in each vector.
+   */
+  void arm_vatan2_f32(
+  float32_t * pSrcY,
+  float32_t * pSrcX,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Block four-quadrant arctangent for Q31 data.
+   * @param[in]  pSrcY      points to the vector of ordinates.
+   * @param[in]  pSrcX      points to the vector of abscissas.
+   * @param[out] pDst       points to the output vector, 1.0 is 2*pi.
+   * @param[in]  blockSize  number of samples in each vector.
+   */
+  void arm_vatan2_q31(
+  q31_t * pSrcY,
+  q31_t * pSrcX,
+  q31_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Block exponential for floating-point data.
+   * @param[in]  pSrc       points to the input vector.
+   * @param[out] pDst       points to the output vector.
+   * @param[in]  blockSize  number of samples in the vector.
+   */
+  void arm_vexp_f32(
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Block natural logarithm for floating-point data.
+   * @param[in]  pSrc       points to the input vector.
+   * @param[out] pDst       points to the output vector.
+   * @param[in]  blockSize  number of samples in the vector.
+   */
+  void arm_vlog_f32(
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Block base 10 logarithm for floating-point data.
+   * @param[in]  pSrc       points to the input vector.
+   * @param[out] pDst       points to the output vector.
+   * @param[in]  blockSize  number of samples in the vector.
+   */
+  void arm_vlog10_f32(
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Block natural logarithm for Q31 data.
+   * @param[in]  pSrc       points to the input vector.
+   * @param[out] pDst       points to the output vector, in 5.26 format.
+   * @param[in]  blockSize  number of samples in the vector.
+   */
+  void arm_vlog_q31(
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Block power for floating-point data.
+   * @param[in]  pSrcA      points to the vector of bases.
+   * @param[in]  pSrcB      points to the vector of exponents.
+   * @param[out] pDst       points to the output vector.
+   * @param[in]  blockSize  number of samples in each vector.
+   */
+  void arm_vpow_f32(
+  float32_t * pSrcA,
+  float32_t * pSrcB,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+
   /**
    * @brief floating-point Circular write function.
    */
@@ -6284,6 +7038,187 @@ void arm_rfft_fast_f32(
   q15_t * pResult);
 
 
+  /**
+   * @brief Instance structure for the floating-point running statistics.
+   * The moments are sums of powers of the deviations from the mean of the
+   * count samples seen so far.
+   */
+  typedef struct
+  {
+    uint32_t count;           /**< number of samples seen. */
+    float32_t mean;           /**< mean of the samples. */
+    float32_t m2;             /**< sum of the squared deviations from the mean. */
+    float32_t m3;             /**< sum of the cubed deviations from the mean. */
+    float32_t m4;             /**< sum of the fourth powers of the deviations from the mean. */
+    float32_t min;            /**< smallest sample. */
+    float32_t max;            /**< largest sample. */
+  } arm_running_stats_instance_f32;
+
+
+  /**
+   * @brief  Initialization function for the floating-point running statistics.
+   * @param[in,out] S  points to an instance of the running statistics structure.
+   */
+  void arm_running_stats_init_f32(
+  arm_running_stats_instance_f32 * S);
+
+
+  /**
+   * @brief  Adds a block of samples to the floating-point running statistics.
+   * @param[in,out] S          points to an instance of the running statistics structure.
+   * @param[in]     pSrc       points to the block of samples.
+   * @param[in]     blockSize  number of samples in the block.
+   */
+  void arm_running_stats_f32(
+  arm_running_stats_instance_f32 * S,
+  float32_t * pSrc,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Merges two floating-point running statistics.
+   * @param[in,out] S       points to the running statistics, updated with the samples of pOther.
+   * @param[in]     pOther  points to the running statistics of other samples.
+   */
+  void arm_running_stats_merge_f32(
+  arm_running_stats_instance_f32 * S,
+  const arm_running_stats_instance_f32 * pOther);
+
+
+  /**
+   * @brief  Variance of the samples of floating-point running statistics.
+   * @param[in]  S        points to an instance of the running statistics structure.
+   * @param[out] pResult  variance, as given by arm_var_f32().
+   */
+  void arm_running_stats_var_f32(
+  const arm_running_stats_instance_f32 * S,
+  float32_t * pResult);
+
+
+  /**
+   * @brief  Standard deviation of the samples of floating-point running statistics.
+   * @param[in]  S        points to an instance of the running statistics structure.
+   * @param[out] pResult  standard deviation, as given by arm_std_f32().
+   */
+  void arm_running_stats_std_f32(
+  const arm_running_stats_instance_f32 * S,
+  float32_t * pResult);
+
+
+  /**
+   * @brief  Root Mean Square of the samples of floating-point running statistics.
+   * @param[in]  S        points to an instance of the running statistics structure.
+   * @param[out] pResult  RMS value, as given by arm_rms_f32().
+   */
+  void arm_running_stats_rms_f32(
+  const arm_running_stats_instance_f32 * S,
+  float32_t * pResult);
+
+
+  /**
+   * @brief  Skewness of the samples of floating-point running statistics.
+   * @param[in]  S        points to an instance of the running statistics structure.
+   * @param[out] pResult  skewness of the samples.
+   */
+  void arm_running_stats_skewness_f32(
+  const arm_running_stats_instance_f32 * S,
+  float32_t * pResult);
+
+
+  /**
+   * @brief  Excess kurtosis of the samples of floating-point running statistics.
+   * @param[in]  S        points to an instance of the running statistics structure.
+   * @param[out] pResult  excess kurtosis of the samples.
+   */
+  void arm_running_stats_kurtosis_f32(
+  const arm_running_stats_instance_f32 * S,
+  float32_t * pResult);
+
+
+  /**
+   * @brief  k-th smallest element of a floating-point vector, by quickselect.
+   * @param[in,out] pSrc       points to the input vector, reordered
+   * @param[in]     blockSize  length of the input vector
+   * @param[in]     k          rank of the element, 0 for the minimum
+   * @param[out]    pResult    k-th smallest element
+   */
+  void arm_quickselect_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  uint32_t k,
+  float32_t * pResult);
+
+
+  /**
+   * @brief  Percentile of a floating-point vector, interpolated between the closest ranks.
+   * @param[in,out] pSrc       points to the input vector, reordered
+   * @param[in]     blockSize  length of the input vector
+   * @param[in]     fraction   percentile as a fraction, from 0 to 1 (0.5 for the median)
+   * @param[out]    pResult    percentile value
+   */
+  void arm_percentile_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t fraction,
+  float32_t * pResult);
+
+
+  /**
+   * @brief  k-th smallest element of a Q31 vector, by quickselect.
+   * @param[in,out] pSrc       points to the input vector, reordered
+   * @param[in]     blockSize  length of the input vector
+   * @param[in]     k          rank of the element, 0 for the minimum
+   * @param[out]    pResult    k-th smallest element
+   */
+  void arm_quickselect_q31(
+  q31_t * pSrc,
+  uint32_t blockSize,
+  uint32_t k,
+  q31_t * pResult);
+
+
+  /**
+   * @brief  Percentile of a Q31 vector, interpolated between the closest ranks.
+   * @param[in,out] pSrc       points to the input vector, reordered
+   * @param[in]     blockSize  length of the input vector
+   * @param[in]     fraction   percentile as a fraction in 1.31 format (0x40000000 for the median)
+   * @param[out]    pResult    percentile value
+   */
+  void arm_percentile_q31(
+  q31_t * pSrc,
+  uint32_t blockSize,
+  q31_t fraction,
+  q31_t * pResult);
+
+
+  /**
+   * @brief  k-th smallest element of a Q15 vector, by quickselect.
+   * @param[in,out] pSrc       points to the input vector, reordered
+   * @param[in]     blockSize  length of the input vector
+   * @param[in]     k          rank of the element, 0 for the minimum
+   * @param[out]    pResult    k-th smallest element
+   */
+  void arm_quickselect_q15(
+  q15_t * pSrc,
+  uint32_t blockSize,
+  uint32_t k,
+  q15_t * pResult);
+
+
+  /**
+   * @brief  Percentile of a Q15 vector, interpolated between the closest ranks.
+   * @param[in,out] pSrc       points to the input vector, reordered
+   * @param[in]     blockSize  length of the input vector
+   * @param[in]     fraction   percentile as a fraction in 1.15 format (0x4000 for the median)
+   * @param[out]    pResult    percentile value
+   */
+  void arm_percentile_q15(
+  q15_t * pSrc,
+  uint32_t blockSize,
+  q15_t fraction,
+  q15_t * pResult);
+
+
   /**
    * @brief  Floating-point complex magnitude
    * @param[in]  pSrc        points to the complex input vector
@@ -95,6 +95,55 @@ void arm_dot_prod_f32(
    ** No loop unrolling is used. */
   blkCnt = blockSize % 0x4U;
 
+#elif defined (ARM_MATH_SSE4)
+
+  /* Run the below code for x86 hosts */
+  /* Partial sums in the lanes of the accumulators, added together at the end. The order
+   ** of the additions differs from the scalar code, the result is within rounding of it */
+  __m128 acc4 = _mm_setzero_ps();
+
+#if defined (ARM_MATH_AVX2)
+  __m256 acc8a = _mm256_setzero_ps();
+  __m256 acc8b = _mm256_setzero_ps();
+
+  blkCnt = blockSize >> 4U;
+
+  while (blkCnt > 0U)
+  {
+    acc8a = _mm256_fmadd_ps(_mm256_loadu_ps(pSrcA), _mm256_loadu_ps(pSrcB), acc8a);
+    acc8b = _mm256_fmadd_ps(_mm256_loadu_ps(pSrcA + 8), _mm256_loadu_ps(pSrcB + 8), acc8b);
+    pSrcA += 16;
+    pSrcB += 16;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  acc8a = _mm256_add_ps(acc8a, acc8b);
+  acc4 = _mm_add_ps(_mm256_castps256_ps128(acc8a), _mm256_extractf128_ps(acc8a, 1));
+
+  blkCnt = (blockSize & 0xFU) >> 2U;
+#else
+  blkCnt = blockSize >> 2U;
+#endif
+
+  while (blkCnt > 0U)
+  {
+    acc4 = _mm_add_ps(acc4, _mm_mul_ps(_mm_loadu_ps(pSrcA), _mm_loadu_ps(pSrcB)));
+    pSrcA += 4;
+    pSrcB += 4;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Horizontal sum of the four lanes */
+  acc4 = _mm_hadd_ps(acc4, acc4);
+  acc4 = _mm_hadd_ps(acc4, acc4);
+  sum = _mm_cvtss_f32(acc4);
+
+  blkCnt = blockSize % 0x4U;
+
 #else
 
   /* Run the below code for Cortex-M0 */
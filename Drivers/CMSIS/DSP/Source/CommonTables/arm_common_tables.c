@@ -22174,3 +22174,32 @@ const q15_t sinTable_q15[FAST_MATH_TABLE_SIZE + 1] = {
 	-5998, -5602, -5205, -4808, -4410, -4011, -3612, -3212, -2811, -2411,
 	-2009, -1608, -1206, -804, -402, 0
 };
+
+
+/**
+ * \par
+ * Batcher's odd-even merge sorting network of 16 inputs, 63 comparators.
+ * Every byte is a comparator (i, j), i < j, with i in the high nibble and
+ * j in the low nibble: after it, x[i] <= x[j].
+ * \par
+ * The comparators with j >= n, in order, sort n < 16 inputs: they never
+ * exchange when x[n] to x[15] are padded with the largest value.
+ * \par
+ * Example code for the generation of the table:
+ * <pre>
+ * merge(lo, n, r): m = 2 * r
+ *     if (m < n) { merge(lo, n, m); merge(lo + r, n, m);
+ *                  for (i = lo + r; i + r < lo + n; i += m) emit(i, i + r); }
+ *     else emit(lo, lo + r);
+ * sort(lo, n): if (n > 1) { sort(lo, n / 2); sort(lo + n / 2, n / 2); merge(lo, n, 1); }
+ * sort(0, 16);</pre>
+ */
+
+const uint8_t armSortNetwork16[ARMSORTNETWORK16_TABLE_LENGTH] = {
+	0x01, 0x23, 0x02, 0x13, 0x12, 0x45, 0x67, 0x46, 0x57, 0x56, 0x04, 0x26,
+	0x24, 0x15, 0x37, 0x35, 0x12, 0x34, 0x56, 0x89, 0xAB, 0x8A, 0x9B, 0x9A,
+	0xCD, 0xEF, 0xCE, 0xDF, 0xDE, 0x8C, 0xAE, 0xAC, 0x9D, 0xBF, 0xBD, 0x9A,
+	0xBC, 0xDE, 0x08, 0x4C, 0x48, 0x2A, 0x6E, 0x6A, 0x24, 0x68, 0xAC, 0x19,
+	0x5D, 0x59, 0x3B, 0x7F, 0x7B, 0x35, 0x79, 0xBD, 0x12, 0x34, 0x56, 0x78,
+	0x9A, 0xBC, 0xDE
+};
@@ -128,6 +128,69 @@ void arm_cmplx_mag_f32(
     blkCnt--;
   }
 
+#elif defined (ARM_MATH_SSE4)
+
+  /* Run the below code for x86 hosts */
+  uint32_t blkCnt;                               /* loop counter */
+  __m128 a4, b4, re4, im4;
+
+#if defined (ARM_MATH_AVX2)
+  __m256 a8, b8, re8, im8, mag8;
+
+  /* 8 outputs at a time. The in-lane shuffles leave the samples in the order
+   ** 0 1 4 5 2 3 6 7, put back once the magnitudes are computed */
+  blkCnt = numSamples >> 3U;
+
+  while (blkCnt > 0U)
+  {
+    a8 = _mm256_loadu_ps(pSrc);
+    b8 = _mm256_loadu_ps(pSrc + 8);
+    re8 = _mm256_shuffle_ps(a8, b8, _MM_SHUFFLE(2, 0, 2, 0));
+    im8 = _mm256_shuffle_ps(a8, b8, _MM_SHUFFLE(3, 1, 3, 1));
+    mag8 = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(re8, re8), _mm256_mul_ps(im8, im8)));
+    mag8 = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(mag8), _MM_SHUFFLE(3, 1, 2, 0)));
+    _mm256_storeu_ps(pDst, mag8);
+    pSrc += 16;
+    pDst += 8;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  blkCnt = (numSamples & 0x7U) >> 2U;
+#else
+  blkCnt = numSamples >> 2U;
+#endif
+
+  /* 4 outputs at a time, real and imaginary parts split into two vectors */
+  while (blkCnt > 0U)
+  {
+    a4 = _mm_loadu_ps(pSrc);
+    b4 = _mm_loadu_ps(pSrc + 4);
+    re4 = _mm_shuffle_ps(a4, b4, _MM_SHUFFLE(2, 0, 2, 0));
+    im4 = _mm_shuffle_ps(a4, b4, _MM_SHUFFLE(3, 1, 3, 1));
+    _mm_storeu_ps(pDst, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(re4, re4), _mm_mul_ps(im4, im4))));
+    pSrc += 8;
+    pDst += 4;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  blkCnt = numSamples % 0x4U;
+
+  while (blkCnt > 0U)
+  {
+    /* C[0] = sqrt(A[0] * A[0] + A[1] * A[1]) */
+    realIn = *pSrc++;
+    imagIn = *pSrc++;
+    /* store the result in the destination buffer. */
+    arm_sqrt_f32((realIn * realIn) + (imagIn * imagIn), pDst++);
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
 #else
 
   /* Run the below code for Cortex-M0 */
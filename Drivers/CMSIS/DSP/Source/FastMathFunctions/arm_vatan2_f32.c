@@ -0,0 +1,247 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_vatan2_f32.c
+ * Description:  Block four-quadrant arctangent for floating-point vectors
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @defgroup VAtan2 Block Four-Quadrant Arctangent
+ *
+ * Computes the angle of every (x, y) point of two vectors, as atan2(y, x) of the
+ * standard C library. The ratio t of the smaller to the larger magnitude is in [0, 1],
+ * and its arctangent is a minimax polynomial:
+ * <pre>
+ *     atan(t) = t * P(t^2)
+ * </pre>
+ * of degree 17. The octant and the signs of x and y then map the result to (-pi, pi]:
+ * <pre>
+ *     |y| > |x|  :  a = pi/2 - a
+ *     x < 0      :  a = pi - a
+ *     y < 0      :  a = -a
+ * </pre>
+ * The processing is the same for every element, without branches, so that it runs on
+ * 4 lanes on the host and keeps the FPU pipeline of the Cortex-M4 busy with 4 independent
+ * evaluations.
+ *
+ * The Q31 angle is scaled as the input of arm_vsin_q31(): the result is atan2(y, x) / (2 * pi),
+ * in (-0.5, +0.5]. The ratio uses a reciprocal from Newton-Raphson iterations, and the
+ * polynomial of degree 19 is evaluated in fixed point.
+ *
+ * \par Accuracy
+ * The relative error of the floating-point results is below 2.4e-7 (2 ulp). The signs of
+ * zeros are handled as by the C library, and atan2(0, 0) is 0; the result for two
+ * infinite inputs is NaN. The Q31 results are within 4 LSB of the exact ones, and
+ * the angle of (0, 0) is 0.
+ */
+
+/**
+ * @addtogroup VAtan2
+ * @{
+ */
+
+#define VATAN2_PI      3.14159265358979f
+#define VATAN2_PI_2    1.57079632679490f
+
+/* atan(t) = t * P(t^2) */
+#define VATAN2_A0     0.9999999847657763f
+#define VATAN2_A1    -0.3333307334509511f
+#define VATAN2_A2     0.19992619392562183f
+#define VATAN2_A3    -0.1420364447389128f
+#define VATAN2_A4     0.10640934054802251f
+#define VATAN2_A5    -0.07504294602587981f
+#define VATAN2_A6     0.04269152002991623f
+#define VATAN2_A7    -0.016068629430126245f
+#define VATAN2_A8     0.0028498897389127344f
+
+/**
+ * @brief  Four-quadrant arctangent of one point.
+ * @param[in]  y  ordinate.
+ * @param[in]  x  abscissa.
+ * @return atan2(y, x).
+ */
+CMSIS_INLINE __STATIC_INLINE float32_t arm_vatan2_core_f32(
+  float32_t y,
+  float32_t x)
+{
+  union
+  {
+    float32_t f;
+    uint32_t u;
+  } a, sx, sy;
+  float32_t ax, ay, mx, mn, t, s, p;
+
+  sx.f = x;
+  sy.f = y;
+  ax = fabsf(x);
+  ay = fabsf(y);
+
+  /* Ratio in [0, 1], 0 for the origin */
+  mx = (ay > ax) ? ay : ax;
+  mn = (ay > ax) ? ax : ay;
+  t = mn / mx;
+  t = (mx > 0.0f) ? t : 0.0f;
+  s = t * t;
+
+  p = (((((((VATAN2_A8 * s) + VATAN2_A7) * s) + VATAN2_A6) * s) + VATAN2_A5) * s) + VATAN2_A4;
+  p = (((((((p * s) + VATAN2_A3) * s) + VATAN2_A2) * s) + VATAN2_A1) * s) + VATAN2_A0;
+  a.f = p * t;
+
+  /* Octant, then half plane from the sign bit of x, and sign of y */
+  a.f = (ay > ax) ? (VATAN2_PI_2 - a.f) : a.f;
+  a.f = ((sx.u >> 31) != 0U) ? (VATAN2_PI - a.f) : a.f;
+  a.u ^= sy.u & 0x80000000U;
+
+  return (a.f);
+}
+
+/**
+ * @brief  Block four-quadrant arctangent for floating-point data.
+ * @param[in]  *pSrcY     points to the vector of ordinates.
+ * @param[in]  *pSrcX     points to the vector of abscissas.
+ * @param[out] *pDst      points to the output vector, in radians.
+ * @param[in]  blockSize  number of samples in each vector.
+ * @return none.
+ *
+ * \par
+ * The output can be one of the input buffers, for an in-place computation.
+ */
+
+void arm_vatan2_f32(
+  float32_t * pSrcY,
+  float32_t * pSrcX,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t *pY = pSrcY;                         /* Ordinate pointer */
+  float32_t *pX = pSrcX;                         /* Abscissa pointer */
+  float32_t *pOut = pDst;                        /* Output pointer */
+  uint32_t blkCnt;                               /* Loop counter */
+
+#if defined (ARM_MATH_SSE4)
+  /* Run the below code for x86 hosts */
+  __m128 vy, vx, vsign, vax, vay, vswap, vmx, vt, vs, vp;
+
+  vsign = _mm_set1_ps(-0.0f);
+
+  blkCnt = blockSize >> 2U;
+
+  while (blkCnt > 0U)
+  {
+    vy = _mm_loadu_ps(pY);
+    vx = _mm_loadu_ps(pX);
+    pY += 4;
+    pX += 4;
+
+    vax = _mm_andnot_ps(vsign, vx);
+    vay = _mm_andnot_ps(vsign, vy);
+
+    /* Ratio in [0, 1], 0 for the origin */
+    vswap = _mm_cmpgt_ps(vay, vax);
+    vmx = _mm_max_ps(vax, vay);
+    vt = _mm_div_ps(_mm_min_ps(vax, vay), vmx);
+    vt = _mm_and_ps(vt, _mm_cmpgt_ps(vmx, _mm_setzero_ps()));
+    vs = _mm_mul_ps(vt, vt);
+
+    vp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(VATAN2_A8), vs), _mm_set1_ps(VATAN2_A7));
+    vp = _mm_add_ps(_mm_mul_ps(vp, vs), _mm_set1_ps(VATAN2_A6));
+    vp = _mm_add_ps(_mm_mul_ps(vp, vs), _mm_set1_ps(VATAN2_A5));
+    vp = _mm_add_ps(_mm_mul_ps(vp, vs), _mm_set1_ps(VATAN2_A4));
+    vp = _mm_add_ps(_mm_mul_ps(vp, vs), _mm_set1_ps(VATAN2_A3));
+    vp = _mm_add_ps(_mm_mul_ps(vp, vs), _mm_set1_ps(VATAN2_A2));
+    vp = _mm_add_ps(_mm_mul_ps(vp, vs), _mm_set1_ps(VATAN2_A1));
+    vp = _mm_add_ps(_mm_mul_ps(vp, vs), _mm_set1_ps(VATAN2_A0));
+    vp = _mm_mul_ps(vp, vt);
+
+    /* Octant, then half plane from the sign bit of x, and sign of y */
+    vp = _mm_blendv_ps(vp, _mm_sub_ps(_mm_set1_ps(VATAN2_PI_2), vp), vswap);
+    vp = _mm_blendv_ps(vp, _mm_sub_ps(_mm_set1_ps(VATAN2_PI), vp), vx);
+    vp = _mm_xor_ps(vp, _mm_and_ps(vsign, vy));
+
+    _mm_storeu_ps(pOut, vp);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#elif defined (ARM_MATH_DSP)
+  /* Run the below code for Cortex-M4 and Cortex-M7 */
+  float32_t inY1, inY2, inY3, inY4;              /* Temporary input variables */
+  float32_t inX1, inX2, inX3, inX4;              /* Temporary input variables */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2U;
+
+  /* Four independent evaluations, interleaved by the compiler in the FPU pipeline.
+  ** A second loop below computes the remaining 1 to 3 samples. */
+  while (blkCnt > 0U)
+  {
+    inY1 = pY[0];
+    inY2 = pY[1];
+    inY3 = pY[2];
+    inY4 = pY[3];
+    inX1 = pX[0];
+    inX2 = pX[1];
+    inX3 = pX[2];
+    inX4 = pX[3];
+    pY += 4;
+    pX += 4;
+
+    pOut[0] = arm_vatan2_core_f32(inY1, inX1);
+    pOut[1] = arm_vatan2_core_f32(inY2, inX2);
+    pOut[2] = arm_vatan2_core_f32(inY3, inX3);
+    pOut[3] = arm_vatan2_core_f32(inY4, inX4);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#else
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #if defined (ARM_MATH_SSE4) */
+
+  while (blkCnt > 0U)
+  {
+    *pOut++ = arm_vatan2_core_f32(*pY++, *pX++);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of VAtan2 group
+ */
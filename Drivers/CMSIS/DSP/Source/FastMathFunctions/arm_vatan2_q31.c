@@ -0,0 +1,188 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_vatan2_q31.c
+ * Description:  Block four-quadrant arctangent for Q31 vectors
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @addtogroup VAtan2
+ * @{
+ */
+
+/* Initial reciprocal of d in [0.5, 1): 48/17 - 32/17 * d */
+#define VATAN2_Q31_R0  3031741621U
+#define VATAN2_Q31_R1  4042322161U
+
+/* atan(t) / (2 * pi) = t * A(t^2) */
+#define VATAN2_Q31_A0  ((q31_t) 0x145F3067)
+#define VATAN2_Q31_A1  ((q31_t) 0xF9359C91)
+#define VATAN2_Q31_A2  ((q31_t) 0x0412DA1D)
+#define VATAN2_Q31_A3  ((q31_t) 0xFD18FAFB)
+#define VATAN2_Q31_A4  ((q31_t) 0x02374F0D)
+#define VATAN2_Q31_A5  ((q31_t) 0xFE53A305)
+#define VATAN2_Q31_A6  ((q31_t) 0x011EFB61)
+#define VATAN2_Q31_A7  ((q31_t) 0xFF6B6A4C)
+#define VATAN2_Q31_A8  ((q31_t) 0x0031E53F)
+#define VATAN2_Q31_A9  ((q31_t) 0xFFF820F2)
+
+/**
+ * @brief  Four-quadrant arctangent of one Q31 point.
+ * @param[in]  y  ordinate.
+ * @param[in]  x  abscissa.
+ * @return atan2(y, x) / (2 * pi).
+ */
+CMSIS_INLINE __STATIC_INLINE q31_t arm_vatan2_core_q31(
+  q31_t y,
+  q31_t x)
+{
+  uint32_t ax, ay, mx, mn, d, r;
+  uint32_t shift;
+  q31_t t, s, p, a;
+
+  /* Magnitudes, 0x80000000 included */
+  ax = (x < 0) ? (0U - (uint32_t) x) : (uint32_t) x;
+  ay = (y < 0) ? (0U - (uint32_t) y) : (uint32_t) y;
+  mx = (ay > ax) ? ay : ax;
+  mn = (ay > ax) ? ax : ay;
+
+  if (mx == 0U)
+  {
+    return (0);
+  }
+
+  /* Normalized divisor in [0.5, 1), and its reciprocal in 2.30 format */
+  shift = __CLZ(mx);
+  d = mx << shift;
+  r = VATAN2_Q31_R0 - (uint32_t) (((uint64_t) VATAN2_Q31_R1 * d) >> 33);
+  r = (uint32_t) (((uint64_t) r * (0x80000000U - (uint32_t) (((uint64_t) d * r) >> 32))) >> 30);
+  r = (uint32_t) (((uint64_t) r * (0x80000000U - (uint32_t) (((uint64_t) d * r) >> 32))) >> 30);
+  r = (uint32_t) (((uint64_t) r * (0x80000000U - (uint32_t) (((uint64_t) d * r) >> 32))) >> 30);
+
+  /* Ratio in [0, 1] */
+  d = (uint32_t) (((uint64_t) (mn << shift) * r) >> 31);
+  t = (d > 0x7FFFFFFFU) ? 0x7FFFFFFF : (q31_t) d;
+  s = (q31_t) (((q63_t) t * t) >> 31);
+
+  p = (q31_t) ((((q63_t) VATAN2_Q31_A9 * s) + 0x40000000) >> 31) + VATAN2_Q31_A8;
+  p = (q31_t) ((((q63_t) p * s) + 0x40000000) >> 31) + VATAN2_Q31_A7;
+  p = (q31_t) ((((q63_t) p * s) + 0x40000000) >> 31) + VATAN2_Q31_A6;
+  p = (q31_t) ((((q63_t) p * s) + 0x40000000) >> 31) + VATAN2_Q31_A5;
+  p = (q31_t) ((((q63_t) p * s) + 0x40000000) >> 31) + VATAN2_Q31_A4;
+  p = (q31_t) ((((q63_t) p * s) + 0x40000000) >> 31) + VATAN2_Q31_A3;
+  p = (q31_t) ((((q63_t) p * s) + 0x40000000) >> 31) + VATAN2_Q31_A2;
+  p = (q31_t) ((((q63_t) p * s) + 0x40000000) >> 31) + VATAN2_Q31_A1;
+  p = (q31_t) ((((q63_t) p * s) + 0x40000000) >> 31) + VATAN2_Q31_A0;
+  a = (q31_t) ((((q63_t) p * t) + 0x40000000) >> 31);
+
+  /* Octant, then half plane and sign; a quarter turn is 0x20000000 */
+  a = (ay > ax) ? (0x20000000 - a) : a;
+  a = (x < 0) ? (0x40000000 - a) : a;
+  a = (y < 0) ? -a : a;
+
+  return (a);
+}
+
+/**
+ * @brief  Block four-quadrant arctangent for Q31 data.
+ * @param[in]  *pSrcY     points to the vector of ordinates.
+ * @param[in]  *pSrcX     points to the vector of abscissas.
+ * @param[out] *pDst      points to the output vector, 1.0 is 2*pi.
+ * @param[in]  blockSize  number of samples in each vector.
+ * @return none.
+ *
+ * \par
+ * Only the ratio of y to x matters, so that both can use any common scaling.
+ * The output can be one of the input buffers, for an in-place computation.
+ */
+
+void arm_vatan2_q31(
+  q31_t * pSrcY,
+  q31_t * pSrcX,
+  q31_t * pDst,
+  uint32_t blockSize)
+{
+  q31_t *pY = pSrcY;                             /* Ordinate pointer */
+  q31_t *pX = pSrcX;                             /* Abscissa pointer */
+  q31_t *pOut = pDst;                            /* Output pointer */
+  uint32_t blkCnt;                               /* Loop counter */
+
+#if defined (ARM_MATH_DSP)
+  /* Run the below code for Cortex-M4 and Cortex-M7 */
+  q31_t inY1, inY2, inY3, inY4;                  /* Temporary input variables */
+  q31_t inX1, inX2, inX3, inX4;                  /* Temporary input variables */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2U;
+
+  /* Four independent evaluations, interleaved by the compiler in the pipeline.
+  ** A second loop below computes the remaining 1 to 3 samples. */
+  while (blkCnt > 0U)
+  {
+    inY1 = pY[0];
+    inY2 = pY[1];
+    inY3 = pY[2];
+    inY4 = pY[3];
+    inX1 = pX[0];
+    inX2 = pX[1];
+    inX3 = pX[2];
+    inX4 = pX[3];
+    pY += 4;
+    pX += 4;
+
+    pOut[0] = arm_vatan2_core_q31(inY1, inX1);
+    pOut[1] = arm_vatan2_core_q31(inY2, inX2);
+    pOut[2] = arm_vatan2_core_q31(inY3, inX3);
+    pOut[3] = arm_vatan2_core_q31(inY4, inX4);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#else
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #if defined (ARM_MATH_DSP) */
+
+  while (blkCnt > 0U)
+  {
+    *pOut++ = arm_vatan2_core_q31(*pY++, *pX++);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of VAtan2 group
+ */
@@ -0,0 +1,201 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_vcos_f32.c
+ * Description:  Block cosine for floating-point vectors
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @addtogroup VSinCos
+ * @{
+ */
+
+/* 2/pi, and pi/2 split so that j * DP1 and j * DP2 are exact for |j| < 2^16 */
+#define VCOS_2_PI    0.636619772367581f
+#define VCOS_DP1     1.5703125f
+#define VCOS_DP2     4.837512969970703125e-4f
+#define VCOS_DP3     7.54978995489188216e-8f
+
+/* Adding 1.5 * 2^23 rounds to an integer, left in the low mantissa bits */
+#define VCOS_ROUND   12582912.0f
+
+/* sin(r) = r + r * z * S(z), cos(r) = 1 - z / 2 + z * z * C(z), z = r * r */
+#define VCOS_S0     -1.6666654611e-1f
+#define VCOS_S1      8.3321608736e-3f
+#define VCOS_S2     -1.9515295891e-4f
+#define VCOS_C0      4.166664568298827e-2f
+#define VCOS_C1     -1.388731625493765e-3f
+#define VCOS_C2      2.443315711809948e-5f
+
+/**
+ * @brief  Cosine of one sample, the sine one quadrant further.
+ * @param[in]  x  input value in radians.
+ * @return cos(x).
+ */
+CMSIS_INLINE __STATIC_INLINE float32_t arm_vcos_core_f32(
+  float32_t x)
+{
+  union
+  {
+    float32_t f;
+    uint32_t u;
+  } t;
+  float32_t j, r, z, s, c;
+  uint32_t quad;
+
+  /* Quadrant of the input */
+  t.f = (x * VCOS_2_PI) + VCOS_ROUND;
+  j = t.f - VCOS_ROUND;
+  quad = t.u + 1U;
+
+  /* Reduction to [-pi/4, pi/4] */
+  r = ((x - (j * VCOS_DP1)) - (j * VCOS_DP2)) - (j * VCOS_DP3);
+  z = r * r;
+
+  s = r + ((r * z) * ((((VCOS_S2 * z) + VCOS_S1) * z) + VCOS_S0));
+  c = (1.0f - (0.5f * z)) + ((z * z) * ((((VCOS_C2 * z) + VCOS_C1) * z) + VCOS_C0));
+
+  /* cos(x) = sin(x + pi/2): odd quadrants use the cosine, the last two are negated */
+  t.f = ((quad & 1U) != 0U) ? c : s;
+  t.u ^= (quad & 2U) << 30;
+
+  return (t.f);
+}
+
+/**
+ * @brief  Block cosine for floating-point data.
+ * @param[in]  *pSrc      points to the input vector, in radians.
+ * @param[out] *pDst      points to the output vector.
+ * @param[in]  blockSize  number of samples in the vector.
+ * @return none.
+ *
+ * \par
+ * The output can be the input buffer, for an in-place computation.
+ */
+
+void arm_vcos_f32(
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t *pIn = pSrc;                         /* Input pointer */
+  float32_t *pOut = pDst;                        /* Output pointer */
+  uint32_t blkCnt;                               /* Loop counter */
+
+#if defined (ARM_MATH_SSE4)
+  /* Run the below code for x86 hosts */
+  __m128 vx, vt, vj, vr, vz, vs, vc;
+  __m128i vq;
+
+  blkCnt = blockSize >> 2U;
+
+  while (blkCnt > 0U)
+  {
+    vx = _mm_loadu_ps(pIn);
+    pIn += 4;
+
+    /* Quadrant of the input */
+    vt = _mm_add_ps(_mm_mul_ps(vx, _mm_set1_ps(VCOS_2_PI)), _mm_set1_ps(VCOS_ROUND));
+    vj = _mm_sub_ps(vt, _mm_set1_ps(VCOS_ROUND));
+    vq = _mm_add_epi32(_mm_castps_si128(vt), _mm_set1_epi32(1));
+
+    /* Reduction to [-pi/4, pi/4] */
+    vr = _mm_sub_ps(vx, _mm_mul_ps(vj, _mm_set1_ps(VCOS_DP1)));
+    vr = _mm_sub_ps(vr, _mm_mul_ps(vj, _mm_set1_ps(VCOS_DP2)));
+    vr = _mm_sub_ps(vr, _mm_mul_ps(vj, _mm_set1_ps(VCOS_DP3)));
+    vz = _mm_mul_ps(vr, vr);
+
+    vs = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(VCOS_S2), vz), _mm_set1_ps(VCOS_S1));
+    vs = _mm_add_ps(_mm_mul_ps(vs, vz), _mm_set1_ps(VCOS_S0));
+    vs = _mm_add_ps(vr, _mm_mul_ps(_mm_mul_ps(vr, vz), vs));
+
+    vc = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(VCOS_C2), vz), _mm_set1_ps(VCOS_C1));
+    vc = _mm_add_ps(_mm_mul_ps(vc, vz), _mm_set1_ps(VCOS_C0));
+    vc = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), vz)),
+                    _mm_mul_ps(_mm_mul_ps(vz, vz), vc));
+
+    /* cos(x) = sin(x + pi/2): odd quadrants use the cosine, the last two are negated */
+    vs = _mm_blendv_ps(vs, vc, _mm_castsi128_ps(_mm_slli_epi32(vq, 31)));
+    vs = _mm_xor_ps(vs, _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(vq, 1), 31)));
+
+    _mm_storeu_ps(pOut, vs);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#elif defined (ARM_MATH_DSP)
+  /* Run the below code for Cortex-M4 and Cortex-M7 */
+  float32_t in1, in2, in3, in4;                  /* Temporary input variables */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2U;
+
+  /* Four independent evaluations, interleaved by the compiler in the FPU pipeline.
+  ** A second loop below computes the remaining 1 to 3 samples. */
+  while (blkCnt > 0U)
+  {
+    in1 = pIn[0];
+    in2 = pIn[1];
+    in3 = pIn[2];
+    in4 = pIn[3];
+    pIn += 4;
+
+    pOut[0] = arm_vcos_core_f32(in1);
+    pOut[1] = arm_vcos_core_f32(in2);
+    pOut[2] = arm_vcos_core_f32(in3);
+    pOut[3] = arm_vcos_core_f32(in4);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#else
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #if defined (ARM_MATH_SSE4) */
+
+  while (blkCnt > 0U)
+  {
+    *pOut++ = arm_vcos_core_f32(*pIn++);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of VSinCos group
+ */
@@ -0,0 +1,241 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_vexp_f32.c
+ * Description:  Block exponential for floating-point vectors
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @defgroup VExp Block Exponential
+ *
+ * Computes the natural exponential of every element of a vector. The input is split
+ * into a power of 2 and a remainder r in [-ln(2)/2, ln(2)/2]:
+ * <pre>
+ *     n = round(x / ln(2))
+ *     r = (x - n * C1) - n * C2
+ *     exp(x) = 2^n * (1 + r + r^2 * P(r))
+ * </pre>
+ * where C1 + C2 = ln(2), n * C1 is exact, and P is a minimax polynomial of degree 5.
+ * 2^n is built in the exponent field of two floats, so that results down to the
+ * smallest subnormal are rounded once. The processing is the same for every element,
+ * without branches, so that it runs on 4 lanes on the host and keeps the FPU pipeline
+ * of the Cortex-M4 busy with 4 independent evaluations.
+ *
+ * \par Accuracy
+ * The relative error is below 1.2e-7 (1 ulp) for normal results. Inputs above 88.72
+ * give +Inf, inputs below -103.28 give 0, and NaNs are propagated.
+ */
+
+/**
+ * @addtogroup VExp
+ * @{
+ */
+
+/* 1/ln(2), and ln(2) split so that n * C1 is exact */
+#define VEXP_LOG2E   1.44269504088896341f
+#define VEXP_C1      0.693359375f
+#define VEXP_C2     -2.12194440e-4f
+
+/* Range of the finite non-zero results */
+#define VEXP_MAXLOG  88.72283905206835f
+#define VEXP_MINLOG -103.27892990343185f
+
+/* Adding 1.5 * 2^23 rounds to an integer, left in the low mantissa bits */
+#define VEXP_ROUND   12582912.0f
+#define VEXP_ROUND_BITS 0x4B400000
+
+/* exp(r) = 1 + r + r^2 * P(r) */
+#define VEXP_P0      5.0000001201e-1f
+#define VEXP_P1      1.6666665459e-1f
+#define VEXP_P2      4.1665795894e-2f
+#define VEXP_P3      8.3334519073e-3f
+#define VEXP_P4      1.3981999507e-3f
+#define VEXP_P5      1.9875691500e-4f
+
+/**
+ * @brief  Exponential of one sample.
+ * @param[in]  x  input value.
+ * @return exp(x).
+ */
+CMSIS_INLINE __STATIC_INLINE float32_t arm_vexp_core_f32(
+  float32_t x)
+{
+  union
+  {
+    float32_t f;
+    uint32_t u;
+  } t, s1, s2;
+  float32_t xc, fn, r, y;
+  int32_t n, n1;
+
+  /* The clamped input keeps the exponents in range, NaNs go through */
+  xc = (x > VEXP_MAXLOG) ? VEXP_MAXLOG : x;
+  xc = (xc < VEXP_MINLOG) ? VEXP_MINLOG : xc;
+
+  /* n = round(x / ln(2)) */
+  t.f = (xc * VEXP_LOG2E) + VEXP_ROUND;
+  fn = t.f - VEXP_ROUND;
+  n = (int32_t) (t.u - VEXP_ROUND_BITS);
+
+  /* Remainder in [-ln(2)/2, ln(2)/2] */
+  r = (xc - (fn * VEXP_C1)) - (fn * VEXP_C2);
+
+  y = (((VEXP_P5 * r) + VEXP_P4) * r) + VEXP_P3;
+  y = (((((y * r) + VEXP_P2) * r) + VEXP_P1) * r) + VEXP_P0;
+  y = ((y * (r * r)) + r) + 1.0f;
+
+  /* 2^n = 2^n1 * 2^(n - n1), both normal for n in [-149, 128] */
+  n1 = n >> 1;
+  s1.u = ((uint32_t) (n1 + 127)) << 23;
+  s2.u = ((uint32_t) ((n - n1) + 127)) << 23;
+  y = (y * s1.f) * s2.f;
+
+  y = (x > VEXP_MAXLOG) ? INFINITY : y;
+  y = (x < VEXP_MINLOG) ? 0.0f : y;
+
+  return (y);
+}
+
+/**
+ * @brief  Block exponential for floating-point data.
+ * @param[in]  *pSrc      points to the input vector.
+ * @param[out] *pDst      points to the output vector.
+ * @param[in]  blockSize  number of samples in the vector.
+ * @return none.
+ *
+ * \par
+ * The output can be the input buffer, for an in-place computation.
+ */
+
+void arm_vexp_f32(
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t *pIn = pSrc;                         /* Input pointer */
+  float32_t *pOut = pDst;                        /* Output pointer */
+  uint32_t blkCnt;                               /* Loop counter */
+
+#if defined (ARM_MATH_SSE4)
+  /* Run the below code for x86 hosts */
+  __m128 vx, vxc, vt, vfn, vr, vy;
+  __m128i vn, vn1;
+
+  blkCnt = blockSize >> 2U;
+
+  while (blkCnt > 0U)
+  {
+    vx = _mm_loadu_ps(pIn);
+    pIn += 4;
+
+    /* The clamped input keeps the exponents in range, NaNs go through */
+    vxc = _mm_min_ps(vx, _mm_set1_ps(VEXP_MAXLOG));
+    vxc = _mm_max_ps(vxc, _mm_set1_ps(VEXP_MINLOG));
+    vxc = _mm_blendv_ps(vxc, vx, _mm_cmpunord_ps(vx, vx));
+
+    /* n = round(x / ln(2)) */
+    vt = _mm_add_ps(_mm_mul_ps(vxc, _mm_set1_ps(VEXP_LOG2E)), _mm_set1_ps(VEXP_ROUND));
+    vfn = _mm_sub_ps(vt, _mm_set1_ps(VEXP_ROUND));
+    vn = _mm_sub_epi32(_mm_castps_si128(vt), _mm_set1_epi32(VEXP_ROUND_BITS));
+
+    /* Remainder in [-ln(2)/2, ln(2)/2] */
+    vr = _mm_sub_ps(vxc, _mm_mul_ps(vfn, _mm_set1_ps(VEXP_C1)));
+    vr = _mm_sub_ps(vr, _mm_mul_ps(vfn, _mm_set1_ps(VEXP_C2)));
+
+    vy = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(VEXP_P5), vr), _mm_set1_ps(VEXP_P4));
+    vy = _mm_add_ps(_mm_mul_ps(vy, vr), _mm_set1_ps(VEXP_P3));
+    vy = _mm_add_ps(_mm_mul_ps(vy, vr), _mm_set1_ps(VEXP_P2));
+    vy = _mm_add_ps(_mm_mul_ps(vy, vr), _mm_set1_ps(VEXP_P1));
+    vy = _mm_add_ps(_mm_mul_ps(vy, vr), _mm_set1_ps(VEXP_P0));
+    vy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vy, _mm_mul_ps(vr, vr)), vr), _mm_set1_ps(1.0f));
+
+    /* 2^n = 2^n1 * 2^(n - n1), both normal for n in [-149, 128] */
+    vn1 = _mm_srai_epi32(vn, 1);
+    vn = _mm_sub_epi32(vn, vn1);
+    vy = _mm_mul_ps(vy, _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(vn1, _mm_set1_epi32(127)), 23)));
+    vy = _mm_mul_ps(vy, _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(vn, _mm_set1_epi32(127)), 23)));
+
+    vy = _mm_blendv_ps(vy, _mm_set1_ps(INFINITY), _mm_cmpgt_ps(vx, _mm_set1_ps(VEXP_MAXLOG)));
+    vy = _mm_andnot_ps(_mm_cmplt_ps(vx, _mm_set1_ps(VEXP_MINLOG)), vy);
+
+    _mm_storeu_ps(pOut, vy);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#elif defined (ARM_MATH_DSP)
+  /* Run the below code for Cortex-M4 and Cortex-M7 */
+  float32_t in1, in2, in3, in4;                  /* Temporary input variables */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2U;
+
+  /* Four independent evaluations, interleaved by the compiler in the FPU pipeline.
+  ** A second loop below computes the remaining 1 to 3 samples. */
+  while (blkCnt > 0U)
+  {
+    in1 = pIn[0];
+    in2 = pIn[1];
+    in3 = pIn[2];
+    in4 = pIn[3];
+    pIn += 4;
+
+    pOut[0] = arm_vexp_core_f32(in1);
+    pOut[1] = arm_vexp_core_f32(in2);
+    pOut[2] = arm_vexp_core_f32(in3);
+    pOut[3] = arm_vexp_core_f32(in4);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#else
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #if defined (ARM_MATH_SSE4) */
+
+  while (blkCnt > 0U)
+  {
+    *pOut++ = arm_vexp_core_f32(*pIn++);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of VExp group
+ */
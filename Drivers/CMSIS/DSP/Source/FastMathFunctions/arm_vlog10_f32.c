@@ -0,0 +1,66 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_vlog10_f32.c
+ * Description:  Block base 10 logarithm for floating-point vectors
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @addtogroup VLog
+ * @{
+ */
+
+/* log10(e) */
+#define VLOG10_E  0.4342944819f
+
+/**
+ * @brief  Block base 10 logarithm for floating-point data.
+ * @param[in]  *pSrc      points to the input vector.
+ * @param[out] *pDst      points to the output vector.
+ * @param[in]  blockSize  number of samples in the vector.
+ * @return none.
+ *
+ * \par
+ * The natural logarithm is scaled by log10(e), which adds up to 1 ulp to its error.
+ * The output can be the input buffer, for an in-place computation.
+ */
+
+void arm_vlog10_f32(
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  arm_vlog_f32(pSrc, pDst, blockSize);
+  arm_scale_f32(pDst, VLOG10_E, pDst, blockSize);
+}
+
+/**
+ * @} end of VLog group
+ */
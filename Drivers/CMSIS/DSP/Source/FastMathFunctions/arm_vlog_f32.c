@@ -0,0 +1,254 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_vlog_f32.c
+ * Description:  Block natural logarithm for floating-point vectors
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @defgroup VLog Block Logarithm
+ *
+ * Computes the natural or base 10 logarithm of every element of a vector. The
+ * floating-point input is split into its exponent e and a mantissa m in [sqrt(2)/2, sqrt(2)):
+ * <pre>
+ *     f = m - 1
+ *     log(x) = f - f^2 / 2 + f^3 * P(f) + e * ln(2)
+ * </pre>
+ * where P is a minimax polynomial of degree 8, and e * ln(2) is added in two parts so
+ * that the result keeps full precision for large exponents. The processing is the same
+ * for every element, without branches, so that it runs on 4 lanes on the host and keeps
+ * the FPU pipeline of the Cortex-M4 busy with 4 independent evaluations.
+ * Subnormal inputs are scaled by 2^23 first.
+ *
+ * The Q31 input is normalized the same way with a count of leading zeros, and the
+ * polynomial of degree 10 is evaluated in fixed point. The output of arm_vlog_q31() is
+ * in 5.26 format, which holds the logarithm of every positive Q31 value.
+ *
+ * \par Accuracy
+ * The floating-point results are within 1.2e-7 of the exact ones where |log(x)| <= 1,
+ * and their relative error is below 1.2e-7 elsewhere; log(0) is -Inf, the logarithm of
+ * a negative value is NaN, and +Inf and NaN are returned unchanged. The Q31 results
+ * are within 1 LSB of the exact ones, and the logarithm of 0 or of a negative value
+ * is 0x80000000.
+ */
+
+/**
+ * @addtogroup VLog
+ * @{
+ */
+
+/* ln(2) split so that e * C1 is exact */
+#define VLOG_C1        0.693359375f
+#define VLOG_C2       -2.12194440e-4f
+
+#define VLOG_SQRT2     1.41421356f
+#define VLOG_MIN_NORM  1.17549435e-38f
+#define VLOG_SUBNORM   8388608.0f
+
+/* log(1 + f) = f - f^2 / 2 + f^3 * P(f) */
+#define VLOG_P0        3.3333331174e-1f
+#define VLOG_P1       -2.4999993993e-1f
+#define VLOG_P2        2.0000714765e-1f
+#define VLOG_P3       -1.6668057665e-1f
+#define VLOG_P4        1.4249322787e-1f
+#define VLOG_P5       -1.2420140846e-1f
+#define VLOG_P6        1.1676998740e-1f
+#define VLOG_P7       -1.1514610310e-1f
+#define VLOG_P8        7.0376836292e-2f
+
+/**
+ * @brief  Natural logarithm of one sample.
+ * @param[in]  x  input value.
+ * @return log(x).
+ */
+CMSIS_INLINE __STATIC_INLINE float32_t arm_vlog_core_f32(
+  float32_t x)
+{
+  union
+  {
+    float32_t f;
+    uint32_t u;
+  } t;
+  float32_t m, f, z, fe, y;
+  int32_t e;
+
+  /* Subnormals are scaled to normal numbers */
+  t.f = (x < VLOG_MIN_NORM) ? (x * VLOG_SUBNORM) : x;
+  e = (x < VLOG_MIN_NORM) ? -23 : 0;
+
+  /* Exponent, and mantissa in [1, 2) */
+  e += (int32_t) ((t.u >> 23) & 0xFFU) - 127;
+  t.u = (t.u & 0x007FFFFFU) | 0x3F800000U;
+
+  /* Mantissa in [sqrt(2)/2, sqrt(2)) */
+  m = (t.f > VLOG_SQRT2) ? (t.f * 0.5f) : t.f;
+  e += (t.f > VLOG_SQRT2) ? 1 : 0;
+
+  f = m - 1.0f;
+  z = f * f;
+  fe = (float32_t) e;
+
+  y = (((((VLOG_P8 * f) + VLOG_P7) * f) + VLOG_P6) * f) + VLOG_P5;
+  y = (((((((y * f) + VLOG_P4) * f) + VLOG_P3) * f) + VLOG_P2) * f) + VLOG_P1;
+  y = (y * f) + VLOG_P0;
+  y = (((f * z) * y) + (fe * VLOG_C2)) - (0.5f * z);
+  y = (f + y) + (fe * VLOG_C1);
+
+  y = (x == INFINITY) ? x : y;
+  y = (x == 0.0f) ? -INFINITY : y;
+  y = (x < 0.0f) ? NAN : y;
+  y = (x != x) ? x : y;
+
+  return (y);
+}
+
+/**
+ * @brief  Block natural logarithm for floating-point data.
+ * @param[in]  *pSrc      points to the input vector.
+ * @param[out] *pDst      points to the output vector.
+ * @param[in]  blockSize  number of samples in the vector.
+ * @return none.
+ *
+ * \par
+ * The output can be the input buffer, for an in-place computation.
+ */
+
+void arm_vlog_f32(
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t *pIn = pSrc;                         /* Input pointer */
+  float32_t *pOut = pDst;                        /* Output pointer */
+  uint32_t blkCnt;                               /* Loop counter */
+
+#if defined (ARM_MATH_SSE4)
+  /* Run the below code for x86 hosts */
+  __m128 vx, vsub, vm, vbig, vf, vz, vfe, vy;
+  __m128i vt, ve;
+
+  blkCnt = blockSize >> 2U;
+
+  while (blkCnt > 0U)
+  {
+    vx = _mm_loadu_ps(pIn);
+    pIn += 4;
+
+    /* Subnormals are scaled to normal numbers */
+    vsub = _mm_cmplt_ps(vx, _mm_set1_ps(VLOG_MIN_NORM));
+    vt = _mm_castps_si128(_mm_blendv_ps(vx, _mm_mul_ps(vx, _mm_set1_ps(VLOG_SUBNORM)), vsub));
+    ve = _mm_and_si128(_mm_castps_si128(vsub), _mm_set1_epi32(-23));
+
+    /* Exponent, and mantissa in [1, 2) */
+    ve = _mm_add_epi32(ve, _mm_and_si128(_mm_srli_epi32(vt, 23), _mm_set1_epi32(0xFF)));
+    ve = _mm_sub_epi32(ve, _mm_set1_epi32(127));
+    vt = _mm_or_si128(_mm_and_si128(vt, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000));
+    vm = _mm_castsi128_ps(vt);
+
+    /* Mantissa in [sqrt(2)/2, sqrt(2)) */
+    vbig = _mm_cmpgt_ps(vm, _mm_set1_ps(VLOG_SQRT2));
+    vm = _mm_blendv_ps(vm, _mm_mul_ps(vm, _mm_set1_ps(0.5f)), vbig);
+    ve = _mm_sub_epi32(ve, _mm_castps_si128(vbig));
+
+    vf = _mm_sub_ps(vm, _mm_set1_ps(1.0f));
+    vz = _mm_mul_ps(vf, vf);
+    vfe = _mm_cvtepi32_ps(ve);
+
+    vy = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(VLOG_P8), vf), _mm_set1_ps(VLOG_P7));
+    vy = _mm_add_ps(_mm_mul_ps(vy, vf), _mm_set1_ps(VLOG_P6));
+    vy = _mm_add_ps(_mm_mul_ps(vy, vf), _mm_set1_ps(VLOG_P5));
+    vy = _mm_add_ps(_mm_mul_ps(vy, vf), _mm_set1_ps(VLOG_P4));
+    vy = _mm_add_ps(_mm_mul_ps(vy, vf), _mm_set1_ps(VLOG_P3));
+    vy = _mm_add_ps(_mm_mul_ps(vy, vf), _mm_set1_ps(VLOG_P2));
+    vy = _mm_add_ps(_mm_mul_ps(vy, vf), _mm_set1_ps(VLOG_P1));
+    vy = _mm_add_ps(_mm_mul_ps(vy, vf), _mm_set1_ps(VLOG_P0));
+    vy = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(vf, vz), vy), _mm_mul_ps(vfe, _mm_set1_ps(VLOG_C2)));
+    vy = _mm_sub_ps(vy, _mm_mul_ps(_mm_set1_ps(0.5f), vz));
+    vy = _mm_add_ps(_mm_add_ps(vf, vy), _mm_mul_ps(vfe, _mm_set1_ps(VLOG_C1)));
+
+    vy = _mm_blendv_ps(vy, vx, _mm_cmpeq_ps(vx, _mm_set1_ps(INFINITY)));
+    vy = _mm_blendv_ps(vy, _mm_set1_ps(-INFINITY), _mm_cmpeq_ps(vx, _mm_setzero_ps()));
+    vy = _mm_blendv_ps(vy, _mm_set1_ps(NAN), _mm_cmplt_ps(vx, _mm_setzero_ps()));
+    vy = _mm_blendv_ps(vy, vx, _mm_cmpunord_ps(vx, vx));
+
+    _mm_storeu_ps(pOut, vy);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#elif defined (ARM_MATH_DSP)
+  /* Run the below code for Cortex-M4 and Cortex-M7 */
+  float32_t in1, in2, in3, in4;                  /* Temporary input variables */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2U;
+
+  /* Four independent evaluations, interleaved by the compiler in the FPU pipeline.
+  ** A second loop below computes the remaining 1 to 3 samples. */
+  while (blkCnt > 0U)
+  {
+    in1 = pIn[0];
+    in2 = pIn[1];
+    in3 = pIn[2];
+    in4 = pIn[3];
+    pIn += 4;
+
+    pOut[0] = arm_vlog_core_f32(in1);
+    pOut[1] = arm_vlog_core_f32(in2);
+    pOut[2] = arm_vlog_core_f32(in3);
+    pOut[3] = arm_vlog_core_f32(in4);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#else
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #if defined (ARM_MATH_SSE4) */
+
+  while (blkCnt > 0U)
+  {
+    *pOut++ = arm_vlog_core_f32(*pIn++);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of VLog group
+ */
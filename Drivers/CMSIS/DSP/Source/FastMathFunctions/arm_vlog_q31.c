@@ -0,0 +1,161 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_vlog_q31.c
+ * Description:  Block natural logarithm for Q31 vectors
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @addtogroup VLog
+ * @{
+ */
+
+/* Mantissa threshold sqrt(2)/2, and ln(2), in 1.31 format */
+#define VLOG_Q31_SQRTHF  0x5A82799A
+#define VLOG_Q31_LN2     1488522236
+
+/* log(1 + f) = f - f^2 / 2 + f^3 * R(f) */
+#define VLOG_Q31_R0    ((q31_t) 0x2AAAAA3E)
+#define VLOG_Q31_R1    ((q31_t) 0xDFFFA71F)
+#define VLOG_Q31_R2    ((q31_t) 0x199A2129)
+#define VLOG_Q31_R3    ((q31_t) 0xEABB1909)
+#define VLOG_Q31_R4    ((q31_t) 0x1229C805)
+#define VLOG_Q31_R5    ((q31_t) 0xEF180A15)
+#define VLOG_Q31_R6    ((q31_t) 0x10744D03)
+#define VLOG_Q31_R7    ((q31_t) 0xF63B67DD)
+
+/**
+ * @brief  Natural logarithm of one Q31 sample.
+ * @param[in]  x  input value.
+ * @return log(x) in 5.26 format.
+ */
+CMSIS_INLINE __STATIC_INLINE q31_t arm_vlog_core_q31(
+  q31_t x)
+{
+  uint32_t shift;
+  int32_t e;
+  q31_t m, f, z, p, y;
+
+  if (x <= 0)
+  {
+    return ((q31_t) 0x80000000);
+  }
+
+  /* x = (1 + f) * 2^e, f in [sqrt(2)/2 - 1, sqrt(2) - 1) */
+  shift = __CLZ((uint32_t) x) - 1U;
+  m = x << shift;
+  f = (m < VLOG_Q31_SQRTHF) ? (q31_t) (((uint32_t) m << 1) - 0x80000000U)
+                             : (q31_t) ((uint32_t) m - 0x80000000U);
+  e = (m < VLOG_Q31_SQRTHF) ? -((int32_t) shift + 1) : -(int32_t) shift;
+  z = (q31_t) (((q63_t) f * f) >> 31);
+
+  p = (q31_t) (((q63_t) VLOG_Q31_R7 * f) >> 31) + VLOG_Q31_R6;
+  p = (q31_t) (((q63_t) p * f) >> 31) + VLOG_Q31_R5;
+  p = (q31_t) (((q63_t) p * f) >> 31) + VLOG_Q31_R4;
+  p = (q31_t) (((q63_t) p * f) >> 31) + VLOG_Q31_R3;
+  p = (q31_t) (((q63_t) p * f) >> 31) + VLOG_Q31_R2;
+  p = (q31_t) (((q63_t) p * f) >> 31) + VLOG_Q31_R1;
+  p = (q31_t) (((q63_t) p * f) >> 31) + VLOG_Q31_R0;
+  y = (f - (z >> 1)) + (q31_t) ((((q63_t) z * f) >> 31) * p >> 31);
+
+  /* Add e * ln(2), and round to 5.26 format */
+  y = (q31_t) ((((q63_t) e * VLOG_Q31_LN2) + y + 16) >> 5);
+
+  return (y);
+}
+
+/**
+ * @brief  Block natural logarithm for Q31 data.
+ * @param[in]  *pSrc      points to the input vector.
+ * @param[out] *pDst      points to the output vector, in 5.26 format.
+ * @param[in]  blockSize  number of samples in the vector.
+ * @return none.
+ *
+ * \par
+ * The logarithm of the smallest positive input, 2^-31, is -21.49, and the logarithms
+ * of 0 and of negative inputs are saturated to 0x80000000 (-32.0).
+ * The output can be the input buffer, for an in-place computation.
+ */
+
+void arm_vlog_q31(
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize)
+{
+  q31_t *pIn = pSrc;                             /* Input pointer */
+  q31_t *pOut = pDst;                            /* Output pointer */
+  uint32_t blkCnt;                               /* Loop counter */
+
+#if defined (ARM_MATH_DSP)
+  /* Run the below code for Cortex-M4 and Cortex-M7 */
+  q31_t in1, in2, in3, in4;                      /* Temporary input variables */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2U;
+
+  /* Four independent evaluations, interleaved by the compiler in the pipeline.
+  ** A second loop below computes the remaining 1 to 3 samples. */
+  while (blkCnt > 0U)
+  {
+    in1 = pIn[0];
+    in2 = pIn[1];
+    in3 = pIn[2];
+    in4 = pIn[3];
+    pIn += 4;
+
+    pOut[0] = arm_vlog_core_q31(in1);
+    pOut[1] = arm_vlog_core_q31(in2);
+    pOut[2] = arm_vlog_core_q31(in3);
+    pOut[3] = arm_vlog_core_q31(in4);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#else
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #if defined (ARM_MATH_DSP) */
+
+  while (blkCnt > 0U)
+  {
+    *pOut++ = arm_vlog_core_q31(*pIn++);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of VLog group
+ */
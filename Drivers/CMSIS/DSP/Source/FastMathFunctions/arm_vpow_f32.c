@@ -0,0 +1,114 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_vpow_f32.c
+ * Description:  Block power for floating-point vectors
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @defgroup VPow Block Power
+ *
+ * Raises every element of a vector to the power given by the element of a second vector:
+ * <pre>
+ *     pDst[n] = pSrcA[n] ^ pSrcB[n] = exp(pSrcB[n] * log(pSrcA[n]))
+ * </pre>
+ * The samples are processed in chunks of VPOW_BLOCK_SIZE, with arm_vlog_f32() and
+ * arm_vexp_f32() on a buffer on the stack, so that the three passes stay in the cache
+ * or in the tightly coupled memory.
+ *
+ * \par Accuracy
+ * The error of log(x) is multiplied by the exponent, so that the relative error is about
+ * (2 + |pSrcB[n] * log(pSrcA[n])|) * 1.2e-7. For instance, it is below 2e-6 for
+ * results between 1e-6 and 1e6. Any base to the power 0 is 1, a negative base
+ * gives NaN, and a zero base gives 0 or +Inf depending on the sign of the exponent.
+ */
+
+/**
+ * @addtogroup VPow
+ * @{
+ */
+
+#define VPOW_BLOCK_SIZE  32U
+
+/**
+ * @brief  Block power for floating-point data.
+ * @param[in]  *pSrcA     points to the vector of bases.
+ * @param[in]  *pSrcB     points to the vector of exponents.
+ * @param[out] *pDst      points to the output vector.
+ * @param[in]  blockSize  number of samples in each vector.
+ * @return none.
+ *
+ * \par
+ * The output can be one of the input buffers, for an in-place computation.
+ */
+
+void arm_vpow_f32(
+  float32_t * pSrcA,
+  float32_t * pSrcB,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t buffer[VPOW_BLOCK_SIZE];             /* log, then product of a chunk */
+  float32_t *pA = pSrcA;                         /* Base pointer */
+  float32_t *pB = pSrcB;                         /* Exponent pointer */
+  float32_t *pOut = pDst;                        /* Output pointer */
+  float32_t b;                                   /* Exponent */
+  uint32_t blkCnt;                               /* Samples left */
+  uint32_t chunk;                                /* Samples of the chunk */
+  uint32_t i;                                    /* Loop counter */
+
+  blkCnt = blockSize;
+
+  while (blkCnt > 0U)
+  {
+    chunk = (blkCnt < VPOW_BLOCK_SIZE) ? blkCnt : VPOW_BLOCK_SIZE;
+
+    arm_vlog_f32(pA, buffer, chunk);
+
+    /* A zero exponent gives exp(0) = 1, even for the bases with an infinite or NaN logarithm */
+    for (i = 0U; i < chunk; i++)
+    {
+      b = pB[i];
+      buffer[i] = (b == 0.0f) ? 0.0f : (buffer[i] * b);
+    }
+
+    /* The inputs of the chunk are not read again, so that pDst can be pSrcA or pSrcB */
+    arm_vexp_f32(buffer, pOut, chunk);
+
+    pA += chunk;
+    pB += chunk;
+    pOut += chunk;
+    blkCnt -= chunk;
+  }
+}
+
+/**
+ * @} end of VPow group
+ */
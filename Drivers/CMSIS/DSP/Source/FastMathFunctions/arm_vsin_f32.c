@@ -0,0 +1,233 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_vsin_f32.c
+ * Description:  Block sine for floating-point vectors
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @defgroup VSinCos Block Sine and Cosine
+ *
+ * Computes the sine or the cosine of every element of a vector. Unlike arm_sin_f32()
+ * and arm_cos_f32(), the functions take a block of inputs, do not use tables, and
+ * accept any angle: the processing is the same for every element, without branches,
+ * so that it runs on 4 lanes on the host and keeps the FPU pipeline of the Cortex-M4
+ * busy with 4 independent evaluations.
+ *
+ * The floating-point input, in radians, is reduced to r in [-pi/4, pi/4] and to its
+ * quadrant j:
+ * <pre>
+ *     j = round(x * 2 / pi)
+ *     r = ((x - j * DP1) - j * DP2) - j * DP3
+ * </pre>
+ * where DP1 + DP2 + DP3 = pi/2 and the products with DP1 and DP2 are exact (Cody-Waite).
+ * sin(r) and cos(r) are minimax polynomials of degree 7 and 8, and the quadrant selects
+ * one of them and its sign.
+ *
+ * The Q31 input is scaled as the one of arm_sin_q31(): [0 +0.9999] maps to [0 2*pi),
+ * and the full Q31 range wraps around. The angle is split into its octant, given by the
+ * top 3 bits, and its position in the octant, from which the polynomials of degree 9
+ * and 10 are evaluated in fixed point.
+ *
+ * \par Accuracy
+ * The floating-point results are within 1.2e-7 (2^-23) of the exact ones for |x| <= 8192.
+ * The reduction loses accuracy gradually above that, and is not valid above |x| = 1e5.
+ * The Q31 results are within 4 LSB of the exact ones.
+ */
+
+/**
+ * @addtogroup VSinCos
+ * @{
+ */
+
+/* 2/pi, and pi/2 split so that j * DP1 and j * DP2 are exact for |j| < 2^16 */
+#define VSIN_2_PI    0.636619772367581f
+#define VSIN_DP1     1.5703125f
+#define VSIN_DP2     4.837512969970703125e-4f
+#define VSIN_DP3     7.54978995489188216e-8f
+
+/* Adding 1.5 * 2^23 rounds to an integer, left in the low mantissa bits */
+#define VSIN_ROUND   12582912.0f
+
+/* sin(r) = r + r * z * S(z), cos(r) = 1 - z / 2 + z * z * C(z), z = r * r */
+#define VSIN_S0     -1.6666654611e-1f
+#define VSIN_S1      8.3321608736e-3f
+#define VSIN_S2     -1.9515295891e-4f
+#define VSIN_C0      4.166664568298827e-2f
+#define VSIN_C1     -1.388731625493765e-3f
+#define VSIN_C2      2.443315711809948e-5f
+
+/**
+ * @brief  Sine of one sample, the quadrant shifted by quadOffset.
+ * @param[in]  x           input value in radians.
+ * @param[in]  quadOffset  0 for the sine, 1 for the cosine.
+ * @return sin(x + quadOffset * pi/2).
+ */
+CMSIS_INLINE __STATIC_INLINE float32_t arm_vsin_core_f32(
+  float32_t x,
+  uint32_t quadOffset)
+{
+  union
+  {
+    float32_t f;
+    uint32_t u;
+  } t;
+  float32_t j, r, z, s, c;
+  uint32_t quad;
+
+  /* Quadrant of the input */
+  t.f = (x * VSIN_2_PI) + VSIN_ROUND;
+  j = t.f - VSIN_ROUND;
+  quad = t.u + quadOffset;
+
+  /* Reduction to [-pi/4, pi/4] */
+  r = ((x - (j * VSIN_DP1)) - (j * VSIN_DP2)) - (j * VSIN_DP3);
+  z = r * r;
+
+  s = r + ((r * z) * ((((VSIN_S2 * z) + VSIN_S1) * z) + VSIN_S0));
+  c = (1.0f - (0.5f * z)) + ((z * z) * ((((VSIN_C2 * z) + VSIN_C1) * z) + VSIN_C0));
+
+  /* Odd quadrants use the cosine, the last two are negated */
+  t.f = ((quad & 1U) != 0U) ? c : s;
+  t.u ^= (quad & 2U) << 30;
+
+  return (t.f);
+}
+
+/**
+ * @brief  Block sine for floating-point data.
+ * @param[in]  *pSrc      points to the input vector, in radians.
+ * @param[out] *pDst      points to the output vector.
+ * @param[in]  blockSize  number of samples in the vector.
+ * @return none.
+ *
+ * \par
+ * The output can be the input buffer, for an in-place computation.
+ */
+
+void arm_vsin_f32(
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t *pIn = pSrc;                         /* Input pointer */
+  float32_t *pOut = pDst;                        /* Output pointer */
+  uint32_t blkCnt;                               /* Loop counter */
+
+#if defined (ARM_MATH_SSE4)
+  /* Run the below code for x86 hosts */
+  __m128 vx, vt, vj, vr, vz, vs, vc;
+  __m128i vq;
+
+  blkCnt = blockSize >> 2U;
+
+  while (blkCnt > 0U)
+  {
+    vx = _mm_loadu_ps(pIn);
+    pIn += 4;
+
+    /* Quadrant of the input */
+    vt = _mm_add_ps(_mm_mul_ps(vx, _mm_set1_ps(VSIN_2_PI)), _mm_set1_ps(VSIN_ROUND));
+    vj = _mm_sub_ps(vt, _mm_set1_ps(VSIN_ROUND));
+    vq = _mm_castps_si128(vt);
+
+    /* Reduction to [-pi/4, pi/4] */
+    vr = _mm_sub_ps(vx, _mm_mul_ps(vj, _mm_set1_ps(VSIN_DP1)));
+    vr = _mm_sub_ps(vr, _mm_mul_ps(vj, _mm_set1_ps(VSIN_DP2)));
+    vr = _mm_sub_ps(vr, _mm_mul_ps(vj, _mm_set1_ps(VSIN_DP3)));
+    vz = _mm_mul_ps(vr, vr);
+
+    vs = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(VSIN_S2), vz), _mm_set1_ps(VSIN_S1));
+    vs = _mm_add_ps(_mm_mul_ps(vs, vz), _mm_set1_ps(VSIN_S0));
+    vs = _mm_add_ps(vr, _mm_mul_ps(_mm_mul_ps(vr, vz), vs));
+
+    vc = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(VSIN_C2), vz), _mm_set1_ps(VSIN_C1));
+    vc = _mm_add_ps(_mm_mul_ps(vc, vz), _mm_set1_ps(VSIN_C0));
+    vc = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), vz)),
+                    _mm_mul_ps(_mm_mul_ps(vz, vz), vc));
+
+    /* Odd quadrants use the cosine, the last two are negated */
+    vs = _mm_blendv_ps(vs, vc, _mm_castsi128_ps(_mm_slli_epi32(vq, 31)));
+    vs = _mm_xor_ps(vs, _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(vq, 1), 31)));
+
+    _mm_storeu_ps(pOut, vs);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#elif defined (ARM_MATH_DSP)
+  /* Run the below code for Cortex-M4 and Cortex-M7 */
+  float32_t in1, in2, in3, in4;                  /* Temporary input variables */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2U;
+
+  /* Four independent evaluations, interleaved by the compiler in the FPU pipeline.
+  ** A second loop below computes the remaining 1 to 3 samples. */
+  while (blkCnt > 0U)
+  {
+    in1 = pIn[0];
+    in2 = pIn[1];
+    in3 = pIn[2];
+    in4 = pIn[3];
+    pIn += 4;
+
+    pOut[0] = arm_vsin_core_f32(in1, 0U);
+    pOut[1] = arm_vsin_core_f32(in2, 0U);
+    pOut[2] = arm_vsin_core_f32(in3, 0U);
+    pOut[3] = arm_vsin_core_f32(in4, 0U);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#else
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #if defined (ARM_MATH_SSE4) */
+
+  while (blkCnt > 0U)
+  {
+    *pOut++ = arm_vsin_core_f32(*pIn++, 0U);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of VSinCos group
+ */
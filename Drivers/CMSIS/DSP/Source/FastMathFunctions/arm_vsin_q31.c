@@ -0,0 +1,164 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_vsin_q31.c
+ * Description:  Block sine for Q31 vectors
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @addtogroup VSinCos
+ * @{
+ */
+
+/* pi/2 in 2.30 format, scaled by 2 */
+#define VSIN_Q31_PI_2  3373259426U
+
+/* sin(u) = u + u * z * S(z), cos(u) = 1 - z / 2 + z * z * C(z), z = u * u */
+#define VSIN_Q31_S0    ((q31_t) 0xEAAAAAAB)
+#define VSIN_Q31_S1    ((q31_t) 0x01111108)
+#define VSIN_Q31_S2    ((q31_t) 0xFFF97FC3)
+#define VSIN_Q31_S3    ((q31_t) 0x000016CB)
+#define VSIN_Q31_C0    ((q31_t) 0x05555555)
+#define VSIN_Q31_C1    ((q31_t) 0xFFD27D29)
+#define VSIN_Q31_C2    ((q31_t) 0x0000D009)
+#define VSIN_Q31_C3    ((q31_t) 0xFFFFFDB8)
+
+/**
+ * @brief  Sine of one Q31 sample, the quadrant shifted by quadOffset.
+ * @param[in]  x           scaled input value, 1.0 is 2*pi.
+ * @param[in]  quadOffset  0 for the sine, 1 for the cosine.
+ * @return sin(x + quadOffset * pi/2).
+ */
+CMSIS_INLINE __STATIC_INLINE q31_t arm_vsin_core_q31(
+  q31_t x,
+  uint32_t quadOffset)
+{
+  uint32_t phase, quad, rem, swap;
+  q31_t u, z, p, s, c, y;
+  q63_t cl;
+
+  /* Quadrant, and position in the quadrant on 32 bits */
+  phase = ((uint32_t) x) << 1;
+  quad = (phase >> 30) + quadOffset;
+  rem = phase << 2;
+
+  /* In the second octant of the quadrant, sine and cosine of the complement are swapped */
+  swap = rem >> 31;
+  rem = (swap != 0U) ? (0U - rem) : rem;
+
+  /* Angle in [0, pi/4], in 1.31 format */
+  u = (q31_t) (((uint64_t) rem * VSIN_Q31_PI_2) >> 32);
+  z = (q31_t) (((q63_t) u * u) >> 31);
+
+  p = (q31_t) (((q63_t) VSIN_Q31_S3 * z) >> 31) + VSIN_Q31_S2;
+  p = (q31_t) (((q63_t) p * z) >> 31) + VSIN_Q31_S1;
+  p = (q31_t) (((q63_t) p * z) >> 31) + VSIN_Q31_S0;
+  s = u + (q31_t) ((((q63_t) u * z) >> 31) * p >> 31);
+
+  p = (q31_t) (((q63_t) VSIN_Q31_C3 * z) >> 31) + VSIN_Q31_C2;
+  p = (q31_t) (((q63_t) p * z) >> 31) + VSIN_Q31_C1;
+  p = (q31_t) (((q63_t) p * z) >> 31) + VSIN_Q31_C0;
+  cl = (0x80000000LL - (z >> 1)) + ((((q63_t) z * z) >> 31) * p >> 31);
+  c = (cl > 0x7FFFFFFF) ? 0x7FFFFFFF : (q31_t) cl;
+
+  /* Odd quadrants use the cosine, the last two are negated */
+  y = (((quad ^ swap) & 1U) != 0U) ? c : s;
+  y = ((quad & 2U) != 0U) ? -y : y;
+
+  return (y);
+}
+
+/**
+ * @brief  Block sine for Q31 data.
+ * @param[in]  *pSrc      points to the input vector, [0 +0.9999] maps to [0 2*pi).
+ * @param[out] *pDst      points to the output vector.
+ * @param[in]  blockSize  number of samples in the vector.
+ * @return none.
+ *
+ * \par
+ * Inputs outside [0 +0.9999] wrap around, so that -0.25 is the same angle as 0.75.
+ * The output can be the input buffer, for an in-place computation.
+ */
+
+void arm_vsin_q31(
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize)
+{
+  q31_t *pIn = pSrc;                             /* Input pointer */
+  q31_t *pOut = pDst;                            /* Output pointer */
+  uint32_t blkCnt;                               /* Loop counter */
+
+#if defined (ARM_MATH_DSP)
+  /* Run the below code for Cortex-M4 and Cortex-M7 */
+  q31_t in1, in2, in3, in4;                      /* Temporary input variables */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2U;
+
+  /* Four independent evaluations, interleaved by the compiler in the pipeline.
+  ** A second loop below computes the remaining 1 to 3 samples. */
+  while (blkCnt > 0U)
+  {
+    in1 = pIn[0];
+    in2 = pIn[1];
+    in3 = pIn[2];
+    in4 = pIn[3];
+    pIn += 4;
+
+    pOut[0] = arm_vsin_core_q31(in1, 0U);
+    pOut[1] = arm_vsin_core_q31(in2, 0U);
+    pOut[2] = arm_vsin_core_q31(in3, 0U);
+    pOut[3] = arm_vsin_core_q31(in4, 0U);
+    pOut += 4;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#else
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #if defined (ARM_MATH_DSP) */
+
+  while (blkCnt > 0U)
+  {
+    *pOut++ = arm_vsin_core_q31(*pIn++, 0U);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of VSinCos group
+ */
@@ -456,6 +456,141 @@ uint32_t blockSize)
 
    } while (stage > 0U);
 
+#elif defined(ARM_MATH_SSE4)
+
+   /* Run the below code for x86 hosts */
+
+   /* Four stages at a time, one per lane, as a wavefront: at step t the stage of lane j filters
+   ** the sample t - j, its input being the output of lane j - 1 at the previous step. Every stage
+   ** performs the same operations on the same samples as the scalar code. The lanes outside of
+   ** the block in the first and last three steps keep their state */
+   __m128 vb0, vb1, vb2, va1, va2, vd1, vd2, vx, vy, vd1n, vd2n, vmask;
+   uint32_t t, steps;
+   int32_t lane;
+
+   while (stage >= 4U)
+   {
+      vb0 = _mm_set_ps(pCoeffs[15], pCoeffs[10], pCoeffs[5], pCoeffs[0]);
+      vb1 = _mm_set_ps(pCoeffs[16], pCoeffs[11], pCoeffs[6], pCoeffs[1]);
+      vb2 = _mm_set_ps(pCoeffs[17], pCoeffs[12], pCoeffs[7], pCoeffs[2]);
+      va1 = _mm_set_ps(pCoeffs[18], pCoeffs[13], pCoeffs[8], pCoeffs[3]);
+      va2 = _mm_set_ps(pCoeffs[19], pCoeffs[14], pCoeffs[9], pCoeffs[4]);
+      vd1 = _mm_set_ps(pState[6], pState[4], pState[2], pState[0]);
+      vd2 = _mm_set_ps(pState[7], pState[5], pState[3], pState[1]);
+      vy = _mm_setzero_ps();
+
+      steps = blockSize + 3U;
+
+      for (t = 0U; t < steps; t++)
+      {
+         /* Previous outputs move up one stage, the new sample enters the first one */
+         vx = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(vy), 4));
+         vx = _mm_move_ss(vx, _mm_set_ss((t < blockSize) ? pIn[t] : 0.0f));
+
+         /* y[n] = b0 * x[n] + d1 */
+         vy = _mm_add_ps(_mm_mul_ps(vb0, vx), vd1);
+
+         /* d1 = b1 * x[n] + a1 * y[n] + d2 */
+         vd1n = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vb1, vx), _mm_mul_ps(va1, vy)), vd2);
+
+         /* d2 = b2 * x[n] + a2 * y[n] */
+         vd2n = _mm_add_ps(_mm_mul_ps(vb2, vx), _mm_mul_ps(va2, vy));
+
+         if ((t >= 3U) && (t < blockSize))
+         {
+            vd1 = vd1n;
+            vd2 = vd2n;
+         }
+         else
+         {
+            /* Filling or draining the wavefront */
+            lane = (int32_t)t;
+            vmask = _mm_castsi128_ps(_mm_set_epi32(
+                        ((lane - 3 >= 0) && (lane - 3 < (int32_t)blockSize)) ? -1 : 0,
+                        ((lane - 2 >= 0) && (lane - 2 < (int32_t)blockSize)) ? -1 : 0,
+                        ((lane - 1 >= 0) && (lane - 1 < (int32_t)blockSize)) ? -1 : 0,
+                        (lane < (int32_t)blockSize) ? -1 : 0));
+            vd1 = _mm_blendv_ps(vd1, vd1n, vmask);
+            vd2 = _mm_blendv_ps(vd2, vd2n, vmask);
+         }
+
+         /* The last stage of the group gives the output of the sample t - 3 */
+         if (t >= 3U)
+         {
+            _mm_store_ss(&pOut[t - 3U], _mm_shuffle_ps(vy, vy, _MM_SHUFFLE(3, 3, 3, 3)));
+         }
+      }
+
+      /* Store the updated state variables back into the state array */
+      pState[0] = _mm_cvtss_f32(vd1);
+      pState[1] = _mm_cvtss_f32(vd2);
+      pState[2] = _mm_cvtss_f32(_mm_shuffle_ps(vd1, vd1, _MM_SHUFFLE(1, 1, 1, 1)));
+      pState[3] = _mm_cvtss_f32(_mm_shuffle_ps(vd2, vd2, _MM_SHUFFLE(1, 1, 1, 1)));
+      pState[4] = _mm_cvtss_f32(_mm_shuffle_ps(vd1, vd1, _MM_SHUFFLE(2, 2, 2, 2)));
+      pState[5] = _mm_cvtss_f32(_mm_shuffle_ps(vd2, vd2, _MM_SHUFFLE(2, 2, 2, 2)));
+      pState[6] = _mm_cvtss_f32(_mm_shuffle_ps(vd1, vd1, _MM_SHUFFLE(3, 3, 3, 3)));
+      pState[7] = _mm_cvtss_f32(_mm_shuffle_ps(vd2, vd2, _MM_SHUFFLE(3, 3, 3, 3)));
+
+      pCoeffs += 20U;
+      pState += 8U;
+      stage -= 4U;
+
+      /* The current group output is the input of the next one */
+      pIn = pDst;
+      pOut = pDst;
+   }
+
+   /* Remaining stages, one at a time */
+   while (stage > 0U)
+   {
+      /* Reading the coefficients */
+      b0 = *pCoeffs++;
+      b1 = *pCoeffs++;
+      b2 = *pCoeffs++;
+      a1 = *pCoeffs++;
+      a2 = *pCoeffs++;
+
+      /*Reading the state values */
+      d1 = pState[0];
+      d2 = pState[1];
+
+      sample = blockSize;
+
+      while (sample > 0U)
+      {
+         /* Read the input */
+         Xn1 = *pIn++;
+
+         /* y[n] = b0 * x[n] + d1 */
+         acc1 = (b0 * Xn1) + d1;
+
+         /* Store the result in the accumulator in the destination buffer. */
+         *pOut++ = acc1;
+
+         /* d1 = b1 * x[n] + a1 * y[n] + d2 */
+         d1 = ((b1 * Xn1) + (a1 * acc1)) + d2;
+
+         /* d2 = b2 * x[n] + a2 * y[n] */
+         d2 = (b2 * Xn1) + (a2 * acc1);
+
+         /* decrement the loop counter */
+         sample--;
+      }
+
+      /* Store the updated state variables back into the state array */
+      *pState++ = d1;
+      *pState++ = d2;
+
+      /* The current stage input is given as the output to the next stage */
+      pIn = pDst;
+
+      /*Reset the output working pointer */
+      pOut = pDst;
+
+      /* decrement the loop counter */
+      stage--;
+   }
+
 #else
 
    float32_t Xn2, Xn3, Xn4;                  	  /*  Input State variables     */
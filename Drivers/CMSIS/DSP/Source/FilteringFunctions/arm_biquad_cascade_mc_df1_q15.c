@@ -0,0 +1,228 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_biquad_cascade_mc_df1_q15.c
+ * Description:  Processing function for the Q15 multi-channel Biquad cascade filter
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup BiquadCascadeDF1
+ * @{
+ */
+
+/**
+ * @brief Processing function for the Q15 multi-channel Biquad cascade filter.
+ * @param[in]  *S        points to an instance of the Q15 multi-channel Biquad cascade structure.
+ * @param[in]  *pSrc     points to the block of input frames.
+ * @param[out] *pDst     points to the block of output frames.
+ * @param[in]  blockSize number of frames to process.
+ * @return none.
+ *
+ * \par
+ * <code>numChannels</code> interleaved channels, every channel filtered with the same
+ * coefficients. The frames are read in place, as written by a DMA from a multiplexed source.
+ * The channels of a stage are computed in pairs: the coefficients are loaded once per stage
+ * and pair, and the two independent recursions overlap.
+ * \par
+ * The coefficients are the 6 per stage of arm_biquad_cascade_df1_q15(), <code>{b0, 0, b1, b2, a1, a2}</code>,
+ * so that the same array can serve both.
+ * \par
+ * <code>pState</code> holds the 4 state variables of each channel, channel after channel,
+ * for the first stage then for the next ones:
+ * <pre>
+ *     {x[n-1], x[n-2], y[n-1], y[n-2] of ch0, x[n-1], x[n-2], y[n-1], y[n-2] of ch1, ...}
+ * </pre>
+ *
+ * <b>Scaling and Overflow Behavior:</b>
+ * \par
+ * As for arm_biquad_cascade_df1_q15(): a 64-bit accumulator per channel, shifted by
+ * <code>postShift</code>, truncated and saturated to 1.15. The outputs are the ones of
+ * arm_biquad_cascade_df1_q15() on each channel alone.
+ */
+
+void arm_biquad_cascade_mc_df1_q15(
+  const arm_biquad_casd_mc_df1_inst_q15 * S,
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize)
+{
+  q15_t *pStageIn = pSrc;                        /*  input of the current stage    */
+  q15_t *pIn;                                    /*  input pointer initialization  */
+  q15_t *pOut;                                   /*  output pointer initialization */
+  q15_t *pState = S->pState;                     /*  pState pointer initialization */
+  q15_t *pCoeffs = S->pCoeffs;                   /*  coeff pointer initialization  */
+  q63_t acca, accb;                              /*  accumulators                  */
+  q15_t b0, b1, b2, a1, a2;                      /*  Filter coefficients           */
+  q15_t Xna, Xn1a, Xn2a, Yn1a, Yn2a;             /*  first channel of a pair       */
+  q15_t Xnb, Xn1b, Xn2b, Yn1b, Yn2b;             /*  second channel of a pair      */
+  int32_t shift = (15 - (int32_t) S->postShift); /*  Post shift                    */
+  uint32_t numChannels = S->numChannels;         /*  number of channels            */
+  uint32_t sample, ch, stage = S->numStages;     /*  loop counters                 */
+
+  do
+  {
+    /* Reading the coefficients */
+    b0 = *pCoeffs++;
+    pCoeffs++;  // skip the 0 coefficient
+    b1 = *pCoeffs++;
+    b2 = *pCoeffs++;
+    a1 = *pCoeffs++;
+    a2 = *pCoeffs++;
+
+    ch = 0U;
+
+    while ((ch + 2U) <= numChannels)
+    {
+      pIn = &pStageIn[ch];
+      pOut = &pDst[ch];
+
+      /* Reading the state values */
+      Xn1a = pState[0];
+      Xn2a = pState[1];
+      Yn1a = pState[2];
+      Yn2a = pState[3];
+      Xn1b = pState[4];
+      Xn2b = pState[5];
+      Yn1b = pState[6];
+      Yn2b = pState[7];
+
+      sample = blockSize;
+
+      while (sample > 0U)
+      {
+        /* Read the inputs of the pair */
+        Xna = pIn[0];
+        Xnb = pIn[1];
+        pIn += numChannels;
+
+        /* acc =  b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] + a1 * y[n-1] + a2 * y[n-2] */
+        acca = (q31_t) b0 * Xna;
+        accb = (q31_t) b0 * Xnb;
+        acca += (q31_t) b1 * Xn1a;
+        accb += (q31_t) b1 * Xn1b;
+        acca += (q31_t) b2 * Xn2a;
+        accb += (q31_t) b2 * Xn2b;
+        acca += (q31_t) a1 * Yn1a;
+        accb += (q31_t) a1 * Yn1b;
+        acca += (q31_t) a2 * Yn2a;
+        accb += (q31_t) a2 * Yn2b;
+
+        /* The result is converted to 1.15 and saturated */
+        acca = __SSAT((acca >> shift), 16);
+        accb = __SSAT((accb >> shift), 16);
+
+        /* Every time after the output is computed state should be updated. */
+        Xn2a = Xn1a;
+        Xn1a = Xna;
+        Yn2a = Yn1a;
+        Yn1a = (q15_t) acca;
+        Xn2b = Xn1b;
+        Xn1b = Xnb;
+        Yn2b = Yn1b;
+        Yn1b = (q15_t) accb;
+
+        /* Store the outputs in the destination buffer. */
+        pOut[0] = (q15_t) acca;
+        pOut[1] = (q15_t) accb;
+        pOut += numChannels;
+
+        /* decrement the loop counter */
+        sample--;
+      }
+
+      /*  Store the updated state variables back into the pState array */
+      pState[0] = Xn1a;
+      pState[1] = Xn2a;
+      pState[2] = Yn1a;
+      pState[3] = Yn2a;
+      pState[4] = Xn1b;
+      pState[5] = Xn2b;
+      pState[6] = Yn1b;
+      pState[7] = Yn2b;
+
+      pState += 8U;
+      ch += 2U;
+    }
+
+    /* Last channel of an odd number */
+    if (ch < numChannels)
+    {
+      pIn = &pStageIn[ch];
+      pOut = &pDst[ch];
+
+      Xn1a = pState[0];
+      Xn2a = pState[1];
+      Yn1a = pState[2];
+      Yn2a = pState[3];
+
+      sample = blockSize;
+
+      while (sample > 0U)
+      {
+        Xna = *pIn;
+        pIn += numChannels;
+
+        acca = (q31_t) b0 * Xna;
+        acca += (q31_t) b1 * Xn1a;
+        acca += (q31_t) b2 * Xn2a;
+        acca += (q31_t) a1 * Yn1a;
+        acca += (q31_t) a2 * Yn2a;
+        acca = __SSAT((acca >> shift), 16);
+
+        Xn2a = Xn1a;
+        Xn1a = Xna;
+        Yn2a = Yn1a;
+        Yn1a = (q15_t) acca;
+
+        *pOut = (q15_t) acca;
+        pOut += numChannels;
+
+        sample--;
+      }
+
+      pState[0] = Xn1a;
+      pState[1] = Xn2a;
+      pState[2] = Yn1a;
+      pState[3] = Yn2a;
+
+      pState += 4U;
+    }
+
+    /*  The first stage goes from the input buffer to the output buffer. */
+    /*  Subsequent stages occur in-place in the output buffer */
+    pStageIn = pDst;
+
+  } while (--stage);
+}
+
+
+/**
+  * @} end of BiquadCascadeDF1 group
+  */
@@ -0,0 +1,225 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_biquad_cascade_mc_df1_q31.c
+ * Description:  Processing function for the Q31 multi-channel Biquad cascade filter
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup BiquadCascadeDF1
+ * @{
+ */
+
+/**
+ * @brief Processing function for the Q31 multi-channel Biquad cascade filter.
+ * @param[in]  *S        points to an instance of the Q31 multi-channel Biquad cascade structure.
+ * @param[in]  *pSrc     points to the block of input frames.
+ * @param[out] *pDst     points to the block of output frames.
+ * @param[in]  blockSize number of frames to process.
+ * @return none.
+ *
+ * \par
+ * <code>numChannels</code> interleaved channels, every channel filtered with the same
+ * coefficients. The frames are read in place, as written by a DMA from a multiplexed source.
+ * The channels of a stage are computed in pairs: the coefficients are loaded once per stage
+ * and pair, and the two independent recursions overlap.
+ * \par
+ * <code>pState</code> holds the 4 state variables of each channel, channel after channel,
+ * for the first stage then for the next ones:
+ * <pre>
+ *     {x[n-1], x[n-2], y[n-1], y[n-2] of ch0, x[n-1], x[n-2], y[n-1], y[n-2] of ch1, ...}
+ * </pre>
+ *
+ * <b>Scaling and Overflow Behavior:</b>
+ * \par
+ * As for arm_biquad_cascade_df1_q31(): a 64-bit accumulator per channel, shifted by
+ * <code>postShift</code> and truncated to 1.31. The outputs are the ones of
+ * arm_biquad_cascade_df1_q31() on each channel alone.
+ */
+
+void arm_biquad_cascade_mc_df1_q31(
+  const arm_biquad_casd_mc_df1_inst_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize)
+{
+  q31_t *pStageIn = pSrc;                        /*  input of the current stage    */
+  q31_t *pIn;                                    /*  input pointer initialization  */
+  q31_t *pOut;                                   /*  output pointer initialization */
+  q31_t *pState = S->pState;                     /*  pState pointer initialization */
+  q31_t *pCoeffs = S->pCoeffs;                   /*  coeff pointer initialization  */
+  q63_t acca, accb;                              /*  accumulators                  */
+  q31_t b0, b1, b2, a1, a2;                      /*  Filter coefficients           */
+  q31_t Xna, Xn1a, Xn2a, Yn1a, Yn2a;             /*  first channel of a pair       */
+  q31_t Xnb, Xn1b, Xn2b, Yn1b, Yn2b;             /*  second channel of a pair      */
+  uint32_t uShift = ((uint32_t) S->postShift + 1U);
+  uint32_t lShift = 32U - uShift;                /*  Shift to be applied to the output */
+  uint32_t numChannels = S->numChannels;         /*  number of channels            */
+  uint32_t sample, ch, stage = S->numStages;     /*  loop counters                 */
+
+  do
+  {
+    /* Reading the coefficients */
+    b0 = *pCoeffs++;
+    b1 = *pCoeffs++;
+    b2 = *pCoeffs++;
+    a1 = *pCoeffs++;
+    a2 = *pCoeffs++;
+
+    ch = 0U;
+
+    while ((ch + 2U) <= numChannels)
+    {
+      pIn = &pStageIn[ch];
+      pOut = &pDst[ch];
+
+      /* Reading the state values */
+      Xn1a = pState[0];
+      Xn2a = pState[1];
+      Yn1a = pState[2];
+      Yn2a = pState[3];
+      Xn1b = pState[4];
+      Xn2b = pState[5];
+      Yn1b = pState[6];
+      Yn2b = pState[7];
+
+      sample = blockSize;
+
+      while (sample > 0U)
+      {
+        /* Read the inputs of the pair */
+        Xna = pIn[0];
+        Xnb = pIn[1];
+        pIn += numChannels;
+
+        /* acc =  b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] + a1 * y[n-1] + a2 * y[n-2] */
+        acca = (q63_t) b0 * Xna;
+        accb = (q63_t) b0 * Xnb;
+        acca += (q63_t) b1 * Xn1a;
+        accb += (q63_t) b1 * Xn1b;
+        acca += (q63_t) b2 * Xn2a;
+        accb += (q63_t) b2 * Xn2b;
+        acca += (q63_t) a1 * Yn1a;
+        accb += (q63_t) a1 * Yn1b;
+        acca += (q63_t) a2 * Yn2a;
+        accb += (q63_t) a2 * Yn2b;
+
+        /* The result is converted to 1.31  */
+        acca = acca >> lShift;
+        accb = accb >> lShift;
+
+        /* Every time after the output is computed state should be updated. */
+        Xn2a = Xn1a;
+        Xn1a = Xna;
+        Yn2a = Yn1a;
+        Yn1a = (q31_t) acca;
+        Xn2b = Xn1b;
+        Xn1b = Xnb;
+        Yn2b = Yn1b;
+        Yn1b = (q31_t) accb;
+
+        /* Store the outputs in the destination buffer. */
+        pOut[0] = (q31_t) acca;
+        pOut[1] = (q31_t) accb;
+        pOut += numChannels;
+
+        /* decrement the loop counter */
+        sample--;
+      }
+
+      /*  Store the updated state variables back into the pState array */
+      pState[0] = Xn1a;
+      pState[1] = Xn2a;
+      pState[2] = Yn1a;
+      pState[3] = Yn2a;
+      pState[4] = Xn1b;
+      pState[5] = Xn2b;
+      pState[6] = Yn1b;
+      pState[7] = Yn2b;
+
+      pState += 8U;
+      ch += 2U;
+    }
+
+    /* Last channel of an odd number */
+    if (ch < numChannels)
+    {
+      pIn = &pStageIn[ch];
+      pOut = &pDst[ch];
+
+      Xn1a = pState[0];
+      Xn2a = pState[1];
+      Yn1a = pState[2];
+      Yn2a = pState[3];
+
+      sample = blockSize;
+
+      while (sample > 0U)
+      {
+        Xna = *pIn;
+        pIn += numChannels;
+
+        acca = (q63_t) b0 * Xna;
+        acca += (q63_t) b1 * Xn1a;
+        acca += (q63_t) b2 * Xn2a;
+        acca += (q63_t) a1 * Yn1a;
+        acca += (q63_t) a2 * Yn2a;
+        acca = acca >> lShift;
+
+        Xn2a = Xn1a;
+        Xn1a = Xna;
+        Yn2a = Yn1a;
+        Yn1a = (q31_t) acca;
+
+        *pOut = (q31_t) acca;
+        pOut += numChannels;
+
+        sample--;
+      }
+
+      pState[0] = Xn1a;
+      pState[1] = Xn2a;
+      pState[2] = Yn1a;
+      pState[3] = Yn2a;
+
+      pState += 4U;
+    }
+
+    /*  The first stage goes from the input buffer to the output buffer. */
+    /*  Subsequent stages occur in-place in the output buffer */
+    pStageIn = pDst;
+
+  } while (--stage);
+}
+
+
+/**
+  * @} end of BiquadCascadeDF1 group
+  */
@@ -0,0 +1,343 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_biquad_cascade_mc_df2T_f32.c
+ * Description:  Processing function for floating-point multi-channel transposed direct form II Biquad cascade filter
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+#if defined(ARM_MATH_SSE4)
+
+/* Loads the first n (0 to 4) lanes from p, the other lanes are zero */
+CMSIS_INLINE __STATIC_INLINE __m128 arm_biquad_mc_load_ps(
+const float32_t * p,
+uint32_t n)
+{
+    switch (n)
+    {
+    case 4U:
+        return _mm_loadu_ps(p);
+    case 3U:
+        return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) p), _mm_load_ss(p + 2));
+    case 2U:
+        return _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) p);
+    case 1U:
+        return _mm_load_ss(p);
+    default:
+        return _mm_setzero_ps();
+    }
+}
+
+/* Stores the first n (0 to 4) lanes of v to p */
+CMSIS_INLINE __STATIC_INLINE void arm_biquad_mc_store_ps(
+float32_t * p,
+__m128 v,
+uint32_t n)
+{
+    switch (n)
+    {
+    case 4U:
+        _mm_storeu_ps(p, v);
+        break;
+    case 3U:
+        _mm_storel_pi((__m64 *) p, v);
+        _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+        break;
+    case 2U:
+        _mm_storel_pi((__m64 *) p, v);
+        break;
+    case 1U:
+        _mm_store_ss(p, v);
+        break;
+    default:
+        break;
+    }
+}
+
+#endif
+
+/**
+* @ingroup groupFilters
+*/
+
+/**
+* @addtogroup BiquadCascadeDF2T
+* @{
+*/
+
+/**
+* @brief Processing function for the floating-point multi-channel transposed direct form II Biquad cascade filter.
+* @param[in]  *S        points to an instance of the filter data structure.
+* @param[in]  *pSrc     points to the block of input frames.
+* @param[out] *pDst     points to the block of output frames
+* @param[in]  blockSize number of frames to process.
+* @return none.
+*
+* \par
+* The generalization of arm_biquad_cascade_stereo_df2T_f32() to <code>numChannels</code>
+* interleaved channels, every channel filtered with the same coefficients. The frames are read
+* in place, as written by a DMA from a multiplexed source. The channels of a stage are computed
+* in groups of 4, one lane each: the coefficients are loaded once per stage and group, and the
+* 4 independent recursions hide the latency of the multiply-accumulates. On x86 hosts two
+* vectors of 4 lanes run in the same loop, the lanes past the last channel being zero.
+* \par
+* <code>pState</code> holds the 2 state variables of each channel, channel after channel,
+* for the first stage then for the next ones:
+* <pre>
+*     {d1 ch0, d2 ch0, d1 ch1, d2 ch1, ...}
+* </pre>
+* The outputs are the ones of arm_biquad_cascade_df2T_f32() on each channel alone.
+*/
+
+void arm_biquad_cascade_mc_df2T_f32(
+const arm_biquad_cascade_mc_df2T_instance_f32 * S,
+float32_t * pSrc,
+float32_t * pDst,
+uint32_t blockSize)
+{
+
+    float32_t *pStageIn = pSrc;                    /*  input of the current stage */
+    float32_t *pIn;                                /*  source pointer            */
+    float32_t *pOut;                               /*  destination pointer       */
+    float32_t *pState = S->pState;                 /*  State pointer             */
+    float32_t *pCoeffs = S->pCoeffs;               /*  coefficient pointer       */
+    float32_t b0, b1, b2, a1, a2;                  /*  Filter coefficients       */
+    float32_t acc1a, Xn1a, d1a, d2a;               /*  first channel of a group  */
+#if defined(ARM_MATH_SSE4)
+    __m128 vb0, vb1, vb2, va1, va2;                /*  coefficients in all lanes */
+    __m128 vxa, vya, vd1a, vd2a;                   /*  first 4 channels          */
+    __m128 vxb, vyb, vd1b, vd2b;                   /*  next 4 channels           */
+    float32_t d1Lanes[8], d2Lanes[8];              /*  state values of the lanes */
+    uint32_t nA, nB, i;                            /*  lanes in use              */
+#else
+    float32_t acc1b, acc1c, acc1d;                 /*  accumulators              */
+    float32_t Xn1b, Xn1c, Xn1d;                    /*  temporary inputs          */
+    float32_t d1b, d2b, d1c, d2c, d1d, d2d;        /*  state variables           */
+#endif
+    uint32_t numChannels = S->numChannels;         /*  number of channels        */
+    uint32_t sample, ch, stage = S->numStages;     /*  loop counters             */
+
+    do
+    {
+        /* Reading the coefficients */
+        b0 = pCoeffs[0];
+        b1 = pCoeffs[1];
+        b2 = pCoeffs[2];
+        a1 = pCoeffs[3];
+        a2 = pCoeffs[4];
+        pCoeffs += 5U;
+
+#if defined(ARM_MATH_SSE4)
+        vb0 = _mm_set1_ps(b0);
+        vb1 = _mm_set1_ps(b1);
+        vb2 = _mm_set1_ps(b2);
+        va1 = _mm_set1_ps(a1);
+        va2 = _mm_set1_ps(a2);
+#endif
+
+        ch = 0U;
+
+#if defined(ARM_MATH_SSE4)
+        while (ch < numChannels)
+        {
+            pIn = &pStageIn[ch];
+            pOut = &pDst[ch];
+            sample = blockSize;
+
+            /* Lanes of the two vectors, up to 8 channels */
+            nA = ((numChannels - ch) > 4U) ? 4U : (numChannels - ch);
+            nB = ((numChannels - ch - nA) > 4U) ? 4U : (numChannels - ch - nA);
+
+            /* Reading the state values, one channel per lane */
+            memset(d1Lanes, 0, sizeof(d1Lanes));
+            memset(d2Lanes, 0, sizeof(d2Lanes));
+
+            for (i = 0U; i < (nA + nB); i++)
+            {
+                d1Lanes[i] = pState[2U * i];
+                d2Lanes[i] = pState[(2U * i) + 1U];
+            }
+
+            vd1a = _mm_loadu_ps(&d1Lanes[0]);
+            vd2a = _mm_loadu_ps(&d2Lanes[0]);
+            vd1b = _mm_loadu_ps(&d1Lanes[4]);
+            vd2b = _mm_loadu_ps(&d2Lanes[4]);
+
+            while (sample > 0U)
+            {
+                vxa = arm_biquad_mc_load_ps(pIn, nA);
+                vxb = arm_biquad_mc_load_ps(pIn + 4, nB);
+                pIn += numChannels;
+
+                /* y[n] = b0 * x[n] + d1 */
+                vya = _mm_add_ps(_mm_mul_ps(vb0, vxa), vd1a);
+                vyb = _mm_add_ps(_mm_mul_ps(vb0, vxb), vd1b);
+
+                /* d1 = b1 * x[n] + a1 * y[n] + d2 */
+                vd1a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vb1, vxa), _mm_mul_ps(va1, vya)), vd2a);
+                vd1b = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vb1, vxb), _mm_mul_ps(va1, vyb)), vd2b);
+
+                /* d2 = b2 * x[n] + a2 * y[n] */
+                vd2a = _mm_add_ps(_mm_mul_ps(vb2, vxa), _mm_mul_ps(va2, vya));
+                vd2b = _mm_add_ps(_mm_mul_ps(vb2, vxb), _mm_mul_ps(va2, vyb));
+
+                arm_biquad_mc_store_ps(pOut, vya, nA);
+                arm_biquad_mc_store_ps(pOut + 4, vyb, nB);
+                pOut += numChannels;
+
+                sample--;
+            }
+
+            /* Store the updated state variables back into the state array */
+            _mm_storeu_ps(&d1Lanes[0], vd1a);
+            _mm_storeu_ps(&d2Lanes[0], vd2a);
+            _mm_storeu_ps(&d1Lanes[4], vd1b);
+            _mm_storeu_ps(&d2Lanes[4], vd2b);
+
+            for (i = 0U; i < (nA + nB); i++)
+            {
+                pState[2U * i] = d1Lanes[i];
+                pState[(2U * i) + 1U] = d2Lanes[i];
+            }
+
+            pState += 2U * (nA + nB);
+            ch += nA + nB;
+        }
+#else
+        while ((ch + 4U) <= numChannels)
+        {
+            pIn = &pStageIn[ch];
+            pOut = &pDst[ch];
+            sample = blockSize;
+
+            /*Reading the state values */
+            d1a = pState[0];
+            d2a = pState[1];
+            d1b = pState[2];
+            d2b = pState[3];
+            d1c = pState[4];
+            d2c = pState[5];
+            d1d = pState[6];
+            d2d = pState[7];
+
+            while (sample > 0U)
+            {
+                /* Read the inputs of the group */
+                Xn1a = pIn[0];
+                Xn1b = pIn[1];
+                Xn1c = pIn[2];
+                Xn1d = pIn[3];
+                pIn += numChannels;
+
+                /* y[n] = b0 * x[n] + d1 */
+                acc1a = (b0 * Xn1a) + d1a;
+                acc1b = (b0 * Xn1b) + d1b;
+                acc1c = (b0 * Xn1c) + d1c;
+                acc1d = (b0 * Xn1d) + d1d;
+
+                /* Store the result in the accumulator in the destination buffer. */
+                pOut[0] = acc1a;
+                pOut[1] = acc1b;
+                pOut[2] = acc1c;
+                pOut[3] = acc1d;
+                pOut += numChannels;
+
+                /* Every time after the output is computed state should be updated. */
+                /* d1 = b1 * x[n] + a1 * y[n] + d2 */
+                d1a = ((b1 * Xn1a) + (a1 * acc1a)) + d2a;
+                d1b = ((b1 * Xn1b) + (a1 * acc1b)) + d2b;
+                d1c = ((b1 * Xn1c) + (a1 * acc1c)) + d2c;
+                d1d = ((b1 * Xn1d) + (a1 * acc1d)) + d2d;
+
+                /* d2 = b2 * x[n] + a2 * y[n] */
+                d2a = (b2 * Xn1a) + (a2 * acc1a);
+                d2b = (b2 * Xn1b) + (a2 * acc1b);
+                d2c = (b2 * Xn1c) + (a2 * acc1c);
+                d2d = (b2 * Xn1d) + (a2 * acc1d);
+
+                sample--;
+            }
+
+            /* Store the updated state variables back into the state array */
+            pState[0] = d1a;
+            pState[1] = d2a;
+            pState[2] = d1b;
+            pState[3] = d2b;
+            pState[4] = d1c;
+            pState[5] = d2c;
+            pState[6] = d1d;
+            pState[7] = d2d;
+
+            pState += 8U;
+            ch += 4U;
+        }
+#endif
+
+        /* Remaining 1 to 3 channels, one at a time */
+        while (ch < numChannels)
+        {
+            pIn = &pStageIn[ch];
+            pOut = &pDst[ch];
+            sample = blockSize;
+
+            d1a = pState[0];
+            d2a = pState[1];
+
+            while (sample > 0U)
+            {
+                Xn1a = *pIn;
+                pIn += numChannels;
+
+                acc1a = (b0 * Xn1a) + d1a;
+                *pOut = acc1a;
+                pOut += numChannels;
+
+                d1a = ((b1 * Xn1a) + (a1 * acc1a)) + d2a;
+                d2a = (b2 * Xn1a) + (a2 * acc1a);
+
+                sample--;
+            }
+
+            pState[0] = d1a;
+            pState[1] = d2a;
+
+            pState += 2U;
+            ch++;
+        }
+
+        /* The current stage output is given as the input to the next stage */
+        pStageIn = pDst;
+
+        /*decrement the loop counter */
+        stage--;
+
+    } while (stage > 0U);
+
+}
+
+
+/**
+* @} end of BiquadCascadeDF2T group
+*/
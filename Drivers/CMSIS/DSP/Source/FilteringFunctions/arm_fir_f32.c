@@ -546,6 +546,118 @@ uint32_t blockSize)
 
 }
 
+#elif defined(ARM_MATH_SSE4)
+
+/* Run the below code for x86 hosts */
+
+void arm_fir_f32(
+const arm_fir_instance_f32 * S,
+float32_t * pSrc,
+float32_t * pDst,
+uint32_t blockSize)
+{
+   float32_t *pState = S->pState;                 /* State pointer */
+   float32_t *pCoeffs = S->pCoeffs;               /* Coefficient pointer */
+   float32_t *pStateCurnt;                        /* Points to the current sample of the state */
+   float32_t *px, *pb;                            /* Temporary pointers for state and coefficient buffers */
+   uint32_t numTaps = S->numTaps;                 /* Number of filter coefficients in the filter */
+   uint32_t i, tapCnt, blkCnt;                    /* Loop counters */
+   float32_t acc;
+
+   /* The whole block is copied into the state buffer first: an output only reads
+   ** the state up to its own sample */
+   pStateCurnt = &(S->pState[(numTaps - 1U)]);
+   memcpy(pStateCurnt, pSrc, blockSize * sizeof(float32_t));
+
+   /* Several outputs are computed at once, one per lane. Each tap is a broadcast
+   ** coefficient times the state vector starting at that tap, so every output sums
+   ** its products in the same order as the scalar code below */
+   blkCnt = blockSize;
+
+#if defined(ARM_MATH_AVX2)
+   while (blkCnt >= 8U)
+   {
+      __m256 acc8 = _mm256_setzero_ps();
+
+      px = pState;
+      pb = pCoeffs;
+      i = numTaps;
+
+      do
+      {
+         acc8 = _mm256_fmadd_ps(_mm256_loadu_ps(px++), _mm256_broadcast_ss(pb++), acc8);
+         i--;
+
+      } while (i > 0U);
+
+      _mm256_storeu_ps(pDst, acc8);
+      pDst += 8;
+      pState += 8;
+      blkCnt -= 8U;
+   }
+#endif
+
+   while (blkCnt >= 4U)
+   {
+      __m128 acc4 = _mm_setzero_ps();
+
+      px = pState;
+      pb = pCoeffs;
+      i = numTaps;
+
+      do
+      {
+         acc4 = _mm_add_ps(acc4, _mm_mul_ps(_mm_loadu_ps(px++), _mm_set1_ps(*pb++)));
+         i--;
+
+      } while (i > 0U);
+
+      _mm_storeu_ps(pDst, acc4);
+      pDst += 4;
+      pState += 4;
+      blkCnt -= 4U;
+   }
+
+   while (blkCnt > 0U)
+   {
+      acc = 0.0f;
+      px = pState;
+      pb = pCoeffs;
+      i = numTaps;
+
+      do
+      {
+         acc += *px++ * *pb++;
+         i--;
+
+      } while (i > 0U);
+
+      *pDst++ = acc;
+      pState = pState + 1;
+      blkCnt--;
+   }
+
+   /* Processing is complete.
+   ** Now copy the last numTaps - 1 samples to the starting of the state buffer.
+   ** This prepares the state buffer for the next function call. */
+
+   /* Points to the start of the state buffer */
+   pStateCurnt = S->pState;
+
+   /* Copy numTaps number of values */
+   tapCnt = numTaps - 1U;
+
+   /* Copy data */
+   while (tapCnt > 0U)
+   {
+      *pStateCurnt++ = *pState++;
+
+      /* Decrement the loop counter */
+      tapCnt--;
+   }
+
+}
+
 #else
 
 /* Run the below code for Cortex-M4 and Cortex-M3 */
@@ -0,0 +1,168 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_fir_fft_f32.c
+ * Description:  Floating-point FIR filter by uniformly partitioned overlap-save
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FIR
+ * @{
+ */
+
+/**
+ * @brief Products of two packed real spectra, pY = pX * pH or pY += pX * pH.
+ * @param[in]  *pX      points to the input spectrum, fftLen values as output by arm_rfft_fast_f32().
+ * @param[in]  *pH      points to the partition spectrum.
+ * @param[in,out] *pY   points to the sum.
+ * @param[in]  fftLen   length of the real FFT.
+ * @param[in]  accumulate 0 to overwrite pY, 1 to add to it.
+ * @return none.
+ *
+ * The first two values are the real DC and Nyquist bins, the others complex bins.
+ */
+static void arm_fir_fft_cmac_f32(
+  const float32_t * pX,
+  const float32_t * pH,
+  float32_t * pY,
+  uint32_t fftLen,
+  uint32_t accumulate)
+{
+  float32_t xr, xi, hr, hi;
+  uint32_t bins = (fftLen / 2U) - 1U;
+
+  if (accumulate == 0U)
+  {
+    *pY++ = *pX++ * *pH++;
+    *pY++ = *pX++ * *pH++;
+
+    while (bins > 0U)
+    {
+      xr = *pX++;
+      xi = *pX++;
+      hr = *pH++;
+      hi = *pH++;
+      *pY++ = xr * hr - xi * hi;
+      *pY++ = xr * hi + xi * hr;
+      bins--;
+    }
+  }
+  else
+  {
+    *pY++ += *pX++ * *pH++;
+    *pY++ += *pX++ * *pH++;
+
+    while (bins > 0U)
+    {
+      xr = *pX++;
+      xi = *pX++;
+      hr = *pH++;
+      hi = *pH++;
+      *pY++ += xr * hr - xi * hi;
+      *pY++ += xr * hi + xi * hr;
+      bins--;
+    }
+  }
+}
+
+/**
+ * @param[in,out] *S points to an instance of the floating-point FFT-based FIR filter structure.
+ * @param[in] *pSrc points to the block of input data.
+ * @param[out] *pDst points to the block of output data.
+ * @param[in] blockSize number of samples to process per call.
+ * @return none.
+ *
+ * \par Algorithm:
+ * Uniformly partitioned overlap-save. Every partLen input samples:
+ * - the previous and the new block form a window of 2*partLen samples, whose spectrum X
+ *   becomes the newest slot of the frequency-domain delay line,
+ * - Y = sum over p of X[i-p] * H[p], H[p] being the spectrum of partition p of the filter and
+ *   X[i-p] the spectrum of the window p blocks ago,
+ * - the last partLen samples of the inverse FFT of Y are the outputs, the first ones are
+ *   wrapped around by the circular convolution and dropped.
+ * \par
+ * The outputs are the ones of arm_fir_f32() with the same coefficients, without delay, up to
+ * the rounding of the FFTs. <code>blockSize</code> is the value given to arm_fir_fft_init_f32()
+ * or another multiple of <code>S->partLen</code>; <code>pDst</code> may be <code>pSrc</code>.
+ */
+void arm_fir_fft_f32(
+  arm_fir_fft_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t *pWin = S->pScratch;                 /* Window, then sum of the products */
+  float32_t *pOut = &(S->pScratch[2U * S->partLen]);  /* Inverse FFT of the sum */
+  uint32_t partLen = S->partLen;
+  uint32_t fftLen = 2U * partLen;
+  uint32_t numParts = S->numParts;
+  uint32_t blkCnt, p, slot;
+
+  if (partLen == 0U)
+  {
+    arm_fir_f32(&(S->fir), pSrc, pDst, blockSize);
+    return;
+  }
+
+  blkCnt = blockSize / partLen;
+
+  while (blkCnt > 0U)
+  {
+    /* Window of the previous and the new block, the new one kept for the next call */
+    memcpy(pWin, S->pState, partLen * sizeof(float32_t));
+    memcpy(&pWin[partLen], pSrc, partLen * sizeof(float32_t));
+    memcpy(S->pState, pSrc, partLen * sizeof(float32_t));
+
+    /* Its spectrum in the next slot of the delay line */
+    S->fdlIndex = (S->fdlIndex + 1U == numParts) ? 0U : (S->fdlIndex + 1U);
+    arm_rfft_fast_f32(&(S->rfft), pWin, &(S->pFdl[S->fdlIndex * fftLen]), 0U);
+
+    /* Partition p applies to the spectrum p blocks ago */
+    slot = S->fdlIndex;
+    for (p = 0U; p < numParts; p++)
+    {
+      arm_fir_fft_cmac_f32(&(S->pFdl[slot * fftLen]), &(S->pCoeffsFreq[p * fftLen]),
+                           pWin, fftLen, (p != 0U) ? 1U : 0U);
+      slot = (slot == 0U) ? (numParts - 1U) : (slot - 1U);
+    }
+
+    /* Valid part of the circular convolution */
+    arm_rfft_fast_f32(&(S->rfft), pWin, pOut, 1U);
+    memcpy(pDst, &pOut[partLen], partLen * sizeof(float32_t));
+
+    pSrc += partLen;
+    pDst += partLen;
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of FIR group
+ */
@@ -0,0 +1,193 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_fir_fft_init_f32.c
+ * Description:  Floating-point FFT-based FIR filter initialization function
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FIR
+ * @{
+ */
+
+/*
+ * Cost of the FFT path, in taps of arm_fir_f32() (multiply-accumulates per
+ * output sample), used to choose between the two forms:
+ * - ARM_FIR_FFT_COST_RFFT: the forward and inverse real FFTs, per output sample and per
+ *   log2 of their length,
+ * - ARM_FIR_FFT_COST_BIN: complex multiply-accumulate of one frequency bin,
+ * - ARM_FIR_FFT_COST_BLOCK: copies and call overhead, per output sample.
+ * The host values fit the arm_fir_f32 and arm_fir_fft_f32 rows of the benchmark suite,
+ * break-even near 130 taps. The Cortex-M ones are derived from the FPU instruction
+ * timings, to be replaced by the break-even that benchmark measures on the target;
+ * each can be set on the command line.
+ */
+#if defined (ARM_MATH_HOST_X86)
+#ifndef ARM_FIR_FFT_COST_RFFT
+#define ARM_FIR_FFT_COST_RFFT   2.0f
+#endif
+#ifndef ARM_FIR_FFT_COST_BIN
+#define ARM_FIR_FFT_COST_BIN    6.0f
+#endif
+#ifndef ARM_FIR_FFT_COST_BLOCK
+#define ARM_FIR_FFT_COST_BLOCK  90.0f
+#endif
+#else
+#ifndef ARM_FIR_FFT_COST_RFFT
+#define ARM_FIR_FFT_COST_RFFT   6.5f
+#endif
+#ifndef ARM_FIR_FFT_COST_BIN
+#define ARM_FIR_FFT_COST_BIN    5.5f
+#endif
+#ifndef ARM_FIR_FFT_COST_BLOCK
+#define ARM_FIR_FFT_COST_BLOCK  8.0f
+#endif
+#endif
+
+/* Partition lengths, the real FFT lengths of arm_rfft_fast_f32() halved */
+#define ARM_FIR_FFT_MIN_PART    16U
+#define ARM_FIR_FFT_MAX_PART    2048U
+
+/**
+ * @details
+ *
+ * @param[in,out] *S points to an instance of the floating-point FFT-based FIR filter structure.
+ * @param[in] 	  numTaps  Number of filter coefficients in the filter.
+ * @param[in]     *pCoeffs points to the filter coefficients buffer.
+ * @param[in]     *pBuffer points to the buffer of partition spectra, delay line and state.
+ * @param[in] 	  blockSize number of samples that are processed per call.
+ * @return        ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if <code>numTaps</code> or <code>blockSize</code> is 0.
+ *
+ * <b>Description:</b>
+ * \par
+ * <code>pCoeffs</code> points to the array of filter coefficients stored in time reversed order,
+ * as for arm_fir_init_f32():
+ * <pre>
+ *    {b[numTaps-1], b[numTaps-2], b[N-2], ..., b[1], b[0]}
+ * </pre>
+ * A correlation with a template t[0..numTaps-1] (matched filter) is therefore set up by passing
+ * the template as it is: pDst[n] = sum of t[k] * x[n-numTaps+1+k].
+ * \par
+ * The filter is cut into partitions of <code>partLen</code> taps, a power of two from 16 to 2048 that
+ * divides <code>blockSize</code>. The spectra of the partitions are computed here, each call then
+ * costs two real FFTs of 2*partLen points and numParts spectral products per partLen samples
+ * instead of numTaps multiply-accumulates per sample. The length is the one of least
+ * estimated cost; the direct form arm_fir_f32() is kept (partLen 0) when it is cheaper, for short
+ * filters, or when <code>blockSize</code> has no such divisor.
+ * \par
+ * <code>pBuffer</code> is of length <code>ARM_FIR_FFT_BUFFER_SIZE(numTaps, blockSize)</code>.
+ * In FFT form <code>pCoeffs</code> is only read here, in direct form arm_fir_f32() keeps reading it.
+ */
+
+arm_status arm_fir_fft_init_f32(
+  arm_fir_fft_instance_f32 * S,
+  uint16_t numTaps,
+  float32_t * pCoeffs,
+  float32_t * pBuffer,
+  uint32_t blockSize)
+{
+  float32_t *pPart;                              /* Time-domain partition, zero padded */
+  float32_t cost, bestCost;
+  uint32_t len, log2Len, parts, bestLen;
+  uint32_t p, t, tap;
+
+  S->numTaps = numTaps;
+  S->partLen = 0U;
+  S->numParts = 0U;
+  S->fdlIndex = 0U;
+
+  if ((numTaps == 0U) || (blockSize == 0U))
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  /* Direct form cost, then the FFT form for every partition length allowed */
+  bestCost = (float32_t) numTaps;
+  bestLen = 0U;
+
+  log2Len = 5U;
+  for (len = ARM_FIR_FFT_MIN_PART; len <= ARM_FIR_FFT_MAX_PART; len <<= 1U)
+  {
+    if ((blockSize % len) == 0U)
+    {
+      parts = (numTaps + len - 1U) / len;
+      cost = (ARM_FIR_FFT_COST_RFFT * (float32_t) log2Len)
+           + (ARM_FIR_FFT_COST_BIN * (float32_t) parts * (float32_t) (len + 1U) / (float32_t) len)
+           + ARM_FIR_FFT_COST_BLOCK;
+
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        bestLen = len;
+      }
+    }
+    log2Len++;
+  }
+
+  if (bestLen == 0U)
+  {
+    arm_fir_init_f32(&(S->fir), numTaps, pCoeffs, pBuffer, blockSize);
+    return ARM_MATH_SUCCESS;
+  }
+
+  parts = (numTaps + bestLen - 1U) / bestLen;
+  S->partLen = (uint16_t) bestLen;
+  S->numParts = (uint16_t) parts;
+  S->pCoeffsFreq = pBuffer;
+  S->pFdl = &pBuffer[parts * 2U * bestLen];
+  S->pState = &pBuffer[parts * 4U * bestLen];
+  S->pScratch = &pBuffer[parts * 4U * bestLen + bestLen];
+  arm_rfft_fast_init_f32(&(S->rfft), (uint16_t) (2U * bestLen));
+
+  /* Spectra of the partitions, b[p*partLen .. p*partLen+partLen-1] followed by partLen zeros */
+  pPart = S->pScratch;
+  for (p = 0U; p < parts; p++)
+  {
+    memset(pPart, 0, 2U * bestLen * sizeof(float32_t));
+    for (t = 0U; t < bestLen; t++)
+    {
+      tap = p * bestLen + t;
+      if (tap < numTaps)
+      {
+        pPart[t] = pCoeffs[numTaps - 1U - tap];
+      }
+    }
+    arm_rfft_fast_f32(&(S->rfft), pPart, &(S->pCoeffsFreq[p * 2U * bestLen]), 0U);
+  }
+
+  /* Clear the delay line and the previous input block */
+  memset(S->pFdl, 0, (parts * 2U * bestLen + bestLen) * sizeof(float32_t));
+
+  return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of FIR group
+ */
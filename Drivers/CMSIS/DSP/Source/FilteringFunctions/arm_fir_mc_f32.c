@@ -0,0 +1,287 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_fir_mc_f32.c
+ * Description:  Floating-point multi-channel FIR filter processing function
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FIR
+ * @{
+ */
+
+/**
+ * @param[in]  *S points to an instance of the floating-point multi-channel FIR structure.
+ * @param[in]  *pSrc points to the block of input frames.
+ * @param[out] *pDst points to the block of output frames.
+ * @param[in]  blockSize number of frames to process per call.
+ * @return     none.
+ *
+ * \par
+ * The frames hold <code>numChannels</code> interleaved samples, as written by a DMA from a
+ * multiplexed source, and every channel is filtered with the same coefficients. The channels
+ * are computed in groups of 4 (8 with AVX2 on the host), one lane each: every coefficient is
+ * loaded once per group and multiplied with the samples of the group, read in place from the
+ * frames. On x86 hosts the channels left after the groups of 8 go in two vectors of 4 lanes,
+ * the last vector overlapping the previous one rather than leaving channels to the scalar
+ * code. The outputs are the ones of arm_fir_f32() on each channel alone.
+ */
+
+void arm_fir_mc_f32(
+const arm_fir_mc_instance_f32 * S,
+float32_t * pSrc,
+float32_t * pDst,
+uint32_t blockSize)
+{
+   float32_t *pState = S->pState;                 /* State pointer */
+   float32_t *pCoeffs = S->pCoeffs;               /* Coefficient pointer */
+   float32_t *pStateCurnt;                        /* Points to the current frame of the state */
+   float32_t *px, *pb;                            /* Temporary pointers for state and coefficient buffers */
+   float32_t *pFrame, *pOut;                      /* First state frame and output of the current output */
+   float32_t acc0;                                /* Accumulator */
+#if defined(ARM_MATH_SSE4)
+   uint32_t offA, offB;                           /* First channels of the two vectors */
+#else
+   float32_t acc1, acc2, acc3, coeff;             /* Accumulators of the other channels of the group */
+#endif
+   uint32_t numTaps = S->numTaps;                 /* Number of filter coefficients in the filter */
+   uint32_t numChannels = S->numChannels;         /* Number of interleaved channels */
+   uint32_t ch, i, tapCnt, blkCnt;                /* Loop counters */
+
+   /* The whole block is copied into the state buffer first: an output only reads
+   ** the state up to its own frame */
+   pStateCurnt = &(S->pState[(numTaps - 1U) * numChannels]);
+   memcpy(pStateCurnt, pSrc, blockSize * numChannels * sizeof(float32_t));
+
+   ch = 0U;
+
+#if defined(ARM_MATH_AVX2)
+   while ((ch + 8U) <= numChannels)
+   {
+      pFrame = &pState[ch];
+      pOut = &pDst[ch];
+      blkCnt = blockSize;
+
+      while (blkCnt > 0U)
+      {
+         __m256 acc8 = _mm256_setzero_ps();
+
+         px = pFrame;
+         pb = pCoeffs;
+         i = numTaps;
+
+         do
+         {
+            acc8 = _mm256_fmadd_ps(_mm256_loadu_ps(px), _mm256_broadcast_ss(pb++), acc8);
+            px += numChannels;
+            i--;
+
+         } while (i > 0U);
+
+         _mm256_storeu_ps(pOut, acc8);
+         pOut += numChannels;
+         pFrame += numChannels;
+         blkCnt--;
+      }
+
+      ch += 8U;
+   }
+#endif
+
+#if defined(ARM_MATH_SSE4)
+   /* The remaining channels in two vectors of 4 lanes, two frames at a time: the four
+   ** accumulations share the coefficient and overlap. A vector past the last channel is moved
+   ** back onto the last 4 channels, which are then computed twice with the same result */
+   while ((ch < numChannels) && (numChannels >= 4U))
+   {
+      offA = ((ch + 4U) <= numChannels) ? ch : (numChannels - 4U);
+      offB = ((ch + 8U) <= numChannels) ? (ch + 4U) : (numChannels - 4U);
+
+      pFrame = pState;
+      pOut = pDst;
+      blkCnt = blockSize;
+
+      while (blkCnt > 0U)
+      {
+         __m128 accA0 = _mm_setzero_ps(), accB0 = _mm_setzero_ps();
+         __m128 accA1 = _mm_setzero_ps(), accB1 = _mm_setzero_ps();
+         __m128 vc;
+
+         px = pFrame;
+         pb = pCoeffs;
+         i = numTaps;
+
+         if (blkCnt >= 2U)
+         {
+            do
+            {
+               vc = _mm_set1_ps(*pb++);
+               accA0 = _mm_add_ps(accA0, _mm_mul_ps(_mm_loadu_ps(px + offA), vc));
+               accB0 = _mm_add_ps(accB0, _mm_mul_ps(_mm_loadu_ps(px + offB), vc));
+               accA1 = _mm_add_ps(accA1, _mm_mul_ps(_mm_loadu_ps(px + numChannels + offA), vc));
+               accB1 = _mm_add_ps(accB1, _mm_mul_ps(_mm_loadu_ps(px + numChannels + offB), vc));
+               px += numChannels;
+               i--;
+
+            } while (i > 0U);
+
+            _mm_storeu_ps(pOut + offA, accA0);
+            _mm_storeu_ps(pOut + offB, accB0);
+            _mm_storeu_ps(pOut + numChannels + offA, accA1);
+            _mm_storeu_ps(pOut + numChannels + offB, accB1);
+
+            pOut += 2U * numChannels;
+            pFrame += 2U * numChannels;
+            blkCnt -= 2U;
+         }
+         else
+         {
+            do
+            {
+               vc = _mm_set1_ps(*pb++);
+               accA0 = _mm_add_ps(accA0, _mm_mul_ps(_mm_loadu_ps(px + offA), vc));
+               accB0 = _mm_add_ps(accB0, _mm_mul_ps(_mm_loadu_ps(px + offB), vc));
+               px += numChannels;
+               i--;
+
+            } while (i > 0U);
+
+            _mm_storeu_ps(pOut + offA, accA0);
+            _mm_storeu_ps(pOut + offB, accB0);
+
+            pOut += numChannels;
+            pFrame += numChannels;
+            blkCnt--;
+         }
+      }
+
+      ch += 8U;
+   }
+#else
+   while ((ch + 4U) <= numChannels)
+   {
+      pFrame = &pState[ch];
+      pOut = &pDst[ch];
+      blkCnt = blockSize;
+
+      while (blkCnt > 0U)
+      {
+         px = pFrame;
+         pb = pCoeffs;
+         i = numTaps;
+
+         acc0 = 0.0f;
+         acc1 = 0.0f;
+         acc2 = 0.0f;
+         acc3 = 0.0f;
+
+         do
+         {
+            /* One coefficient load for the four channels */
+            coeff = *pb++;
+            acc0 += px[0] * coeff;
+            acc1 += px[1] * coeff;
+            acc2 += px[2] * coeff;
+            acc3 += px[3] * coeff;
+            px += numChannels;
+            i--;
+
+         } while (i > 0U);
+
+         pOut[0] = acc0;
+         pOut[1] = acc1;
+         pOut[2] = acc2;
+         pOut[3] = acc3;
+
+         pOut += numChannels;
+         pFrame += numChannels;
+         blkCnt--;
+      }
+
+      ch += 4U;
+   }
+#endif
+
+   /* Remaining 1 to 3 channels, one at a time */
+   while (ch < numChannels)
+   {
+      pFrame = &pState[ch];
+      pOut = &pDst[ch];
+      blkCnt = blockSize;
+
+      while (blkCnt > 0U)
+      {
+         acc0 = 0.0f;
+         px = pFrame;
+         pb = pCoeffs;
+         i = numTaps;
+
+         do
+         {
+            acc0 += *px * *pb++;
+            px += numChannels;
+            i--;
+
+         } while (i > 0U);
+
+         *pOut = acc0;
+         pOut += numChannels;
+         pFrame += numChannels;
+         blkCnt--;
+      }
+
+      ch++;
+   }
+
+   /* Processing is complete.
+   ** Now copy the last numTaps - 1 frames to the starting of the state buffer.
+   ** This prepares the state buffer for the next function call. */
+
+   /* Points to the start of the state buffer */
+   pStateCurnt = S->pState;
+   pState = &(S->pState[blockSize * numChannels]);
+
+   /* Copy (numTaps - 1) frames */
+   tapCnt = (numTaps - 1U) * numChannels;
+
+   /* Copy data */
+   while (tapCnt > 0U)
+   {
+      *pStateCurnt++ = *pState++;
+
+      /* Decrement the loop counter */
+      tapCnt--;
+   }
+
+}
+
+/**
+ * @} end of FIR group
+ */
@@ -0,0 +1,182 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_fir_mc_q31.c
+ * Description:  Q31 multi-channel FIR filter processing function
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FIR
+ * @{
+ */
+
+/**
+ * @param[in]  *S points to an instance of the Q31 multi-channel FIR structure.
+ * @param[in]  *pSrc points to the block of input frames.
+ * @param[out] *pDst points to the block of output frames.
+ * @param[in]  blockSize number of frames to process per call.
+ * @return     none.
+ *
+ * \par
+ * The frames hold <code>numChannels</code> interleaved samples and every channel is filtered
+ * with the same coefficients. The channels are computed in groups of 4, every coefficient
+ * loaded once per group.
+ *
+ * <b>Scaling and Overflow Behavior:</b>
+ * \par
+ * As for arm_fir_q31(): each channel has a 64-bit accumulator in 2.62 format, of which
+ * bits [62:31] are kept as the 1.31 output. The outputs are the ones of arm_fir_q31() on each
+ * channel alone, and the same care must be taken with the gain of the filter.
+ */
+
+void arm_fir_mc_q31(
+  const arm_fir_mc_instance_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize)
+{
+  q31_t *pState = S->pState;                     /* State pointer */
+  q31_t *pCoeffs = S->pCoeffs;                   /* Coefficient pointer */
+  q31_t *pStateCurnt;                            /* Points to the current frame of the state */
+  q31_t *px, *pb;                                /* Temporary pointers for state and coefficient buffers */
+  q31_t *pFrame, *pOut;                          /* First state frame and output of the current output */
+  q63_t acc0, acc1, acc2, acc3;                  /* Accumulators, one per channel of the group */
+  q31_t coeff;                                   /* Coefficient of the current tap */
+  uint32_t numTaps = S->numTaps;                 /* Number of filter coefficients in the filter */
+  uint32_t numChannels = S->numChannels;         /* Number of interleaved channels */
+  uint32_t ch, i, tapCnt, blkCnt;                /* Loop counters */
+
+  /* The whole block is copied into the state buffer first: an output only reads
+   ** the state up to its own frame */
+  pStateCurnt = &(S->pState[(numTaps - 1U) * numChannels]);
+  memcpy(pStateCurnt, pSrc, blockSize * numChannels * sizeof(q31_t));
+
+  ch = 0U;
+
+  while ((ch + 4U) <= numChannels)
+  {
+    pFrame = &pState[ch];
+    pOut = &pDst[ch];
+    blkCnt = blockSize;
+
+    while (blkCnt > 0U)
+    {
+      acc0 = 0;
+      acc1 = 0;
+      acc2 = 0;
+      acc3 = 0;
+
+      px = pFrame;
+      pb = pCoeffs;
+      i = numTaps;
+
+      do
+      {
+        /* One coefficient load for the four channels */
+        coeff = *pb++;
+        acc0 += (q63_t) px[0] * coeff;
+        acc1 += (q63_t) px[1] * coeff;
+        acc2 += (q63_t) px[2] * coeff;
+        acc3 += (q63_t) px[3] * coeff;
+        px += numChannels;
+        i--;
+
+      } while (i > 0U);
+
+      /* The results are in 2.62 format.  Convert to 1.31 */
+      pOut[0] = (q31_t) (acc0 >> 31U);
+      pOut[1] = (q31_t) (acc1 >> 31U);
+      pOut[2] = (q31_t) (acc2 >> 31U);
+      pOut[3] = (q31_t) (acc3 >> 31U);
+
+      pOut += numChannels;
+      pFrame += numChannels;
+      blkCnt--;
+    }
+
+    ch += 4U;
+  }
+
+  /* Remaining 1 to 3 channels, one at a time */
+  while (ch < numChannels)
+  {
+    pFrame = &pState[ch];
+    pOut = &pDst[ch];
+    blkCnt = blockSize;
+
+    while (blkCnt > 0U)
+    {
+      acc0 = 0;
+      px = pFrame;
+      pb = pCoeffs;
+      i = numTaps;
+
+      do
+      {
+        acc0 += (q63_t) *px * *pb++;
+        px += numChannels;
+        i--;
+
+      } while (i > 0U);
+
+      *pOut = (q31_t) (acc0 >> 31U);
+      pOut += numChannels;
+      pFrame += numChannels;
+      blkCnt--;
+    }
+
+    ch++;
+  }
+
+  /* Processing is complete.
+   ** Now copy the last numTaps - 1 frames to the starting of the state buffer.
+   ** This prepares the state buffer for the next function call. */
+
+  /* Points to the start of the state buffer */
+  pStateCurnt = S->pState;
+  pState = &(S->pState[blockSize * numChannels]);
+
+  /* Copy (numTaps - 1) frames */
+  tapCnt = (numTaps - 1U) * numChannels;
+
+  /* Copy data */
+  while (tapCnt > 0U)
+  {
+    *pStateCurnt++ = *pState++;
+
+    /* Decrement the loop counter */
+    tapCnt--;
+  }
+
+}
+
+/**
+ * @} end of FIR group
+ */
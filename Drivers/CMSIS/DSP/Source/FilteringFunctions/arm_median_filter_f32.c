@@ -0,0 +1,266 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_median_filter_f32.c
+ * Description:  Floating-point sliding window median filter
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @defgroup MedianFilter Sliding Window Median Filter
+ *
+ * Each output sample is the median of the last <code>windowSize</code> input samples:
+ * <pre>
+ *     y[n] = median(x[n-windowSize+1], ..., x[n-1], x[n])
+ * </pre>
+ * For an even <code>windowSize</code>, it is the mean of the two middle samples. The filter
+ * rejects impulsive noise, spikes shorter than half the window, while keeping the edges of
+ * steps. The window starts filled with zeros, as the state of an FIR filter.
+ *
+ * \par Algorithm
+ * The window is kept as two heaps around the median: a max-heap of the samples below it and
+ * a min-heap of the samples above it, together in one array of sample indexes, with the
+ * median in the middle. A position array gives the heap node of each sample. Every new sample
+ * replaces the oldest one in its heap node, which then moves up or down its heap, and across
+ * the median when needed: an update costs O(log(windowSize)) compare-exchanges instead of the
+ * O(windowSize) of a sorted window, or the O(windowSize * log(windowSize)) of sorting every
+ * window.
+ *
+ * \par
+ * The functions operate on blocks of input and output data and each call to the function
+ * processes <code>blockSize</code> samples through the filter. <code>pSrc</code> and
+ * <code>pDst</code> points to input and output arrays containing <code>blockSize</code> values.
+ *
+ * \par Instance Structure
+ * The window samples, heap and positions are stored in an instance data structure.
+ * A separate instance structure must be defined for each filter.
+ * There are separate instance structure declarations for each of the 3 supported data types.
+ *
+ * \par Initialization Functions
+ * There is also an associated initialization function for each data type.
+ * The initialization function performs the following operations:
+ * - Sets the values of the internal structure fields.
+ * - Zeros out the window samples and builds the heaps around them.
+ *
+ * \par
+ * <code>pState</code> holds <code>windowSize</code> samples and <code>pIndex</code>
+ * holds <code>2*windowSize</code> indexes: the heap, then the positions.
+ *
+ * \par Fixed-Point Behavior
+ * The fixed-point functions output input samples, or the mean of two of them rounded
+ * towards minus infinity for an even <code>windowSize</code>, and cannot overflow.
+ */
+
+/**
+ * @addtogroup MedianFilter
+ * @{
+ */
+
+/*
+ * Exchanges heap nodes i and j when the sample of node i is less than the one of node j.
+ * Returns 1 if they are exchanged.
+ */
+static uint32_t arm_median_cmp_exch_f32(
+  const float32_t * pData,
+  int16_t * pHeap,
+  int16_t * pPos,
+  int32_t i,
+  int32_t j)
+{
+  int16_t tmp;
+
+  if (!(pData[pHeap[i]] < pData[pHeap[j]]))
+  {
+    return (0U);
+  }
+
+  tmp = pHeap[i];
+  pHeap[i] = pHeap[j];
+  pHeap[j] = tmp;
+  pPos[pHeap[i]] = (int16_t) i;
+  pPos[pHeap[j]] = (int16_t) j;
+
+  return (1U);
+}
+
+/* Moves down the min-heap, nodes 1 to minCnt, from child node i */
+static void arm_median_min_down_f32(
+  const float32_t * pData,
+  int16_t * pHeap,
+  int16_t * pPos,
+  int32_t i,
+  int32_t minCnt)
+{
+  while (i <= minCnt)
+  {
+    /* Smaller child of node i / 2 */
+    if ((i > 1) && (i < minCnt) && (pData[pHeap[i + 1]] < pData[pHeap[i]]))
+    {
+      i++;
+    }
+
+    if (arm_median_cmp_exch_f32(pData, pHeap, pPos, i, i / 2) == 0U)
+    {
+      break;
+    }
+
+    i *= 2;
+  }
+}
+
+/* Moves down the max-heap, nodes -1 to -maxCnt, from child node i */
+static void arm_median_max_down_f32(
+  const float32_t * pData,
+  int16_t * pHeap,
+  int16_t * pPos,
+  int32_t i,
+  int32_t maxCnt)
+{
+  while (i >= -maxCnt)
+  {
+    /* Larger child of node i / 2 */
+    if ((i < -1) && (i > -maxCnt) && (pData[pHeap[i]] < pData[pHeap[i - 1]]))
+    {
+      i--;
+    }
+
+    if (arm_median_cmp_exch_f32(pData, pHeap, pPos, i / 2, i) == 0U)
+    {
+      break;
+    }
+
+    i *= 2;
+  }
+}
+
+/**
+ * @param[in]  *S         points to an instance of the floating-point median filter structure.
+ * @param[in]  *pSrc      points to the block of input data.
+ * @param[out] *pDst      points to the block of output data.
+ * @param[in]  blockSize  number of samples to process.
+ * @return     none.
+ */
+
+void arm_median_filter_f32(
+  arm_median_filter_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t *pData = S->pState;                  /* window samples */
+  int16_t *pHeap = S->pIndex + (S->windowSize >> 1U);  /* median node of the heap */
+  int16_t *pPos = S->pIndex + S->windowSize;     /* heap node of every sample */
+  float32_t in, old;                             /* new and replaced samples */
+  int32_t maxCnt = (int32_t) (S->windowSize >> 1U);          /* nodes of the max-heap */
+  int32_t minCnt = (int32_t) ((S->windowSize - 1U) >> 1U);   /* nodes of the min-heap */
+  int32_t i;                                     /* heap node */
+  uint32_t idx = S->stateIndex;                  /* oldest sample */
+  uint32_t blkCnt = blockSize;                   /* loop counter */
+
+  while (blkCnt > 0U)
+  {
+    in = *pSrc++;
+
+    /* The new sample takes the place of the oldest one */
+    i = pPos[idx];
+    old = pData[idx];
+    pData[idx] = in;
+
+    idx++;
+    if (idx == S->windowSize)
+    {
+      idx = 0U;
+    }
+
+    if (i > 0)
+    {
+      /* In the min-heap: down if larger, else up and maybe across the median */
+      if (old < in)
+      {
+        arm_median_min_down_f32(pData, pHeap, pPos, i * 2, minCnt);
+      }
+      else
+      {
+        while ((i > 0) && (arm_median_cmp_exch_f32(pData, pHeap, pPos, i, i / 2) != 0U))
+        {
+          i /= 2;
+        }
+
+        if (i == 0)
+        {
+          arm_median_max_down_f32(pData, pHeap, pPos, -1, maxCnt);
+        }
+      }
+    }
+    else if (i < 0)
+    {
+      /* In the max-heap: down if smaller, else up and maybe across the median */
+      if (in < old)
+      {
+        arm_median_max_down_f32(pData, pHeap, pPos, i * 2, maxCnt);
+      }
+      else
+      {
+        while ((i < 0) && (arm_median_cmp_exch_f32(pData, pHeap, pPos, i / 2, i) != 0U))
+        {
+          i /= 2;
+        }
+
+        if (i == 0)
+        {
+          arm_median_min_down_f32(pData, pHeap, pPos, 1, minCnt);
+        }
+      }
+    }
+    else
+    {
+      /* The median itself: into the heap on its side */
+      arm_median_max_down_f32(pData, pHeap, pPos, -1, maxCnt);
+      arm_median_min_down_f32(pData, pHeap, pPos, 1, minCnt);
+    }
+
+    /* The median node, and the top of the max-heap for an even window */
+    if (maxCnt == minCnt)
+    {
+      *pDst++ = pData[pHeap[0]];
+    }
+    else
+    {
+      *pDst++ = 0.5f * (pData[pHeap[0]] + pData[pHeap[-1]]);
+    }
+
+    blkCnt--;
+  }
+
+  S->stateIndex = (uint16_t) idx;
+}
+
+/**
+ * @} end of MedianFilter group
+ */
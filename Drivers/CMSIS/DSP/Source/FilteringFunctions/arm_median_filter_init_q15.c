@@ -0,0 +1,91 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_median_filter_init_q15.c
+ * Description:  Q15 median filter initialization function
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup MedianFilter
+ * @{
+ */
+
+/**
+ * @brief  Initialization function for the Q15 median filter.
+ * @param[in,out] *S          points to an instance of the Q15 median filter structure.
+ * @param[in]     windowSize  number of samples in the window, from 1 to 32767.
+ * @param[in]     *pState     points to the window samples, of length <code>windowSize</code>.
+ * @param[in]     *pIndex     points to the heap and positions, of length <code>2*windowSize</code>.
+ * @return        none.
+ *
+ * <b>Description:</b>
+ * \par
+ * The window is filled with zeros: the first <code>windowSize-1</code> outputs are the
+ * medians of the first input samples and of zeros.
+ */
+
+void arm_median_filter_init_q15(
+  arm_median_filter_instance_q15 * S,
+  uint16_t windowSize,
+  q15_t * pState,
+  int16_t * pIndex)
+{
+  int16_t *pHeap = pIndex + (windowSize >> 1U);  /* median node of the heap */
+  int16_t *pPos = pIndex + windowSize;           /* heap node of every sample */
+  int16_t node;                                  /* heap node of a sample */
+  uint32_t i;                                    /* loop counter */
+
+  S->windowSize = windowSize;
+  S->stateIndex = 0U;
+
+  /* Clear the window */
+  memset(pState, 0, windowSize * sizeof(q15_t));
+
+  /* Samples alternate between the max-heap and the min-heap: 0, -1, 1, -2, 2, ... */
+  for (i = 0U; i < windowSize; i++)
+  {
+    node = (int16_t) ((i + 1U) >> 1U);
+
+    if ((i & 1U) != 0U)
+    {
+      node = -node;
+    }
+
+    pPos[i] = node;
+    pHeap[node] = (int16_t) i;
+  }
+
+  S->pState = pState;
+  S->pIndex = pIndex;
+}
+
+/**
+ * @} end of MedianFilter group
+ */
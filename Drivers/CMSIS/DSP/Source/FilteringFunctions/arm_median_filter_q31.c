@@ -0,0 +1,221 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_median_filter_q31.c
+ * Description:  Q31 sliding window median filter
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup MedianFilter
+ * @{
+ */
+
+/*
+ * Exchanges heap nodes i and j when the sample of node i is less than the one of node j.
+ * Returns 1 if they are exchanged.
+ */
+static uint32_t arm_median_cmp_exch_q31(
+  const q31_t * pData,
+  int16_t * pHeap,
+  int16_t * pPos,
+  int32_t i,
+  int32_t j)
+{
+  int16_t tmp;
+
+  if (!(pData[pHeap[i]] < pData[pHeap[j]]))
+  {
+    return (0U);
+  }
+
+  tmp = pHeap[i];
+  pHeap[i] = pHeap[j];
+  pHeap[j] = tmp;
+  pPos[pHeap[i]] = (int16_t) i;
+  pPos[pHeap[j]] = (int16_t) j;
+
+  return (1U);
+}
+
+/* Moves down the min-heap, nodes 1 to minCnt, from child node i */
+static void arm_median_min_down_q31(
+  const q31_t * pData,
+  int16_t * pHeap,
+  int16_t * pPos,
+  int32_t i,
+  int32_t minCnt)
+{
+  while (i <= minCnt)
+  {
+    /* Smaller child of node i / 2 */
+    if ((i > 1) && (i < minCnt) && (pData[pHeap[i + 1]] < pData[pHeap[i]]))
+    {
+      i++;
+    }
+
+    if (arm_median_cmp_exch_q31(pData, pHeap, pPos, i, i / 2) == 0U)
+    {
+      break;
+    }
+
+    i *= 2;
+  }
+}
+
+/* Moves down the max-heap, nodes -1 to -maxCnt, from child node i */
+static void arm_median_max_down_q31(
+  const q31_t * pData,
+  int16_t * pHeap,
+  int16_t * pPos,
+  int32_t i,
+  int32_t maxCnt)
+{
+  while (i >= -maxCnt)
+  {
+    /* Larger child of node i / 2 */
+    if ((i < -1) && (i > -maxCnt) && (pData[pHeap[i]] < pData[pHeap[i - 1]]))
+    {
+      i--;
+    }
+
+    if (arm_median_cmp_exch_q31(pData, pHeap, pPos, i / 2, i) == 0U)
+    {
+      break;
+    }
+
+    i *= 2;
+  }
+}
+
+/**
+ * @param[in]  *S         points to an instance of the Q31 median filter structure.
+ * @param[in]  *pSrc      points to the block of input data.
+ * @param[out] *pDst      points to the block of output data.
+ * @param[in]  blockSize  number of samples to process.
+ * @return     none.
+ */
+
+void arm_median_filter_q31(
+  arm_median_filter_instance_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize)
+{
+  q31_t *pData = S->pState;                      /* window samples */
+  int16_t *pHeap = S->pIndex + (S->windowSize >> 1U);  /* median node of the heap */
+  int16_t *pPos = S->pIndex + S->windowSize;     /* heap node of every sample */
+  q31_t in, old;                                 /* new and replaced samples */
+  int32_t maxCnt = (int32_t) (S->windowSize >> 1U);          /* nodes of the max-heap */
+  int32_t minCnt = (int32_t) ((S->windowSize - 1U) >> 1U);   /* nodes of the min-heap */
+  int32_t i;                                     /* heap node */
+  uint32_t idx = S->stateIndex;                  /* oldest sample */
+  uint32_t blkCnt = blockSize;                   /* loop counter */
+
+  while (blkCnt > 0U)
+  {
+    in = *pSrc++;
+
+    /* The new sample takes the place of the oldest one */
+    i = pPos[idx];
+    old = pData[idx];
+    pData[idx] = in;
+
+    idx++;
+    if (idx == S->windowSize)
+    {
+      idx = 0U;
+    }
+
+    if (i > 0)
+    {
+      /* In the min-heap: down if larger, else up and maybe across the median */
+      if (old < in)
+      {
+        arm_median_min_down_q31(pData, pHeap, pPos, i * 2, minCnt);
+      }
+      else
+      {
+        while ((i > 0) && (arm_median_cmp_exch_q31(pData, pHeap, pPos, i, i / 2) != 0U))
+        {
+          i /= 2;
+        }
+
+        if (i == 0)
+        {
+          arm_median_max_down_q31(pData, pHeap, pPos, -1, maxCnt);
+        }
+      }
+    }
+    else if (i < 0)
+    {
+      /* In the max-heap: down if smaller, else up and maybe across the median */
+      if (in < old)
+      {
+        arm_median_max_down_q31(pData, pHeap, pPos, i * 2, maxCnt);
+      }
+      else
+      {
+        while ((i < 0) && (arm_median_cmp_exch_q31(pData, pHeap, pPos, i / 2, i) != 0U))
+        {
+          i /= 2;
+        }
+
+        if (i == 0)
+        {
+          arm_median_min_down_q31(pData, pHeap, pPos, 1, minCnt);
+        }
+      }
+    }
+    else
+    {
+      /* The median itself: into the heap on its side */
+      arm_median_max_down_q31(pData, pHeap, pPos, -1, maxCnt);
+      arm_median_min_down_q31(pData, pHeap, pPos, 1, minCnt);
+    }
+
+    /* The median node, and the top of the max-heap for an even window */
+    if (maxCnt == minCnt)
+    {
+      *pDst++ = pData[pHeap[0]];
+    }
+    else
+    {
+      *pDst++ = (q31_t) (((q63_t) pData[pHeap[0]] + pData[pHeap[-1]]) >> 1);
+    }
+
+    blkCnt--;
+  }
+
+  S->stateIndex = (uint16_t) idx;
+}
+
+/**
+ * @} end of MedianFilter group
+ */
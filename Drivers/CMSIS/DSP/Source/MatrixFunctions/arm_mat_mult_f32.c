@@ -182,6 +182,112 @@ arm_status arm_mat_mult_f32(
 
       } while (col > 0U);
 
+#elif defined (ARM_MATH_SSE4)
+
+  /* Run the below code for x86 hosts */
+
+  uint16_t col, i = 0U, row = numRowsA, colCnt;  /* loop counters */
+  arm_status status;                             /* status of matrix multiplication */
+  __m128 acc4;
+
+#ifdef ARM_MATH_MATRIX_CHECK
+
+  /* Check for matrix mismatch condition */
+  if ((pSrcA->numCols != pSrcB->numRows) ||
+     (pSrcA->numRows != pDst->numRows) || (pSrcB->numCols != pDst->numCols))
+  {
+
+    /* Set status as ARM_MATH_SIZE_MISMATCH */
+    status = ARM_MATH_SIZE_MISMATCH;
+  }
+  else
+#endif /*      #ifdef ARM_MATH_MATRIX_CHECK    */
+
+  {
+    /* Several columns of the output row at once, one per lane: each element of the row of pSrcA
+     ** is broadcast and multiplied by the same columns of the matching row of pSrcB. Every output
+     ** sums its products in the same order as the scalar code */
+    /* row loop */
+    do
+    {
+      /* Output pointer is set to starting address of the row being processed */
+      px = pOut + i;
+
+      /* Columns left in the output row */
+      col = numColsB;
+
+#if defined (ARM_MATH_AVX2)
+      while (col >= 8U)
+      {
+        __m256 acc8 = _mm256_setzero_ps();
+
+        pIn1 = pInA;
+        pIn2 = pSrcB->pData + (numColsB - col);
+        colCnt = numColsA;
+
+        while (colCnt > 0U)
+        {
+          acc8 = _mm256_fmadd_ps(_mm256_broadcast_ss(pIn1++), _mm256_loadu_ps(pIn2), acc8);
+          pIn2 += numColsB;
+
+          /* Decrement the loop counter */
+          colCnt--;
+        }
+
+        _mm256_storeu_ps(px, acc8);
+        px += 8;
+        col -= 8U;
+      }
+#endif
+
+      while (col >= 4U)
+      {
+        acc4 = _mm_setzero_ps();
+
+        pIn1 = pInA;
+        pIn2 = pSrcB->pData + (numColsB - col);
+        colCnt = numColsA;
+
+        while (colCnt > 0U)
+        {
+          acc4 = _mm_add_ps(acc4, _mm_mul_ps(_mm_set1_ps(*pIn1++), _mm_loadu_ps(pIn2)));
+          pIn2 += numColsB;
+
+          /* Decrement the loop counter */
+          colCnt--;
+        }
+
+        _mm_storeu_ps(px, acc4);
+        px += 4;
+        col -= 4U;
+      }
+
+      /* Remaining columns */
+      while (col > 0U)
+      {
+        sum = 0.0f;
+
+        pIn1 = pInA;
+        pIn2 = pSrcB->pData + (numColsB - col);
+        colCnt = numColsA;
+
+        while (colCnt > 0U)
+        {
+          /* c(m,n) = a(1,1)*b(1,1) + a(1,2) * b(2,1) + .... + a(m,p)*b(p,n) */
+          sum += *pIn1++ * (*pIn2);
+          pIn2 += numColsB;
+
+          /* Decrement the loop counter */
+          colCnt--;
+        }
+
+        /* Store the result in the destination buffer */
+        *px++ = sum;
+
+        /* Decrement the column loop counter */
+        col--;
+      }
+
 #else
 
   /* Run the below code for Cortex-M0 */
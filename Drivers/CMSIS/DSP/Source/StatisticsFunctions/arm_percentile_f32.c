@@ -0,0 +1,90 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_percentile_f32.c
+ * Description:  Percentile of a floating-point vector
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup OrderStat
+ * @{
+ */
+
+/**
+ * @brief  Percentile of a floating-point vector.
+ * @param[in,out] *pSrc     points to the input vector, reordered.
+ * @param[in]     blockSize length of the input vector, greater than 0.
+ * @param[in]     fraction  percentile as a fraction, 0 for the minimum, 0.5 for the median
+ *                          and 1 for the maximum. Values out of [0, 1] are clamped.
+ * @param[out]    *pResult  percentile value.
+ * @return none.
+ */
+
+void arm_percentile_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t fraction,
+  float32_t * pResult)
+{
+  float32_t rank;                                /* rank in the sorted vector */
+  float32_t lower, upper;                        /* elements around the rank */
+  uint32_t index;                                /* index of the upper element */
+
+  /* rank = fraction * (blockSize - 1) */
+  rank = fraction * (float32_t) (blockSize - 1U);
+
+  if (rank < 0.0f)
+  {
+    rank = 0.0f;
+  }
+  else if (rank > (float32_t) (blockSize - 1U))
+  {
+    rank = (float32_t) (blockSize - 1U);
+  }
+
+  index = (uint32_t) rank;
+  rank = rank - (float32_t) index;
+
+  arm_quickselect_f32(pSrc, blockSize, index, &lower);
+
+  if (rank > 0.0f)
+  {
+    /* The next element in the sorted order is the minimum of the ones after lower */
+    arm_min_f32(pSrc + index + 1U, blockSize - index - 1U, &upper, &index);
+
+    lower = lower + (rank * (upper - lower));
+  }
+
+  *pResult = lower;
+}
+
+/**
+ * @} end of OrderStat group
+ */
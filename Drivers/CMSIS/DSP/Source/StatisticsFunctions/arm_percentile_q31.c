@@ -0,0 +1,92 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_percentile_q31.c
+ * Description:  Percentile of a Q31 vector
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup OrderStat
+ * @{
+ */
+
+/**
+ * @brief  Percentile of a Q31 vector.
+ * @param[in,out] *pSrc     points to the input vector, reordered.
+ * @param[in]     blockSize length of the input vector, greater than 0.
+ * @param[in]     fraction  percentile as a fraction in 1.31 format, 0 for the minimum and
+ *                          0x40000000 for the median. Negative values are clamped to 0.
+ * @param[out]    *pResult  percentile value.
+ * @return none.
+ *
+ * <b>Scaling and Overflow Behavior:</b>
+ * \par
+ * The rank is computed in 33.31 format and the interpolation in 2.62 format, so neither
+ * overflows. The fraction cannot reach 1: the maximum is the one of arm_max_q31(), or of
+ * arm_quickselect_q31() with k = blockSize - 1.
+ */
+
+void arm_percentile_q31(
+  q31_t * pSrc,
+  uint32_t blockSize,
+  q31_t fraction,
+  q31_t * pResult)
+{
+  q63_t rank;                                    /* rank in the sorted vector, 33.31 */
+  q31_t lower, upper;                            /* elements around the rank */
+  q31_t frac;                                    /* fractional part of the rank */
+  uint32_t index;                                /* index of the upper element */
+
+  if (fraction < 0)
+  {
+    fraction = 0;
+  }
+
+  /* rank = fraction * (blockSize - 1) */
+  rank = (q63_t) fraction * (blockSize - 1U);
+  index = (uint32_t) (rank >> 31);
+  frac = (q31_t) (rank & 0x7FFFFFFF);
+
+  arm_quickselect_q31(pSrc, blockSize, index, &lower);
+
+  if (frac > 0)
+  {
+    /* The next element in the sorted order is the minimum of the ones after lower */
+    arm_min_q31(pSrc + index + 1U, blockSize - index - 1U, &upper, &index);
+
+    lower = (q31_t) (lower + ((((q63_t) upper - lower) * frac) >> 31));
+  }
+
+  *pResult = lower;
+}
+
+/**
+ * @} end of OrderStat group
+ */
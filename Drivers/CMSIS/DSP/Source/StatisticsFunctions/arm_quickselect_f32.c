@@ -0,0 +1,185 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_quickselect_f32.c
+ * Description:  k-th smallest element of a floating-point vector
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+#include "arm_common_tables.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @defgroup OrderStat Order Statistics
+ *
+ * Quickselect finds the k-th smallest element of a vector in O(blockSize) average time,
+ * without sorting it:
+ * <pre>
+ *     Result = sorted(pSrc)[k],   0 <= k < blockSize
+ * </pre>
+ * The vector is partitioned around the median of its first, middle and last elements, and
+ * only the partition holding index k is partitioned again, down to 16 elements or less,
+ * which are sorted with the network of arm_sort_f32(). Past 2 * log2(blockSize) partitioning
+ * levels, the remaining partition is sorted, which bounds the worst case to
+ * O(blockSize * log(blockSize)).
+ *
+ * \par
+ * The vector is reordered in place. On return, <code>pSrc[k]</code> holds the result, the
+ * elements before it are less than or equal to it, and the elements after it are greater
+ * than or equal to it.
+ *
+ * \par
+ * The percentile interpolates linearly between the two closest ranks, as the default of
+ * numpy.percentile():
+ * <pre>
+ *     rank   = p * (blockSize - 1),   0 <= p <= 1
+ *     Result = x[floor(rank)] + (rank - floor(rank)) * (x[floor(rank) + 1] - x[floor(rank)])
+ * </pre>
+ * where x is the sorted vector. It selects x[floor(rank)] with quickselect, then takes
+ * x[floor(rank) + 1] as the minimum of the elements after it.
+ * The median is the percentile at p = 0.5.
+ *
+ * \par
+ * Functions exist for floating-point, Q31 and Q15 data types.
+ */
+
+/**
+ * @addtogroup OrderStat
+ * @{
+ */
+
+/* Compare-exchange: a <= b afterwards */
+#define ARM_SELECT_CE_F32(a, b)                                 \
+  do                                                            \
+  {                                                             \
+    float32_t lo_ = ((a) < (b)) ? (a) : (b);                    \
+    (b) = ((a) < (b)) ? (b) : (a);                              \
+    (a) = lo_;                                                  \
+  } while (0)
+
+/*
+ * Partitions around the median of the first, middle and last elements.
+ * Returns the size of the left partition: pSrc[0 .. n-1] <= pivot <= pSrc[n .. blockSize-1],
+ * both partitions not empty.
+ */
+static uint32_t arm_select_partition_f32(
+  float32_t * pSrc,
+  uint32_t blockSize)
+{
+  float32_t pivot, in;                           /* pivot and swapped element */
+  uint32_t mid = blockSize >> 1U;                /* middle element */
+  uint32_t i = 0U;                               /* left index */
+  uint32_t j = blockSize - 1U;                   /* right index */
+
+  ARM_SELECT_CE_F32(pSrc[0], pSrc[mid]);
+  ARM_SELECT_CE_F32(pSrc[mid], pSrc[j]);
+  ARM_SELECT_CE_F32(pSrc[0], pSrc[mid]);
+  pivot = pSrc[mid];
+
+  /* The first and last elements stop the scans */
+  while (1)
+  {
+    do
+    {
+      i++;
+    } while (pSrc[i] < pivot);
+
+    do
+    {
+      j--;
+    } while (pivot < pSrc[j]);
+
+    if (i >= j)
+    {
+      break;
+    }
+
+    in = pSrc[i];
+    pSrc[i] = pSrc[j];
+    pSrc[j] = in;
+  }
+
+  return (i);
+}
+
+/**
+ * @brief  Finds the k-th smallest element of a floating-point vector.
+ * @param[in,out] *pSrc     points to the input vector, reordered.
+ * @param[in]     blockSize length of the input vector.
+ * @param[in]     k         rank of the element, 0 for the minimum, less than blockSize.
+ * @param[out]    *pResult  k-th smallest element.
+ * @return none.
+ */
+
+void arm_quickselect_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  uint32_t k,
+  float32_t * pResult)
+{
+  uint32_t depth = 0U;                           /* partitioning levels before sorting */
+  uint32_t left;                                 /* size of the left partition */
+  uint32_t n = blockSize;
+
+  /* 2 * log2(blockSize) */
+  while (n > 1U)
+  {
+    depth += 2U;
+    n >>= 1U;
+  }
+
+  while (blockSize > ARM_SORT_NETWORK_SIZE)
+  {
+    if (depth == 0U)
+    {
+      break;
+    }
+
+    depth--;
+    left = arm_select_partition_f32(pSrc, blockSize);
+
+    /* Keeps the partition holding index k */
+    if (k < left)
+    {
+      blockSize = left;
+    }
+    else
+    {
+      pSrc += left;
+      blockSize -= left;
+      k -= left;
+    }
+  }
+
+  arm_sort_f32(pSrc, blockSize);
+
+  *pResult = pSrc[k];
+}
+
+/**
+ * @} end of OrderStat group
+ */
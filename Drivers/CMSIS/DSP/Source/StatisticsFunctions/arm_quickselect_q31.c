@@ -0,0 +1,151 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_quickselect_q31.c
+ * Description:  k-th smallest element of a Q31 vector
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+#include "arm_common_tables.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup OrderStat
+ * @{
+ */
+
+/* Compare-exchange: a <= b afterwards */
+#define ARM_SELECT_CE_Q31(a, b)                                 \
+  do                                                            \
+  {                                                             \
+    q31_t lo_ = ((a) < (b)) ? (a) : (b);                        \
+    (b) = ((a) < (b)) ? (b) : (a);                              \
+    (a) = lo_;                                                  \
+  } while (0)
+
+/*
+ * Partitions around the median of the first, middle and last elements.
+ * Returns the size of the left partition: pSrc[0 .. n-1] <= pivot <= pSrc[n .. blockSize-1],
+ * both partitions not empty.
+ */
+static uint32_t arm_select_partition_q31(
+  q31_t * pSrc,
+  uint32_t blockSize)
+{
+  q31_t pivot, in;                           /* pivot and swapped element */
+  uint32_t mid = blockSize >> 1U;                /* middle element */
+  uint32_t i = 0U;                               /* left index */
+  uint32_t j = blockSize - 1U;                   /* right index */
+
+  ARM_SELECT_CE_Q31(pSrc[0], pSrc[mid]);
+  ARM_SELECT_CE_Q31(pSrc[mid], pSrc[j]);
+  ARM_SELECT_CE_Q31(pSrc[0], pSrc[mid]);
+  pivot = pSrc[mid];
+
+  /* The first and last elements stop the scans */
+  while (1)
+  {
+    do
+    {
+      i++;
+    } while (pSrc[i] < pivot);
+
+    do
+    {
+      j--;
+    } while (pivot < pSrc[j]);
+
+    if (i >= j)
+    {
+      break;
+    }
+
+    in = pSrc[i];
+    pSrc[i] = pSrc[j];
+    pSrc[j] = in;
+  }
+
+  return (i);
+}
+
+/**
+ * @brief  Finds the k-th smallest element of a Q31 vector.
+ * @param[in,out] *pSrc     points to the input vector, reordered.
+ * @param[in]     blockSize length of the input vector.
+ * @param[in]     k         rank of the element, 0 for the minimum, less than blockSize.
+ * @param[out]    *pResult  k-th smallest element.
+ * @return none.
+ */
+
+void arm_quickselect_q31(
+  q31_t * pSrc,
+  uint32_t blockSize,
+  uint32_t k,
+  q31_t * pResult)
+{
+  uint32_t depth = 0U;                           /* partitioning levels before sorting */
+  uint32_t left;                                 /* size of the left partition */
+  uint32_t n = blockSize;
+
+  /* 2 * log2(blockSize) */
+  while (n > 1U)
+  {
+    depth += 2U;
+    n >>= 1U;
+  }
+
+  while (blockSize > ARM_SORT_NETWORK_SIZE)
+  {
+    if (depth == 0U)
+    {
+      break;
+    }
+
+    depth--;
+    left = arm_select_partition_q31(pSrc, blockSize);
+
+    /* Keeps the partition holding index k */
+    if (k < left)
+    {
+      blockSize = left;
+    }
+    else
+    {
+      pSrc += left;
+      blockSize -= left;
+      k -= left;
+    }
+  }
+
+  arm_sort_q31(pSrc, blockSize);
+
+  *pResult = pSrc[k];
+}
+
+/**
+ * @} end of OrderStat group
+ */
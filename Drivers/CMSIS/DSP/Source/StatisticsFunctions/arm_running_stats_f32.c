@@ -0,0 +1,268 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_running_stats_f32.c
+ * Description:  Adds a block of samples to floating-point running statistics
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @defgroup RunningStats Running Statistics
+ *
+ * Mean, variance, standard deviation, RMS value, skewness, kurtosis, minimum
+ * and maximum of a stream of samples, updated block after block. The samples
+ * are read once, and do not need to be kept: an instance holds the number of
+ * samples seen, their mean, the sums of the 2nd to 4th powers of their deviations
+ * from the mean, and their extremes.
+ *
+ * Each block is reduced in a single pass to the power sums of its deviations from
+ * the running mean, which vectorize like a dot product. The block moments are then
+ * combined with the running ones by the pairwise update of Chan et al., extended to
+ * the 3rd and 4th moments by Pebay:
+ *
+ * <pre>
+ *     n = nA + nB,  delta = meanB - meanA
+ *     mean = meanA + delta * nB / n
+ *     M2   = M2A + M2B + delta^2 * nA * nB / n
+ *     M3   = M3A + M3B + delta^3 * nA * nB * (nA - nB) / n^2 + 3 * delta * (nA * M2B - nB * M2A) / n
+ *     M4   = M4A + M4B + delta^4 * nA * nB * (nA^2 - nA * nB + nB^2) / n^3
+ *                      + 6 * delta^2 * (nA^2 * M2B + nB^2 * M2A) / n^2 + 4 * delta * (nA * M3B - nB * M3A) / n
+ * </pre>
+ *
+ * The same update merges the statistics of separate streams with arm_running_stats_merge_f32():
+ * chunks of a buffer, processed by different tasks or devices, give the statistics of the whole
+ * buffer, without the loss of precision of the sums of squares.
+ *
+ * \par Initialization
+ * arm_running_stats_init_f32() clears an instance. The <code>count</code>, <code>mean</code>,
+ * <code>min</code> and <code>max</code> members can be read directly; <code>min</code> and
+ * <code>max</code> are only meaningful once <code>count</code> is not zero.
+ */
+
+/**
+ * @addtogroup RunningStats
+ * @{
+ */
+
+/**
+ * @brief Adds a block of samples to floating-point running statistics.
+ * @param[in,out] *S         points to an instance of the running statistics structure.
+ * @param[in]     *pSrc      points to the block of samples.
+ * @param[in]     blockSize  number of samples in the block.
+ * @return none.
+ *
+ * \par
+ * The deviations are taken from the running mean, or from the first sample of the first block,
+ * so that the power sums of the block stay small and the moments about the block mean are
+ * derived from them without cancellation.
+ */
+
+void arm_running_stats_f32(
+  arm_running_stats_instance_f32 * S,
+  float32_t * pSrc,
+  uint32_t blockSize)
+{
+  arm_running_stats_instance_f32 blk;            /* Statistics of the block */
+  float32_t *pIn = pSrc;                         /* Input pointer */
+  float32_t shift;                               /* Origin of the deviations */
+  float32_t s1 = 0.0f, s2 = 0.0f;                /* Sums of the deviations and of their squares */
+  float32_t s3 = 0.0f, s4 = 0.0f;                /* Sums of their 3rd and 4th powers */
+  float32_t minVal, maxVal;                      /* Extremes of the block */
+  float32_t in, d, d2, mu;                       /* Temporary variables */
+  uint32_t blkCnt;                               /* Loop counter */
+
+  if (blockSize == 0U)
+  {
+    return;
+  }
+
+  shift = (S->count > 0U) ? S->mean : pSrc[0];
+  minVal = pSrc[0];
+  maxVal = pSrc[0];
+
+#if defined (ARM_MATH_SSE4)
+  /* Run the below code for x86 hosts */
+  {
+    __m128 vShift = _mm_set1_ps(shift);
+    __m128 vs1 = _mm_setzero_ps(), vs2 = _mm_setzero_ps();
+    __m128 vs3 = _mm_setzero_ps(), vs4 = _mm_setzero_ps();
+    __m128 vMin = _mm_set1_ps(minVal), vMax = _mm_set1_ps(maxVal);
+    __m128 vIn, vd, vd2;
+    float32_t lanes[4];
+
+    blkCnt = blockSize >> 2U;
+
+    while (blkCnt > 0U)
+    {
+      vIn = _mm_loadu_ps(pIn);
+      pIn += 4;
+
+      vMin = _mm_min_ps(vMin, vIn);
+      vMax = _mm_max_ps(vMax, vIn);
+
+      vd = _mm_sub_ps(vIn, vShift);
+      vd2 = _mm_mul_ps(vd, vd);
+      vs1 = _mm_add_ps(vs1, vd);
+      vs2 = _mm_add_ps(vs2, vd2);
+      vs3 = _mm_add_ps(vs3, _mm_mul_ps(vd2, vd));
+      vs4 = _mm_add_ps(vs4, _mm_mul_ps(vd2, vd2));
+
+      blkCnt--;
+    }
+
+    /* Fold the lanes */
+    _mm_storeu_ps(lanes, vs1);
+    s1 = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm_storeu_ps(lanes, vs2);
+    s2 = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm_storeu_ps(lanes, vs3);
+    s3 = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm_storeu_ps(lanes, vs4);
+    s4 = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+    vMin = _mm_min_ps(vMin, _mm_movehl_ps(vMin, vMin));
+    vMin = _mm_min_ss(vMin, _mm_shuffle_ps(vMin, vMin, _MM_SHUFFLE(1, 1, 1, 1)));
+    minVal = _mm_cvtss_f32(vMin);
+    vMax = _mm_max_ps(vMax, _mm_movehl_ps(vMax, vMax));
+    vMax = _mm_max_ss(vMax, _mm_shuffle_ps(vMax, vMax, _MM_SHUFFLE(1, 1, 1, 1)));
+    maxVal = _mm_cvtss_f32(vMax);
+  }
+
+  blkCnt = blockSize % 0x4U;
+
+#elif defined (ARM_MATH_DSP)
+  /* Run the below code for Cortex-M4 and Cortex-M7 */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2U;
+
+  /* First part of the processing with loop unrolling.  Compute 4 samples at a time.
+  ** a second loop below computes the remaining 1 to 3 samples. */
+  while (blkCnt > 0U)
+  {
+    in = *pIn++;
+    minVal = (in < minVal) ? in : minVal;
+    maxVal = (in > maxVal) ? in : maxVal;
+    d = in - shift;
+    d2 = d * d;
+    s1 += d;
+    s2 += d2;
+    s3 += d2 * d;
+    s4 += d2 * d2;
+
+    in = *pIn++;
+    minVal = (in < minVal) ? in : minVal;
+    maxVal = (in > maxVal) ? in : maxVal;
+    d = in - shift;
+    d2 = d * d;
+    s1 += d;
+    s2 += d2;
+    s3 += d2 * d;
+    s4 += d2 * d2;
+
+    in = *pIn++;
+    minVal = (in < minVal) ? in : minVal;
+    maxVal = (in > maxVal) ? in : maxVal;
+    d = in - shift;
+    d2 = d * d;
+    s1 += d;
+    s2 += d2;
+    s3 += d2 * d;
+    s4 += d2 * d2;
+
+    in = *pIn++;
+    minVal = (in < minVal) ? in : minVal;
+    maxVal = (in > maxVal) ? in : maxVal;
+    d = in - shift;
+    d2 = d * d;
+    s1 += d;
+    s2 += d2;
+    s3 += d2 * d;
+    s4 += d2 * d2;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* If the blockSize is not a multiple of 4, compute any remaining samples here.
+  ** No loop unrolling is used. */
+  blkCnt = blockSize % 0x4U;
+
+#else
+  /* Run the below code for Cortex-M0 or Cortex-M3 */
+
+  /* Loop over blockSize number of values */
+  blkCnt = blockSize;
+
+#endif
+
+  while (blkCnt > 0U)
+  {
+    in = *pIn++;
+    minVal = (in < minVal) ? in : minVal;
+    maxVal = (in > maxVal) ? in : maxVal;
+    d = in - shift;
+    d2 = d * d;
+    s1 += d;
+    s2 += d2;
+    s3 += d2 * d;
+    s4 += d2 * d2;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* Moments of the block about its own mean, shift + mu */
+  mu = s1 / (float32_t) blockSize;
+
+  blk.count = blockSize;
+  blk.mean = shift + mu;
+  blk.m2 = s2 - (s1 * mu);
+  blk.m3 = s3 - (mu * ((3.0f * s2) - (2.0f * mu * s1)));
+  blk.m4 = s4 - (mu * ((4.0f * s3) - (mu * ((6.0f * s2) - (3.0f * mu * s1)))));
+  blk.min = minVal;
+  blk.max = maxVal;
+
+  /* Rounding can leave a tiny negative sum of squares */
+  if (blk.m2 < 0.0f)
+  {
+    blk.m2 = 0.0f;
+  }
+
+  if (blk.m4 < 0.0f)
+  {
+    blk.m4 = 0.0f;
+  }
+
+  arm_running_stats_merge_f32(S, &blk);
+}
+
+/**
+ * @} end of RunningStats group
+ */
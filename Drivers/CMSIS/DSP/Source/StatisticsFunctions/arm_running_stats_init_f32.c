@@ -0,0 +1,58 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_running_stats_init_f32.c
+ * Description:  Initialization function for the floating-point running statistics
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup RunningStats
+ * @{
+ */
+
+/**
+ * @brief Initialization function for the floating-point running statistics.
+ * @param[in,out] *S points to an instance of the running statistics structure.
+ * @return none.
+ *
+ * \par
+ * No sample has been seen after the initialization: all the statistics are zero.
+ */
+
+void arm_running_stats_init_f32(
+  arm_running_stats_instance_f32 * S)
+{
+  /* Clear the counters and moments */
+  memset(S, 0, sizeof(arm_running_stats_instance_f32));
+}
+
+/**
+ * @} end of RunningStats group
+ */
@@ -0,0 +1,119 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_running_stats_merge_f32.c
+ * Description:  Merges two floating-point running statistics
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup RunningStats
+ * @{
+ */
+
+/**
+ * @brief Merges two floating-point running statistics.
+ * @param[in,out] *S       points to the running statistics, updated with the samples of pOther.
+ * @param[in]     *pOther  points to the running statistics of other samples.
+ * @return none.
+ *
+ * \par
+ * After the call, <code>S</code> holds the statistics of the samples of both instances, as if
+ * they had been added to a single instance. The order of the merges does not matter, up to the
+ * rounding of the floating-point operations. <code>pOther</code> is not modified.
+ */
+
+void arm_running_stats_merge_f32(
+  arm_running_stats_instance_f32 * S,
+  const arm_running_stats_instance_f32 * pOther)
+{
+  float32_t nA, nB, n;                           /* Sample counts */
+  float32_t fA, fB;                              /* Fractions of the samples in each set */
+  float32_t delta, delta2;                       /* Difference of the means and its square */
+  float32_t m2A, m2B, m3A, m3B;                  /* Moments of each set */
+
+  if (pOther->count == 0U)
+  {
+    return;
+  }
+
+  if (S->count == 0U)
+  {
+    *S = *pOther;
+    return;
+  }
+
+  nA = (float32_t) S->count;
+  nB = (float32_t) pOther->count;
+  n = nA + nB;
+  fA = nA / n;
+  fB = nB / n;
+
+  delta = pOther->mean - S->mean;
+  delta2 = delta * delta;
+
+  m2A = S->m2;
+  m2B = pOther->m2;
+  m3A = S->m3;
+  m3B = pOther->m3;
+
+  /* M4 = M4A + M4B + delta^4 nA fB (fA^2 - fA fB + fB^2) + 6 delta^2 (fA^2 M2B + fB^2 M2A)
+  **    + 4 delta (fA M3B - fB M3A) */
+  S->m4 = S->m4 + pOther->m4
+        + (delta2 * delta2 * nA * fB * ((fA * fA) - (fA * fB) + (fB * fB)))
+        + (6.0f * delta2 * ((fA * fA * m2B) + (fB * fB * m2A)))
+        + (4.0f * delta * ((fA * m3B) - (fB * m3A)));
+
+  /* M3 = M3A + M3B + delta^3 nA fB (fA - fB) + 3 delta (fA M2B - fB M2A) */
+  S->m3 = m3A + m3B
+        + (delta2 * delta * nA * fB * (fA - fB))
+        + (3.0f * delta * ((fA * m2B) - (fB * m2A)));
+
+  /* M2 = M2A + M2B + delta^2 nA fB */
+  S->m2 = m2A + m2B + (delta2 * nA * fB);
+
+  /* mean = meanA + delta fB */
+  S->mean = S->mean + (delta * fB);
+
+  S->count += pOther->count;
+
+  if (pOther->min < S->min)
+  {
+    S->min = pOther->min;
+  }
+
+  if (pOther->max > S->max)
+  {
+    S->max = pOther->max;
+  }
+}
+
+/**
+ * @} end of RunningStats group
+ */
@@ -0,0 +1,162 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_running_stats_moments_f32.c
+ * Description:  Variance, standard deviation, RMS value, skewness and kurtosis of running statistics
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup RunningStats
+ * @{
+ */
+
+/**
+ * @brief Variance of the samples of floating-point running statistics.
+ * @param[in]  *S       points to an instance of the running statistics structure.
+ * @param[out] *pResult variance value returned here.
+ * @return none.
+ *
+ * \par
+ * As arm_var_f32(): <code>M2 / (count - 1)</code>, and zero for less than 2 samples.
+ */
+
+void arm_running_stats_var_f32(
+  const arm_running_stats_instance_f32 * S,
+  float32_t * pResult)
+{
+  if (S->count <= 1U)
+  {
+    *pResult = 0.0f;
+    return;
+  }
+
+  *pResult = S->m2 / (float32_t) (S->count - 1U);
+}
+
+/**
+ * @brief Standard deviation of the samples of floating-point running statistics.
+ * @param[in]  *S       points to an instance of the running statistics structure.
+ * @param[out] *pResult standard deviation value returned here.
+ * @return none.
+ *
+ * \par
+ * As arm_std_f32(): the square root of the variance.
+ */
+
+void arm_running_stats_std_f32(
+  const arm_running_stats_instance_f32 * S,
+  float32_t * pResult)
+{
+  float32_t var;
+
+  arm_running_stats_var_f32(S, &var);
+  arm_sqrt_f32(var, pResult);
+}
+
+/**
+ * @brief Root Mean Square of the samples of floating-point running statistics.
+ * @param[in]  *S       points to an instance of the running statistics structure.
+ * @param[out] *pResult RMS value returned here.
+ * @return none.
+ *
+ * \par
+ * The mean of the squares is <code>mean^2 + M2 / count</code>, so no sum of squares is kept.
+ * The result is zero when no sample has been seen.
+ */
+
+void arm_running_stats_rms_f32(
+  const arm_running_stats_instance_f32 * S,
+  float32_t * pResult)
+{
+  if (S->count == 0U)
+  {
+    *pResult = 0.0f;
+    return;
+  }
+
+  arm_sqrt_f32((S->mean * S->mean) + (S->m2 / (float32_t) S->count), pResult);
+}
+
+/**
+ * @brief Skewness of the samples of floating-point running statistics.
+ * @param[in]  *S       points to an instance of the running statistics structure.
+ * @param[out] *pResult skewness value returned here.
+ * @return none.
+ *
+ * \par
+ * The sample skewness <code>sqrt(count) * M3 / M2^(3/2)</code>, zero when all the samples are
+ * equal.
+ */
+
+void arm_running_stats_skewness_f32(
+  const arm_running_stats_instance_f32 * S,
+  float32_t * pResult)
+{
+  float32_t rootN, rootM2;
+
+  if (S->m2 <= 0.0f)
+  {
+    *pResult = 0.0f;
+    return;
+  }
+
+  arm_sqrt_f32((float32_t) S->count, &rootN);
+  arm_sqrt_f32(S->m2, &rootM2);
+
+  *pResult = (rootN * S->m3) / (S->m2 * rootM2);
+}
+
+/**
+ * @brief Excess kurtosis of the samples of floating-point running statistics.
+ * @param[in]  *S       points to an instance of the running statistics structure.
+ * @param[out] *pResult excess kurtosis value returned here.
+ * @return none.
+ *
+ * \par
+ * The sample excess kurtosis <code>count * M4 / M2^2 - 3</code>, zero for a normal
+ * distribution, and zero when all the samples are equal.
+ */
+
+void arm_running_stats_kurtosis_f32(
+  const arm_running_stats_instance_f32 * S,
+  float32_t * pResult)
+{
+  if (S->m2 <= 0.0f)
+  {
+    *pResult = 0.0f;
+    return;
+  }
+
+  *pResult = (((float32_t) S->count * S->m4) / (S->m2 * S->m2)) - 3.0f;
+}
+
+/**
+ * @} end of RunningStats group
+ */
@@ -0,0 +1,238 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_sort_q15.c
+ * Description:  Sorts a Q15 vector in ascending order
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+#include "arm_common_tables.h"
+
+/**
+ * @ingroup groupSupport
+ */
+
+/**
+ * @addtogroup Sort
+ * @{
+ */
+
+/* Compare-exchange: a <= b afterwards */
+#define ARM_SORT_CE_Q15(a, b)                                   \
+  do                                                            \
+  {                                                             \
+    q15_t lo_ = ((a) < (b)) ? (a) : (b);                        \
+    (b) = ((a) < (b)) ? (b) : (a);                              \
+    (a) = lo_;                                                  \
+  } while (0)
+
+/*
+ * Sorts up to 16 elements with the comparators of armSortNetwork16 that stay
+ * within the block.
+ */
+static void arm_sort_network_q15(
+  q15_t * pSrc,
+  uint32_t blockSize)
+{
+  const uint8_t *pNet = armSortNetwork16;        /* comparator pointer */
+  uint32_t i, j;                                 /* comparator indexes */
+  uint32_t cnt = ARMSORTNETWORK16_TABLE_LENGTH;  /* loop counter */
+
+  while (cnt > 0U)
+  {
+    i = (uint32_t) (*pNet >> 4U);
+    j = (uint32_t) (*pNet++ & 0xFU);
+
+    if (j < blockSize)
+    {
+      ARM_SORT_CE_Q15(pSrc[i], pSrc[j]);
+    }
+
+    cnt--;
+  }
+}
+
+/* Heapsort, the fallback of unbalanced partitions */
+static void arm_sort_heap_q15(
+  q15_t * pSrc,
+  uint32_t blockSize)
+{
+  q15_t in;                                  /* element being sifted down */
+  uint32_t start = blockSize >> 1U;              /* first node to heapify */
+  uint32_t end = blockSize;                      /* end of the heap */
+  uint32_t root, child;                          /* heap indexes */
+
+  while (end > 1U)
+  {
+    if (start > 0U)
+    {
+      /* Builds the max-heap */
+      start--;
+      root = start;
+    }
+    else
+    {
+      /* Moves the largest element to the end of the heap */
+      end--;
+      in = pSrc[end];
+      pSrc[end] = pSrc[0];
+      pSrc[0] = in;
+      root = 0U;
+    }
+
+    in = pSrc[root];
+    child = 2U * root + 1U;
+
+    while (child < end)
+    {
+      if ((child + 1U < end) && (pSrc[child] < pSrc[child + 1U]))
+      {
+        child++;
+      }
+
+      if (!(in < pSrc[child]))
+      {
+        break;
+      }
+
+      pSrc[root] = pSrc[child];
+      root = child;
+      child = 2U * root + 1U;
+    }
+
+    pSrc[root] = in;
+  }
+}
+
+/*
+ * Partitions around the median of the first, middle and last elements.
+ * Returns the size of the left partition: pSrc[0 .. n-1] <= pivot <= pSrc[n .. blockSize-1],
+ * both partitions not empty.
+ */
+static uint32_t arm_sort_partition_q15(
+  q15_t * pSrc,
+  uint32_t blockSize)
+{
+  q15_t pivot, in;                           /* pivot and swapped element */
+  uint32_t mid = blockSize >> 1U;                /* middle element */
+  uint32_t i = 0U;                               /* left index */
+  uint32_t j = blockSize - 1U;                   /* right index */
+
+  ARM_SORT_CE_Q15(pSrc[0], pSrc[mid]);
+  ARM_SORT_CE_Q15(pSrc[mid], pSrc[j]);
+  ARM_SORT_CE_Q15(pSrc[0], pSrc[mid]);
+  pivot = pSrc[mid];
+
+  /* The first and last elements stop the scans */
+  while (1)
+  {
+    do
+    {
+      i++;
+    } while (pSrc[i] < pivot);
+
+    do
+    {
+      j--;
+    } while (pivot < pSrc[j]);
+
+    if (i >= j)
+    {
+      break;
+    }
+
+    in = pSrc[i];
+    pSrc[i] = pSrc[j];
+    pSrc[j] = in;
+  }
+
+  return (i);
+}
+
+/* Quicksort down to the network, heapsort past depth partitioning levels */
+static void arm_sort_intro_q15(
+  q15_t * pSrc,
+  uint32_t blockSize,
+  uint32_t depth)
+{
+  uint32_t left;                                 /* size of the left partition */
+
+  while (blockSize > ARM_SORT_NETWORK_SIZE)
+  {
+    if (depth == 0U)
+    {
+      arm_sort_heap_q15(pSrc, blockSize);
+      return;
+    }
+
+    depth--;
+    left = arm_sort_partition_q15(pSrc, blockSize);
+
+    /* Recursion on the smaller partition, iteration on the larger one */
+    if (left < blockSize - left)
+    {
+      arm_sort_intro_q15(pSrc, left, depth);
+      pSrc += left;
+      blockSize -= left;
+    }
+    else
+    {
+      arm_sort_intro_q15(pSrc + left, blockSize - left, depth);
+      blockSize = left;
+    }
+  }
+
+  if (blockSize > 1U)
+  {
+    arm_sort_network_q15(pSrc, blockSize);
+  }
+}
+
+/**
+ * @brief Sorts the elements of a Q15 vector in ascending order.
+ * @param[in,out] *pSrc     points to the vector, sorted in place.
+ * @param[in]     blockSize number of elements in the vector.
+ * @return none.
+ */
+
+void arm_sort_q15(
+  q15_t * pSrc,
+  uint32_t blockSize)
+{
+  uint32_t depth = 0U;                           /* partitioning levels before heapsort */
+  uint32_t n = blockSize;
+
+  /* 2 * log2(blockSize) */
+  while (n > 1U)
+  {
+    depth += 2U;
+    n >>= 1U;
+  }
+
+  arm_sort_intro_q15(pSrc, blockSize, depth);
+}
+
+/**
+ * @} end of Sort group
+ */
@@ -228,3 +228,72 @@ uint16_t * pBitRevTab)
       pBitRevTab += bitRevFactor;
    }
 }
+
+#if defined (ARM_MATH_HOST_X86)
+
+/*
+* @brief  In-place bit reversal of arm_cfft_f32() and arm_cfft_q31(), C version of arm_bitreversal2.S for x86 hosts.
+* @param[in, out] *pSrc        points to the in-place buffer of 32-bit data type.
+* @param[in]      bitRevLen    length of the bit reversal table.
+* @param[in]      *pBitRevTab  points to the bit reversal table, pairs of byte offsets of the values to swap.
+* @return none.
+*/
+
+void arm_bitreversal_32(
+uint32_t * pSrc,
+const uint16_t bitRevLen,
+const uint16_t * pBitRevTab)
+{
+   uint32_t a, b, i, in;
+
+   for (i = 0U; (i + 1U) < bitRevLen; i += 2U)
+   {
+      a = pBitRevTab[i] >> 2U;
+      b = pBitRevTab[i + 1U] >> 2U;
+
+      /*  pSrc[a] <-> pSrc[b]; */
+      in = pSrc[a];
+      pSrc[a] = pSrc[b];
+      pSrc[b] = in;
+
+      /*  pSrc[a+1U] <-> pSrc[b+1U] */
+      in = pSrc[a + 1U];
+      pSrc[a + 1U] = pSrc[b + 1U];
+      pSrc[b + 1U] = in;
+   }
+}
+
+/*
+* @brief  In-place bit reversal of arm_cfft_q15(), C version of arm_bitreversal2.S for x86 hosts.
+* @param[in, out] *pSrc        points to the in-place buffer of 16-bit data type.
+* @param[in]      bitRevLen    length of the bit reversal table.
+* @param[in]      *pBitRevTab  points to the bit reversal table, pairs of byte offsets of the 32-bit values.
+* @return none.
+*/
+
+void arm_bitreversal_16(
+uint16_t * pSrc,
+const uint16_t bitRevLen,
+const uint16_t * pBitRevTab)
+{
+   uint32_t a, b, i;
+   uint16_t in;
+
+   for (i = 0U; (i + 1U) < bitRevLen; i += 2U)
+   {
+      a = pBitRevTab[i] >> 2U;
+      b = pBitRevTab[i + 1U] >> 2U;
+
+      /*  pSrc[a] <-> pSrc[b]; */
+      in = pSrc[a];
+      pSrc[a] = pSrc[b];
+      pSrc[b] = in;
+
+      /*  pSrc[a+1U] <-> pSrc[b+1U] */
+      in = pSrc[a + 1U];
+      pSrc[a + 1U] = pSrc[b + 1U];
+      pSrc[b + 1U] = in;
+   }
+}
+
+#endif /* #if defined (ARM_MATH_HOST_X86) */
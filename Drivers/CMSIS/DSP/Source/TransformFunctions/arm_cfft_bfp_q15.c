@@ -0,0 +1,796 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_cfft_bfp_q15.c
+ * Description:  Block floating-point Q15 complex FFT
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+extern void arm_bitreversal_16(
+    uint16_t * pSrc,
+    const uint16_t bitRevLen,
+    const uint16_t * pBitRevTable);
+
+/**
+ * @brief  Squared modulus of a complex sample.
+ * @param[in]  re  real part.
+ * @param[in]  im  imaginary part.
+ * @return re^2 + im^2, which fits in 32 bits for any Q15 sample.
+ */
+CMSIS_INLINE __STATIC_INLINE uint32_t arm_cfft_bfp_energy_q15(
+  q31_t re,
+  q31_t im)
+{
+  return ((uint32_t) (re * re) + (uint32_t) (im * im));
+}
+
+/**
+ * @brief  Right shift that leaves guardBits of headroom for a block.
+ * @param[in]  energy     OR of re^2 + im^2 over the block.
+ * @param[in]  guardBits  growth of the next stage in bits.
+ * @return shift to apply to the block, negative when it could be scaled up.
+ *
+ * \par
+ * The leading zeros of the OR bound the largest squared modulus, so that
+ * every modulus is below 2^((33 - clz) / 2). A
+ * radix-4 output is a sum of 4 rotated inputs, so that its modulus is below 4
+ * times the largest input one, and 2 guard bits keep its real and imaginary
+ * parts in Q15 whatever the twiddles. A radix-2 stage needs 1 guard bit.
+ */
+CMSIS_INLINE __STATIC_INLINE int32_t arm_cfft_bfp_shift_q15(
+  uint32_t energy,
+  int32_t guardBits)
+{
+  return ((((int32_t) 33 - (int32_t) __CLZ(energy)) >> 1) + guardBits - 15);
+}
+
+#if defined (ARM_MATH_DSP)
+
+/**
+ * @brief  Radix-4 butterfly on packed samples, without the twiddles.
+ * @param[in]  A      input a, packed real and imaginary parts.
+ * @param[in]  B      input b.
+ * @param[in]  C      input c.
+ * @param[in]  D      input d.
+ * @param[out] *pOut  a+b+c+d, a-b+c-d, a-jb-c+jd and a+jb-c-jd.
+ * @param[in]  shift  right shift of the outputs, from 0 to 3.
+ * @return none.
+ *
+ * \par
+ * The shift is spread over the halving additions of the two levels of the
+ * butterfly, and a shift of 3 also halves the inputs. shift is a constant
+ * where the function is inlined, so that it only selects the instructions.
+ */
+CMSIS_INLINE __STATIC_INLINE void arm_cfft_bfp_bfly4_q15(
+  q31_t A,
+  q31_t B,
+  q31_t C,
+  q31_t D,
+  q31_t * pOut,
+  const uint32_t shift)
+{
+  q31_t R, S, T, U;
+
+  if (shift > 2U)
+  {
+    A = __SHADD16(A, 0);
+    B = __SHADD16(B, 0);
+    C = __SHADD16(C, 0);
+    D = __SHADD16(D, 0);
+  }
+
+  /* R = a + c, S = a - c, T = b + d, U = b - d */
+  if (shift > 1U)
+  {
+    R = __SHADD16(A, C);
+    S = __SHSUB16(A, C);
+    T = __SHADD16(B, D);
+    U = __SHSUB16(B, D);
+  }
+  else
+  {
+    R = __QADD16(A, C);
+    S = __QSUB16(A, C);
+    T = __QADD16(B, D);
+    U = __QSUB16(B, D);
+  }
+
+  if (shift > 0U)
+  {
+    pOut[0] = __SHADD16(R, T);
+    pOut[1] = __SHSUB16(R, T);
+
+#ifndef ARM_MATH_BIG_ENDIAN
+    pOut[2] = __SHSAX(S, U);
+    pOut[3] = __SHASX(S, U);
+#else
+    pOut[2] = __SHASX(S, U);
+    pOut[3] = __SHSAX(S, U);
+#endif /*      #ifndef ARM_MATH_BIG_ENDIAN     */
+
+  }
+  else
+  {
+    pOut[0] = __QADD16(R, T);
+    pOut[1] = __QSUB16(R, T);
+
+#ifndef ARM_MATH_BIG_ENDIAN
+    pOut[2] = __QSAX(S, U);
+    pOut[3] = __QASX(S, U);
+#else
+    pOut[2] = __QASX(S, U);
+    pOut[3] = __QSAX(S, U);
+#endif /*      #ifndef ARM_MATH_BIG_ENDIAN     */
+
+  }
+}
+
+/**
+ * @brief  Product of a packed sample by a twiddle, rounded to Q15.
+ * @param[in]  X  sample, packed real and imaginary parts.
+ * @param[in]  W  twiddle, packed cosine and sine.
+ * @return X * (cos - j sin), packed.
+ */
+CMSIS_INLINE __STATIC_INLINE q31_t arm_cfft_bfp_rot_q15(
+  q31_t X,
+  q31_t W)
+{
+  q31_t re, im;
+
+  /* re = x * cos + y * sin, im = y * cos - x * sin, plus half an LSB */
+  re = __SMLAD(W, X, 0x4000);
+
+#ifndef ARM_MATH_BIG_ENDIAN
+  im = __SMLSDX(W, X, 0x4000);
+
+  /* The saturating doubling leaves the Q15 results in the top halves */
+  return (__PKHTB(__QADD(im, im), __QADD(re, re), 16));
+#else
+  im = __SMLSDX(X, W, 0x4000);
+
+  return (__PKHTB(__QADD(re, re), __QADD(im, im), 16));
+#endif /*      #ifndef ARM_MATH_BIG_ENDIAN     */
+}
+
+/**
+ * @brief  Radix-2 stage on packed samples, for a constant shift.
+ * @param[in, out] *pSrc    points to the complex data.
+ * @param[in]      fftLen   length of the FFT.
+ * @param[in]      *pCoef   points to the twiddle table of fftLen.
+ * @param[in]      shift    right shift of the outputs, from 0 to 2.
+ * @return OR of re^2 + im^2 over the outputs.
+ */
+CMSIS_INLINE __STATIC_INLINE uint32_t arm_cfft_bfp_radix2_dsp_q15(
+  q15_t * pSrc,
+  uint32_t fftLen,
+  const q15_t * pCoef,
+  const uint32_t shift)
+{
+  q31_t A, B, out1, out2;
+  q15_t *pSi0 = pSrc;                            /* Upper half pointer */
+  q15_t *pSi1 = pSrc + fftLen;                   /* Lower half pointer */
+  uint32_t i, n2;
+  uint32_t peak = 0U;
+
+  n2 = fftLen >> 1U;
+
+  for (i = 0U; i < n2; i++)
+  {
+    A = _SIMD32_OFFSET(pSi0);
+    B = _SIMD32_OFFSET(pSi1);
+
+    if (shift > 1U)
+    {
+      A = __SHADD16(A, 0);
+      B = __SHADD16(B, 0);
+    }
+
+    /* a' = a + b, b' = (a - b) * W */
+    if (shift > 0U)
+    {
+      out1 = __SHADD16(A, B);
+      out2 = __SHSUB16(A, B);
+    }
+    else
+    {
+      out1 = __QADD16(A, B);
+      out2 = __QSUB16(A, B);
+    }
+
+    out2 = arm_cfft_bfp_rot_q15(out2, _SIMD32_OFFSET(pCoef + (2U * i)));
+
+    _SIMD32_OFFSET(pSi0) = out1;
+    pSi0 += 2;
+    _SIMD32_OFFSET(pSi1) = out2;
+    pSi1 += 2;
+
+    peak |= __SMUAD(out1, out1) | __SMUAD(out2, out2);
+  }
+
+  return (peak);
+}
+
+/**
+ * @brief  Radix-4 stage on packed samples, for a constant shift.
+ * @param[in, out] *pSrc             points to the complex data.
+ * @param[in]      fftLen            length of the sub-transform.
+ * @param[in]      n1                span of the butterflies of the stage.
+ * @param[in]      *pCoef            points to the twiddle table.
+ * @param[in]      twidCoefModifier  twiddle step for the sub-transform length.
+ * @param[in]      shift             right shift of the outputs, from 0 to 3.
+ * @return OR of re^2 + im^2 over the outputs.
+ */
+CMSIS_INLINE __STATIC_INLINE uint32_t arm_cfft_bfp_radix4_dsp_q15(
+  q15_t * pSrc,
+  uint32_t fftLen,
+  uint32_t n1,
+  const q15_t * pCoef,
+  uint32_t twidCoefModifier,
+  const uint32_t shift)
+{
+  q31_t C1, C2, C3, out[4];
+  q15_t *pSi0;                                   /* Butterfly pointer */
+  uint32_t n2, ic, i0, j;
+  uint32_t peak = 0U;
+
+  n2 = n1 >> 2U;
+  ic = 0U;
+
+  for (j = 0U; j < n2; j++)
+  {
+    C1 = _SIMD32_OFFSET(pCoef + (2U * ic));
+    C2 = _SIMD32_OFFSET(pCoef + (4U * ic));
+    C3 = _SIMD32_OFFSET(pCoef + (6U * ic));
+
+    ic = ic + twidCoefModifier;
+
+    pSi0 = pSrc + (2U * j);
+
+    for (i0 = j; i0 < fftLen; i0 += n1)
+    {
+      arm_cfft_bfp_bfly4_q15(_SIMD32_OFFSET(pSi0),
+                             _SIMD32_OFFSET(pSi0 + (2U * n2)),
+                             _SIMD32_OFFSET(pSi0 + (4U * n2)),
+                             _SIMD32_OFFSET(pSi0 + (6U * n2)),
+                             out, shift);
+
+      /* (a - b + c - d) * W2 at i1, (a - jb - c + jd) * W1 at i2, (a + jb - c - jd) * W3 at i3 */
+      out[1] = arm_cfft_bfp_rot_q15(out[1], C2);
+      out[2] = arm_cfft_bfp_rot_q15(out[2], C1);
+      out[3] = arm_cfft_bfp_rot_q15(out[3], C3);
+
+      _SIMD32_OFFSET(pSi0) = out[0];
+      _SIMD32_OFFSET(pSi0 + (2U * n2)) = out[1];
+      _SIMD32_OFFSET(pSi0 + (4U * n2)) = out[2];
+      _SIMD32_OFFSET(pSi0 + (6U * n2)) = out[3];
+      pSi0 += 2U * n1;
+
+      peak |= __SMUAD(out[0], out[0]) | __SMUAD(out[1], out[1]) |
+              __SMUAD(out[2], out[2]) | __SMUAD(out[3], out[3]);
+    }
+  }
+
+  return (peak);
+}
+
+/**
+ * @brief  Last radix-4 stage on packed samples, for a constant shift.
+ * @param[in, out] *pSrc      points to the complex data.
+ * @param[in]      fftLen     length of the sub-transform.
+ * @param[in]      shift      right shift of the outputs, from 0 to 3.
+ * @param[in]      ifftFlag   swaps the real and imaginary parts of the outputs when set.
+ * @return none.
+ */
+CMSIS_INLINE __STATIC_INLINE void arm_cfft_bfp_radix4_last_dsp_q15(
+  q15_t * pSrc,
+  uint32_t fftLen,
+  const uint32_t shift,
+  uint8_t ifftFlag)
+{
+  q31_t out[4];
+  q15_t *pIn = pSrc;                             /* Butterfly pointer */
+  uint32_t blkCnt;                               /* Loop counter */
+
+  blkCnt = fftLen >> 2U;
+
+  while (blkCnt > 0U)
+  {
+    arm_cfft_bfp_bfly4_q15(_SIMD32_OFFSET(pIn), _SIMD32_OFFSET(pIn + 2),
+                           _SIMD32_OFFSET(pIn + 4), _SIMD32_OFFSET(pIn + 6),
+                           out, shift);
+
+    if (ifftFlag != 0U)
+    {
+      out[0] = __ROR(out[0], 16);
+      out[1] = __ROR(out[1], 16);
+      out[2] = __ROR(out[2], 16);
+      out[3] = __ROR(out[3], 16);
+    }
+
+    _SIMD32_OFFSET(pIn) = out[0];
+    _SIMD32_OFFSET(pIn + 2) = out[1];
+    _SIMD32_OFFSET(pIn + 4) = out[2];
+    _SIMD32_OFFSET(pIn + 6) = out[3];
+    pIn += 8;
+
+    blkCnt--;
+  }
+}
+
+#endif /* #if defined (ARM_MATH_DSP) */
+
+/**
+ * @brief  Radix-2 decimation in frequency stage of the radix-4 by 2 lengths.
+ * @param[in, out] *pSrc      points to the complex data.
+ * @param[in]      fftLen     length of the FFT.
+ * @param[in]      *pCoef     points to the twiddle table of fftLen.
+ * @param[in]      shift      right shift of the outputs.
+ * @return OR of re^2 + im^2 over the outputs.
+ */
+static uint32_t arm_cfft_bfp_radix2_q15(
+  q15_t * pSrc,
+  uint32_t fftLen,
+  const q15_t * pCoef,
+  uint32_t shift)
+{
+  uint32_t peak;
+
+#if defined (ARM_MATH_DSP)
+
+  /* Run the below code for Cortex-M4 and Cortex-M7 */
+
+  /* One loop per shift, which then selects instructions instead of branches */
+  switch (shift)
+  {
+  case 0U:
+    peak = arm_cfft_bfp_radix2_dsp_q15(pSrc, fftLen, pCoef, 0U);
+    break;
+
+  case 1U:
+    peak = arm_cfft_bfp_radix2_dsp_q15(pSrc, fftLen, pCoef, 1U);
+    break;
+
+  default:
+    peak = arm_cfft_bfp_radix2_dsp_q15(pSrc, fftLen, pCoef, 2U);
+    break;
+  }
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  q31_t xt, yt, cosVal, sinVal, out1, out2;
+  q31_t rnd = (q31_t) ((1U << shift) >> 1U);     /* Rounding of the shift */
+  uint32_t i, l, n2;
+
+  n2 = fftLen >> 1U;
+  peak = 0U;
+
+  for (i = 0U; i < n2; i++)
+  {
+    cosVal = pCoef[2U * i];
+    sinVal = pCoef[(2U * i) + 1U];
+
+    l = i + n2;
+
+    /* (xa - xb), (ya - yb), scaled before the rotation */
+    xt = ((q31_t) pSrc[2U * i] - pSrc[2U * l] + rnd) >> shift;
+    yt = ((q31_t) pSrc[(2U * i) + 1U] - pSrc[(2U * l) + 1U] + rnd) >> shift;
+
+    /* xa' = xa + xb, ya' = ya + yb */
+    out1 = __SSAT(((q31_t) pSrc[2U * i] + pSrc[2U * l] + rnd) >> shift, 16);
+    out2 = __SSAT(((q31_t) pSrc[(2U * i) + 1U] + pSrc[(2U * l) + 1U] + rnd) >> shift, 16);
+    pSrc[2U * i] = (q15_t) out1;
+    pSrc[(2U * i) + 1U] = (q15_t) out2;
+    peak |= arm_cfft_bfp_energy_q15(out1, out2);
+
+    /* xb' = xt * cos + yt * sin, yb' = yt * cos - xt * sin */
+    out1 = __SSAT(((xt * cosVal) + (yt * sinVal) + 0x4000) >> 15, 16);
+    out2 = __SSAT(((yt * cosVal) - (xt * sinVal) + 0x4000) >> 15, 16);
+    pSrc[2U * l] = (q15_t) out1;
+    pSrc[(2U * l) + 1U] = (q15_t) out2;
+    peak |= arm_cfft_bfp_energy_q15(out1, out2);
+  }
+
+#endif /* #if defined (ARM_MATH_DSP) */
+
+  return (peak);
+}
+
+/**
+ * @brief  Radix-4 decimation in frequency stage, with the index order of arm_radix4_butterfly_q15().
+ * @param[in, out] *pSrc             points to the complex data.
+ * @param[in]      fftLen            length of the sub-transform.
+ * @param[in]      n1                span of the butterflies of the stage.
+ * @param[in]      *pCoef            points to the twiddle table.
+ * @param[in]      twidCoefModifier  twiddle step for the sub-transform length.
+ * @param[in]      shift             right shift of the outputs.
+ * @return OR of re^2 + im^2 over the outputs.
+ */
+static uint32_t arm_cfft_bfp_radix4_q15(
+  q15_t * pSrc,
+  uint32_t fftLen,
+  uint32_t n1,
+  const q15_t * pCoef,
+  uint32_t twidCoefModifier,
+  uint32_t shift)
+{
+  uint32_t peak;
+
+#if defined (ARM_MATH_DSP)
+
+  /* Run the below code for Cortex-M4 and Cortex-M7 */
+
+  /* One loop per shift, which then selects instructions instead of branches */
+  switch (shift)
+  {
+  case 0U:
+    peak = arm_cfft_bfp_radix4_dsp_q15(pSrc, fftLen, n1, pCoef, twidCoefModifier, 0U);
+    break;
+
+  case 1U:
+    peak = arm_cfft_bfp_radix4_dsp_q15(pSrc, fftLen, n1, pCoef, twidCoefModifier, 1U);
+    break;
+
+  case 2U:
+    peak = arm_cfft_bfp_radix4_dsp_q15(pSrc, fftLen, n1, pCoef, twidCoefModifier, 2U);
+    break;
+
+  default:
+    peak = arm_cfft_bfp_radix4_dsp_q15(pSrc, fftLen, n1, pCoef, twidCoefModifier, 3U);
+    break;
+  }
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  q31_t R0, R1, S0, S1, T0, T1, U0, U1, out1, out2;
+  q31_t Co1, Si1, Co2, Si2, Co3, Si3;
+  q31_t rnd = (q31_t) ((1U << shift) >> 1U);     /* Rounding of the shift */
+  uint32_t n2, ic, i0, i1, i2, i3, j;
+
+  n2 = n1 >> 2U;
+  ic = 0U;
+  peak = 0U;
+
+  for (j = 0U; j < n2; j++)
+  {
+    Co1 = pCoef[ic * 2U];
+    Si1 = pCoef[(ic * 2U) + 1U];
+    Co2 = pCoef[2U * (ic * 2U)];
+    Si2 = pCoef[(2U * (ic * 2U)) + 1U];
+    Co3 = pCoef[3U * (ic * 2U)];
+    Si3 = pCoef[(3U * (ic * 2U)) + 1U];
+
+    ic = ic + twidCoefModifier;
+
+    for (i0 = j; i0 < fftLen; i0 += n1)
+    {
+      i1 = i0 + n2;
+      i2 = i1 + n2;
+      i3 = i2 + n2;
+
+      /* R = a + c, S = a - c */
+      R0 = (q31_t) pSrc[i0 * 2U] + pSrc[i2 * 2U];
+      R1 = (q31_t) pSrc[(i0 * 2U) + 1U] + pSrc[(i2 * 2U) + 1U];
+      S0 = (q31_t) pSrc[i0 * 2U] - pSrc[i2 * 2U];
+      S1 = (q31_t) pSrc[(i0 * 2U) + 1U] - pSrc[(i2 * 2U) + 1U];
+
+      /* T = b + d, U = b - d */
+      T0 = (q31_t) pSrc[i1 * 2U] + pSrc[i3 * 2U];
+      T1 = (q31_t) pSrc[(i1 * 2U) + 1U] + pSrc[(i3 * 2U) + 1U];
+      U0 = (q31_t) pSrc[i1 * 2U] - pSrc[i3 * 2U];
+      U1 = (q31_t) pSrc[(i1 * 2U) + 1U] - pSrc[(i3 * 2U) + 1U];
+
+      /* xa' = xa + xb + xc + xd, ya' = ya + yb + yc + yd */
+      out1 = __SSAT((R0 + T0 + rnd) >> shift, 16);
+      out2 = __SSAT((R1 + T1 + rnd) >> shift, 16);
+      pSrc[i0 * 2U] = (q15_t) out1;
+      pSrc[(i0 * 2U) + 1U] = (q15_t) out2;
+      peak |= arm_cfft_bfp_energy_q15(out1, out2);
+
+      /* (a - b + c - d) * W2, written at i1 */
+      R0 = (R0 - T0 + rnd) >> shift;
+      R1 = (R1 - T1 + rnd) >> shift;
+      out1 = __SSAT(((Co2 * R0) + (Si2 * R1) + 0x4000) >> 15, 16);
+      out2 = __SSAT(((Co2 * R1) - (Si2 * R0) + 0x4000) >> 15, 16);
+      pSrc[i1 * 2U] = (q15_t) out1;
+      pSrc[(i1 * 2U) + 1U] = (q15_t) out2;
+      peak |= arm_cfft_bfp_energy_q15(out1, out2);
+
+      /* (a - jb - c + jd) * W1, written at i2 */
+      T0 = (S0 + U1 + rnd) >> shift;
+      T1 = (S1 - U0 + rnd) >> shift;
+      out1 = __SSAT(((Co1 * T0) + (Si1 * T1) + 0x4000) >> 15, 16);
+      out2 = __SSAT(((Co1 * T1) - (Si1 * T0) + 0x4000) >> 15, 16);
+      pSrc[i2 * 2U] = (q15_t) out1;
+      pSrc[(i2 * 2U) + 1U] = (q15_t) out2;
+      peak |= arm_cfft_bfp_energy_q15(out1, out2);
+
+      /* (a + jb - c - jd) * W3, written at i3 */
+      T0 = (S0 - U1 + rnd) >> shift;
+      T1 = (S1 + U0 + rnd) >> shift;
+      out1 = __SSAT(((Co3 * T0) + (Si3 * T1) + 0x4000) >> 15, 16);
+      out2 = __SSAT(((Co3 * T1) - (Si3 * T0) + 0x4000) >> 15, 16);
+      pSrc[i3 * 2U] = (q15_t) out1;
+      pSrc[(i3 * 2U) + 1U] = (q15_t) out2;
+      peak |= arm_cfft_bfp_energy_q15(out1, out2);
+    }
+  }
+
+#endif /* #if defined (ARM_MATH_DSP) */
+
+  return (peak);
+}
+
+/**
+ * @brief  Last radix-4 stage, where all the twiddles are 1.
+ * @param[in, out] *pSrc      points to the complex data.
+ * @param[in]      fftLen     length of the sub-transform.
+ * @param[in]      shift      right shift of the outputs.
+ * @param[in]      ifftFlag   swaps the real and imaginary parts of the outputs when set.
+ * @return none.
+ */
+static void arm_cfft_bfp_radix4_last_q15(
+  q15_t * pSrc,
+  uint32_t fftLen,
+  uint32_t shift,
+  uint8_t ifftFlag)
+{
+#if defined (ARM_MATH_DSP)
+
+  /* Run the below code for Cortex-M4 and Cortex-M7 */
+
+  /* One loop per shift, which then selects instructions instead of branches */
+  switch (shift)
+  {
+  case 0U:
+    arm_cfft_bfp_radix4_last_dsp_q15(pSrc, fftLen, 0U, ifftFlag);
+    break;
+
+  case 1U:
+    arm_cfft_bfp_radix4_last_dsp_q15(pSrc, fftLen, 1U, ifftFlag);
+    break;
+
+  case 2U:
+    arm_cfft_bfp_radix4_last_dsp_q15(pSrc, fftLen, 2U, ifftFlag);
+    break;
+
+  default:
+    arm_cfft_bfp_radix4_last_dsp_q15(pSrc, fftLen, 3U, ifftFlag);
+    break;
+  }
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  q31_t R0, R1, S0, S1, T0, T1, U0, U1;
+  q31_t rnd = (q31_t) ((1U << shift) >> 1U);     /* Rounding of the shift */
+  q15_t *pIn = pSrc;                             /* Butterfly pointer */
+  uint32_t re, im;                               /* Offsets of the outputs */
+  uint32_t blkCnt;                               /* Loop counter */
+
+  re = (ifftFlag != 0U) ? 1U : 0U;
+  im = 1U - re;
+
+  blkCnt = fftLen >> 2U;
+
+  while (blkCnt > 0U)
+  {
+    R0 = (q31_t) pIn[0] + pIn[4];
+    R1 = (q31_t) pIn[1] + pIn[5];
+    S0 = (q31_t) pIn[0] - pIn[4];
+    S1 = (q31_t) pIn[1] - pIn[5];
+
+    T0 = (q31_t) pIn[2] + pIn[6];
+    T1 = (q31_t) pIn[3] + pIn[7];
+    U0 = (q31_t) pIn[2] - pIn[6];
+    U1 = (q31_t) pIn[3] - pIn[7];
+
+    pIn[re] = (q15_t) __SSAT((R0 + T0 + rnd) >> shift, 16);
+    pIn[im] = (q15_t) __SSAT((R1 + T1 + rnd) >> shift, 16);
+    pIn[2U + re] = (q15_t) __SSAT((R0 - T0 + rnd) >> shift, 16);
+    pIn[2U + im] = (q15_t) __SSAT((R1 - T1 + rnd) >> shift, 16);
+    pIn[4U + re] = (q15_t) __SSAT((S0 + U1 + rnd) >> shift, 16);
+    pIn[4U + im] = (q15_t) __SSAT((S1 - U0 + rnd) >> shift, 16);
+    pIn[6U + re] = (q15_t) __SSAT((S0 - U1 + rnd) >> shift, 16);
+    pIn[6U + im] = (q15_t) __SSAT((S1 + U0 + rnd) >> shift, 16);
+    pIn += 8;
+
+    blkCnt--;
+  }
+
+#endif /* #if defined (ARM_MATH_DSP) */
+}
+
+/**
+ * @ingroup groupTransforms
+ */
+
+/**
+ * @addtogroup ComplexFFT
+ * @{
+ */
+
+/**
+ * @brief  Processing function for the block floating-point Q15 complex FFT.
+ * @param[in]      *S              points to an instance of the Q15 CFFT structure.
+ * @param[in, out] *p1             points to the complex data buffer of size <code>2*fftLen</code>. Processing occurs in-place.
+ * @param[in]      ifftFlag        flag that selects forward (ifftFlag=0) or inverse (ifftFlag=1) transform.
+ * @param[in]      bitReverseFlag  flag that enables (bitReverseFlag=1) or disables (bitReverseFlag=0) bit reversal of output.
+ * @param[out]     *pBlockExp      points to the block exponent of the output.
+ * @return none.
+ *
+ * \par Scaling
+ * The stages are the ones of arm_cfft_q15(), but the scaling is chosen from
+ * the data. The input is first scaled up to the largest amplitude at which the
+ * first stage cannot overflow, then each stage is shifted right only by the
+ * number of bits that it can grow beyond the headroom left in the block. The
+ * headroom is the count of leading zeros of the largest re^2 + im^2, measured
+ * on the input and then on the outputs of each stage as they are written. The
+ * products with the twiddles are accumulated in 32 bits and rounded. The
+ * inverse transform runs the forward stages on the input with its real and
+ * imaginary parts swapped, and swaps them back in the last stage.
+ *
+ * \par
+ * On cores with the DSP extension the butterflies work on packed samples, as
+ * in arm_radix4_butterfly_q15(): the shift of a stage is made by the halving
+ * additions of the butterflies, with one loop per shift, and each rotation is a
+ * <code>__SMLAD</code> and a <code>__SMLSDX</code>. The squared moduli of the
+ * outputs come from one <code>__SMUAD</code> each. Other cores shift the 32-bit
+ * sums with rounding instead, which is slightly more accurate.
+ *
+ * \par
+ * The output, multiplied by <code>2^(*pBlockExp)</code>, is the transform
+ * without any scaling, in the format of the input:
+ * <pre>
+ *     X[k] = p1[k] * 2^(*pBlockExp)
+ * </pre>
+ * for both directions. arm_cfft_q15() divides both by <code>fftLen</code>, so
+ * that its output matches this one shifted by <code>*pBlockExp - log2(fftLen)</code>.
+ * *pBlockExp is negative when the input had more headroom than the transform
+ * uses.
+ *
+ * \par
+ * The input is no longer scaled by the stages whose growth fits in its
+ * headroom, so that the error of a low-amplitude signal stays relative to the
+ * signal, while a full-scale input gets at most the shifts of arm_cfft_q15().
+ * The buffer and the tables are the same as for arm_cfft_q15(). The extra
+ * cost is one pass over the input to measure it, and the measure of each
+ * output, so that the transform is slower than arm_cfft_q15(): its benefit is
+ * the accuracy of a Q31 transform at the memory cost of a Q15 one, for inputs
+ * that do not use the full scale.
+ */
+
+void arm_cfft_bfp_q15(
+  const arm_cfft_instance_q15 * S,
+  q15_t * p1,
+  uint8_t ifftFlag,
+  uint8_t bitReverseFlag,
+  int32_t * pBlockExp)
+{
+  uint32_t L = S->fftLen;
+  uint32_t numCols;                              /* Radix-4 sub-transforms */
+  uint32_t n1, k, i;
+  uint32_t twidCoefModifier;
+  uint32_t peak;
+  int32_t shift, blockExp;
+  q31_t re, im;
+
+  switch (L)
+  {
+  case 16:
+  case 64:
+  case 256:
+  case 1024:
+  case 4096:
+    numCols = 1U;
+    break;
+
+  case 32:
+  case 128:
+  case 512:
+  case 2048:
+    numCols = 2U;
+    break;
+
+  default:
+    *pBlockExp = 0;
+    return;
+  }
+
+  /* Headroom of the input. The inverse transform is the forward one of the
+     input with its real and imaginary parts swapped, swapped back by the last
+     stage */
+  peak = 0U;
+  for (i = 0U; i < L; i++)
+  {
+    re = p1[2U * i];
+    im = p1[(2U * i) + 1U];
+    peak |= arm_cfft_bfp_energy_q15(re, im);
+
+    if (ifftFlag != 0U)
+    {
+      p1[2U * i] = (q15_t) im;
+      p1[(2U * i) + 1U] = (q15_t) re;
+    }
+  }
+
+  /* Scale a low-amplitude input up to the first stage headroom */
+  blockExp = 0;
+  shift = arm_cfft_bfp_shift_q15(peak, (numCols == 2U) ? 1 : 2);
+  if (shift < 0)
+  {
+    arm_shift_q15(p1, (int8_t) -shift, p1, 2U * L);
+    peak <<= -2 * shift;
+    blockExp = shift;
+  }
+
+  /* Radix-2 stage splitting the radix-4 by 2 lengths */
+  if (numCols == 2U)
+  {
+    shift = arm_cfft_bfp_shift_q15(peak, 1);
+    shift = (shift > 0) ? shift : 0;
+    peak = arm_cfft_bfp_radix2_q15(p1, L, S->pTwiddle, (uint32_t) shift);
+    blockExp += shift;
+  }
+
+  L = L / numCols;
+  twidCoefModifier = numCols;
+
+  /* Radix-4 stages, both columns shifted alike */
+  for (n1 = L; n1 > 4U; n1 >>= 2U)
+  {
+    shift = arm_cfft_bfp_shift_q15(peak, 2);
+    shift = (shift > 0) ? shift : 0;
+
+    peak = 0U;
+    for (k = 0U; k < numCols; k++)
+    {
+      peak |= arm_cfft_bfp_radix4_q15(p1 + (2U * k * L), L, n1, S->pTwiddle,
+                                      twidCoefModifier, (uint32_t) shift);
+    }
+
+    blockExp += shift;
+    twidCoefModifier <<= 2U;
+  }
+
+  /* Last stage, without twiddles */
+  shift = arm_cfft_bfp_shift_q15(peak, 2);
+  shift = (shift > 0) ? shift : 0;
+  arm_cfft_bfp_radix4_last_q15(p1, L * numCols, (uint32_t) shift, ifftFlag);
+  blockExp += shift;
+
+  if (bitReverseFlag)
+    arm_bitreversal_16((uint16_t*)p1,S->bitRevLength,S->pBitRevTable);
+
+  *pBlockExp = blockExp;
+}
+
+/**
+ * @} end of ComplexFFT group
+ */
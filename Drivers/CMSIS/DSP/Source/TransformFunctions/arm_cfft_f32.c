@@ -189,6 +189,13 @@ extern void arm_bitreversal_32(
 *       break;
 *   }
 * \endcode
+* \par Block floating-point Q15
+* arm_cfft_q15 scales the data down at every stage, whatever its amplitude, so
+* that a low-amplitude input loses most of its bits.  arm_cfft_bfp_q15 uses the
+* same structures and stages, but measures the headroom of the block before each
+* stage and shifts only by the growth that the stage can actually cause.  The
+* total shift is returned as a block exponent, and the output scaled by
+* <code>2^blockExp</code> is the unscaled transform.
 *
 */
 
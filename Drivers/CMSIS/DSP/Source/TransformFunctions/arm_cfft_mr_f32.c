@@ -0,0 +1,444 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_cfft_mr_f32.c
+ * Description:  Mixed-radix (2/3/4/5) Decimation in Time CFFT Floating point processing function
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+* @ingroup groupTransforms
+*/
+
+/**
+* @defgroup MixedRadixFFT Mixed-Radix FFT Functions
+*
+* \par
+* The complex and real FFTs of the ComplexFFT and RealFFT groups are limited to
+* power-of-two lengths. The mixed-radix functions accept any length that is a product
+* of 2, 3 and 5, so that frames of 60, 100, 240, 480 or 960 samples can be transformed
+* without zero padding or resampling.
+* \par
+* The transform is a decimation in time FFT in radix-4, radix-2, radix-3 and radix-5
+* stages. The input is first copied to the work buffer in digit-reversed order, the
+* stages then run in place, the last one writes the result in natural order back to
+* the input buffer. There is no bit reversal flag: the output is always in order.
+* \par
+* The data layout and the scaling are the ones of arm_cfft_f32(): interleaved
+* {real, imag} pairs processed in place, the inverse transform is scaled by 1/fftLen.
+* arm_rfft_mr_f32() computes a real FFT of fftLen points with a complex FFT of
+* fftLen/2 points, its output is packed like the one of arm_rfft_fast_f32().
+* \par Initialization
+* \par
+* An instance holds the plan of the stages, a pointer to the twiddle factors and a
+* pointer to the work buffer. Both buffers belong to the caller and are sized with
+* ARM_CFFT_MR_TWIDDLE_SIZE() and ARM_CFFT_MR_BUFFER_SIZE() (ARM_RFFT_MR_TWIDDLE_SIZE()
+* and ARM_RFFT_MR_BUFFER_SIZE() for the real FFT). The init function builds the plan
+* and computes the twiddle factors:
+* <pre>
+*     float32_t twiddle[ARM_CFFT_MR_TWIDDLE_SIZE(480)];
+*     float32_t buffer[ARM_CFFT_MR_BUFFER_SIZE(480)];
+*     arm_cfft_mr_instance_f32 S;
+*
+*     arm_cfft_mr_init_f32(&S, 480, twiddle, buffer);
+*     arm_cfft_mr_f32(&S, data, 0);
+* </pre>
+*/
+
+/**
+* @addtogroup MixedRadixFFT
+* @{
+*/
+
+/* cos(2*pi/3), sin(2*pi/3), cos(2*pi/5), cos(4*pi/5), sin(2*pi/5), sin(4*pi/5) */
+#define C3_1  0.5f
+#define S3_1  0.86602540378443864676f
+#define C5_1  0.30901699437494742410f
+#define C5_2  -0.80901699437494742410f
+#define S5_1  0.95105651629515357212f
+#define S5_2  0.58778525229247312917f
+
+/*
+* Butterflies on the values of one group, x[2*q], x[2*q+1] being the twiddled
+* input q. The results are stored back into x, output q at x[2*q].
+*/
+
+CMSIS_INLINE __STATIC_INLINE void arm_cfft_mr_bfly2_f32(
+  float32_t * x)
+{
+  float32_t t0, t1;
+
+  t0 = x[0] - x[2];
+  t1 = x[1] - x[3];
+  x[0] = x[0] + x[2];
+  x[1] = x[1] + x[3];
+  x[2] = t0;
+  x[3] = t1;
+}
+
+CMSIS_INLINE __STATIC_INLINE void arm_cfft_mr_bfly3_f32(
+  float32_t * x)
+{
+  float32_t t1r, t1i, t2r, t2i, mr, mi, sr, si;
+
+  t1r = x[2] + x[4];
+  t1i = x[3] + x[5];
+  t2r = x[2] - x[4];
+  t2i = x[3] - x[5];
+
+  mr = x[0] - C3_1 * t1r;
+  mi = x[1] - C3_1 * t1i;
+  /*  -j * sin(2*pi/3) * t2 */
+  sr = S3_1 * t2i;
+  si = -S3_1 * t2r;
+
+  x[0] = x[0] + t1r;
+  x[1] = x[1] + t1i;
+  x[2] = mr + sr;
+  x[3] = mi + si;
+  x[4] = mr - sr;
+  x[5] = mi - si;
+}
+
+CMSIS_INLINE __STATIC_INLINE void arm_cfft_mr_bfly4_f32(
+  float32_t * x)
+{
+  float32_t t0r, t0i, t1r, t1i, t2r, t2i, t3r, t3i;
+
+  t0r = x[0] + x[4];
+  t0i = x[1] + x[5];
+  t1r = x[0] - x[4];
+  t1i = x[1] - x[5];
+  t2r = x[2] + x[6];
+  t2i = x[3] + x[7];
+  t3r = x[2] - x[6];
+  t3i = x[3] - x[7];
+
+  x[0] = t0r + t2r;
+  x[1] = t0i + t2i;
+  /*  t1 - j * t3 */
+  x[2] = t1r + t3i;
+  x[3] = t1i - t3r;
+  x[4] = t0r - t2r;
+  x[5] = t0i - t2i;
+  /*  t1 + j * t3 */
+  x[6] = t1r - t3i;
+  x[7] = t1i + t3r;
+}
+
+CMSIS_INLINE __STATIC_INLINE void arm_cfft_mr_bfly5_f32(
+  float32_t * x)
+{
+  float32_t t1r, t1i, t2r, t2i, t3r, t3i, t4r, t4i;
+  float32_t b1r, b1i, b2r, b2i, d1r, d1i, d2r, d2i;
+
+  t1r = x[2] + x[8];
+  t1i = x[3] + x[9];
+  t2r = x[4] + x[6];
+  t2i = x[5] + x[7];
+  t3r = x[2] - x[8];
+  t3i = x[3] - x[9];
+  t4r = x[4] - x[6];
+  t4i = x[5] - x[7];
+
+  b1r = x[0] + C5_1 * t1r + C5_2 * t2r;
+  b1i = x[1] + C5_1 * t1i + C5_2 * t2i;
+  b2r = x[0] + C5_2 * t1r + C5_1 * t2r;
+  b2i = x[1] + C5_2 * t1i + C5_1 * t2i;
+  d1r = S5_1 * t3r + S5_2 * t4r;
+  d1i = S5_1 * t3i + S5_2 * t4i;
+  d2r = S5_2 * t3r - S5_1 * t4r;
+  d2i = S5_2 * t3i - S5_1 * t4i;
+
+  x[0] = x[0] + t1r + t2r;
+  x[1] = x[1] + t1i + t2i;
+  /*  b1 - j * d1, b2 - j * d2, b2 + j * d2, b1 + j * d1 */
+  x[2] = b1r + d1i;
+  x[3] = b1i - d1r;
+  x[4] = b2r + d2i;
+  x[5] = b2i - d2r;
+  x[6] = b2r - d2i;
+  x[7] = b2i + d2r;
+  x[8] = b1r - d1i;
+  x[9] = b1i + d1r;
+}
+
+/**
+* @brief  Radix-r stage of the mixed-radix CFFT.
+* @param[in]  *pSrc             points to the groups of m points left by the previous stages.
+* @param[out] *pDst             points to the groups of r*m points, may be pSrc.
+* @param[in]  fftLen            length of the FFT.
+* @param[in]  m                 length of the transforms combined, product of the previous radices.
+* @param[in]  radix             radix of the stage: 2, 3, 4 or 5.
+* @param[in]  *pCoef            points to the twiddle factors of fftLen.
+* @return none.
+*
+* The first butterfly of each group has unit twiddles: it is run without multiplications,
+* which covers the whole first stage. The others run column by column so that a column
+* loads its twiddles once. Inlined in one function per radix below, where radix is a
+* constant: the loops over the inputs of a butterfly unroll and the switch folds.
+*/
+CMSIS_INLINE __STATIC_INLINE void arm_cfft_mr_stage_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t fftLen,
+  uint32_t m,
+  uint32_t radix,
+  const float32_t * pCoef)
+{
+  float32_t x[10];                     /* Values of a group, up to radix 5 */
+  float32_t w[10];                     /* Twiddles of a column, w[2*q] for input q */
+  const float32_t *pIn;
+  float32_t *pOut;
+  float32_t xr, xi;
+  uint32_t span = 2U * radix * m;      /* Values between two groups */
+  uint32_t step = 2U * m;              /* Values between two inputs of a group */
+  uint32_t twidCoefModifier = fftLen / (radix * m);
+  uint32_t end = 2U * fftLen;
+  uint32_t j, k, q;
+
+  /*  First column, unit twiddles */
+  for (j = 0U; j < end; j += span)
+  {
+    pIn = &pSrc[j];
+    for (q = 0U; q < 2U * radix; q += 2U)
+    {
+      x[q]      = pIn[0];
+      x[q + 1U] = pIn[1];
+      pIn += step;
+    }
+
+    switch (radix)
+    {
+    case 4U:
+      arm_cfft_mr_bfly4_f32(x);
+      break;
+    case 2U:
+      arm_cfft_mr_bfly2_f32(x);
+      break;
+    case 3U:
+      arm_cfft_mr_bfly3_f32(x);
+      break;
+    default:
+      arm_cfft_mr_bfly5_f32(x);
+      break;
+    }
+
+    pOut = &pDst[j];
+    for (q = 0U; q < 2U * radix; q += 2U)
+    {
+      pOut[0] = x[q];
+      pOut[1] = x[q + 1U];
+      pOut += step;
+    }
+  }
+
+  /*  Other columns, input q of column k multiplied by W_N^(k*q*twidCoefModifier) */
+  for (k = 1U; k < m; k++)
+  {
+    for (q = 2U; q < 2U * radix; q += 2U)
+    {
+      w[q]      = pCoef[k * q * twidCoefModifier];
+      w[q + 1U] = pCoef[k * q * twidCoefModifier + 1U];
+    }
+
+    for (j = 2U * k; j < end; j += span)
+    {
+      pIn = &pSrc[j];
+      x[0] = pIn[0];
+      x[1] = pIn[1];
+      for (q = 2U; q < 2U * radix; q += 2U)
+      {
+        pIn += step;
+        xr = pIn[0];
+        xi = pIn[1];
+        x[q]      = xr * w[q] - xi * w[q + 1U];
+        x[q + 1U] = xr * w[q + 1U] + xi * w[q];
+      }
+
+      switch (radix)
+      {
+      case 4U:
+        arm_cfft_mr_bfly4_f32(x);
+        break;
+      case 2U:
+        arm_cfft_mr_bfly2_f32(x);
+        break;
+      case 3U:
+        arm_cfft_mr_bfly3_f32(x);
+        break;
+      default:
+        arm_cfft_mr_bfly5_f32(x);
+        break;
+      }
+
+      pOut = &pDst[j];
+      for (q = 0U; q < 2U * radix; q += 2U)
+      {
+        pOut[0] = x[q];
+        pOut[1] = x[q + 1U];
+        pOut += step;
+      }
+    }
+  }
+}
+
+static void arm_cfft_mr_radix2_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t fftLen,
+  uint32_t m,
+  const float32_t * pCoef)
+{
+  arm_cfft_mr_stage_f32(pSrc, pDst, fftLen, m, 2U, pCoef);
+}
+
+static void arm_cfft_mr_radix3_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t fftLen,
+  uint32_t m,
+  const float32_t * pCoef)
+{
+  arm_cfft_mr_stage_f32(pSrc, pDst, fftLen, m, 3U, pCoef);
+}
+
+static void arm_cfft_mr_radix4_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t fftLen,
+  uint32_t m,
+  const float32_t * pCoef)
+{
+  arm_cfft_mr_stage_f32(pSrc, pDst, fftLen, m, 4U, pCoef);
+}
+
+static void arm_cfft_mr_radix5_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t fftLen,
+  uint32_t m,
+  const float32_t * pCoef)
+{
+  arm_cfft_mr_stage_f32(pSrc, pDst, fftLen, m, 5U, pCoef);
+}
+
+/**
+* @brief Processing function for the floating-point mixed-radix complex FFT.
+* @param[in]      *S              points to an instance of the mixed-radix CFFT structure.
+* @param[in, out] *p1             points to the complex data buffer of size <code>2*fftLen</code>. Processing occurs in-place.
+* @param[in]      ifftFlag        flag that selects forward (ifftFlag=0) or inverse (ifftFlag=1) transform.
+* @return none.
+*/
+void arm_cfft_mr_f32(
+  const arm_cfft_mr_instance_f32 * S,
+  float32_t * p1,
+  uint8_t ifftFlag)
+{
+  float32_t *pBuf = S->pBuffer;
+  float32_t *pDst;
+  uint32_t L = S->fftLen;
+  uint32_t numStages = S->numStages;
+  uint32_t weight[ARM_CFFT_MR_MAX_STAGES];  /* Product of the radices of the stages before */
+  uint32_t digit[ARM_CFFT_MR_MAX_STAGES];
+  uint32_t i, s, pos, m;
+  float32_t sign, invL;
+
+  if (numStages == 0U)
+  {
+    return;
+  }
+
+  m = 1U;
+  for (s = 0U; s < numStages; s++)
+  {
+    weight[s] = m;
+    digit[s] = 0U;
+    m *= S->radix[s];
+  }
+
+  /*  Digit-reversed copy: the last digit of the input index, base the radix of
+   *  the last stage, is the first one of the position, and so on. The position
+   *  is counted along with the index. The inverse is computed as the
+   *  conjugate of the forward transform of the conjugate. */
+  sign = (ifftFlag == 1U) ? -1.0f : 1.0f;
+  pos = 0U;
+  for (i = 0U; i < L; i++)
+  {
+    pBuf[2U * pos]      = p1[2U * i];
+    pBuf[2U * pos + 1U] = p1[2U * i + 1U] * sign;
+
+    s = numStages - 1U;
+    pos += weight[s];
+    while (++digit[s] == S->radix[s])
+    {
+      digit[s] = 0U;
+      pos -= S->radix[s] * weight[s];
+      if (s == 0U)
+      {
+        break;
+      }
+      s--;
+      pos += weight[s];
+    }
+  }
+
+  /*  Stages in place in the work buffer, the last one back to p1 */
+  for (s = 0U; s < numStages; s++)
+  {
+    pDst = (s == numStages - 1U) ? p1 : pBuf;
+
+    switch (S->radix[s])
+    {
+    case 4U:
+      arm_cfft_mr_radix4_f32(pBuf, pDst, L, weight[s], S->pTwiddle);
+      break;
+    case 2U:
+      arm_cfft_mr_radix2_f32(pBuf, pDst, L, weight[s], S->pTwiddle);
+      break;
+    case 3U:
+      arm_cfft_mr_radix3_f32(pBuf, pDst, L, weight[s], S->pTwiddle);
+      break;
+    default:
+      arm_cfft_mr_radix5_f32(pBuf, pDst, L, weight[s], S->pTwiddle);
+      break;
+    }
+  }
+
+  if (ifftFlag == 1U)
+  {
+    invL = 1.0f / (float32_t) L;
+    /*  Conjugate and scale output data */
+    for (i = 0U; i < 2U * L; i += 2U)
+    {
+      p1[i]      =  p1[i] * invL;
+      p1[i + 1U] = -p1[i + 1U] * invL;
+    }
+  }
+}
+
+/**
+* @} end of MixedRadixFFT group
+*/
@@ -0,0 +1,128 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_cfft_mr_init_f32.c
+ * Description:  Initialization function for the mixed-radix CFFT Floating point processing function
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupTransforms
+ */
+
+/**
+ * @addtogroup MixedRadixFFT
+ * @{
+ */
+
+/**
+* @brief  Initialization function for the floating-point mixed-radix CFFT/CIFFT.
+* @param[in,out] *S             points to an arm_cfft_mr_instance_f32 structure.
+* @param[in]     fftLen         length of the FFT.
+* @param[out]    *pTwiddle      points to ARM_CFFT_MR_TWIDDLE_SIZE(fftLen) values, filled with the twiddle factors.
+* @param[in]     *pBuffer       points to ARM_CFFT_MR_BUFFER_SIZE(fftLen) values, the work buffer.
+* @return        The function returns ARM_MATH_SUCCESS if initialization is successful or ARM_MATH_ARGUMENT_ERROR if <code>fftLen</code> is not a supported value.
+*
+* \par Description:
+* \par
+* <code>fftLen</code> must be a product of 2, 3 and 5 (and at least 2), such as 60, 100, 240, 480 or 960.
+* It is split into radix-4 stages first, then at most one radix-2 stage, then the radix-3 and
+* radix-5 stages.
+* \par
+* The twiddle factors <code>W_N^k = exp(-2*pi*i*k/N)</code>, k = 0 .. N-1, are computed here in double precision,
+* real and imaginary parts interleaved. An instance of a fixed length can also point to a table
+* generated offline, the same layout.
+* \par
+* Instances of the same length may share the twiddle factors. The work buffer holds the data
+* during the transform: instances run concurrently need separate ones.
+*/
+arm_status arm_cfft_mr_init_f32(
+  arm_cfft_mr_instance_f32 * S,
+  uint16_t fftLen,
+  float32_t * pTwiddle,
+  float32_t * pBuffer)
+{
+  uint32_t n = fftLen;
+  uint32_t k;
+  uint8_t stages = 0U;
+  float64_t phase;
+
+  S->fftLen = fftLen;
+  S->numStages = 0U;
+  S->pTwiddle = pTwiddle;
+  S->pBuffer = pBuffer;
+
+  if (fftLen < 2U)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  /*  Factorize, radix-4 stages first as they need the fewest operations per point */
+  while ((n % 4U) == 0U)
+  {
+    S->radix[stages++] = 4U;
+    n /= 4U;
+  }
+
+  if ((n % 2U) == 0U)
+  {
+    S->radix[stages++] = 2U;
+    n /= 2U;
+  }
+
+  while ((n % 3U) == 0U)
+  {
+    S->radix[stages++] = 3U;
+    n /= 3U;
+  }
+
+  while ((n % 5U) == 0U)
+  {
+    S->radix[stages++] = 5U;
+    n /= 5U;
+  }
+
+  /*  Another prime factor: no butterfly for it */
+  if (n != 1U)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  S->numStages = stages;
+
+  /*  Twiddle factors. PI is a float32_t constant, too coarse for long lengths */
+  for (k = 0U; k < fftLen; k++)
+  {
+    phase = (6.283185307179586476925 * (float64_t) k) / (float64_t) fftLen;
+    pTwiddle[2U * k]      = (float32_t) cos(phase);
+    pTwiddle[2U * k + 1U] = (float32_t) -sin(phase);
+  }
+
+  return ARM_MATH_SUCCESS;
+}
+
+/**
+* @} end of MixedRadixFFT group
+*/
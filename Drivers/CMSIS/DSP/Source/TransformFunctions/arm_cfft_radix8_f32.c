@@ -42,7 +42,11 @@
 * @return none.
 */
 
+#if defined(ARM_MATH_SSE4)
+static void arm_radix8_butterfly_generic_f32(
+#else
 void arm_radix8_butterfly_f32(
+#endif
 float32_t * pSrc,
 uint16_t fftLen,
 const float32_t * pCoef,
@@ -283,3 +287,188 @@ uint16_t twidCoefModifier)
       twidCoefModifier <<= 3;
    } while (n2 > 7);
 }
+
+#if defined(ARM_MATH_SSE4)
+
+/* ----------------------------------------------------------------------
+ * x86 hosts: the butterflies of four consecutive j in the lanes
+ * -------------------------------------------------------------------- */
+
+/* Loads the complex values i .. i + 3 as real and imaginary parts */
+#define RADIX8_LOAD(re, im, i)                                               \
+   do {                                                                      \
+      __m128 lo_ = _mm_loadu_ps(&pSrc[2U * (i)]);                            \
+      __m128 hi_ = _mm_loadu_ps(&pSrc[2U * (i) + 4U]);                       \
+      (re) = _mm_shuffle_ps(lo_, hi_, _MM_SHUFFLE(2, 0, 2, 0));              \
+      (im) = _mm_shuffle_ps(lo_, hi_, _MM_SHUFFLE(3, 1, 3, 1));              \
+   } while (0)
+
+#define RADIX8_STORE(i, re, im)                                              \
+   do {                                                                      \
+      _mm_storeu_ps(&pSrc[2U * (i)], _mm_unpacklo_ps((re), (im)));           \
+      _mm_storeu_ps(&pSrc[2U * (i) + 4U], _mm_unpackhi_ps((re), (im)));      \
+   } while (0)
+
+/* (co * r + si * s, co * s - si * r), as p1 + p2 and p3 - p4 of the scalar code */
+#define RADIX8_TWIDDLE(i, co, si, r, s)                                      \
+   RADIX8_STORE((i), _mm_add_ps(_mm_mul_ps((co), (r)), _mm_mul_ps((si), (s))), \
+                     _mm_sub_ps(_mm_mul_ps((co), (s)), _mm_mul_ps((si), (r))))
+
+void arm_radix8_butterfly_f32(
+float32_t * pSrc,
+uint16_t fftLen,
+const float32_t * pCoef,
+uint16_t twidCoefModifier)
+{
+   uint32_t i1, i2, i3, i4, i5, i6, i7, i8;
+   uint32_t n1, n2, j, k, l;
+   float32_t co[7][4], si[7][4];
+
+   __m128 r1, r2, r3, r4, r5, r6, r7, r8;
+   __m128 s1, s2, s3, s4, s5, s6, s7, s8;
+   __m128 t1, t2, x1, x2, y1, y2;
+   __m128 co2, co3, co4, co5, co6, co7, co8;
+   __m128 si2, si3, si4, si5, si6, si7, si8;
+   const __m128 C81 = _mm_set1_ps(0.70710678118f);
+
+   /* The lengths arm_cfft_f32() uses, other ones take the scalar code */
+   if ((fftLen != 64U) && (fftLen != 512U) && (fftLen != 4096U))
+   {
+      arm_radix8_butterfly_generic_f32(pSrc, fftLen, pCoef, twidCoefModifier);
+      return;
+   }
+
+   n2 = fftLen;
+
+   /* All the stages but the last one: n2 is a multiple of 8. The j = 0 butterflies
+   ** take the twiddle at index 0, (1, 0), and give the results of the scalar code */
+   do
+   {
+      n1 = n2;
+      n2 = n2 >> 3;
+
+      for (j = 0U; j < n2; j += 4U)
+      {
+         /*  index calculation for the coefficients of the four lanes */
+         for (l = 0U; l < 4U; l++)
+         {
+            for (k = 0U; k < 7U; k++)
+            {
+               co[k][l] = pCoef[2U * ((k + 1U) * (j + l) * twidCoefModifier)];
+               si[k][l] = pCoef[2U * ((k + 1U) * (j + l) * twidCoefModifier) + 1U];
+            }
+         }
+
+         co2 = _mm_loadu_ps(co[0]);
+         co3 = _mm_loadu_ps(co[1]);
+         co4 = _mm_loadu_ps(co[2]);
+         co5 = _mm_loadu_ps(co[3]);
+         co6 = _mm_loadu_ps(co[4]);
+         co7 = _mm_loadu_ps(co[5]);
+         co8 = _mm_loadu_ps(co[6]);
+         si2 = _mm_loadu_ps(si[0]);
+         si3 = _mm_loadu_ps(si[1]);
+         si4 = _mm_loadu_ps(si[2]);
+         si5 = _mm_loadu_ps(si[3]);
+         si6 = _mm_loadu_ps(si[4]);
+         si7 = _mm_loadu_ps(si[5]);
+         si8 = _mm_loadu_ps(si[6]);
+
+         i1 = j;
+
+         do
+         {
+            /*  index calculation for the input */
+            i2 = i1 + n2;
+            i3 = i2 + n2;
+            i4 = i3 + n2;
+            i5 = i4 + n2;
+            i6 = i5 + n2;
+            i7 = i6 + n2;
+            i8 = i7 + n2;
+
+            RADIX8_LOAD(x1, y1, i1);
+            RADIX8_LOAD(x2, y2, i5);
+            r1 = _mm_add_ps(x1, x2);
+            r5 = _mm_sub_ps(x1, x2);
+            s1 = _mm_add_ps(y1, y2);
+            s5 = _mm_sub_ps(y1, y2);
+            RADIX8_LOAD(x1, y1, i2);
+            RADIX8_LOAD(x2, y2, i6);
+            r2 = _mm_add_ps(x1, x2);
+            r6 = _mm_sub_ps(x1, x2);
+            s2 = _mm_add_ps(y1, y2);
+            s6 = _mm_sub_ps(y1, y2);
+            RADIX8_LOAD(x1, y1, i3);
+            RADIX8_LOAD(x2, y2, i7);
+            r3 = _mm_add_ps(x1, x2);
+            r7 = _mm_sub_ps(x1, x2);
+            s3 = _mm_add_ps(y1, y2);
+            s7 = _mm_sub_ps(y1, y2);
+            RADIX8_LOAD(x1, y1, i4);
+            RADIX8_LOAD(x2, y2, i8);
+            r4 = _mm_add_ps(x1, x2);
+            r8 = _mm_sub_ps(x1, x2);
+            s4 = _mm_add_ps(y1, y2);
+            s8 = _mm_sub_ps(y1, y2);
+
+            t1 = _mm_sub_ps(r1, r3);
+            r1 = _mm_add_ps(r1, r3);
+            r3 = _mm_sub_ps(r2, r4);
+            r2 = _mm_add_ps(r2, r4);
+            x1 = _mm_add_ps(r1, r2);
+            r2 = _mm_sub_ps(r1, r2);
+            t2 = _mm_sub_ps(s1, s3);
+            s1 = _mm_add_ps(s1, s3);
+            s3 = _mm_sub_ps(s2, s4);
+            s2 = _mm_add_ps(s2, s4);
+            r1 = _mm_add_ps(t1, s3);
+            t1 = _mm_sub_ps(t1, s3);
+            RADIX8_STORE(i1, x1, _mm_add_ps(s1, s2));
+            s2 = _mm_sub_ps(s1, s2);
+            s1 = _mm_sub_ps(t2, r3);
+            t2 = _mm_add_ps(t2, r3);
+            RADIX8_TWIDDLE(i5, co5, si5, r2, s2);
+            RADIX8_TWIDDLE(i3, co3, si3, r1, s1);
+            RADIX8_TWIDDLE(i7, co7, si7, t1, t2);
+
+            r1 = _mm_mul_ps(_mm_sub_ps(r6, r8), C81);
+            r6 = _mm_mul_ps(_mm_add_ps(r6, r8), C81);
+            s1 = _mm_mul_ps(_mm_sub_ps(s6, s8), C81);
+            s6 = _mm_mul_ps(_mm_add_ps(s6, s8), C81);
+            t1 = _mm_sub_ps(r5, r1);
+            r5 = _mm_add_ps(r5, r1);
+            r8 = _mm_sub_ps(r7, r6);
+            r7 = _mm_add_ps(r7, r6);
+            t2 = _mm_sub_ps(s5, s1);
+            s5 = _mm_add_ps(s5, s1);
+            s8 = _mm_sub_ps(s7, s6);
+            s7 = _mm_add_ps(s7, s6);
+            r1 = _mm_add_ps(r5, s7);
+            r5 = _mm_sub_ps(r5, s7);
+            r6 = _mm_add_ps(t1, s8);
+            t1 = _mm_sub_ps(t1, s8);
+            s1 = _mm_sub_ps(s5, r7);
+            s5 = _mm_add_ps(s5, r7);
+            s6 = _mm_sub_ps(t2, r8);
+            t2 = _mm_add_ps(t2, r8);
+            RADIX8_TWIDDLE(i2, co2, si2, r1, s1);
+            RADIX8_TWIDDLE(i8, co8, si8, r5, s5);
+            RADIX8_TWIDDLE(i6, co6, si6, r6, s6);
+            RADIX8_TWIDDLE(i4, co4, si4, t1, t2);
+
+            i1 += n1;
+         } while (i1 < fftLen);
+      }
+
+      twidCoefModifier <<= 3;
+   } while (n2 > 8U);
+
+   /* Last stage, eight adjacent values per butterfly and no twiddles */
+   for (i1 = 0U; i1 < fftLen; i1 += 8U)
+   {
+      arm_radix8_butterfly_generic_f32(&pSrc[2U * i1], 8U, pCoef, twidCoefModifier);
+   }
+}
+
+#endif /* #if defined(ARM_MATH_SSE4) */
@@ -0,0 +1,140 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_rfft_mr_f32.c
+ * Description:  Mixed-radix RFFT Floating point processing function
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+* @ingroup groupTransforms
+*/
+
+/**
+* @addtogroup MixedRadixFFT
+* @{
+*/
+
+/**
+* @brief Processing function for the floating-point mixed-radix real FFT.
+* @param[in]  *S                points to an arm_rfft_mr_instance_f32 structure.
+* @param[in]  *p                points to the input buffer, overwritten by the forward transform.
+* @param[out] *pOut             points to the output buffer.
+* @param[in]  ifftFlag          RFFT if flag is 0, RIFFT if flag is 1
+* @return none.
+*
+* \par
+* The fftLen real samples are transformed as fftLen/2 complex ones, x[2n] + j*x[2n+1], whose
+* spectrum Z gives the even and odd halves E[k] = (Z[k] + conj(Z[M-k]))/2 and
+* O[k] = -j*(Z[k] - conj(Z[M-k]))/2, M = fftLen/2. The bins k and M-k are then
+* X[k] = E[k] + W^k*O[k] and X[M-k] = conj(E[k] - W^k*O[k]).
+* \par
+* The spectrum is packed as by arm_rfft_fast_f32(): pOut[0] is the real DC bin, pOut[1] the real
+* bin fftLen/2, then the complex bins 1 .. fftLen/2-1. The inverse takes this layout in p and
+* writes fftLen real samples, scaled by 1/fftLen.
+*/
+void arm_rfft_mr_f32(
+  const arm_rfft_mr_instance_f32 * S,
+  float32_t * p, float32_t * pOut,
+  uint8_t ifftFlag)
+{
+  const float32_t *pW = S->pTwiddleRFFT;
+  uint32_t M = S->fftLenRFFT / 2U;
+  uint32_t k;
+  float32_t ar, ai, br, bi, er, ei, dr, di, orr, oi, tr, ti, wr, wi;
+
+  if (ifftFlag == 1U)
+  {
+    /*  DC and Nyquist bins give E[0] and O[0] */
+    pOut[0] = 0.5f * (p[0] + p[1]);
+    pOut[1] = 0.5f * (p[0] - p[1]);
+
+    for (k = 1U; k <= M / 2U; k++)
+    {
+      /*  A = X[k], B = conj(X[M-k]) */
+      ar = p[2U * k];
+      ai = p[2U * k + 1U];
+      br = p[2U * (M - k)];
+      bi = -p[2U * (M - k) + 1U];
+      wr = pW[2U * k];
+      wi = pW[2U * k + 1U];
+
+      er = 0.5f * (ar + br);
+      ei = 0.5f * (ai + bi);
+      dr = 0.5f * (ar - br);
+      di = 0.5f * (ai - bi);
+
+      /*  O = conj(W^k) * (A - B) / 2 */
+      orr = wr * dr + wi * di;
+      oi  = wr * di - wi * dr;
+
+      /*  Z[k] = E + j*O, Z[M-k] = conj(E - j*O) */
+      pOut[2U * k]             = er - oi;
+      pOut[2U * k + 1U]        = ei + orr;
+      pOut[2U * (M - k)]       = er + oi;
+      pOut[2U * (M - k) + 1U]  = orr - ei;
+    }
+
+    arm_cfft_mr_f32(&(S->Sint), pOut, 1U);
+  }
+  else
+  {
+    arm_cfft_mr_f32(&(S->Sint), p, 0U);
+
+    /*  X[0] = E[0] + O[0], X[M] = E[0] - O[0], both real */
+    pOut[0] = p[0] + p[1];
+    pOut[1] = p[0] - p[1];
+
+    for (k = 1U; k <= M / 2U; k++)
+    {
+      /*  A = Z[k], B = conj(Z[M-k]) */
+      ar = p[2U * k];
+      ai = p[2U * k + 1U];
+      br = p[2U * (M - k)];
+      bi = -p[2U * (M - k) + 1U];
+      wr = pW[2U * k];
+      wi = pW[2U * k + 1U];
+
+      er = 0.5f * (ar + br);
+      ei = 0.5f * (ai + bi);
+      /*  O = -j * (A - B) / 2 */
+      orr = 0.5f * (ai - bi);
+      oi  = 0.5f * (br - ar);
+
+      /*  T = W^k * O */
+      tr = wr * orr - wi * oi;
+      ti = wr * oi + wi * orr;
+
+      pOut[2U * k]             = er + tr;
+      pOut[2U * k + 1U]        = ei + ti;
+      pOut[2U * (M - k)]       = er - tr;
+      pOut[2U * (M - k) + 1U]  = ti - ei;
+    }
+  }
+}
+
+/**
+* @} end of MixedRadixFFT group
+*/
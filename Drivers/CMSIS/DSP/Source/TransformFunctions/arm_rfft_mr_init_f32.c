@@ -0,0 +1,93 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_rfft_mr_init_f32.c
+ * Description:  Initialization function for the mixed-radix RFFT Floating point processing function
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V.1.5.1
+ *
+ * Target Processor: Cortex-M cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2017 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupTransforms
+ */
+
+/**
+ * @addtogroup MixedRadixFFT
+ * @{
+ */
+
+/**
+* @brief  Initialization function for the floating-point mixed-radix real FFT.
+* @param[in,out] *S             points to an arm_rfft_mr_instance_f32 structure.
+* @param[in]     fftLen         length of the Real Sequence.
+* @param[out]    *pTwiddle      points to ARM_RFFT_MR_TWIDDLE_SIZE(fftLen) values, filled with the twiddle factors.
+* @param[in]     *pBuffer       points to ARM_RFFT_MR_BUFFER_SIZE(fftLen) values, the work buffer.
+* @return        The function returns ARM_MATH_SUCCESS if initialization is successful or ARM_MATH_ARGUMENT_ERROR if <code>fftLen</code> is not a supported value.
+*
+* \par Description:
+* \par
+* <code>fftLen</code> must be even and <code>fftLen/2</code> a length supported by arm_cfft_mr_init_f32(),
+* such as 100, 240, 480 or 960.
+* \par
+* The first fftLen values of <code>pTwiddle</code> are the twiddle factors of the internal complex FFT,
+* followed by the <code>W_fftLen^k</code>, k = 0 .. fftLen/4, of the real stage.
+*/
+arm_status arm_rfft_mr_init_f32(
+  arm_rfft_mr_instance_f32 * S,
+  uint16_t fftLen,
+  float32_t * pTwiddle,
+  float32_t * pBuffer)
+{
+  float32_t *pTwiddleRFFT = &pTwiddle[fftLen];
+  uint32_t k;
+  float64_t phase;
+
+  S->fftLenRFFT = fftLen;
+  S->pTwiddleRFFT = pTwiddleRFFT;
+
+  if ((fftLen % 2U) != 0U)
+  {
+    S->Sint.fftLen = 0U;
+    S->Sint.numStages = 0U;
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  if (arm_cfft_mr_init_f32(&(S->Sint), fftLen / 2U, pTwiddle, pBuffer) != ARM_MATH_SUCCESS)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  for (k = 0U; k <= fftLen / 4U; k++)
+  {
+    phase = (6.283185307179586476925 * (float64_t) k) / (float64_t) fftLen;
+    pTwiddleRFFT[2U * k]      = (float32_t) cos(phase);
+    pTwiddleRFFT[2U * k + 1U] = (float32_t) -sin(phase);
+  }
+
+  return ARM_MATH_SUCCESS;
+}
+
+/**
+* @} end of MixedRadixFFT group
+*/
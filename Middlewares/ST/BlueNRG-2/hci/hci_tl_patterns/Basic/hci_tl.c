@@ -60,6 +60,13 @@
   #define HCI_READ_PACKET_NUM_MAX 	   (5)
 #endif
 
+/**
+ * Packets lent to the event queue when the pool runs empty, once enabled with hci_reserve_enable()
+ */
+#ifndef HCI_READ_PACKET_RESERVE
+  #define HCI_READ_PACKET_RESERVE      (0)
+#endif
+
 #ifndef MIN
   #define MIN(a,b)      ((a) < (b))? (a) : (b)
 #endif
@@ -71,6 +78,14 @@ tListNode             hciReadPktPool;
 tListNode             hciReadPktRxQueue;
 static tHciDataPacket hciReadPacketBuffer[HCI_READ_PACKET_NUM_MAX];
 static tHciContext    hciContext;
+static tHciStats      hciStats;
+static volatile uint8_t hciRxStalled;
+static uint8_t        hciCmdCredits;
+#if (HCI_READ_PACKET_RESERVE > 0)
+static tListNode      hciReservePktPool;
+static tHciDataPacket hciReservePacketBuffer[HCI_READ_PACKET_RESERVE];
+static volatile uint8_t hciReserveEnabled;
+#endif
 
 /************************* Static internal functions **************************/
 
@@ -139,6 +154,25 @@ static void move_list(tListNode * dest_list, tListNode * src_list)
   }
 }
 
+/**
+  * @brief  Give a packet back to the pool it belongs to.
+  *
+  * @param  hciReadPacket The HCI data packet
+  * @retval None
+  */
+static void free_packet(tHciDataPacket * hciReadPacket)
+{
+#if (HCI_READ_PACKET_RESERVE > 0)
+  if ((hciReadPacket >= &hciReservePacketBuffer[0]) &&
+      (hciReadPacket < &hciReservePacketBuffer[HCI_READ_PACKET_RESERVE]))
+  {
+    list_insert_tail(&hciReservePktPool, (tListNode *)hciReadPacket);
+    return;
+  }
+#endif
+  list_insert_tail(&hciReadPktPool, (tListNode *)hciReadPacket);
+}
+
 /**
   * @brief  Free the HCI event list.
   *
@@ -149,9 +183,30 @@ static void free_event_list(void)
 {
   tHciDataPacket * pckt;
 
-  while(list_get_size(&hciReadPktPool) < HCI_READ_PACKET_NUM_MAX/2){
+  while((list_get_size(&hciReadPktPool) < HCI_READ_PACKET_NUM_MAX/2) &&
+        (list_is_empty(&hciReadPktRxQueue) == FALSE)){
     list_remove_head(&hciReadPktRxQueue, (tListNode **)&pckt);    
-    list_insert_tail(&hciReadPktPool, (tListNode *)pckt);
+    free_packet(pckt);
+  }
+}
+
+/**
+  * @brief  Read the events left pending by the ISR when it found the pool empty.
+  *         The IRQ line stayed high and raises no new edge: read them now that
+  *         packets were freed, with the EXTI masked not to read the bus twice.
+  *
+  * @param  None
+  * @retval None
+  */
+static void resume_stalled_read(void)
+{
+  if (hciRxStalled)
+  {
+    HAL_NVIC_DisableIRQ(HCI_TL_SPI_EXTI_IRQn);
+    hciRxStalled = 0;
+    hciStats.resumes++;
+    hci_tl_lowlevel_isr();
+    HAL_NVIC_EnableIRQ(HCI_TL_SPI_EXTI_IRQn);
   }
 }
 
@@ -179,6 +234,22 @@ void hci_init(void(* UserEvtRx)(void* pData), void* pConf)
     list_insert_tail(&hciReadPktPool, (tListNode *)&hciReadPacketBuffer[index]);
   } 
   
+#if (HCI_READ_PACKET_RESERVE > 0)
+  /* The reserve is only lent once enabled */
+  list_init_head(&hciReservePktPool);
+  for (index = 0; index < HCI_READ_PACKET_RESERVE; index++)
+  {
+    list_insert_tail(&hciReservePktPool, (tListNode *)&hciReservePacketBuffer[index]);
+  }
+  hciReserveEnabled = 0;
+#endif
+  
+  BLUENRG_memset(&hciStats, 0, sizeof(hciStats));
+  hciRxStalled = 0;
+  
+  /* One command allowed until the controller reports its Num_HCI_Command_Packets */
+  hciCmdCredits = 1;
+  
   /* Initialize low level driver */
   if (hciContext.io.Init)  hciContext.io.Init(NULL);
   if (hciContext.io.Reset) hciContext.io.Reset();
@@ -194,7 +265,14 @@ void hci_register_io_bus(tHciIO* fops)
   hciContext.io.Reset   = fops->Reset;
 }
 
-int hci_send_req(struct hci_request* r, BOOL async)
+/**
+  * @brief  Wait for the response of the oldest command sent. The other events
+  *         received meanwhile are left in the queue for the application.
+  *
+  * @param  r The HCI request of the command
+  * @retval 0 when success, -1 when failure
+  */
+static int wait_response(struct hci_request* r)
 {
   uint8_t *ptr;
   uint16_t opcode = htobs(cmd_opcode_pack(r->ogf, r->ocf));
@@ -205,15 +283,6 @@ int hci_send_req(struct hci_request* r, BOOL async)
   tListNode hciTempQueue;
   
   list_init_head(&hciTempQueue);
-
-  free_event_list();
-  
-  send_cmd(r->ogf, r->ocf, r->clen, r->cparam);
-  
-  if (async)
-  {
-    return 0;
-  }
   
   while (1) 
   {
@@ -253,6 +322,7 @@ int hci_send_req(struct hci_request* r, BOOL async)
       {      
       case EVT_CMD_STATUS:
         cs = (void *) ptr;
+        hciCmdCredits = cs->ncmd;
         
         if (cs->opcode != opcode)
           goto failed;
@@ -270,6 +340,7 @@ int hci_send_req(struct hci_request* r, BOOL async)
       
       case EVT_CMD_COMPLETE:
         cc = (void *) ptr;
+        hciCmdCredits = cc->ncmd;
       
         if (cc->opcode != opcode)
           goto failed;
@@ -302,11 +373,12 @@ int hci_send_req(struct hci_request* r, BOOL async)
     
     /* If there are no more packets to be processed, be sure there is at list one
        packet in the pool to process the expected event.
-       If no free packets are available, discard the processed event and insert it
-       into the pool. */
+       If no free packets are available, discard the processed event and give it
+       back to its pool, then read the events the ISR may have left pending. */
     if (list_is_empty(&hciReadPktPool) && list_is_empty(&hciReadPktRxQueue)) {
-      list_insert_tail(&hciReadPktPool, (tListNode *)hciReadPacket);
+      free_packet(hciReadPacket);
       hciReadPacket=NULL;
+      resume_stalled_read();
     }
     else {
       /* Insert the packet in a different queue. These packets will be
@@ -320,20 +392,60 @@ int hci_send_req(struct hci_request* r, BOOL async)
   
 failed: 
   if (hciReadPacket!=NULL) {
-    list_insert_head(&hciReadPktPool, (tListNode *)hciReadPacket);
+    free_packet(hciReadPacket);
   }
   move_list(&hciReadPktRxQueue, &hciTempQueue);
+  resume_stalled_read();
 
   return -1;
   
 done:
   /* Insert the packet back into the pool.*/
-  list_insert_head(&hciReadPktPool, (tListNode *)hciReadPacket); 
+  free_packet(hciReadPacket);
   move_list(&hciReadPktRxQueue, &hciTempQueue);
+  resume_stalled_read();
 
   return 0;
 }
 
+int hci_send_req(struct hci_request* r, BOOL async)
+{
+  free_event_list();
+  
+  send_cmd(r->ogf, r->ocf, r->clen, r->cparam);
+  
+  if (async)
+  {
+    return 0;
+  }
+  
+  return wait_response(r);
+}
+
+int hci_send_cmd_queued(struct hci_request* r)
+{
+  if (hciCmdCredits == 0)
+  {
+    return -1;
+  }
+  
+  /* The queue is not trimmed: it holds the responses of the commands still pending */
+  hciCmdCredits--;
+  send_cmd(r->ogf, r->ocf, r->clen, r->cparam);
+  
+  return 0;
+}
+
+int hci_wait_cmd_response(struct hci_request* r)
+{
+  return wait_response(r);
+}
+
+uint8_t hci_cmd_credits(void)
+{
+  return hciCmdCredits;
+}
+
 void hci_user_evt_proc(void)
 {
   tHciDataPacket * hciReadPacket = NULL;
@@ -348,14 +460,17 @@ void hci_user_evt_proc(void)
       hciContext.UserEvtRx(hciReadPacket->dataBuff);
     }
 
-    list_insert_tail(&hciReadPktPool, (tListNode *)hciReadPacket);
+    free_packet(hciReadPacket);
   }
+  
+  resume_stalled_read();
 }
 
 int32_t hci_notify_asynch_evt(void* pdata)
 {
   tHciDataPacket * hciReadPacket = NULL;
   uint8_t data_len;
+  uint16_t depth;
   
   int32_t ret = 0;
   
@@ -363,7 +478,18 @@ int32_t hci_notify_asynch_evt(void* pdata)
   {
     /* Queuing a packet to read */
     list_remove_head (&hciReadPktPool, (tListNode **)&hciReadPacket);
-    
+  }
+#if (HCI_READ_PACKET_RESERVE > 0)
+  else if (hciReserveEnabled && (list_is_empty (&hciReservePktPool) == FALSE))
+  {
+    /* Sustained load: borrow from the reserve */
+    list_remove_head (&hciReservePktPool, (tListNode **)&hciReadPacket);
+    hciStats.reserve_borrowed++;
+  }
+#endif
+  
+  if (hciReadPacket != NULL)
+  {
     if (hciContext.io.Receive)
     {
       data_len = hciContext.io.Receive(hciReadPacket->dataBuff, HCI_READ_PACKET_SIZE);
@@ -371,23 +497,70 @@ int32_t hci_notify_asynch_evt(void* pdata)
       {                    
         hciReadPacket->data_len = data_len;
         if (verify_packet(hciReadPacket) == 0)
+        {
           list_insert_tail(&hciReadPktRxQueue, (tListNode *)hciReadPacket);
+          hciStats.rx_events++;
+          depth = (uint16_t)list_get_size(&hciReadPktRxQueue);
+          if (depth > hciStats.rx_queue_max)
+          {
+            hciStats.rx_queue_max = depth;
+          }
+        }
         else
-          list_insert_head(&hciReadPktPool, (tListNode *)hciReadPacket);          
+        {
+          hciStats.verify_rejects++;
+          free_packet(hciReadPacket);
+        }
       }
       else 
       {
         /* Insert the packet back into the pool*/
-        list_insert_head(&hciReadPktPool, (tListNode *)hciReadPacket);
+        hciStats.empty_reads++;
+        free_packet(hciReadPacket);
       }
     }
+    else
+    {
+      free_packet(hciReadPacket);
+    }
   }
   else 
   {
+    /* Resumed by resume_stalled_read() once packets are freed */
+    hciStats.pool_empty++;
+    hciRxStalled = 1;
     ret = 1;
   }
   return ret;
   
 }
 
+const tHciStats *hci_get_stats(void)
+{
+  return &hciStats;
+}
+
+void hci_reset_stats(void)
+{
+  BLUENRG_memset(&hciStats, 0, sizeof(hciStats));
+}
+
+void hci_reserve_enable(BOOL enable)
+{
+#if (HCI_READ_PACKET_RESERVE > 0)
+  hciReserveEnabled = (enable != FALSE) ? 1 : 0;
+#else
+  (void)enable;
+#endif
+}
+
+uint8_t hci_reserve_free(void)
+{
+#if (HCI_READ_PACKET_RESERVE > 0)
+  return (uint8_t)list_get_size(&hciReservePktPool);
+#else
+  return 0;
+#endif
+}
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -113,6 +113,25 @@ typedef struct
   void (* UserEvtRx) (void * pData); /**< ACI events callback function pointer */
 } tHciContext;
 
+/**
+ * @}
+ */ 
+
+/**
+ * @brief Counters of the HCI event queue
+ * @{
+ */
+typedef struct
+{
+  uint32_t rx_events;        /**< Events queued for hci_user_evt_proc() */
+  uint32_t pool_empty;       /**< Reads given up because no packet was free */
+  uint32_t verify_rejects;   /**< Packets dropped by verify_packet() */
+  uint32_t empty_reads;      /**< Reads that returned no data */
+  uint32_t reserve_borrowed; /**< Packets lent by the reserve pool */
+  uint32_t resumes;          /**< Reads resumed by hci_user_evt_proc() after the pool ran empty */
+  uint16_t rx_queue_max;     /**< Longest event queue seen */
+} tHciStats;
+
 /**
  * @}
  */ 
@@ -199,6 +218,68 @@ int32_t hci_notify_asynch_evt(void* pdata);
  */
 void hci_resume_flow(void);
 
+/**
+ * @brief  Counters of the HCI event queue.
+ *
+ * @param  None
+ * @retval Counters, updated from the BlueNRG interrupt
+ */
+const tHciStats *hci_get_stats(void);
+
+/**
+ * @brief  Clear the counters of the HCI event queue.
+ *
+ * @param  None
+ * @retval None
+ */
+void hci_reset_stats(void);
+
+/**
+ * @brief  Allow the event queue to borrow the HCI_READ_PACKET_RESERVE packets of the reserve
+ *         pool when the packet pool runs empty. Borrowed packets go back to the reserve once
+ *         processed.
+ *
+ * @param  enable: TRUE to lend the reserve, FALSE to stop lending it
+ * @retval None
+ */
+void hci_reserve_enable(BOOL enable);
+
+/**
+ * @brief  Packets of the reserve pool not lent.
+ *
+ * @param  None
+ * @retval Number of packets
+ */
+uint8_t hci_reserve_free(void);
+
+/**
+ * @brief  Send a command without waiting for its response, so that several commands can be
+ *         in flight. Takes one of the command credits granted by the controller through the
+ *         Num_HCI_Command_Packets field of its Command Complete and Command Status events.
+ *         The responses are taken in order with hci_wait_cmd_response(), all of them before
+ *         the next hci_send_req().
+ *
+ * @param  r The HCI request, its response fields are not used
+ * @retval int: 0 when sent, -1 when the controller has no credit left
+ */
+int hci_send_cmd_queued(struct hci_request *r);
+
+/**
+ * @brief  Wait for the response of the oldest command sent with hci_send_cmd_queued().
+ *
+ * @param  r The HCI request of that command, the response is copied into r->rparam
+ * @retval int: 0 when success, -1 when failure
+ */
+int hci_wait_cmd_response(struct hci_request *r);
+
+/**
+ * @brief  Commands the controller accepts before the next response.
+ *
+ * @param  None
+ * @retval Number of commands
+ */
+uint8_t hci_cmd_credits(void);
+
 /**
  * @brief  This function is called when an ACI/HCI command is sent and the response 
  *         is waited from the BLE core.
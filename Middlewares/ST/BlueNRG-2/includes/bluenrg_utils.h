@@ -42,6 +42,22 @@ typedef PACKED(struct) devConfigS  {
   uint8_t  Test_mode;
 } devConfig_t;
 
+/**
+ * Callback used by program_device_chunked() to fetch a part of the image.
+ * It returns 0 if the size bytes found at offset have been copied to data.
+ */
+typedef int (*fw_read_cb_t)(uint32_t offset, uint8_t *data, uint16_t size);
+
+/**
+ * Progress of an interrupted update: size of the image and sectors already
+ * verified. It is saved after each sector and cleared once the image is done.
+ */
+typedef struct
+{
+  uint32_t fw_size;
+  uint32_t sectors_done;
+} updater_progress_t;
+
 /* Exported constants --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
 #define FROM_US_TO_SYS_TIME(us)      ((uint32_t)(us/2.4414)+1)
@@ -77,6 +93,18 @@ typedef PACKED(struct) devConfigS  {
   */
 int program_device(const uint8_t *fw_image, uint32_t fw_size);
 
+/**
+  * @brief  Flash a new firmware using internal bootloader, reading the image
+  *         through a callback (e.g. from external memory or a link).
+  * @param  read_cb  Function used to fetch the image, block by block.
+  * @param  fw_size  Size of the firmware image. The firmware image size shall
+  *                  be multiple of 4 bytes.
+  * @retval int      It returns 0 if successful, or a number not equal to 0 in
+  *                  case of error (ACI_ERROR, UNSUPPORTED_VERSION,
+  *                  WRONG_IMAGE_SIZE, CRC_ERROR, PARSE_ERROR)
+  */
+int program_device_chunked(fw_read_cb_t read_cb, uint32_t fw_size);
+
 /**
   * @brief  Verify raw data from Device Configuration block.
   * @param  ifr_data Pointer to the buffer that will contain the data to verify.
@@ -102,6 +130,38 @@ int program_DEV_CONFIG(const devConfig_t *ifr_image);
   * @retval int        It returns 0 if successful
   */
 uint8_t getBlueNRGVersion(uint8_t *hw_version, uint16_t *fw_version);
+
+/* Hooks of the updater, weak in bluenrg_utils.c: the application overrides
+   them to keep the progress across resets and to use a CRC unit. By default
+   an interrupted update starts over and the CRC is computed in software. */
+
+/**
+  * @brief  Read back the progress last saved with updater_progress_save().
+  * @param  progress Pointer to the progress to fill.
+  * @retval int      It returns 0 if a progress was found
+  */
+int updater_progress_load(updater_progress_t *progress);
+
+/**
+  * @brief  Save the progress of the update, after each verified sector.
+  * @param  progress Pointer to the progress to keep.
+  */
+void updater_progress_save(const updater_progress_t *progress);
+
+/**
+  * @brief  Forget the progress, once the update is complete.
+  */
+void updater_progress_clear(void);
+
+/**
+  * @brief  Feed words to a CRC-32 computed as the STM32 CRC unit does (poly
+  *         0x04C11DB7, word by word, MSB first, from 0xFFFFFFFF).
+  * @param  words   Words to feed.
+  * @param  count   Number of words.
+  * @param  restart Start a new CRC from 0xFFFFFFFF with these words.
+  * @retval uint32_t CRC of the words fed since the last restart
+  */
+uint32_t updater_crc_calc(const uint32_t *words, uint32_t count, uint8_t restart);
    
 #ifdef __cplusplus
 }
@@ -0,0 +1,583 @@
+/******************** (C) COPYRIGHT 2020 STMicroelectronics ********************
+* File Name          : bluenrg_utils.c
+* Author             : AMS - RF Application Team
+* Version            : V1.0.0
+* Date               : 03-February-2020
+* Description        : Utility functions for BlueNRG-1,2 (updater, IFR, version)
+********************************************************************************
+* THE PRESENT FIRMWARE WHICH IS FOR GUIDANCE ONLY AIMS AT PROVIDING CUSTOMERS
+* WITH CODING INFORMATION REGARDING THEIR PRODUCTS IN ORDER FOR THEM TO SAVE TIME.
+* AS A RESULT, STMICROELECTRONICS SHALL NOT BE HELD LIABLE FOR ANY DIRECT,
+* INDIRECT OR CONSEQUENTIAL DAMAGES WITH RESPECT TO ANY CLAIMS ARISING FROM THE
+* CONTENT OF SUCH FIRMWARE AND/OR THE USE MADE BY CUSTOMERS OF THE CODING
+* INFORMATION CONTAINED HEREIN IN CONNECTION WITH THEIR PRODUCTS.
+*******************************************************************************/
+
+/******************************************************************************
+ * Include Files
+******************************************************************************/
+#include <string.h>
+#include "hci.h"
+#include "hci_tl.h"
+#include "hci_const.h"
+#include "bluenrg1_types.h"
+#include "bluenrg1_hal_aci.h"
+#include "bluenrg1_hci_le.h"
+#include "bluenrg_utils.h"
+
+/******************************************************************************
+ * Local Defines
+******************************************************************************/
+#define SUPPORTED_BOOTLOADER_VERSION_MIN  3
+#define SUPPORTED_BOOTLOADER_VERSION_MAX  5
+
+#define BASE_ADDRESS              0x10040000
+#define FULL_STACK_SIZE           (256*1024)
+#define SECTOR_SIZE               (2*1024)
+/* The first sector holds the updater itself and is never touched */
+#define FW_OFFSET                 SECTOR_SIZE
+
+#define IFR_BASE_ADDRESS          0x10020000
+#ifndef DEV_CONFIG_OFFSET
+#define DEV_CONFIG_OFFSET         0x0000
+#endif
+#define DEV_CONFIG_ADDRESS        (IFR_BASE_ADDRESS + DEV_CONFIG_OFFSET)
+
+/* Largest block sent with one ACI_HAL_UPDATER_PROG_DATA_BLK. The block size
+   actually used is the biggest power of two that fits both this value and the
+   updater buffer, so that a block never straddles a flash sector. */
+#define UPDATER_BLOCK_SIZE_MAX    64
+
+#define UPDATER_START_RETRIES     20
+#define UPDATER_START_DELAY_MS    10
+#define MAX_WRITE_RETRIES         2
+#define MAX_ERASE_RETRIES         2
+
+#define OCF_UPDATER_PROG_DATA_BLK 0x027
+
+#define CRC32_POLY                0x04C11DB7
+
+/******************************************************************************
+ * Local Variables
+******************************************************************************/
+static const uint8_t *src_image;
+static fw_read_cb_t src_read_cb;
+static uint16_t block_size;
+static uint8_t crc_first;
+static uint32_t crc_value;
+static uint32_t crc_soft;
+
+/* Two block buffers: one is on the wire while the other is being filled */
+static uint32_t block_buf[2][UPDATER_BLOCK_SIZE_MAX/4];
+/* Copy of the IFR sector used by program_DEV_CONFIG() */
+static uint32_t ifr_buf[SECTOR_SIZE/4];
+
+/******************************************************************************
+ * Local Function Definitions
+******************************************************************************/
+/**
+  * @brief  Fetch a part of the image from the memory-mapped or chunked source
+  */
+static int src_fetch(uint32_t offset, uint8_t *data, uint16_t size)
+{
+  if (src_image != NULL)
+  {
+    memcpy(data, src_image + offset, size);
+    return 0;
+  }
+  return src_read_cb(offset, data, size);
+}
+
+/**
+  * @brief  Restart the CRC computation of a flash area.
+  *
+  * The updater computes a CRC-32 (poly 0x04C11DB7, word by word, MSB first)
+  * starting from 0, while updater_crc_calc(), like the STM32 CRC unit, always
+  * restarts from 0xFFFFFFFF. Inverting the first word makes up for the
+  * different initial value, so both give the same result as
+  * ACI_HAL_UPDATER_CALC_CRC.
+  */
+static void crc_start(void)
+{
+  crc_first = 1;
+  crc_value = 0;
+}
+
+static void crc_feed(const uint32_t *words, uint32_t count)
+{
+  uint32_t first;
+
+  if (count == 0)
+    return;
+
+  if (crc_first)
+  {
+    first = words[0] ^ 0xFFFFFFFF;
+    crc_value = updater_crc_calc(&first, 1, 1);
+    crc_first = 0;
+    words++;
+    count--;
+  }
+  if (count)
+    crc_value = updater_crc_calc(words, count, 0);
+}
+
+/* Account for the erased (0xFF) tail of a partially programmed sector */
+static void crc_feed_erased(uint32_t size)
+{
+  uint32_t erased = 0xFFFFFFFF;
+
+  for (; size >= 4; size -= 4)
+    crc_feed(&erased, 1);
+}
+
+/**
+  * @brief  Reboot the BlueNRG-2 into the updater and wait until it answers
+  */
+static int updater_enter(uint8_t *version)
+{
+  uint8_t retries;
+
+  /* The controller resets while executing this command, so the answer may be lost */
+  aci_hal_updater_start();
+
+  for (retries = 0; retries < UPDATER_START_RETRIES; retries++)
+  {
+    HAL_Delay(UPDATER_START_DELAY_MS);
+    if (aci_hal_get_updater_version(version) == BLE_STATUS_SUCCESS)
+      return BLE_UTIL_SUCCESS;
+  }
+  return BLE_UTIL_ACI_ERROR;
+}
+
+/**
+  * @brief  Pick the block size from the updater buffer size
+  */
+static int updater_setup(void)
+{
+  uint8_t version, buffer_size;
+
+  if (updater_enter(&version) != BLE_UTIL_SUCCESS)
+    return BLE_UTIL_ACI_ERROR;
+
+  if (version < SUPPORTED_BOOTLOADER_VERSION_MIN || version > SUPPORTED_BOOTLOADER_VERSION_MAX)
+    return BLE_UTIL_UNSUPPORTED_VERSION;
+
+  if (aci_hal_get_updater_bufsize(&buffer_size) != BLE_STATUS_SUCCESS)
+    return BLE_UTIL_ACI_ERROR;
+
+  /* The buffer size includes the 6 bytes of address and length */
+  block_size = UPDATER_BLOCK_SIZE_MAX;
+  while (block_size > 4 && block_size > (uint16_t)(buffer_size - 6))
+    block_size >>= 1;
+
+  return BLE_UTIL_SUCCESS;
+}
+
+/**
+  * @brief  Send ACI_HAL_UPDATER_PROG_DATA_BLK without waiting for the answer
+  */
+static int updater_prog_blk_send(uint32_t address, const uint8_t *data, uint16_t size)
+{
+  struct hci_request rq;
+  uint8_t cmd_buffer[6 + UPDATER_BLOCK_SIZE_MAX];
+  aci_hal_updater_prog_data_blk_cp0 *cp0 = (aci_hal_updater_prog_data_blk_cp0 *)cmd_buffer;
+
+  cp0->Address = htob(address, 4);
+  cp0->Data_Length = htob(size, 2);
+  memcpy(cp0->Data, data, size);
+
+  memset(&rq, 0, sizeof(rq));
+  rq.ogf = 0x3f;
+  rq.ocf = OCF_UPDATER_PROG_DATA_BLK;
+  rq.cparam = cmd_buffer;
+  rq.clen = 6 + size;
+
+  return hci_send_cmd_queued(&rq);
+}
+
+/**
+  * @brief  Wait for the Command Complete of a block sent with
+  *         updater_prog_blk_send()
+  */
+static tBleStatus updater_prog_blk_wait(void)
+{
+  struct hci_request rq;
+  tBleStatus status;
+
+  memset(&rq, 0, sizeof(rq));
+  rq.ogf = 0x3f;
+  rq.ocf = OCF_UPDATER_PROG_DATA_BLK;
+  rq.rparam = &status;
+  rq.rlen = 1;
+
+  if (hci_wait_cmd_response(&rq) < 0)
+    return BLE_STATUS_TIMEOUT;
+
+  return status;
+}
+
+/**
+  * @brief  Erase one 2 KB sector of the BlueNRG-2 flash
+  */
+static int updater_erase_sector(uint32_t address)
+{
+  uint8_t retries;
+
+  for (retries = 0; retries <= MAX_ERASE_RETRIES; retries++)
+  {
+    if (aci_hal_updater_erase_sector(address) == BLE_STATUS_SUCCESS)
+      return BLE_UTIL_SUCCESS;
+  }
+  return BLE_UTIL_ACI_ERROR;
+}
+
+/**
+  * @brief  Program size bytes (multiple of block_size) at address.
+  *
+  * The next block is fetched from the source and fed to the CRC unit while
+  * the BlueNRG-2 is still busy writing the previous one. A block rejected by
+  * the updater is sent again synchronously.
+  */
+static int updater_program_area(uint32_t address, uint32_t offset, uint32_t size)
+{
+  uint32_t n, count = size / block_size;
+  uint8_t cur = 0, retries;
+  tBleStatus status;
+
+  if (count == 0)
+    return BLE_UTIL_SUCCESS;
+
+  if (src_fetch(offset, (uint8_t *)block_buf[cur], block_size) != 0)
+    return BLE_UTIL_PARSE_ERROR;
+  crc_feed(block_buf[cur], block_size / 4);
+
+  for (n = 0; n < count; n++)
+  {
+    if (updater_prog_blk_send(address, (uint8_t *)block_buf[cur], block_size) < 0)
+      return BLE_UTIL_ACI_ERROR;
+
+    /* Prepare the next block while the current one is being programmed */
+    if (n + 1 < count)
+    {
+      if (src_fetch(offset + block_size, (uint8_t *)block_buf[cur ^ 1], block_size) != 0)
+      {
+        updater_prog_blk_wait();
+        return BLE_UTIL_PARSE_ERROR;
+      }
+      crc_feed(block_buf[cur ^ 1], block_size / 4);
+    }
+
+    status = updater_prog_blk_wait();
+    for (retries = 0; status != BLE_STATUS_SUCCESS && retries < MAX_WRITE_RETRIES; retries++)
+      status = aci_hal_updater_prog_data_blk(address, block_size, (uint8_t *)block_buf[cur]);
+    if (status != BLE_STATUS_SUCCESS)
+      return BLE_UTIL_ACI_ERROR;
+
+    address += block_size;
+    offset += block_size;
+    cur ^= 1;
+  }
+  return BLE_UTIL_SUCCESS;
+}
+
+/**
+  * @brief  Compute with the CRC unit the CRC of [offset, offset + size) of the
+  *         image as the updater would see it once programmed
+  */
+static int image_crc(uint32_t offset, uint32_t size, uint32_t fw_size, uint32_t *crc)
+{
+  uint32_t end = offset + size;
+  uint32_t chunk;
+
+  crc_start();
+  while (offset < end && offset < fw_size)
+  {
+    chunk = fw_size - offset;
+    if (chunk > UPDATER_BLOCK_SIZE_MAX)
+      chunk = UPDATER_BLOCK_SIZE_MAX;
+    if (src_fetch(offset, (uint8_t *)block_buf[0], chunk) != 0)
+      return BLE_UTIL_PARSE_ERROR;
+    crc_feed(block_buf[0], chunk / 4);
+    offset += chunk;
+  }
+  crc_feed_erased(end - offset);
+  *crc = crc_value;
+
+  return BLE_UTIL_SUCCESS;
+}
+
+/**
+  * @brief  Return the first sector still to be programmed. Sectors recorded as
+  *         done by an interrupted update are only skipped if the updater CRC
+  *         of the whole range matches the one of the new image.
+  */
+static uint32_t resume_sector(uint32_t fw_size)
+{
+  updater_progress_t progress;
+  uint32_t first = FW_OFFSET / SECTOR_SIZE;
+  uint32_t count, crc_local, crc_remote;
+
+  if (updater_progress_load(&progress) != 0 || progress.fw_size != fw_size ||
+      progress.sectors_done <= first)
+    return first;
+
+  count = progress.sectors_done - first;
+  if (image_crc(FW_OFFSET, count * SECTOR_SIZE, fw_size, &crc_local) != BLE_UTIL_SUCCESS)
+    return first;
+  if (aci_hal_updater_calc_crc(BASE_ADDRESS + FW_OFFSET, count, &crc_remote) != BLE_STATUS_SUCCESS)
+    return first;
+
+  return (crc_local == crc_remote) ? progress.sectors_done : first;
+}
+
+/**
+  * @brief  Program the image sector by sector, checking each one with
+  *         ACI_HAL_UPDATER_CALC_CRC against updater_crc_calc()
+  */
+static int program_image(uint32_t fw_size)
+{
+  updater_progress_t progress;
+  uint32_t sector, sectors, address, size;
+  uint32_t crc_remote;
+  int ret;
+
+  if (fw_size > FULL_STACK_SIZE || fw_size <= FW_OFFSET || (fw_size & 3))
+    return BLE_UTIL_WRONG_IMAGE_SIZE;
+
+  ret = updater_setup();
+  if (ret != BLE_UTIL_SUCCESS)
+    return ret;
+
+  if (aci_hal_updater_erase_blue_flag() != BLE_STATUS_SUCCESS)
+    return BLE_UTIL_ACI_ERROR;
+
+  sectors = (fw_size + SECTOR_SIZE - 1) / SECTOR_SIZE;
+  progress.fw_size = fw_size;
+
+  for (sector = resume_sector(fw_size); sector < sectors; sector++)
+  {
+    address = BASE_ADDRESS + sector * SECTOR_SIZE;
+    size = fw_size - sector * SECTOR_SIZE;
+    if (size > SECTOR_SIZE)
+      size = SECTOR_SIZE;
+
+    if (updater_erase_sector(address) != BLE_UTIL_SUCCESS)
+      return BLE_UTIL_ACI_ERROR;
+
+    crc_start();
+    ret = updater_program_area(address, sector * SECTOR_SIZE, size - size % block_size);
+    if (ret != BLE_UTIL_SUCCESS)
+      return ret;
+
+    /* Image tail shorter than a block: send it as a last, smaller block */
+    if (size % block_size)
+    {
+      address += size - size % block_size;
+      if (src_fetch(sector * SECTOR_SIZE + size - size % block_size, (uint8_t *)block_buf[0], size % block_size) != 0)
+        return BLE_UTIL_PARSE_ERROR;
+      crc_feed(block_buf[0], (size % block_size) / 4);
+      if (aci_hal_updater_prog_data_blk(address, size % block_size, (uint8_t *)block_buf[0]) != BLE_STATUS_SUCCESS)
+        return BLE_UTIL_ACI_ERROR;
+    }
+    crc_feed_erased(SECTOR_SIZE - size);
+
+    if (aci_hal_updater_calc_crc(BASE_ADDRESS + sector * SECTOR_SIZE, 1, &crc_remote) != BLE_STATUS_SUCCESS)
+      return BLE_UTIL_ACI_ERROR;
+    if (crc_remote != crc_value)
+      return BLE_UTIL_CRC_ERROR;
+
+    progress.sectors_done = sector + 1;
+    updater_progress_save(&progress);
+  }
+
+  if (aci_hal_updater_reset_blue_flag() != BLE_STATUS_SUCCESS)
+    return BLE_UTIL_ACI_ERROR;
+
+  updater_progress_clear();
+  aci_hal_updater_reboot();
+
+  return BLE_UTIL_SUCCESS;
+}
+
+/**
+  * @brief  Read len bytes of the IFR into data, one updater block at a time
+  */
+static int ifr_read(uint32_t address, uint8_t *data, uint16_t len)
+{
+  uint16_t chunk;
+
+  while (len)
+  {
+    chunk = (len > block_size) ? block_size : len;
+    if (aci_hal_updater_read_data_blk(address, chunk, data) != BLE_STATUS_SUCCESS)
+      return BLE_UTIL_ACI_ERROR;
+    address += chunk;
+    data += chunk;
+    len -= chunk;
+  }
+  return BLE_UTIL_SUCCESS;
+}
+
+/******************************************************************************
+ * Function Definitions
+******************************************************************************/
+/**
+  * @note   Without this hook the progress is lost on a reset and an interrupted
+  *         update starts again from the first sector.
+  */
+WEAK_FUNCTION(int updater_progress_load(updater_progress_t *progress))
+{
+  (void)progress;
+  return -1;
+}
+
+WEAK_FUNCTION(void updater_progress_save(const updater_progress_t *progress))
+{
+  (void)progress;
+}
+
+WEAK_FUNCTION(void updater_progress_clear(void))
+{
+}
+
+/**
+  * @note   Bitwise, for the targets without a CRC unit. The progress of an
+  *         update is limited by the link, not by this loop.
+  */
+WEAK_FUNCTION(uint32_t updater_crc_calc(const uint32_t *words, uint32_t count, uint8_t restart))
+{
+  uint8_t bit;
+
+  if (restart)
+    crc_soft = 0xFFFFFFFF;
+
+  for (; count; count--)
+  {
+    crc_soft ^= *words++;
+    for (bit = 0; bit < 32; bit++)
+      crc_soft = (crc_soft & 0x80000000) ? (crc_soft << 1) ^ CRC32_POLY : (crc_soft << 1);
+  }
+  return crc_soft;
+}
+
+/**
+  * @note   The BlueNRG-2 is left running the new firmware: BlueNRG_Init() has to
+  *         be called again before using the stack. If the update is interrupted,
+  *         calling program_device() again with the same image resumes from the
+  *         last sector whose CRC was verified, as far as the progress hooks keep
+  *         it across resets.
+  */
+int program_device(const uint8_t *fw_image, uint32_t fw_size)
+{
+  src_image = fw_image;
+  src_read_cb = NULL;
+
+  return program_image(fw_size);
+}
+
+int program_device_chunked(fw_read_cb_t read_cb, uint32_t fw_size)
+{
+  src_image = NULL;
+  src_read_cb = read_cb;
+
+  return program_image(fw_size);
+}
+
+uint8_t verify_DEV_CONFIG(const devConfig_t *ifr_data)
+{
+  uint8_t data[sizeof(devConfig_t)];
+  uint8_t ret;
+
+  if (updater_setup() != BLE_UTIL_SUCCESS)
+    return BLE_UTIL_ACI_ERROR;
+
+  if (ifr_read(DEV_CONFIG_ADDRESS, data, sizeof(data)) != BLE_UTIL_SUCCESS)
+    ret = BLE_UTIL_ACI_ERROR;
+  else if (memcmp(data, ifr_data, sizeof(data)) != 0)
+    ret = BLE_UTIL_WRONG_VERIFY;
+  else
+    ret = BLE_UTIL_SUCCESS;
+
+  aci_hal_updater_reboot();
+
+  return ret;
+}
+
+/**
+  * @note   The whole IFR sector is read back, patched and programmed again, so
+  *         the rest of its content is preserved.
+  */
+int program_DEV_CONFIG(const devConfig_t *ifr_image)
+{
+  uint32_t sector_address = DEV_CONFIG_ADDRESS & ~(uint32_t)(SECTOR_SIZE - 1);
+  uint32_t crc_remote;
+  int ret;
+
+  ret = updater_setup();
+  if (ret != BLE_UTIL_SUCCESS)
+    return ret;
+
+  if (ifr_read(sector_address, (uint8_t *)ifr_buf, SECTOR_SIZE) != BLE_UTIL_SUCCESS)
+    return BLE_UTIL_ACI_ERROR;
+
+  /* Nothing to do if the configuration is already there */
+  if (memcmp((uint8_t *)ifr_buf + (DEV_CONFIG_ADDRESS - sector_address), ifr_image, sizeof(devConfig_t)) != 0)
+  {
+    memcpy((uint8_t *)ifr_buf + (DEV_CONFIG_ADDRESS - sector_address), ifr_image, sizeof(devConfig_t));
+
+    if (updater_erase_sector(sector_address) != BLE_UTIL_SUCCESS)
+      return BLE_UTIL_ACI_ERROR;
+
+    src_image = (const uint8_t *)ifr_buf;
+    src_read_cb = NULL;
+    crc_start();
+    ret = updater_program_area(sector_address, 0, SECTOR_SIZE);
+    if (ret != BLE_UTIL_SUCCESS)
+      return ret;
+
+    if (aci_hal_updater_calc_crc(sector_address, 1, &crc_remote) != BLE_STATUS_SUCCESS)
+      return BLE_UTIL_ACI_ERROR;
+    if (crc_remote != crc_value)
+      return BLE_UTIL_CRC_ERROR;
+  }
+
+  aci_hal_updater_reboot();
+
+  return BLE_UTIL_SUCCESS;
+}
+
+uint8_t getBlueNRGVersion(uint8_t *hw_version, uint16_t *fw_version)
+{
+  uint8_t hci_version, lmp_pal_version;
+  uint16_t hci_revision, manufacturer_name, lmp_pal_subversion;
+  uint8_t dtm_version_major, dtm_version_minor, dtm_version_patch, dtm_variant;
+  uint16_t dtm_build_number, btle_stack_variant, btle_stack_build_number;
+  uint8_t btle_stack_version_major, btle_stack_version_minor;
+  uint8_t btle_stack_version_patch, btle_stack_development;
+  tBleStatus status;
+
+  status = hci_read_local_version_information(&hci_version, &hci_revision,
+                                              &lmp_pal_version, &manufacturer_name,
+                                              &lmp_pal_subversion);
+  if (status != BLE_STATUS_SUCCESS)
+    return BLE_UTIL_ACI_ERROR;
+
+  *hw_version = hci_revision >> 8;
+
+  status = aci_hal_get_firmware_details(&dtm_version_major, &dtm_version_minor,
+                                        &dtm_version_patch, &dtm_variant,
+                                        &dtm_build_number, &btle_stack_version_major,
+                                        &btle_stack_version_minor, &btle_stack_version_patch,
+                                        &btle_stack_development, &btle_stack_variant,
+                                        &btle_stack_build_number);
+  if (status != BLE_STATUS_SUCCESS)
+    return BLE_UTIL_ACI_ERROR;
+
+  *fw_version = (btle_stack_version_major << 8) | ((btle_stack_version_minor & 0x0F) << 4) |
+                (btle_stack_version_patch & 0x0F);
+
+  return BLE_UTIL_SUCCESS;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
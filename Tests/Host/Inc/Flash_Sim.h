@@ -0,0 +1,67 @@
+/**
+  **************************************************************************************************
+  * @file           : Flash_Sim.h
+  * @brief          : Header for Flash_Sim.c file
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __FLASH_SIM_H
+#define __FLASH_SIM_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+#define FLASHSIM_MAX_SECTORS						4U
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t Erases[FLASHSIM_MAX_SECTORS];	/* Wear of each sector */
+	uint32_t Programs;									/* Words programmed */
+	uint32_t Operations;								/* Erases and programs, torn and failed ones included */
+	uint32_t Errors;										/* Misaligned, out of range, or 0 bits programmed to 1 */
+
+} FlashSim_Stats_t;
+
+
+/* Exported variables ----------------------------------------------------------------------------*/
+extern FlashSim_Stats_t FlashSim_Stats;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+int32_t FlashSim_Open(const char *pPath, uint8_t Sectors, uint32_t Sector_Size);
+void FlashSim_Close(void);
+void FlashSim_Blank(void);
+void FlashSim_CutPower(uint32_t Operations, uint32_t Seed);
+void FlashSim_PowerOn(void);
+uint8_t FlashSim_PowerLost(void);
+
+/* Same prototypes as KVStore_IO_t */
+int32_t FlashSim_Erase(uint8_t Sector);
+int32_t FlashSim_Program(uint8_t Sector, uint32_t Offset, uint32_t Data);
+int32_t FlashSim_Read(uint8_t Sector, uint32_t Offset, void *pData, uint32_t Length);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __FLASH_SIM_H */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,69 @@
+/**
+  **************************************************************************************************
+  * @file           : Host_Test.h
+  * @brief          : Checks of the host tests. Each test is one program: a failed check is printed
+	*										and HOST_TEST_END() makes the exit status non-zero.
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __HOST_TEST_H
+#define __HOST_TEST_H
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/* Exported variables ----------------------------------------------------------------------------*/
+static unsigned int Host_Test_Checks;
+static unsigned int Host_Test_Failures;
+
+
+/* Exported macro --------------------------------------------------------------------------------*/
+#define HOST_CHECK(Condition) \
+	do \
+	{ \
+		Host_Test_Checks++; \
+		if(!(Condition)) \
+		{ \
+			Host_Test_Failures++; \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #Condition); \
+		} \
+	} while(0)
+
+/* Runs one test function, named in the log */
+#define HOST_RUN(Test) \
+	do \
+	{ \
+		unsigned int Failures = Host_Test_Failures; \
+		Test(); \
+		printf("%-48s %s\n", #Test, (Host_Test_Failures == Failures) ? "passed" : "FAILED"); \
+	} while(0)
+
+#define HOST_TEST_END() \
+	do \
+	{ \
+		printf("%u checks, %u failed\n", Host_Test_Checks, Host_Test_Failures); \
+		return (Host_Test_Failures == 0U) ? EXIT_SUCCESS : EXIT_FAILURE; \
+	} while(0)
+
+
+/* Exported functions ----------------------------------------------------------------------------*/
+/* Deterministic pseudo-random numbers (LCG), the same on every host */
+static inline uint32_t Host_Rand(uint32_t *pState)
+{
+	*pState = (*pState * 1664525U) + 1013904223U;
+	return *pState >> 8;
+}
+
+
+
+#endif  /* __HOST_TEST_H */
+
+
+/******************************************* END OF FILE *******************************************/
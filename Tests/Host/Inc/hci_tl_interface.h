@@ -0,0 +1,25 @@
+/**
+  **************************************************************************************************
+  * @file           : hci_tl_interface.h
+  * @brief          : Host stand-in for BlueNRG-2/Target/hci_tl_interface.h, included by main.h and
+	*										hci_tl.h. The host tests have no SPI transport, only the HAL stand-in the
+	*										target header brings in through custom_bus.h.
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __HCI_TL_INTERFACE_H
+#define __HCI_TL_INTERFACE_H
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+
+
+#endif  /* __HCI_TL_INTERFACE_H */
+
+
+/******************************************* END OF FILE *******************************************/
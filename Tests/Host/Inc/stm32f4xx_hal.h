@@ -0,0 +1,167 @@
+/**
+  **************************************************************************************************
+  * @file           : stm32f4xx_hal.h
+  * @brief          : Host stand-in for the HAL. Found before the HAL include path, it lets main.h
+	*										and the hardware-independent parts of Core/Src build with the host compiler.
+  * @author         :
+  **************************************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion ---------------------------------------------------------*/
+#ifndef __STM32F4xx_HAL_H
+#define __STM32F4xx_HAL_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+
+/* Exported defines ------------------------------------------------------------------------------*/
+/* Flash constants used by the modules that program the internal flash */
+#define FLASH_TYPEERASE_SECTORS					0x00000000U
+#define FLASH_TYPEPROGRAM_WORD					0x00000002U
+#define FLASH_BANK_1										1U
+#define FLASH_VOLTAGE_RANGE_3						0x00000002U
+#define FLASH_SECTOR_2									2U
+#define FLASH_SECTOR_3									3U
+#define FLASH_FLAG_EOP									0x00000001U
+#define FLASH_FLAG_OPERR								0x00000002U
+#define FLASH_FLAG_WRPERR								0x00000010U
+#define FLASH_FLAG_PGAERR								0x00000020U
+#define FLASH_FLAG_PGPERR								0x00000040U
+#define FLASH_FLAG_PGSERR								0x00000080U
+
+#define FLASH_LATENCY_0									0x00000000U
+#define FLASH_LATENCY_1									0x00000001U
+#define FLASH_LATENCY_2									0x00000002U
+#define FLASH_LATENCY_3									0x00000003U
+
+#define __HAL_FLASH_CLEAR_FLAG(flag)		((void)(flag))
+
+/* Clock tree, as stm32f411xe.h and stm32f4xx_hal_rcc.h */
+#define HSI_VALUE												16000000U
+#define RCC_SYSCLKSOURCE_HSI						0x00000000U
+#define RCC_SYSCLKSOURCE_PLLCLK					0x00000002U
+#define RCC_PLLP_DIV2										0x00000002U
+#define RCC_PLLP_DIV4										0x00000004U
+#define RCC_PLLP_DIV6										0x00000006U
+#define RCC_PLLP_DIV8										0x00000008U
+#define RCC_CFGR_HPRE_Pos								4U
+#define RCC_CFGR_HPRE										0x000000F0U
+#define RCC_SYSCLK_DIV1									0x00000000U
+#define RCC_SYSCLK_DIV2									0x00000080U
+#define RCC_SYSCLK_DIV4									0x00000090U
+#define RCC_SYSCLK_DIV8									0x000000A0U
+#define RCC_SYSCLK_DIV16								0x000000B0U
+#define RCC_CFGR_PPRE1_Pos							10U
+#define RCC_CFGR_PPRE1									0x00001C00U
+#define RCC_HCLK_DIV1										0x00000000U
+#define RCC_HCLK_DIV2										0x00001000U
+#define RCC_HCLK_DIV4										0x00001400U
+#define RCC_HCLK_DIV8										0x00001800U
+#define RCC_HCLK_DIV16									0x00001C00U
+
+/* SPI1 baud rate prescaler, as stm32f4xx_hal_spi.h */
+#define SPI_CR1_BR_Pos									3U
+#define SPI_CR1_BR											0x00000038U
+#define SPI_BAUDRATEPRESCALER_2					0x00000000U
+#define SPI_BAUDRATEPRESCALER_4					0x00000008U
+#define SPI_BAUDRATEPRESCALER_8					0x00000010U
+#define SPI_BAUDRATEPRESCALER_16				0x00000018U
+#define SPI_BAUDRATEPRESCALER_32				0x00000020U
+#define SPI_BAUDRATEPRESCALER_64				0x00000028U
+#define SPI_BAUDRATEPRESCALER_128				0x00000030U
+#define SPI_BAUDRATEPRESCALER_256				0x00000038U
+
+/* USART divider with 16x oversampling, as stm32f4xx_hal_uart.h */
+#define UART_DIV_SAMPLING16(_PCLK_, _BAUD_)            ((uint32_t)((((uint64_t)(_PCLK_))*25U)/(4U*((uint64_t)(_BAUD_)))))
+#define UART_DIVMANT_SAMPLING16(_PCLK_, _BAUD_)        (UART_DIV_SAMPLING16((_PCLK_), (_BAUD_))/100U)
+#define UART_DIVFRAQ_SAMPLING16(_PCLK_, _BAUD_)        ((((UART_DIV_SAMPLING16((_PCLK_), (_BAUD_)) - (UART_DIVMANT_SAMPLING16((_PCLK_), (_BAUD_)) * 100U)) * 16U) + 50U) / 100U)
+#define UART_BRR_SAMPLING16(_PCLK_, _BAUD_)            ((UART_DIVMANT_SAMPLING16((_PCLK_), (_BAUD_)) << 4U) + \
+                                                        (UART_DIVFRAQ_SAMPLING16((_PCLK_), (_BAUD_)) & 0xF0U) + \
+                                                        (UART_DIVFRAQ_SAMPLING16((_PCLK_), (_BAUD_)) & 0x0FU))
+
+
+/* Exported types --------------------------------------------------------------------------------*/
+typedef enum
+{
+	HAL_OK = 0x00U,
+	HAL_ERROR = 0x01U,
+	HAL_BUSY = 0x02U,
+	HAL_TIMEOUT = 0x03U
+
+} HAL_StatusTypeDef;
+
+typedef struct
+{
+	uint32_t Dummy;
+
+} CRC_HandleTypeDef;
+
+typedef struct
+{
+	uint32_t Dummy;
+
+} SPI_HandleTypeDef;
+
+typedef struct
+{
+	uint32_t Dummy;
+
+} UART_HandleTypeDef;
+
+/* Only the counter of TIM2, the microsecond timebase, is read */
+typedef struct
+{
+	volatile uint32_t CNT;
+
+} TIM_TypeDef;
+
+typedef struct
+{
+	TIM_TypeDef *Instance;
+
+} TIM_HandleTypeDef;
+
+typedef struct
+{
+	uint32_t TypeErase;
+	uint32_t Banks;
+	uint32_t Sector;
+	uint32_t NbSectors;
+	uint32_t VoltageRange;
+
+} FLASH_EraseInitTypeDef;
+
+
+/* Exported Functions ----------------------------------------------------------------------------*/
+/* Provided by the test when the module under test uses them */
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError);
+uint32_t HAL_CRC_Calculate(CRC_HandleTypeDef *hcrc, uint32_t pBuffer[], uint32_t BufferLength);
+uint32_t HAL_CRC_Accumulate(CRC_HandleTypeDef *hcrc, uint32_t pBuffer[], uint32_t BufferLength);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif  /* __STM32F4xx_HAL_H */
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,262 @@
+/**
+  **************************************************************************************************
+  * @file       : Flash_Sim.c
+  * @brief      : File-backed NOR flash for the host tests. Sectors are kept in an image file, so
+	*								a test can close and reopen it as a device reading its flash after a reset.
+	*								Power can be cut during any erase or program.
+  * @author			:
+  **************************************************************************************************
+  *
+  * Flash behaviour, as the STM32F4 internal flash:
+  *		+ an erase sets all the bits of a sector, a program can only clear bits
+  *		+ programming is by aligned 32-bit words; a word that is not erased is an error, it is
+  *			counted and the bits are ANDed as the flash would do
+  *
+  * Power loss: FlashSim_CutPower(n) makes the n-th erase or program from now on the last one. That
+  * operation is torn: a program clears only some of its bits, an erase leaves some words as they
+  * were. Every operation after it fails, without touching the image, until FlashSim_PowerOn().
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Flash_Sim.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define FLASHSIM_ERASED_WORD						((uint32_t)0xFFFFFFFF)
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+FlashSim_Stats_t FlashSim_Stats;
+
+/* The image is loaded when opened and written back to its file when closed */
+static FILE *Image_File;
+static uint8_t *Image;
+static uint8_t Image_Sectors;
+static uint32_t Image_Sector_Size;
+
+/* Operations left before the power is cut, 0 when no cut is pending */
+static uint32_t Cut_Countdown;
+static uint32_t Cut_Seed;
+static uint8_t Power_Lost;
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+/**
+  * @brief	Pseudo-random bits of the torn operations
+  */
+static uint32_t FlashSim_Rand(void)
+{
+	Cut_Seed = (Cut_Seed * 1664525U) + 1013904223U;
+	return Cut_Seed ^ (Cut_Seed >> 16);
+}
+
+/**
+  * @brief	Counts one erase or program
+  * @retval	1 if it is the operation the power is cut during
+  */
+static uint8_t FlashSim_Tick(void)
+{
+	FlashSim_Stats.Operations++;
+
+	if(Cut_Countdown != 0U)
+	{
+		if(--Cut_Countdown == 0U)
+		{
+			Power_Lost = 1;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+
+/* Exported functions ----------------------------------------------------------------------------*/
+/**
+  * @brief	Opens the image file, creating a blank one if it does not exist. The statistics are
+  *					kept when the same image is opened again.
+  * @retval	0 on success, -1 otherwise
+  */
+int32_t FlashSim_Open(const char *pPath, uint8_t Sectors, uint32_t Sector_Size)
+{
+	uint32_t Size = Sectors * Sector_Size;
+	uint8_t Loaded = 0;
+
+	if((Image != NULL) || (Sectors == 0U) || (Sectors > FLASHSIM_MAX_SECTORS) || ((Sector_Size & 3U) != 0U))
+	{
+		return -1;
+	}
+
+	Image = (uint8_t *)malloc(Size);
+	Image_File = fopen(pPath, "r+b");
+	if(Image_File == NULL)
+	{
+		Image_File = fopen(pPath, "w+b");
+	}
+	if((Image == NULL) || (Image_File == NULL))
+	{
+		FlashSim_Close();
+		return -1;
+	}
+
+	Image_Sectors = Sectors;
+	Image_Sector_Size = Sector_Size;
+	FlashSim_PowerOn();
+
+	if((fseek(Image_File, 0, SEEK_END) == 0) && (ftell(Image_File) == (long)Size))
+	{
+		rewind(Image_File);
+		Loaded = (fread(Image, 1, Size, Image_File) == Size);
+	}
+	if(!Loaded)
+	{
+		FlashSim_Blank();
+	}
+	return 0;
+}
+
+/**
+  * @brief	Writes the image back to its file and closes it
+  */
+void FlashSim_Close(void)
+{
+	if((Image != NULL) && (Image_File != NULL))
+	{
+		rewind(Image_File);
+		(void)fwrite(Image, 1, Image_Sectors * Image_Sector_Size, Image_File);
+	}
+	if(Image_File != NULL)
+	{
+		(void)fclose(Image_File);
+		Image_File = NULL;
+	}
+	free(Image);
+	Image = NULL;
+}
+
+/**
+  * @brief	Erases all the sectors and clears the statistics, as a new device
+  */
+void FlashSim_Blank(void)
+{
+	memset(&FlashSim_Stats, 0, sizeof(FlashSim_Stats));
+	memset(Image, 0xFF, Image_Sectors * Image_Sector_Size);
+}
+
+/**
+  * @brief	Cuts the power during the Operations-th erase or program from now on
+  * @param	Operations: 1 for the next one, 0 to cancel a pending cut
+  * @param	Seed: selects the bits and words the torn operation leaves as they were
+  */
+void FlashSim_CutPower(uint32_t Operations, uint32_t Seed)
+{
+	Cut_Countdown = Operations;
+	Cut_Seed = Seed;
+}
+
+/**
+  * @brief	Restores the power, the image keeps what the torn operation left
+  */
+void FlashSim_PowerOn(void)
+{
+	Cut_Countdown = 0;
+	Power_Lost = 0;
+}
+
+uint8_t FlashSim_PowerLost(void)
+{
+	return Power_Lost;
+}
+
+/**
+  * @brief	Erases one sector
+  * @retval	0 on success, -1 if the power was lost
+  */
+int32_t FlashSim_Erase(uint8_t Sector)
+{
+	uint32_t Offset;
+	uint8_t Torn;
+
+	if(Power_Lost)
+	{
+		FlashSim_Stats.Operations++;
+		return -1;
+	}
+	if(Sector >= Image_Sectors)
+	{
+		FlashSim_Stats.Errors++;
+		return -1;
+	}
+
+	Torn = FlashSim_Tick();
+	FlashSim_Stats.Erases[Sector]++;
+
+	for(Offset = 0; Offset < Image_Sector_Size; Offset += 4U)
+	{
+		if(!Torn || ((FlashSim_Rand() & 1U) != 0U))
+		{
+			memset(&Image[(Sector * Image_Sector_Size) + Offset], 0xFF, 4);
+		}
+	}
+
+	return Torn ? -1 : 0;
+}
+
+/**
+  * @brief	Programs one aligned 32-bit word
+  * @retval	0 on success, -1 on error or if the power was lost
+  */
+int32_t FlashSim_Program(uint8_t Sector, uint32_t Offset, uint32_t Data)
+{
+	uint32_t Word;
+	uint8_t Torn;
+
+	if(Power_Lost)
+	{
+		FlashSim_Stats.Operations++;
+		return -1;
+	}
+	if((Sector >= Image_Sectors) || ((Offset & 3U) != 0U) || ((Offset + 4U) > Image_Sector_Size))
+	{
+		FlashSim_Stats.Errors++;
+		return -1;
+	}
+
+	Torn = FlashSim_Tick();
+	FlashSim_Stats.Programs++;
+
+	memcpy(&Word, &Image[(Sector * Image_Sector_Size) + Offset], 4);
+	if(Word != FLASHSIM_ERASED_WORD)
+	{
+		FlashSim_Stats.Errors++;
+	}
+
+	/* A torn program clears only some of the bits */
+	Word &= Torn ? (Data | FlashSim_Rand()) : Data;
+	memcpy(&Image[(Sector * Image_Sector_Size) + Offset], &Word, 4);
+
+	return Torn ? -1 : 0;
+}
+
+/**
+  * @brief	Reads from one sector
+  * @retval	0 on success, -1 if out of range
+  */
+int32_t FlashSim_Read(uint8_t Sector, uint32_t Offset, void *pData, uint32_t Length)
+{
+	if((Sector >= Image_Sectors) || ((Offset + Length) > Image_Sector_Size))
+	{
+		FlashSim_Stats.Errors++;
+		memset(pData, 0xFF, Length);
+		return -1;
+	}
+
+	memcpy(pData, &Image[(Sector * Image_Sector_Size) + Offset], Length);
+	return 0;
+}
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,685 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Adv_Manager.c
+  * @brief      : Host test of Adv_Manager.c. The schedule is stepped on a virtual clock and the
+	*								manager drives an emulated controller that keeps the advertising and scan
+	*								response data as the BlueNRG-2 builds them.
+  * @author			:
+  **************************************************************************************************
+  *
+  * The intervals must change exactly at the ends of the phases, with one restart each, payloads
+  * already in the controller must not be sent again, and the manufacturer data must rotate
+  * without advertising being stopped.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Host_Test.h"
+#include "Adv_Manager.h"
+#include "bluenrg_conf.h"
+#include "bluenrg1_gap.h"
+#include "bluenrg1_gap_aci.h"
+#include "bluenrg1_hci_le.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* Start of the runs, the virtual clock wraps around during the default schedule */
+#define TEST_T0													0xFFFF0000U
+
+#define TEST_MAX_STARTS									8U
+
+/* Commands the emulated controller refuses once */
+#define TEST_FAIL_DISCOVERABLE					0x01U
+#define TEST_FAIL_ADV_DATA							0x02U
+#define TEST_FAIL_SCAN_DATA							0x04U
+
+#define TEST_MANUF_SIZE									6U
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+/**
+  * @brief Emulated controller: advertising state and the payloads it holds
+  */
+typedef struct
+{
+	uint8_t Advertising;
+	uint16_t Interval_Min;
+	uint16_t Interval_Max;
+	uint8_t Adv_Data[ADVMGR_MAX_DATA];
+	uint8_t Adv_Length;
+	uint8_t Scan_Data[ADVMGR_MAX_DATA];
+	uint8_t Scan_Length;
+	uint8_t Fail;											/* TEST_FAIL_xxx */
+
+	uint32_t Starts;
+	uint32_t Stops;
+	uint32_t Adv_Updates;
+	uint32_t Scan_Updates;
+	uint32_t Misuses;									/* Commands not allowed in the current state */
+	uint32_t Start_Tick[TEST_MAX_STARTS];
+
+} Ctrl_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static uint32_t Tick;
+static Ctrl_t Ctrl;
+
+static const uint8_t Test_Name[] = {AD_TYPE_COMPLETE_LOCAL_NAME, 'B', 'L', 'E', '_', 'E', 'x'};
+
+/* Company identifier and payload of each slot used */
+static const uint8_t Test_Manuf[3][TEST_MANUF_SIZE] =
+{
+	{0x30, 0x00, 'A', 0x01, 0x02, 0x03},
+	{0x30, 0x00, 'B', 0x04, 0x05, 0x06},
+	{0x30, 0x00, 'C', 0x07, 0x08, 0x09},
+};
+
+static const AdvMgr_Phase_t Test_Default[] =
+{
+	{ADVMGR_FAST_MS, ADVMGR_FAST_INTERV_MIN, ADVMGR_FAST_INTERV_MAX},
+	{ADVMGR_NORMAL_MS, ADV_INTERV_MIN, ADV_INTERV_MAX},
+	{ADVMGR_FOREVER, ADVMGR_SLOW_INTERV_MIN, ADVMGR_SLOW_INTERV_MAX},
+};
+
+static const AdvMgr_Phase_t Test_Forever[] = {{ADVMGR_FOREVER, ADVMGR_FAST_INTERV_MIN, ADVMGR_FAST_INTERV_MAX}};
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+/* KV_Store.c is only linked for KVStore_CRC32(), the flash must not be reached */
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+	(void)TypeProgram;
+	(void)Address;
+	(void)Data;
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+	(void)pEraseInit;
+	(void)SectorError;
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return Tick;
+}
+
+/* Takes the fault injected in a command, if any */
+static uint8_t Ctrl_Fails(uint8_t Command)
+{
+	if(Ctrl.Fail & Command)
+	{
+		Ctrl.Fail &= (uint8_t)~Command;
+		return 1;
+	}
+	return 0;
+}
+
+/**
+  * @brief	AD structure of a type in the advertising data
+  * @retval	Offset of its length byte, -1 if absent
+  */
+static int Ctrl_FindAD(uint8_t Type)
+{
+	uint8_t i;
+
+	for(i = 0; (i + 1U) < Ctrl.Adv_Length; i = (uint8_t)(i + Ctrl.Adv_Data[i] + 1U))
+	{
+		if(Ctrl.Adv_Data[i + 1U] == Type)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+/* The flags and the local name, as the BlueNRG-2 builds them */
+tBleStatus aci_gap_set_discoverable(uint8_t Advertising_Type, uint16_t Advertising_Interval_Min,
+																		uint16_t Advertising_Interval_Max, uint8_t Own_Address_Type,
+																		uint8_t Advertising_Filter_Policy, uint8_t Local_Name_Length,
+																		uint8_t Local_Name[], uint8_t Service_Uuid_length,
+																		uint8_t Service_Uuid_List[], uint16_t Slave_Conn_Interval_Min,
+																		uint16_t Slave_Conn_Interval_Max)
+{
+	(void)Advertising_Type;
+	(void)Own_Address_Type;
+	(void)Advertising_Filter_Policy;
+	(void)Service_Uuid_length;
+	(void)Service_Uuid_List;
+	(void)Slave_Conn_Interval_Min;
+	(void)Slave_Conn_Interval_Max;
+
+	if(Ctrl.Advertising)
+	{
+		Ctrl.Misuses++;
+		return BLE_STATUS_NOT_ALLOWED;
+	}
+	if(Ctrl_Fails(TEST_FAIL_DISCOVERABLE))
+	{
+		return BLE_STATUS_ERROR;
+	}
+
+	Ctrl.Adv_Data[0] = 2;
+	Ctrl.Adv_Data[1] = AD_TYPE_FLAGS;
+	Ctrl.Adv_Data[2] = FLAG_BIT_LE_GENERAL_DISCOVERABLE_MODE | FLAG_BIT_BR_EDR_NOT_SUPPORTED;
+	Ctrl.Adv_Length = 3;
+	if(Local_Name_Length != 0U)
+	{
+		Ctrl.Adv_Data[3] = Local_Name_Length;
+		memcpy(&Ctrl.Adv_Data[4], Local_Name, Local_Name_Length);
+		Ctrl.Adv_Length = (uint8_t)(Ctrl.Adv_Length + 1U + Local_Name_Length);
+	}
+
+	Ctrl.Advertising = 1;
+	Ctrl.Interval_Min = Advertising_Interval_Min;
+	Ctrl.Interval_Max = Advertising_Interval_Max;
+	if(Ctrl.Starts < TEST_MAX_STARTS)
+	{
+		Ctrl.Start_Tick[Ctrl.Starts] = Tick;
+	}
+	Ctrl.Starts++;
+	return BLE_STATUS_SUCCESS;
+}
+
+tBleStatus aci_gap_set_non_discoverable(void)
+{
+	if(!Ctrl.Advertising)
+	{
+		Ctrl.Misuses++;
+		return BLE_STATUS_NOT_ALLOWED;
+	}
+
+	Ctrl.Advertising = 0;
+	Ctrl.Stops++;
+	return BLE_STATUS_SUCCESS;
+}
+
+/* Each AD structure given replaces the one of the same type, or is added */
+tBleStatus aci_gap_update_adv_data(uint8_t AdvDataLen, uint8_t AdvData[])
+{
+	uint8_t Data[ADVMGR_MAX_DATA], Length, i, Size, Old;
+	int Found;
+
+	if(!Ctrl.Advertising)
+	{
+		Ctrl.Misuses++;
+	}
+	if(Ctrl_Fails(TEST_FAIL_ADV_DATA))
+	{
+		return BLE_STATUS_ERROR;
+	}
+
+	memcpy(Data, Ctrl.Adv_Data, sizeof(Data));
+	Length = Ctrl.Adv_Length;
+	for(i = 0; i < AdvDataLen; i = (uint8_t)(i + Size))
+	{
+		Size = (uint8_t)(AdvData[i] + 1U);
+		Found = Ctrl_FindAD(AdvData[i + 1U]);
+		if(Found >= 0)
+		{
+			Old = (uint8_t)(Ctrl.Adv_Data[Found] + 1U);
+			memmove(&Ctrl.Adv_Data[Found], &Ctrl.Adv_Data[Found + Old], (size_t)(Ctrl.Adv_Length - (Found + Old)));
+			Ctrl.Adv_Length = (uint8_t)(Ctrl.Adv_Length - Old);
+		}
+		if((i + Size > AdvDataLen) || ((Ctrl.Adv_Length + Size) > ADVMGR_MAX_DATA))
+		{
+			memcpy(Ctrl.Adv_Data, Data, sizeof(Data));
+			Ctrl.Adv_Length = Length;
+			return BLE_STATUS_INVALID_PARAMS;
+		}
+		memcpy(&Ctrl.Adv_Data[Ctrl.Adv_Length], &AdvData[i], Size);
+		Ctrl.Adv_Length = (uint8_t)(Ctrl.Adv_Length + Size);
+	}
+
+	Ctrl.Adv_Updates++;
+	return BLE_STATUS_SUCCESS;
+}
+
+tBleStatus hci_le_set_scan_response_data(uint8_t Scan_Response_Data_Length, uint8_t Scan_Response_Data[31])
+{
+	if(Ctrl_Fails(TEST_FAIL_SCAN_DATA))
+	{
+		return BLE_STATUS_ERROR;
+	}
+
+	memcpy(Ctrl.Scan_Data, Scan_Response_Data, Scan_Response_Data_Length);
+	Ctrl.Scan_Length = Scan_Response_Data_Length;
+	Ctrl.Scan_Updates++;
+	return BLE_STATUS_SUCCESS;
+}
+
+/* A central connected: the controller stops advertising by itself */
+static void Ctrl_Connect(void)
+{
+	Ctrl.Advertising = 0;
+	AdvMgr_Connected();
+}
+
+/**
+  * @brief	The controller advertises the flags, the name and the manufacturer data given
+  * @param	pManuf: company identifier and payload, NULL for none
+  */
+static uint8_t Ctrl_Holds(const uint8_t *pManuf)
+{
+	int Manuf = Ctrl_FindAD(AD_TYPE_MANUFACTURER_SPECIFIC_DATA);
+
+	if(!Ctrl.Advertising || (Ctrl.Adv_Data[1] != AD_TYPE_FLAGS) || (Ctrl.Adv_Data[3] != sizeof(Test_Name)) ||
+		 (memcmp(&Ctrl.Adv_Data[4], Test_Name, sizeof(Test_Name)) != 0))
+	{
+		return 0;
+	}
+	if(pManuf == NULL)
+	{
+		return (Manuf < 0);
+	}
+
+	return (Manuf >= 0) && (Ctrl.Adv_Data[Manuf] == (TEST_MANUF_SIZE + 1U)) &&
+				 (memcmp(&Ctrl.Adv_Data[Manuf + 2], pManuf, TEST_MANUF_SIZE) == 0);
+}
+
+static void Test_Setup(void)
+{
+	memset(&Ctrl, 0, sizeof(Ctrl));
+	Tick = TEST_T0;
+	AdvMgr_Init();
+	(void)AdvMgr_SetName(Test_Name, sizeof(Test_Name));
+}
+
+/* Expected phase of the default schedule after Elapsed ms */
+static uint8_t Test_DefaultPhase(uint32_t Elapsed)
+{
+	if(Elapsed < ADVMGR_FAST_MS)
+	{
+		return 0;
+	}
+	return (Elapsed < (ADVMGR_FAST_MS + ADVMGR_NORMAL_MS)) ? 1U : 2U;
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	The schedule stepped every ms, then late: the phases end exactly ADVMGR_FAST_MS and
+  *					ADVMGR_NORMAL_MS later, whenever they are noticed
+  */
+static void Test_AdvMgr_Schedule(void)
+{
+	static const AdvMgr_Phase_t Finite[] = {{100, 32, 48}, {200, 160, 320}};
+	AdvMgr_Sched_t Sched;
+	uint32_t Elapsed, Step, Expected, Changes, Failed, Seed = 7;
+	uint8_t Changed;
+
+	/* Every ms through both ends, across the wrap around of the clock */
+	AdvMgr_SchedInit(&Sched, Test_Default, 3);
+	AdvMgr_SchedStart(&Sched, TEST_T0);
+	Changes = 0;
+	Failed = 0;
+	for(Elapsed = 0; Elapsed <= (ADVMGR_FAST_MS + ADVMGR_NORMAL_MS + 1000U); Elapsed++)
+	{
+		Changed = AdvMgr_SchedUpdate(&Sched, TEST_T0 + Elapsed);
+		Changes += Changed;
+		if(Changed != ((Elapsed == ADVMGR_FAST_MS) || (Elapsed == (ADVMGR_FAST_MS + ADVMGR_NORMAL_MS))))
+		{
+			Failed++;
+		}
+		if(AdvMgr_SchedPhase(&Sched) != &Test_Default[Test_DefaultPhase(Elapsed)])
+		{
+			Failed++;
+		}
+
+		Expected = (Elapsed < ADVMGR_FAST_MS) ? (ADVMGR_FAST_MS - Elapsed) :
+							 (Elapsed < (ADVMGR_FAST_MS + ADVMGR_NORMAL_MS)) ? (ADVMGR_FAST_MS + ADVMGR_NORMAL_MS - Elapsed) :
+							 UINT32_MAX;
+		if(AdvMgr_SchedRemaining(&Sched, TEST_T0 + Elapsed) != Expected)
+		{
+			Failed++;
+		}
+	}
+	HOST_CHECK((Changes == 2U) && (Failed == 0U));
+
+	/* Late calls: the next end is still counted from the previous one */
+	AdvMgr_SchedStart(&Sched, TEST_T0);
+	Elapsed = 0;
+	Failed = 0;
+	while(Elapsed < (ADVMGR_FAST_MS + ADVMGR_NORMAL_MS + 10000U))
+	{
+		Step = 1U + (Host_Rand(&Seed) % 5000U);
+		Elapsed += Step;
+		Changed = AdvMgr_SchedUpdate(&Sched, TEST_T0 + Elapsed);
+		if((Changed != (Test_DefaultPhase(Elapsed) != Test_DefaultPhase(Elapsed - Step))) ||
+			 (AdvMgr_SchedPhase(&Sched) != &Test_Default[Test_DefaultPhase(Elapsed)]))
+		{
+			Failed++;
+		}
+		if((Test_DefaultPhase(Elapsed) == 1U) &&
+			 (AdvMgr_SchedRemaining(&Sched, TEST_T0 + Elapsed) != (ADVMGR_FAST_MS + ADVMGR_NORMAL_MS - Elapsed)))
+		{
+			Failed++;
+		}
+	}
+	HOST_CHECK(Failed == 0U);
+
+	/* A call past both ends skips the second phase */
+	AdvMgr_SchedStart(&Sched, TEST_T0);
+	HOST_CHECK(AdvMgr_SchedUpdate(&Sched, TEST_T0 + ADVMGR_FAST_MS + ADVMGR_NORMAL_MS + 5U) == 1U);
+	HOST_CHECK(AdvMgr_SchedPhase(&Sched) == &Test_Default[2]);
+	HOST_CHECK(AdvMgr_SchedUpdate(&Sched, TEST_T0 + 0x7FFFFFFFU) == 0U);
+
+	/* A schedule of finite phases ends */
+	AdvMgr_SchedInit(&Sched, Finite, 2);
+	AdvMgr_SchedStart(&Sched, TEST_T0);
+	HOST_CHECK((AdvMgr_SchedUpdate(&Sched, TEST_T0 + 299U) == 1U) && (AdvMgr_SchedPhase(&Sched) == &Finite[1]));
+	HOST_CHECK(AdvMgr_SchedRemaining(&Sched, TEST_T0 + 299U) == 1U);
+	HOST_CHECK((AdvMgr_SchedUpdate(&Sched, TEST_T0 + 300U) == 1U) && (AdvMgr_SchedPhase(&Sched) == NULL));
+	HOST_CHECK(AdvMgr_SchedRemaining(&Sched, TEST_T0 + 300U) == 0U);
+}
+
+/**
+  * @brief	The manager follows the default schedule on the virtual clock: one restart at each end
+  *					of phase, with the intervals of the next one, and the manufacturer data sent again
+  */
+static void Test_AdvMgr_Phases(void)
+{
+	static const AdvMgr_Phase_t Finite[] = {{1000, 32, 48}};
+	const AdvMgr_Stats_t *pStats = AdvMgr_GetStats();
+	uint32_t Elapsed, Period, Failed, Restarts, Sent;
+
+	/* Processed every ms: the intervals change at the exact ends */
+	Test_Setup();
+	HOST_CHECK(AdvMgr_SetManufData(0, Test_Manuf[0], TEST_MANUF_SIZE) == ADVMGR_OK);
+	HOST_CHECK(AdvMgr_Start() == ADVMGR_OK);
+	HOST_CHECK(Ctrl_Holds(Test_Manuf[0]) && (Ctrl.Interval_Min == ADVMGR_FAST_INTERV_MIN) &&
+						 (Ctrl.Interval_Max == ADVMGR_FAST_INTERV_MAX));
+	Failed = 0;
+	for(Elapsed = 1; Elapsed <= (ADVMGR_FAST_MS + ADVMGR_NORMAL_MS + 1000U); Elapsed++)
+	{
+		Tick = TEST_T0 + Elapsed;
+		AdvMgr_Process();
+		if(!Ctrl_Holds(Test_Manuf[0]) || (AdvMgr_GetPhase() == NULL) || (AdvMgr_GetPhase()->Interval_Min != Ctrl.Interval_Min))
+		{
+			Failed++;
+		}
+	}
+	HOST_CHECK(Failed == 0U);
+	HOST_CHECK((Ctrl.Starts == 3U) && (Ctrl.Stops == 2U) && (Ctrl.Misuses == 0U));
+	HOST_CHECK(Ctrl.Start_Tick[1] == (TEST_T0 + ADVMGR_FAST_MS));
+	HOST_CHECK(Ctrl.Start_Tick[2] == (TEST_T0 + ADVMGR_FAST_MS + ADVMGR_NORMAL_MS));
+	HOST_CHECK((Ctrl.Interval_Min == ADVMGR_SLOW_INTERV_MIN) && (Ctrl.Interval_Max == ADVMGR_SLOW_INTERV_MAX));
+	HOST_CHECK((pStats->Starts == 1U) && (pStats->Phase_Changes == 2U) && (pStats->Adv_Updates == 3U));
+	HOST_CHECK(Ctrl.Adv_Updates == 3U);
+	Restarts = Ctrl.Stops;
+	Sent = Ctrl.Adv_Updates;
+
+	/* Processed every 250 ms: the ends are noticed late, the schedule does not drift */
+	for(Period = 7; Period <= 250U; Period += 243U)
+	{
+		Test_Setup();
+		(void)AdvMgr_SetManufData(0, Test_Manuf[0], TEST_MANUF_SIZE);
+		(void)AdvMgr_Start();
+		for(Elapsed = Period; Elapsed <= (ADVMGR_FAST_MS + ADVMGR_NORMAL_MS + 1000U); Elapsed += Period)
+		{
+			Tick = TEST_T0 + Elapsed;
+			AdvMgr_Process();
+		}
+		HOST_CHECK((Ctrl.Starts == 3U) && (Ctrl.Stops == 2U) && Ctrl_Holds(Test_Manuf[0]));
+		HOST_CHECK((Ctrl.Start_Tick[1] - TEST_T0 - ADVMGR_FAST_MS) < Period);
+		HOST_CHECK((Ctrl.Start_Tick[2] - TEST_T0 - ADVMGR_FAST_MS - ADVMGR_NORMAL_MS) < Period);
+	}
+
+	/* Connected in the second phase: nothing more until the next start, which is fast again */
+	Test_Setup();
+	(void)AdvMgr_Start();
+	Tick = TEST_T0 + ADVMGR_FAST_MS + 1000U;
+	AdvMgr_Process();
+	HOST_CHECK(Ctrl.Interval_Min == ADV_INTERV_MIN);
+	Ctrl_Connect();
+	HOST_CHECK(!AdvMgr_IsAdvertising() && (AdvMgr_GetPhase() == NULL));
+	for(Elapsed = 0; Elapsed < 600U; Elapsed++)
+	{
+		Tick += 1000U;
+		AdvMgr_Process();
+	}
+	HOST_CHECK((Ctrl.Starts == 2U) && (Ctrl.Stops == 1U) && !Ctrl.Advertising);
+	HOST_CHECK(AdvMgr_Start() == ADVMGR_OK);
+	HOST_CHECK((Ctrl.Starts == 3U) && (Ctrl.Stops == 1U) && (Ctrl.Interval_Min == ADVMGR_FAST_INTERV_MIN));
+	HOST_CHECK(Ctrl.Misuses == 0U);
+
+	/* Start while advertising restarts from the first phase */
+	Tick += ADVMGR_FAST_MS;
+	AdvMgr_Process();
+	HOST_CHECK(Ctrl.Interval_Min == ADV_INTERV_MIN);
+	HOST_CHECK((AdvMgr_Start() == ADVMGR_OK) && (Ctrl.Interval_Min == ADVMGR_FAST_INTERV_MIN));
+	HOST_CHECK((Ctrl.Stops == 3U) && (Ctrl.Misuses == 0U));
+
+	/* A schedule of finite phases stops advertising at its end */
+	Test_Setup();
+	HOST_CHECK(AdvMgr_SetSchedule(Finite, 1) == ADVMGR_OK);
+	(void)AdvMgr_Start();
+	Tick = TEST_T0 + 999U;
+	AdvMgr_Process();
+	HOST_CHECK(Ctrl.Advertising && AdvMgr_IsAdvertising());
+	Tick = TEST_T0 + 1000U;
+	AdvMgr_Process();
+	HOST_CHECK(!Ctrl.Advertising && !AdvMgr_IsAdvertising() && (AdvMgr_GetPhase() == NULL));
+	HOST_CHECK((Ctrl.Starts == 1U) && (Ctrl.Stops == 1U) && (Ctrl.Misuses == 0U));
+
+	/* A refused restart is retried at the next call */
+	Test_Setup();
+	(void)AdvMgr_SetManufData(0, Test_Manuf[0], TEST_MANUF_SIZE);
+	(void)AdvMgr_Start();
+	Ctrl.Fail = TEST_FAIL_DISCOVERABLE;
+	Tick = TEST_T0 + ADVMGR_FAST_MS;
+	AdvMgr_Process();
+	HOST_CHECK(!Ctrl.Advertising && (pStats->Errors == 1U));
+	HOST_CHECK((AdvMgr_GetPhase() != NULL) && (AdvMgr_GetPhase()->Interval_Min == ADV_INTERV_MIN));
+	Tick++;
+	AdvMgr_Process();
+	HOST_CHECK(Ctrl_Holds(Test_Manuf[0]) && (Ctrl.Interval_Min == ADV_INTERV_MIN) && (Ctrl.Starts == 2U));
+
+	printf("  default schedule over %u s: %u restarts, advertising data sent %u times\n",
+				 (ADVMGR_FAST_MS + ADVMGR_NORMAL_MS + 1000U) / 1000U, (unsigned int)Restarts, (unsigned int)Sent);
+}
+
+/**
+  * @brief	Payloads the controller already holds are not sent again, changed ones once
+  */
+static void Test_AdvMgr_Payloads(void)
+{
+	static const uint8_t Scan[] = {0x03, 0x03, 0x0F, 0x18};
+	static const uint8_t Scan2[] = {0x03, 0x03, 0x0A, 0x18};
+	const AdvMgr_Stats_t *pStats = AdvMgr_GetStats();
+	uint32_t k, Updates;
+
+	Test_Setup();
+	HOST_CHECK(AdvMgr_SetScanResponse(Scan, sizeof(Scan)) == ADVMGR_OK);
+	HOST_CHECK(AdvMgr_SetManufData(0, Test_Manuf[0], TEST_MANUF_SIZE) == ADVMGR_OK);
+	HOST_CHECK(AdvMgr_Start() == ADVMGR_OK);
+	HOST_CHECK(Ctrl_Holds(Test_Manuf[0]) && (Ctrl.Adv_Updates == 1U));
+
+	/* The same data set again and again */
+	for(k = 0; k < 10U; k++)
+	{
+		(void)AdvMgr_SetManufData(0, Test_Manuf[0], TEST_MANUF_SIZE);
+		Tick += 100U;
+		AdvMgr_Process();
+	}
+	HOST_CHECK((Ctrl.Adv_Updates == 1U) && (pStats->Adv_Skipped == 10U) && Ctrl_Holds(Test_Manuf[0]));
+
+	/* Changed: sent once, then skipped */
+	(void)AdvMgr_SetManufData(0, Test_Manuf[1], TEST_MANUF_SIZE);
+	AdvMgr_Process();
+	HOST_CHECK((Ctrl.Adv_Updates == 2U) && Ctrl_Holds(Test_Manuf[1]));
+	(void)AdvMgr_SetManufData(0, Test_Manuf[1], TEST_MANUF_SIZE);
+	AdvMgr_Process();
+	HOST_CHECK((Ctrl.Adv_Updates == 2U) && (pStats->Adv_Skipped == 11U));
+
+	/* Changed and changed back between two calls */
+	(void)AdvMgr_SetManufData(0, Test_Manuf[2], TEST_MANUF_SIZE);
+	(void)AdvMgr_SetManufData(0, Test_Manuf[1], TEST_MANUF_SIZE);
+	AdvMgr_Process();
+	HOST_CHECK((Ctrl.Adv_Updates == 2U) && (pStats->Adv_Skipped == 12U) && Ctrl_Holds(Test_Manuf[1]));
+
+	/* Another slot is not advertised */
+	(void)AdvMgr_SetManufData(1, Test_Manuf[2], TEST_MANUF_SIZE);
+	AdvMgr_Process();
+	HOST_CHECK((Ctrl.Adv_Updates == 2U) && Ctrl_Holds(Test_Manuf[1]));
+
+	/* Refused: tried again at the next change, even to the same data */
+	Ctrl.Fail = TEST_FAIL_ADV_DATA;
+	(void)AdvMgr_SetManufData(0, Test_Manuf[0], TEST_MANUF_SIZE);
+	AdvMgr_Process();
+	HOST_CHECK((pStats->Errors == 1U) && Ctrl_Holds(Test_Manuf[1]));
+	(void)AdvMgr_SetManufData(0, Test_Manuf[0], TEST_MANUF_SIZE);
+	AdvMgr_Process();
+	HOST_CHECK((Ctrl.Adv_Updates == 3U) && Ctrl_Holds(Test_Manuf[0]));
+
+	/* Scan response */
+	Updates = Ctrl.Scan_Updates;
+	HOST_CHECK(AdvMgr_SetScanResponse(Scan, sizeof(Scan)) == ADVMGR_OK);
+	HOST_CHECK((Ctrl.Scan_Updates == Updates) && (pStats->Scan_Skipped == 1U));
+	HOST_CHECK(AdvMgr_SetScanResponse(Scan2, sizeof(Scan2)) == ADVMGR_OK);
+	HOST_CHECK((Ctrl.Scan_Updates == (Updates + 1U)) && (memcmp(Ctrl.Scan_Data, Scan2, sizeof(Scan2)) == 0));
+	HOST_CHECK(AdvMgr_SetScanResponse(Scan2, sizeof(Scan2)) == ADVMGR_OK);
+	HOST_CHECK(Ctrl.Scan_Updates == (Updates + 1U));
+
+	/* Kept by the controller over a restart, not sent again */
+	HOST_CHECK(AdvMgr_Start() == ADVMGR_OK);
+	HOST_CHECK((Ctrl.Scan_Updates == (Updates + 1U)) && Ctrl_Holds(Test_Manuf[0]));
+
+	/* Refused: sent again at the next start */
+	Ctrl.Fail = TEST_FAIL_SCAN_DATA;
+	HOST_CHECK(AdvMgr_SetScanResponse(Scan, sizeof(Scan)) == ADVMGR_ERROR_ACI);
+	HOST_CHECK(memcmp(Ctrl.Scan_Data, Scan2, sizeof(Scan2)) == 0);
+	HOST_CHECK(AdvMgr_Start() == ADVMGR_OK);
+	HOST_CHECK((Ctrl.Scan_Updates == (Updates + 2U)) && (memcmp(Ctrl.Scan_Data, Scan, sizeof(Scan)) == 0));
+
+	/* Too large for what the name leaves */
+	HOST_CHECK(AdvMgr_SetManufData(0, Test_Manuf[0], ADVMGR_MAX_MANUF_DATA + 1U) == ADVMGR_ERROR_PARAM);
+	HOST_CHECK(AdvMgr_SetManufData(ADVMGR_MANUF_SLOTS, Test_Manuf[0], TEST_MANUF_SIZE) == ADVMGR_ERROR_PARAM);
+	HOST_CHECK(Ctrl.Misuses == 0U);
+}
+
+/**
+  * @brief	The manufacturer data rotates over the slots set with one update each, advertising is
+  *					never stopped for it
+  */
+static void Test_AdvMgr_Rotation(void)
+{
+	const AdvMgr_Stats_t *pStats = AdvMgr_GetStats();
+	uint32_t Elapsed, Failed, Updates, Stops, Rotated;
+	uint8_t Slot;
+
+	/* Three slots, a new one every second for a minute */
+	Test_Setup();
+	(void)AdvMgr_SetSchedule(Test_Forever, 1);
+	for(Slot = 0; Slot < 3U; Slot++)
+	{
+		(void)AdvMgr_SetManufData(Slot, Test_Manuf[Slot], TEST_MANUF_SIZE);
+	}
+	(void)AdvMgr_Start();
+	AdvMgr_SetRotation(1000);
+	Failed = 0;
+	for(Elapsed = 10; Elapsed <= 60000U; Elapsed += 10U)
+	{
+		Tick = TEST_T0 + Elapsed;
+		AdvMgr_Process();
+		if(!Ctrl_Holds(Test_Manuf[(Elapsed / 1000U) % 3U]))
+		{
+			Failed++;
+		}
+	}
+	HOST_CHECK(Failed == 0U);
+	HOST_CHECK((Ctrl.Starts == 1U) && (Ctrl.Stops == 0U) && (Ctrl.Misuses == 0U));
+	HOST_CHECK((pStats->Rotations == 60U) && (Ctrl.Adv_Updates == 61U) && (pStats->Adv_Updates == 61U));
+	Rotated = Ctrl.Adv_Updates;
+
+	/* Two slots of the same data: the rotation between them is not sent */
+	(void)AdvMgr_SetManufData(1, Test_Manuf[0], TEST_MANUF_SIZE);
+	AdvMgr_ResetStats();
+	Updates = Ctrl.Adv_Updates;
+	for(Elapsed = 60010U; Elapsed <= 90000U; Elapsed += 10U)
+	{
+		Tick = TEST_T0 + Elapsed;
+		AdvMgr_Process();
+	}
+	HOST_CHECK((pStats->Rotations == 30U) && (pStats->Adv_Skipped == 10U) && (pStats->Adv_Updates == 20U));
+	HOST_CHECK((Ctrl.Adv_Updates - Updates) == 20U);
+	HOST_CHECK((Ctrl.Starts == 1U) && (Ctrl.Stops == 0U));
+
+	/* With the default schedule the restarts are those of the phase changes only */
+	Test_Setup();
+	for(Slot = 0; Slot < 3U; Slot++)
+	{
+		(void)AdvMgr_SetManufData(Slot, Test_Manuf[Slot], TEST_MANUF_SIZE);
+	}
+	(void)AdvMgr_Start();
+	AdvMgr_SetRotation(700);
+	for(Elapsed = 10; Elapsed <= 60000U; Elapsed += 10U)
+	{
+		Tick = TEST_T0 + Elapsed;
+		AdvMgr_Process();
+	}
+	HOST_CHECK((Ctrl.Stops == 1U) && (pStats->Phase_Changes == 1U) && (pStats->Rotations == 85U));
+	HOST_CHECK(Ctrl_Holds(Test_Manuf[85U % 3U]));
+	Stops = Ctrl.Stops;
+
+	/* The slot advertised emptied: rebuilt without it from the next call, the next slot comes with
+	   the rotation */
+	Slot = (uint8_t)(85U % 3U);
+	(void)AdvMgr_SetManufData(Slot, NULL, 0);
+	AdvMgr_Process();
+	Tick += 10U;
+	AdvMgr_Process();
+	HOST_CHECK((Ctrl.Stops == (Stops + 1U)) && Ctrl_Holds(NULL));
+	Tick += 700U;
+	AdvMgr_Process();
+	HOST_CHECK(Ctrl_Holds(Test_Manuf[(Slot + 1U) % 3U]) && (Ctrl.Stops == (Stops + 1U)));
+
+	/* A single slot set does not rotate */
+	Test_Setup();
+	(void)AdvMgr_SetSchedule(Test_Forever, 1);
+	(void)AdvMgr_SetManufData(2, Test_Manuf[2], TEST_MANUF_SIZE);
+	(void)AdvMgr_Start();
+	AdvMgr_SetRotation(100);
+	for(Elapsed = 10; Elapsed <= 10000U; Elapsed += 10U)
+	{
+		Tick = TEST_T0 + Elapsed;
+		AdvMgr_Process();
+	}
+	HOST_CHECK(Ctrl_Holds(Test_Manuf[2]) && (pStats->Rotations == 0U) && (Ctrl.Adv_Updates == 1U));
+	HOST_CHECK(Ctrl.Misuses == 0U);
+
+	printf("  3 slots rotated every 1 s for 60 s: advertising data sent %u times, no restart\n", (unsigned int)Rotated);
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(void)
+{
+	HOST_RUN(Test_AdvMgr_Schedule);
+	HOST_RUN(Test_AdvMgr_Phases);
+	HOST_RUN(Test_AdvMgr_Payloads);
+	HOST_RUN(Test_AdvMgr_Rotation);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
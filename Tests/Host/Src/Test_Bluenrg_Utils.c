@@ -0,0 +1,1081 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Bluenrg_Utils.c
+  * @brief      : Host test of the BlueNRG-2 updater of bluenrg_utils.c against an emulated updater.
+	*								The emulator erases, programs and checks its flash as the updater does, and
+	*								computes ACI_HAL_UPDATER_CALC_CRC from 0 while the CRC unit starts from
+	*								0xFFFFFFFF.
+  * @author			:
+  **************************************************************************************************
+  *
+  * The updater is linked with Updater_Port.c, so the progress goes to KVSTORE_KEY_FW_UPDATE of a
+  * key-value store on the file-backed flash of Flash_Sim.c, and the CRCs to the CRC unit emulated
+  * below. The link to the BlueNRG-2 is lost after each command in turn; after a reset of both
+  * sides the same image must resume from the last verified sector, and another image must start
+  * over. Flipped bits, rejected blocks and erases, and the device configuration of the IFR are
+  * covered too. The commands of a whole image are printed for each block size.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Host_Test.h"
+#include "Flash_Sim.h"
+#include "KV_Store.h"
+#include "hci.h"
+#include "hci_tl.h"
+#include "bluenrg1_hal_aci.h"
+#include "bluenrg1_hci_le.h"
+#include "bluenrg_utils.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define TEST_IMAGE											"Test_Bluenrg_Utils.bin"
+
+#define TEST_OGF												((uint16_t)0x3F)
+#define TEST_OCF_PROG_DATA_BLK					((uint16_t)0x0027)
+
+/* Memory map of the BlueNRG-2, as seen by the updater */
+#define TEST_BASE_ADDRESS								0x10040000U
+#define TEST_FLASH_SIZE									(256U * 1024U)
+#define TEST_IFR_ADDRESS								0x10020000U
+#define TEST_SECTOR_SIZE								2048U
+#define TEST_SECTORS										(TEST_FLASH_SIZE / TEST_SECTOR_SIZE)
+
+#define TEST_UPDATER_VERSION						4U
+#define TEST_BUFFER_SIZE								70U				/* 64-byte blocks */
+#define TEST_BOOT_MS										35U				/* Reboot to the first answer */
+
+/* Tries of bluenrg_utils.c: a block is sent once and retried twice, an erase tried three times */
+#define TEST_BLOCK_TRIES								3U
+#define TEST_ERASE_TRIES								3U
+
+/* Image of the resume test: 20 sectors and a tail shorter than a block */
+#define TEST_RESUME_SIZE								((20U * TEST_SECTOR_SIZE) + 36U)
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t Flash[TEST_FLASH_SIZE];
+	uint8_t Ifr[TEST_SECTOR_SIZE];
+
+	uint8_t In_Updater;
+	uint32_t Ready_Tick;							/* Answers from this tick on, after a reboot */
+	uint8_t Mute;											/* The updater never answers */
+	uint8_t Version;
+	uint8_t Buffer_Size;
+	uint8_t Blue_Flag;								/* Valid: the application is started on reboot */
+	uint8_t Pending;									/* Block sent with hci_send_cmd_queued(), not waited for */
+	tBleStatus Pending_Status;
+
+	/* Faults */
+	uint32_t Cut_At;									/* First command lost with the link, 0: never */
+	uint8_t Dead;
+	uint8_t Reject_Blocks;						/* Next blocks answered with an error, not programmed */
+	uint8_t Reject_Erases;
+	uint32_t Corrupt_Block;						/* Block programmed with a bit flipped, 0: none */
+
+	/* Counters */
+	uint32_t Commands;
+	uint32_t Erases[TEST_SECTORS];
+	uint32_t Ifr_Erases;
+	uint32_t Blocks;									/* Programmed, queued or not */
+	uint32_t Sync_Blocks;							/* Sent with aci_hal_updater_prog_data_blk() */
+	uint32_t Crc_Calls;
+	uint32_t Reboots;
+	uint32_t Errors;									/* Misaligned, out of range, 0 bits to 1, out of sequence */
+
+} Upd_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static const KVStore_IO_t Test_IO =
+{
+	FlashSim_Erase,
+	FlashSim_Program,
+	FlashSim_Read,
+};
+
+static Upd_t Upd;
+static uint8_t Old_Flash[TEST_FLASH_SIZE];				/* Firmware before the update */
+static uint8_t Image[TEST_FLASH_SIZE];
+static uint8_t Other_Image[TEST_FLASH_SIZE];
+static uint32_t Image_Size;
+static uint32_t Seed = 0x5EC7012U;
+
+/* Source of program_device_chunked() */
+static const uint8_t *pSource;
+static uint32_t Fetched;
+static uint32_t Fetch_Fail_At;							/* Fetch answered with an error, 0: never */
+static uint32_t Fetches;
+
+CRC_HandleTypeDef hcrc;											/* Handle used by Updater_Port.c */
+static uint32_t Crc_Unit;
+static uint32_t Tick;
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+/**
+  * @brief	One word of the CRC-32 of the updater and of the STM32 CRC unit (poly 0x04C11DB7, MSB
+  *					first). Only the initial value differs: 0 for the updater, 0xFFFFFFFF for the unit.
+  */
+static uint32_t Test_Crc32Word(uint32_t Crc, uint32_t Word)
+{
+	uint8_t Bit;
+
+	Crc ^= Word;
+	for(Bit = 0; Bit < 32U; Bit++)
+	{
+		Crc = (Crc & 0x80000000U) ? ((Crc << 1) ^ 0x04C11DB7U) : (Crc << 1);
+	}
+	return Crc;
+}
+
+static uint32_t Test_Word(const uint8_t *pData)
+{
+	return (uint32_t)pData[0] | ((uint32_t)pData[1] << 8) | ((uint32_t)pData[2] << 16) | ((uint32_t)pData[3] << 24);
+}
+
+/* The store is only given the simulated flash, the HAL routines must not be reached */
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+	(void)TypeProgram;
+	(void)Address;
+	(void)Data;
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+	(void)pEraseInit;
+	(void)SectorError;
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+/* CRC unit, as MX_CRC_Init() configures it */
+uint32_t HAL_CRC_Accumulate(CRC_HandleTypeDef *pHandle, uint32_t pBuffer[], uint32_t BufferLength)
+{
+	uint32_t i;
+
+	HOST_CHECK(pHandle == &hcrc);
+	for(i = 0; i < BufferLength; i++)
+	{
+		Crc_Unit = Test_Crc32Word(Crc_Unit, pBuffer[i]);
+	}
+	return Crc_Unit;
+}
+
+uint32_t HAL_CRC_Calculate(CRC_HandleTypeDef *pHandle, uint32_t pBuffer[], uint32_t BufferLength)
+{
+	Crc_Unit = 0xFFFFFFFFU;
+	return HAL_CRC_Accumulate(pHandle, pBuffer, BufferLength);
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+	Tick += Delay;
+}
+
+/**
+  * @brief	Area of the flash or of the IFR at Address, NULL when out of both
+  */
+static uint8_t *Upd_Memory(uint32_t Address, uint32_t Length)
+{
+	if((Address >= TEST_BASE_ADDRESS) && (Length <= TEST_FLASH_SIZE) &&
+		 ((Address - TEST_BASE_ADDRESS) <= (TEST_FLASH_SIZE - Length)))
+	{
+		return &Upd.Flash[Address - TEST_BASE_ADDRESS];
+	}
+	if((Address >= TEST_IFR_ADDRESS) && (Length <= TEST_SECTOR_SIZE) &&
+		 ((Address - TEST_IFR_ADDRESS) <= (TEST_SECTOR_SIZE - Length)))
+	{
+		return &Upd.Ifr[Address - TEST_IFR_ADDRESS];
+	}
+	return NULL;
+}
+
+/**
+  * @brief	Count a command. It returns 1 when the link is lost, no answer comes back then.
+  *					Only the queued block may be waited for after another command was sent.
+  */
+static uint8_t Upd_Command(uint8_t Queued)
+{
+	if(!Queued && Upd.Pending)
+	{
+		Upd.Errors++;
+	}
+	Upd.Commands++;
+	if((Upd.Cut_At != 0U) && (Upd.Commands >= Upd.Cut_At))
+	{
+		Upd.Dead = 1;
+	}
+	return Upd.Dead;
+}
+
+/**
+  * @brief	The host waits for the application to boot (BlueNRG_Init()), while the updater does not
+  *					answer until it has booted
+  */
+static uint8_t Upd_Booted(void)
+{
+	if(Tick >= Upd.Ready_Tick)
+	{
+		return !(Upd.In_Updater && Upd.Mute);
+	}
+	if(!Upd.In_Updater)
+	{
+		Tick = Upd.Ready_Tick;
+		return 1;
+	}
+	return 0;
+}
+
+/**
+  * @brief	Updater command: lost with the link, or only answered by the updater once booted
+  */
+static tBleStatus Upd_Updater(void)
+{
+	if(Upd_Command(0) || !Upd_Booted())
+	{
+		return BLE_STATUS_TIMEOUT;
+	}
+	return Upd.In_Updater ? BLE_STATUS_SUCCESS : BLE_STATUS_NOT_ALLOWED;
+}
+
+/**
+  * @brief	Program a block. The flash only clears bits, and a block stays within one sector and
+  *					the updater buffer.
+  */
+static tBleStatus Upd_Program(uint32_t Address, uint16_t Length, const uint8_t *pData)
+{
+	uint8_t *pMemory = Upd_Memory(Address, Length);
+	uint16_t i;
+
+	if(Upd.Reject_Blocks)
+	{
+		Upd.Reject_Blocks--;
+		return BLE_STATUS_ERROR;
+	}
+	if((pMemory == NULL) || (Length == 0U) || ((Length & 3U) != 0U) || ((Address & 3U) != 0U) ||
+		 (Length > (uint16_t)(Upd.Buffer_Size - 6U)) ||
+		 ((Address / TEST_SECTOR_SIZE) != ((Address + Length - 1U) / TEST_SECTOR_SIZE)) ||
+		 (Address < (TEST_BASE_ADDRESS + TEST_SECTOR_SIZE) && (Address >= TEST_BASE_ADDRESS)))
+	{
+		Upd.Errors++;
+		return BLE_STATUS_INVALID_PARAMS;
+	}
+
+	for(i = 0; i < Length; i++)
+	{
+		if((pMemory[i] & pData[i]) != pData[i])
+		{
+			Upd.Errors++;
+		}
+		pMemory[i] &= pData[i];
+	}
+	Upd.Blocks++;
+	if(Upd.Blocks == Upd.Corrupt_Block)
+	{
+		pMemory[Length / 2U] ^= 0x10U;
+	}
+	return BLE_STATUS_SUCCESS;
+}
+
+/* Commands of the application firmware */
+tBleStatus aci_hal_updater_start(void)
+{
+	if(Upd_Command(0) || !Upd_Booted() || Upd.In_Updater)
+	{
+		return BLE_STATUS_TIMEOUT;
+	}
+	/* Reboots into the updater before answering */
+	Upd.In_Updater = 1;
+	Upd.Ready_Tick = Tick + TEST_BOOT_MS;
+	return BLE_STATUS_TIMEOUT;
+}
+
+tBleStatus hci_read_local_version_information(uint8_t *HCI_Version, uint16_t *HCI_Revision, uint8_t *LMP_PAL_Version,
+																							uint16_t *Manufacturer_Name, uint16_t *LMP_PAL_Subversion)
+{
+	*HCI_Version = 0x08;
+	*HCI_Revision = 0x3100;							/* Cut 3.1 */
+	*LMP_PAL_Version = 0x08;
+	*Manufacturer_Name = 0x0030;
+	*LMP_PAL_Subversion = 0x2113;
+	return BLE_STATUS_SUCCESS;
+}
+
+tBleStatus aci_hal_get_firmware_details(uint8_t *DTM_version_major, uint8_t *DTM_version_minor, uint8_t *DTM_version_patch,
+																				uint8_t *DTM_variant, uint16_t *DTM_Build_Number, uint8_t *BTLE_Stack_version_major,
+																				uint8_t *BTLE_Stack_version_minor, uint8_t *BTLE_Stack_version_patch,
+																				uint8_t *BTLE_Stack_development, uint16_t *BTLE_Stack_variant,
+																				uint16_t *BTLE_Stack_Build_Number)
+{
+	*DTM_version_major = 2;
+	*DTM_version_minor = 1;
+	*DTM_version_patch = 3;
+	*DTM_variant = 1;
+	*DTM_Build_Number = 0;
+	*BTLE_Stack_version_major = 2;
+	*BTLE_Stack_version_minor = 1;
+	*BTLE_Stack_version_patch = 3;
+	*BTLE_Stack_development = 0;
+	*BTLE_Stack_variant = 0;
+	*BTLE_Stack_Build_Number = 0;
+	return BLE_STATUS_SUCCESS;
+}
+
+/* Commands of the updater */
+tBleStatus aci_hal_updater_reboot(void)
+{
+	tBleStatus Status = Upd_Updater();
+
+	if(Status == BLE_STATUS_SUCCESS)
+	{
+		/* The updater stays in control until the BLUE flag is valid */
+		Upd.In_Updater = !Upd.Blue_Flag;
+		Upd.Ready_Tick = Tick + TEST_BOOT_MS;
+		Upd.Reboots++;
+	}
+	return Status;
+}
+
+tBleStatus aci_hal_get_updater_version(uint8_t *Version)
+{
+	tBleStatus Status = Upd_Updater();
+
+	if(Status == BLE_STATUS_SUCCESS)
+	{
+		*Version = Upd.Version;
+	}
+	return Status;
+}
+
+tBleStatus aci_hal_get_updater_bufsize(uint8_t *Buffer_Size)
+{
+	tBleStatus Status = Upd_Updater();
+
+	if(Status == BLE_STATUS_SUCCESS)
+	{
+		*Buffer_Size = Upd.Buffer_Size;
+	}
+	return Status;
+}
+
+tBleStatus aci_hal_updater_erase_blue_flag(void)
+{
+	tBleStatus Status = Upd_Updater();
+
+	if(Status == BLE_STATUS_SUCCESS)
+	{
+		Upd.Blue_Flag = 0;
+	}
+	return Status;
+}
+
+tBleStatus aci_hal_updater_reset_blue_flag(void)
+{
+	tBleStatus Status = Upd_Updater();
+
+	if(Status == BLE_STATUS_SUCCESS)
+	{
+		Upd.Blue_Flag = 1;
+	}
+	return Status;
+}
+
+tBleStatus aci_hal_updater_erase_sector(uint32_t Address)
+{
+	tBleStatus Status = Upd_Updater();
+	uint8_t *pMemory = Upd_Memory(Address, TEST_SECTOR_SIZE);
+
+	if(Status != BLE_STATUS_SUCCESS)
+	{
+		return Status;
+	}
+	if(Upd.Reject_Erases)
+	{
+		Upd.Reject_Erases--;
+		return BLE_STATUS_ERROR;
+	}
+	if((pMemory == NULL) || ((Address % TEST_SECTOR_SIZE) != 0U) || (Address == TEST_BASE_ADDRESS))
+	{
+		Upd.Errors++;
+		return BLE_STATUS_INVALID_PARAMS;
+	}
+
+	memset(pMemory, 0xFF, TEST_SECTOR_SIZE);
+	if(Address == TEST_IFR_ADDRESS)
+	{
+		Upd.Ifr_Erases++;
+	}
+	else
+	{
+		Upd.Erases[(Address - TEST_BASE_ADDRESS) / TEST_SECTOR_SIZE]++;
+	}
+	return BLE_STATUS_SUCCESS;
+}
+
+tBleStatus aci_hal_updater_prog_data_blk(uint32_t Address, uint16_t Data_Length, uint8_t Data[])
+{
+	tBleStatus Status = Upd_Updater();
+
+	if(Status != BLE_STATUS_SUCCESS)
+	{
+		return Status;
+	}
+	Upd.Sync_Blocks++;
+	return Upd_Program(Address, Data_Length, Data);
+}
+
+tBleStatus aci_hal_updater_read_data_blk(uint32_t Address, uint16_t Data_Length, uint8_t Data[])
+{
+	tBleStatus Status = Upd_Updater();
+
+	if(Status != BLE_STATUS_SUCCESS)
+	{
+		return Status;
+	}
+	/* Only the IFR can be read back */
+	if((Address < TEST_IFR_ADDRESS) || (Address >= TEST_BASE_ADDRESS) || (Upd_Memory(Address, Data_Length) == NULL) ||
+		 (Data_Length > (uint16_t)(Upd.Buffer_Size - 6U)))
+	{
+		Upd.Errors++;
+		return BLE_STATUS_INVALID_PARAMS;
+	}
+	memcpy(Data, Upd_Memory(Address, Data_Length), Data_Length);
+	return BLE_STATUS_SUCCESS;
+}
+
+/**
+  * @brief	ACI_HAL_UPDATER_CALC_CRC: CRC-32 of whole sectors, word by word from 0
+  */
+tBleStatus aci_hal_updater_calc_crc(uint32_t Address, uint8_t Num_Of_Sectors, uint32_t *crc)
+{
+	tBleStatus Status = Upd_Updater();
+	uint8_t *pMemory = Upd_Memory(Address, Num_Of_Sectors * TEST_SECTOR_SIZE);
+	uint32_t Crc = 0, i;
+
+	if(Status != BLE_STATUS_SUCCESS)
+	{
+		return Status;
+	}
+	if((pMemory == NULL) || (Num_Of_Sectors == 0U) || ((Address % TEST_SECTOR_SIZE) != 0U))
+	{
+		Upd.Errors++;
+		return BLE_STATUS_INVALID_PARAMS;
+	}
+	for(i = 0; i < (Num_Of_Sectors * TEST_SECTOR_SIZE); i += 4U)
+	{
+		Crc = Test_Crc32Word(Crc, Test_Word(&pMemory[i]));
+	}
+	*crc = Crc;
+	Upd.Crc_Calls++;
+	return BLE_STATUS_SUCCESS;
+}
+
+/**
+  * @brief	ACI_HAL_UPDATER_PROG_DATA_BLK sent ahead: programmed now, answered by
+  *					hci_wait_cmd_response(). The updater takes one command at a time.
+  */
+int hci_send_cmd_queued(struct hci_request *r)
+{
+	const uint8_t *pParam = (const uint8_t *)r->cparam;
+	uint32_t Address;
+	uint16_t Length;
+
+	HOST_CHECK((r->ogf == TEST_OGF) && (r->ocf == TEST_OCF_PROG_DATA_BLK) && (r->clen >= 6U));
+	if(Upd.Pending)
+	{
+		Upd.Errors++;
+		return -1;
+	}
+	if(Upd_Command(1))
+	{
+		return -1;
+	}
+
+	Address = Test_Word(pParam);
+	Length = (uint16_t)(pParam[4] | (pParam[5] << 8));
+	HOST_CHECK(r->clen == (6U + Length));
+	Upd.Pending = 1;
+	Upd.Pending_Status = Upd.In_Updater ? Upd_Program(Address, Length, &pParam[6]) : BLE_STATUS_NOT_ALLOWED;
+	return 0;
+}
+
+int hci_wait_cmd_response(struct hci_request *r)
+{
+	if(!Upd.Pending)
+	{
+		Upd.Errors++;
+		return -1;
+	}
+	Upd.Pending = 0;
+	if(Upd.Dead)
+	{
+		return -1;
+	}
+
+	HOST_CHECK((r->ogf == TEST_OGF) && (r->ocf == TEST_OCF_PROG_DATA_BLK) && (r->rlen == 1U));
+	*(uint8_t *)r->rparam = Upd.Pending_Status;
+	return 0;
+}
+
+/**
+  * @brief	Power-on of the BlueNRG-2 running its old firmware, with another updater buffer size
+  */
+static void Upd_PowerOn(uint8_t Buffer_Size)
+{
+	uint32_t i;
+
+	memset(&Upd, 0, sizeof(Upd));
+	for(i = 0; i < TEST_FLASH_SIZE; i++)
+	{
+		Old_Flash[i] = (uint8_t)Host_Rand(&Seed);
+	}
+	memcpy(Upd.Flash, Old_Flash, TEST_FLASH_SIZE);
+	for(i = 0; i < TEST_SECTOR_SIZE; i++)
+	{
+		Upd.Ifr[i] = (uint8_t)Host_Rand(&Seed);
+	}
+	Upd.Version = TEST_UPDATER_VERSION;
+	Upd.Buffer_Size = Buffer_Size;
+	Upd.Blue_Flag = 1;
+	Upd.Ready_Tick = Tick;
+}
+
+/**
+  * @brief	Reset of the BlueNRG-2 after a lost link: the flash is kept, and the updater starts
+  *					again by itself while the BLUE flag is erased. Counters start from 0.
+  */
+static void Upd_Reset(void)
+{
+	Upd.In_Updater = !Upd.Blue_Flag;
+	Upd.Ready_Tick = Tick + TEST_BOOT_MS;
+	Upd.Pending = 0;
+	Upd.Dead = 0;
+	Upd.Cut_At = 0;
+	Upd.Corrupt_Block = 0;
+	Upd.Commands = 0;
+	Upd.Blocks = 0;
+	Upd.Sync_Blocks = 0;
+	Upd.Crc_Calls = 0;
+	memset(Upd.Erases, 0, sizeof(Upd.Erases));
+}
+
+/**
+  * @brief	Reset of the host: flash reopened and store started again
+  */
+static void Test_Reboot(void)
+{
+	FlashSim_Close();
+	HOST_CHECK(FlashSim_Open(TEST_IMAGE, 2, KVSTORE_SECTOR_SIZE) == 0);
+	KVStore_RegisterIO(&Test_IO);
+	HOST_CHECK(KVStore_Init() == KVSTORE_OK);
+}
+
+static void Test_NewDevice(void)
+{
+	FlashSim_Close();
+	(void)remove(TEST_IMAGE);
+	Test_Reboot();
+}
+
+static void Test_MakeImage(uint8_t *pImage, uint32_t Size)
+{
+	uint32_t i;
+
+	for(i = 0; i < Size; i++)
+	{
+		pImage[i] = (uint8_t)Host_Rand(&Seed);
+	}
+}
+
+/* Source of program_device_chunked() */
+static int Test_Fetch(uint32_t offset, uint8_t *data, uint16_t size)
+{
+	Fetches++;
+	if((Fetch_Fail_At != 0U) && (Fetches >= Fetch_Fail_At))
+	{
+		return -1;
+	}
+	HOST_CHECK((size != 0U) && (offset < Image_Size) && (size <= (Image_Size - offset)));
+	if((offset >= Image_Size) || (size > (Image_Size - offset)))
+	{
+		return -1;
+	}
+	memcpy(data, pSource + offset, size);
+	Fetched += size;
+	return 0;
+}
+
+static int Test_Program(const uint8_t *pImage, uint32_t Size, uint8_t Chunked)
+{
+	pSource = pImage;
+	Image_Size = Size;
+	Fetched = 0;
+	Fetches = 0;
+	return Chunked ? program_device_chunked(Test_Fetch, Size) : program_device(pImage, Size);
+}
+
+/**
+  * @brief	Progress saved under KVSTORE_KEY_FW_UPDATE, 0 sectors when there is none
+  */
+static uint32_t Test_SectorsDone(uint32_t Size)
+{
+	updater_progress_t Progress;
+	uint16_t Length = sizeof(Progress);
+
+	if(KVStore_Read(KVSTORE_KEY_FW_UPDATE, &Progress, &Length) != KVSTORE_OK)
+	{
+		return 0;
+	}
+	HOST_CHECK((Length == sizeof(Progress)) && (Progress.fw_size == Size));
+	return Progress.sectors_done;
+}
+
+/**
+  * @brief	Flash after a complete update: updater sector and sectors past the image untouched,
+  *					the image, then 0xFF to the end of its last sector. The application is started and
+  *					the progress forgotten.
+  */
+static void Test_CheckUpdated(const uint8_t *pImage, uint32_t Size)
+{
+	uint32_t End = ((Size + TEST_SECTOR_SIZE - 1U) / TEST_SECTOR_SIZE) * TEST_SECTOR_SIZE;
+	uint32_t i;
+	uint8_t Erased = 1;
+
+	HOST_CHECK(memcmp(Upd.Flash, Old_Flash, TEST_SECTOR_SIZE) == 0);
+	HOST_CHECK(memcmp(&Upd.Flash[TEST_SECTOR_SIZE], &pImage[TEST_SECTOR_SIZE], Size - TEST_SECTOR_SIZE) == 0);
+	for(i = Size; i < End; i++)
+	{
+		Erased &= (Upd.Flash[i] == 0xFFU);
+	}
+	HOST_CHECK(Erased);
+	HOST_CHECK(memcmp(&Upd.Flash[End], &Old_Flash[End], TEST_FLASH_SIZE - End) == 0);
+
+	HOST_CHECK(Upd.Blue_Flag && !Upd.In_Updater);
+	HOST_CHECK((Upd.Errors == 0U) && !Upd.Pending);
+	HOST_CHECK(Test_SectorsDone(Size) == 0U);
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	Inverting the first word makes the CRC unit, which starts from 0xFFFFFFFF, give the
+  *					CRC of the updater, which starts from 0
+  */
+static void Test_Utils_Crc(void)
+{
+	uint32_t Words[TEST_SECTOR_SIZE / 4U];
+	uint32_t Updater, Unit, First, Count, i, n;
+
+	for(n = 0; n < 200U; n++)
+	{
+		Count = 1U + (Host_Rand(&Seed) % (TEST_SECTOR_SIZE / 4U));
+		Updater = 0;
+		for(i = 0; i < Count; i++)
+		{
+			Words[i] = (n & 1U) ? Host_Rand(&Seed) : 0xFFFFFFFFU;
+			Updater = Test_Crc32Word(Updater, Words[i]);
+		}
+
+		/* Both initial values matter... */
+		Unit = HAL_CRC_Calculate(&hcrc, Words, Count);
+		HOST_CHECK(Unit != Updater);
+
+		/* ...and the inverted first word makes up for them */
+		First = Words[0] ^ 0xFFFFFFFFU;
+		Unit = HAL_CRC_Calculate(&hcrc, &First, 1);
+		if(Count > 1U)
+		{
+			Unit = HAL_CRC_Accumulate(&hcrc, &Words[1], Count - 1U);
+		}
+		HOST_CHECK(Unit == Updater);
+	}
+}
+
+/**
+  * @brief	Whole images of every size class, from memory and through the read callback, with
+  *					64, 32 and 8-byte blocks. Every sector of the image is erased once, programmed and
+  *					checked with one CALC_CRC; each byte is fetched once.
+  */
+static void Test_Utils_Program(void)
+{
+	static const uint32_t Sizes[] =
+	{
+		TEST_SECTOR_SIZE + 4U, TEST_SECTOR_SIZE + 64U, 2U * TEST_SECTOR_SIZE, (7U * TEST_SECTOR_SIZE) + 36U,
+		(40U * TEST_SECTOR_SIZE) + 1000U, TEST_FLASH_SIZE,
+	};
+	static const uint8_t Buffer_Sizes[] = {TEST_BUFFER_SIZE, 38U, 20U};
+	static const uint16_t Block_Sizes[] = {64U, 32U, 8U};
+	uint32_t Sectors, s, Erased;
+	uint8_t b, i, Chunked;
+
+	for(b = 0; b < sizeof(Buffer_Sizes); b++)
+	{
+		for(i = 0; i < (sizeof(Sizes) / sizeof(Sizes[0])); i++)
+		{
+			Chunked = (i + b) & 1U;
+			Upd_PowerOn(Buffer_Sizes[b]);
+			Test_NewDevice();
+			Test_MakeImage(Image, Sizes[i]);
+
+			HOST_CHECK(Test_Program(Image, Sizes[i], Chunked) == BLE_UTIL_SUCCESS);
+			Test_CheckUpdated(Image, Sizes[i]);
+
+			Sectors = (Sizes[i] + TEST_SECTOR_SIZE - 1U) / TEST_SECTOR_SIZE;
+			Erased = 0;
+			for(s = 0; s < TEST_SECTORS; s++)
+			{
+				Erased += (Upd.Erases[s] == (uint32_t)((s >= 1U) && (s < Sectors)));
+			}
+			HOST_CHECK(Erased == TEST_SECTORS);
+			HOST_CHECK(Upd.Crc_Calls == (Sectors - 1U));
+			HOST_CHECK(Upd.Blocks == (((Sizes[i] - TEST_SECTOR_SIZE) + Block_Sizes[b] - 1U) / Block_Sizes[b]));
+			HOST_CHECK(Upd.Sync_Blocks == (uint32_t)((Sizes[i] % Block_Sizes[b]) != 0U));
+			HOST_CHECK(!Chunked || (Fetched == (Sizes[i] - TEST_SECTOR_SIZE)));
+			HOST_CHECK(Upd.Reboots == 1U);
+
+			if(Sizes[i] == TEST_FLASH_SIZE)
+			{
+				printf("  %2u-byte blocks: 256 KB image in %lu commands, %lu blocks\n", Block_Sizes[b],
+							 (unsigned long)Upd.Commands, (unsigned long)Upd.Blocks);
+			}
+		}
+	}
+}
+
+/**
+  * @brief	The link is lost at each command of an update in turn. After a reset of the host and of
+  *					the BlueNRG-2, the same image resumes from the sectors recorded under
+  *					KVSTORE_KEY_FW_UPDATE, which must all hold the image.
+  */
+static void Test_Utils_Resume(void)
+{
+	uint32_t Sectors = (TEST_RESUME_SIZE + TEST_SECTOR_SIZE - 1U) / TEST_SECTOR_SIZE;
+	uint32_t Commands, Cut, Done, Resumed = 0, Skipped = 0, s;
+	uint8_t Chunked;
+
+	Upd_PowerOn(TEST_BUFFER_SIZE);
+	Test_NewDevice();
+	Test_MakeImage(Image, TEST_RESUME_SIZE);
+	HOST_CHECK(Test_Program(Image, TEST_RESUME_SIZE, 0) == BLE_UTIL_SUCCESS);
+	Commands = Upd.Commands;
+
+	for(Cut = 1; Cut <= Commands; Cut++)
+	{
+		Upd_PowerOn(TEST_BUFFER_SIZE);
+		Test_NewDevice();
+		Upd.Cut_At = Cut;
+		Chunked = Cut & 1U;
+
+		/* Only the reboot, last command, may be lost with the update complete */
+		HOST_CHECK((Test_Program(Image, TEST_RESUME_SIZE, Chunked) == BLE_UTIL_SUCCESS) == (Cut == Commands));
+		HOST_CHECK((Upd.Errors == 0U) && Upd.Dead);
+
+		Done = Test_SectorsDone(TEST_RESUME_SIZE);
+		HOST_CHECK(Done <= Sectors);
+		if(Done > 1U)
+		{
+			HOST_CHECK(memcmp(&Upd.Flash[TEST_SECTOR_SIZE], &Image[TEST_SECTOR_SIZE],
+												((Done * TEST_SECTOR_SIZE) < TEST_RESUME_SIZE ? (Done * TEST_SECTOR_SIZE) : TEST_RESUME_SIZE) -
+												TEST_SECTOR_SIZE) == 0);
+		}
+		else
+		{
+			Done = 1;
+		}
+
+		Test_Reboot();
+		Upd_Reset();
+		HOST_CHECK(Test_Program(Image, TEST_RESUME_SIZE, Chunked) == BLE_UTIL_SUCCESS);
+		Test_CheckUpdated(Image, TEST_RESUME_SIZE);
+
+		for(s = 1; s < Sectors; s++)
+		{
+			HOST_CHECK(Upd.Erases[s] == (uint32_t)(s >= Done));
+		}
+		/* Verified with one CALC_CRC of the whole range: each byte is fetched once, for the CRC or
+		   to be programmed */
+		HOST_CHECK(Upd.Crc_Calls == ((Sectors - Done) + (Done > 1U)));
+		HOST_CHECK(!Chunked || (Fetched == (TEST_RESUME_SIZE - TEST_SECTOR_SIZE)));
+
+		Resumed += (Done > 1U);
+		Skipped += Done - 1U;
+	}
+
+	printf("  %lu commands an update, %lu resumed updates, %lu sectors not programmed again\n",
+				 (unsigned long)Commands, (unsigned long)Resumed, (unsigned long)Skipped);
+	HOST_CHECK(Resumed > (Commands / 2U));
+}
+
+/**
+  * @brief	Progress of another image, or of the same image over a flash changed since, is not
+  *					resumed: the update starts over from the first sector
+  */
+static void Test_Utils_ResumeOther(void)
+{
+	uint32_t Sectors = (TEST_RESUME_SIZE + TEST_SECTOR_SIZE - 1U) / TEST_SECTOR_SIZE;
+	uint32_t s, Erased;
+	uint8_t Case;
+
+	for(Case = 0; Case < 3U; Case++)
+	{
+		Upd_PowerOn(TEST_BUFFER_SIZE);
+		Test_NewDevice();
+		Test_MakeImage(Image, TEST_RESUME_SIZE);
+		memcpy(Other_Image, Image, TEST_RESUME_SIZE);
+		Upd.Cut_At = 400;
+		HOST_CHECK(Test_Program(Image, TEST_RESUME_SIZE, 0) == BLE_UTIL_ACI_ERROR);
+		HOST_CHECK(Test_SectorsDone(TEST_RESUME_SIZE) > 2U);
+
+		Test_Reboot();
+		Upd_Reset();
+		switch(Case)
+		{
+			case 0:
+				/* Same size, one word changed in the first sector */
+				Other_Image[TEST_SECTOR_SIZE + 100U] ^= 0x01U;
+				HOST_CHECK(Test_Program(Other_Image, TEST_RESUME_SIZE, 1) == BLE_UTIL_SUCCESS);
+				Test_CheckUpdated(Other_Image, TEST_RESUME_SIZE);
+				break;
+			case 1:
+				/* Same image, one sector erased by another tool meanwhile */
+				memset(&Upd.Flash[2U * TEST_SECTOR_SIZE], 0xFF, TEST_SECTOR_SIZE);
+				HOST_CHECK(Test_Program(Image, TEST_RESUME_SIZE, 0) == BLE_UTIL_SUCCESS);
+				Test_CheckUpdated(Image, TEST_RESUME_SIZE);
+				break;
+			default:
+				/* Shorter image */
+				Sectors--;
+				HOST_CHECK(Test_Program(Image, TEST_RESUME_SIZE - TEST_SECTOR_SIZE, 1) == BLE_UTIL_SUCCESS);
+				HOST_CHECK(memcmp(&Upd.Flash[TEST_SECTOR_SIZE], &Image[TEST_SECTOR_SIZE],
+													TEST_RESUME_SIZE - (2U * TEST_SECTOR_SIZE)) == 0);
+				HOST_CHECK(Test_SectorsDone(TEST_RESUME_SIZE - TEST_SECTOR_SIZE) == 0U);
+				break;
+		}
+
+		Erased = 0;
+		for(s = 1; s < Sectors; s++)
+		{
+			Erased += Upd.Erases[s];
+		}
+		HOST_CHECK(Erased == (Sectors - 1U));
+	}
+}
+
+/**
+  * @brief	A bit flipped while programming fails the CALC_CRC of its sector. The sectors before it
+  *					stay recorded, and the next update resumes from the failed one.
+  */
+static void Test_Utils_CrcError(void)
+{
+	uint32_t Sectors = (TEST_RESUME_SIZE + TEST_SECTOR_SIZE - 1U) / TEST_SECTOR_SIZE;
+	uint32_t Blocks_Per_Sector = TEST_SECTOR_SIZE / 64U;
+	uint32_t s;
+
+	Upd_PowerOn(TEST_BUFFER_SIZE);
+	Test_NewDevice();
+	Test_MakeImage(Image, TEST_RESUME_SIZE);
+
+	/* Sixth block of sector 5 */
+	Upd.Corrupt_Block = (4U * Blocks_Per_Sector) + 6U;
+	HOST_CHECK(Test_Program(Image, TEST_RESUME_SIZE, 1) == BLE_UTIL_CRC_ERROR);
+	HOST_CHECK(Test_SectorsDone(TEST_RESUME_SIZE) == 5U);
+	HOST_CHECK(!Upd.Blue_Flag && (Upd.Errors == 0U));
+
+	Test_Reboot();
+	Upd_Reset();
+	HOST_CHECK(Test_Program(Image, TEST_RESUME_SIZE, 1) == BLE_UTIL_SUCCESS);
+	Test_CheckUpdated(Image, TEST_RESUME_SIZE);
+	for(s = 1; s < Sectors; s++)
+	{
+		HOST_CHECK(Upd.Erases[s] == (uint32_t)(s >= 5U));
+	}
+
+	/* Flipped in the short tail block, sent on its own */
+	Upd_PowerOn(TEST_BUFFER_SIZE);
+	Test_NewDevice();
+	Upd.Corrupt_Block = ((TEST_RESUME_SIZE - TEST_SECTOR_SIZE) + 63U) / 64U;
+	HOST_CHECK(Test_Program(Image, TEST_RESUME_SIZE, 0) == BLE_UTIL_CRC_ERROR);
+	HOST_CHECK(Test_SectorsDone(TEST_RESUME_SIZE) == (Sectors - 1U));
+}
+
+/**
+  * @brief	Rejected blocks are sent again synchronously, rejected erases tried again, up to their
+  *					number of tries
+  */
+static void Test_Utils_Retry(void)
+{
+	uint8_t Rejects;
+
+	for(Rejects = 1; Rejects <= TEST_BLOCK_TRIES; Rejects++)
+	{
+		Upd_PowerOn(TEST_BUFFER_SIZE);
+		Test_NewDevice();
+		Test_MakeImage(Image, 3U * TEST_SECTOR_SIZE);
+		Upd.Reject_Blocks = Rejects;
+		if(Rejects < TEST_BLOCK_TRIES)
+		{
+			HOST_CHECK(Test_Program(Image, 3U * TEST_SECTOR_SIZE, Rejects & 1U) == BLE_UTIL_SUCCESS);
+			Test_CheckUpdated(Image, 3U * TEST_SECTOR_SIZE);
+			HOST_CHECK(Upd.Sync_Blocks == Rejects);
+		}
+		else
+		{
+			HOST_CHECK(Test_Program(Image, 3U * TEST_SECTOR_SIZE, 0) == BLE_UTIL_ACI_ERROR);
+			HOST_CHECK((Upd.Errors == 0U) && !Upd.Pending);
+		}
+	}
+
+	for(Rejects = 1; Rejects <= TEST_ERASE_TRIES; Rejects++)
+	{
+		Upd_PowerOn(TEST_BUFFER_SIZE);
+		Test_NewDevice();
+		Test_MakeImage(Image, 3U * TEST_SECTOR_SIZE);
+		Upd.Reject_Erases = Rejects;
+		if(Rejects < TEST_ERASE_TRIES)
+		{
+			HOST_CHECK(Test_Program(Image, 3U * TEST_SECTOR_SIZE, 1) == BLE_UTIL_SUCCESS);
+			Test_CheckUpdated(Image, 3U * TEST_SECTOR_SIZE);
+		}
+		else
+		{
+			HOST_CHECK(Test_Program(Image, 3U * TEST_SECTOR_SIZE, 1) == BLE_UTIL_ACI_ERROR);
+			HOST_CHECK(Upd.Blocks == 0U);
+		}
+	}
+}
+
+/**
+  * @brief	Wrong image sizes, updater versions, an updater that never answers and a source that
+  *					fails
+  */
+static void Test_Utils_Errors(void)
+{
+	static const uint32_t Sizes[] = {0U, TEST_SECTOR_SIZE, TEST_SECTOR_SIZE + 2U, TEST_FLASH_SIZE + 4U};
+	uint32_t Start;
+	uint8_t i;
+
+	Upd_PowerOn(TEST_BUFFER_SIZE);
+	Test_NewDevice();
+	Test_MakeImage(Image, TEST_FLASH_SIZE);
+	for(i = 0; i < (sizeof(Sizes) / sizeof(Sizes[0])); i++)
+	{
+		HOST_CHECK(program_device(Image, Sizes[i]) == BLE_UTIL_WRONG_IMAGE_SIZE);
+	}
+	HOST_CHECK(Upd.Commands == 0U);
+
+	for(i = 2; i <= 6U; i += 4U)
+	{
+		Upd_PowerOn(TEST_BUFFER_SIZE);
+		Upd.Version = i;
+		HOST_CHECK(Test_Program(Image, 4U * TEST_SECTOR_SIZE, 0) == BLE_UTIL_UNSUPPORTED_VERSION);
+		HOST_CHECK(Upd.Blue_Flag && (Upd.Erases[1] == 0U));
+	}
+
+	/* Never booted */
+	Upd_PowerOn(TEST_BUFFER_SIZE);
+	Upd.Mute = 1;
+	Start = Tick;
+	HOST_CHECK(Test_Program(Image, 4U * TEST_SECTOR_SIZE, 0) == BLE_UTIL_ACI_ERROR);
+	HOST_CHECK((Tick - Start) >= 100U);
+	HOST_CHECK(Upd.Blue_Flag);
+
+	/* Source failing at its first fetch and while a block is in flight */
+	for(i = 1; i <= 2U; i++)
+	{
+		Upd_PowerOn(TEST_BUFFER_SIZE);
+		Test_NewDevice();
+		Fetch_Fail_At = i;
+		HOST_CHECK(Test_Program(Image, 4U * TEST_SECTOR_SIZE, 1) == BLE_UTIL_PARSE_ERROR);
+		HOST_CHECK((Upd.Errors == 0U) && !Upd.Pending);
+		HOST_CHECK(Test_SectorsDone(4U * TEST_SECTOR_SIZE) == 0U);
+	}
+	Fetch_Fail_At = 0;
+}
+
+/**
+  * @brief	Device configuration written into the IFR sector, the rest of the sector kept, then
+  *					verified. The same configuration again is not programmed.
+  */
+static void Test_Utils_DevConfig(void)
+{
+	uint8_t Ifr[TEST_SECTOR_SIZE];
+	devConfig_t Config;
+
+	Upd_PowerOn(TEST_BUFFER_SIZE);
+	memcpy(Ifr, Upd.Ifr, TEST_SECTOR_SIZE);
+
+	memset(&Config, 0, sizeof(Config));
+	Config.HS_crystal = 0x01;
+	Config.LS_source = 0x01;
+	Config.SMPS_management = 0x01;
+	Config.HS_startup_time = 0x0107;
+	Config.SlaveSCA = 100;
+	Config.MasterSCA = 0x04;
+	Config.max_conn_event_length = 0xFFFFFFFFU;
+	memcpy(Ifr, &Config, sizeof(Config));
+
+	HOST_CHECK(verify_DEV_CONFIG(&Config) == BLE_UTIL_WRONG_VERIFY);
+	HOST_CHECK(program_DEV_CONFIG(&Config) == BLE_UTIL_SUCCESS);
+	HOST_CHECK(memcmp(Upd.Ifr, Ifr, TEST_SECTOR_SIZE) == 0);
+	HOST_CHECK((Upd.Ifr_Erases == 1U) && (Upd.Errors == 0U) && !Upd.In_Updater);
+	HOST_CHECK(verify_DEV_CONFIG(&Config) == BLE_UTIL_SUCCESS);
+
+	HOST_CHECK(program_DEV_CONFIG(&Config) == BLE_UTIL_SUCCESS);
+	HOST_CHECK(Upd.Ifr_Erases == 1U);
+
+	/* The flipped bit must fail the CRC of the IFR sector too */
+	Config.SlaveSCA = 50;
+	Upd.Corrupt_Block = Upd.Blocks + 1U;
+	HOST_CHECK(program_DEV_CONFIG(&Config) == BLE_UTIL_CRC_ERROR);
+}
+
+static void Test_Utils_Version(void)
+{
+	uint8_t Hw = 0;
+	uint16_t Fw = 0;
+
+	HOST_CHECK(getBlueNRGVersion(&Hw, &Fw) == BLE_UTIL_SUCCESS);
+	HOST_CHECK((Hw == 0x31U) && (Fw == 0x0213U));
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(void)
+{
+	HOST_RUN(Test_Utils_Crc);
+	HOST_RUN(Test_Utils_Program);
+	HOST_RUN(Test_Utils_Resume);
+	HOST_RUN(Test_Utils_ResumeOther);
+	HOST_RUN(Test_Utils_CrcError);
+	HOST_RUN(Test_Utils_Retry);
+	HOST_RUN(Test_Utils_Errors);
+	HOST_RUN(Test_Utils_DevConfig);
+	HOST_RUN(Test_Utils_Version);
+
+	FlashSim_Close();
+	(void)remove(TEST_IMAGE);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
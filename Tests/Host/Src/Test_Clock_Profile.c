@@ -0,0 +1,229 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Clock_Profile.c
+  * @brief      : Host test of ClockProfile_Compute(). Every profile of the table is checked against
+	*								the device limits and the clocks it must give, then altered profiles check
+	*								each rejection.
+  * @author			:
+  **************************************************************************************************
+  *
+  * Build with -DCLOCKPROFILE_SWITCH_ENABLE=0: only the computation, which has no hardware
+  * dependency, is compiled.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include "Host_Test.h"
+#include "Clock_Profile.h"
+#include "custom_bus.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define TEST_UART_BAUDRATE							115200U
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+/* Clocks a profile of the table must give */
+typedef struct
+{
+	ClockProfile_Id_t Id;
+	uint32_t SysClk;
+	uint32_t HClk;
+	uint32_t PClk1;
+	uint32_t PClk2;
+	uint32_t TimClk1;
+	uint32_t Flash_Latency;
+	uint32_t SPI_Baudrate;
+
+} Test_Expected_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Same tables as system_stm32f4xx.c */
+const uint8_t AHBPrescTable[16] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 6, 7, 8, 9};
+const uint8_t APBPrescTable[8]  = {0, 0, 0, 0, 1, 2, 3, 4};
+
+static const Test_Expected_t Expected[CLOCK_PROFILE_COUNT] =
+{
+	{ CLOCK_PROFILE_BURST_DSP,			100000000U, 100000000U, 50000000U, 100000000U, 100000000U, FLASH_LATENCY_3, 6250000U },
+	{ CLOCK_PROFILE_BLE_STREAMING,	64000000U,	64000000U,	32000000U, 64000000U,  64000000U,  FLASH_LATENCY_1, 8000000U },
+	{ CLOCK_PROFILE_IDLE_LOW_POWER, 16000000U,	4000000U,		4000000U,	 4000000U,	 4000000U,	 FLASH_LATENCY_0, 2000000U },
+};
+
+/* Highest HCLK for 0 to 3 flash wait states, VDD 2.7 V - 3.6 V (RM0383) */
+static const uint32_t Latency_HClk_Max[] = {30000000U, 64000000U, 90000000U, 100000000U};
+
+/* Console baud rates each profile must keep within CLOCKPROFILE_UART_ERROR_MAX */
+static const uint32_t Baudrates[] = {9600U, 19200U, 38400U, 57600U, 115200U};
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+/**
+  * @brief	SPI1 prescaler of custom_bus.c: the smallest division keeping SPI1 under
+  *					BUS_SPI1_BAUDRATE
+  */
+uint32_t BSP_SPI1_GetPrescaler(uint32_t clock_src_hz)
+{
+	uint32_t Shift = 0;
+
+	while(((clock_src_hz >> (Shift + 1U)) > BUS_SPI1_BAUDRATE) && (Shift < 7U))
+	{
+		Shift++;
+	}
+
+	return Shift << SPI_CR1_BR_Pos;
+}
+
+/**
+  * @brief	Device limits and derived settings every accepted profile must meet
+  */
+static void Test_CheckLimits(const ClockProfile_Freq_t *pFreq, uint32_t UART_Baudrate)
+{
+	uint32_t Error;
+
+	HOST_CHECK(pFreq->SysClk <= CLOCKPROFILE_SYSCLK_MAX);
+	HOST_CHECK(pFreq->HClk <= pFreq->SysClk);
+	HOST_CHECK(pFreq->PClk1 <= CLOCKPROFILE_PCLK1_MAX);
+	HOST_CHECK(pFreq->PClk2 <= CLOCKPROFILE_PCLK2_MAX);
+
+	/* TIM2 counts microseconds */
+	HOST_CHECK((pFreq->TimClk1 / (pFreq->TIM2_Prescaler + 1U)) == 1000000U);
+	HOST_CHECK((pFreq->TimClk1 % (pFreq->TIM2_Prescaler + 1U)) == 0U);
+
+	/* Enough wait states for HCLK, and not more than needed */
+	HOST_CHECK(pFreq->Flash_Latency < (sizeof(Latency_HClk_Max) / sizeof(Latency_HClk_Max[0])));
+	HOST_CHECK(pFreq->HClk <= Latency_HClk_Max[pFreq->Flash_Latency]);
+	HOST_CHECK((pFreq->Flash_Latency == FLASH_LATENCY_0) || (pFreq->HClk > Latency_HClk_Max[pFreq->Flash_Latency - 1U]));
+
+	/* Fastest SPI1 divider under the BlueNRG-2 maximum */
+	HOST_CHECK(pFreq->SPI_Baudrate <= BUS_SPI1_BAUDRATE);
+	HOST_CHECK((pFreq->SPI_Prescaler == SPI_BAUDRATEPRESCALER_2) || ((2U * pFreq->SPI_Baudrate) > BUS_SPI1_BAUDRATE));
+	HOST_CHECK(pFreq->SPI_Baudrate == (pFreq->PClk2 >> (((pFreq->SPI_Prescaler & SPI_CR1_BR) >> SPI_CR1_BR_Pos) + 1U)));
+
+	HOST_CHECK(pFreq->UART_BRR >= 16U);
+	Error = (pFreq->UART_Baudrate > UART_Baudrate) ? (pFreq->UART_Baudrate - UART_Baudrate) : (UART_Baudrate - pFreq->UART_Baudrate);
+	HOST_CHECK((Error * 1000U) <= (UART_Baudrate * CLOCKPROFILE_UART_ERROR_MAX));
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	Each profile of the table gives its expected clocks and stays within the limits
+  */
+static void Test_ClockProfile_Table(void)
+{
+	const ClockProfile_t *pProfile;
+	ClockProfile_Freq_t Freq;
+	uint32_t i, b;
+
+	for(i = 0; i < CLOCK_PROFILE_COUNT; i++)
+	{
+		pProfile = ClockProfile_GetProfile(Expected[i].Id);
+		HOST_CHECK(pProfile != NULL);
+		if(pProfile == NULL)
+		{
+			continue;
+		}
+
+		HOST_CHECK(ClockProfile_Compute(pProfile, TEST_UART_BAUDRATE, &Freq) == CLOCKPROFILE_OK);
+		HOST_CHECK(Freq.SysClk == Expected[i].SysClk);
+		HOST_CHECK(Freq.HClk == Expected[i].HClk);
+		HOST_CHECK(Freq.PClk1 == Expected[i].PClk1);
+		HOST_CHECK(Freq.PClk2 == Expected[i].PClk2);
+		HOST_CHECK(Freq.TimClk1 == Expected[i].TimClk1);
+		HOST_CHECK(Freq.Flash_Latency == Expected[i].Flash_Latency);
+		HOST_CHECK(Freq.SPI_Baudrate == Expected[i].SPI_Baudrate);
+		Test_CheckLimits(&Freq, TEST_UART_BAUDRATE);
+
+		for(b = 0; b < (sizeof(Baudrates) / sizeof(Baudrates[0])); b++)
+		{
+			HOST_CHECK(ClockProfile_Compute(pProfile, Baudrates[b], &Freq) == CLOCKPROFILE_OK);
+			Test_CheckLimits(&Freq, Baudrates[b]);
+		}
+	}
+
+	HOST_CHECK(ClockProfile_GetProfile(CLOCK_PROFILE_COUNT) == NULL);
+}
+
+/**
+  * @brief	BLE_STREAMING is the profile running SPI1 exactly at the BlueNRG-2 maximum
+  */
+static void Test_ClockProfile_Streaming(void)
+{
+	ClockProfile_Freq_t Freq;
+
+	HOST_CHECK(ClockProfile_Compute(ClockProfile_GetProfile(CLOCK_PROFILE_BLE_STREAMING), TEST_UART_BAUDRATE, &Freq) == CLOCKPROFILE_OK);
+	HOST_CHECK(Freq.SPI_Baudrate == BUS_SPI1_BAUDRATE);
+	HOST_CHECK(Freq.SPI_Prescaler == SPI_BAUDRATEPRESCALER_8);
+	HOST_CHECK(Freq.TIM2_Prescaler == 63U);
+	HOST_CHECK(Freq.UART_BRR == 0x22CU);
+}
+
+/**
+  * @brief	Profiles breaking one rule each are rejected
+  */
+static void Test_ClockProfile_Rejected(void)
+{
+	ClockProfile_t Profile;
+	ClockProfile_Freq_t Freq;
+	const ClockProfile_t *pBurst = ClockProfile_GetProfile(CLOCK_PROFILE_BURST_DSP);
+	const ClockProfile_t *pIdle = ClockProfile_GetProfile(CLOCK_PROFILE_IDLE_LOW_POWER);
+
+	HOST_CHECK(ClockProfile_Compute(NULL, TEST_UART_BAUDRATE, &Freq) == CLOCKPROFILE_ERROR_PARAM);
+	HOST_CHECK(ClockProfile_Compute(pBurst, TEST_UART_BAUDRATE, NULL) == CLOCKPROFILE_ERROR_PARAM);
+	HOST_CHECK(ClockProfile_Compute(pBurst, 0, &Freq) == CLOCKPROFILE_ERROR_PARAM);
+
+	/* Neither the HSI nor the PLL */
+	Profile = *pBurst;
+	Profile.SysClk_Source = 0x00000001U;
+	HOST_CHECK(ClockProfile_Compute(&Profile, TEST_UART_BAUDRATE, &Freq) == CLOCKPROFILE_ERROR_PARAM);
+
+	/* PLL dividers out of their fields */
+	Profile = *pBurst;
+	Profile.PLLM = 1;
+	HOST_CHECK(ClockProfile_Compute(&Profile, TEST_UART_BAUDRATE, &Freq) == CLOCKPROFILE_ERROR_RANGE);
+	Profile = *pBurst;
+	Profile.PLLQ = 16;
+	HOST_CHECK(ClockProfile_Compute(&Profile, TEST_UART_BAUDRATE, &Freq) == CLOCKPROFILE_ERROR_RANGE);
+
+	/* VCO input under 1 MHz, VCO output over 432 MHz (for a valid 55 MHz SYSCLK) */
+	Profile = *pBurst;
+	Profile.PLLM = 20;
+	HOST_CHECK(ClockProfile_Compute(&Profile, TEST_UART_BAUDRATE, &Freq) == CLOCKPROFILE_ERROR_RANGE);
+	Profile = *pBurst;
+	Profile.PLLM = 8;
+	Profile.PLLN = 220;
+	Profile.PLLP = RCC_PLLP_DIV8;
+	HOST_CHECK(ClockProfile_Compute(&Profile, TEST_UART_BAUDRATE, &Freq) == CLOCKPROFILE_ERROR_RANGE);
+
+	/* SYSCLK over 100 MHz, APB1 over 50 MHz */
+	Profile = *pBurst;
+	Profile.PLLN = 240;
+	HOST_CHECK(ClockProfile_Compute(&Profile, TEST_UART_BAUDRATE, &Freq) == CLOCKPROFILE_ERROR_RANGE);
+	Profile = *pBurst;
+	Profile.APB1_Divider = RCC_HCLK_DIV1;
+	HOST_CHECK(ClockProfile_Compute(&Profile, TEST_UART_BAUDRATE, &Freq) == CLOCKPROFILE_ERROR_RANGE);
+
+	/* 99.5 MHz: TIM2 cannot count whole microseconds */
+	Profile = *pBurst;
+	Profile.PLLN = 199;
+	HOST_CHECK(ClockProfile_Compute(&Profile, TEST_UART_BAUDRATE, &Freq) == CLOCKPROFILE_ERROR_RANGE);
+
+	/* 4 MHz on APB2: no USART divider for 460800 baud, 2.1% error at 230400 */
+	HOST_CHECK(ClockProfile_Compute(pIdle, 460800U, &Freq) == CLOCKPROFILE_ERROR_RANGE);
+	HOST_CHECK(ClockProfile_Compute(pIdle, 230400U, &Freq) == CLOCKPROFILE_ERROR_RANGE);
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(void)
+{
+	HOST_RUN(Test_ClockProfile_Table);
+	HOST_RUN(Test_ClockProfile_Streaming);
+	HOST_RUN(Test_ClockProfile_Rejected);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,792 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Dsp_Pipeline.c
+  * @brief      : Host test of Dsp_Pipeline.c and Dsp_Endpoints.c: chains fed from files and written
+	*								to files, checked against the same CMSIS-DSP kernels wired by hand with
+	*								their own buffers, then the DMA source and the BLE sink.
+  * @author			:
+  **************************************************************************************************
+  *
+  * Two chains are run:
+  *  - spectrum: q15 to float, DC blocker in place, decimation by 4, FFT of 256, power (the
+  *    example of Dsp_Pipeline.c): the decimated output is accumulated. Also run with a gain
+  *    not in place instead of the DC blocker, so that the accumulation spans three buffers;
+  *  - resampling: q15 to float, gain in place, interpolation by 4, FIR, output gain: the
+  *    interpolated output is sliced, and read while the nodes after the FIR run.
+  * Their output must be bit exact with the hand-wired chains, the buffers planned must stay
+  * within Arena_Used, and the tone of the test signal must come out in its FFT bin.
+  *
+  * A recorded q15 file can be run through the spectrum chain instead:
+  *   test_dsp_pipeline <q15 file> <power file>       power spectra of 128 float32_t bins
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include <math.h>
+#include "Host_Test.h"
+#include "Dsp_Pipeline.h"
+#include "Dsp_Endpoints.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* Spectrum chain */
+#define TEST_BLOCK											64U
+#define TEST_DEC_M											4U
+#define TEST_DEC_TAPS										16U
+#define TEST_FFT_N											256U
+#define TEST_BINS												(TEST_FFT_N / 2U)
+#define TEST_BLOCKS_PER_FRAME						((TEST_FFT_N * TEST_DEC_M) / TEST_BLOCK)
+
+/* Resampling chain */
+#define TEST_B_BLOCK										32U
+#define TEST_INTERP_L										4U
+#define TEST_INTERP_TAPS								16U
+#define TEST_FIR_TAPS										8U
+
+/* Test signal: DC, a tone in bin TEST_TONE_BIN of the decimated FFT, noise */
+#define TEST_SAMPLES										(TEST_BLOCK * TEST_BLOCKS_PER_FRAME * 20U)
+#define TEST_TONE_BIN										20U
+#define TEST_DC													3000
+#define TEST_AMPLITUDE									8000.0f
+#define TEST_NOISE											500U
+
+#define TEST_FRAMES											(TEST_SAMPLES / (TEST_BLOCK * TEST_BLOCKS_PER_FRAME))
+#define TEST_B_BLOCKS										(TEST_SAMPLES / TEST_B_BLOCK)
+#define TEST_B_OUT											(TEST_B_BLOCKS * TEST_B_BLOCK * TEST_INTERP_L)
+
+#define TEST_ARENA_WORDS								1024U
+#define TEST_GUARD											((uint8_t)0xA5)
+
+#define TEST_TX_UNLIMITED								0xFFFFFFFFU
+
+#define TEST_FIRE_NONE								((uint8_t)0xFF)
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+/* Instances and states of the kernels of both chains */
+typedef struct
+{
+	arm_biquad_casd_df1_inst_f32 Hp;
+	float32_t Hp_State[4];
+	arm_fir_decimate_instance_f32 Dec;
+	float32_t Dec_State[TEST_DEC_TAPS + TEST_BLOCK - 1U];
+	arm_rfft_fast_instance_f32 Fft;
+
+	float32_t Gain;
+	float32_t Out_Gain;
+	arm_fir_interpolate_instance_f32 Interp;
+	float32_t Interp_State[(TEST_INTERP_TAPS / TEST_INTERP_L) + TEST_B_BLOCK - 1U];
+	arm_fir_instance_f32 Fir;
+	float32_t Fir_State[TEST_FIR_TAPS + TEST_B_BLOCK - 1U];
+
+} Test_Chain_t;
+
+/* File sink that also completes a DMA half while the chain is busy */
+typedef struct
+{
+	Pipe_FileSink_t File;
+	Pipe_DmaSource_t *pSource;
+	uint8_t Fire;											/* Half to complete at the next block, 0xFF for none */
+
+} Test_Sink_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static Test_Chain_t Chain;
+static Test_Chain_t Reference;
+
+/* DC blocker: y[n] = x[n] - x[n-1] + 0.99 y[n-1] */
+static const float32_t Hp_Coeffs[5] = {1.0f, -1.0f, 0.0f, 0.99f, 0.0f};
+static float32_t Dec_Coeffs[TEST_DEC_TAPS];
+static float32_t Interp_Coeffs[TEST_INTERP_TAPS];
+static float32_t Fir_Coeffs[TEST_FIR_TAPS];
+
+static void Test_ToQ15(void *pContext, void *pIn, void *pOut, uint16_t Samples);
+
+static const Pipe_Node_t Spectrum_Nodes[] =
+{
+	PIPE_NODE_Q15_TO_F32(TEST_BLOCK),
+	PIPE_NODE_BIQUAD_F32(&Chain.Hp, TEST_BLOCK),
+	PIPE_NODE_DECIMATE_F32(&Chain.Dec, TEST_BLOCK, TEST_DEC_M),
+	PIPE_NODE_RFFT_F32(&Chain.Fft, TEST_FFT_N),
+	PIPE_NODE_POWER_F32(TEST_FFT_N),
+};
+
+/* A gain not in place: the converted block, its scaled copy and the decimated samples apart */
+static const Pipe_Node_t Scaled_Spectrum_Nodes[] =
+{
+	PIPE_NODE_Q15_TO_F32(TEST_BLOCK),
+	PIPE_NODE(Pipe_Scale_f32, &Chain.Gain, TEST_BLOCK, TEST_BLOCK, 4U, 4U, 0U),
+	PIPE_NODE_DECIMATE_F32(&Chain.Dec, TEST_BLOCK, TEST_DEC_M),
+	PIPE_NODE_RFFT_F32(&Chain.Fft, TEST_FFT_N),
+	PIPE_NODE_POWER_F32(TEST_FFT_N),
+};
+
+/* The last node only for a q15 sink */
+static const Pipe_Node_t Resample_Nodes[] =
+{
+	PIPE_NODE_Q15_TO_F32(TEST_B_BLOCK),
+	PIPE_NODE_SCALE_F32(&Chain.Gain, TEST_B_BLOCK),
+	PIPE_NODE_INTERPOLATE_F32(&Chain.Interp, TEST_B_BLOCK, TEST_INTERP_L),
+	PIPE_NODE_FIR_F32(&Chain.Fir, TEST_B_BLOCK),
+	PIPE_NODE(Pipe_Scale_f32, &Chain.Out_Gain, TEST_B_BLOCK, TEST_B_BLOCK, 4U, 4U, 0U),
+	PIPE_NODE(Test_ToQ15, NULL, TEST_B_BLOCK, TEST_B_BLOCK, 4U, 2U, 0U),
+};
+
+static Pipe_t Pipe;
+static uint32_t Arena[TEST_ARENA_WORDS];
+
+static int16_t Signal[TEST_SAMPLES];
+static float32_t Expected[TEST_B_OUT];
+static float32_t Output[TEST_B_OUT];
+static int16_t Expected_Q15[TEST_B_OUT];
+
+/* BlueNRG_NotifySamples() */
+static int16_t Notified[TEST_B_OUT];
+static uint32_t Notified_Count;
+static uint32_t Tx_Budget;
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+/**
+  * @brief	Notification of BLE_Process.c, sends as many samples as the TX buffers take
+  */
+uint16_t BlueNRG_NotifySamples(const int16_t *pSamples, uint16_t Count, uint8_t Channels)
+{
+	uint16_t Sent = (Count < Tx_Budget) ? Count : (uint16_t)Tx_Budget;
+
+	HOST_CHECK(Channels == 1U);
+	HOST_CHECK((Notified_Count + Sent) <= TEST_B_OUT);
+	if((Notified_Count + Sent) > TEST_B_OUT)
+	{
+		return 0;
+	}
+
+	memcpy(&Notified[Notified_Count], pSamples, (uint32_t)Sent * sizeof(int16_t));
+	Notified_Count += Sent;
+	if(Tx_Budget != TEST_TX_UNLIMITED)
+	{
+		Tx_Budget -= Sent;
+	}
+
+	return Sent;
+}
+
+/**
+  * @brief	Stage converting back to q15 for the BLE sink
+  */
+static void Test_ToQ15(void *pContext, void *pIn, void *pOut, uint16_t Samples)
+{
+	(void)pContext;
+	arm_float_to_q15((float32_t *)pIn, (q15_t *)pOut, Samples);
+}
+
+/**
+  * @brief	Windowed sinc low pass, cutoff Fc of the sample rate, DC gain Gain
+  */
+static void Test_LowPass(float32_t *pCoeffs, uint16_t Taps, float32_t Fc, float32_t Gain)
+{
+	float32_t Sum = 0.0f, x;
+	uint16_t i;
+
+	for(i = 0; i < Taps; i++)
+	{
+		x = (float32_t)i - ((float32_t)(Taps - 1U) / 2.0f);
+		pCoeffs[i] = (x == 0.0f) ? (2.0f * Fc) : (sinf(2.0f * PI * Fc * x) / (PI * x));
+		pCoeffs[i] *= 0.5f - (0.5f * cosf((2.0f * PI * (float32_t)i) / (float32_t)(Taps - 1U)));
+		Sum += pCoeffs[i];
+	}
+	for(i = 0; i < Taps; i++)
+	{
+		pCoeffs[i] *= Gain / Sum;
+	}
+}
+
+/**
+  * @brief	Kernel instances with cleared states
+  */
+static void Test_InitChain(Test_Chain_t *pChain)
+{
+	memset(pChain, 0, sizeof(Test_Chain_t));
+
+	arm_biquad_cascade_df1_init_f32(&pChain->Hp, 1, (float32_t *)Hp_Coeffs, pChain->Hp_State);
+	HOST_CHECK(arm_fir_decimate_init_f32(&pChain->Dec, TEST_DEC_TAPS, TEST_DEC_M, Dec_Coeffs, pChain->Dec_State, TEST_BLOCK) == ARM_MATH_SUCCESS);
+	HOST_CHECK(arm_rfft_fast_init_f32(&pChain->Fft, TEST_FFT_N) == ARM_MATH_SUCCESS);
+
+	pChain->Gain = 0.5f;
+	pChain->Out_Gain = 1.5f;
+	HOST_CHECK(arm_fir_interpolate_init_f32(&pChain->Interp, TEST_INTERP_L, TEST_INTERP_TAPS, Interp_Coeffs,
+																					pChain->Interp_State, TEST_B_BLOCK) == ARM_MATH_SUCCESS);
+	arm_fir_init_f32(&pChain->Fir, TEST_FIR_TAPS, Fir_Coeffs, pChain->Fir_State, TEST_B_BLOCK);
+}
+
+static void Test_MakeSignal(void)
+{
+	uint32_t Seed = 43;
+	float32_t Phase;
+	uint32_t i;
+
+	Test_LowPass(Dec_Coeffs, TEST_DEC_TAPS, 0.5f / TEST_DEC_M, 1.0f);
+	Test_LowPass(Interp_Coeffs, TEST_INTERP_TAPS, 0.5f / TEST_INTERP_L, (float32_t)TEST_INTERP_L);
+	Test_LowPass(Fir_Coeffs, TEST_FIR_TAPS, 0.2f, 1.0f);
+
+	for(i = 0; i < TEST_SAMPLES; i++)
+	{
+		Phase = (2.0f * PI * (float32_t)(TEST_TONE_BIN * i)) / (float32_t)(TEST_FFT_N * TEST_DEC_M);
+		Signal[i] = (int16_t)(TEST_DC + (int32_t)(TEST_AMPLITUDE * sinf(Phase)) +
+													(int32_t)(Host_Rand(&Seed) % (2U * TEST_NOISE)) - (int32_t)TEST_NOISE);
+	}
+}
+
+/**
+  * @brief	Spectrum chain wired by hand, a buffer per kernel
+  * @param	Scaled: the gain instead of the DC blocker
+  * @retval	Frames written to pOut, TEST_BINS each
+  */
+static uint32_t Test_RefSpectrum(const int16_t *pIn, uint32_t Blocks, uint8_t Scaled, float32_t *pOut)
+{
+	static float32_t Block[TEST_BLOCK];
+	static float32_t Filtered[TEST_BLOCK];
+	static float32_t Decimated[TEST_FFT_N];
+	static float32_t Spectrum[TEST_FFT_N];
+	uint32_t b, Fill = 0, Frames = 0;
+
+	Test_InitChain(&Reference);
+	for(b = 0; b < Blocks; b++)
+	{
+		arm_q15_to_float((q15_t *)&pIn[b * TEST_BLOCK], Block, TEST_BLOCK);
+		if(Scaled)
+		{
+			arm_scale_f32(Block, Reference.Gain, Filtered, TEST_BLOCK);
+		}
+		else
+		{
+			arm_biquad_cascade_df1_f32(&Reference.Hp, Block, Filtered, TEST_BLOCK);
+		}
+		arm_fir_decimate_f32(&Reference.Dec, Filtered, &Decimated[Fill], TEST_BLOCK);
+		Fill += TEST_BLOCK / TEST_DEC_M;
+		if(Fill < TEST_FFT_N)
+		{
+			continue;
+		}
+
+		arm_rfft_fast_f32(&Reference.Fft, Decimated, Spectrum, 0);
+		pOut[0] = Spectrum[0] * Spectrum[0];
+		arm_cmplx_mag_squared_f32(&Spectrum[2], &pOut[1], TEST_BINS - 1U);
+		pOut += TEST_BINS;
+		Frames++;
+		Fill = 0;
+	}
+
+	return Frames;
+}
+
+/**
+  * @brief	Resampling chain wired by hand
+  * @retval	Samples written to pOut
+  */
+static uint32_t Test_RefResample(const int16_t *pIn, uint32_t Blocks, float32_t *pOut)
+{
+	static float32_t Block[TEST_B_BLOCK];
+	static float32_t Scaled[TEST_B_BLOCK];
+	static float32_t Interpolated[TEST_B_BLOCK * TEST_INTERP_L];
+	static float32_t Filtered[TEST_B_BLOCK];
+	uint32_t b, s, Samples = 0;
+
+	Test_InitChain(&Reference);
+	for(b = 0; b < Blocks; b++)
+	{
+		arm_q15_to_float((q15_t *)&pIn[b * TEST_B_BLOCK], Block, TEST_B_BLOCK);
+		arm_scale_f32(Block, Reference.Gain, Scaled, TEST_B_BLOCK);
+		arm_fir_interpolate_f32(&Reference.Interp, Scaled, Interpolated, TEST_B_BLOCK);
+		for(s = 0; s < TEST_INTERP_L; s++)
+		{
+			arm_fir_f32(&Reference.Fir, &Interpolated[s * TEST_B_BLOCK], Filtered, TEST_B_BLOCK);
+			arm_scale_f32(Filtered, Reference.Out_Gain, &pOut[Samples], TEST_B_BLOCK);
+			Samples += TEST_B_BLOCK;
+		}
+	}
+
+	return Samples;
+}
+
+/**
+  * @brief	Fill the arena past the planned buffers, to find writes out of them
+  */
+static void Test_GuardArena(uint32_t Used)
+{
+	memset((uint8_t *)Arena + Used, TEST_GUARD, sizeof(Arena) - Used);
+}
+
+static uint8_t Test_ArenaIntact(uint32_t Used)
+{
+	const uint8_t *p = (const uint8_t *)Arena;
+	uint32_t i;
+
+	for(i = Used; i < sizeof(Arena); i++)
+	{
+		if(p[i] != TEST_GUARD)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/**
+  * @brief	Read back what a file sink wrote
+  */
+static uint32_t Test_ReadBack(FILE *pFile, void *pData, uint32_t Bytes)
+{
+	rewind(pFile);
+	return (uint32_t)fread(pData, 1, Bytes, pFile);
+}
+
+/**
+  * @brief	Sink of the DMA test: writes to its file, and completes a half when asked to
+  */
+static void Test_DmaSink(void *pContext, void *pData, uint16_t Samples)
+{
+	Test_Sink_t *pSink = (Test_Sink_t *)pContext;
+
+	Pipe_FileSink(&pSink->File, pData, Samples);
+	if(pSink->Fire == 0U)
+	{
+		Pipe_DmaSource_HalfComplete(pSink->pSource);
+	}
+	else if(pSink->Fire == 1U)
+	{
+		Pipe_DmaSource_Complete(pSink->pSource);
+	}
+	pSink->Fire = TEST_FIRE_NONE;
+}
+
+/**
+  * @brief	The DMA writes a block of the signal in a half, then calls the interrupt callback
+  */
+static void Test_DmaWrite(Pipe_DmaSource_t *pSource, const int16_t *pBlock, uint8_t Half)
+{
+	uint32_t Bytes = Pipe_BlockBytes(pSource->pPipe);
+
+	memcpy(&pSource->pBuffer[Half * Bytes], pBlock, Bytes);
+	if(Half == 0U)
+	{
+		Pipe_DmaSource_HalfComplete(pSource);
+	}
+	else
+	{
+		Pipe_DmaSource_Complete(pSource);
+	}
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	Chains rejected, buffers planned, in-place run on the pushed block
+  */
+static void Test_Pipe_Plan(void)
+{
+	static float32_t Block[TEST_BLOCK];
+	Pipe_FileSink_t Sink = {NULL, 4, 0};
+	Pipe_Node_t Nodes[PIPE_MAX_NODES + 1U];
+	float32_t Scale = 2.0f;
+	uint32_t i;
+
+	Test_InitChain(&Chain);
+
+	/* Spectrum: the example of Dsp_Pipeline.c, two buffers of 256 floats */
+	HOST_CHECK(Pipe_ArenaSize(Spectrum_Nodes, 5) == (2U * TEST_FFT_N * sizeof(float32_t)));
+	HOST_CHECK(Pipe_Init(&Pipe, Spectrum_Nodes, 5, Pipe_FileSink, &Sink, Arena, sizeof(Arena)) == PIPE_OK);
+	HOST_CHECK((Pipe_GetStats(&Pipe)->Buffers == 2U) && (Pipe_GetStats(&Pipe)->In_Place == 1U));
+	HOST_CHECK(Pipe_BlockBytes(&Pipe) == (TEST_BLOCK * sizeof(int16_t)));
+
+	/* Resampling: the converted block scaled in place, the FIR output in the same buffer, the
+	   output gain apart from the interpolated block still sliced */
+	HOST_CHECK(Pipe_ArenaSize(Resample_Nodes, 5) == ((TEST_B_BLOCK + (TEST_B_BLOCK * TEST_INTERP_L) + TEST_B_BLOCK) * sizeof(float32_t)));
+	HOST_CHECK(Pipe_Init(&Pipe, Resample_Nodes, 5, Pipe_FileSink, &Sink, Arena, sizeof(Arena)) == PIPE_OK);
+	HOST_CHECK((Pipe_GetStats(&Pipe)->Buffers == 3U) && (Pipe_GetStats(&Pipe)->In_Place == 1U));
+
+	/* A filter whose output is accumulated for the FFT can not run in place */
+	memcpy(Nodes, Spectrum_Nodes, sizeof(Spectrum_Nodes));
+	Nodes[2] = Spectrum_Nodes[3];
+	Nodes[2].In_Block = TEST_BLOCK * 4U;
+	HOST_CHECK(Pipe_Init(&Pipe, Nodes, 3, Pipe_FileSink, &Sink, Arena, sizeof(Arena)) == PIPE_OK);
+	HOST_CHECK(Pipe_GetStats(&Pipe)->In_Place == 0U);
+
+	/* Arena too small, the size needed is reported */
+	HOST_CHECK(Pipe_Init(&Pipe, Spectrum_Nodes, 5, Pipe_FileSink, &Sink, Arena, Pipe_ArenaSize(Spectrum_Nodes, 5) - 1U) == PIPE_ERROR_ARENA);
+	HOST_CHECK(Pipe_GetStats(&Pipe)->Arena_Used == Pipe_ArenaSize(Spectrum_Nodes, 5));
+	HOST_CHECK(Pipe_Init(&Pipe, Spectrum_Nodes, 5, Pipe_FileSink, &Sink, NULL, sizeof(Arena)) == PIPE_ERROR_ARENA);
+
+	/* Parameters */
+	HOST_CHECK(Pipe_Init(&Pipe, Spectrum_Nodes, 5, NULL, &Sink, Arena, sizeof(Arena)) == PIPE_ERROR_PARAM);
+	HOST_CHECK(Pipe_Init(&Pipe, Spectrum_Nodes, 0, Pipe_FileSink, &Sink, Arena, sizeof(Arena)) == PIPE_ERROR_PARAM);
+	for(i = 0; i <= PIPE_MAX_NODES; i++)
+	{
+		Nodes[i] = Spectrum_Nodes[1];
+	}
+	/* Filters in place all along: no arena */
+	HOST_CHECK(Pipe_Init(&Pipe, Nodes, PIPE_MAX_NODES + 1U, Pipe_FileSink, &Sink, NULL, 0) == PIPE_ERROR_PARAM);
+	HOST_CHECK(Pipe_Init(&Pipe, Nodes, PIPE_MAX_NODES, Pipe_FileSink, &Sink, NULL, 0) == PIPE_OK);
+	HOST_CHECK(Pipe_GetStats(&Pipe)->In_Place == PIPE_MAX_NODES);
+	Nodes[3].pfProcess = NULL;
+	HOST_CHECK(Pipe_Init(&Pipe, Nodes, 4, Pipe_FileSink, &Sink, Arena, sizeof(Arena)) == PIPE_ERROR_PARAM);
+
+	/* Neighbours not multiples: 16 decimated samples into an FFT of 24 */
+	memcpy(Nodes, Spectrum_Nodes, sizeof(Spectrum_Nodes));
+	Nodes[3].In_Block = 24;
+	HOST_CHECK(Pipe_Init(&Pipe, Nodes, 5, Pipe_FileSink, &Sink, Arena, sizeof(Arena)) == PIPE_ERROR_RATE);
+
+	/* float32_t into a q15 input */
+	memcpy(Nodes, Spectrum_Nodes, sizeof(Spectrum_Nodes));
+	Nodes[1] = Spectrum_Nodes[0];
+	HOST_CHECK(Pipe_Init(&Pipe, Nodes, 2, Pipe_FileSink, &Sink, Arena, sizeof(Arena)) == PIPE_ERROR_FORMAT);
+
+	/* A first node in place works in the pushed block itself, as in a DMA half */
+	Nodes[0] = (Pipe_Node_t)PIPE_NODE_SCALE_F32(&Scale, TEST_BLOCK);
+	Nodes[1] = (Pipe_Node_t)PIPE_NODE_DECIMATE_F32(&Chain.Dec, TEST_BLOCK, TEST_DEC_M);
+	HOST_CHECK(Pipe_Init(&Pipe, Nodes, 2, Pipe_FileSink, &Sink, Arena, sizeof(Arena)) == PIPE_OK);
+	HOST_CHECK(Pipe_GetStats(&Pipe)->Arena_Used == ((TEST_BLOCK / TEST_DEC_M) * sizeof(float32_t)));
+	HOST_CHECK(Pipe_GetStats(&Pipe)->In_Place == 1U);
+	Sink.pFile = tmpfile();
+	HOST_CHECK(Sink.pFile != NULL);
+	if(Sink.pFile == NULL)
+	{
+		return;
+	}
+	for(i = 0; i < TEST_BLOCK; i++)
+	{
+		Block[i] = (float32_t)i;
+	}
+	Pipe_Push(&Pipe, Block);
+	for(i = 0; i < TEST_BLOCK; i++)
+	{
+		HOST_CHECK(Block[i] == (2.0f * (float32_t)i));
+	}
+	HOST_CHECK(Sink.Samples == (TEST_BLOCK / TEST_DEC_M));
+
+	/* Samples waiting for a whole FFT frame are dropped by a reset */
+	Test_InitChain(&Chain);
+	HOST_CHECK(Pipe_Init(&Pipe, Spectrum_Nodes, 5, Pipe_FileSink, &Sink, Arena, sizeof(Arena)) == PIPE_OK);
+	for(i = 0; i < (TEST_BLOCKS_PER_FRAME * 2U); i++)
+	{
+		if(i == (TEST_BLOCKS_PER_FRAME / 2U))
+		{
+			Pipe_Reset(&Pipe);
+		}
+		Pipe_Push(&Pipe, &Signal[i * TEST_BLOCK]);
+		HOST_CHECK(Pipe_GetStats(&Pipe)->Sink_Blocks == ((i < ((TEST_BLOCKS_PER_FRAME * 3U) / 2U) - 1U) ? 0U : 1U));
+	}
+	fclose(Sink.pFile);
+}
+
+/**
+  * @brief	Spectrum chains from a file to a file: bit exact with the hand-wired kernels
+  */
+static void Test_Pipe_Spectrum(void)
+{
+	static int16_t Block[TEST_BLOCK];
+	Pipe_FileSink_t Sink = {NULL, sizeof(float32_t), 0};
+	FILE *pSource = tmpfile();
+	const Pipe_Stats_t *pStats = Pipe_GetStats(&Pipe);
+	const float32_t *pBins;
+	uint32_t Frames, Used, f, k, Peak;
+	uint8_t Scaled;
+
+	HOST_CHECK(pSource != NULL);
+	if(pSource == NULL)
+	{
+		return;
+	}
+
+	/* A partial block at the end is left out */
+	HOST_CHECK(fwrite(Signal, sizeof(int16_t), TEST_SAMPLES, pSource) == TEST_SAMPLES);
+	HOST_CHECK(fwrite(Signal, sizeof(int16_t), 5, pSource) == 5U);
+
+	for(Scaled = 0; Scaled <= 1U; Scaled++)
+	{
+		rewind(pSource);
+		Sink.pFile = tmpfile();
+		Sink.Samples = 0;
+		HOST_CHECK(Sink.pFile != NULL);
+		if(Sink.pFile == NULL)
+		{
+			break;
+		}
+
+		Test_InitChain(&Chain);
+		HOST_CHECK(Pipe_Init(&Pipe, Scaled ? Scaled_Spectrum_Nodes : Spectrum_Nodes, 5, Pipe_FileSink, &Sink, Arena, sizeof(Arena)) == PIPE_OK);
+		HOST_CHECK(pStats->Buffers == (Scaled ? 3U : 2U));
+		Used = pStats->Arena_Used;
+		Test_GuardArena(Used);
+
+		HOST_CHECK(Pipe_RunFile(&Pipe, pSource, Block) == (TEST_SAMPLES / TEST_BLOCK));
+		HOST_CHECK(Test_ArenaIntact(Used));
+		HOST_CHECK(pStats->Blocks == (TEST_SAMPLES / TEST_BLOCK));
+		HOST_CHECK(pStats->Sink_Blocks == TEST_FRAMES);
+		HOST_CHECK(pStats->Runs == ((pStats->Blocks * 3U) + (TEST_FRAMES * 2U)));
+		HOST_CHECK(Sink.Samples == (TEST_FRAMES * TEST_BINS));
+
+		Frames = Test_RefSpectrum(Signal, TEST_SAMPLES / TEST_BLOCK, Scaled, Expected);
+		HOST_CHECK(Frames == TEST_FRAMES);
+		HOST_CHECK(Test_ReadBack(Sink.pFile, Output, Sink.Samples * sizeof(float32_t)) == (Sink.Samples * sizeof(float32_t)));
+		HOST_CHECK(memcmp(Output, Expected, Frames * TEST_BINS * sizeof(float32_t)) == 0);
+
+		/* The tone stands out in its bin, the DC blocked once the filter settled */
+		for(f = 1; f < Frames; f++)
+		{
+			pBins = &Output[f * TEST_BINS];
+			for(k = 1, Peak = 1; k < TEST_BINS; k++)
+			{
+				Peak = (pBins[k] > pBins[Peak]) ? k : Peak;
+			}
+			HOST_CHECK(Peak == TEST_TONE_BIN);
+			HOST_CHECK(Scaled || (pBins[0] < (pBins[TEST_TONE_BIN] / 100.0f)));
+		}
+		fclose(Sink.pFile);
+	}
+
+	fclose(pSource);
+}
+
+/**
+  * @brief	Resampling chain: the interpolated blocks are filtered in slices
+  */
+static void Test_Pipe_Resample(void)
+{
+	static int16_t Block[TEST_B_BLOCK];
+	Pipe_FileSink_t Sink = {NULL, sizeof(float32_t), 0};
+	FILE *pSource = tmpfile();
+	const Pipe_Stats_t *pStats = Pipe_GetStats(&Pipe);
+	uint32_t Samples, Used;
+
+	Sink.pFile = tmpfile();
+	HOST_CHECK((pSource != NULL) && (Sink.pFile != NULL));
+	if((pSource == NULL) || (Sink.pFile == NULL))
+	{
+		return;
+	}
+	HOST_CHECK(fwrite(Signal, sizeof(int16_t), TEST_SAMPLES, pSource) == TEST_SAMPLES);
+	rewind(pSource);
+
+	Test_InitChain(&Chain);
+	HOST_CHECK(Pipe_Init(&Pipe, Resample_Nodes, 5, Pipe_FileSink, &Sink, Arena, sizeof(Arena)) == PIPE_OK);
+	Used = pStats->Arena_Used;
+	Test_GuardArena(Used);
+
+	HOST_CHECK(Pipe_RunFile(&Pipe, pSource, Block) == TEST_B_BLOCKS);
+	HOST_CHECK(Test_ArenaIntact(Used));
+	HOST_CHECK(pStats->Sink_Blocks == (TEST_B_BLOCKS * TEST_INTERP_L));
+	HOST_CHECK(pStats->Runs == (TEST_B_BLOCKS * (3U + (2U * TEST_INTERP_L))));
+
+	Samples = Test_RefResample(Signal, TEST_B_BLOCKS, Expected);
+	HOST_CHECK((Samples == TEST_B_OUT) && (Sink.Samples == Samples));
+	HOST_CHECK(Test_ReadBack(Sink.pFile, Output, Samples * sizeof(float32_t)) == (Samples * sizeof(float32_t)));
+	HOST_CHECK(memcmp(Output, Expected, Samples * sizeof(float32_t)) == 0);
+
+	fclose(pSource);
+	fclose(Sink.pFile);
+}
+
+/**
+  * @brief	DMA source: halves pushed where they lie, in order, overruns counted
+  */
+static void Test_Pipe_DmaSource(void)
+{
+	/* Two blocks of either chain: q15 for the spectrum, float32_t for the scaling */
+	static float32_t Dma[2U * TEST_BLOCK];
+	Test_Sink_t Sink;
+	Pipe_DmaSource_t Source;
+	Pipe_Node_t Nodes[2];
+	float32_t Scale = 1.0f;
+	uint32_t b;
+
+	memset(&Sink, 0, sizeof(Sink));
+	Sink.File.Size = sizeof(float32_t);
+	Sink.File.pFile = tmpfile();
+	Sink.pSource = &Source;
+	Sink.Fire = TEST_FIRE_NONE;
+	HOST_CHECK(Sink.File.pFile != NULL);
+	if(Sink.File.pFile == NULL)
+	{
+		return;
+	}
+
+	/* Each half pushed before the DMA comes back to it: the output of the file run */
+	Test_InitChain(&Chain);
+	HOST_CHECK(Pipe_Init(&Pipe, Spectrum_Nodes, 5, Test_DmaSink, &Sink, Arena, sizeof(Arena)) == PIPE_OK);
+	Pipe_DmaSource_Init(&Source, &Pipe, (uint8_t *)Dma);
+	for(b = 0; b < (TEST_SAMPLES / TEST_BLOCK); b++)
+	{
+		Test_DmaWrite(&Source, &Signal[b * TEST_BLOCK], (uint8_t)(b & 1U));
+		HOST_CHECK(Pipe_DmaSource_Process(&Source) == 1U);
+	}
+	HOST_CHECK(Source.Overruns == 0U);
+	HOST_CHECK(Sink.File.Samples == (TEST_FRAMES * TEST_BINS));
+	(void)Test_RefSpectrum(Signal, TEST_SAMPLES / TEST_BLOCK, 0, Expected);
+	HOST_CHECK(Test_ReadBack(Sink.File.pFile, Output, Sink.File.Samples * sizeof(float32_t)) == (Sink.File.Samples * sizeof(float32_t)));
+	HOST_CHECK(memcmp(Output, Expected, Sink.File.Samples * sizeof(float32_t)) == 0);
+
+	/* Both halves filled before the main loop came: the first is being written again */
+	Pipe_DmaSource_Init(&Source, &Pipe, (uint8_t *)Dma);
+	Test_DmaWrite(&Source, &Signal[0], 0);
+	Test_DmaWrite(&Source, &Signal[TEST_BLOCK], 1);
+	HOST_CHECK(Source.Overruns == 1U);
+	HOST_CHECK(Pipe_DmaSource_Process(&Source) == 2U);
+	HOST_CHECK(Pipe_DmaSource_Process(&Source) == 0U);
+
+	/* The first half completed while the second is pushed: the DMA writes the one in use */
+	Nodes[0] = (Pipe_Node_t)PIPE_NODE_SCALE_F32(&Scale, TEST_BLOCK);
+	Nodes[1] = (Pipe_Node_t)PIPE_NODE_DECIMATE_F32(&Chain.Dec, TEST_BLOCK, TEST_DEC_M);
+	HOST_CHECK(Pipe_Init(&Pipe, Nodes, 2, Test_DmaSink, &Sink, Arena, sizeof(Arena)) == PIPE_OK);
+	Pipe_DmaSource_Init(&Source, &Pipe, (uint8_t *)Dma);
+	Pipe_DmaSource_HalfComplete(&Source);
+	HOST_CHECK(Pipe_DmaSource_Process(&Source) == 1U);
+	Pipe_DmaSource_Complete(&Source);
+	Sink.Fire = 0;
+	HOST_CHECK(Pipe_DmaSource_Process(&Source) == 2U);
+	HOST_CHECK(Source.Overruns == 1U);
+
+	/* The second half completed while the first is pushed */
+	Pipe_DmaSource_Init(&Source, &Pipe, (uint8_t *)Dma);
+	Pipe_DmaSource_HalfComplete(&Source);
+	Sink.Fire = 1;
+	HOST_CHECK(Pipe_DmaSource_Process(&Source) == 2U);
+	HOST_CHECK(Source.Overruns == 1U);
+
+	fclose(Sink.File.pFile);
+}
+
+/**
+  * @brief	BLE sink, float and q15 chains: every block notified whole and in order, or dropped
+  *					while TX buffers are short
+  */
+static void Test_Pipe_BleSink(void)
+{
+	static int16_t Sink_Samples[TEST_B_BLOCK];
+	Pipe_BleSink_t Sink;
+	uint32_t Seed = 7, Dropped, Kept, Pos, b;
+	uint8_t Is_Float;
+
+	(void)Test_RefResample(Signal, TEST_B_BLOCKS, Expected);
+	arm_float_to_q15(Expected, Expected_Q15, TEST_B_OUT);
+
+	for(Is_Float = 0; Is_Float <= 1U; Is_Float++)
+	{
+		/* TX buffers always free */
+		Test_InitChain(&Chain);
+		HOST_CHECK(Pipe_Init(&Pipe, Resample_Nodes, Is_Float ? 5U : 6U, Pipe_BleSink, &Sink, Arena, sizeof(Arena)) == PIPE_OK);
+		Pipe_BleSink_Init(&Sink, Sink_Samples, TEST_B_BLOCK, 1, Is_Float);
+		Notified_Count = 0;
+		Tx_Budget = TEST_TX_UNLIMITED;
+		for(b = 0; b < TEST_B_BLOCKS; b++)
+		{
+			Pipe_Push(&Pipe, &Signal[b * TEST_B_BLOCK]);
+		}
+		HOST_CHECK((Notified_Count == TEST_B_OUT) && (Sink.Dropped == 0U));
+		HOST_CHECK(memcmp(Notified, Expected_Q15, sizeof(Expected_Q15)) == 0);
+
+		/* A few TX buffers freed between blocks, the main loop resuming now and then */
+		Test_InitChain(&Chain);
+		HOST_CHECK(Pipe_Init(&Pipe, Resample_Nodes, Is_Float ? 5U : 6U, Pipe_BleSink, &Sink, Arena, sizeof(Arena)) == PIPE_OK);
+		Pipe_BleSink_Init(&Sink, Sink_Samples, TEST_B_BLOCK, 1, Is_Float);
+		Notified_Count = 0;
+		for(b = 0; b < TEST_B_BLOCKS; b++)
+		{
+			Tx_Budget = Host_Rand(&Seed) % 48U;
+			if((Host_Rand(&Seed) % 4U) == 0U)
+			{
+				(void)Pipe_BleSink_Resume(&Sink);
+			}
+			Pipe_Push(&Pipe, &Signal[b * TEST_B_BLOCK]);
+		}
+		Tx_Budget = TEST_TX_UNLIMITED;
+		HOST_CHECK(Pipe_BleSink_Resume(&Sink) == 1U);
+
+		/* The notified stream is the expected blocks, some left out */
+		for(b = 0, Pos = 0, Kept = 0, Dropped = 0; b < (TEST_B_OUT / TEST_B_BLOCK); b++)
+		{
+			if(((Pos + TEST_B_BLOCK) <= Notified_Count) &&
+				 (memcmp(&Notified[Pos], &Expected_Q15[b * TEST_B_BLOCK], TEST_B_BLOCK * sizeof(int16_t)) == 0))
+			{
+				Pos += TEST_B_BLOCK;
+				Kept++;
+			}
+			else
+			{
+				Dropped++;
+			}
+		}
+		HOST_CHECK(Pos == Notified_Count);
+		HOST_CHECK(Sink.Dropped == (Dropped * TEST_B_BLOCK));
+		HOST_CHECK((Kept != 0U) && (Dropped != 0U));
+		printf("  %-5s sink, short TX buffers: %u blocks notified, %u dropped\n", Is_Float ? "float" : "q15",
+					 (unsigned int)Kept, (unsigned int)Dropped);
+
+		/* A block larger than the sink */
+		Pipe_BleSink_Init(&Sink, Sink_Samples, TEST_B_BLOCK - 1U, 1, Is_Float);
+		Pipe_Push(&Pipe, &Signal[0]);
+		HOST_CHECK(Sink.Dropped == (TEST_B_BLOCK * TEST_INTERP_L));
+	}
+}
+
+/**
+  * @brief	Spectrum chain on a recorded file
+  */
+static int Test_RunRecorded(const char *pIn, const char *pOut)
+{
+	static int16_t Block[TEST_BLOCK];
+	Pipe_FileSink_t Sink = {NULL, sizeof(float32_t), 0};
+	FILE *pSource = fopen(pIn, "rb");
+	uint32_t Blocks;
+
+	Sink.pFile = fopen(pOut, "wb");
+	if((pSource == NULL) || (Sink.pFile == NULL))
+	{
+		printf("cannot open %s or %s\n", pIn, pOut);
+		return EXIT_FAILURE;
+	}
+
+	Test_MakeSignal();
+	Test_InitChain(&Chain);
+	if(Pipe_Init(&Pipe, Spectrum_Nodes, 5, Pipe_FileSink, &Sink, Arena, sizeof(Arena)) != PIPE_OK)
+	{
+		return EXIT_FAILURE;
+	}
+	Blocks = Pipe_RunFile(&Pipe, pSource, Block);
+	printf("%s: %u blocks of %u samples, %u spectra of %u bins to %s\n", pIn, (unsigned int)Blocks, TEST_BLOCK,
+				 (unsigned int)(Sink.Samples / TEST_BINS), TEST_BINS, pOut);
+
+	fclose(pSource);
+	fclose(Sink.pFile);
+	return EXIT_SUCCESS;
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+	if(argc == 3)
+	{
+		return Test_RunRecorded(argv[1], argv[2]);
+	}
+	if(argc != 1)
+	{
+		printf("usage: %s [<q15 file> <power file>]\n", argv[0]);
+		return 2;
+	}
+
+	Test_MakeSignal();
+
+	HOST_RUN(Test_Pipe_Plan);
+	HOST_RUN(Test_Pipe_Spectrum);
+	HOST_RUN(Test_Pipe_Resample);
+	HOST_RUN(Test_Pipe_DmaSource);
+	HOST_RUN(Test_Pipe_BleSink);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,635 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Gatt_Builder.c
+  * @brief      : Host test of Gatt_Builder.c against an emulated controller. The emulator parses the
+	*								add commands as the BlueNRG-2 does, allocates the handles itself and grants a
+	*								limited number of command credits. Every handle the builder predicted and wrote
+	*								back must be the one the controller allocated.
+  * @author			:
+  **************************************************************************************************
+  *
+  * Regression test of the handle layout: the boot sequence of the firmware (configuration, test
+  * and update services), a product-sized database of about 80 attributes, and a rebuild after a
+  * reset of the controller, where the predictions are wrong and the rejected commands are sent
+  * again. The commands sent and the round trips the host waited for are printed.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Host_Test.h"
+#include "Gatt_Builder.h"
+#include "hci.h"
+#include "hci_tl.h"
+#include "bluenrg1_gatt_aci.h"
+#include "bluenrg1_gatt_server.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define TEST_OGF												((uint16_t)0x3F)
+#define TEST_OCF_ADD_SERVICE						((uint16_t)0x0102)
+#define TEST_OCF_ADD_CHAR								((uint16_t)0x0104)
+#define TEST_OCF_ADD_CHAR_DESC					((uint16_t)0x0105)
+
+/* Handles the GATT and GAP services of the controller take after aci_gatt_init(), aci_gap_init() */
+#define TEST_FIRST_FREE_HANDLE					((uint16_t)0x000C)
+
+#define TEST_MAX_SERVICES								32U
+#define TEST_MAX_ATTRIBUTES							256U
+#define TEST_MAX_QUEUE									16U
+
+#define TEST_PRODUCT_SERVICES						6U
+#define TEST_PRODUCT_CHARS							6U
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+/* Service as allocated by the controller */
+typedef struct
+{
+	uint16_t Start;
+	uint8_t Records;
+	uint8_t Used;
+	uint8_t Uuid[16];
+
+} Ctrl_Service_t;
+
+/* Characteristic or user description as allocated by the controller */
+typedef struct
+{
+	uint16_t Service;
+	uint16_t Char;										/* Declaration of the characteristic described */
+	uint16_t Handle;
+	uint8_t Is_Desc;
+	uint8_t Uuid[16];
+	char Name[GATTBUILD_NAME_MAX + 1U];
+
+} Ctrl_Attribute_t;
+
+typedef struct
+{
+	uint16_t Ocf;
+	uint8_t Status;
+	uint16_t Handle;
+
+} Ctrl_Response_t;
+
+typedef struct
+{
+	uint16_t Next_Free;
+	Ctrl_Service_t Service[TEST_MAX_SERVICES];
+	uint8_t Services;
+	Ctrl_Attribute_t Attribute[TEST_MAX_ATTRIBUTES];
+	uint16_t Attributes;
+
+	Ctrl_Response_t Queue[TEST_MAX_QUEUE];
+	uint8_t Queue_Head;
+	uint8_t In_Flight;
+	uint8_t Credits;									/* Commands accepted before a response */
+
+	uint32_t Commands;
+	uint32_t Rejected;
+	uint32_t Round_Trips;							/* Waits with no other command in flight */
+	uint8_t Timeout;									/* Fail the waits */
+
+} Ctrl_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static Ctrl_t Ctrl;
+static uint32_t Tick;
+
+/* Firmware tables, as in BLE_Process.c, Perf_Test.c and Ota_Update.c */
+static const uint8_t Config_Uuid[16] = {0x66,0x9A,0x0C,0x20,0x00,0x08,0x96,0x9E,0xE2,0x11,0x9E,0xB1,0xE0,0xF2,0x73,0xD9};
+static const uint8_t Config_Char_Uuid[4][16] =
+{
+	{0x01,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x83,0xEA,0x25,0x9B},
+	{0x02,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x83,0xEA,0x25,0x9B},
+	{0x03,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x83,0xEA,0x25,0x9B},
+	{0x04,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x83,0xEA,0x25,0x9B},
+};
+static uint16_t hService, hIndicate, hNotify, hRead, hWrite;
+
+static const GattBuild_Char_t Config_Chars[4] =
+{
+	{Config_Char_Uuid[0], 20, CHAR_PROP_INDICATE, GATT_DONT_NOTIFY_EVENTS, CHAR_VALUE_LEN_CONSTANT,
+		"TEST_ONE", ATTR_ACCESS_READ_ONLY, &hIndicate},
+	{Config_Char_Uuid[1], 20, CHAR_PROP_NOTIFY, GATT_DONT_NOTIFY_EVENTS, CHAR_VALUE_LEN_VARIABLE,
+		"TEST_TWO", ATTR_ACCESS_READ_ONLY, &hNotify},
+	{Config_Char_Uuid[2], 20, CHAR_PROP_READ, GATT_DONT_NOTIFY_EVENTS, CHAR_VALUE_LEN_CONSTANT,
+		"TEST_THREE", ATTR_ACCESS_READ_ONLY, &hRead},
+	{Config_Char_Uuid[3], 20, CHAR_PROP_WRITE|CHAR_PROP_WRITE_WITHOUT_RESP, GATT_NOTIFY_ATTRIBUTE_WRITE, CHAR_VALUE_LEN_CONSTANT,
+		"TEST_FOUR", ATTR_ACCESS_READ_WRITE, &hWrite},
+};
+static const GattBuild_Service_t Config_Service = {Config_Uuid, 20, Config_Chars, 4, &hService};
+
+static const uint8_t Perf_Uuid[4][16] =
+{
+	{0x10,0xA1,0x5E,0x1F,0x00,0x00,0x00,0x80,0x00,0x10,0x00,0x00,0x00,0x00,0x00,0x00},
+	{0x11,0xA1,0x5E,0x1F,0x00,0x00,0x00,0x80,0x00,0x10,0x00,0x00,0x00,0x00,0x00,0x00},
+	{0x12,0xA1,0x5E,0x1F,0x00,0x00,0x00,0x80,0x00,0x10,0x00,0x00,0x00,0x00,0x00,0x00},
+	{0x13,0xA1,0x5E,0x1F,0x00,0x00,0x00,0x80,0x00,0x10,0x00,0x00,0x00,0x00,0x00,0x00},
+};
+static uint16_t hPerfService, hControl, hData, hResults;
+
+static const GattBuild_Char_t Perf_Chars[3] =
+{
+	{Perf_Uuid[1], 4, CHAR_PROP_WRITE, GATT_NOTIFY_ATTRIBUTE_WRITE, CHAR_VALUE_LEN_VARIABLE, NULL, 0, &hControl},
+	{Perf_Uuid[2], 244, CHAR_PROP_NOTIFY|CHAR_PROP_WRITE_WITHOUT_RESP, GATT_NOTIFY_ATTRIBUTE_WRITE,
+		CHAR_VALUE_LEN_VARIABLE, NULL, 0, &hData},
+	{Perf_Uuid[3], 32, CHAR_PROP_READ, GATT_DONT_NOTIFY_EVENTS, CHAR_VALUE_LEN_CONSTANT, NULL, 0, &hResults},
+};
+static const GattBuild_Service_t Perf_Service = {Perf_Uuid[0], 8, Perf_Chars, 3, &hPerfService};
+
+static const uint8_t Ota_Uuid[3][16] =
+{
+	{0x20,0x0B,0x7A,0x0C,0x00,0x00,0x00,0x80,0x00,0x10,0x00,0x00,0x00,0x00,0x00,0x00},
+	{0x21,0x0B,0x7A,0x0C,0x00,0x00,0x00,0x80,0x00,0x10,0x00,0x00,0x00,0x00,0x00,0x00},
+	{0x22,0x0B,0x7A,0x0C,0x00,0x00,0x00,0x80,0x00,0x10,0x00,0x00,0x00,0x00,0x00,0x00},
+};
+static uint16_t hOtaService, hOtaControl, hOtaData;
+
+static const GattBuild_Char_t Ota_Chars[2] =
+{
+	{Ota_Uuid[1], 9, CHAR_PROP_WRITE|CHAR_PROP_NOTIFY, GATT_NOTIFY_ATTRIBUTE_WRITE, CHAR_VALUE_LEN_VARIABLE, NULL, 0, &hOtaControl},
+	{Ota_Uuid[2], 244, CHAR_PROP_WRITE_WITHOUT_RESP, GATT_NOTIFY_ATTRIBUTE_WRITE, CHAR_VALUE_LEN_VARIABLE, NULL, 0, &hOtaData},
+};
+static const GattBuild_Service_t Ota_Service = {Ota_Uuid[0], 6, Ota_Chars, 2, &hOtaService};
+
+/* Product database, filled by Test_MakeProduct() */
+static uint8_t Product_Uuid[TEST_PRODUCT_SERVICES][1U + TEST_PRODUCT_CHARS][16];
+static char Product_Name[TEST_PRODUCT_SERVICES][TEST_PRODUCT_CHARS][GATTBUILD_NAME_MAX + 1U];
+static uint16_t Product_Handle[TEST_PRODUCT_SERVICES][1U + TEST_PRODUCT_CHARS];
+static GattBuild_Char_t Product_Chars[TEST_PRODUCT_SERVICES][TEST_PRODUCT_CHARS];
+static GattBuild_Service_t Product[TEST_PRODUCT_SERVICES];
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+uint32_t HAL_GetTick(void)
+{
+	return Tick++;
+}
+
+static uint16_t Ctrl_GetU16(const uint8_t *p)
+{
+	return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static Ctrl_Service_t *Ctrl_FindService(uint16_t Handle)
+{
+	uint8_t i;
+
+	for(i = 0; i < Ctrl.Services; i++)
+	{
+		if(Ctrl.Service[i].Start == Handle)
+		{
+			return &Ctrl.Service[i];
+		}
+	}
+	return NULL;
+}
+
+static const Ctrl_Attribute_t *Ctrl_FindChar(uint16_t Service, uint16_t Handle)
+{
+	uint16_t i;
+
+	for(i = 0; i < Ctrl.Attributes; i++)
+	{
+		if(!Ctrl.Attribute[i].Is_Desc && (Ctrl.Attribute[i].Service == Service) && (Ctrl.Attribute[i].Handle == Handle))
+		{
+			return &Ctrl.Attribute[i];
+		}
+	}
+	return NULL;
+}
+
+/**
+  * @brief	Reset of the controller, then aci_gatt_init() and aci_gap_init()
+  */
+static void Ctrl_Reset(uint8_t Credits)
+{
+	memset(&Ctrl, 0, sizeof(Ctrl));
+	Ctrl.Next_Free = TEST_FIRST_FREE_HANDLE;
+	Ctrl.Credits = Credits;
+}
+
+static uint8_t Ctrl_AddService(const uint8_t *pParam, uint32_t Length, uint16_t *pHandle)
+{
+	Ctrl_Service_t *pService;
+
+	HOST_CHECK(Length == 19U);
+	HOST_CHECK((pParam[0] == UUID_TYPE_128) && (pParam[17] == PRIMARY_SERVICE));
+	if((Ctrl.Services >= TEST_MAX_SERVICES) || (pParam[18] == 0U))
+	{
+		return BLE_STATUS_INSUFFICIENT_RESOURCES;
+	}
+
+	pService = &Ctrl.Service[Ctrl.Services++];
+	pService->Start = Ctrl.Next_Free;
+	pService->Records = pParam[18];
+	pService->Used = 1;
+	memcpy(pService->Uuid, &pParam[1], 16);
+	Ctrl.Next_Free += pService->Records;
+
+	*pHandle = pService->Start;
+	return BLE_STATUS_SUCCESS;
+}
+
+static uint8_t Ctrl_AddChar(const uint8_t *pParam, uint32_t Length, uint16_t *pHandle)
+{
+	Ctrl_Service_t *pService = Ctrl_FindService(Ctrl_GetU16(pParam));
+	Ctrl_Attribute_t *pAttribute;
+	uint8_t Properties = pParam[21], Records = 2;
+
+	HOST_CHECK(Length == 26U);
+	HOST_CHECK(pParam[2] == UUID_TYPE_128);
+	HOST_CHECK((pParam[24] >= 7U) && (pParam[24] <= 16U));
+	if(pService == NULL)
+	{
+		return BLE_STATUS_INVALID_HANDLE;
+	}
+
+	Records += (Properties & (CHAR_PROP_NOTIFY | CHAR_PROP_INDICATE)) ? 1U : 0U;
+	Records += (Properties & CHAR_PROP_BROADCAST) ? 1U : 0U;
+	Records += (Properties & CHAR_PROP_EXT) ? 1U : 0U;
+	if(((pService->Used + Records) > pService->Records) || (Ctrl.Attributes >= TEST_MAX_ATTRIBUTES))
+	{
+		return BLE_STATUS_INSUFFICIENT_RESOURCES;
+	}
+
+	pAttribute = &Ctrl.Attribute[Ctrl.Attributes++];
+	memset(pAttribute, 0, sizeof(Ctrl_Attribute_t));
+	pAttribute->Service = pService->Start;
+	pAttribute->Handle = pService->Start + pService->Used;
+	pAttribute->Char = pAttribute->Handle;
+	memcpy(pAttribute->Uuid, &pParam[3], 16);
+	pService->Used += Records;
+
+	*pHandle = pAttribute->Handle;
+	return BLE_STATUS_SUCCESS;
+}
+
+static uint8_t Ctrl_AddDesc(const uint8_t *pParam, uint32_t Length, uint16_t *pHandle)
+{
+	Ctrl_Service_t *pService = Ctrl_FindService(Ctrl_GetU16(pParam));
+	Ctrl_Attribute_t *pAttribute;
+	uint8_t Value_Length = pParam[8];
+
+	HOST_CHECK(Length == (14U + Value_Length));
+	HOST_CHECK((pParam[4] == UUID_TYPE_16) && (Ctrl_GetU16(&pParam[5]) == CHAR_USER_DESC_UUID));
+	HOST_CHECK((Value_Length <= pParam[7]) && (Value_Length <= GATTBUILD_NAME_MAX));
+	/* A writable description takes any name up to the maximum */
+	HOST_CHECK(pParam[7] == ((pParam[10U + Value_Length] == ATTR_ACCESS_READ_WRITE) ? GATTBUILD_NAME_MAX : Value_Length));
+	if((pService == NULL) || (Ctrl_FindChar(pService->Start, Ctrl_GetU16(&pParam[2])) == NULL))
+	{
+		return BLE_STATUS_INVALID_HANDLE;
+	}
+	if(((pService->Used + 1U) > pService->Records) || (Ctrl.Attributes >= TEST_MAX_ATTRIBUTES))
+	{
+		return BLE_STATUS_INSUFFICIENT_RESOURCES;
+	}
+
+	pAttribute = &Ctrl.Attribute[Ctrl.Attributes++];
+	memset(pAttribute, 0, sizeof(Ctrl_Attribute_t));
+	pAttribute->Is_Desc = 1;
+	pAttribute->Service = pService->Start;
+	pAttribute->Char = Ctrl_GetU16(&pParam[2]);
+	pAttribute->Handle = pService->Start + pService->Used;
+	memcpy(pAttribute->Name, &pParam[9], Value_Length);
+	pService->Used++;
+
+	*pHandle = pAttribute->Handle;
+	return BLE_STATUS_SUCCESS;
+}
+
+/**
+  * @brief	The controller handles the commands in order, as they arrive
+  */
+int hci_send_cmd_queued(struct hci_request *r)
+{
+	Ctrl_Response_t *pResponse;
+	uint16_t Handle = 0;
+	uint8_t Status;
+
+	if(Ctrl.In_Flight >= Ctrl.Credits)
+	{
+		return -1;
+	}
+	HOST_CHECK(r->ogf == TEST_OGF);
+
+	switch(r->ocf)
+	{
+		case TEST_OCF_ADD_SERVICE:
+			Status = Ctrl_AddService((const uint8_t *)r->cparam, r->clen, &Handle);
+			break;
+		case TEST_OCF_ADD_CHAR:
+			Status = Ctrl_AddChar((const uint8_t *)r->cparam, r->clen, &Handle);
+			break;
+		case TEST_OCF_ADD_CHAR_DESC:
+			Status = Ctrl_AddDesc((const uint8_t *)r->cparam, r->clen, &Handle);
+			break;
+		default:
+			HOST_CHECK(0);
+			Status = BLE_STATUS_UNKNOWN_CONNECTION_ID;
+			break;
+	}
+
+	Ctrl.Commands++;
+	Ctrl.Rejected += (Status != BLE_STATUS_SUCCESS);
+
+	pResponse = &Ctrl.Queue[(Ctrl.Queue_Head + Ctrl.In_Flight) % TEST_MAX_QUEUE];
+	pResponse->Ocf = r->ocf;
+	pResponse->Status = Status;
+	pResponse->Handle = Handle;
+	Ctrl.In_Flight++;
+
+	return 0;
+}
+
+int hci_wait_cmd_response(struct hci_request *r)
+{
+	Ctrl_Response_t *pResponse = &Ctrl.Queue[Ctrl.Queue_Head];
+	uint8_t *pParam = (uint8_t *)r->rparam;
+
+	HOST_CHECK(Ctrl.In_Flight != 0U);
+	if((Ctrl.In_Flight == 0U) || Ctrl.Timeout)
+	{
+		return -1;
+	}
+
+	/* Nothing else in flight: the host idles for the whole round trip */
+	if(Ctrl.In_Flight == 1U)
+	{
+		Ctrl.Round_Trips++;
+	}
+
+	HOST_CHECK((r->ocf == pResponse->Ocf) && (r->rlen == 3U));
+	pParam[0] = pResponse->Status;
+	pParam[1] = (uint8_t)pResponse->Handle;
+	pParam[2] = (uint8_t)(pResponse->Handle >> 8);
+
+	Ctrl.Queue_Head = (Ctrl.Queue_Head + 1U) % TEST_MAX_QUEUE;
+	Ctrl.In_Flight--;
+	return 0;
+}
+
+uint8_t hci_cmd_credits(void)
+{
+	return Ctrl.Credits - Ctrl.In_Flight;
+}
+
+/**
+  * @brief	Every handle written back is the one the controller allocated, every attribute of the
+  *					table was added once, in the service of the table
+  */
+static void Test_CheckTables(const GattBuild_Service_t *pServices, uint8_t Services)
+{
+	const GattBuild_Service_t *pService;
+	const GattBuild_Char_t *pChar;
+	const Ctrl_Service_t *pCtrl;
+	const Ctrl_Attribute_t *pAttribute;
+	uint16_t Found, a;
+	uint8_t s, c, i;
+
+	for(s = 0; s < Services; s++)
+	{
+		pService = &pServices[s];
+		pCtrl = Ctrl_FindService(*pService->pHandle);
+		HOST_CHECK((pCtrl != NULL) && (memcmp(pCtrl->Uuid, pService->pUuid, 16) == 0));
+		if(pCtrl == NULL)
+		{
+			continue;
+		}
+		HOST_CHECK(pCtrl->Records == GattBuild_ServiceRecords(pService));
+
+		for(c = 0; c < pService->Chars; c++)
+		{
+			pChar = &pService->pChars[c];
+			HOST_CHECK(GattBuild_PredictChar(pService, pCtrl->Start, c) == *pChar->pHandle);
+
+			pAttribute = Ctrl_FindChar(pCtrl->Start, *pChar->pHandle);
+			HOST_CHECK((pAttribute != NULL) && (memcmp(pAttribute->Uuid, pChar->pUuid, 16) == 0));
+
+			/* One user description, the last record of the characteristic */
+			for(a = 0, Found = 0; a < Ctrl.Attributes; a++)
+			{
+				if(Ctrl.Attribute[a].Is_Desc && (Ctrl.Attribute[a].Char == *pChar->pHandle) && (Ctrl.Attribute[a].Service == pCtrl->Start))
+				{
+					Found++;
+					HOST_CHECK(Ctrl.Attribute[a].Handle == (*pChar->pHandle + GattBuild_CharRecords(pChar) - 1U));
+					HOST_CHECK((pChar->pName != NULL) && (strcmp(Ctrl.Attribute[a].Name, pChar->pName) == 0));
+				}
+			}
+			HOST_CHECK(Found == ((pChar->pName != NULL) ? 1U : 0U));
+		}
+
+		/* Added once */
+		for(i = 0, Found = 0; i < Ctrl.Services; i++)
+		{
+			Found += (memcmp(Ctrl.Service[i].Uuid, pService->pUuid, 16) == 0);
+		}
+		HOST_CHECK(Found == 1U);
+	}
+}
+
+/**
+  * @brief	A product database: every kind of characteristic, with and without descriptions
+  */
+static void Test_MakeProduct(void)
+{
+	GattBuild_Char_t *pChar;
+	uint8_t s, c;
+	static const uint8_t Properties[TEST_PRODUCT_CHARS] =
+	{
+		CHAR_PROP_READ | CHAR_PROP_NOTIFY,
+		CHAR_PROP_WRITE,
+		CHAR_PROP_READ | CHAR_PROP_INDICATE | CHAR_PROP_NOTIFY,
+		CHAR_PROP_BROADCAST | CHAR_PROP_READ,
+		CHAR_PROP_WRITE | CHAR_PROP_EXT,
+		CHAR_PROP_BROADCAST | CHAR_PROP_NOTIFY | CHAR_PROP_EXT,
+	};
+
+	memset(Product_Handle, 0xAA, sizeof(Product_Handle));
+	for(s = 0; s < TEST_PRODUCT_SERVICES; s++)
+	{
+		memset(Product_Uuid[s][0], 0x40 + s, 16);
+		for(c = 0; c < TEST_PRODUCT_CHARS; c++)
+		{
+			pChar = &Product_Chars[s][c];
+			memset(Product_Uuid[s][1U + c], 0x80 + (s * 16) + c, 16);
+			(void)snprintf(Product_Name[s][c], sizeof(Product_Name[s][c]), "Service %u characteristic %u", s, c);
+
+			pChar->pUuid = Product_Uuid[s][1U + c];
+			pChar->Max_Length = (uint16_t)(20U + c);
+			pChar->Properties = Properties[(s + c) % TEST_PRODUCT_CHARS];
+			pChar->Evt_Mask = (pChar->Properties & CHAR_PROP_WRITE) ? GATT_NOTIFY_ATTRIBUTE_WRITE : GATT_DONT_NOTIFY_EVENTS;
+			pChar->Is_Variable = (uint8_t)(c & 1U);
+			/* Two out of three described, some writable */
+			pChar->pName = ((c % 3U) != 2U) ? Product_Name[s][c] : NULL;
+			pChar->Name_Access = ((c % 3U) == 1U) ? ATTR_ACCESS_READ_WRITE : ATTR_ACCESS_READ_ONLY;
+			pChar->pHandle = &Product_Handle[s][1U + c];
+		}
+
+		Product[s].pUuid = Product_Uuid[s][0];
+		/* Some services keep spare handles */
+		Product[s].Max_Records = ((s % 2U) == 1U) ? 40U : 0U;
+		Product[s].pChars = Product_Chars[s];
+		Product[s].Chars = TEST_PRODUCT_CHARS;
+		Product[s].pHandle = &Product_Handle[s][0];
+	}
+}
+
+static void Test_Print(const char *pName, uint32_t Commands, uint32_t Round_Trips)
+{
+	printf("  %-36s %3u commands, %3u round trips\n", pName, (unsigned int)Commands, (unsigned int)Round_Trips);
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	Boot of the firmware: configuration, test and update services, one run each
+  */
+static void Test_GattBuild_Boot(void)
+{
+	const GattBuild_Stats_t *pStats = GattBuild_GetStats();
+	uint32_t Round_Trips;
+
+	Ctrl_Reset(GATTBUILD_WINDOW);
+
+	/* The first service of the first run is waited for, the rest follows back to back */
+	HOST_CHECK(GattBuild_Run(&Config_Service, 1) == GATTBUILD_OK);
+	HOST_CHECK(Ctrl.Commands == 9U);
+	HOST_CHECK(pStats->Predicted == 8U);
+	HOST_CHECK(hService == TEST_FIRST_FREE_HANDLE);
+	HOST_CHECK((hIndicate == (hService + 1U)) && (hNotify == (hService + 5U)) && (hRead == (hService + 9U)) && (hWrite == (hService + 12U)));
+	Test_Print("configuration service", Ctrl.Commands, Ctrl.Round_Trips);
+	Round_Trips = Ctrl.Round_Trips;
+	HOST_CHECK(Round_Trips <= 2U);
+
+	/* Handles known from the previous run: nothing waited for but the last responses */
+	HOST_CHECK(GattBuild_Run(&Perf_Service, 1) == GATTBUILD_OK);
+	HOST_CHECK(GattBuild_Run(&Ota_Service, 1) == GATTBUILD_OK);
+	HOST_CHECK(hPerfService == (hService + 20U));
+	HOST_CHECK(hOtaService == (hPerfService + 8U));
+	Test_Print("with test and update services", Ctrl.Commands, Ctrl.Round_Trips);
+	HOST_CHECK(Ctrl.Round_Trips <= (Round_Trips + 2U));
+
+	Test_CheckTables(&Config_Service, 1);
+	Test_CheckTables(&Perf_Service, 1);
+	Test_CheckTables(&Ota_Service, 1);
+
+	HOST_CHECK(pStats->Commands == Ctrl.Commands);
+	HOST_CHECK(pStats->Predicted == (Ctrl.Commands - 1U));
+	HOST_CHECK((pStats->Mispredicted == 0U) && (pStats->Resent == 0U));
+	HOST_CHECK(Ctrl.Rejected == 0U);
+}
+
+/**
+  * @brief	Product database of about 80 attributes in one run
+  */
+static void Test_GattBuild_Product(void)
+{
+	const GattBuild_Stats_t *pStats = GattBuild_GetStats();
+	uint32_t Commands = Ctrl.Commands, Round_Trips = Ctrl.Round_Trips, Predicted = pStats->Predicted;
+
+	Test_MakeProduct();
+	HOST_CHECK(GattBuild_Run(Product, TEST_PRODUCT_SERVICES) == GATTBUILD_OK);
+	Test_CheckTables(Product, TEST_PRODUCT_SERVICES);
+
+	Commands = Ctrl.Commands - Commands;
+	Round_Trips = Ctrl.Round_Trips - Round_Trips;
+	Test_Print("product database", Commands, Round_Trips);
+	/* Services, characteristics and the descriptions of two out of three */
+	HOST_CHECK(Commands == (TEST_PRODUCT_SERVICES * (1U + TEST_PRODUCT_CHARS + ((TEST_PRODUCT_CHARS * 2U) / 3U))));
+	HOST_CHECK(Round_Trips <= 2U);
+	HOST_CHECK((pStats->Predicted - Predicted) == Commands);
+	HOST_CHECK((pStats->Mispredicted == 0U) && (Ctrl.Rejected == 0U));
+	HOST_CHECK(hService == TEST_FIRST_FREE_HANDLE);
+	HOST_CHECK(Product_Handle[0][0] == (hOtaService + 6U));
+}
+
+/**
+  * @brief	One command credit: no pipelining, the handles are the same
+  */
+static void Test_GattBuild_OneCredit(void)
+{
+	Ctrl_Reset(1);
+	HOST_CHECK(GattBuild_Run(Product, TEST_PRODUCT_SERVICES) == GATTBUILD_OK);
+	Test_CheckTables(Product, TEST_PRODUCT_SERVICES);
+	Test_Print("product database, one credit", Ctrl.Commands, Ctrl.Round_Trips);
+	HOST_CHECK(Ctrl.Round_Trips == Ctrl.Commands);
+}
+
+/**
+  * @brief	Rebuild after a reset of the controller: the handles kept from the previous runs are
+  *					wrong, the rejected commands are sent again and nothing is added at a wrong place
+  */
+static void Test_GattBuild_Reset(void)
+{
+	const GattBuild_Stats_t *pStats = GattBuild_GetStats();
+	uint32_t Mispredicted = pStats->Mispredicted, Resent = pStats->Resent;
+
+	Ctrl_Reset(GATTBUILD_WINDOW);
+	HOST_CHECK(GattBuild_Run(&Config_Service, 1) == GATTBUILD_OK);
+	HOST_CHECK(hService == TEST_FIRST_FREE_HANDLE);
+	HOST_CHECK(pStats->Mispredicted > Mispredicted);
+	HOST_CHECK(pStats->Resent > Resent);
+	HOST_CHECK(Ctrl.Rejected != 0U);
+	Test_CheckTables(&Config_Service, 1);
+	Test_Print("configuration service after a reset", Ctrl.Commands, Ctrl.Round_Trips);
+
+	/* Back on track */
+	Mispredicted = pStats->Mispredicted;
+	HOST_CHECK(GattBuild_Run(Product, TEST_PRODUCT_SERVICES) == GATTBUILD_OK);
+	Test_CheckTables(&Config_Service, 1);
+	Test_CheckTables(Product, TEST_PRODUCT_SERVICES);
+	HOST_CHECK(pStats->Mispredicted == Mispredicted);
+}
+
+/**
+  * @brief	Tables the controller cannot take, and a lost response
+  */
+static void Test_GattBuild_Errors(void)
+{
+	GattBuild_Char_t Chars[2];
+	GattBuild_Service_t Service;
+	uint16_t Handle;
+
+	Ctrl_Reset(GATTBUILD_WINDOW);
+
+	/* No handle to write back, description too long */
+	Service = Config_Service;
+	Service.pHandle = NULL;
+	HOST_CHECK(GattBuild_Run(&Service, 1) == GATTBUILD_ERROR_PARAM);
+	memcpy(Chars, Config_Chars, sizeof(Chars));
+	Chars[1].pName = "A user description over thirty-two bytes";
+	Service = Config_Service;
+	Service.pChars = Chars;
+	Service.Chars = 2;
+	HOST_CHECK(GattBuild_Run(&Service, 1) == GATTBUILD_ERROR_PARAM);
+	HOST_CHECK(Ctrl.Commands == 0U);
+
+	/* Fewer handles reserved than the characteristics take */
+	memcpy(Chars, Config_Chars, sizeof(Chars));
+	Service.pHandle = &Handle;
+	Service.Max_Records = 5;
+	HOST_CHECK(GattBuild_Run(&Service, 1) == GATTBUILD_ERROR_ACI);
+
+	Ctrl.Timeout = 1;
+	HOST_CHECK(GattBuild_Run(&Config_Service, 1) == GATTBUILD_ERROR_TIMEOUT);
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(void)
+{
+	HOST_RUN(Test_GattBuild_Boot);
+	HOST_RUN(Test_GattBuild_Product);
+	HOST_RUN(Test_GattBuild_OneCredit);
+	HOST_RUN(Test_GattBuild_Reset);
+	HOST_RUN(Test_GattBuild_Errors);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
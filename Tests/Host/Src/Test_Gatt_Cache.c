@@ -0,0 +1,632 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Gatt_Cache.c
+  * @brief      : Host test of Gatt_Cache.c against an emulated GATT server. The emulator answers the
+	*								discovery procedures one ATT request at a time, as a peer with the default
+	*								23-byte MTU, and counts the round trips of every connection.
+  * @author			:
+  **************************************************************************************************
+  *
+  * The cache is stored on the file-backed flash of Flash_Sim.c through KV_Store.c, so a reconnect
+  * can also follow a reset of the central. Each scenario prints the round trips of the full
+  * discovery and of the reconnect, and checks them against the statistics of the cache.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Host_Test.h"
+#include "Flash_Sim.h"
+#include "Gatt_Cache.h"
+#include "Radio_Sched.h"
+#include "Event_Mask.h"
+#include "bluenrg1_gatt_aci.h"
+#include "bluenrg1_gatt_server.h"
+#include "bluenrg1_events.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define TEST_IMAGE											"Test_Gatt_Cache.bin"
+
+#define TEST_CONN_HANDLE								0x0801U
+#define TEST_ATT_MTU										23U
+
+#define TEST_MAX_SERVICES								16U
+#define TEST_MAX_CHARS									96U
+
+#define TEST_DATABASE_HASH_UUID					0x2B2AU
+
+/* Calls of GattCache_Process() allowed to resolve a database */
+#define TEST_MAX_STEPS									1000U
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+typedef struct
+{
+	uint16_t Start;
+	uint16_t End;
+	uint8_t UUID_128;
+	uint8_t UUID[16];
+
+} Test_Service_t;
+
+typedef struct
+{
+	uint16_t Decl;
+	uint16_t Value;
+	uint8_t Properties;
+	uint8_t UUID_128;
+	uint8_t UUID[16];
+
+} Test_Char_t;
+
+/* Database of an emulated peer */
+typedef struct
+{
+	uint8_t Addr_Type;
+	uint8_t Addr[6];
+	uint8_t Has_Hash;									/* Exposes a Database Hash characteristic */
+	uint8_t Hash[16];
+	uint8_t Services;
+	uint8_t Chars;
+	Test_Service_t Service[TEST_MAX_SERVICES];
+	Test_Char_t Char[TEST_MAX_CHARS];
+
+} Test_Peer_t;
+
+typedef enum
+{
+	TEST_REQ_NONE = 0x00,
+	TEST_REQ_READ_HASH,
+	TEST_REQ_SERVICES,
+	TEST_REQ_CHARS,
+
+} Test_Request_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static const KVStore_IO_t Test_IO =
+{
+	FlashSim_Erase,
+	FlashSim_Program,
+	FlashSim_Read,
+};
+
+static Test_Peer_t Peers[3];
+static const Test_Peer_t *pConnected;
+
+/* Procedure started by the cache, answered by Test_Serve() */
+static Test_Request_t Request;
+static uint16_t Request_Start;
+static uint16_t Request_End;
+static uint8_t Busy_Count;						/* Requests to refuse with BLE_STATUS_NOT_ALLOWED */
+
+static uint32_t Round_Trips;					/* ATT requests of the emulated peer */
+
+static RadioSched_Job_t Job;
+static uint32_t Ready_Calls;
+static uint8_t Ready_From_Cache;
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+/* The store is only given the simulated flash, the HAL routines must not be reached */
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+	(void)TypeProgram;
+	(void)Address;
+	(void)Data;
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+	(void)pEraseInit;
+	(void)SectorError;
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+EvtMask_Status_t EvtMask_RegisterList(const uint32_t *pEvents, uint8_t Count)
+{
+	(void)pEvents;
+	HOST_CHECK(Count > 0U);
+	return EVTMASK_OK;
+}
+
+/* Saves run once the event being processed returned, as from the radio scheduler */
+RadioSched_Status_t RadioSched_Submit(RadioSched_Job_t Job_Func, void *pContext, uint32_t Duration_us)
+{
+	(void)pContext;
+	(void)Duration_us;
+
+	if(Job != NULL)
+	{
+		return RADIOSCHED_ERROR_FULL;
+	}
+	Job = Job_Func;
+	return RADIOSCHED_OK;
+}
+
+static tBleStatus Test_Start(uint16_t Connection_Handle, Test_Request_t Req, uint16_t Start, uint16_t End)
+{
+	HOST_CHECK(Connection_Handle == TEST_CONN_HANDLE);
+	HOST_CHECK(Request == TEST_REQ_NONE);
+
+	if(Busy_Count > 0U)
+	{
+		Busy_Count--;
+		return BLE_STATUS_NOT_ALLOWED;
+	}
+	Request = Req;
+	Request_Start = Start;
+	Request_End = End;
+	return BLE_STATUS_SUCCESS;
+}
+
+tBleStatus aci_gatt_read_using_char_uuid(uint16_t Connection_Handle, uint16_t Start_Handle, uint16_t End_Handle,
+																				 uint8_t UUID_Type, UUID_t *UUID)
+{
+	HOST_CHECK((UUID_Type == UUID_TYPE_16) && (UUID->UUID_16 == TEST_DATABASE_HASH_UUID));
+	return Test_Start(Connection_Handle, TEST_REQ_READ_HASH, Start_Handle, End_Handle);
+}
+
+tBleStatus aci_gatt_disc_all_primary_services(uint16_t Connection_Handle)
+{
+	return Test_Start(Connection_Handle, TEST_REQ_SERVICES, 0x0001, 0xFFFF);
+}
+
+tBleStatus aci_gatt_disc_all_char_of_service(uint16_t Connection_Handle, uint16_t Start_Handle, uint16_t End_Handle)
+{
+	return Test_Start(Connection_Handle, TEST_REQ_CHARS, Start_Handle, End_Handle);
+}
+
+static void Test_PutHandle(uint8_t *pData, uint16_t Handle)
+{
+	pData[0] = (uint8_t)Handle;
+	pData[1] = (uint8_t)(Handle >> 8);
+}
+
+/**
+  * @brief	Answers the primary service discovery: one Read By Group Type response per round trip,
+  *					entries of one size only, closed by an Attribute Not Found
+  */
+static void Test_ServeServices(void)
+{
+	uint8_t Data[TEST_ATT_MTU];
+	uint16_t Start = Request_Start;
+	uint8_t Length, Entry, Used, i;
+
+	for(;;)
+	{
+		Round_Trips++;
+
+		for(i = 0; (i < pConnected->Services) && (pConnected->Service[i].Start < Start); i++)
+		{
+		}
+		if(i == pConnected->Services)
+		{
+			break;
+		}
+
+		Entry = pConnected->Service[i].UUID_128 ? 20U : 6U;
+		for(Used = 0; (i < pConnected->Services) && (pConnected->Service[i].UUID_128 == (Entry == 20U)) &&
+									((Used + Entry) <= (TEST_ATT_MTU - 2U)); i++, Used += Entry)
+		{
+			Test_PutHandle(&Data[Used], pConnected->Service[i].Start);
+			Test_PutHandle(&Data[Used + 2U], pConnected->Service[i].End);
+			memcpy(&Data[Used + 4U], pConnected->Service[i].UUID, Entry - 4U);
+			Start = pConnected->Service[i].End + 1U;
+		}
+		Length = Used;
+		aci_att_read_by_group_type_resp_event(TEST_CONN_HANDLE, Entry, Length, Data);
+	}
+}
+
+/**
+  * @brief	Answers the characteristic discovery of one service, as Test_ServeServices()
+  */
+static void Test_ServeChars(void)
+{
+	uint8_t Data[TEST_ATT_MTU];
+	uint16_t Start = Request_Start;
+	uint8_t Entry, Used, i;
+
+	for(;;)
+	{
+		Round_Trips++;
+
+		for(i = 0; (i < pConnected->Chars) && (pConnected->Char[i].Decl < Start); i++)
+		{
+		}
+		if((i == pConnected->Chars) || (pConnected->Char[i].Decl > Request_End))
+		{
+			break;
+		}
+
+		Entry = pConnected->Char[i].UUID_128 ? 21U : 7U;
+		for(Used = 0; (i < pConnected->Chars) && (pConnected->Char[i].Decl <= Request_End) &&
+									(pConnected->Char[i].UUID_128 == (Entry == 21U)) && ((Used + Entry) <= (TEST_ATT_MTU - 2U)); i++, Used += Entry)
+		{
+			Test_PutHandle(&Data[Used], pConnected->Char[i].Decl);
+			Data[Used + 2U] = pConnected->Char[i].Properties;
+			Test_PutHandle(&Data[Used + 3U], pConnected->Char[i].Value);
+			memcpy(&Data[Used + 5U], pConnected->Char[i].UUID, Entry - 5U);
+			Start = pConnected->Char[i].Decl + 1U;
+		}
+		aci_att_read_by_type_resp_event(TEST_CONN_HANDLE, Entry, Used, Data);
+	}
+}
+
+/**
+  * @brief	Runs the procedure the cache started, then the save it submitted
+  */
+static void Test_Serve(void)
+{
+	uint8_t Hash[16];
+
+	switch(Request)
+	{
+		case TEST_REQ_READ_HASH:
+			Round_Trips++;
+			if(pConnected->Has_Hash)
+			{
+				memcpy(Hash, pConnected->Hash, 16);
+				aci_gatt_disc_read_char_by_uuid_resp_event(TEST_CONN_HANDLE, 0x0003, 16, Hash);
+			}
+			break;
+		case TEST_REQ_SERVICES:
+			Test_ServeServices();
+			break;
+		case TEST_REQ_CHARS:
+			Test_ServeChars();
+			break;
+		default:
+			break;
+	}
+
+	if(Request != TEST_REQ_NONE)
+	{
+		Request = TEST_REQ_NONE;
+		aci_gatt_proc_complete_event(TEST_CONN_HANDLE, BLE_STATUS_SUCCESS);
+	}
+
+	if(Job != NULL)
+	{
+		RadioSched_Job_t Run = Job;
+
+		Job = NULL;
+		Run(NULL);
+	}
+}
+
+static void Test_Ready(uint16_t Connection_Handle, uint8_t From_Cache)
+{
+	HOST_CHECK(Connection_Handle == TEST_CONN_HANDLE);
+	Ready_Calls++;
+	Ready_From_Cache = From_Cache;
+}
+
+/**
+  * @brief	Builds a database: each service holds its characteristics, those notifying have a CCCD
+  */
+static void Test_MakePeer(Test_Peer_t *pPeer, uint8_t Id, uint8_t Services, uint8_t Chars_Per_Service, uint8_t Has_Hash)
+{
+	uint16_t Handle = 1;
+	uint8_t s, c;
+	Test_Char_t *pChar;
+
+	memset(pPeer, 0, sizeof(Test_Peer_t));
+	pPeer->Addr_Type = Id & 1U;
+	memcpy(pPeer->Addr, "\x11\x22\x33\x44\x55\x00", 6);
+	pPeer->Addr[5] = Id;
+	pPeer->Has_Hash = Has_Hash;
+	memset(pPeer->Hash, 0xA0 + Id, 16);
+
+	for(s = 0; s < Services; s++)
+	{
+		pPeer->Service[s].Start = Handle++;
+		/* Every third service has a 128-bit UUID */
+		pPeer->Service[s].UUID_128 = ((s % 3U) == 2U);
+		memset(pPeer->Service[s].UUID, 0x30 + s, 16);
+		pPeer->Service[s].UUID[0] = Id;
+
+		for(c = 0; c < Chars_Per_Service; c++)
+		{
+			pChar = &pPeer->Char[pPeer->Chars++];
+			pChar->Decl = Handle++;
+			pChar->Value = Handle++;
+			pChar->Properties = ((c % 2U) == 0U) ? 0x12U : 0x0AU;
+			if(pChar->Properties & 0x10U)
+			{
+				Handle++;
+			}
+			pChar->UUID_128 = ((c % 4U) == 3U);
+			memset(pChar->UUID, 0x60 + c, 16);
+			pChar->UUID[0] = (uint8_t)((s << 4) | c);
+			pChar->UUID[1] = Id;
+		}
+		pPeer->Service[s].End = Handle - 1U;
+	}
+	pPeer->Services = Services;
+}
+
+/**
+  * @brief	Connects to a peer and runs the cache until its database is resolved
+  * @retval	Round trips of the connection
+  */
+static uint32_t Test_Connect(const Test_Peer_t *pPeer)
+{
+	uint32_t Steps, Ready = Ready_Calls;
+
+	pConnected = pPeer;
+	Round_Trips = 0;
+	GattCache_Connect(TEST_CONN_HANDLE, pPeer->Addr_Type, pPeer->Addr);
+
+	for(Steps = 0; (Steps < TEST_MAX_STEPS) && (GattCache_GetState() != GATTCACHE_STATE_READY) &&
+								 (GattCache_GetState() != GATTCACHE_STATE_FAILED); Steps++)
+	{
+		GattCache_Process();
+		Test_Serve();
+	}
+	/* The save of a new discovery */
+	Test_Serve();
+
+	HOST_CHECK(GattCache_GetState() == GATTCACHE_STATE_READY);
+	HOST_CHECK(Ready_Calls == (Ready + 1U));
+	GattCache_Disconnect(TEST_CONN_HANDLE);
+
+	return Round_Trips;
+}
+
+/**
+  * @brief	Connected and resolved: every service and characteristic is found with its handles
+  */
+static void Test_CheckHandles(const Test_Peer_t *pPeer)
+{
+	const Test_Service_t *pService;
+	const Test_Char_t *pChar;
+	uint16_t Start, End, Value;
+	uint8_t Properties, s, c;
+
+	pConnected = pPeer;
+	Round_Trips = 0;
+	GattCache_Connect(TEST_CONN_HANDLE, pPeer->Addr_Type, pPeer->Addr);
+	while((GattCache_GetState() != GATTCACHE_STATE_READY) && (GattCache_GetState() != GATTCACHE_STATE_FAILED))
+	{
+		GattCache_Process();
+		Test_Serve();
+	}
+	Test_Serve();
+
+	for(s = 0, c = 0; s < pPeer->Services; s++)
+	{
+		pService = &pPeer->Service[s];
+		HOST_CHECK(GattCache_FindService(pService->UUID_128 ? UUID_TYPE_128 : UUID_TYPE_16, pService->UUID, &Start, &End) == GATTCACHE_OK);
+		HOST_CHECK((Start == pService->Start) && (End == pService->End));
+
+		for(; (c < pPeer->Chars) && (pPeer->Char[c].Decl <= pService->End); c++)
+		{
+			pChar = &pPeer->Char[c];
+			HOST_CHECK(GattCache_FindChar(Start, End, pChar->UUID_128 ? UUID_TYPE_128 : UUID_TYPE_16, pChar->UUID,
+																		&Value, &Properties) == GATTCACHE_OK);
+			HOST_CHECK((Value == pChar->Value) && (Properties == pChar->Properties));
+		}
+	}
+
+	/* A characteristic is only found in its own service */
+	if(pPeer->Services > 1U)
+	{
+		pChar = &pPeer->Char[0];
+		HOST_CHECK(GattCache_FindChar(pPeer->Service[1].Start, pPeer->Service[1].End, pChar->UUID_128 ? UUID_TYPE_128 : UUID_TYPE_16,
+																	pChar->UUID, &Value, NULL) == GATTCACHE_ERROR_NOT_FOUND);
+	}
+
+	GattCache_Disconnect(TEST_CONN_HANDLE);
+}
+
+/**
+  * @brief	Reset of the central: flash reopened, store and cache started again
+  */
+static void Test_Reboot(void)
+{
+	FlashSim_Close();
+	HOST_CHECK(FlashSim_Open(TEST_IMAGE, 2, KVSTORE_SECTOR_SIZE) == 0);
+	KVStore_RegisterIO(&Test_IO);
+	HOST_CHECK(KVStore_Init() == KVSTORE_OK);
+	GattCache_Init();
+	GattCache_SetCallback(Test_Ready);
+}
+
+static void Test_NewDevice(void)
+{
+	FlashSim_Close();
+	(void)remove(TEST_IMAGE);
+	Test_Reboot();
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	Peer with a Database Hash: a full discovery, then reconnects validated by one read,
+  *					before and after a reset of the central
+  */
+static void Test_GattCache_DatabaseHash(void)
+{
+	const GattCache_Stats_t *pStats = GattCache_GetStats();
+	uint32_t Discovery, Reconnect;
+
+	Test_NewDevice();
+	Test_MakePeer(&Peers[0], 1, 6, 4, 1);
+
+	Discovery = Test_Connect(&Peers[0]);
+	HOST_CHECK(!Ready_From_Cache);
+	HOST_CHECK((pStats->Misses == 1U) && (pStats->Hits == 0U) && (pStats->Saves == 1U));
+	HOST_CHECK(pStats->Round_Trips == Discovery);
+
+	Reconnect = Test_Connect(&Peers[0]);
+	HOST_CHECK(Ready_From_Cache);
+	HOST_CHECK(Reconnect == 1U);
+	HOST_CHECK(pStats->Hits == 1U);
+	HOST_CHECK(pStats->Round_Trips_Saved == (Discovery - Reconnect));
+	HOST_CHECK(pStats->Saves == 1U);
+
+	printf("  Database Hash: discovery %u round trips, reconnect %u, saved %u\n", (unsigned int)Discovery,
+				 (unsigned int)Reconnect, (unsigned int)pStats->Round_Trips_Saved);
+
+	Test_Reboot();
+	HOST_CHECK(Test_Connect(&Peers[0]) == 1U);
+	HOST_CHECK(Ready_From_Cache);
+	HOST_CHECK(pStats->Round_Trips_Saved == (Discovery - 1U));
+	Test_CheckHandles(&Peers[0]);
+
+	/* Database changed, so did its hash: discovered again, the new handles are used */
+	Test_MakePeer(&Peers[0], 1, 5, 5, 1);
+	Peers[0].Hash[0] ^= 0xFF;
+	HOST_CHECK(Test_Connect(&Peers[0]) > 1U);
+	HOST_CHECK(!Ready_From_Cache);
+	Test_CheckHandles(&Peers[0]);
+	HOST_CHECK(Ready_From_Cache);
+}
+
+/**
+  * @brief	Peer without Database Hash: validated by its service list, which saves the
+  *					characteristic discovery of every service
+  */
+static void Test_GattCache_ServiceList(void)
+{
+	const GattCache_Stats_t *pStats = GattCache_GetStats();
+	uint32_t Discovery, Reconnect, Service_Discovery;
+
+	Test_NewDevice();
+	Test_MakePeer(&Peers[0], 2, 7, 3, 0);
+
+	/* 3 16-bit or 1 128-bit service per response, and the closing request */
+	Service_Discovery = 6U;
+
+	Discovery = Test_Connect(&Peers[0]);
+	HOST_CHECK(!Ready_From_Cache);
+	Reconnect = Test_Connect(&Peers[0]);
+	HOST_CHECK(Ready_From_Cache);
+	HOST_CHECK(Reconnect == (1U + Service_Discovery));
+	HOST_CHECK(pStats->Round_Trips_Saved == (Discovery - Reconnect));
+	HOST_CHECK(pStats->Round_Trips == (Discovery + Reconnect));
+
+	printf("  Service list: discovery %u round trips, reconnect %u, saved %u\n", (unsigned int)Discovery,
+				 (unsigned int)Reconnect, (unsigned int)pStats->Round_Trips_Saved);
+
+	Test_CheckHandles(&Peers[0]);
+
+	/* A service more: the list does not match, discovered again */
+	Test_MakePeer(&Peers[0], 2, 8, 3, 0);
+	HOST_CHECK(Test_Connect(&Peers[0]) > Reconnect);
+	HOST_CHECK(!Ready_From_Cache);
+	HOST_CHECK(pStats->Misses == 2U);
+	Test_CheckHandles(&Peers[0]);
+	HOST_CHECK(Ready_From_Cache);
+}
+
+/**
+  * @brief	Three peers for two slots: the least recently discovered one is replaced
+  */
+static void Test_GattCache_Peers(void)
+{
+	const GattCache_Stats_t *pStats = GattCache_GetStats();
+
+	Test_NewDevice();
+	Test_MakePeer(&Peers[0], 3, 4, 3, 1);
+	Test_MakePeer(&Peers[1], 4, 3, 4, 1);
+	Test_MakePeer(&Peers[2], 5, 5, 2, 0);
+
+	(void)Test_Connect(&Peers[0]);
+	(void)Test_Connect(&Peers[1]);
+	HOST_CHECK(Test_Connect(&Peers[0]) == 1U);
+	HOST_CHECK(Test_Connect(&Peers[1]) == 1U);
+
+	/* Peer 0 was discovered first: its slot goes to peer 2 */
+	(void)Test_Connect(&Peers[2]);
+	HOST_CHECK(!Ready_From_Cache);
+	HOST_CHECK(Test_Connect(&Peers[1]) == 1U);
+	HOST_CHECK(Ready_From_Cache);
+	(void)Test_Connect(&Peers[2]);
+	HOST_CHECK(Ready_From_Cache);
+	(void)Test_Connect(&Peers[0]);
+	HOST_CHECK(!Ready_From_Cache);
+	HOST_CHECK(pStats->Misses == 4U);
+
+	/* Forgotten (e.g. Service Changed): discovered again */
+	HOST_CHECK(GattCache_Forget(Peers[0].Addr_Type, Peers[0].Addr) == GATTCACHE_OK);
+	HOST_CHECK(GattCache_Forget(Peers[0].Addr_Type, Peers[0].Addr) == GATTCACHE_ERROR_NOT_FOUND);
+	HOST_CHECK(Test_Connect(&Peers[0]) > 1U);
+	HOST_CHECK(!Ready_From_Cache);
+	Test_CheckHandles(&Peers[0]);
+}
+
+/**
+  * @brief	Database larger than an image: used for the connection, not stored
+  */
+static void Test_GattCache_Overflow(void)
+{
+	const GattCache_Stats_t *pStats = GattCache_GetStats();
+	uint32_t Discovery;
+
+	Test_NewDevice();
+	Test_MakePeer(&Peers[0], 6, 12, 6, 1);
+
+	Discovery = Test_Connect(&Peers[0]);
+	HOST_CHECK(pStats->Overflows == 1U);
+	HOST_CHECK(pStats->Saves == 0U);
+	HOST_CHECK(Test_Connect(&Peers[0]) == Discovery);
+	HOST_CHECK(!Ready_From_Cache);
+	HOST_CHECK(pStats->Hits == 0U);
+}
+
+/**
+  * @brief	A procedure refused while another runs is retried on the next pass
+  */
+static void Test_GattCache_Busy(void)
+{
+	const GattCache_Stats_t *pStats = GattCache_GetStats();
+
+	Test_NewDevice();
+	Test_MakePeer(&Peers[0], 7, 3, 3, 1);
+
+	HOST_CHECK(GattCache_FindService(UUID_TYPE_16, Peers[0].Service[0].UUID, &Request_Start, &Request_End) == GATTCACHE_ERROR_NOT_READY);
+
+	Busy_Count = 5;
+	(void)Test_Connect(&Peers[0]);
+	HOST_CHECK(Busy_Count == 0U);
+	HOST_CHECK(pStats->Errors == 0U);
+	HOST_CHECK(Test_Connect(&Peers[0]) == 1U);
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(void)
+{
+	HOST_RUN(Test_GattCache_DatabaseHash);
+	HOST_RUN(Test_GattCache_ServiceList);
+	HOST_RUN(Test_GattCache_Peers);
+	HOST_RUN(Test_GattCache_Overflow);
+	HOST_RUN(Test_GattCache_Busy);
+
+	FlashSim_Close();
+	(void)remove(TEST_IMAGE);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
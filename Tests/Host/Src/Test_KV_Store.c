@@ -0,0 +1,410 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_KV_Store.c
+  * @brief      : Host test of KV_Store.c on the file-backed flash of Flash_Sim.c. The power is cut
+	*								during every erase and program of a workload crossing several compactions,
+	*								then the store is mounted again as after a reset.
+  * @author			:
+  **************************************************************************************************
+  *
+  * After a power loss each key must hold the value of its last completed write, except the key
+  * written when the power was cut, which may hold either its old or its new value. The store must
+  * then accept writes again without programming a word that is not erased.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Host_Test.h"
+#include "Flash_Sim.h"
+#include "KV_Store.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define TEST_IMAGE											"Test_KV_Store.bin"
+
+/* Writes of the power loss workload, enough for three compactions */
+#define TEST_WORKLOAD_WRITES						1200U
+
+/* Keys filled before the workload, so compactions have records to copy */
+#define TEST_PREFILL_KEYS								24U
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+/* Expected content of the store */
+typedef struct
+{
+	uint8_t Present[KVSTORE_MAX_KEYS];
+	uint16_t Length[KVSTORE_MAX_KEYS];
+	uint8_t Value[KVSTORE_MAX_KEYS][KVSTORE_MAX_VALUE_SIZE];
+
+} Test_Model_t;
+
+typedef struct
+{
+	uint16_t Key;
+	uint16_t Length;										/* 0 deletes the key */
+	uint8_t Value[KVSTORE_MAX_VALUE_SIZE];
+
+} Test_Op_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static const KVStore_IO_t Test_IO =
+{
+	FlashSim_Erase,
+	FlashSim_Program,
+	FlashSim_Read,
+};
+
+static Test_Model_t Model;
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+/* The store is only given the simulated flash, the HAL routines must not be reached */
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+	(void)TypeProgram;
+	(void)Address;
+	(void)Data;
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+	(void)pEraseInit;
+	(void)SectorError;
+	HOST_CHECK(0);
+	return HAL_ERROR;
+}
+
+/**
+  * @brief	Reset of the device: the image is reopened and the store mounted again
+  */
+static KVStore_Status_t Test_Reboot(void)
+{
+	FlashSim_Close();
+	HOST_CHECK(FlashSim_Open(TEST_IMAGE, 2, KVSTORE_SECTOR_SIZE) == 0);
+	KVStore_RegisterIO(&Test_IO);
+
+	return KVStore_Init();
+}
+
+/**
+  * @brief	New device: blank flash, mounted once
+  */
+static void Test_NewDevice(void)
+{
+	FlashSim_Close();
+	(void)remove(TEST_IMAGE);
+	HOST_CHECK(Test_Reboot() == KVSTORE_OK);
+	memset(&Model, 0, sizeof(Model));
+}
+
+static void Test_ModelApply(const Test_Op_t *pOp)
+{
+	Model.Present[pOp->Key] = (pOp->Length != 0U);
+	Model.Length[pOp->Key] = pOp->Length;
+	memcpy(Model.Value[pOp->Key], pOp->Value, pOp->Length);
+}
+
+/**
+  * @brief	Checks that the store holds the content of the model
+  */
+static uint8_t Test_ModelMatches(void)
+{
+	uint8_t Value[KVSTORE_MAX_VALUE_SIZE];
+	uint16_t Length;
+	uint16_t Key;
+	KVStore_Status_t Status;
+
+	for(Key = 0; Key < KVSTORE_MAX_KEYS; Key++)
+	{
+		Length = sizeof(Value);
+		Status = KVStore_Read(Key, Value, &Length);
+		if(!Model.Present[Key])
+		{
+			if(Status != KVSTORE_ERROR_NOT_FOUND)
+			{
+				return 0;
+			}
+		}
+		else if((Status != KVSTORE_OK) || (Length != Model.Length[Key]) ||
+						(memcmp(Value, Model.Value[Key], Length) != 0))
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/**
+  * @brief	Random write, one in eight deletes its key
+  */
+static void Test_RandomOp(Test_Op_t *pOp, uint32_t *pSeed)
+{
+	uint16_t i;
+
+	pOp->Key = (uint16_t)(Host_Rand(pSeed) % KVSTORE_MAX_KEYS);
+	pOp->Length = ((Host_Rand(pSeed) % 8U) == 0U) ? 0U :
+								(uint16_t)(1U + (Host_Rand(pSeed) % KVSTORE_MAX_VALUE_SIZE));
+	for(i = 0; i < pOp->Length; i++)
+	{
+		pOp->Value[i] = (uint8_t)Host_Rand(pSeed);
+	}
+}
+
+static KVStore_Status_t Test_Apply(const Test_Op_t *pOp)
+{
+	return (pOp->Length == 0U) ? KVStore_Delete(pOp->Key) : KVStore_Write(pOp->Key, pOp->Value, pOp->Length);
+}
+
+/**
+  * @brief	Fills the first keys, without power loss
+  */
+static void Test_Prefill(void)
+{
+	Test_Op_t Op;
+	uint32_t Seed = 7;
+
+	for(Op.Key = 0; Op.Key < TEST_PREFILL_KEYS; Op.Key++)
+	{
+		Test_RandomOp(&Op, &Seed);
+		Op.Length = (uint16_t)(1U + (Op.Key % KVSTORE_MAX_VALUE_SIZE));
+		HOST_CHECK(Test_Apply(&Op) == KVSTORE_OK);
+		Test_ModelApply(&Op);
+	}
+}
+
+/**
+  * @brief	Runs the writes of the workload until the power is lost
+  * @param	pOp: out, the write the power was lost during
+  * @retval	1 if the power was lost
+  */
+static uint8_t Test_RunWorkload(uint32_t Writes, uint32_t Seed, Test_Op_t *pOp)
+{
+	uint32_t n;
+	KVStore_Status_t Status;
+
+	for(n = 0; n < Writes; n++)
+	{
+		Test_RandomOp(pOp, &Seed);
+		Status = Test_Apply(pOp);
+		if(FlashSim_PowerLost())
+		{
+			return 1;
+		}
+		HOST_CHECK(Status == KVSTORE_OK);
+		Test_ModelApply(pOp);
+	}
+	return 0;
+}
+
+/**
+  * @brief	Mounts the store after a power loss and checks its content
+  * @param	pOp: the write the power was lost during
+  */
+static void Test_Recover(const Test_Op_t *pOp, uint32_t Cut)
+{
+	Test_Model_t Before = Model;
+	uint8_t Matches;
+
+	HOST_CHECK(Test_Reboot() == KVSTORE_OK);
+
+	/* Either the interrupted write did not happen, or it completed */
+	Matches = Test_ModelMatches();
+	if(!Matches)
+	{
+		Test_ModelApply(pOp);
+		Matches = Test_ModelMatches();
+		if(!Matches)
+		{
+			Model = Before;
+		}
+	}
+	HOST_CHECK(Matches);
+	if(!Matches)
+	{
+		printf("  power cut at operation %u\n", (unsigned int)Cut);
+	}
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	Read, write, delete and parameter checks
+  */
+static void Test_KVStore_Basic(void)
+{
+	const uint8_t Identity[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x34, 0x12};
+	uint8_t Value[KVSTORE_MAX_VALUE_SIZE + 1];
+	uint16_t Length;
+	uint32_t Programs;
+
+	Test_NewDevice();
+	memset(Value, 0x5A, sizeof(Value));
+
+	Length = sizeof(Value);
+	HOST_CHECK(KVStore_Read(KVSTORE_KEY_DEVICE_IDENTITY, Value, &Length) == KVSTORE_ERROR_NOT_FOUND);
+	HOST_CHECK(KVStore_Write(KVSTORE_MAX_KEYS, Identity, sizeof(Identity)) == KVSTORE_ERROR_PARAM);
+	HOST_CHECK(KVStore_Write(1, Value, KVSTORE_MAX_VALUE_SIZE + 1) == KVSTORE_ERROR_PARAM);
+	HOST_CHECK(KVStore_Write(1, NULL, 4) == KVSTORE_ERROR_PARAM);
+
+	HOST_CHECK(KVStore_Write(KVSTORE_KEY_DEVICE_IDENTITY, Identity, sizeof(Identity)) == KVSTORE_OK);
+	HOST_CHECK(KVStore_Write(KVSTORE_KEY_FW_UPDATE, Value, KVSTORE_MAX_VALUE_SIZE) == KVSTORE_OK);
+
+	/* Buffer too small for the value */
+	Length = sizeof(Identity) - 1U;
+	HOST_CHECK(KVStore_Read(KVSTORE_KEY_DEVICE_IDENTITY, Value, &Length) == KVSTORE_ERROR_PARAM);
+
+	/* Same value again, or deleting a missing key: nothing is programmed */
+	Programs = FlashSim_Stats.Programs;
+	HOST_CHECK(KVStore_Write(KVSTORE_KEY_DEVICE_IDENTITY, Identity, sizeof(Identity)) == KVSTORE_OK);
+	HOST_CHECK(KVStore_Delete(KVSTORE_KEY_GATT_CACHE) == KVSTORE_OK);
+	HOST_CHECK(FlashSim_Stats.Programs == Programs);
+
+	HOST_CHECK(KVStore_Delete(KVSTORE_KEY_FW_UPDATE) == KVSTORE_OK);
+	HOST_CHECK(FlashSim_Stats.Programs > Programs);
+
+	/* The values are read back from the image file after a reset */
+	HOST_CHECK(Test_Reboot() == KVSTORE_OK);
+	Length = sizeof(Value);
+	HOST_CHECK(KVStore_Read(KVSTORE_KEY_DEVICE_IDENTITY, Value, &Length) == KVSTORE_OK);
+	HOST_CHECK((Length == sizeof(Identity)) && (memcmp(Value, Identity, Length) == 0));
+	Length = sizeof(Value);
+	HOST_CHECK(KVStore_Read(KVSTORE_KEY_FW_UPDATE, Value, &Length) == KVSTORE_ERROR_NOT_FOUND);
+	HOST_CHECK(FlashSim_Stats.Errors == 0U);
+}
+
+/**
+  * @brief	Long run of writes: compactions keep the live records and alternate the sectors
+  */
+static void Test_KVStore_Compaction(void)
+{
+	Test_Op_t Op;
+	uint32_t Seed = 11, n;
+
+	Test_NewDevice();
+	Test_Prefill();
+
+	for(n = 0; n < 5000U; n++)
+	{
+		Test_RandomOp(&Op, &Seed);
+		HOST_CHECK(Test_Apply(&Op) == KVSTORE_OK);
+		Test_ModelApply(&Op);
+
+		if((n % 1000U) == 999U)
+		{
+			HOST_CHECK(Test_ModelMatches());
+			HOST_CHECK(FlashSim_Stats.Errors == 0U);
+			HOST_CHECK(Test_Reboot() == KVSTORE_OK);
+		}
+	}
+
+	HOST_CHECK(Test_ModelMatches());
+	HOST_CHECK(FlashSim_Stats.Erases[1] >= 5U);
+	HOST_CHECK((FlashSim_Stats.Erases[0] <= (FlashSim_Stats.Erases[1] + 1U)) &&
+						 (FlashSim_Stats.Erases[1] <= (FlashSim_Stats.Erases[0] + 1U)));
+
+	/* Explicit compaction */
+	HOST_CHECK(KVStore_Compact() == KVSTORE_OK);
+	HOST_CHECK(Test_Reboot() == KVSTORE_OK);
+	HOST_CHECK(Test_ModelMatches());
+}
+
+/**
+  * @brief	Power lost while the first mount formats the flash
+  */
+static void Test_KVStore_PowerLossFormat(void)
+{
+	uint32_t Cut;
+
+	for(Cut = 1; Cut <= 3U; Cut++)
+	{
+		Test_NewDevice();
+		FlashSim_Blank();
+		FlashSim_CutPower(Cut, Cut);
+		HOST_CHECK(KVStore_Init() == KVSTORE_ERROR_FLASH);
+
+		HOST_CHECK(Test_Reboot() == KVSTORE_OK);
+		HOST_CHECK(Test_ModelMatches());
+		HOST_CHECK(KVStore_Write(KVSTORE_KEY_DEVICE_IDENTITY, "id", 2) == KVSTORE_OK);
+		HOST_CHECK(Test_Reboot() == KVSTORE_OK);
+		HOST_CHECK(FlashSim_Stats.Errors == 0U);
+	}
+}
+
+/**
+  * @brief	Power cut during each erase and program of the workload in turn, then a second cut
+  *					while writing again
+  */
+static void Test_KVStore_PowerLoss(void)
+{
+	Test_Op_t Op;
+	uint32_t Total, Cut, Seed = 5;
+
+	/* Dry run: operations of the workload */
+	Test_NewDevice();
+	Test_Prefill();
+	Total = FlashSim_Stats.Operations;
+	HOST_CHECK(Test_RunWorkload(TEST_WORKLOAD_WRITES, 1000, &Op) == 0U);
+	Total = FlashSim_Stats.Operations - Total;
+	HOST_CHECK((FlashSim_Stats.Erases[0] + FlashSim_Stats.Erases[1]) >= 4U);
+
+	for(Cut = 1; Cut <= Total; Cut++)
+	{
+		Test_NewDevice();
+		Test_Prefill();
+
+		FlashSim_CutPower(Cut, Cut);
+		HOST_CHECK(Test_RunWorkload(TEST_WORKLOAD_WRITES, 1000, &Op) == 1U);
+		Test_Recover(&Op, Cut);
+
+		/* Writing again, with a second cut somewhere in the next writes */
+		FlashSim_CutPower(1U + (Host_Rand(&Seed) % 2000U), Cut);
+		if(Test_RunWorkload(200, Cut, &Op))
+		{
+			Test_Recover(&Op, Cut);
+		}
+		FlashSim_CutPower(0, 0);
+		HOST_CHECK(Test_RunWorkload(100, Cut + 1U, &Op) == 0U);
+		HOST_CHECK(Test_Reboot() == KVSTORE_OK);
+		HOST_CHECK(Test_ModelMatches());
+
+		/* Programming a word that is not erased would go unnoticed on the device */
+		HOST_CHECK(FlashSim_Stats.Errors == 0U);
+	}
+
+	printf("  power cut at each of the %u operations\n", (unsigned int)Total);
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(void)
+{
+	HOST_RUN(Test_KVStore_Basic);
+	HOST_RUN(Test_KVStore_Compaction);
+	HOST_RUN(Test_KVStore_PowerLossFormat);
+	HOST_RUN(Test_KVStore_PowerLoss);
+
+	FlashSim_Close();
+	(void)remove(TEST_IMAGE);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
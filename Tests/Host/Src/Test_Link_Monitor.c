@@ -0,0 +1,524 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Link_Monitor.c
+  * @brief      : Host test of Link_Monitor.c. Scripted RSSI and loss traces are fed to the power
+	*								controller of a link whose packets get lost when the peer receives them too
+	*								weakly; the monitor is then run on emulated links.
+  * @author			:
+  **************************************************************************************************
+  *
+  * The TX power must step up as soon as the link degrades, step down only once the margin above
+  * the window held for LINKMON_LOWER_HOLD samples, and settle without oscillating on any constant
+  * trace.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Host_Test.h"
+#include "Link_Monitor.h"
+#include "bluenrg1_hal_aci.h"
+#include "bluenrg1_hci_le.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* Packets sent by the link between two samples */
+#define TEST_PACKETS										20U
+
+/* Peer sensitivity: packets start to get lost below TEST_SENS_DBM, half of them
+   TEST_SENS_RANGE_DB lower */
+#define TEST_SENS_DBM										(-88)
+#define TEST_SENS_RANGE_DB							10
+
+/* Samples a controller is given to settle on a constant trace */
+#define TEST_SETTLE											100U
+
+#define TEST_TOP_LEVEL									((uint8_t)(LinkMon_LevelCount() - 1U))
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+/**
+  * @brief A link: path loss, measurement noise and interference, and the controller driving it
+  */
+typedef struct
+{
+	LinkMon_Ctrl_t Ctrl;
+	uint8_t Level;
+	int16_t Path_Loss_dB;
+	uint8_t Noise_dB;									/* RSSI measured within +/- Noise_dB */
+	uint8_t Interference;							/* Packets lost whatever the signal, per 256 */
+	uint32_t Loss_Acc;								/* Lost packets carried to the next sample, per 256 */
+	uint32_t Seed;
+
+	uint32_t Raises;
+	uint32_t Lowers;
+	uint32_t Reversals;								/* Changes of direction of the level */
+	int8_t Last_Step;
+	int8_t Peer_Min;									/* Lowest RSSI the peer received */
+	uint32_t Failed;
+
+} Link_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Emulated controller of the monitor test */
+static uint32_t Tick;
+static uint8_t Link_Status[LINKMON_MAX_LINKS];
+static uint16_t Link_Handle[LINKMON_MAX_LINKS];
+static int8_t Link_RSSI[LINKMON_MAX_LINKS];
+static uint8_t Tx_High_Power, Tx_PA_Level;
+static uint32_t Tx_Power_Sets;
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+uint32_t HAL_GetTick(void)
+{
+	return Tick;
+}
+
+tBleStatus aci_hal_get_link_status(uint8_t Status[8], uint16_t Handle[16 / 2])
+{
+	memcpy(Status, Link_Status, sizeof(Link_Status));
+	memcpy(Handle, Link_Handle, sizeof(Link_Handle));
+	return BLE_STATUS_SUCCESS;
+}
+
+tBleStatus hci_read_rssi(uint16_t Connection_Handle, int8_t *RSSI)
+{
+	uint8_t i;
+
+	for(i = 0; i < LINKMON_MAX_LINKS; i++)
+	{
+		if((Link_Status[i] != 0U) && (Link_Handle[i] == Connection_Handle) && (Link_RSSI[i] != LINKMON_RSSI_UNAVAILABLE))
+		{
+			*RSSI = Link_RSSI[i];
+			return BLE_STATUS_SUCCESS;
+		}
+	}
+	return BLE_STATUS_ERROR;
+}
+
+tBleStatus aci_hal_set_tx_power_level(uint8_t En_High_Power, uint8_t PA_Level)
+{
+	Tx_High_Power = En_High_Power;
+	Tx_PA_Level = PA_Level;
+	Tx_Power_Sets++;
+	return BLE_STATUS_SUCCESS;
+}
+
+static void Link_Init(Link_t *pLink, uint8_t Level, int16_t Path_Loss_dB, uint32_t Seed)
+{
+	memset(pLink, 0, sizeof(Link_t));
+	LinkMon_CtrlInit(&pLink->Ctrl, Level);
+	pLink->Level = Level;
+	pLink->Path_Loss_dB = Path_Loss_dB;
+	pLink->Peer_Min = INT8_MAX;
+	pLink->Seed = Seed;
+}
+
+/* RSSI the peer actually receives at a level */
+static int16_t Link_PeerRSSI(const Link_t *pLink, uint8_t Level)
+{
+	return LinkMon_GetLevel(Level)->Power_dBm - pLink->Path_Loss_dB;
+}
+
+/**
+  * @brief	One sample period: the peer measured here, the packets sent at the current level, then
+  *					the controller update
+  * @retval	Level change
+  */
+static int8_t Link_Sample(Link_t *pLink)
+{
+	int16_t RSSI, Peer;
+	uint32_t Loss;
+	uint16_t Failed;
+	uint8_t Level;
+	int8_t Step;
+
+	RSSI = LINKMON_PEER_TX_DBM - pLink->Path_Loss_dB;
+	if(pLink->Noise_dB != 0U)
+	{
+		RSSI += (int16_t)(Host_Rand(&pLink->Seed) % ((2U * pLink->Noise_dB) + 1U)) - pLink->Noise_dB;
+	}
+
+	/* Loss per 256: 0 above the sensitivity, half of the packets TEST_SENS_RANGE_DB under it */
+	Peer = Link_PeerRSSI(pLink, pLink->Level);
+	Loss = 0;
+	if(Peer < TEST_SENS_DBM)
+	{
+		Loss = ((uint32_t)(TEST_SENS_DBM - Peer) * 128U) / TEST_SENS_RANGE_DB;
+		Loss = (Loss > 256U) ? 256U : Loss;
+	}
+	Loss += pLink->Interference;
+
+	/* Spread evenly over the samples, so that a constant loss gives a constant trace */
+	pLink->Loss_Acc += TEST_PACKETS * ((Loss > 256U) ? 256U : Loss);
+	Failed = (uint16_t)(pLink->Loss_Acc >> 8);
+	pLink->Loss_Acc &= 0xFFU;
+	pLink->Failed += Failed;
+	if(Peer < pLink->Peer_Min)
+	{
+		pLink->Peer_Min = (int8_t)Peer;
+	}
+
+	Level = LinkMon_CtrlUpdate(&pLink->Ctrl, (int8_t)RSSI, TEST_PACKETS, Failed);
+	Step = (int8_t)(Level - pLink->Level);
+	if(Step > 0)
+	{
+		pLink->Raises++;
+	}
+	else if(Step < 0)
+	{
+		pLink->Lowers++;
+	}
+	if(Step != 0)
+	{
+		if((pLink->Last_Step != 0) && ((Step > 0) != (pLink->Last_Step > 0)))
+		{
+			pLink->Reversals++;
+		}
+		pLink->Last_Step = Step;
+	}
+	pLink->Level = Level;
+
+	return Step;
+}
+
+/**
+  * @brief	Level a settled controller must end at: the lowest keeping the estimate at the peer
+  *					above the window, unless even the top level cannot
+  */
+static uint8_t Test_Settled(const LinkMon_Ctrl_t *pCtrl, uint8_t Level)
+{
+	if((Level < TEST_TOP_LEVEL) && (LinkMon_PeerRSSI(pCtrl, Level) < LINKMON_TARGET_LOW_DBM))
+	{
+		return 0;
+	}
+	if((Level > 0U) && (LinkMon_PeerRSSI(pCtrl, Level - 1U) >= LINKMON_TARGET_HIGH_DBM))
+	{
+		return 0;
+	}
+	return 1;
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	The peer walks away, the signal fades at once, then interference: the power goes up,
+  *					never down, and keeps the peer above its sensitivity while the ladder allows
+  */
+static void Test_LinkMon_Degrade(void)
+{
+	Link_t Link;
+	uint32_t k;
+	int8_t Step;
+
+	/* From 45 to 95 dB of path loss in 0.2 dB steps, noisy RSSI */
+	Link_Init(&Link, 0, 45, 1U);
+	Link.Noise_dB = 2;
+	for(k = 0; k < 250U; k++)
+	{
+		Link.Path_Loss_dB = (int16_t)(45 + (k / 5U));
+		HOST_CHECK(Link_Sample(&Link) >= 0);
+
+		/* Within the smoothing lag of the window while the top level is not reached */
+		if(Link.Level < TEST_TOP_LEVEL)
+		{
+			HOST_CHECK(Link_PeerRSSI(&Link, Link.Level) >= (LINKMON_TARGET_LOW_DBM - 5));
+		}
+	}
+	HOST_CHECK((Link.Lowers == 0U) && (Link.Raises > 0U) && (Link.Level == TEST_TOP_LEVEL));
+	HOST_CHECK(Link.Failed == 0U);
+
+	/* 23 dB fade from the bottom of the window: several steps at the first sample, back in the
+	   window once the smoothed RSSI caught up */
+	Link_Init(&Link, 0, 62, 2U);
+	for(k = 0; k < TEST_SETTLE; k++)
+	{
+		(void)Link_Sample(&Link);
+	}
+	HOST_CHECK((Link.Raises == 0U) && (Link.Lowers == 0U) && (Link.Level == 0U));
+	Link.Path_Loss_dB = 85;
+	HOST_CHECK(Link_Sample(&Link) >= 2);
+	for(k = 1; (k < 20U) && (Link_PeerRSSI(&Link, Link.Level) < LINKMON_TARGET_LOW_DBM); k++)
+	{
+		HOST_CHECK(Link_Sample(&Link) >= 0);
+	}
+	HOST_CHECK(k <= 12U);
+
+	/* 15% interference at a strong signal: one step a sample, from when the smoothed loss
+	   passes 5% until the interference stops */
+	Link_Init(&Link, 0, 40, 3U);
+	for(k = 0; k < 10U; k++)
+	{
+		(void)Link_Sample(&Link);
+	}
+	Link.Interference = 38;
+	for(k = 0; k < 8U; k++)
+	{
+		Step = Link_Sample(&Link);
+		HOST_CHECK((Step == 0) || (Step == 1));
+	}
+	HOST_CHECK((Link.Raises >= 4U) && (Link.Lowers == 0U));
+
+	/* Then, once the smoothed loss is back under 5%, down one step at a time */
+	Link.Interference = 0;
+	for(k = 0; k < 1000U; k++)
+	{
+		Step = Link_Sample(&Link);
+		HOST_CHECK((Step >= -1) && ((Step <= 0) || ((Link.Ctrl.Loss_Q4 >> 4) > LINKMON_LOSS_HIGH)));
+	}
+	HOST_CHECK(Link.Level == 0U);
+}
+
+/**
+  * @brief	The power steps down only past the hysteresis margin, held for LINKMON_LOWER_HOLD
+  *					samples
+  */
+static void Test_LinkMon_Hysteresis(void)
+{
+	Link_t Link;
+	uint32_t k, Run;
+	uint8_t l, Before;
+	int8_t Step;
+
+	for(l = 1; l <= TEST_TOP_LEVEL; l++)
+	{
+		/* One level down would put the peer 1 dB under the top of the window: kept */
+		Link_Init(&Link, l, 0, l);
+		Link.Path_Loss_dB = (int16_t)(LinkMon_GetLevel(l - 1U)->Power_dBm - (LINKMON_TARGET_HIGH_DBM - 1));
+		for(k = 0; k < 1000U; k++)
+		{
+			HOST_CHECK(Link_Sample(&Link) == 0);
+		}
+
+		/* At the top of the window: lowered after exactly LINKMON_LOWER_HOLD samples, once */
+		Link_Init(&Link, l, 0, l);
+		Link.Path_Loss_dB = (int16_t)(LinkMon_GetLevel(l - 1U)->Power_dBm - LINKMON_TARGET_HIGH_DBM);
+		for(k = 1; k < LINKMON_LOWER_HOLD; k++)
+		{
+			HOST_CHECK(Link_Sample(&Link) == 0);
+		}
+		HOST_CHECK(Link_Sample(&Link) == -1);
+		for(k = 0; k < 1000U; k++)
+		{
+			HOST_CHECK(Link_Sample(&Link) == 0);
+		}
+		HOST_CHECK((Link.Level == (l - 1U)) && Test_Settled(&Link.Ctrl, Link.Level));
+	}
+
+	/* A sample under the margin restarts the hold */
+	Link_Init(&Link, 5, 0, 5U);
+	Link.Path_Loss_dB = (int16_t)(LinkMon_GetLevel(4)->Power_dBm - LINKMON_TARGET_HIGH_DBM - 3);
+	for(k = 1; k < LINKMON_LOWER_HOLD; k++)
+	{
+		HOST_CHECK(Link_Sample(&Link) == 0);
+	}
+	Link.Path_Loss_dB += 16;
+	HOST_CHECK(Link_Sample(&Link) == 0);
+	Link.Path_Loss_dB -= 16;
+	for(k = 0; (k < 100U) && (Link.Lowers == 0U); k++)
+	{
+		(void)Link_Sample(&Link);
+	}
+	HOST_CHECK(k >= LINKMON_LOWER_HOLD);
+
+	/* Losses above 1% hold the power even with the margin */
+	Link_Init(&Link, 5, 30, 6U);
+	Link.Interference = 8;
+	for(k = 0; k < 1000U; k++)
+	{
+		HOST_CHECK(Link_Sample(&Link) >= 0);
+	}
+	HOST_CHECK(Link.Lowers == 0U);
+
+	/* The peer comes back with a noisy RSSI: every step down follows LINKMON_LOWER_HOLD samples
+	   past the margin, and leaves the estimate at or above the top of the window */
+	Link_Init(&Link, TEST_TOP_LEVEL, 95, 7U);
+	Link.Noise_dB = 3;
+	Run = 0;
+	for(k = 0; k < 2000U; k++)
+	{
+		Link.Path_Loss_dB = (int16_t)(95 - (k / 40U));
+		Before = Link.Level;
+		Step = Link_Sample(&Link);
+		HOST_CHECK(Step <= 0);
+
+		if((Before > 0U) && (LinkMon_PeerRSSI(&Link.Ctrl, Before - 1U) >= LINKMON_TARGET_HIGH_DBM))
+		{
+			Run++;
+		}
+		else
+		{
+			Run = 0;
+		}
+		if(Step < 0)
+		{
+			HOST_CHECK((Step == -1) && (Run >= LINKMON_LOWER_HOLD));
+			HOST_CHECK(LinkMon_PeerRSSI(&Link.Ctrl, Link.Level) >= LINKMON_TARGET_HIGH_DBM);
+			Run = 0;
+		}
+	}
+	HOST_CHECK((Link.Level == 0U) && (Link.Raises == 0U) && (Link.Reversals == 0U));
+}
+
+/**
+  * @brief	Constant traces, exact and noisy, from every start level: the level settles within the
+  *					window and never changes direction
+  */
+static void Test_LinkMon_Constant(void)
+{
+	static const uint8_t Starts[] = {0, 3, LINKMON_DEFAULT_LEVEL, 9};
+	static const uint8_t Noises[] = {0, 1, 3};
+	uint32_t k, Changes, Oscillating = 0;
+	int16_t Path_Loss;
+	uint8_t s, n;
+	Link_t Link;
+
+	for(Path_Loss = 20; Path_Loss <= 110; Path_Loss++)
+	{
+		for(s = 0; s < sizeof(Starts); s++)
+		{
+			for(n = 0; n < sizeof(Noises); n++)
+			{
+				Link_Init(&Link, Starts[s], Path_Loss, (uint32_t)Path_Loss * 31U + s);
+				Link.Noise_dB = Noises[n];
+				for(k = 0; k < TEST_SETTLE; k++)
+				{
+					(void)Link_Sample(&Link);
+				}
+
+				Changes = Link.Raises + Link.Lowers;
+				for(k = 0; k < 1000U; k++)
+				{
+					(void)Link_Sample(&Link);
+				}
+				if(Link.Reversals != 0U)
+				{
+					Oscillating++;
+				}
+
+				/* Exact traces: settled in the window, nothing moves afterwards */
+				if(Noises[n] == 0U)
+				{
+					HOST_CHECK(Changes == (Link.Raises + Link.Lowers));
+					HOST_CHECK(Test_Settled(&Link.Ctrl, Link.Level));
+				}
+			}
+		}
+	}
+	HOST_CHECK(Oscillating == 0U);
+
+	/* Constant losses: between 1% and 5% nothing moves, above the level goes to the top */
+	Link_Init(&Link, 4, 60, 11U);
+	Link.Interference = 7;
+	for(k = 0; k < 1000U; k++)
+	{
+		HOST_CHECK(Link_Sample(&Link) == 0);
+	}
+
+	Link_Init(&Link, 4, 60, 12U);
+	Link.Interference = 26;
+	for(k = 0; k < 1000U; k++)
+	{
+		HOST_CHECK(Link_Sample(&Link) >= 0);
+	}
+	HOST_CHECK((Link.Level == TEST_TOP_LEVEL) && (Link.Reversals == 0U));
+}
+
+/**
+  * @brief	Samples without RSSI: nothing decided before the first one, only the loss counts after
+  */
+static void Test_LinkMon_Unavailable(void)
+{
+	LinkMon_Ctrl_t Ctrl;
+	uint8_t k;
+
+	LinkMon_CtrlInit(&Ctrl, 4);
+	for(k = 0; k < 20U; k++)
+	{
+		HOST_CHECK(LinkMon_CtrlUpdate(&Ctrl, LINKMON_RSSI_UNAVAILABLE, TEST_PACKETS, TEST_PACKETS) == 4U);
+	}
+
+	/* Losses built up meanwhile raise the level as soon as the RSSI is known */
+	HOST_CHECK(LinkMon_CtrlUpdate(&Ctrl, -40, 0, 0) == 5U);
+	HOST_CHECK(LinkMon_CtrlUpdate(&Ctrl, LINKMON_RSSI_UNAVAILABLE, 0, 0) == 6U);
+	HOST_CHECK(Ctrl.RSSI_Q4 == (-40 * 16));
+
+	LinkMon_CtrlInit(&Ctrl, 200);
+	HOST_CHECK(Ctrl.Level == TEST_TOP_LEVEL);
+}
+
+/**
+  * @brief	Monitor on emulated links: the highest level wanted is applied, once, and the default
+  *					one after the disconnection
+  */
+static void Test_LinkMon_Monitor(void)
+{
+	LinkMon_Stats_t Stats[LINKMON_MAX_LINKS];
+	uint32_t k, Sets;
+
+	memset(Link_Status, 0, sizeof(Link_Status));
+	Tick = 1000;
+	Tx_Power_Sets = 0;
+	HOST_CHECK(LinkMon_Init() == LINKMON_OK);
+	HOST_CHECK((Tx_Power_Sets == 1U) && (LinkMon_GetTxPower() == LinkMon_GetLevel(LINKMON_DEFAULT_LEVEL)->Power_dBm));
+
+	/* A close peer and a far one */
+	Link_Status[0] = 0x02;
+	Link_Handle[0] = 0x0801;
+	Link_RSSI[0] = -30;
+	Link_Status[3] = 0x05;
+	Link_Handle[3] = 0x0802;
+	Link_RSSI[3] = -75;
+
+	for(k = 0; k < 100U; k++)
+	{
+		Tick += LINKMON_PERIOD_MS;
+		LinkMon_ReportTx(0x0801, 10, 0);
+		LinkMon_ReportTx(0x0802, 10, 0);
+		LinkMon_Process();
+	}
+	HOST_CHECK(LinkMon_GetLinks(Stats, LINKMON_MAX_LINKS) == 2U);
+	HOST_CHECK((Stats[0].Level == 0U) && (Stats[0].Lowers == LINKMON_DEFAULT_LEVEL) && (Stats[0].Samples == 100U));
+	HOST_CHECK(Test_Settled(&(LinkMon_Ctrl_t){.RSSI_Q4 = -75 * 16, .Started = 1}, Stats[1].Level));
+	HOST_CHECK(LinkMon_GetTxPower() == LinkMon_GetLevel(Stats[1].Level)->Power_dBm);
+	HOST_CHECK((Tx_High_Power == LinkMon_GetLevel(Stats[1].Level)->En_High_Power) && (Tx_PA_Level == LinkMon_GetLevel(Stats[1].Level)->PA_Level));
+	HOST_CHECK(Stats[1].Peer_RSSI == (-75 + LinkMon_GetTxPower()));
+
+	/* The reports before the first sample of a link are not counted */
+	HOST_CHECK((Stats[0].Tx_Packets == 990U) && (Stats[1].Tx_Packets == 990U) && (Stats[1].Tx_Failed == 0U));
+
+	/* Sampled every LINKMON_PERIOD_MS only, the power set on changes only */
+	Sets = Tx_Power_Sets;
+	Tick += LINKMON_PERIOD_MS - 1U;
+	LinkMon_Process();
+	Tick += LINKMON_PERIOD_MS;
+	LinkMon_Process();
+	HOST_CHECK(LinkMon_GetStats(0x0801, &Stats[0]) == LINKMON_OK);
+	HOST_CHECK((Stats[0].Samples == 101U) && (Tx_Power_Sets == Sets));
+	HOST_CHECK(LinkMon_GetStats(0x0801, NULL) == LINKMON_ERROR_PARAM);
+
+	/* Disconnected */
+	memset(Link_Status, 0, sizeof(Link_Status));
+	Tick += LINKMON_PERIOD_MS;
+	LinkMon_Process();
+	HOST_CHECK(LinkMon_GetStats(0x0802, &Stats[0]) == LINKMON_ERROR_NOT_FOUND);
+	HOST_CHECK(LinkMon_GetTxPower() == LinkMon_GetLevel(LINKMON_DEFAULT_LEVEL)->Power_dBm);
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(void)
+{
+	HOST_RUN(Test_LinkMon_Degrade);
+	HOST_RUN(Test_LinkMon_Hysteresis);
+	HOST_RUN(Test_LinkMon_Constant);
+	HOST_RUN(Test_LinkMon_Unavailable);
+	HOST_RUN(Test_LinkMon_Monitor);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
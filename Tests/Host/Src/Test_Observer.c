@@ -0,0 +1,554 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Observer.c
+  * @brief      : Host test of the advertiser table of Observer.c, fed by synthetic advertising
+	*								floods. The table is checked against a model of the advertisers, then timed
+	*								with Observer_Benchmark().
+  * @author			:
+  **************************************************************************************************
+  *
+  * Build with -DOBSERVER_BENCHMARK=1. The time of the table functions is virtual, the benchmark
+  * reads the host clock through HAL_GetTick().
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include <time.h>
+#include "Host_Test.h"
+#include "Observer.h"
+#include "bluenrg1_gap_aci.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define TEST_MAX_DEVICES								512U
+#define TEST_MAX_DATA										31U
+#define TEST_REPORTS_PER_EVENT					4U
+
+/* Expiry: an event every 20 ms, the table swept once per TEST_SWEEP_MS */
+#define TEST_EVENT_PERIOD_MS						20U
+#define TEST_SWEEP_MS										((OBSERVER_TABLE_SIZE / OBSERVER_SWEEP_SLOTS) * TEST_EVENT_PERIOD_MS)
+#define TEST_EXPIRE_STEPS								200000U
+#define TEST_GROUP											100U
+#define TEST_GROUP_STEP_MS							2000U
+
+/* Advertising report event types */
+#define TEST_ADV_IND										0x00U
+#define TEST_ADV_NONCONN_IND						0x03U
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+/* What the table should know of an advertiser */
+typedef struct
+{
+	uint8_t Address[6];
+	uint8_t Address_Type;
+	uint8_t Seen;
+	uint8_t Event_Type;
+	uint8_t Adv_Version;							/* Advertising data, changed now and then */
+	uint8_t Scan_Version;
+	uint8_t Adv_Sent;									/* Version last reported */
+	uint8_t Scan_Sent;
+	uint8_t Adv_Seen;
+	uint8_t Scan_Seen;
+	uint32_t Last_Seen;
+	uint32_t Reports;
+	uint32_t Changes;
+
+} Test_Device_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static Test_Device_t Devices[TEST_MAX_DEVICES];
+static uint8_t Event[1U + TEST_REPORTS_PER_EVENT * (10U + TEST_MAX_DATA)];
+
+static uint32_t Callback_New;
+static uint32_t Callback_Changed;
+static uint32_t Callback_Errors;
+
+/* Virtual time, or the host clock for the benchmark */
+static uint32_t Now;
+static uint8_t Real_Time;
+
+static uint8_t Scanning;
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+uint32_t HAL_GetTick(void)
+{
+	return Real_Time ? (uint32_t)(((uint64_t)clock() * 1000U) / CLOCKS_PER_SEC) : Now;
+}
+
+tBleStatus aci_gap_start_observation_proc(uint16_t LE_Scan_Interval, uint16_t LE_Scan_Window, uint8_t LE_Scan_Type,
+																					uint8_t Own_Address_Type, uint8_t Filter_Duplicates, uint8_t Scanning_Filter_Policy)
+{
+	(void)LE_Scan_Interval;
+	(void)LE_Scan_Window;
+	(void)LE_Scan_Type;
+	(void)Own_Address_Type;
+	(void)Scanning_Filter_Policy;
+
+	/* The table does the filtering */
+	HOST_CHECK(Filter_Duplicates == 0U);
+	Scanning = 1;
+	return BLE_STATUS_SUCCESS;
+}
+
+tBleStatus aci_gap_terminate_gap_proc(uint8_t Procedure_Code)
+{
+	(void)Procedure_Code;
+	Scanning = 0;
+	return BLE_STATUS_SUCCESS;
+}
+
+/**
+  * @brief	Checks the flags the table raises against the model
+  */
+static void Test_Callback(const Observer_Device_t *pDevice, const Observer_Report_t *pReport, uint8_t Flags)
+{
+	(void)pReport;
+
+	if(Flags & OBSERVER_FLAG_NEW)
+	{
+		Callback_New++;
+	}
+	if(Flags & OBSERVER_FLAG_CHANGED)
+	{
+		Callback_Changed++;
+	}
+	if(((Flags & OBSERVER_FLAG_NEW) && (Flags & OBSERVER_FLAG_CHANGED)) || (pDevice == NULL) || !pDevice->Used)
+	{
+		Callback_Errors++;
+	}
+}
+
+/**
+  * @brief	Advertisers with random addresses, some of them sharing the address with another type
+  */
+static void Test_MakeDevices(uint32_t Count, uint32_t *pSeed)
+{
+	uint32_t i, j;
+
+	memset(Devices, 0, sizeof(Devices));
+	for(i = 0; i < Count; i++)
+	{
+		if((i > 0U) && ((i % 16U) == 0U))
+		{
+			/* Same address, other address type: another device */
+			memcpy(Devices[i].Address, Devices[i - 1U].Address, 6);
+			Devices[i].Address_Type = Devices[i - 1U].Address_Type ^ 1U;
+			continue;
+		}
+		for(j = 0; j < 6U; j++)
+		{
+			Devices[i].Address[j] = (uint8_t)Host_Rand(pSeed);
+		}
+		/* Beacons of one vendor share the upper bytes, the worst case for the hash */
+		if((i % 2U) == 0U)
+		{
+			Devices[i].Address[5] = 0xC0;
+			Devices[i].Address[4] = 0x5A;
+			Devices[i].Address[3] = 0x00;
+		}
+		Devices[i].Address_Type = (uint8_t)(Host_Rand(pSeed) & 1U);
+	}
+}
+
+/**
+  * @brief	Appends one report of a device to Event, the payload is derived from its version
+  * @retval	Bytes written
+  */
+static uint32_t Test_PutReport(uint8_t *pReport, const Test_Device_t *pDevice, uint8_t Event_Type, int8_t RSSI)
+{
+	uint8_t Version = (Event_Type == OBSERVER_EVENT_SCAN_RSP) ? pDevice->Scan_Version : pDevice->Adv_Version;
+	uint8_t Length = (uint8_t)(3U + ((pDevice->Address[0] + Version) % (TEST_MAX_DATA - 2U)));
+	uint8_t i;
+
+	pReport[0] = Event_Type;
+	pReport[1] = pDevice->Address_Type;
+	memcpy(&pReport[2], pDevice->Address, 6);
+	pReport[8] = Length;
+	for(i = 0; i < Length; i++)
+	{
+		pReport[9U + i] = (uint8_t)(pDevice->Address[i % 6U] ^ (Version * 31U) ^ i);
+	}
+	pReport[9U + Length] = (uint8_t)RSSI;
+
+	return 10U + Length;
+}
+
+/**
+  * @brief	One event of random reports from Count devices starting at First, applied to the model
+  * @retval	Event length
+  */
+static uint16_t Test_MakeEvent(uint32_t First, uint32_t Count, uint32_t *pSeed, uint32_t *pChanges)
+{
+	Test_Device_t *pDevice;
+	uint32_t Offset = 1;
+	uint8_t Reports, Event_Type, Changed, n;
+	int8_t RSSI;
+
+	Reports = (uint8_t)(1U + (Host_Rand(pSeed) % TEST_REPORTS_PER_EVENT));
+	Event[0] = Reports;
+
+	for(n = 0; n < Reports; n++)
+	{
+		pDevice = &Devices[(First + (Host_Rand(pSeed) % Count)) % TEST_MAX_DEVICES];
+
+		switch(Host_Rand(pSeed) % 4U)
+		{
+			case 0:
+				Event_Type = OBSERVER_EVENT_SCAN_RSP;
+				break;
+			case 1:
+				Event_Type = TEST_ADV_NONCONN_IND;
+				break;
+			default:
+				Event_Type = TEST_ADV_IND;
+				break;
+		}
+
+		/* The payload changes in one report out of sixteen */
+		if((Host_Rand(pSeed) % 16U) == 0U)
+		{
+			if(Event_Type == OBSERVER_EVENT_SCAN_RSP)
+			{
+				pDevice->Scan_Version++;
+			}
+			else
+			{
+				pDevice->Adv_Version++;
+			}
+		}
+
+		RSSI = (int8_t)(-40 - (int32_t)(Host_Rand(pSeed) % 50U));
+		Offset += Test_PutReport(&Event[Offset], pDevice, Event_Type, RSSI);
+
+		/* Model: a known device changes when the payload differs from the last one of the same
+		 * kind, or when it is the first of its kind (the table starts from no data) */
+		if(pDevice->Seen)
+		{
+			if(Event_Type == OBSERVER_EVENT_SCAN_RSP)
+			{
+				Changed = !pDevice->Scan_Seen || (pDevice->Scan_Sent != pDevice->Scan_Version);
+			}
+			else
+			{
+				Changed = !pDevice->Adv_Seen || (pDevice->Adv_Sent != pDevice->Adv_Version);
+			}
+			if(Changed)
+			{
+				pDevice->Changes++;
+				(*pChanges)++;
+			}
+		}
+		if(Event_Type == OBSERVER_EVENT_SCAN_RSP)
+		{
+			pDevice->Scan_Sent = pDevice->Scan_Version;
+			pDevice->Scan_Seen = 1;
+		}
+		else
+		{
+			pDevice->Adv_Sent = pDevice->Adv_Version;
+			pDevice->Adv_Seen = 1;
+			pDevice->Event_Type = Event_Type;
+		}
+		pDevice->Seen = 1;
+		pDevice->Reports++;
+		pDevice->Last_Seen = Now;
+	}
+
+	return (uint16_t)Offset;
+}
+
+static void Test_CountDevice(const Observer_Device_t *pDevice, void *pContext)
+{
+	(void)pDevice;
+	(*(uint32_t *)pContext)++;
+}
+
+static void Test_CheckExpired(const Observer_Device_t *pDevice, void *pContext)
+{
+	HOST_CHECK((*(uint32_t *)pContext - pDevice->Last_Seen) <= (OBSERVER_TIMEOUT_MS + TEST_SWEEP_MS));
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	Zero-copy walk of well formed and truncated events
+  */
+static void Test_Observer_Parse(void)
+{
+	Observer_Iter_t Iter;
+	Observer_Report_t Report;
+	uint32_t Seed = 1, Length;
+
+	Test_MakeDevices(3, &Seed);
+	Event[0] = 3;
+	Length = 1;
+	Length += Test_PutReport(&Event[Length], &Devices[0], TEST_ADV_IND, -50);
+	Length += Test_PutReport(&Event[Length], &Devices[1], OBSERVER_EVENT_SCAN_RSP, -60);
+	Length += Test_PutReport(&Event[Length], &Devices[2], TEST_ADV_NONCONN_IND, OBSERVER_RSSI_UNAVAILABLE);
+
+	HOST_CHECK(Observer_IterInit(&Iter, Event, (uint16_t)Length) == 3U);
+	HOST_CHECK(Observer_IterNext(&Iter, &Report) == 1U);
+	HOST_CHECK((Report.Event_Type == TEST_ADV_IND) && (Report.RSSI == -50));
+	HOST_CHECK(Report.pAddress == &Event[3]);
+	HOST_CHECK(Report.pData == &Event[10]);
+	HOST_CHECK(memcmp(Report.pAddress, Devices[0].Address, 6) == 0);
+	HOST_CHECK(Observer_IterNext(&Iter, &Report) == 1U);
+	HOST_CHECK((Report.Event_Type == OBSERVER_EVENT_SCAN_RSP) && (Report.RSSI == -60));
+	HOST_CHECK(Report.Address_Type == Devices[1].Address_Type);
+	HOST_CHECK(Observer_IterNext(&Iter, &Report) == 1U);
+	HOST_CHECK(Report.RSSI == OBSERVER_RSSI_UNAVAILABLE);
+	HOST_CHECK(&Report.pData[Report.Length_Data + 1U] == &Event[Length]);
+	HOST_CHECK(Observer_IterNext(&Iter, &Report) == 0U);
+	HOST_CHECK(Iter.Remaining == 0U);
+
+	/* Truncated in the last report: two reports taken, the event counted as malformed */
+	Observer_Init();
+	Observer_ProcessEvent(Event, (uint16_t)(Length - 1U), 0);
+	HOST_CHECK(Observer_GetStats()->Reports == 2U);
+	HOST_CHECK(Observer_GetStats()->Malformed == 1U);
+
+	/* Header cut, or nothing at all */
+	HOST_CHECK(Observer_IterInit(&Iter, Event, 5) == 3U);
+	HOST_CHECK(Observer_IterNext(&Iter, &Report) == 0U);
+	HOST_CHECK(Observer_IterInit(&Iter, Event, 0) == 0U);
+	HOST_CHECK(Observer_IterNext(&Iter, &Report) == 0U);
+	HOST_CHECK(Observer_IterInit(&Iter, NULL, 10) == 0U);
+}
+
+/**
+  * @brief	Flood from a few hundred advertisers: one NEW per device, CHANGED exactly when the
+  *					payload changed, the counters and last-seen times of each device
+  */
+static void Test_Observer_Flood(void)
+{
+	const Observer_Device_t *pEntry;
+	const Observer_Stats_t *pStats;
+	uint32_t Seed = 2, Changes = 0, Reports = 0, Count = 180U, Events = 0, i;
+	uint16_t Length;
+
+	Test_MakeDevices(Count, &Seed);
+	Observer_Init();
+	Observer_SetCallback(Test_Callback);
+	Callback_New = Callback_Changed = Callback_Errors = 0;
+
+	for(Now = 0; Reports < 200000U; Now += 3U)
+	{
+		Length = Test_MakeEvent(0, Count, &Seed, &Changes);
+		Reports += Event[0];
+		Observer_ProcessEvent(Event, Length, Now);
+		Events++;
+	}
+
+	pStats = Observer_GetStats();
+	HOST_CHECK(pStats->Events == Events);
+	HOST_CHECK(pStats->Reports == Reports);
+	HOST_CHECK(pStats->Malformed == 0U);
+	HOST_CHECK(pStats->Dropped_Full == 0U);
+	HOST_CHECK(pStats->Devices == Count);
+	HOST_CHECK(pStats->New_Devices == Count);
+	HOST_CHECK(Callback_New == Count);
+	HOST_CHECK(Callback_Changed == Changes);
+	HOST_CHECK(pStats->Changes == Changes);
+	HOST_CHECK(Callback_Errors == 0U);
+
+	for(i = 0; i < Count; i++)
+	{
+		pEntry = Observer_Find(Devices[i].Address, Devices[i].Address_Type);
+		HOST_CHECK(pEntry != NULL);
+		if(pEntry == NULL)
+		{
+			continue;
+		}
+		HOST_CHECK(pEntry->Reports == ((Devices[i].Reports < UINT16_MAX) ? Devices[i].Reports : UINT16_MAX));
+		HOST_CHECK(pEntry->Changes == Devices[i].Changes);
+		HOST_CHECK(pEntry->Last_Seen == Devices[i].Last_Seen);
+		HOST_CHECK(pEntry->Event_Type == Devices[i].Event_Type);
+		HOST_CHECK((pEntry->RSSI_Q4 <= (-40 * 16)) && (pEntry->RSSI_Q4 >= (-89 * 16)));
+	}
+
+	/* 70% load at most: probes stay short */
+	printf("  %u reports, %u devices, longest probe %u\n", (unsigned int)Reports, (unsigned int)Count,
+				 (unsigned int)pStats->Max_Probe);
+	HOST_CHECK(pStats->Max_Probe < 32U);
+
+	Observer_SetCallback(NULL);
+}
+
+/**
+  * @brief	Smoothed RSSI follows a step and ignores unavailable measurements
+  */
+static void Test_Observer_RSSI(void)
+{
+	const Observer_Device_t *pEntry;
+	uint32_t Seed = 3, n;
+
+	Test_MakeDevices(1, &Seed);
+	Observer_Init();
+
+	Event[0] = 1;
+	(void)Test_PutReport(&Event[1], &Devices[0], TEST_ADV_IND, OBSERVER_RSSI_UNAVAILABLE);
+	Observer_ProcessEvent(Event, sizeof(Event), 0);
+	pEntry = Observer_Find(Devices[0].Address, Devices[0].Address_Type);
+	HOST_CHECK((pEntry != NULL) && (pEntry->RSSI_Last == OBSERVER_RSSI_UNAVAILABLE));
+
+	/* The first measurement is taken as is */
+	(void)Test_PutReport(&Event[1], &Devices[0], TEST_ADV_IND, -80);
+	Observer_ProcessEvent(Event, sizeof(Event), 1);
+	HOST_CHECK((pEntry != NULL) && (pEntry->RSSI_Q4 == (-80 * 16)));
+
+	/* Step to -50 dBm: a weight of 1/8 per report, settled within a dB after 40 reports */
+	(void)Test_PutReport(&Event[1], &Devices[0], TEST_ADV_IND, -50);
+	Observer_ProcessEvent(Event, sizeof(Event), 2);
+	HOST_CHECK((pEntry != NULL) && (pEntry->RSSI_Q4 > (-80 * 16)) && (pEntry->RSSI_Q4 < (-70 * 16)));
+	for(n = 0; n < 40U; n++)
+	{
+		Observer_ProcessEvent(Event, sizeof(Event), 3U + n);
+	}
+	HOST_CHECK((pEntry != NULL) && (pEntry->RSSI_Q4 >= (-51 * 16)) && (pEntry->RSSI_Q4 <= (-50 * 16)));
+
+	(void)Test_PutReport(&Event[1], &Devices[0], TEST_ADV_IND, OBSERVER_RSSI_UNAVAILABLE);
+	Observer_ProcessEvent(Event, sizeof(Event), 100);
+	HOST_CHECK((pEntry != NULL) && (pEntry->RSSI_Last == -50) && (pEntry->Last_Seen == 100U));
+}
+
+/**
+  * @brief	More advertisers than the table takes: the load limit holds, new ones are dropped
+  */
+static void Test_Observer_Full(void)
+{
+	uint32_t Seed = 4, Changes = 0, n;
+	uint16_t Length;
+
+	Test_MakeDevices(TEST_MAX_DEVICES, &Seed);
+	Observer_Init();
+	Observer_SetCallback(Test_Callback);
+	Callback_New = Callback_Changed = Callback_Errors = 0;
+
+	for(n = 0, Now = 0; n < 20000U; n++, Now++)
+	{
+		Length = Test_MakeEvent(0, TEST_MAX_DEVICES, &Seed, &Changes);
+		Observer_ProcessEvent(Event, Length, Now);
+	}
+
+	HOST_CHECK(Observer_GetStats()->Devices == OBSERVER_MAX_DEVICES);
+	HOST_CHECK(Callback_New == OBSERVER_MAX_DEVICES);
+	HOST_CHECK(Observer_GetStats()->Dropped_Full > 0U);
+	HOST_CHECK(Callback_Errors == 0U);
+
+	Observer_SetCallback(NULL);
+}
+
+/**
+  * @brief	Advertisers coming and going for an hour: the sweep removes the silent ones without
+  *					losing the others (backward shift deletion), and a device heard again is new again
+  */
+static void Test_Observer_Expire(void)
+{
+	const Observer_Stats_t *pStats;
+	Test_Device_t *pDevice;
+	uint32_t Seed = 5, Changes = 0, Listed, Step, i;
+	uint16_t Length;
+
+	Test_MakeDevices(TEST_MAX_DEVICES, &Seed);
+	Observer_Init();
+	pStats = Observer_GetStats();
+
+	/* A group of TEST_GROUP advertisers, one leaving and another coming every TEST_GROUP_STEP_MS */
+	for(Step = 0, Now = 0; Step < TEST_EXPIRE_STEPS; Step++, Now += TEST_EVENT_PERIOD_MS)
+	{
+		Length = Test_MakeEvent(Now / TEST_GROUP_STEP_MS, TEST_GROUP, &Seed, &Changes);
+		Observer_ProcessEvent(Event, Length, Now);
+		Observer_Expire(Now, OBSERVER_SWEEP_SLOTS);
+
+		if((Step % 5000U) != 4999U)
+		{
+			continue;
+		}
+
+		/* Never removed early: every device heard within the timeout is found */
+		for(i = 0; i < TEST_MAX_DEVICES; i++)
+		{
+			pDevice = &Devices[i];
+			if(pDevice->Seen && ((Now - pDevice->Last_Seen) <= OBSERVER_TIMEOUT_MS))
+			{
+				HOST_CHECK(Observer_Find(pDevice->Address, pDevice->Address_Type) != NULL);
+			}
+		}
+
+		/* Removed within one sweep of the table after the timeout */
+		Observer_ForEach(Test_CheckExpired, &Now);
+		Listed = 0;
+		Observer_ForEach(Test_CountDevice, &Listed);
+		HOST_CHECK(Listed == pStats->Devices);
+	}
+
+	/* The group went round the devices several times: each came back as a new device */
+	printf("  %u new devices, %u expired\n", (unsigned int)pStats->New_Devices, (unsigned int)pStats->Expired);
+	HOST_CHECK(pStats->Expired > (2U * TEST_MAX_DEVICES));
+	HOST_CHECK((pStats->New_Devices - pStats->Expired) == pStats->Devices);
+	HOST_CHECK(pStats->Dropped_Full == 0U);
+	HOST_CHECK(pStats->Malformed == 0U);
+}
+
+/**
+  * @brief	Reports per second of Observer_Benchmark(), on the host clock
+  */
+static void Test_Observer_Benchmark(void)
+{
+	uint32_t Rate;
+
+	Real_Time = 1;
+	Rate = Observer_Benchmark(150, 3000000U);
+	Real_Time = 0;
+
+	printf("  %u reports/s, 150 advertisers\n", (unsigned int)Rate);
+	HOST_CHECK(Rate > 10000U);
+	HOST_CHECK(Observer_GetStats()->Devices == 150U);
+	HOST_CHECK(Observer_GetStats()->Malformed == 0U);
+}
+
+/**
+  * @brief	Events only go to the table while scanning
+  */
+static void Test_Observer_Scanning(void)
+{
+	uint32_t Seed = 6;
+
+	Test_MakeDevices(1, &Seed);
+	Observer_Init();
+	Event[0] = 1;
+	(void)Test_PutReport(&Event[1], &Devices[0], TEST_ADV_IND, -70);
+
+	HOST_CHECK(Observer_HandleEvent(Event, sizeof(Event)) == 0U);
+	HOST_CHECK(Observer_Start(0x10, 0x20) == OBSERVER_ERROR_PARAM);
+	HOST_CHECK(!Scanning);
+	HOST_CHECK(Observer_Start(0x20, 0x10) == OBSERVER_OK);
+	HOST_CHECK(Scanning);
+	HOST_CHECK(Observer_HandleEvent(Event, sizeof(Event)) == 1U);
+	HOST_CHECK(Observer_GetStats()->Devices == 1U);
+	HOST_CHECK(Observer_Stop() == OBSERVER_OK);
+	HOST_CHECK(Observer_HandleEvent(Event, sizeof(Event)) == 0U);
+	HOST_CHECK(Observer_GetStats()->Devices == 1U);
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(void)
+{
+	HOST_RUN(Test_Observer_Parse);
+	HOST_RUN(Test_Observer_Flood);
+	HOST_RUN(Test_Observer_RSSI);
+	HOST_RUN(Test_Observer_Full);
+	HOST_RUN(Test_Observer_Expire);
+	HOST_RUN(Test_Observer_Scanning);
+	HOST_RUN(Test_Observer_Benchmark);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
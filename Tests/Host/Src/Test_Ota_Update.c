@@ -0,0 +1,382 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Ota_Update.c
+  * @brief      : Host test of the image reception of Ota_Update.c. A simulated peer streams images
+	*								over a lossy link, the received bytes are word-programmed into a simulated
+	*								staging flash, paced like the radio scheduler jobs.
+  * @author			:
+  **************************************************************************************************
+  *
+  * Build with -DOTA_ENABLE=0: only the reception, which has no hardware dependency, is compiled.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Host_Test.h"
+#include "Ota_Update.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* Packets the link carries per connection event */
+#define TEST_PACKETS_PER_EVENT					6U
+
+/* Events without an acknowledgement before the peer sends its window again */
+#define TEST_PEER_TIMEOUT								400U
+
+#define TEST_MAX_EVENTS									2000000U
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+/* Go-back-N sender of the updater */
+typedef struct
+{
+	uint32_t Offset;									/* Next byte to send */
+	uint16_t Seq;
+	uint32_t Window_Offset;						/* Given by the last acknowledgement */
+	uint16_t Window_Seq;
+	uint8_t Open;											/* The first acknowledgement arrived */
+	uint8_t Done;											/* Acknowledged up to the end of the image */
+	uint32_t Idle;										/* Events since the last acknowledgement */
+	uint16_t Data_Size;								/* Image bytes per packet, from the MTU */
+
+} Test_Peer_t;
+
+typedef struct
+{
+	uint32_t Image_Size;
+	uint16_t Data_Size;
+	uint32_t Loss_Permille;						/* Data packets lost by the link */
+	uint32_t Flash_Every;							/* One programming job every Flash_Every events */
+	uint32_t Seed;
+
+} Test_Case_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static Ota_Rx_t Rx;
+static uint8_t Image[OTA_MAX_IMAGE_SIZE];
+static uint8_t Staging[OTA_STAGING_SIZE];
+static uint32_t Flash_Errors;
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+/**
+  * @brief	Word programming of the staging flash: aligned, and only on erased words
+	*/
+static void Test_FlashProgram(uint32_t Offset, uint32_t Word)
+{
+	uint32_t Old;
+
+	if(((Offset & 3U) != 0U) || ((Offset + 4U) > OTA_STAGING_SIZE))
+	{
+		Flash_Errors++;
+		return;
+	}
+
+	memcpy(&Old, &Staging[Offset], 4);
+	if(Old != 0xFFFFFFFFU)
+	{
+		Flash_Errors++;
+	}
+	Old &= Word;
+	memcpy(&Staging[Offset], &Old, 4);
+}
+
+/**
+  * @brief	Ota_ProgramJob() on the simulated flash
+	*/
+static void Test_ProgramJob(void)
+{
+	const uint8_t *pData;
+	uint32_t Word;
+	uint16_t Length, i;
+
+	Length = Ota_RxPending(&Rx, &pData);
+	if(Length == 0U)
+	{
+		return;
+	}
+
+	/* Whole words, except the end of the image */
+	HOST_CHECK(((Length & 3U) == 0U) || ((Rx.Programmed + Length) == Rx.Image_Size));
+	HOST_CHECK(Length <= OTA_PROGRAM_CHUNK);
+
+	for(i = 0; i < Length; i += 4U)
+	{
+		Word = 0xFFFFFFFFU;
+		memcpy(&Word, &pData[i], ((uint16_t)(Length - i) < 4U) ? (uint32_t)(Length - i) : 4U);
+		Test_FlashProgram(Rx.Programmed + i, Word);
+	}
+
+	Ota_RxProgrammed(&Rx, Length);
+}
+
+/**
+  * @brief	Packets of one connection event, within the window of the peer
+	*/
+static void Test_PeerSend(Test_Peer_t *pPeer, const Test_Case_t *pCase, uint32_t *pSeed)
+{
+	uint8_t Packet[OTA_MAX_PACKET];
+	uint16_t Length, n;
+	Ota_RxResult_t Result;
+
+	for(n = 0; n < TEST_PACKETS_PER_EVENT; n++)
+	{
+		if(!pPeer->Open || (pPeer->Offset >= pCase->Image_Size) ||
+			 ((uint16_t)(pPeer->Seq - pPeer->Window_Seq) >= OTA_WINDOW))
+		{
+			break;
+		}
+
+		Length = pPeer->Data_Size;
+		if(Length > (pCase->Image_Size - pPeer->Offset))
+		{
+			Length = (uint16_t)(pCase->Image_Size - pPeer->Offset);
+		}
+
+		Packet[0] = (uint8_t)pPeer->Seq;
+		Packet[1] = (uint8_t)(pPeer->Seq >> 8);
+		memcpy(&Packet[2], &Image[pPeer->Offset], Length);
+
+		if((Host_Rand(pSeed) % 1000U) >= pCase->Loss_Permille)
+		{
+			Result = Ota_RxPacket(&Rx, Packet, (uint16_t)(Length + 2U));
+			HOST_CHECK(Result != OTA_RX_INVALID);
+		}
+
+		pPeer->Offset += Length;
+		pPeer->Seq++;
+	}
+}
+
+/**
+  * @brief	Acknowledgement sent by the device, as Ota_Process() does, and taken by the peer
+	*/
+static void Test_Acknowledge(Test_Peer_t *pPeer)
+{
+	uint8_t Event = Ota_RxAckDue(&Rx);
+
+	if(Event == 0U)
+	{
+		if(++pPeer->Idle >= TEST_PEER_TIMEOUT)
+		{
+			/* Nothing heard: the end of the window was lost, send it again */
+			pPeer->Offset = pPeer->Window_Offset;
+			pPeer->Seq = pPeer->Window_Seq;
+			pPeer->Idle = 0;
+		}
+		return;
+	}
+
+	Ota_RxAcked(&Rx);
+
+	pPeer->Open = 1;
+	pPeer->Idle = 0;
+	pPeer->Window_Offset = Rx.Received;
+	pPeer->Window_Seq = Rx.Next_Seq;
+	if(Event == OTA_EVT_NACK)
+	{
+		pPeer->Offset = Rx.Received;
+		pPeer->Seq = Rx.Next_Seq;
+	}
+	if(Rx.Received == Rx.Image_Size)
+	{
+		pPeer->Done = 1;
+	}
+}
+
+/**
+  * @brief	Stream one image, then check the staging area
+	*/
+static void Test_Stream(const Test_Case_t *pCase)
+{
+	Test_Peer_t Peer;
+	uint32_t Seed = pCase->Seed, Events, i;
+
+	for(i = 0; i < pCase->Image_Size; i++)
+	{
+		Image[i] = (uint8_t)Host_Rand(&Seed);
+	}
+	memset(Staging, 0xFF, sizeof(Staging));
+	Flash_Errors = 0;
+
+	memset(&Peer, 0, sizeof(Peer));
+	Peer.Data_Size = pCase->Data_Size;
+
+	/* As Ota_Process() once the staging sectors are erased: the first acknowledgement opens the window */
+	Ota_RxInit(&Rx, pCase->Image_Size);
+	Rx.Since_Ack = OTA_WINDOW / 2U;
+
+	for(Events = 0; Events < TEST_MAX_EVENTS; Events++)
+	{
+		Test_PeerSend(&Peer, pCase, &Seed);
+		Test_Acknowledge(&Peer);
+
+		if((Events % pCase->Flash_Every) == 0U)
+		{
+			Test_ProgramJob();
+		}
+
+		HOST_CHECK((Rx.Received - Rx.Programmed) <= OTA_RING_SIZE);
+
+		if(Peer.Done && (Rx.Programmed == Rx.Image_Size))
+		{
+			break;
+		}
+	}
+
+	HOST_CHECK(Events < TEST_MAX_EVENTS);
+	HOST_CHECK(Rx.Received == pCase->Image_Size);
+	HOST_CHECK(Rx.Programmed == pCase->Image_Size);
+	HOST_CHECK(Ota_RxAckDue(&Rx) == 0U);
+	HOST_CHECK(Flash_Errors == 0U);
+	HOST_CHECK(memcmp(Staging, Image, pCase->Image_Size) == 0);
+
+	/* The last word is padded with 0xFF, as the CRC of Ota_Image.h expects, the rest stays erased */
+	for(i = pCase->Image_Size; i < OTA_STAGING_SIZE; i++)
+	{
+		if(Staging[i] != 0xFFU)
+		{
+			break;
+		}
+	}
+	HOST_CHECK(i == OTA_STAGING_SIZE);
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+static void Test_Ota_Lossless(void)
+{
+	const Test_Case_t Case = {100003U, OTA_MAX_DATA, 0U, 1U, 1U};
+
+	Test_Stream(&Case);
+	HOST_CHECK(Rx.Dropped == 0U);
+	HOST_CHECK(Rx.Nacks == 0U);
+}
+
+static void Test_Ota_SlowFlash(void)
+{
+	/* The flash takes a chunk every 8 events: the acknowledgements are held, nothing overruns the ring */
+	const Test_Case_t Case = {65537U, OTA_MAX_DATA, 0U, 8U, 2U};
+
+	Test_Stream(&Case);
+	HOST_CHECK(Rx.Dropped == 0U);
+	HOST_CHECK(Rx.Nacks == 0U);
+}
+
+static void Test_Ota_Lossy(void)
+{
+	const Test_Case_t Cases[] =
+	{
+		{OTA_MAX_IMAGE_SIZE, OTA_MAX_DATA, 20U, 1U, 3U},
+		{OTA_MAX_IMAGE_SIZE - 1U, 20U, 50U, 2U, 4U},				/* 23-byte MTU */
+		{40001U, 181U, 200U, 1U, 5U},
+	};
+	uint32_t i;
+
+	for(i = 0; i < (sizeof(Cases) / sizeof(Cases[0])); i++)
+	{
+		Test_Stream(&Cases[i]);
+		HOST_CHECK(Rx.Nacks > 0U);
+	}
+}
+
+static void Test_Ota_SmallImages(void)
+{
+	uint32_t Size;
+	Test_Case_t Case = {0U, OTA_MAX_DATA, 0U, 1U, 6U};
+
+	for(Size = 1U; Size <= 9U; Size++)
+	{
+		Case.Image_Size = Size;
+		Test_Stream(&Case);
+	}
+}
+
+static void Test_Ota_InvalidPackets(void)
+{
+	uint8_t Packet[OTA_MAX_PACKET + 1U];
+
+	memset(Packet, 0x5A, sizeof(Packet));
+	Ota_RxInit(&Rx, 1000U);
+
+	/* Sequence only, or larger than an HCI event */
+	Packet[0] = 0;
+	Packet[1] = 0;
+	HOST_CHECK(Ota_RxPacket(&Rx, Packet, 2U) == OTA_RX_INVALID);
+	HOST_CHECK(Ota_RxPacket(&Rx, Packet, OTA_MAX_PACKET + 1U) == OTA_RX_INVALID);
+	HOST_CHECK(Rx.Received == 0U);
+
+	HOST_CHECK(Ota_RxPacket(&Rx, Packet, OTA_MAX_PACKET) == OTA_RX_OK);
+	HOST_CHECK(Rx.Received == OTA_MAX_DATA);
+
+	/* Ahead: a packet was lost, the next acknowledgement is a NACK */
+	Packet[0] = 2;
+	HOST_CHECK(Ota_RxPacket(&Rx, Packet, OTA_MAX_PACKET) == OTA_RX_DROPPED);
+	HOST_CHECK(Ota_RxAckDue(&Rx) == OTA_EVT_NACK);
+	Ota_RxAcked(&Rx);
+	HOST_CHECK(Rx.Nacks == 1U);
+
+	/* Still in flight after the NACK: dropped silently */
+	Packet[0] = 3;
+	HOST_CHECK(Ota_RxPacket(&Rx, Packet, OTA_MAX_PACKET) == OTA_RX_DROPPED);
+	HOST_CHECK(Ota_RxAckDue(&Rx) == 0U);
+
+	/* Behind: a duplicate */
+	Packet[0] = 0;
+	HOST_CHECK(Ota_RxPacket(&Rx, Packet, OTA_MAX_PACKET) == OTA_RX_DROPPED);
+	HOST_CHECK(Ota_RxAckDue(&Rx) == 0U);
+
+	/* Beyond the announced size */
+	Packet[0] = 1;
+	Rx.Received = 1000U - 10U;
+	Rx.Programmed = Rx.Received;
+	HOST_CHECK(Ota_RxPacket(&Rx, Packet, 2U + 11U) == OTA_RX_INVALID);
+	HOST_CHECK(Ota_RxPacket(&Rx, Packet, 2U + 10U) == OTA_RX_OK);
+	HOST_CHECK(Ota_RxAckDue(&Rx) == OTA_EVT_ACK);
+}
+
+static void Test_Ota_RingOverrun(void)
+{
+	uint8_t Packet[OTA_MAX_PACKET];
+	uint16_t Seq;
+
+	memset(Packet, 0xA5, sizeof(Packet));
+	Ota_RxInit(&Rx, OTA_MAX_IMAGE_SIZE);
+
+	/* A peer ignoring its window, with nothing programmed: the ring fills up, then packets are dropped */
+	for(Seq = 0; Seq < ((OTA_RING_SIZE / OTA_MAX_DATA) + 4U); Seq++)
+	{
+		Packet[0] = (uint8_t)Rx.Next_Seq;
+		Packet[1] = (uint8_t)(Rx.Next_Seq >> 8);
+		(void)Ota_RxPacket(&Rx, Packet, OTA_MAX_PACKET);
+	}
+
+	HOST_CHECK(Rx.Received == ((OTA_RING_SIZE / OTA_MAX_DATA) * OTA_MAX_DATA));
+	HOST_CHECK(Rx.Dropped == 4U);
+
+	/* The NACK waits until the ring holds a window again */
+	HOST_CHECK(Ota_RxAckDue(&Rx) == 0U);
+	while((OTA_RING_SIZE - (Rx.Received - Rx.Programmed)) < (OTA_WINDOW * OTA_MAX_DATA))
+	{
+		Test_ProgramJob();
+	}
+	HOST_CHECK(Ota_RxAckDue(&Rx) == OTA_EVT_NACK);
+}
+
+
+int main(void)
+{
+	HOST_RUN(Test_Ota_Lossless);
+	HOST_RUN(Test_Ota_SlowFlash);
+	HOST_RUN(Test_Ota_Lossy);
+	HOST_RUN(Test_Ota_SmallImages);
+	HOST_RUN(Test_Ota_InvalidPackets);
+	HOST_RUN(Test_Ota_RingOverrun);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
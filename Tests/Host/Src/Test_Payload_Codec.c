@@ -0,0 +1,557 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Payload_Codec.c
+  * @brief      : Host test of Payload_Codec.c: encode/decode round trips of both codecs, malformed
+	*								frames, then compression ratios of sample streams and records sent in 20-byte
+	*								notifications, as BlueNRG_NotifySamples() and BlueNRG_NotifyRecord() do.
+  * @author			:
+  **************************************************************************************************
+  *
+  * The benchmark runs on built-in traces shaped as the sensor data (3-axis accelerometer and
+  * gyroscope, temperature, heart rate, JSON records using the dictionary fields). Recorded
+  * datasets can be given on the command line instead:
+  *   test_payload_codec -s <channels> <file>    int16 little endian samples, interleaved
+  *   test_payload_codec -r <file>               text records, one per line
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include "Host_Test.h"
+#include "Payload_Codec.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* Notification characteristic of BLE_Process.c */
+#define TEST_FRAME_SIZE									20U
+
+#define TEST_MAX_SAMPLES								6000U
+#define TEST_MAX_RECORDS								400U
+
+/* Air time gain of typical telemetry, raw frames per 100 compressed ones. Every frame restarts
+ * the deltas, so streams of many channels gain less than 2x in 20-byte frames */
+#define TEST_SAMPLES_GAIN_MIN						190U
+#define TEST_SAMPLES_3CH_GAIN_MIN				160U
+/* Records: raw bytes per 100 sent */
+#define TEST_RECORDS_GAIN_MIN						140U
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t Frames;
+	uint32_t Raw_Frames;							/* Same data in uncompressed frames */
+	uint32_t Bytes;										/* Sent, headers included */
+	uint32_t Raw_Bytes;
+	uint32_t Fit;											/* Records sent in one notification */
+	uint32_t Raw_Fit;
+
+} Test_Ratio_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static int16_t Samples[TEST_MAX_SAMPLES];
+static uint8_t Decoded[2U * TEST_MAX_SAMPLES];
+static uint8_t Records[TEST_MAX_RECORDS][CODEC_MAX_INPUT];
+static uint16_t Record_Length[TEST_MAX_RECORDS];
+
+static uint32_t Seed = 1;
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+/**
+  * @brief	Value between -Range and Range
+  */
+static int32_t Test_Noise(int32_t Range)
+{
+	return (int32_t)(Host_Rand(&Seed) % (uint32_t)(2 * Range + 1)) - Range;
+}
+
+/**
+  * @brief	Periodic motion without math.h: a triangle wave of the given period and amplitude
+  */
+static int32_t Test_Triangle(uint32_t t, uint32_t Period, int32_t Amplitude)
+{
+	int32_t Phase = (int32_t)(t % Period);
+	int32_t Half = (int32_t)(Period / 2U);
+
+	return (((Phase < Half) ? Phase : (2 * Half - Phase)) * 2 * Amplitude / Half) - Amplitude;
+}
+
+/**
+  * @brief	Sends samples as BlueNRG_NotifySamples() does, decodes every frame and checks it
+  */
+static void Test_SendSamples(const int16_t *pSamples, uint16_t Count, uint8_t Channels, uint16_t Frame_Size, Test_Ratio_t *pRatio)
+{
+	uint8_t Frame[256];
+	uint16_t Sent = 0, Consumed, Length, Size;
+
+	while(Sent < Count)
+	{
+		Length = Codec_EncodeDelta16(&pSamples[Sent], Count - Sent, Channels, Frame, Frame_Size, &Consumed);
+		HOST_CHECK((Length > 1U) && (Length <= Frame_Size));
+		HOST_CHECK((Consumed != 0U) && ((Consumed % Channels) == 0U));
+		if((Length == 0U) || (Consumed == 0U))
+		{
+			return;
+		}
+		HOST_CHECK(CODEC_HEADER_CODEC(Frame[0]) == CODEC_DELTA16);
+
+		HOST_CHECK(Codec_Decode(Frame, Length, Decoded, sizeof(Decoded), &Size) == CODEC_OK);
+		HOST_CHECK(Size == (2U * Consumed));
+		HOST_CHECK(memcmp(Decoded, &pSamples[Sent], Size) == 0);
+
+		/* Too small an output is refused, not overrun */
+		if(Size > 0U)
+		{
+			HOST_CHECK(Codec_Decode(Frame, Length, Decoded, Size - 1U, &Size) == CODEC_ERROR_OVERFLOW);
+		}
+
+		Sent += Consumed;
+		if(pRatio != NULL)
+		{
+			pRatio->Frames++;
+			pRatio->Bytes += Length;
+		}
+	}
+
+	if(pRatio != NULL)
+	{
+		/* Whole sample sets per raw frame */
+		pRatio->Raw_Frames += (Count + ((((Frame_Size - 1U) / 2U) / Channels) * Channels) - 1U) /
+													((((Frame_Size - 1U) / 2U) / Channels) * Channels);
+		pRatio->Raw_Bytes += 2U * Count;
+	}
+}
+
+/**
+  * @brief	Sends a record as BlueNRG_NotifyRecord() does, with a frame large enough to hold it
+  * @retval	Frame length
+  */
+static uint16_t Test_SendRecord(const uint8_t *pRecord, uint16_t Length, uint16_t Frame_Size)
+{
+	uint8_t Frame[CODEC_MAX_INPUT + 8U];
+	uint16_t Size, Frame_Length;
+
+	Frame_Length = Codec_EncodeRecord(pRecord, Length, Frame, Frame_Size);
+	if(Frame_Length == 0U)
+	{
+		/* Only when it does not fit even uncompressed */
+		HOST_CHECK((Length + 1U) > Frame_Size);
+		return 0;
+	}
+
+	HOST_CHECK((Frame_Length <= Frame_Size) && (Frame_Length <= (Length + 1U)));
+	HOST_CHECK(Codec_Decode(Frame, Frame_Length, Decoded, sizeof(Decoded), &Size) == CODEC_OK);
+	HOST_CHECK((Size == Length) && (memcmp(Decoded, pRecord, Length) == 0));
+
+	return Frame_Length;
+}
+
+/**
+  * @brief	3-axis accelerometer at 100 Hz, in mg: gravity, walking steps and sensor noise
+  */
+static uint16_t Test_TraceAccelerometer(void)
+{
+	uint16_t t;
+
+	for(t = 0; t < (TEST_MAX_SAMPLES / 3U); t++)
+	{
+		Samples[3U * t] = (int16_t)(Test_Triangle(t, 110, 180) + Test_Noise(4));
+		Samples[3U * t + 1U] = (int16_t)(Test_Triangle(t + 20U, 110, 90) + Test_Noise(4));
+		Samples[3U * t + 2U] = (int16_t)(1000 + Test_Triangle(t, 55, 250) + Test_Noise(4));
+	}
+	return (uint16_t)(3U * t);
+}
+
+/**
+  * @brief	3-axis gyroscope in 0.1 dps: slow turns and a larger noise
+  */
+static uint16_t Test_TraceGyroscope(void)
+{
+	int32_t Drift[3] = {0, 0, 0};
+	uint16_t t, c;
+
+	for(t = 0; t < (TEST_MAX_SAMPLES / 3U); t++)
+	{
+		for(c = 0; c < 3U; c++)
+		{
+			Drift[c] += Test_Noise(3);
+			Samples[3U * t + c] = (int16_t)(Drift[c] + Test_Triangle(t + 40U * c, 400, 300) + Test_Noise(12));
+		}
+	}
+	return (uint16_t)(3U * t);
+}
+
+/**
+  * @brief	Temperature in 0.01 degC and heart rate in 0.1 bpm, one sample set a second
+  */
+static uint16_t Test_TraceVitals(void)
+{
+	int32_t Temperature = 3650, Rate = 720;
+	uint16_t t;
+
+	for(t = 0; t < (TEST_MAX_SAMPLES / 2U); t++)
+	{
+		Temperature += Test_Noise(2);
+		Rate += Test_Noise(6);
+		Rate += (Rate < 600) ? 3 : ((Rate > 1200) ? -3 : 0);
+		Samples[2U * t] = (int16_t)Temperature;
+		Samples[2U * t + 1U] = (int16_t)Rate;
+	}
+	return (uint16_t)(2U * t);
+}
+
+/**
+  * @brief	Status records as sent with BlueNRG_NotifyRecord()
+  */
+static uint16_t Test_TraceRecords(void)
+{
+	uint16_t n;
+	int Length;
+
+	for(n = 0; n < TEST_MAX_RECORDS; n++)
+	{
+		switch(n % 4U)
+		{
+			case 0:
+				Length = snprintf((char *)Records[n], CODEC_MAX_INPUT, "{\"t\":%u,\"acc\":[%d,%d,%d]}", 1000U * n,
+													(int)Test_Noise(200), (int)Test_Noise(200), 1000 + (int)Test_Noise(50));
+				break;
+			case 1:
+				Length = snprintf((char *)Records[n], CODEC_MAX_INPUT, "{\"t\":%u,\"hr\":%d,\"spo2\":%d}", 1000U * n,
+													70 + (int)Test_Noise(10), 97 + (int)Test_Noise(2));
+				break;
+			case 2:
+				Length = snprintf((char *)Records[n], CODEC_MAX_INPUT, "{\"t\":%u,\"temp\":%d,\"bat\":%d}", 1000U * n,
+													3650 + (int)Test_Noise(20), 80 - (int)(n / 40U));
+				break;
+			default:
+				Length = snprintf((char *)Records[n], CODEC_MAX_INPUT, "{\"id\":%u,\"state\":%s,\"step\":%u}", n,
+													(Host_Rand(&Seed) & 1U) ? "true" : "false", 10U * n);
+				break;
+		}
+		Record_Length[n] = (uint16_t)Length;
+	}
+	return n;
+}
+
+/**
+  * @brief	Recorded int16 samples, little endian
+  */
+static uint16_t Test_LoadSamples(const char *pPath)
+{
+	uint8_t Bytes[2];
+	uint16_t Count = 0;
+	FILE *pFile = fopen(pPath, "rb");
+
+	if(pFile == NULL)
+	{
+		return 0;
+	}
+	while((Count < TEST_MAX_SAMPLES) && (fread(Bytes, 1, 2, pFile) == 2U))
+	{
+		Samples[Count++] = (int16_t)(Bytes[0] | (Bytes[1] << 8));
+	}
+	(void)fclose(pFile);
+	return Count;
+}
+
+/**
+  * @brief	Recorded text records, one per line
+  */
+static uint16_t Test_LoadRecords(const char *pPath)
+{
+	char Line[512];
+	uint16_t Count = 0;
+	size_t Length;
+	FILE *pFile = fopen(pPath, "r");
+
+	if(pFile == NULL)
+	{
+		return 0;
+	}
+	while((Count < TEST_MAX_RECORDS) && (fgets(Line, sizeof(Line), pFile) != NULL))
+	{
+		Length = strcspn(Line, "\r\n");
+		if((Length == 0U) || (Length > CODEC_MAX_INPUT))
+		{
+			continue;
+		}
+		memcpy(Records[Count], Line, Length);
+		Record_Length[Count++] = (uint16_t)Length;
+	}
+	(void)fclose(pFile);
+	return Count;
+}
+
+/**
+  * @brief	Samples: prints and returns the air time gain, raw frames per 100 compressed frames
+  */
+static uint32_t Test_BenchSamples(const char *pName, uint16_t Count, uint8_t Channels)
+{
+	Test_Ratio_t Ratio;
+	uint32_t Gain;
+
+	memset(&Ratio, 0, sizeof(Ratio));
+	Test_SendSamples(Samples, Count, Channels, TEST_FRAME_SIZE, &Ratio);
+	Gain = (Ratio.Frames != 0U) ? ((100U * Ratio.Raw_Frames) / Ratio.Frames) : 0U;
+
+	printf("  %-32s %6u -> %6u bytes, %5u -> %5u frames, gain %u.%02u\n", pName, (unsigned int)Ratio.Raw_Bytes,
+				 (unsigned int)Ratio.Bytes, (unsigned int)Ratio.Raw_Frames, (unsigned int)Ratio.Frames,
+				 (unsigned int)(Gain / 100U), (unsigned int)(Gain % 100U));
+	return Gain;
+}
+
+/**
+  * @brief	Records: prints and returns the gain in bytes, raw bytes per 100 sent, and counts the
+  *					records fitting one notification
+  */
+static uint32_t Test_BenchRecords(const char *pName, uint16_t Count)
+{
+	Test_Ratio_t Ratio;
+	uint32_t Gain;
+	uint16_t n;
+
+	memset(&Ratio, 0, sizeof(Ratio));
+	for(n = 0; n < Count; n++)
+	{
+		Ratio.Bytes += Test_SendRecord(Records[n], Record_Length[n], CODEC_MAX_INPUT + 1U);
+		Ratio.Raw_Bytes += Record_Length[n];
+		Ratio.Fit += (Test_SendRecord(Records[n], Record_Length[n], TEST_FRAME_SIZE) != 0U);
+		Ratio.Raw_Fit += (Record_Length[n] < TEST_FRAME_SIZE);
+	}
+	Gain = (Ratio.Bytes != 0U) ? ((100U * Ratio.Raw_Bytes) / Ratio.Bytes) : 0U;
+
+	printf("  %-32s %6u -> %6u bytes, gain %u.%02u, %u -> %u of %u records in one frame\n", pName,
+				 (unsigned int)Ratio.Raw_Bytes, (unsigned int)Ratio.Bytes, (unsigned int)(Gain / 100U), (unsigned int)(Gain % 100U),
+				 (unsigned int)Ratio.Raw_Fit, (unsigned int)Ratio.Fit, (unsigned int)Count);
+	HOST_CHECK(Ratio.Fit >= Ratio.Raw_Fit);
+	return Gain;
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	CODEC_DELTA16 round trips: every channel count and frame size, full scale steps
+  */
+static void Test_Codec_Delta16(void)
+{
+	uint8_t Frame[8];
+	uint16_t Count, Consumed, Size, i;
+	uint8_t Channels;
+	uint16_t Frame_Size;
+
+	for(Channels = 1; Channels <= CODEC_MAX_CHANNELS; Channels++)
+	{
+		/* From the smallest frame holding any sample set: header and a 3-byte varint per sample */
+		for(Frame_Size = (uint16_t)(1U + (3U * Channels)); Frame_Size <= 244U; Frame_Size += 11U)
+		{
+			Count = (uint16_t)((Host_Rand(&Seed) % 300U) / Channels * Channels);
+			for(i = 0; i < Count; i++)
+			{
+				switch(Host_Rand(&Seed) % 4U)
+				{
+					case 0:
+						Samples[i] = (int16_t)((Host_Rand(&Seed) & 1U) ? INT16_MAX : INT16_MIN);
+						break;
+					case 1:
+						Samples[i] = (int16_t)Host_Rand(&Seed);
+						break;
+					default:
+						Samples[i] = (int16_t)(((i >= Channels) ? Samples[i - Channels] : 0) + Test_Noise(60));
+						break;
+				}
+			}
+			Test_SendSamples(Samples, Count, Channels, Frame_Size, NULL);
+		}
+	}
+
+	/* Nothing to send, or a sample set not fitting the frame */
+	HOST_CHECK(Codec_EncodeDelta16(Samples, 0, 1, Frame, sizeof(Frame), &Consumed) == 0U);
+	HOST_CHECK(Consumed == 0U);
+	HOST_CHECK(Codec_EncodeDelta16(Samples, 2, 3, Frame, sizeof(Frame), &Consumed) == 0U);
+	Samples[0] = INT16_MIN;
+	Samples[1] = INT16_MIN;
+	Samples[2] = INT16_MIN;
+	HOST_CHECK(Codec_EncodeDelta16(Samples, 3, 3, Frame, sizeof(Frame), &Consumed) == 0U);
+	HOST_CHECK(Codec_EncodeDelta16(Samples, 3, 0, Frame, sizeof(Frame), &Consumed) == 0U);
+	HOST_CHECK(Codec_EncodeDelta16(Samples, 17, 17, Frame, sizeof(Frame), &Consumed) == 0U);
+	HOST_CHECK(Codec_EncodeDelta16(Samples, 1, 1, Frame, 1, &Consumed) == 0U);
+
+	/* Constant signal: one byte per sample after the first */
+	for(i = 0; i < 40U; i++)
+	{
+		Samples[i] = 1234;
+	}
+	HOST_CHECK(Codec_EncodeDelta16(Samples, 40, 1, Frame, sizeof(Frame), &Consumed) == 8U);
+	HOST_CHECK(Consumed == 6U);
+	HOST_CHECK(Codec_Decode(Frame, 8, Decoded, sizeof(Decoded), &Size) == CODEC_OK);
+	HOST_CHECK(Size == 12U);
+}
+
+/**
+  * @brief	CODEC_LZ and CODEC_RAW round trips of text, structured and random records
+  */
+static void Test_Codec_Records(void)
+{
+	uint8_t Record[CODEC_MAX_INPUT];
+	uint8_t Frame[CODEC_MAX_INPUT + 8U];
+	uint16_t Length, Size, Frame_Length, n, i;
+	static const char *Words[] = {"{\"t\":", "\"acc\":[", ",", "]", "}", "null", "true", "\"hr\":", "OK", "ERR", "x"};
+
+	for(n = 0; n < 3000U; n++)
+	{
+		Length = (uint16_t)(Host_Rand(&Seed) % (CODEC_MAX_INPUT + 1U));
+		switch(n % 3U)
+		{
+			case 0:
+				/* Random bytes: stored raw */
+				for(i = 0; i < Length; i++)
+				{
+					Record[i] = (uint8_t)Host_Rand(&Seed);
+				}
+				break;
+			case 1:
+				/* Dictionary words and digits */
+				for(i = 0; i < Length;)
+				{
+					const char *pWord = Words[Host_Rand(&Seed) % (sizeof(Words) / sizeof(Words[0]))];
+
+					while((*pWord != '\0') && (i < Length))
+					{
+						Record[i++] = (uint8_t)*pWord++;
+					}
+					if(i < Length)
+					{
+						Record[i++] = (uint8_t)('0' + (Host_Rand(&Seed) % 10U));
+					}
+				}
+				break;
+			default:
+				/* Long runs: overlapping matches */
+				for(i = 0; i < Length; i++)
+				{
+					Record[i] = (uint8_t)((i < 5U) ? ('a' + (Host_Rand(&Seed) % 3U)) : Record[i - 1U - (Host_Rand(&Seed) % 4U)]);
+				}
+				break;
+		}
+
+		(void)Test_SendRecord(Record, Length, CODEC_MAX_INPUT + 1U);
+		(void)Test_SendRecord(Record, Length, TEST_FRAME_SIZE);
+
+		/* LZ alone: decodes whenever it fits */
+		Frame_Length = Codec_EncodeLZ(Record, Length, Frame, (uint16_t)(1U + (Host_Rand(&Seed) % sizeof(Frame))));
+		if(Frame_Length != 0U)
+		{
+			HOST_CHECK(CODEC_HEADER(CODEC_LZ, CODEC_DICT_ID) == Frame[0]);
+			HOST_CHECK(Codec_Decode(Frame, Frame_Length, Decoded, sizeof(Decoded), &Size) == CODEC_OK);
+			HOST_CHECK((Size == Length) && (memcmp(Decoded, Record, Length) == 0));
+		}
+	}
+
+	HOST_CHECK(Codec_EncodeLZ(Record, CODEC_MAX_INPUT + 1U, Frame, sizeof(Frame)) == 0U);
+
+	/* A field name of the dictionary is a single match */
+	HOST_CHECK(Codec_EncodeLZ((const uint8_t *)"\"temp\":", 7, Frame, sizeof(Frame)) == 3U);
+}
+
+/**
+  * @brief	Malformed frames are rejected without writing past the output
+  */
+static void Test_Codec_Malformed(void)
+{
+	uint8_t Frame[64];
+	uint8_t Out[64];
+	uint16_t Size, Length, n, i;
+	Codec_Status_t Status;
+
+	HOST_CHECK(Codec_Decode(Frame, 0, Out, sizeof(Out), &Size) == CODEC_ERROR_FORMAT);
+
+	Frame[0] = CODEC_HEADER(0x0F, 0);
+	HOST_CHECK(Codec_Decode(Frame, 1, Out, sizeof(Out), &Size) == CODEC_ERROR_FORMAT);
+	Frame[0] = CODEC_HEADER(CODEC_LZ, 0x02);
+	HOST_CHECK(Codec_Decode(Frame, 1, Out, sizeof(Out), &Size) == CODEC_ERROR_PARAM);
+
+	/* Two channels, three samples; varint cut; varint too long */
+	memcpy(Frame, "\x11\x02\x04\x06", 4);
+	HOST_CHECK(Codec_Decode(Frame, 4, Out, sizeof(Out), &Size) == CODEC_ERROR_FORMAT);
+	memcpy(Frame, "\x10\x82", 2);
+	HOST_CHECK(Codec_Decode(Frame, 2, Out, sizeof(Out), &Size) == CODEC_ERROR_FORMAT);
+	memcpy(Frame, "\x10\x80\x80\x80\x01", 5);
+	HOST_CHECK(Codec_Decode(Frame, 5, Out, sizeof(Out), &Size) == CODEC_ERROR_FORMAT);
+
+	/* Literal run past the end; match without its distance; match before the dictionary */
+	memcpy(Frame, "\x21\x05\x41", 3);
+	HOST_CHECK(Codec_Decode(Frame, 3, Out, sizeof(Out), &Size) == CODEC_ERROR_FORMAT);
+	memcpy(Frame, "\x21\x80", 2);
+	HOST_CHECK(Codec_Decode(Frame, 2, Out, sizeof(Out), &Size) == CODEC_ERROR_FORMAT);
+	memcpy(Frame, "\x21\x87\xFF", 3);
+	HOST_CHECK(Codec_Decode(Frame, 3, Out, sizeof(Out), &Size) == CODEC_ERROR_FORMAT);
+
+	/* Random frames: any status, but the decoded length stays within the output */
+	for(n = 0; n < 20000U; n++)
+	{
+		Length = (uint16_t)(1U + (Host_Rand(&Seed) % sizeof(Frame)));
+		for(i = 0; i < Length; i++)
+		{
+			Frame[i] = (uint8_t)Host_Rand(&Seed);
+		}
+		Frame[0] = CODEC_HEADER(Host_Rand(&Seed) % 3U, (n % 3U == 2U) ? CODEC_DICT_ID : Frame[0]);
+		Status = Codec_Decode(Frame, Length, Out, (uint16_t)(Host_Rand(&Seed) % sizeof(Out)), &Size);
+		HOST_CHECK((Status != CODEC_OK) || (Size <= sizeof(Out)));
+	}
+}
+
+/**
+  * @brief	Compression of the built-in traces in 20-byte notifications
+  */
+static void Test_Codec_Benchmark(void)
+{
+	HOST_CHECK(Test_BenchSamples("accelerometer 3 ch, mg", Test_TraceAccelerometer(), 3) >= TEST_SAMPLES_3CH_GAIN_MIN);
+	HOST_CHECK(Test_BenchSamples("vitals 2 ch, 0.01 degC/0.1 bpm", Test_TraceVitals(), 2) >= TEST_SAMPLES_GAIN_MIN);
+	HOST_CHECK(Test_BenchSamples("gyroscope 3 ch, 0.1 dps", Test_TraceGyroscope(), 3) >= TEST_SAMPLES_3CH_GAIN_MIN);
+	HOST_CHECK(Test_BenchRecords("JSON status records", Test_TraceRecords()) >= TEST_RECORDS_GAIN_MIN);
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+	int i;
+
+	/* Recorded datasets: benchmark only */
+	if(argc > 1)
+	{
+		for(i = 1; i < argc; i++)
+		{
+			if((strcmp(argv[i], "-s") == 0) && ((i + 2) < argc))
+			{
+				(void)Test_BenchSamples(argv[i + 2], Test_LoadSamples(argv[i + 2]), (uint8_t)atoi(argv[i + 1]));
+				i += 2;
+			}
+			else if((strcmp(argv[i], "-r") == 0) && ((i + 1) < argc))
+			{
+				(void)Test_BenchRecords(argv[i + 1], Test_LoadRecords(argv[i + 1]));
+				i += 1;
+			}
+			else
+			{
+				printf("usage: %s [-s <channels> <int16 file>] [-r <records file>]...\n", argv[0]);
+				return 2;
+			}
+		}
+		HOST_TEST_END();
+	}
+
+	HOST_RUN(Test_Codec_Delta16);
+	HOST_RUN(Test_Codec_Records);
+	HOST_RUN(Test_Codec_Malformed);
+	HOST_RUN(Test_Codec_Benchmark);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
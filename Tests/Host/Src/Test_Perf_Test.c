@@ -0,0 +1,910 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Perf_Test.c
+  * @brief      : Host test of Perf_Test.c. The service is added to the database of an emulated
+	*								controller, then its source, sink and echo runs are driven over an emulated link
+	*								with connection events, TX buffers and a scripted peer.
+  * @author			:
+  **************************************************************************************************
+  *
+  * The results of each run (bytes per second, lost packets, round trip times and their histogram)
+  * are checked against what the peer and the link saw, and against the value published on the
+  * results characteristic.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Host_Test.h"
+#include "Perf_Test.h"
+#include "Radio_Sched.h"
+#include "Link_Monitor.h"
+#include "hci.h"
+#include "hci_tl.h"
+#include "bluenrg1_gatt_aci.h"
+#include "bluenrg1_gatt_server.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+#define TEST_OGF												((uint16_t)0x3F)
+#define TEST_OCF_ADD_SERVICE						((uint16_t)0x0102)
+#define TEST_OCF_ADD_CHAR								((uint16_t)0x0104)
+
+/* Handles the GATT and GAP services of the controller take after aci_gatt_init(), aci_gap_init() */
+#define TEST_FIRST_FREE_HANDLE					((uint16_t)0x000C)
+#define TEST_CREDITS										2U
+
+#define TEST_CONNECTION									((uint16_t)0x0801)
+
+/* Start of the runs, TIM2 wraps around during their first second */
+#define TEST_T0_US											0xFFF00000U
+#define TEST_STEP_US										500U
+
+#define TEST_MAX_POOL										32U
+#define TEST_MAX_ECHOES									8U
+#define TEST_MAX_DROPPED								256U
+
+/* Echo packets, as in Perf_Test.c */
+#define TEST_PKT_PROBE									((uint8_t)0xE0)
+#define TEST_PKT_PEER										((uint8_t)0xE1)
+#define TEST_PROBE_SIZE									7U
+
+#define TEST_GET_U16(p)									((uint16_t)((p)[0] | ((uint16_t)(p)[1] << 8)))
+#define TEST_GET_U32(p)									((uint32_t)((p)[0] | ((uint32_t)(p)[1] << 8) | ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24)))
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+/**
+  * @brief GATT database of the emulated controller, and the add commands in flight
+  */
+typedef struct
+{
+	uint16_t Next_Free;
+	uint16_t Service;
+	uint8_t Records;
+	uint8_t Used;
+	uint8_t Uuid[4][16];							/* Service, then characteristics */
+	uint16_t Char[3];
+	uint8_t Properties[3];
+	uint16_t Max_Length[3];
+	uint8_t Chars;
+
+	uint8_t Status[TEST_CREDITS];
+	uint16_t Handle[TEST_CREDITS];
+	uint8_t Head;
+	uint8_t In_Flight;
+	uint32_t Commands;
+
+} Gatt_t;
+
+/* Peer of a run */
+typedef enum
+{
+	PEER_READ = 0x00,									/* Counts the notifications */
+	PEER_WRITE,												/* Writes sequence numbered packets */
+	PEER_ECHO,												/* Reflects the probes, sends its own */
+
+} Peer_Mode_t;
+
+/* Probe held by the peer before it reflects it */
+typedef struct
+{
+	uint8_t Data[TEST_PROBE_SIZE];
+	uint64_t Due_us;
+	uint32_t Sent_us;									/* TIM2 time the probe was queued at */
+	uint8_t Counted;									/* Reflected in time, its RTT expected */
+
+} Echo_t;
+
+/**
+  * @brief Link: connection events, TX buffers of the controller and the peer
+  */
+typedef struct
+{
+	uint64_t Time_us;
+	uint32_t Interval_us;
+	uint8_t Per_Event;								/* Packets each way in a connection event */
+	uint8_t Pool_Size;								/* Notifications the controller buffers */
+	uint8_t Pool[TEST_MAX_POOL][PERFTEST_MAX_PAYLOAD];
+	uint8_t Pool_Length[TEST_MAX_POOL];
+	uint32_t Pool_Time[TEST_MAX_POOL];				/* TIM2 time queued at */
+	uint32_t Pool_Tick[TEST_MAX_POOL];
+	uint8_t Pool_Head;
+	uint8_t Pool_Count;
+	uint32_t Pool_Refused;
+
+	RadioSched_RefillFunc_t Refill;
+	uint32_t Refills;
+	uint32_t Refills_Full;
+	uint32_t Burst_Max;
+	uint32_t Reported_Sent;						/* LinkMon_ReportTx() */
+	uint32_t Reported_Failed;
+
+	Peer_Mode_t Peer;
+	uint32_t Seed;
+	uint8_t Payload;									/* Expected in source runs */
+	uint32_t Rx_Packets;
+	uint32_t Rx_Bytes;
+	uint32_t Rx_Gaps;
+	uint16_t Rx_Seq;
+	uint16_t Tx_Seq;
+	uint32_t Tx_Packets;
+	uint32_t Tx_Bytes;
+	uint32_t Tx_Skipped;							/* Sequence numbers the peer did not write */
+
+	Echo_t Echo[TEST_MAX_ECHOES];
+	uint8_t Echoes;
+	uint32_t Probes_Seen;
+	uint32_t Probes_Dropped;					/* Not reflected in time */
+	uint32_t Dropped_Tick[TEST_MAX_DROPPED];	/* Tick their timeout expires at */
+	uint8_t Timeout_Pending;					/* The next probe comes at the last timeout */
+	uint32_t Timeouts;
+	uint8_t Peer_Probe[TEST_PROBE_SIZE];
+	uint8_t Peer_Pending;
+	uint32_t Peer_Echoed;
+
+	/* RTTs the results must hold */
+	uint32_t RTT_Count;
+	uint32_t RTT_Min_us;
+	uint32_t RTT_Max_us;
+	uint32_t RTT_Sum_us;
+	uint16_t RTT_Hist[PERFTEST_RTT_BINS];
+
+} Link_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+UART_HandleTypeDef huart1;
+
+static Gatt_t Gatt;
+static Link_t Link;
+static uint32_t Tick;
+
+static uint8_t Published[PERFTEST_RESULTS_SIZE];
+static uint32_t Publications;
+static uint32_t Reports;
+
+/* UUIDs of Perf_Test.c */
+static const uint8_t Test_Uuid[4][16] =
+{
+	{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x90,0xEA,0x25,0x9B},
+	{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x91,0xEA,0x25,0x9B},
+	{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x92,0xEA,0x25,0x9B},
+	{0x96,0xF7,0x4E,0xBF,0xB3,0x8E,0xB7,0x82,0x36,0x4B,0x7E,0x8B,0x93,0xEA,0x25,0x9B},
+};
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+uint32_t HAL_GetTick(void)
+{
+	return Tick;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	(void)pData;
+	(void)Timeout;
+	HOST_CHECK((huart == &huart1) && (Size != 0U));
+	Reports++;
+	return HAL_OK;
+}
+
+uint32_t RadioSched_GetTime(void)
+{
+	return (uint32_t)Link.Time_us;
+}
+
+void RadioSched_SetRefill(RadioSched_RefillFunc_t Refill)
+{
+	Link.Refill = Refill;
+}
+
+void LinkMon_ReportTx(uint16_t Connection_Handle, uint16_t Sent, uint16_t Failed)
+{
+	HOST_CHECK(Connection_Handle == TEST_CONNECTION);
+	Link.Reported_Sent += Sent;
+	Link.Reported_Failed += Failed;
+}
+
+static uint8_t Gatt_AddService(const uint8_t *pParam, uint32_t Length, uint16_t *pHandle)
+{
+	HOST_CHECK((Length == 19U) && (pParam[0] == UUID_TYPE_128) && (pParam[17] == PRIMARY_SERVICE));
+	if(Gatt.Service != 0U)
+	{
+		return BLE_STATUS_INSUFFICIENT_RESOURCES;
+	}
+
+	Gatt.Service = Gatt.Next_Free;
+	Gatt.Records = pParam[18];
+	Gatt.Used = 1;
+	memcpy(Gatt.Uuid[0], &pParam[1], 16);
+	Gatt.Next_Free += Gatt.Records;
+
+	*pHandle = Gatt.Service;
+	return BLE_STATUS_SUCCESS;
+}
+
+/* Declaration and value, and the CCCD the controller adds to a notify characteristic */
+static uint8_t Gatt_AddChar(const uint8_t *pParam, uint32_t Length, uint16_t *pHandle)
+{
+	uint8_t Properties = pParam[21];
+	uint8_t Records = (Properties & CHAR_PROP_NOTIFY) ? 3U : 2U;
+
+	HOST_CHECK((Length == 26U) && (pParam[2] == UUID_TYPE_128));
+	if((TEST_GET_U16(pParam) != Gatt.Service) || (Gatt.Service == 0U))
+	{
+		return BLE_STATUS_INVALID_HANDLE;
+	}
+	if(((Gatt.Used + Records) > Gatt.Records) || (Gatt.Chars >= 3U))
+	{
+		return BLE_STATUS_INSUFFICIENT_RESOURCES;
+	}
+
+	memcpy(Gatt.Uuid[1U + Gatt.Chars], &pParam[3], 16);
+	Gatt.Char[Gatt.Chars] = Gatt.Service + Gatt.Used;
+	Gatt.Properties[Gatt.Chars] = Properties;
+	Gatt.Max_Length[Gatt.Chars] = TEST_GET_U16(&pParam[19]);
+	Gatt.Used += Records;
+
+	*pHandle = Gatt.Char[Gatt.Chars++];
+	return BLE_STATUS_SUCCESS;
+}
+
+/**
+  * @brief	aci_gatt_add_service and aci_gatt_add_char, as Gatt_Builder.c queues them
+  */
+int hci_send_cmd_queued(struct hci_request *r)
+{
+	uint8_t Slot = (uint8_t)((Gatt.Head + Gatt.In_Flight) % TEST_CREDITS);
+	uint16_t Handle = 0;
+
+	if(Gatt.In_Flight >= TEST_CREDITS)
+	{
+		return -1;
+	}
+	HOST_CHECK(r->ogf == TEST_OGF);
+
+	if(r->ocf == TEST_OCF_ADD_SERVICE)
+	{
+		Gatt.Status[Slot] = Gatt_AddService((const uint8_t *)r->cparam, r->clen, &Handle);
+	}
+	else if(r->ocf == TEST_OCF_ADD_CHAR)
+	{
+		Gatt.Status[Slot] = Gatt_AddChar((const uint8_t *)r->cparam, r->clen, &Handle);
+	}
+	else
+	{
+		HOST_CHECK(0);
+		Gatt.Status[Slot] = BLE_STATUS_ERROR;
+	}
+
+	Gatt.Handle[Slot] = Handle;
+	Gatt.In_Flight++;
+	Gatt.Commands++;
+	return 0;
+}
+
+int hci_wait_cmd_response(struct hci_request *r)
+{
+	uint8_t *pParam = (uint8_t *)r->rparam;
+
+	HOST_CHECK((Gatt.In_Flight != 0U) && (r->rlen == 3U));
+	if(Gatt.In_Flight == 0U)
+	{
+		return -1;
+	}
+
+	pParam[0] = Gatt.Status[Gatt.Head];
+	pParam[1] = (uint8_t)Gatt.Handle[Gatt.Head];
+	pParam[2] = (uint8_t)(Gatt.Handle[Gatt.Head] >> 8);
+	Gatt.Head = (uint8_t)((Gatt.Head + 1U) % TEST_CREDITS);
+	Gatt.In_Flight--;
+	return 0;
+}
+
+uint8_t hci_cmd_credits(void)
+{
+	return (uint8_t)(TEST_CREDITS - Gatt.In_Flight);
+}
+
+/* Results characteristic, and notifications of the data characteristic into the TX buffers */
+tBleStatus aci_gatt_update_char_value(uint16_t Service_Handle, uint16_t Char_Handle, uint8_t Val_Offset,
+																			uint8_t Char_Value_Length, uint8_t Char_Value[])
+{
+	uint8_t Slot;
+
+	HOST_CHECK((Service_Handle == Gatt.Service) && (Val_Offset == 0U));
+
+	if(Char_Handle == Gatt.Char[2])
+	{
+		HOST_CHECK(Char_Value_Length == PERFTEST_RESULTS_SIZE);
+		memcpy(Published, Char_Value, PERFTEST_RESULTS_SIZE);
+		Publications++;
+		return BLE_STATUS_SUCCESS;
+	}
+
+	HOST_CHECK((Char_Handle == Gatt.Char[1]) && (Char_Value_Length <= PERFTEST_MAX_PAYLOAD));
+	if(Link.Pool_Count >= Link.Pool_Size)
+	{
+		Link.Pool_Refused++;
+		return BLE_STATUS_INSUFFICIENT_RESOURCES;
+	}
+
+	Slot = (uint8_t)((Link.Pool_Head + Link.Pool_Count) % TEST_MAX_POOL);
+	memcpy(Link.Pool[Slot], Char_Value, Char_Value_Length);
+	Link.Pool_Length[Slot] = Char_Value_Length;
+	Link.Pool_Time[Slot] = (uint32_t)Link.Time_us;
+	Link.Pool_Tick[Slot] = Tick;
+	Link.Pool_Count++;
+	return BLE_STATUS_SUCCESS;
+}
+
+static void Test_Write(uint16_t Handle, const uint8_t *pData, uint16_t Length)
+{
+	HOST_CHECK(PerfTest_AttributeModified(TEST_CONNECTION, Handle, Length, pData) == 1U);
+}
+
+static void Test_Command(const uint8_t *pCommand, uint16_t Length)
+{
+	Test_Write(Gatt.Char[0] + 1U, pCommand, Length);
+}
+
+/* Histogram bin, independent of PerfTest_RttBin() */
+static uint8_t Test_Bin(uint32_t RTT_us)
+{
+	uint8_t Bin;
+
+	for(Bin = 0; Bin < (PERFTEST_RTT_BINS - 1U); Bin++)
+	{
+		if(RTT_us <= (PERFTEST_RTT_BIN0_US << Bin))
+		{
+			break;
+		}
+	}
+	return Bin;
+}
+
+/**
+  * @brief	The peer received a notification
+  */
+static void Peer_Notified(const uint8_t *pData, uint8_t Length, uint32_t Sent_us, uint32_t Sent_Tick)
+{
+	Echo_t *pEcho;
+	uint32_t Delay;
+
+	if(Link.Peer == PEER_READ)
+	{
+		HOST_CHECK(Length == Link.Payload);
+		if(TEST_GET_U16(pData) != Link.Rx_Seq)
+		{
+			Link.Rx_Gaps++;
+		}
+		Link.Rx_Seq = (uint16_t)(TEST_GET_U16(pData) + 1U);
+		Link.Rx_Packets++;
+		Link.Rx_Bytes += Length;
+		return;
+	}
+
+	HOST_CHECK((Link.Peer == PEER_ECHO) && (Length == TEST_PROBE_SIZE));
+	if(pData[0] == TEST_PKT_PEER)
+	{
+		HOST_CHECK(Link.Peer_Pending && (memcmp(pData, Link.Peer_Probe, TEST_PROBE_SIZE) == 0));
+		Link.Peer_Pending = 0;
+		Link.Peer_Echoed++;
+		return;
+	}
+	HOST_CHECK((pData[0] == TEST_PKT_PROBE) && (TEST_GET_U32(&pData[3]) == Sent_us));
+	Link.Probes_Seen++;
+	if(Link.Timeout_Pending)
+	{
+		HOST_CHECK(Sent_Tick == Link.Dropped_Tick[Link.Probes_Dropped - 1U]);
+		Link.Timeout_Pending = 0;
+		Link.Timeouts++;
+	}
+
+	/* One probe in 16 dropped, one in 16 reflected too late, the others after 0 to 127 events */
+	switch(Host_Rand(&Link.Seed) % 16U)
+	{
+		case 0:
+			Delay = UINT32_MAX;
+			break;
+		case 1:
+			Delay = PERFTEST_ECHO_TIMEOUT_MS * 1000U + 500000U;
+			break;
+		default:
+			Delay = 1U << (Host_Rand(&Link.Seed) % 8U);
+			Delay = (Host_Rand(&Link.Seed) % Delay) * Link.Interval_us;
+			break;
+	}
+
+	if(Delay > (PERFTEST_ECHO_TIMEOUT_MS * 1000U))
+	{
+		HOST_CHECK(Link.Probes_Dropped < TEST_MAX_DROPPED);
+		if(Link.Probes_Dropped < TEST_MAX_DROPPED)
+		{
+			Link.Dropped_Tick[Link.Probes_Dropped++] = Sent_Tick + PERFTEST_ECHO_TIMEOUT_MS;
+			Link.Timeout_Pending = 1;
+		}
+	}
+	if(Delay == UINT32_MAX)
+	{
+		return;
+	}
+
+	HOST_CHECK(Link.Echoes < TEST_MAX_ECHOES);
+	pEcho = &Link.Echo[Link.Echoes++];
+	memcpy(pEcho->Data, pData, TEST_PROBE_SIZE);
+	pEcho->Due_us = Link.Time_us + Delay;
+	pEcho->Sent_us = Sent_us;
+	pEcho->Counted = (Delay <= (PERFTEST_ECHO_TIMEOUT_MS * 1000U));
+}
+
+/**
+  * @brief	The peer writes its packets of the connection event
+  */
+static void Peer_Write(void)
+{
+	uint8_t Packet[PERFTEST_MAX_PAYLOAD] = {0};
+	uint32_t RTT;
+	uint8_t i, k, Length;
+
+	for(k = 0; k < Link.Per_Event; k++)
+	{
+		if(Link.Peer == PEER_WRITE)
+		{
+			/* Sequence numbers skipped now and then, some packets repeated, a few too short */
+			switch((Link.Tx_Packets != 0U) ? (Host_Rand(&Link.Seed) % 64U) : 63U)
+			{
+				case 0:
+				case 1:
+					Link.Tx_Skipped += 1U + (Link.Tx_Seq % 3U);
+					Link.Tx_Seq = (uint16_t)(Link.Tx_Seq + 1U + (Link.Tx_Seq % 3U));
+					break;
+				case 2:
+					Link.Tx_Seq--;
+					break;
+				default:
+					break;
+			}
+			Packet[0] = (uint8_t)Link.Tx_Seq;
+			Packet[1] = (uint8_t)(Link.Tx_Seq >> 8);
+			Length = (uint8_t)(PERFTEST_MIN_PAYLOAD + (Host_Rand(&Link.Seed) % (PERFTEST_MAX_PAYLOAD - 1U)));
+			if((Host_Rand(&Link.Seed) % 256U) == 0U)
+			{
+				/* No sequence number: counted, not checked */
+				Length = 1;
+			}
+			else
+			{
+				Link.Tx_Seq++;
+			}
+			Test_Write(Gatt.Char[1] + 1U, Packet, Length);
+			Link.Tx_Packets++;
+			Link.Tx_Bytes += Length;
+			continue;
+		}
+
+		/* Echo: the reflections due, then now and then a probe of the peer */
+		for(i = 0; i < Link.Echoes; i++)
+		{
+			if(Link.Echo[i].Due_us <= Link.Time_us)
+			{
+				break;
+			}
+		}
+		if(i < Link.Echoes)
+		{
+			if(Link.Echo[i].Counted)
+			{
+				RTT = (uint32_t)Link.Time_us - Link.Echo[i].Sent_us;
+				Link.RTT_Count++;
+				Link.RTT_Min_us = (RTT < Link.RTT_Min_us) ? RTT : Link.RTT_Min_us;
+				Link.RTT_Max_us = (RTT > Link.RTT_Max_us) ? RTT : Link.RTT_Max_us;
+				Link.RTT_Sum_us += RTT;
+				Link.RTT_Hist[Test_Bin(RTT)]++;
+			}
+			Test_Write(Gatt.Char[1] + 1U, Link.Echo[i].Data, TEST_PROBE_SIZE);
+			Link.Echo[i] = Link.Echo[--Link.Echoes];
+			continue;
+		}
+
+		if(!Link.Peer_Pending && ((Host_Rand(&Link.Seed) % 32U) == 0U))
+		{
+			Link.Peer_Probe[0] = TEST_PKT_PEER;
+			for(i = 1; i < TEST_PROBE_SIZE; i++)
+			{
+				Link.Peer_Probe[i] = (uint8_t)Host_Rand(&Link.Seed);
+			}
+			Link.Peer_Pending = 1;
+			Test_Write(Gatt.Char[1] + 1U, Link.Peer_Probe, TEST_PROBE_SIZE);
+		}
+		break;
+	}
+}
+
+/**
+  * @brief	Connection event: the refill RadioSched runs before it, then the packets of both sides
+  */
+static void Link_Event(void)
+{
+	RadioSched_Refill_t Refill;
+	uint8_t Count = Link.Pool_Count, k;
+
+	if(Link.Refill != NULL)
+	{
+		Refill = Link.Refill();
+		Link.Refills++;
+		if(Refill == RADIOSCHED_REFILL_FULL)
+		{
+			HOST_CHECK(Link.Pool_Count == Link.Pool_Size);
+			Link.Refills_Full++;
+		}
+		if((uint32_t)(Link.Pool_Count - Count) > Link.Burst_Max)
+		{
+			Link.Burst_Max = (uint32_t)(Link.Pool_Count - Count);
+		}
+	}
+
+	for(k = 0; (k < Link.Per_Event) && (Link.Pool_Count != 0U); k++)
+	{
+		Peer_Notified(Link.Pool[Link.Pool_Head], Link.Pool_Length[Link.Pool_Head], Link.Pool_Time[Link.Pool_Head],
+									Link.Pool_Tick[Link.Pool_Head]);
+		Link.Pool_Head = (uint8_t)((Link.Pool_Head + 1U) % TEST_MAX_POOL);
+		Link.Pool_Count--;
+	}
+
+	if(Link.Peer != PEER_READ)
+	{
+		Peer_Write();
+	}
+}
+
+/**
+  * @brief	Main loop for a while: connection events and PerfTest_Process()
+  */
+static void Link_Run(uint32_t Duration_ms)
+{
+	uint64_t End = Link.Time_us + ((uint64_t)Duration_ms * 1000U);
+
+	while(Link.Time_us < End)
+	{
+		Link.Time_us += TEST_STEP_US;
+		Tick = (uint32_t)(Link.Time_us / 1000U);
+		if(((Link.Time_us - TEST_T0_US) % Link.Interval_us) == 0U)
+		{
+			Link_Event();
+		}
+		PerfTest_Process();
+	}
+}
+
+/**
+  * @brief	Fresh controller and link, the service added and notifications enabled
+  */
+static void Test_Setup(Peer_Mode_t Peer, uint32_t Interval_us, uint8_t Per_Event, uint8_t Pool_Size)
+{
+	static const uint8_t Notify[2] = {0x01, 0x00};
+
+	memset(&Gatt, 0, sizeof(Gatt));
+	Gatt.Next_Free = TEST_FIRST_FREE_HANDLE;
+	memset(&Link, 0, sizeof(Link));
+	Link.Time_us = TEST_T0_US;
+	Link.Interval_us = Interval_us;
+	Link.Per_Event = Per_Event;
+	Link.Pool_Size = Pool_Size;
+	Link.Peer = Peer;
+	Link.Seed = 11;
+	Link.RTT_Min_us = UINT32_MAX;
+	Tick = (uint32_t)(Link.Time_us / 1000U);
+	Publications = 0;
+	Reports = 0;
+
+	HOST_CHECK(PerfTest_Init() == PERFTEST_OK);
+	Test_Write(Gatt.Char[1] + 2U, Notify, sizeof(Notify));
+}
+
+/**
+  * @brief	The results characteristic holds the results of the last run
+  * @param	Mode: mode of the run, the results are idle once it ended
+  */
+static void Test_CheckPublished(const PerfTest_Results_t *pResults, uint8_t Mode)
+{
+	uint32_t Count = 0;
+	uint8_t i;
+
+	for(i = 0; i < PERFTEST_RTT_BINS; i++)
+	{
+		Count += pResults->RTT_Hist[i];
+		HOST_CHECK(TEST_GET_U16(&Published[35U + (2U * i)]) == pResults->RTT_Hist[i]);
+	}
+
+	HOST_CHECK((Published[0] == Mode) && (pResults->Mode == PERFTEST_MODE_IDLE));
+	HOST_CHECK(TEST_GET_U32(&Published[1]) == pResults->Duration_ms);
+	HOST_CHECK(TEST_GET_U32(&Published[5]) == pResults->Bytes);
+	HOST_CHECK(TEST_GET_U32(&Published[9]) == pResults->Packets);
+	HOST_CHECK(TEST_GET_U32(&Published[13]) == pResults->Lost);
+	HOST_CHECK(TEST_GET_U32(&Published[17]) == pResults->Bytes_Per_s);
+	HOST_CHECK(TEST_GET_U16(&Published[21]) == Count);
+	HOST_CHECK(TEST_GET_U32(&Published[23]) == ((Count != 0U) ? pResults->RTT_Min_us : 0U));
+	HOST_CHECK(TEST_GET_U32(&Published[27]) == pResults->RTT_Max_us);
+	HOST_CHECK(TEST_GET_U32(&Published[31]) == ((Count != 0U) ? (pResults->RTT_Sum_us / Count) : 0U));
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	The service is added with aci_gatt_add_service and aci_gatt_add_char, the handles written
+  *					back are those the controller allocated, and idle results are published
+  */
+static void Test_PerfTest_Register(void)
+{
+	uint8_t i;
+
+	Test_Setup(PEER_READ, 7500, 4, 8);
+	HOST_CHECK((Gatt.Commands == 4U) && (Gatt.Chars == 3U) && (Gatt.In_Flight == 0U));
+	HOST_CHECK((Gatt.Service == TEST_FIRST_FREE_HANDLE) && (Gatt.Records == 8U) && (Gatt.Used == 8U));
+	for(i = 0; i < 4U; i++)
+	{
+		HOST_CHECK(memcmp(Gatt.Uuid[i], Test_Uuid[i], 16) == 0);
+	}
+
+	/* Control, data with its CCCD, results */
+	HOST_CHECK((Gatt.Char[0] == (Gatt.Service + 1U)) && (Gatt.Char[1] == (Gatt.Service + 3U)) && (Gatt.Char[2] == (Gatt.Service + 6U)));
+	HOST_CHECK(Gatt.Properties[0] == CHAR_PROP_WRITE);
+	HOST_CHECK(Gatt.Properties[1] == (CHAR_PROP_NOTIFY | CHAR_PROP_WRITE_WITHOUT_RESP));
+	HOST_CHECK(Gatt.Properties[2] == CHAR_PROP_READ);
+	HOST_CHECK((Gatt.Max_Length[1] == PERFTEST_MAX_PAYLOAD) && (Gatt.Max_Length[2] == PERFTEST_RESULTS_SIZE));
+
+	HOST_CHECK((Publications == 1U) && (Published[0] == PERFTEST_MODE_IDLE));
+	Test_CheckPublished(PerfTest_GetResults(), PERFTEST_MODE_IDLE);
+
+	/* Attributes of other services are left to the caller */
+	HOST_CHECK(PerfTest_AttributeModified(TEST_CONNECTION, Gatt.Service + 8U, 1, (const uint8_t *)"\x01") == 0U);
+	HOST_CHECK(PerfTest_AttributeModified(TEST_CONNECTION, Gatt.Service - 1U, 1, (const uint8_t *)"\x01") == 0U);
+}
+
+/**
+  * @brief	Source runs: the TX buffers are refilled before every connection event, the peer gets
+  *					every sequence number, and the rate is the one the link carries
+  */
+static void Test_PerfTest_Source(void)
+{
+	static const struct
+	{
+		uint32_t Interval_us;
+		uint8_t Per_Event;
+		uint8_t Pool_Size;
+		uint8_t Payload;
+
+	} Runs[] =
+	{
+		{7500, 4, 8, 20},
+		{7500, 6, 8, 12},
+		{30000, 20, 24, 20},									/* Bounded by PERFTEST_MAX_BURST */
+		{50000, 2, 12, 2},
+	};
+	const PerfTest_Results_t *pResults = PerfTest_GetResults();
+	uint8_t Command[4] = {PERFTEST_CMD_SOURCE, 0, 0, 0};
+	uint32_t Expected, Packets;
+	uint8_t r;
+
+	for(r = 0; r < (sizeof(Runs) / sizeof(Runs[0])); r++)
+	{
+		Test_Setup(PEER_READ, Runs[r].Interval_us, Runs[r].Per_Event, Runs[r].Pool_Size);
+		Link.Payload = Runs[r].Payload;
+		Command[1] = Runs[r].Payload;
+		Test_Command(Command, 2);
+		HOST_CHECK((pResults->Mode == PERFTEST_MODE_SOURCE) && (Link.Refill != NULL));
+		Link_Run(10000);
+		Packets = pResults->Packets;
+		Test_Command((const uint8_t *)"\x00", 1);
+
+		HOST_CHECK((pResults->Mode == PERFTEST_MODE_IDLE) && (Link.Refill == NULL));
+		HOST_CHECK(pResults->Duration_ms == 10000U);
+		HOST_CHECK((pResults->Packets == Packets) && (pResults->Bytes == (Packets * Runs[r].Payload)));
+		HOST_CHECK(pResults->Next_Seq == (uint16_t)Packets);
+		HOST_CHECK(pResults->Bytes_Per_s == (pResults->Bytes / 10U));
+
+		/* Everything queued reached the peer in order but what is still buffered */
+		HOST_CHECK((Link.Rx_Gaps == 0U) && (Link.Rx_Packets == (Packets - Link.Pool_Count)));
+		HOST_CHECK(Link.Burst_Max <= PERFTEST_MAX_BURST);
+		HOST_CHECK(Link.Reported_Sent == (Packets + Link.Reported_Failed));
+		HOST_CHECK(Link.Reported_Failed == Link.Pool_Refused);
+
+		/* The link carries min(Per_Event, PERFTEST_MAX_BURST) packets per event */
+		Expected = (uint32_t)(((uint64_t)((Runs[r].Per_Event < PERFTEST_MAX_BURST) ? Runs[r].Per_Event : PERFTEST_MAX_BURST) *
+													 Runs[r].Payload * 1000000U) / Runs[r].Interval_us);
+		HOST_CHECK((pResults->Bytes_Per_s >= Expected) &&
+							 (pResults->Bytes_Per_s <= (Expected + ((Runs[r].Pool_Size * Runs[r].Payload) / 10U) + Runs[r].Payload)));
+		if(Runs[r].Per_Event <= PERFTEST_MAX_BURST)
+		{
+			HOST_CHECK(Link.Refills_Full == Link.Refills);
+		}
+		else
+		{
+			HOST_CHECK(Link.Refills_Full < Link.Refills);
+		}
+
+		HOST_CHECK((Publications == 2U) && (Reports == 1U));
+		Test_CheckPublished(pResults, PERFTEST_MODE_SOURCE);
+		printf("  %2u.%u ms, %2u packets an event, %2u bytes: %5u B/s\n", (unsigned int)(Runs[r].Interval_us / 1000U),
+					 (unsigned int)((Runs[r].Interval_us / 100U) % 10U), Runs[r].Per_Event, Runs[r].Payload,
+					 (unsigned int)pResults->Bytes_Per_s);
+	}
+
+	/* Timed run, payload length clamped */
+	Test_Setup(PEER_READ, 7500, 4, 8);
+	Link.Payload = PERFTEST_MAX_PAYLOAD;
+	Command[1] = PERFTEST_MAX_PAYLOAD + 10U;
+	Command[2] = 3;
+	Test_Command(Command, 4);
+	Link_Run(5000);
+	HOST_CHECK((pResults->Mode == PERFTEST_MODE_IDLE) && (pResults->Duration_ms == 3000U) && (Link.Refill == NULL));
+	HOST_CHECK(pResults->Bytes_Per_s == (pResults->Bytes / 3U));
+	Test_CheckPublished(pResults, PERFTEST_MODE_SOURCE);
+
+	Test_Setup(PEER_READ, 7500, 4, 8);
+	Link.Payload = PERFTEST_MIN_PAYLOAD;
+	Command[1] = 1;
+	Test_Command(Command, 2);
+	Link_Run(100);
+	PerfTest_Disconnect();
+	HOST_CHECK((pResults->Mode == PERFTEST_MODE_IDLE) && (pResults->Duration_ms == 100U) && (Link.Rx_Packets != 0U));
+
+	/* The next connection starts with notifications disabled */
+	Test_Command(Command, 2);
+	Link_Run(100);
+	HOST_CHECK(pResults->Packets == 0U);
+	PerfTest_Disconnect();
+
+	/* Notifications disabled: nothing queued */
+	Test_Setup(PEER_READ, 7500, 4, 8);
+	Test_Write(Gatt.Char[1] + 2U, (const uint8_t *)"\x00\x00", 2);
+	Test_Command(Command, 2);
+	Link_Run(1000);
+	HOST_CHECK((pResults->Packets == 0U) && (Link.Rx_Packets == 0U) && (Link.Refills != 0U));
+}
+
+/**
+  * @brief	Sink run: every byte written is counted, the sequence numbers the peer skipped are lost,
+  *					repeated ones are not; the sequence wraps around
+  */
+static void Test_PerfTest_Sink(void)
+{
+	const PerfTest_Results_t *pResults = PerfTest_GetResults();
+
+	Test_Setup(PEER_WRITE, 7500, 6, 8);
+	Link.Tx_Seq = 0xFF00;
+	Test_Command((const uint8_t *)"\x02", 1);
+	Link_Run(20000);
+	Test_Command((const uint8_t *)"\x00", 1);
+
+	HOST_CHECK((pResults->Mode == PERFTEST_MODE_IDLE) && (pResults->Duration_ms == 20000U));
+	HOST_CHECK((pResults->Packets == Link.Tx_Packets) && (pResults->Bytes == Link.Tx_Bytes));
+	HOST_CHECK((Link.Tx_Skipped != 0U) && (pResults->Lost == Link.Tx_Skipped));
+	HOST_CHECK(pResults->Next_Seq == Link.Tx_Seq);
+	HOST_CHECK(pResults->Bytes_Per_s == (Link.Tx_Bytes / 20U));
+	HOST_CHECK(Link.Tx_Seq < 0xFF00U);
+	HOST_CHECK((Publications == 2U) && (Reports == 1U));
+	Test_CheckPublished(pResults, PERFTEST_MODE_SINK);
+	printf("  sink: %u packets, %u lost, %u B/s\n", (unsigned int)pResults->Packets, (unsigned int)pResults->Lost,
+				 (unsigned int)pResults->Bytes_Per_s);
+
+	/* Writes out of a sink run are not counted */
+	Test_Setup(PEER_WRITE, 7500, 6, 8);
+	Link_Run(1000);
+	HOST_CHECK((pResults->Packets == 0U) && (Link.Tx_Packets != 0U));
+}
+
+/**
+  * @brief	Echo run: one probe in flight, reflections counted with the RTT the peer produced,
+  *					dropped and late ones lost once they time out, probes of the peer reflected
+  */
+static void Test_PerfTest_Echo(void)
+{
+	const PerfTest_Results_t *pResults = PerfTest_GetResults();
+	uint32_t Lost = 0, Queued = 0, i;
+
+	Test_Setup(PEER_ECHO, 7500, 4, 8);
+	Test_Command((const uint8_t *)"\x03", 1);
+	Link_Run(120000);
+	Test_Command((const uint8_t *)"\x00", 1);
+
+	/* Timed out by the last PerfTest_Process() */
+	for(i = 0; i < Link.Probes_Dropped; i++)
+	{
+		Lost += ((int32_t)(Tick - Link.Dropped_Tick[i]) >= 0) ? 1U : 0U;
+	}
+	for(i = 0; i < Link.Pool_Count; i++)
+	{
+		Queued += (Link.Pool[(Link.Pool_Head + i) % TEST_MAX_POOL][0] == TEST_PKT_PROBE) ? 1U : 0U;
+	}
+
+	HOST_CHECK((pResults->Mode == PERFTEST_MODE_IDLE) && (pResults->Duration_ms == 120000U));
+	HOST_CHECK((Link.RTT_Count > 100U) && (pResults->Packets == Link.RTT_Count));
+	HOST_CHECK(pResults->Bytes == (Link.RTT_Count * TEST_PROBE_SIZE));
+	HOST_CHECK((Lost != 0U) && (pResults->Lost == Lost) && (Link.Timeouts >= (Lost - 1U)));
+	HOST_CHECK(pResults->Next_Seq == (Link.Probes_Seen + Queued));
+	HOST_CHECK(Link.Probes_Seen <= (Link.RTT_Count + Link.Probes_Dropped + 1U));
+	HOST_CHECK((pResults->RTT_Min_us == Link.RTT_Min_us) && (pResults->RTT_Max_us == Link.RTT_Max_us));
+	HOST_CHECK(pResults->RTT_Sum_us == Link.RTT_Sum_us);
+	HOST_CHECK(memcmp(pResults->RTT_Hist, Link.RTT_Hist, sizeof(Link.RTT_Hist)) == 0);
+	HOST_CHECK(pResults->Bytes_Per_s == (pResults->Bytes / 120U));
+	for(i = 0; i < PERFTEST_RTT_BINS; i++)
+	{
+		HOST_CHECK(Link.RTT_Hist[i] != 0U);
+	}
+	HOST_CHECK(Link.Peer_Echoed > 10U);
+	HOST_CHECK((Publications == 2U) && (Reports == 2U));
+	Test_CheckPublished(pResults, PERFTEST_MODE_ECHO);
+
+	printf("  echo: %u probes, %u lost, RTT min %u avg %u max %u us, hist", (unsigned int)pResults->Packets,
+				 (unsigned int)pResults->Lost, (unsigned int)pResults->RTT_Min_us,
+				 (unsigned int)(pResults->RTT_Sum_us / pResults->Packets), (unsigned int)pResults->RTT_Max_us);
+	for(i = 0; i < PERFTEST_RTT_BINS; i++)
+	{
+		printf(" %u", pResults->RTT_Hist[i]);
+	}
+	printf("\n");
+
+	/* Notifications disabled: no probe */
+	Test_Setup(PEER_ECHO, 7500, 4, 8);
+	Test_Write(Gatt.Char[1] + 2U, (const uint8_t *)"\x00\x00", 2);
+	Test_Command((const uint8_t *)"\x03", 1);
+	Link_Run(5000);
+	HOST_CHECK((pResults->Next_Seq == 0U) && (pResults->Lost == 0U));
+}
+
+/**
+  * @brief	Accounting on its own: histogram edges, sequence wrap around, empty results
+  */
+static void Test_PerfTest_Accounting(void)
+{
+	PerfTest_Results_t Results;
+	uint8_t Buffer[PERFTEST_RESULTS_SIZE + 1U];
+	uint8_t Packet[2];
+	uint8_t Bin;
+
+	for(Bin = 0; Bin < (PERFTEST_RTT_BINS - 1U); Bin++)
+	{
+		HOST_CHECK(PerfTest_RttBin(PERFTEST_RTT_BIN0_US << Bin) == Bin);
+		HOST_CHECK(PerfTest_RttBin((PERFTEST_RTT_BIN0_US << Bin) + 1U) == (Bin + 1U));
+	}
+	HOST_CHECK((PerfTest_RttBin(0) == 0U) && (PerfTest_RttBin(UINT32_MAX) == (PERFTEST_RTT_BINS - 1U)));
+
+	PerfTest_ResultsInit(&Results, PERFTEST_MODE_SINK);
+	Packet[0] = 0xFE;
+	Packet[1] = 0xFF;
+	PerfTest_SinkUpdate(&Results, Packet, 2);
+	Packet[0] = 0x01;
+	Packet[1] = 0x00;
+	PerfTest_SinkUpdate(&Results, Packet, 2);
+	HOST_CHECK((Results.Lost == 2U) && (Results.Next_Seq == 2U));
+	Packet[0] = 0xFF;
+	Packet[1] = 0xFF;
+	PerfTest_SinkUpdate(&Results, Packet, 2);
+	HOST_CHECK((Results.Lost == 2U) && (Results.Next_Seq == 2U) && (Results.Packets == 3U));
+
+	PerfTest_Finish(&Results, 0);
+	HOST_CHECK(Results.Bytes_Per_s == 0U);
+	memset(Buffer, 0xAA, sizeof(Buffer));
+	HOST_CHECK(PerfTest_Serialize(&Results, Buffer) == PERFTEST_RESULTS_SIZE);
+	HOST_CHECK(Buffer[PERFTEST_RESULTS_SIZE] == 0xAAU);
+	HOST_CHECK((TEST_GET_U16(&Buffer[21]) == 0U) && (TEST_GET_U32(&Buffer[23]) == 0U));
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(void)
+{
+	HOST_RUN(Test_PerfTest_Register);
+	HOST_RUN(Test_PerfTest_Source);
+	HOST_RUN(Test_PerfTest_Sink);
+	HOST_RUN(Test_PerfTest_Echo);
+	HOST_RUN(Test_PerfTest_Accounting);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,347 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Radio_Sched.c
+  * @brief      : Host test of Radio_Sched.c on a simulated radio. Activities repeat with the
+	*								advertising or connection interval, each followed by its end of radio activity
+	*								event, while the main loop runs the scheduler with jobs always queued.
+  * @author			:
+  **************************************************************************************************
+  *
+  * No job may run into a radio activity, whatever the interval, and the notification buffers must
+  * be refilled right before each connection event. Only when the events stop past the announced
+  * activity, or report the radio idle, may the gap be left open with no end. TIM2 wraps around
+  * during every run.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Host_Test.h"
+#include "Radio_Sched.h"
+#include "Event_Mask.h"
+#include "bluenrg1_hal_aci.h"
+#include "bluenrg1_events.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* Main loop: one RadioSched_Process() every TEST_STEP_US when no job runs */
+#define TEST_STEP_US										100U
+/* Radio activity, from its start to its end of radio activity event */
+#define TEST_ACTIVITY_US								1000U
+/* TIM2 wraps around TEST_WRAP_US into each run */
+#define TEST_WRAP_US										2000000U
+
+#define TEST_FLASH_JOB_US								20000U			/* Sector of a flash write */
+#define TEST_SHORT_JOB_US								1000U
+
+/* Refill lead time, the margins taken off the gap and a main loop step, plus 1/64 of the period */
+#define TEST_REFILL_MAX_US							(RADIOSCHED_REFILL_LEAD_US + RADIOSCHED_ACTIVITY_US + RADIOSCHED_GUARD_US + TEST_STEP_US)
+
+/* As Radio_Sched.c */
+#define TEST_SILENCE_US									100000U
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+typedef struct
+{
+	uint64_t Time;										/* Local time in us, TIM2 counts its low 32 bits */
+	uint8_t Running;									/* Activities scheduled on the radio */
+	uint8_t State;										/* RADIO_STATE_x of every activity */
+	uint32_t Period;
+	uint64_t Next_Activity;						/* Start of the next activity */
+	uint64_t Last_Event;
+
+	uint32_t Job_Us;
+	uint32_t Jobs_Run;
+	uint32_t Jobs_Done;								/* Run since the main loop queued them again */
+	uint32_t Overlaps;								/* Jobs still running when an activity started */
+	uint32_t Unbounded;								/* Steps with no end to the gap while activities were scheduled */
+
+	uint32_t Refills;
+	uint32_t Refills_Early;						/* More than the lead time before the connection event */
+	uint32_t Refills_Late;
+
+} Sim_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static Sim_t Sim;
+static TIM_TypeDef Tim2;
+TIM_HandleTypeDef htim2 = {&Tim2};
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+EvtMask_Status_t EvtMask_Register(uint32_t Event)
+{
+	HOST_CHECK(Event == EVTMASK_HAL_END_OF_RADIO_ACTIVITY);
+	return EVTMASK_OK;
+}
+
+tBleStatus aci_hal_set_radio_activity_mask(uint16_t Radio_Activity_Mask)
+{
+	(void)Radio_Activity_Mask;
+	return BLE_STATUS_SUCCESS;
+}
+
+static void Sim_Advance(uint32_t Us)
+{
+	Sim.Time += Us;
+	Tim2.CNT = (uint32_t)Sim.Time;
+}
+
+/* Controller time, 625/256 us a tick, of a local time */
+static uint32_t Sim_SysTime(uint64_t Time)
+{
+	return (uint32_t)((Time * 256U) / 625U);
+}
+
+/**
+  * @brief	Radio job: takes its time and checks it ended before the next activity
+  */
+static void Test_Job(void *pContext)
+{
+	(void)pContext;
+
+	Sim_Advance(Sim.Job_Us);
+	Sim.Jobs_Run++;
+	Sim.Jobs_Done++;
+	if(Sim.Running && (Sim.Time > Sim.Next_Activity))
+	{
+		Sim.Overlaps++;
+	}
+}
+
+static RadioSched_Refill_t Test_Refill(void)
+{
+	Sim.Refills++;
+	if(Sim.Time > Sim.Next_Activity)
+	{
+		Sim.Refills_Late++;
+	}
+	else if((Sim.Next_Activity - Sim.Time) > (TEST_REFILL_MAX_US + (Sim.Period >> 6)))
+	{
+		Sim.Refills_Early++;
+	}
+	return RADIOSCHED_REFILL_FULL;
+}
+
+/**
+  * @brief	Keep the jobs queued: the work is never done
+  */
+static void Sim_Requeue(void)
+{
+	for(; Sim.Jobs_Done > 0U; Sim.Jobs_Done--)
+	{
+		HOST_CHECK(RadioSched_Submit(Test_Job, NULL, Sim.Job_Us) == RADIOSCHED_OK);
+	}
+}
+
+/**
+  * @brief	Scheduler started TEST_WRAP_US before TIM2 wraps around, with two jobs queued
+  */
+static void Sim_Init(uint32_t Job_Us)
+{
+	memset(&Sim, 0, sizeof(Sim));
+	Sim.Time = 0x100000000ULL - TEST_WRAP_US;
+	Tim2.CNT = (uint32_t)Sim.Time;
+	Sim.Job_Us = Job_Us;
+
+	HOST_CHECK(RadioSched_Init(RADIO_ACTIVITY_MASK_ADVERTISING | RADIO_ACTIVITY_MASK_CONN_SLAVE) == RADIOSCHED_OK);
+	HOST_CHECK(RadioSched_Submit(Test_Job, NULL, Job_Us) == RADIOSCHED_OK);
+	HOST_CHECK(RadioSched_Submit(Test_Job, NULL, Job_Us) == RADIOSCHED_OK);
+}
+
+/**
+  * @brief	Schedule an activity every Period from First on
+  */
+static void Sim_Start(uint8_t State, uint32_t Period, uint32_t First)
+{
+	Sim.Running = 1;
+	Sim.State = State;
+	Sim.Period = Period;
+	Sim.Next_Activity = Sim.Time + First;
+}
+
+/**
+  * @brief	Main loop for Duration us: end of radio activity events as they come, then the
+  *					scheduler
+  */
+static void Sim_Run(uint32_t Duration)
+{
+	uint64_t End = Sim.Time + Duration;
+
+	while(Sim.Time < End)
+	{
+		if(Sim.Running && (Sim.Time >= (Sim.Next_Activity + TEST_ACTIVITY_US)))
+		{
+			Sim.Next_Activity += Sim.Period;
+			Sim.Last_Event = Sim.Time;
+			aci_hal_end_of_radio_activity_event(Sim.State, Sim.State, Sim_SysTime(Sim.Next_Activity));
+		}
+
+		RadioSched_Process();
+		if(Sim.Running && (RadioSched_GetFreeTime() == UINT32_MAX))
+		{
+			Sim.Unbounded++;
+		}
+		Sim_Requeue();
+		Sim_Advance(TEST_STEP_US);
+	}
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	Slow advertising (1 s and the 1285 ms of the slow phase) and a slow connection: the
+  *					flash jobs fill the gaps, never the time of the next activity
+  */
+static void Test_RadioSched_SlowIntervals(void)
+{
+	static const struct
+	{
+		uint8_t State;
+		uint32_t Period;
+
+	} Cases[] =
+	{
+		{RADIO_STATE_ADVERTISING, 1000000U},
+		{RADIO_STATE_ADVERTISING, 1285000U},
+		{RADIO_STATE_CONN_SLAVE, 400000U},
+		{RADIO_STATE_CONN_SLAVE, 125000U},
+	};
+	const uint32_t Duration = 30000000U;
+	uint32_t Busy_Min;
+	uint8_t i;
+
+	for(i = 0; i < (sizeof(Cases) / sizeof(Cases[0])); i++)
+	{
+		Sim_Init(TEST_FLASH_JOB_US);
+		Sim_Start(Cases[i].State, Cases[i].Period, 5000U);
+
+		/* Until a second event gives the period, nothing runs */
+		Sim_Run(Cases[i].Period);
+		HOST_CHECK(Sim.Jobs_Run == 0U);
+
+		Sim_Run(Duration);
+		HOST_CHECK((Sim.Overlaps == 0U) && (RadioSched_GetStats()->Jobs_Overrun == 0U));
+		HOST_CHECK(Sim.Unbounded == 0U);
+
+		/* Each gap loses the activity, the margins and the job that did not fit */
+		Busy_Min = (uint32_t)(((uint64_t)Duration * (Cases[i].Period - (Cases[i].Period / 32U) - 30000U)) / Cases[i].Period);
+		HOST_CHECK((Sim.Jobs_Run * TEST_FLASH_JOB_US) >= Busy_Min);
+
+		printf("  %s %4lu ms: %5.1f%% of the time in jobs, %lu overlaps\n",
+					 (Cases[i].State == RADIO_STATE_ADVERTISING) ? "advertising" : "connection ",
+					 (unsigned long)(Cases[i].Period / 1000U), (100.0 * Sim.Jobs_Run * TEST_FLASH_JOB_US) / Duration,
+					 (unsigned long)Sim.Overlaps);
+	}
+}
+
+/**
+  * @brief	The buffers are refilled within the lead time of every connection event, at any interval
+  */
+static void Test_RadioSched_Refill(void)
+{
+	static const uint32_t Periods[] = {7500U, 50000U, 400000U, 1000000U};
+	const RadioSched_Stats_t *pStats;
+	uint8_t i;
+
+	for(i = 0; i < (sizeof(Periods) / sizeof(Periods[0])); i++)
+	{
+		Sim_Init(TEST_SHORT_JOB_US);
+		RadioSched_SetRefill(Test_Refill);
+		Sim_Start(RADIO_STATE_CONN_SLAVE, Periods[i], 3000U);
+
+		/* The first event gives no period yet, its refill is done at once */
+		Sim_Run(Periods[i] + 5000U);
+		RadioSched_ResetStats();
+		Sim.Refills = Sim.Refills_Early = Sim.Refills_Late = 0;
+
+		Sim_Run(100U * Periods[i]);
+		pStats = RadioSched_GetStats();
+		HOST_CHECK(pStats->Conn_Events == 100U);
+		HOST_CHECK((Sim.Refills == pStats->Conn_Events) || (Sim.Refills == (pStats->Conn_Events + 1U)));
+			HOST_CHECK((Sim.Refills_Early == 0U) && (Sim.Refills_Late == 0U) && (pStats->Refills_Late == 0U));
+		HOST_CHECK((pStats->Conn_Events_Full == pStats->Conn_Events) && (pStats->Conn_Events_Empty == 0U));
+		HOST_CHECK((Sim.Overlaps == 0U) && (Sim.Jobs_Run > 0U));
+	}
+
+	/* Flash jobs never fit between 7.5 ms connection events, they are deferred */
+	Sim_Init(TEST_FLASH_JOB_US);
+	Sim_Start(RADIO_STATE_CONN_SLAVE, 7500U, 3000U);
+	Sim_Run(1000000U);
+	HOST_CHECK((Sim.Jobs_Run == 0U) && (RadioSched_GetStats()->Jobs_Deferred >= 2U * 130U));
+}
+
+/**
+  * @brief	Events stopped without an idle report: the gap opens with no end once the announced
+  *					activity is overdue by the silence time, not before
+  */
+static void Test_RadioSched_Stopped(void)
+{
+	uint64_t Opened, Before;
+
+	/* No event since the start */
+	Sim_Init(TEST_FLASH_JOB_US);
+	Sim_Run(TEST_SILENCE_US - TEST_STEP_US);
+	HOST_CHECK((Sim.Jobs_Run == 0U) && (RadioSched_GetFreeTime() == 0U));
+	Sim_Run(3U * TEST_STEP_US);
+	HOST_CHECK(Sim.Jobs_Run > 0U);
+
+	/* 1 s advertising stopped */
+	Sim_Init(TEST_FLASH_JOB_US);
+	Sim_Start(RADIO_STATE_ADVERTISING, 1000000U, 5000U);
+	Sim_Run(5000000U);
+	Sim.Running = 0;
+
+	Opened = 0;
+	while(Sim.Time < (Sim.Last_Event + 3000000U))
+	{
+		Before = Sim.Time;
+		RadioSched_Process();
+		if(!Opened && (RadioSched_GetFreeTime() == UINT32_MAX))
+		{
+			Opened = Before;
+		}
+		Sim_Requeue();
+		Sim_Advance(TEST_STEP_US);
+	}
+	HOST_CHECK(Opened != 0U);
+	HOST_CHECK((Opened - Sim.Last_Event) > (1000000U + TEST_SILENCE_US));
+	HOST_CHECK((Opened - Sim.Last_Event) <= (1000000U + TEST_SILENCE_US + TEST_STEP_US));
+}
+
+/**
+  * @brief	An idle report opens the gap with no end at once, the next activity closes it
+  */
+static void Test_RadioSched_Idle(void)
+{
+	Sim_Init(TEST_FLASH_JOB_US);
+	Sim_Start(RADIO_STATE_ADVERTISING, 1000000U, 5000U);
+	Sim_Run(3000000U);
+
+	Sim.Running = 0;
+	aci_hal_end_of_radio_activity_event(RADIO_STATE_ADVERTISING, RADIO_STATE_IDLE, 0);
+	HOST_CHECK(RadioSched_GetFreeTime() == UINT32_MAX);
+	Sim.Jobs_Run = 0;
+	Sim_Run(TEST_FLASH_JOB_US);
+	HOST_CHECK(Sim.Jobs_Run >= 1U);
+
+	aci_hal_end_of_radio_activity_event(RADIO_STATE_IDLE, RADIO_STATE_ADVERTISING, Sim_SysTime(Sim.Time + 1000000U));
+	HOST_CHECK(RadioSched_GetFreeTime() == 0U);
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(void)
+{
+	HOST_RUN(Test_RadioSched_SlowIntervals);
+	HOST_RUN(Test_RadioSched_Refill);
+	HOST_RUN(Test_RadioSched_Stopped);
+	HOST_RUN(Test_RadioSched_Idle);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/
@@ -0,0 +1,553 @@
+/**
+  **************************************************************************************************
+  * @file       : Test_Time_Sync.c
+  * @brief      : Host test of Time_Sync.c. Synthetic connection anchors, drifting against the local
+	*								timebase and observed with jitter, are fed to the estimator; the service is then
+	*								driven through its radio activity hook.
+  * @author			:
+  **************************************************************************************************
+  *
+  * The estimate must lock and predict the next anchors for any drift up to the period range, with
+  * skipped connection events, across the TIM2 wrap around, and restart when the observations are
+  * far off. Stamps must give an offset in [0, period) on both sides of the last anchor.
+  */
+
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include <string.h>
+#include "Host_Test.h"
+#include "Time_Sync.h"
+#include "Radio_Sched.h"
+#include "bluenrg1_hal_aci.h"
+
+
+/* Private define --------------------------------------------------------------------------------*/
+/* Anchors fed per run */
+#define TEST_ANCHORS										3000U
+/* Anchors to lock at intervals the phase error clip does not slow down */
+#define TEST_LOCK_MAX										100U
+
+/* Observation jitter, +/- us */
+#define TEST_JITTER_US									100U
+/* Largest prediction error of a locked estimate with that jitter, us */
+#define TEST_PREDICT_MAX_US							150
+
+/* Period range of Time_Sync.c, 1/32 of the nominal period */
+#define TEST_RANGE_PPM									31250
+
+/* Anchors before the TIM2 wrap around at the start of each run */
+#define TEST_WRAP_ANCHORS								500U
+
+
+/* Private typedef -------------------------------------------------------------------------------*/
+/**
+  * @brief Connection anchors on the local timebase, in us Q16
+  */
+typedef struct
+{
+	uint64_t Anchor_Q16;							/* Local time of the current anchor */
+	uint64_t Period_Q16;
+	uint32_t Count;										/* Anchors since the first one */
+	uint32_t Jitter_us;
+	uint32_t Skip_Min;								/* Connection intervals between two observations */
+	uint32_t Skip_Max;
+	uint32_t Seed;
+
+} Link_t;
+
+typedef struct
+{
+	uint32_t Lock_Anchor;							/* Anchors fed before the estimate locked, 0 if never */
+	int32_t Predict_Max;							/* Largest next anchor error once locked, us */
+	uint32_t Count_Errors;						/* Anchor counts not following the link */
+
+} Track_t;
+
+
+/* Private variables -----------------------------------------------------------------------------*/
+static RadioSched_ActivityFunc_t Hook;
+static uint32_t Now;
+static uint32_t Anchor_Period_625;
+
+static uint32_t Produced;
+static uint32_t Produced_Errors;
+static uint16_t Produced_Last;
+static uint32_t Produced_Time;
+
+
+/* Private functions -----------------------------------------------------------------------------*/
+void RadioSched_SetActivityHook(RadioSched_ActivityFunc_t pHook)
+{
+	Hook = pHook;
+}
+
+uint32_t RadioSched_GetTime(void)
+{
+	return Now;
+}
+
+tBleStatus aci_hal_get_anchor_period(uint32_t *Anchor_Period, uint32_t *Max_Free_Slot)
+{
+	*Anchor_Period = Anchor_Period_625;
+	*Max_Free_Slot = 0;
+	return BLE_STATUS_SUCCESS;
+}
+
+static int32_t Test_Abs(int32_t Value)
+{
+	return (Value < 0) ? -Value : Value;
+}
+
+/**
+  * @brief	Link of a nominal period, drifting by Drift_ppm on the local timebase. TIM2 wraps around
+  *					half a period after anchor TEST_WRAP_ANCHORS - 1.
+  */
+static void Link_Init(Link_t *pLink, uint32_t Period_us, int32_t Drift_ppm, uint32_t Jitter_us)
+{
+	memset(pLink, 0, sizeof(Link_t));
+	pLink->Period_Q16 = (((uint64_t)Period_us << 16) * (uint64_t)(1000000 + Drift_ppm)) / 1000000U;
+	pLink->Anchor_Q16 = (0x100000000ULL << 16) - (pLink->Period_Q16 * TEST_WRAP_ANCHORS) + (pLink->Period_Q16 / 2U);
+	pLink->Jitter_us = Jitter_us;
+	pLink->Skip_Min = 1U;
+	pLink->Skip_Max = 1U;
+	pLink->Seed = Period_us ^ (uint32_t)Drift_ppm;
+}
+
+static void Link_Step(Link_t *pLink, uint32_t Anchors)
+{
+	pLink->Anchor_Q16 += pLink->Period_Q16 * Anchors;
+	pLink->Count += Anchors;
+}
+
+/* TIM2 time of the current anchor */
+static uint32_t Link_Anchor(const Link_t *pLink)
+{
+	return (uint32_t)(pLink->Anchor_Q16 >> 16);
+}
+
+/* TIM2 time of the end of radio activity event of the current anchor */
+static uint32_t Link_Observe(Link_t *pLink)
+{
+	uint32_t Jitter = 0;
+
+	if(pLink->Jitter_us != 0U)
+	{
+		Jitter = Host_Rand(&pLink->Seed) % ((2U * pLink->Jitter_us) + 1U);
+	}
+	return Link_Anchor(pLink) + TIMESYNC_EVENT_LATENCY_US + Jitter - pLink->Jitter_us;
+}
+
+/**
+  * @brief	Feed observations of the link and track the prediction of the next anchor once locked
+  */
+static void Track_Run(TimeSync_Estimator_t *pEst, Link_t *pLink, uint32_t Anchors, Track_t *pTrack)
+{
+	uint32_t Fed, Skip, Next;
+	uint16_t Count;
+	int32_t Error;
+
+	memset(pTrack, 0, sizeof(Track_t));
+
+	TimeSync_EstimatorUpdate(pEst, Link_Observe(pLink), 0);
+	for(Fed = 1; Fed < Anchors; Fed++)
+	{
+		Skip = pLink->Skip_Min + (Host_Rand(&pLink->Seed) % (pLink->Skip_Max - pLink->Skip_Min + 1U));
+		Link_Step(pLink, Skip);
+		TimeSync_EstimatorUpdate(pEst, Link_Observe(pLink), Skip);
+
+		if(pEst->Anchor_Count != (uint16_t)pLink->Count)
+		{
+			pTrack->Count_Errors++;
+		}
+
+		if(!pTrack->Lock_Anchor && TimeSync_EstimatorLocked(pEst))
+		{
+			pTrack->Lock_Anchor = Fed;
+		}
+
+		if(pTrack->Lock_Anchor)
+		{
+			Next = TimeSync_EstimatorNextAnchor(pEst, Link_Anchor(pLink) + TIMESYNC_EVENT_LATENCY_US + pLink->Jitter_us, &Count);
+			Error = Test_Abs((int32_t)(Next - (uint32_t)((pLink->Anchor_Q16 + pLink->Period_Q16) >> 16)));
+			if(Error > pTrack->Predict_Max)
+			{
+				pTrack->Predict_Max = Error;
+			}
+			if(Count != (uint16_t)(pLink->Count + 1U))
+			{
+				pTrack->Count_Errors++;
+			}
+		}
+	}
+}
+
+static void Test_Producer(uint16_t Anchor_Count)
+{
+	if(Produced && (Anchor_Count != (uint16_t)(Produced_Last + 1U)))
+	{
+		Produced_Errors++;
+	}
+	Produced++;
+	Produced_Last = Anchor_Count;
+	Produced_Time = Now;
+}
+
+
+/* Tests -----------------------------------------------------------------------------------------*/
+/**
+  * @brief	Drifts up to the period range, at a fast, a common and a slow connection interval. At
+  *					400 ms the drift of an interval is larger than the error clip, which only lets the
+  *					period move by TIMESYNC_ERROR_CLIP_US / 64 an update: it takes longer to lock.
+  */
+static void Test_TimeSync_Drift(void)
+{
+	static const struct
+	{
+		uint32_t Period;
+		uint32_t Lock_Max;
+
+	} Periods[] =
+	{
+		{7500U, TEST_LOCK_MAX},
+		{30000U, TEST_LOCK_MAX},
+		{400000U, 600U},
+	};
+	static const int32_t Drifts[] = {-30000, -10000, -500, 0, 500, 10000, 30000};
+	TimeSync_Estimator_t Est;
+	Link_t Link;
+	Track_t Track;
+	int32_t Period_Error;
+	uint8_t p, d;
+
+	for(p = 0; p < (sizeof(Periods) / sizeof(Periods[0])); p++)
+	{
+		for(d = 0; d < (sizeof(Drifts) / sizeof(Drifts[0])); d++)
+		{
+			Link_Init(&Link, Periods[p].Period, Drifts[d], TEST_JITTER_US);
+			TimeSync_EstimatorInit(&Est, Periods[p].Period);
+			Track_Run(&Est, &Link, TEST_ANCHORS, &Track);
+
+			HOST_CHECK((Track.Lock_Anchor != 0U) && (Track.Lock_Anchor <= Periods[p].Lock_Max));
+			HOST_CHECK(TimeSync_EstimatorLocked(&Est));
+			HOST_CHECK(Track.Predict_Max <= TEST_PREDICT_MAX_US);
+			HOST_CHECK(Track.Count_Errors == 0U);
+
+			/* Within 250 ppm of the period */
+			Period_Error = (int32_t)(Est.Period_Q8 - (uint32_t)(Link.Period_Q16 >> 8));
+			HOST_CHECK(Test_Abs(Period_Error) <= (int32_t)(Est.Period_Q8 >> 12));
+
+			printf("  %6lu us %+6ld ppm: locked after %3lu anchors, next anchor within %3ld us\n",
+						 (unsigned long)Periods[p].Period, (long)Drifts[d], (unsigned long)Track.Lock_Anchor, (long)Track.Predict_Max);
+		}
+	}
+
+	/* Beyond the range the period stays at its bound */
+	Link_Init(&Link, 30000U, 2 * TEST_RANGE_PPM, 0);
+	TimeSync_EstimatorInit(&Est, 30000U);
+	Track_Run(&Est, &Link, 500U, &Track);
+	HOST_CHECK(Est.Period_Q8 == (Est.Nominal_Q8 + (Est.Nominal_Q8 >> 5)));
+
+	Link_Init(&Link, 30000U, -2 * TEST_RANGE_PPM, 0);
+	TimeSync_EstimatorInit(&Est, 30000U);
+	Track_Run(&Est, &Link, 500U, &Track);
+	HOST_CHECK(Est.Period_Q8 == (Est.Nominal_Q8 - (Est.Nominal_Q8 >> 5)));
+}
+
+/**
+  * @brief	Slave latency: 1 to 8 connection intervals between two observations, then a constant
+  *					slave latency of 7 (every 8th event)
+  */
+static void Test_TimeSync_Skipped(void)
+{
+	static const int32_t Drifts[] = {-30000, 0, 20000};
+	static const uint32_t Skips[][2] = {{1U, 8U}, {8U, 8U}};
+	TimeSync_Estimator_t Est;
+	Link_t Link;
+	Track_t Track;
+	int32_t Period_Error;
+	uint8_t d, k;
+
+	for(k = 0; k < (sizeof(Skips) / sizeof(Skips[0])); k++)
+	{
+		for(d = 0; d < (sizeof(Drifts) / sizeof(Drifts[0])); d++)
+		{
+			Link_Init(&Link, 30000U, Drifts[d], TEST_JITTER_US);
+			Link.Skip_Min = Skips[k][0];
+			Link.Skip_Max = Skips[k][1];
+			TimeSync_EstimatorInit(&Est, 30000U);
+			Track_Run(&Est, &Link, 20000U, &Track);
+
+			/* The error of several intervals is clipped as much as that of one, and the period
+			   correction is spread over them: it takes more observations to lock */
+			HOST_CHECK((Track.Lock_Anchor != 0U) && (Track.Lock_Anchor <= (Link.Skip_Max * TEST_LOCK_MAX)));
+			HOST_CHECK(Track.Predict_Max <= TEST_PREDICT_MAX_US);
+			HOST_CHECK(Track.Count_Errors == 0U);
+
+			/* The anchor count wrapped around */
+			HOST_CHECK(Link.Count > 65536U);
+
+			Period_Error = (int32_t)(Est.Period_Q8 - (uint32_t)(Link.Period_Q16 >> 8));
+			HOST_CHECK(Test_Abs(Period_Error) <= (int32_t)(Est.Period_Q8 >> 12));
+		}
+	}
+}
+
+/**
+  * @brief	Observations far off the prediction restart the estimate from them, a smaller error is
+  *					clipped
+  */
+static void Test_TimeSync_Restart(void)
+{
+	TimeSync_Estimator_t Est, Before;
+	Link_t Link;
+	Track_t Track;
+	uint32_t Observed, Fed;
+
+	Link_Init(&Link, 30000U, 10000, 0);
+	TimeSync_EstimatorInit(&Est, 30000U);
+	Track_Run(&Est, &Link, 300U, &Track);
+	HOST_CHECK(TimeSync_EstimatorLocked(&Est));
+
+	/* A missed count: the observation is one period off the prediction */
+	Before = Est;
+	Link_Step(&Link, 2U);
+	Observed = Link_Observe(&Link);
+	TimeSync_EstimatorUpdate(&Est, Observed, 1U);
+	HOST_CHECK(!TimeSync_EstimatorLocked(&Est) && (Est.Lock_Count == 0U));
+	HOST_CHECK(Est.Anchor_Q8 == ((uint64_t)(Observed - TIMESYNC_EVENT_LATENCY_US) << 8));
+	HOST_CHECK(Est.Period_Q8 == Before.Period_Q8);
+
+	/* Locks again from there */
+	for(Fed = 1; (Fed <= TIMESYNC_LOCK_COUNT) && !TimeSync_EstimatorLocked(&Est); Fed++)
+	{
+		Link_Step(&Link, 1U);
+		TimeSync_EstimatorUpdate(&Est, Link_Observe(&Link), 1U);
+	}
+	HOST_CHECK(TimeSync_EstimatorLocked(&Est));
+
+	/* Clock retimed: the local time jumps by a third of a period */
+	Link.Anchor_Q16 += Link.Period_Q16 / 3U;
+	Link_Step(&Link, 1U);
+	Observed = Link_Observe(&Link);
+	TimeSync_EstimatorUpdate(&Est, Observed, 1U);
+	HOST_CHECK(Est.Lock_Count == 0U);
+	HOST_CHECK(Est.Anchor_Q8 == ((uint64_t)(Observed - TIMESYNC_EVENT_LATENCY_US) << 8));
+
+	/* Just under a quarter of a period: kept, the phase correction clipped */
+	Before = Est;
+	Observed = (uint32_t)((Before.Anchor_Q8 + Before.Period_Q8) >> 8) + TIMESYNC_EVENT_LATENCY_US + (Before.Period_Q8 >> 10) - 1U;
+	TimeSync_EstimatorUpdate(&Est, Observed, 1U);
+	HOST_CHECK(Est.Anchor_Q8 == (Before.Anchor_Q8 + Before.Period_Q8 + ((uint64_t)TIMESYNC_ERROR_CLIP_US << (8U - TIMESYNC_PHASE_SHIFT))));
+	HOST_CHECK(Est.Period_Q8 == (Before.Period_Q8 + ((uint32_t)TIMESYNC_ERROR_CLIP_US << (8U - TIMESYNC_PERIOD_SHIFT))));
+	HOST_CHECK(Est.Anchor_Count == (uint16_t)(Before.Anchor_Count + 1U));
+
+	/* An error built up over two intervals corrects the period by half as much */
+	Before = Est;
+	Observed = (uint32_t)((Before.Anchor_Q8 + (2U * (uint64_t)Before.Period_Q8)) >> 8) + TIMESYNC_EVENT_LATENCY_US + 100U;
+	TimeSync_EstimatorUpdate(&Est, Observed, 2U);
+	HOST_CHECK(Est.Period_Q8 == (Before.Period_Q8 + ((100U << (8U - TIMESYNC_PERIOD_SHIFT)) / 2U)));
+	HOST_CHECK(Est.Anchor_Count == (uint16_t)(Before.Anchor_Count + 2U));
+
+	/* An event with no interval since the last one is ignored */
+	Before = Est;
+	TimeSync_EstimatorUpdate(&Est, Observed + 5000U, 0);
+	HOST_CHECK(memcmp(&Est, &Before, sizeof(Est)) == 0);
+}
+
+/**
+  * @brief	Predictions and stamps across the TIM2 wrap around
+  */
+static void Test_TimeSync_Wrap(void)
+{
+	TimeSync_Estimator_t Est;
+	TimeSync_Stamp_t Stamp;
+	Link_t Link;
+	Track_t Track;
+	uint32_t Next, Time;
+	uint16_t Count;
+
+	/* Locked well before the wrap, fed up to the last anchor before it */
+	Link_Init(&Link, 30000U, -20000, 0);
+	TimeSync_EstimatorInit(&Est, 30000U);
+	Track_Run(&Est, &Link, TEST_WRAP_ANCHORS, &Track);
+	HOST_CHECK(TimeSync_EstimatorLocked(&Est));
+	HOST_CHECK((Link_Anchor(&Link) > 0xFFF00000U) && ((Link.Anchor_Q16 + Link.Period_Q16) > (0x100000000ULL << 16)));
+
+	/* The next anchor is after the wrap */
+	Time = 0xFFFFFFFFU;
+	Next = TimeSync_EstimatorNextAnchor(&Est, Time, &Count);
+	HOST_CHECK(Next < 30000U);
+	HOST_CHECK((int32_t)(Next - (uint32_t)((Link.Anchor_Q16 + Link.Period_Q16) >> 16)) <= 1);
+	HOST_CHECK((int32_t)(Next - (uint32_t)((Link.Anchor_Q16 + Link.Period_Q16) >> 16)) >= -1);
+	HOST_CHECK(Count == (uint16_t)(Est.Anchor_Count + 1U));
+
+	/* A sample after the wrap is stamped from the anchor before it */
+	TimeSync_EstimatorStamp(&Est, 5U, &Stamp);
+	HOST_CHECK((Stamp.Offset_us >= 0) && ((uint32_t)Stamp.Offset_us < (Est.Period_Q8 >> 8) + 1U));
+	HOST_CHECK(Stamp.Anchor_Count == Est.Anchor_Count);
+	HOST_CHECK(Stamp.Offset_us == (int32_t)(5U - (uint32_t)(Est.Anchor_Q8 >> 8)));
+
+	/* Carries on after it */
+	Track_Run(&Est, &Link, 1000U, &Track);
+	HOST_CHECK(TimeSync_EstimatorLocked(&Est) && (Track.Predict_Max <= 2));
+	HOST_CHECK(Link_Anchor(&Link) < 0x80000000U);
+}
+
+/**
+  * @brief	Stamps of times before and after the last anchor, on an exact estimate
+  */
+static void Test_TimeSync_Stamp(void)
+{
+	const uint32_t Period = 30000U;
+	TimeSync_Estimator_t Est;
+	TimeSync_Stamp_t Stamp;
+	uint32_t Anchor, Time, Next, Seed = 7U;
+	int32_t Delta;
+	uint16_t Count;
+	uint16_t i;
+
+	/* No drift, no jitter: the anchors are exact multiples of the period */
+	Anchor = 0xFFFFFFFFU - (10U * Period);
+	TimeSync_EstimatorInit(&Est, Period);
+	TimeSync_EstimatorUpdate(&Est, Anchor + TIMESYNC_EVENT_LATENCY_US, 0);
+	for(i = 1; i <= 20U; i++)
+	{
+		TimeSync_EstimatorUpdate(&Est, Anchor + (i * Period) + TIMESYNC_EVENT_LATENCY_US, 1U);
+	}
+	Anchor += 20U * Period;
+	HOST_CHECK(TimeSync_EstimatorLocked(&Est) && (Est.Period_Q8 == (Period << 8)));
+	HOST_CHECK((uint32_t)(Est.Anchor_Q8 >> 8) == Anchor);
+
+	/* At, just before and just after anchors */
+	TimeSync_EstimatorStamp(&Est, Anchor, &Stamp);
+	HOST_CHECK((Stamp.Anchor_Count == 20U) && (Stamp.Offset_us == 0));
+	TimeSync_EstimatorStamp(&Est, Anchor - 1U, &Stamp);
+	HOST_CHECK((Stamp.Anchor_Count == 19U) && (Stamp.Offset_us == (int32_t)Period - 1));
+	TimeSync_EstimatorStamp(&Est, Anchor - Period, &Stamp);
+	HOST_CHECK((Stamp.Anchor_Count == 19U) && (Stamp.Offset_us == 0));
+	TimeSync_EstimatorStamp(&Est, Anchor - Period - 1U, &Stamp);
+	HOST_CHECK((Stamp.Anchor_Count == 18U) && (Stamp.Offset_us == (int32_t)Period - 1));
+	TimeSync_EstimatorStamp(&Est, Anchor + Period - 1U, &Stamp);
+	HOST_CHECK((Stamp.Anchor_Count == 20U) && (Stamp.Offset_us == (int32_t)Period - 1));
+
+	/* Before the first anchor, the count goes below 0 */
+	TimeSync_EstimatorStamp(&Est, Anchor - (20U * Period) - 10U, &Stamp);
+	HOST_CHECK((Stamp.Anchor_Count == 0xFFFFU) && (Stamp.Offset_us == (int32_t)Period - 10));
+
+	/* Random times within 50 periods either side */
+	for(i = 0; i < 10000U; i++)
+	{
+		Delta = (int32_t)(Host_Rand(&Seed) % (100U * Period)) - (int32_t)(50U * Period);
+		Time = Anchor + (uint32_t)Delta;
+
+		TimeSync_EstimatorStamp(&Est, Time, &Stamp);
+		HOST_CHECK((Stamp.Offset_us >= 0) && (Stamp.Offset_us < (int32_t)Period));
+		HOST_CHECK(((int32_t)(int16_t)(Stamp.Anchor_Count - 20U) * (int32_t)Period) + Stamp.Offset_us == Delta);
+
+		/* Called from the last anchor on */
+		if(Delta >= 0)
+		{
+			Next = TimeSync_EstimatorNextAnchor(&Est, Time, &Count);
+			HOST_CHECK((Next - Time) == (Period - (uint32_t)Stamp.Offset_us));
+			HOST_CHECK(Count == (uint16_t)(Stamp.Anchor_Count + 1U));
+		}
+	}
+}
+
+/**
+  * @brief	Service fed by the radio activity hook: the producer runs once per anchor, its lead time
+  *					before it, once locked
+  */
+static void Test_TimeSync_Service(void)
+{
+	const uint32_t Lead = 3000U;
+	Link_t Link;
+	uint32_t SysTime, Next_SysTime, Event, Early = 0, Late = 0;
+	uint32_t Skip, Events;
+	uint64_t Due_Q16;
+	TimeSync_Stamp_t Stamp;
+	int32_t Error;
+
+	/* 24 x 1.25 ms, 1% slower on the local timebase */
+	Anchor_Period_625 = 48U;
+	Link_Init(&Link, 30000U, 10000, 20U);
+	Now = Link_Anchor(&Link) - 100000U;
+	TimeSync_Init();
+	HOST_CHECK(Hook != NULL);
+	TimeSync_Start(24U);
+	TimeSync_SetProducer(Test_Producer, Lead);
+	HOST_CHECK(TimeSync_Stamp(Now, &Stamp) == TIMESYNC_ERROR_NOT_LOCKED);
+
+	/* Controller time of the current anchor, 12288 ticks an interval, wrapping around */
+	SysTime = 0xFFFF0000U;
+	Produced = Produced_Errors = 0;
+	Hook(RADIO_STATE_ADVERTISING, RADIO_STATE_CONN_SLAVE, SysTime, Now);
+
+	for(Events = 0; Events < 2000U; Events++)
+	{
+		/* Slave latency of up to 3 skipped events, announced by the previous one */
+		Skip = ((Events % 50U) < 25U) ? 1U : (1U + (Events % 4U));
+		Event = Link_Observe(&Link);
+
+		/* Main loop until the event */
+		while((int32_t)(Event - Now) > 0)
+		{
+			TimeSync_Process();
+			if(Produced_Time == Now)
+			{
+				/* First anchor after now, the skipped ones included */
+				Due_Q16 = Link.Anchor_Q16 - (Link.Period_Q16 * ((uint64_t)(Link_Anchor(&Link) - Now) * 65536U / Link.Period_Q16));
+				Error = (int32_t)((uint32_t)(Due_Q16 >> 16) - Now) - (int32_t)Lead;
+				if(Error > TEST_PREDICT_MAX_US)
+				{
+					Early++;
+				}
+				else if(Error < -TEST_PREDICT_MAX_US)
+				{
+					Late++;
+				}
+			}
+			Now += 100U;
+		}
+
+		Now = Event;
+		Link_Step(&Link, Skip);
+		/* Announced within a tick */
+		SysTime += Skip * 12288U;
+		Next_SysTime = SysTime + (Host_Rand(&Link.Seed) % 3U) - 1U;
+		Hook(RADIO_STATE_CONN_SLAVE, RADIO_STATE_CONN_SLAVE, Next_SysTime, Now);
+	}
+
+	/* One call per anchor once locked, skipped ones included */
+	HOST_CHECK((Produced + TEST_LOCK_MAX) >= Link.Count);
+	HOST_CHECK(Produced_Errors == 0U);
+	HOST_CHECK((Early == 0U) && (Late == 0U));
+
+	HOST_CHECK(TimeSync_Stamp(Now, NULL) == TIMESYNC_ERROR_PARAM);
+	HOST_CHECK(TimeSync_Stamp(Now, &Stamp) == TIMESYNC_OK);
+	HOST_CHECK(Stamp.Anchor_Count == TimeSync_GetEstimator()->Anchor_Count);
+
+	/* Nothing after the disconnection */
+	TimeSync_Stop();
+	Produced = 0;
+	Now += 1000000U;
+	TimeSync_Process();
+	HOST_CHECK((Produced == 0U) && (TimeSync_Stamp(Now, &Stamp) == TIMESYNC_ERROR_NOT_LOCKED));
+}
+
+
+/* Main ------------------------------------------------------------------------------------------*/
+int main(void)
+{
+	HOST_RUN(Test_TimeSync_Drift);
+	HOST_RUN(Test_TimeSync_Skipped);
+	HOST_RUN(Test_TimeSync_Restart);
+	HOST_RUN(Test_TimeSync_Wrap);
+	HOST_RUN(Test_TimeSync_Stamp);
+	HOST_RUN(Test_TimeSync_Service);
+
+	HOST_TEST_END();
+}
+
+
+/******************************************* END OF FILE *******************************************/